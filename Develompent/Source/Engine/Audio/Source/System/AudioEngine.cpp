@@ -1,8 +1,11 @@
 #include "Misc/AudioGlobals.h"
 #include "System/AudioEngine.h"
+#include "System/Malloc.h"
 
 void CAudioEngine::Init()
 {
+	SCOPED_MEMORY_TAG( MTAG_Audio );
+
 	GAudioDevice.Init();
 }
 
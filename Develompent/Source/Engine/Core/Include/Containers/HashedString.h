@@ -0,0 +1,362 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef HASHEDSTRING_H
+#define HASHEDSTRING_H
+
+#include <string>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "Containers/StringView.h"
+#include "System/Archive.h"
+
+/**
+ * @ingroup Core
+ * @brief Max length of string which stored inline in CHashedString without allocation
+ */
+#define HASHEDSTRING_INLINE_LENGTH		23
+
+/**
+ * @ingroup Core
+ * @brief Wide string for engine identifiers (asset names, package paths, config keys, etc)
+ *
+ * Short strings (up to HASHEDSTRING_INLINE_LENGTH chars) are stored inline without heap allocation.
+ * Hash of string is calculated once on assign and carried with string, so using it as key
+ * in hash tables not need recalculate hash on each lookup, and comparison of different strings
+ * is failed on hashes without comparing chars.
+ * For lookup by CStringView in hash tables use MakeLookupKey, it not copies chars of view
+ */
+class CHashedString
+{
+public:
+	/**
+	 * @brief Functions to extract the CHashedString as a key for std::unordered_map and std::unordered_set
+	 */
+	struct SHashedStringKeyFunc
+	{
+		/**
+		 * @brief Get hash of the CHashedString
+		 *
+		 * @param InString	String
+		 * @return Return hash of this CHashedString
+		 */
+		FORCEINLINE std::size_t operator()( const CHashedString& InString ) const
+		{
+			return ( std::size_t )InString.GetHash();
+		}
+	};
+
+	friend CArchive& operator<<( CArchive& InArchive, CHashedString& InValue );
+	friend CArchive& operator<<( CArchive& InArchive, const CHashedString& InValue );
+
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE CHashedString()
+		: data( inlineData )
+		, length( 0 )
+		, bBorrowed( false )
+		, hash( appStrHash( TEXT( "" ), 0 ) )
+	{
+		inlineData[ 0 ] = TEXT( '\0' );
+	}
+
+	/**
+	 * @brief Constructor
+	 * @param InString	String
+	 */
+	FORCEINLINE CHashedString( const CStringView& InString )
+		: data( inlineData )
+		, length( 0 )
+		, bBorrowed( false )
+		, hash( 0 )
+	{
+		Assign( InString );
+	}
+
+	/**
+	 * @brief Constructor
+	 * @param InString	String
+	 */
+	FORCEINLINE CHashedString( const tchar* InString )
+		: CHashedString( CStringView( InString ) )
+	{}
+
+	/**
+	 * @brief Constructor
+	 * @param InString	String
+	 */
+	FORCEINLINE CHashedString( const std::wstring& InString )
+		: CHashedString( CStringView( InString ) )
+	{}
+
+	/**
+	 * @brief Copy constructor
+	 * @param InOther	Other string
+	 */
+	FORCEINLINE CHashedString( const CHashedString& InOther )
+		: data( inlineData )
+		, length( 0 )
+		, bBorrowed( false )
+		, hash( 0 )
+	{
+		Assign( InOther, InOther.hash );
+	}
+
+	/**
+	 * @brief Move constructor
+	 * @param InOther	Other string
+	 */
+	FORCEINLINE CHashedString( CHashedString&& InOther )
+		: data( inlineData )
+		, length( 0 )
+		, bBorrowed( false )
+		, hash( 0 )
+	{
+		MoveFrom( InOther );
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	FORCEINLINE ~CHashedString()
+	{
+		FreeData();
+	}
+
+	/**
+	 * @brief Make key for lookup in hash tables, it points to chars of view without copying them
+	 * @warning Key must not outlive the view and its c_str() isn't null-terminated, copy of key is usual string
+	 *
+	 * @param InString	String
+	 * @return Return key for lookup
+	 */
+	static FORCEINLINE CHashedString MakeLookupKey( const CStringView& InString )
+	{
+		return CHashedString( InString, SLookupKeyTag() );
+	}
+
+	/**
+	 * @brief Create string from UTF-8
+	 *
+	 * @param InString	String in UTF-8
+	 * @return Return created string
+	 */
+	static CHashedString FromUTF8( const achar* InString );
+
+	/**
+	 * @brief Convert string to UTF-8
+	 * @return Return string in UTF-8
+	 */
+	std::string ToUTF8() const;
+
+	/**
+	 * @brief Get pointer to null-terminated string
+	 * @return Return pointer to null-terminated string
+	 */
+	FORCEINLINE const tchar* c_str() const
+	{
+		return data;
+	}
+
+	/**
+	 * @brief Get length of string
+	 * @return Return length of string
+	 */
+	FORCEINLINE uint32 GetLength() const
+	{
+		return length;
+	}
+
+	/**
+	 * @brief Get hash of string
+	 * @return Return hash of string, it equal to hash of CStringView with the same chars
+	 */
+	FORCEINLINE uint64 GetHash() const
+	{
+		return hash;
+	}
+
+	/**
+	 * @brief Is empty string
+	 * @return Return TRUE if string is empty, otherwise will return FALSE
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return length == 0;
+	}
+
+	/**
+	 * @brief Is string stored inline
+	 * @return Return TRUE if string stored inline without heap allocation
+	 */
+	FORCEINLINE bool IsInline() const
+	{
+		return data == inlineData;
+	}
+
+	/**
+	 * @brief Get view of string
+	 * @return Return view of string
+	 */
+	FORCEINLINE CStringView ToView() const
+	{
+		return CStringView( data, length );
+	}
+
+	/**
+	 * @brief Convert to std::wstring
+	 * @return Return copy of string in std::wstring
+	 */
+	FORCEINLINE std::wstring ToString() const
+	{
+		return std::wstring( data, length );
+	}
+
+	/**
+	 * @brief Overload operator for cast to CStringView
+	 */
+	FORCEINLINE operator CStringView() const
+	{
+		return ToView();
+	}
+
+	/**
+	 * @brief Assignment operator
+	 */
+	FORCEINLINE CHashedString& operator=( const CHashedString& InOther )
+	{
+		if ( this != &InOther )
+		{
+			Assign( InOther, InOther.hash );
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 */
+	FORCEINLINE CHashedString& operator=( CHashedString&& InOther )
+	{
+		if ( this != &InOther )
+		{
+			FreeData();
+			MoveFrom( InOther );
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Assignment operator
+	 */
+	FORCEINLINE CHashedString& operator=( const CStringView& InString )
+	{
+		Assign( InString );
+		return *this;
+	}
+
+	/**
+	 * @brief Compare operator
+	 */
+	FORCEINLINE bool operator==( const CHashedString& InOther ) const
+	{
+		return hash == InOther.hash && ToView() == InOther.ToView();
+	}
+
+	/**
+	 * @brief Compare operator
+	 */
+	FORCEINLINE bool operator!=( const CHashedString& InOther ) const
+	{
+		return !operator==( InOther );
+	}
+
+	/**
+	 * @brief Compare operator
+	 */
+	FORCEINLINE bool operator==( const CStringView& InOther ) const
+	{
+		return ToView() == InOther;
+	}
+
+	/**
+	 * @brief Compare operator
+	 */
+	FORCEINLINE bool operator!=( const CStringView& InOther ) const
+	{
+		return !operator==( InOther );
+	}
+
+	/**
+	 * @brief Less operator, it need for sorted containers
+	 */
+	FORCEINLINE bool operator<( const CHashedString& InOther ) const
+	{
+		int32		result = wmemcmp( data, InOther.data, Min( length, InOther.length ) );
+		return result < 0 || ( result == 0 && length < InOther.length );
+	}
+
+private:
+	/**
+	 * @brief Tag of constructor for lookup key
+	 */
+	struct SLookupKeyTag
+	{};
+
+	/**
+	 * @brief Constructor of lookup key
+	 *
+	 * @param InString	String
+	 * @param InTag		Tag of lookup key
+	 */
+	FORCEINLINE CHashedString( const CStringView& InString, SLookupKeyTag InTag )
+		: data( ( tchar* )InString.GetData() )
+		, length( InString.GetLength() )
+		, bBorrowed( true )
+		, hash( InString.GetHash() )
+	{}
+
+	/**
+	 * @brief Assign new string
+	 *
+	 * @param InString	String
+	 * @param InHash	Hash of string. If INVALID_HASH, will be calculated
+	 */
+	void Assign( const CStringView& InString, uint64 InHash = INVALID_HASH );
+
+	/**
+	 * @brief Move data from other string
+	 * @param InOther	Other string, after move it will be empty
+	 */
+	void MoveFrom( CHashedString& InOther );
+
+	/**
+	 * @brief Free allocated data
+	 */
+	FORCEINLINE void FreeData()
+	{
+		if ( data != inlineData )
+		{
+			if ( !bBorrowed )
+			{
+				delete[] data;
+			}
+			data		= inlineData;
+			bBorrowed	= false;
+		}
+	}
+
+	tchar*		data;											/**< Pointer to string, it points to inlineData for short strings */
+	uint32		length;											/**< Length of string */
+	bool		bBorrowed;										/**< Is data borrowed from view (see MakeLookupKey) */
+	uint64		hash;											/**< Hash of string */
+	tchar		inlineData[ HASHEDSTRING_INLINE_LENGTH + 1 ];	/**< Inline storage for short strings */
+};
+
+#endif // !HASHEDSTRING_H
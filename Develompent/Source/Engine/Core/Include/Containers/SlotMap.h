@@ -0,0 +1,314 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SLOTMAP_H
+#define SLOTMAP_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+
+/**
+ * @ingroup Core
+ * @brief Handle of element in TSlotMap
+ *
+ * Handle stores index of slot and generation of element in it. When element is removed generation of slot is increased,
+ * so old handles become invalid even when slot is reused by new element
+ */
+struct SSlotHandle
+{
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE SSlotHandle()
+		: index( INDEX_NONE )
+		, generation( 0 )
+	{}
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InIndex		Index of slot
+	 * @param InGeneration	Generation of slot
+	 */
+	FORCEINLINE SSlotHandle( uint32 InIndex, uint32 InGeneration )
+		: index( InIndex )
+		, generation( InGeneration )
+	{}
+
+	/**
+	 * @brief Is handle was set
+	 * @note It doesn't mean what element is still alive, for it use TSlotMap::IsValid
+	 * @return Return TRUE if handle was set, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsSet() const
+	{
+		return index != INDEX_NONE;
+	}
+
+	/**
+	 * @brief Reset handle
+	 */
+	FORCEINLINE void Reset()
+	{
+		index		= INDEX_NONE;
+		generation	= 0;
+	}
+
+	/**
+	 * @brief Overload operator ==
+	 */
+	FORCEINLINE bool operator==( const SSlotHandle& InOther ) const
+	{
+		return index == InOther.index && generation == InOther.generation;
+	}
+
+	/**
+	 * @brief Overload operator !=
+	 */
+	FORCEINLINE bool operator!=( const SSlotHandle& InOther ) const
+	{
+		return index != InOther.index || generation != InOther.generation;
+	}
+
+	uint32		index;			/**< Index of slot */
+	uint32		generation;		/**< Generation of element in slot */
+};
+
+/**
+ * @ingroup Core
+ * @brief Container with stable generational handles
+ *
+ * Elements are stored in dense array without holes, so iteration over them is same as over std::vector.
+ * Add and remove are O(1): removed element is replaced by last one (swap and pop), slots of removed elements are reused.
+ * Because of it order of elements isn't stable, use handles for keeping references to elements
+ */
+template< typename TElement >
+class TSlotMap
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE TSlotMap()
+		: freeSlotHead( INDEX_NONE )
+	{}
+
+	/**
+	 * @brief Add element
+	 *
+	 * @param InElement		Element
+	 * @return Return handle of added element
+	 */
+	FORCEINLINE SSlotHandle Add( const TElement& InElement )
+	{
+		// Take free slot or allocate new one
+		uint32		slotIndex = freeSlotHead;
+		if ( slotIndex != INDEX_NONE )
+		{
+			freeSlotHead = slots[ slotIndex ].denseIndex;
+		}
+		else
+		{
+			slotIndex = ( uint32 )slots.size();
+			slots.push_back( SSlot() );
+		}
+
+		SSlot&		slot = slots[ slotIndex ];
+		slot.denseIndex = ( uint32 )elements.size();
+		elements.push_back( InElement );
+		denseToSlot.push_back( slotIndex );
+		return SSlotHandle( slotIndex, slot.generation );
+	}
+
+	/**
+	 * @brief Remove element
+	 *
+	 * @param InHandle	Handle of element
+	 * @return Return TRUE if element was removed, FALSE if handle is stale
+	 */
+	FORCEINLINE bool Remove( const SSlotHandle& InHandle )
+	{
+		if ( !IsValid( InHandle ) )
+		{
+			return false;
+		}
+
+		// Move last element to place of removed one
+		SSlot&		slot = slots[ InHandle.index ];
+		uint32		denseIndex = slot.denseIndex;
+		uint32		lastDenseIndex = ( uint32 )elements.size() - 1;
+		if ( denseIndex != lastDenseIndex )
+		{
+			uint32		lastSlotIndex = denseToSlot[ lastDenseIndex ];
+			elements[ denseIndex ]				= std::move( elements[ lastDenseIndex ] );
+			denseToSlot[ denseIndex ]			= lastSlotIndex;
+			slots[ lastSlotIndex ].denseIndex	= denseIndex;
+		}
+		elements.pop_back();
+		denseToSlot.pop_back();
+
+		// Invalidate all handles to this slot and put it to free list
+		++slot.generation;
+		slot.denseIndex		= freeSlotHead;
+		freeSlotHead		= InHandle.index;
+		return true;
+	}
+
+	/**
+	 * @brief Remove all elements
+	 * @note All handles become invalid, slots are kept for reuse
+	 */
+	FORCEINLINE void Empty()
+	{
+		for ( uint32 index = 0, count = ( uint32 )denseToSlot.size(); index < count; ++index )
+		{
+			uint32		slotIndex = denseToSlot[ index ];
+			SSlot&		slot = slots[ slotIndex ];
+			++slot.generation;
+			slot.denseIndex		= freeSlotHead;
+			freeSlotHead		= slotIndex;
+		}
+		elements.clear();
+		denseToSlot.clear();
+	}
+
+	/**
+	 * @brief Reserve memory for elements
+	 * @param InNumElements		Number of elements
+	 */
+	FORCEINLINE void Reserve( uint32 InNumElements )
+	{
+		elements.reserve( InNumElements );
+		denseToSlot.reserve( InNumElements );
+		slots.reserve( InNumElements );
+	}
+
+	/**
+	 * @brief Is handle points to alive element
+	 *
+	 * @param InHandle	Handle of element
+	 * @return Return TRUE if element is alive, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsValid( const SSlotHandle& InHandle ) const
+	{
+		return InHandle.index < slots.size() && slots[ InHandle.index ].generation == InHandle.generation;
+	}
+
+	/**
+	 * @brief Find element
+	 *
+	 * @param InHandle	Handle of element
+	 * @return Return pointer to element, if handle is stale returns NULL
+	 */
+	FORCEINLINE TElement* Find( const SSlotHandle& InHandle )
+	{
+		return IsValid( InHandle ) ? elements.data() + slots[ InHandle.index ].denseIndex : nullptr;
+	}
+
+	/**
+	 * @brief Find element
+	 *
+	 * @param InHandle	Handle of element
+	 * @return Return pointer to element, if handle is stale returns NULL
+	 */
+	FORCEINLINE const TElement* Find( const SSlotHandle& InHandle ) const
+	{
+		return IsValid( InHandle ) ? elements.data() + slots[ InHandle.index ].denseIndex : nullptr;
+	}
+
+	/**
+	 * @brief Get handle of element by dense index
+	 *
+	 * @param InIndex	Index in dense array
+	 * @return Return handle of element
+	 */
+	FORCEINLINE SSlotHandle GetHandle( uint32 InIndex ) const
+	{
+		check( InIndex < denseToSlot.size() );
+		uint32		slotIndex = denseToSlot[ InIndex ];
+		return SSlotHandle( slotIndex, slots[ slotIndex ].generation );
+	}
+
+	/**
+	 * @brief Get dense array of elements
+	 * @return Return dense array of elements
+	 */
+	FORCEINLINE const std::vector<TElement>& GetElements() const
+	{
+		return elements;
+	}
+
+	/**
+	 * @brief Get number of elements
+	 * @return Return number of elements
+	 */
+	FORCEINLINE uint32 Num() const
+	{
+		return ( uint32 )elements.size();
+	}
+
+	/**
+	 * @brief Is empty
+	 * @return Return TRUE if container is empty, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return elements.empty();
+	}
+
+	/**
+	 * @brief Overload operator []
+	 *
+	 * @param InIndex	Index in dense array
+	 * @return Return element
+	 */
+	FORCEINLINE TElement& operator[]( uint32 InIndex )
+	{
+		check( InIndex < elements.size() );
+		return elements[ InIndex ];
+	}
+
+	/**
+	 * @brief Overload operator []
+	 *
+	 * @param InIndex	Index in dense array
+	 * @return Return element
+	 */
+	FORCEINLINE const TElement& operator[]( uint32 InIndex ) const
+	{
+		check( InIndex < elements.size() );
+		return elements[ InIndex ];
+	}
+
+private:
+	/**
+	 * @brief Slot of element
+	 */
+	struct SSlot
+	{
+		/**
+		 * @brief Constructor
+		 */
+		FORCEINLINE SSlot()
+			: denseIndex( INDEX_NONE )
+			, generation( 1 )
+		{}
+
+		uint32		denseIndex;		/**< Index in dense array. For free slot it's index of next free slot */
+		uint32		generation;		/**< Generation, starts from 1 so default handle is never valid */
+	};
+
+	std::vector<TElement>		elements;		/**< Dense array of elements */
+	std::vector<uint32>			denseToSlot;	/**< Index of slot for each element in dense array */
+	std::vector<SSlot>			slots;			/**< Slots */
+	uint32						freeSlotHead;	/**< Index of first free slot */
+};
+
+#endif // !SLOTMAP_H
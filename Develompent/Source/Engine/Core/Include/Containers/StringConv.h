@@ -14,6 +14,32 @@
 #include "Core.h"
 #include "Misc/Types.h"
 
+/**
+ * @ingroup Core
+ * @brief Convert UTF-8 string to TCHAR string
+ * 
+ * Destination buffer must have space at least for InLength + 1 chars. Invalid sequences are replaced by '?'
+ * 
+ * @param InSource	Source string in UTF-8
+ * @param InLength	Length of source string in bytes
+ * @param OutDest	Destination buffer
+ * @return Return number of written chars without the null terminator
+ */
+uint32 appUTF8ToTCHAR( const achar* InSource, uint32 InLength, tchar* OutDest );
+
+/**
+ * @ingroup Core
+ * @brief Convert TCHAR string to UTF-8 string
+ *
+ * Destination buffer must have space at least for InLength * 4 + 1 bytes
+ *
+ * @param InSource	Source string
+ * @param InLength	Length of source string in chars
+ * @param OutDest	Destination buffer
+ * @return Return number of written bytes without the null terminator
+ */
+uint32 appTCHARToUTF8( const tchar* InSource, uint32 InLength, achar* OutDest );
+
 /**
  * @ingroup Core
  * @brief Class that handles the ANSI to TCHAR conversion
@@ -114,6 +140,89 @@ public:
 	}
 };
 
+/**
+ * @ingroup Core
+ * @brief Class that handles the UTF-8 to TCHAR conversion
+ */
+class CUTF8ToTCHAR_Convert
+{
+public:
+	/**
+	 * @brief Converts the string to the desired format
+	 *
+	 * Converts the string to the desired format. Allocates memory if the
+	 * specified destination buffer isn't large enough
+	 *
+	 * @param[in] InSource The source string to convert
+	 * @param[in] InDest The destination buffer that holds the converted data
+	 * @param[in] InSize The size of the dest buffer in chars
+	 * @return Return converted string
+	 */
+	FORCEINLINE tchar*				Convert( const achar* InSource, tchar* InDest, uint32 InSize )
+	{
+		// Number of code units in TCHAR never more than number of bytes in UTF-8
+		uint32		length = ( uint32 )strlen( InSource ) + 1;
+		if ( length > InSize )
+		{
+			InDest = new tchar[ length ];
+		}
+
+		appUTF8ToTCHAR( InSource, length - 1, InDest );
+		return InDest;
+	}
+
+	/**
+	 * @brief Get length of string
+	 * @return Return the string length without the null terminator
+	 */
+	FORCEINLINE uint32				GetLength( tchar* InDest )
+	{
+		return ( uint32 )wcslen( InDest );
+	}
+};
+
+/**
+ * @ingroup Core
+ * @brief Class that handles the TCHAR to UTF-8 conversion
+ */
+class CTCHARToUTF8_Convert
+{
+public:
+	/**
+	 * @brief Converts the string to the desired format
+	 *
+	 * Converts the string to the desired format. Allocates memory if the
+	 * specified destination buffer isn't large enough
+	 *
+	 * @param[in] InSource The source string to convert
+	 * @param[in] InDest The destination buffer that holds the converted data
+	 * @param[in] InSize The size of the dest buffer in chars
+	 * @return Return converted string
+	 */
+	FORCEINLINE achar*				Convert( const tchar* InSource, achar* InDest, uint32 InSize )
+	{
+		// One TCHAR is encoded to maximum 4 bytes in UTF-8
+		uint32		lengthW = ( uint32 )wcslen( InSource );
+		uint32		lengthA = lengthW * 4 + 1;
+		if ( lengthA > InSize )
+		{
+			InDest = new achar[ lengthA ];
+		}
+
+		appTCHARToUTF8( InSource, lengthW, InDest );
+		return InDest;
+	}
+
+	/**
+	 * @brief Get length of string
+	 * @return Return the string length without the null terminator
+	 */
+	FORCEINLINE uint32				GetLength( achar* InDest )
+	{
+		return ( uint32 )strlen( InDest );
+	}
+};
+
 /**
  * @ingroup Core
  * @brief Class takes one type of string and converts it to another
@@ -225,4 +334,36 @@ typedef TStringConversion< achar, tchar, CTCHARToANSI_Convert >			TCHARToANSI;
   */
 #define TCHAR_TO_ANSI( InString )				( achar* )TCHARToANSI( ( const tchar* )InString )
 
+/**
+ * @ingroup Core
+ * @brief Typedef for conversion from UTF-8 to TCHAR
+ */
+typedef TStringConversion< tchar, achar, CUTF8ToTCHAR_Convert >			UTF8ToTCHAR;
+
+/**
+ * @ingroup Core
+ * @brief Typedef for conversion from TCHAR to UTF-8
+ */
+typedef TStringConversion< achar, tchar, CTCHARToUTF8_Convert >			TCHARToUTF8;
+
+/**
+ * @ingroup Core
+ * @brief Convert from UTF-8 to TCHAR
+ *
+ * @param[in] InString Input string for conversion
+ *
+ * Example usage: @code UTF8_TO_TCHAR( u8"Hello" ) @endcode
+ */
+#define UTF8_TO_TCHAR( InString )				( tchar* )UTF8ToTCHAR( ( const achar* )InString )
+
+/**
+ * @ingroup Core
+ * @brief Convert from TCHAR to UTF-8
+ *
+ * @param[in] InString Input string for conversion
+ *
+ * Example usage: @code TCHAR_TO_UTF8( TEXT( "Hello" ) ) @endcode
+ */
+#define TCHAR_TO_UTF8( InString )				( achar* )TCHARToUTF8( ( const tchar* )InString )
+
 #endif // !STRINGCONV_H
\ No newline at end of file
@@ -0,0 +1,189 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef STRINGVIEW_H
+#define STRINGVIEW_H
+
+#include <string>
+#include <wchar.h>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "Misc/Template.h"
+#include "System/MemoryBase.h"
+
+/**
+ * @ingroup Core
+ * @brief Calculate hash of string
+ * It is the same hash as appCalcHash, so strings of all engine types with equal chars have equal hashes
+ *
+ * @param InString	Pointer to string
+ * @param InLength	Length of string
+ * @return Return hash of string
+ */
+FORCEINLINE uint64 appStrHash( const tchar* InString, uint32 InLength )
+{
+	return appMemFastHash( InString, ( uint64 )InLength * sizeof( tchar ) );
+}
+
+/**
+ * @ingroup Core
+ * @brief Non-owning view of wide string
+ *
+ * Use it for parameters of functions which only read string, then callers may pass
+ * string literal, std::wstring or CHashedString without creating temporary std::wstring.
+ * View not guarantee null terminator at the end, so use GetLength() for iteration
+ */
+class CStringView
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	FORCEINLINE CStringView()
+		: data( TEXT( "" ) )
+		, length( 0 )
+	{}
+
+	/**
+	 * @brief Constructor
+	 * @param InString	Null-terminated string
+	 */
+	FORCEINLINE CStringView( const tchar* InString )
+		: data( InString ? InString : TEXT( "" ) )
+		, length( InString ? ( uint32 )wcslen( InString ) : 0 )
+	{}
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InString	Pointer to string
+	 * @param InLength	Length of string
+	 */
+	FORCEINLINE CStringView( const tchar* InString, uint32 InLength )
+		: data( InString )
+		, length( InLength )
+	{}
+
+	/**
+	 * @brief Constructor
+	 * @param InString	String
+	 */
+	FORCEINLINE CStringView( const std::wstring& InString )
+		: data( InString.c_str() )
+		, length( ( uint32 )InString.size() )
+	{}
+
+	/**
+	 * @brief Get pointer to data
+	 * @return Return pointer to data
+	 */
+	FORCEINLINE const tchar* GetData() const
+	{
+		return data;
+	}
+
+	/**
+	 * @brief Get length of string
+	 * @return Return length of string
+	 */
+	FORCEINLINE uint32 GetLength() const
+	{
+		return length;
+	}
+
+	/**
+	 * @brief Is empty string
+	 * @return Return TRUE if string is empty, otherwise will return FALSE
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return length == 0;
+	}
+
+	/**
+	 * @brief Calculate hash of string
+	 * @return Return hash of string
+	 */
+	FORCEINLINE uint64 GetHash() const
+	{
+		return appStrHash( data, length );
+	}
+
+	/**
+	 * @brief Find char in string
+	 *
+	 * @param InChar		Char
+	 * @param InStartIndex	Start index
+	 * @return Return index of char, if not found will return INDEX_NONE
+	 */
+	FORCEINLINE uint32 Find( tchar InChar, uint32 InStartIndex = 0 ) const
+	{
+		for ( uint32 index = InStartIndex; index < length; ++index )
+		{
+			if ( data[ index ] == InChar )
+			{
+				return index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/**
+	 * @brief Get part of string
+	 *
+	 * @param InIndex	Start index
+	 * @param InLength	Length of part. If it greater then remaining length, will be clamped
+	 * @return Return view of part of string
+	 */
+	FORCEINLINE CStringView SubStr( uint32 InIndex, uint32 InLength = INDEX_NONE ) const
+	{
+		check( InIndex <= length );
+		return CStringView( data + InIndex, Min( InLength, length - InIndex ) );
+	}
+
+	/**
+	 * @brief Convert to std::wstring
+	 * @return Return copy of string in std::wstring
+	 */
+	FORCEINLINE std::wstring ToString() const
+	{
+		return std::wstring( data, length );
+	}
+
+	/**
+	 * @brief Overload operator []
+	 */
+	FORCEINLINE tchar operator[]( uint32 InIndex ) const
+	{
+		check( InIndex < length );
+		return data[ InIndex ];
+	}
+
+	/**
+	 * @brief Compare operator
+	 */
+	FORCEINLINE bool operator==( const CStringView& InOther ) const
+	{
+		return length == InOther.length && ( data == InOther.data || !memcmp( data, InOther.data, length * sizeof( tchar ) ) );
+	}
+
+	/**
+	 * @brief Compare operator
+	 */
+	FORCEINLINE bool operator!=( const CStringView& InOther ) const
+	{
+		return !operator==( InOther );
+	}
+
+private:
+	const tchar*		data;		/**< Pointer to string */
+	uint32				length;		/**< Length of string */
+};
+
+#endif // !STRINGVIEW_H
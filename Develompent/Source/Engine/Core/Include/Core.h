@@ -228,6 +228,27 @@ extern void appShowMessageBox( const tchar* InTitle, const tchar* InMessage, EMe
  */
 extern void appDumpCallStack( std::wstring& OutCallStack );
 
+/**
+ * @ingroup Core
+ * @brief Capture addresses of current call stack
+ * It is fast and not resolve symbols, use appProgramCounterToString for it
+ * 
+ * @param OutBackTrace  Output array of program counters
+ * @param InMaxDepth    Max depth of call stack
+ * @param InSkipFrames  Number of skipped frames from top of the stack
+ * @return Return number of captured frames
+ */
+extern uint32 appCaptureStackBackTrace( uint64* OutBackTrace, uint32 InMaxDepth, uint32 InSkipFrames = 0 );
+
+/**
+ * @ingroup Core
+ * @brief Convert program counter to human readable string (function, file and line)
+ * 
+ * @param InProgramCounter  Program counter
+ * @return Return human readable string of program counter
+ */
+extern std::wstring appProgramCounterToString( uint64 InProgramCounter );
+
 /**
  * @ingroup Core
  * @brief Request shutdown application
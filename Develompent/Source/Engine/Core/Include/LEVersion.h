@@ -50,6 +50,9 @@ enum ELifeEnginePackageVersion
 	VER_AssetName_V3						= 18,					/**< Moved asset name to CAsset */
 	VER_AssetOnlyEditor						= 19,					/**< Added field 'bOnlyEditor' to asset */
 	VER_CName								= 20,					/**< Added CName for IDs in string view */
+	VER_WorldClassTable						= 21,					/**< Added class table and blob with data of actors in world */
+	VER_WorldPartition						= 22,					/**< Added cells of world partition for streaming static actors */
+	VER_StaticMeshLODs						= 23,					/**< Added LODs to static mesh */
 
 	//
 	// New versions can be added here
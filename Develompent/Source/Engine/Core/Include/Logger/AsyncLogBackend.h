@@ -0,0 +1,491 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ASYNCLOGBACKEND_H
+#define ASYNCLOGBACKEND_H
+
+#include <string>
+#include <vector>
+#include <type_traits>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "Misc/Misc.h"
+#include "Misc/Template.h"
+#include "Misc/CoreGlobals.h"
+#include "Logger/BaseLogger.h"
+#include "Logger/LogRecord.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Core
+ * Enumeration of behaviour when buffer of thread is full
+ */
+enum ELogOverflowPolicy
+{
+	LOP_Drop,			/**< Drop new messages and report about it later */
+	LOP_Block			/**< Wait until log thread frees space in buffer */
+};
+
+/**
+ * @ingroup Core
+ * Enumeration of chunks in binary log file
+ */
+enum ELogBinaryChunk
+{
+	LBC_Format,			/**< Format string: ID and string */
+	LBC_Record			/**< Log record: size and raw record (SLogRecordHeader with arguments) */
+};
+
+/**
+ * @ingroup Core
+ * Settings of asynchronous logging
+ */
+struct SAsyncLogSettings
+{
+	/**
+	 * Constructor
+	 */
+	SAsyncLogSettings()
+		: bEnable( false )
+		, bBinary( false )
+		, threadBufferSize( 256 * 1024 )
+		, flushInterval( 10 )
+		, overflowPolicy( LOP_Block )
+	{}
+
+	/**
+	 * Load settings from engine config (section 'Engine.Log')
+	 */
+	void LoadFromConfig();
+
+	bool					bEnable;				/**< Is enabled asynchronous logging */
+	bool					bBinary;				/**< Is need write messages into binary log file instead of formatting them */
+	uint32					threadBufferSize;		/**< Size of ring buffer for each thread in bytes */
+	uint32					flushInterval;			/**< Interval in milliseconds between flushes on log thread */
+	ELogOverflowPolicy		overflowPolicy;			/**< Behaviour when buffer of thread is full */
+};
+
+/**
+ * @ingroup Core
+ * Statistics of asynchronous logging
+ */
+struct SAsyncLogStats
+{
+	/**
+	 * Constructor
+	 */
+	SAsyncLogStats()
+		: numThreadBuffers( 0 )
+		, numRecords( 0 )
+		, numDropped( 0 )
+		, numBlocked( 0 )
+		, numBinaryBytes( 0 )
+	{}
+
+	uint32		numThreadBuffers;		/**< Number of registered thread buffers */
+	uint64		numRecords;				/**< Number of pushed records */
+	uint64		numDropped;				/**< Number of dropped records */
+	uint64		numBlocked;				/**< Number of times when producer waited free space */
+	uint64		numBinaryBytes;			/**< Number of bytes written into binary log */
+};
+
+/**
+ * @ingroup Core
+ * Lock-free ring buffer of log records for one thread. One writer (owner thread) and one reader (log thread)
+ */
+class CLogThreadBuffer
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param InSize		Size of buffer in bytes
+	 * @param InThreadId	ID of owner thread
+	 */
+	CLogThreadBuffer( uint32 InSize, uint32 InThreadId );
+
+	/**
+	 * Destructor
+	 */
+	~CLogThreadBuffer();
+
+	/**
+	 * Begin write record into buffer. Called only from owner thread
+	 *
+	 * @param InSize	Size of record (aligned to LOG_RECORD_ALIGNMENT)
+	 * @return Return pointer to memory for record, if buffer is full return nullptr
+	 */
+	byte* BeginWrite( uint32 InSize );
+
+	/**
+	 * End write record and publish it to reader. Called only from owner thread
+	 */
+	FORCEINLINE void EndWrite()
+	{
+		++numRecords;
+		appInterlockedExchange( ( volatile int32* )&writeOffset, ( int32 )pendingWriteOffset );
+	}
+
+	/**
+	 * Collect all published records. Called only from log thread
+	 *
+	 * @param OutRecords	Output array of records. Records is valid until call FinishRead()
+	 */
+	void CollectRecords( std::vector< const SLogRecordHeader* >& OutRecords );
+
+	/**
+	 * Free memory of collected records for writer. Called only from log thread
+	 */
+	FORCEINLINE void FinishRead()
+	{
+		appInterlockedExchange( ( volatile int32* )&readOffset, ( int32 )pendingReadOffset );
+	}
+
+	/**
+	 * Mark that record was dropped
+	 */
+	FORCEINLINE void MarkDropped()
+	{
+		++numDropped;
+	}
+
+	/**
+	 * Mark that writer waited free space
+	 */
+	FORCEINLINE void MarkBlocked()
+	{
+		++numBlocked;
+	}
+
+	/**
+	 * Get number of dropped records which not reported yet. Called only from log thread
+	 * @return Return number of dropped records which not reported yet
+	 */
+	FORCEINLINE uint32 TakeUnreportedDropped()
+	{
+		uint32		currentDropped = numDropped;
+		uint32		result = currentDropped - numReportedDropped;
+		numReportedDropped = currentDropped;
+		return result;
+	}
+
+	/**
+	 * Get ID of owner thread
+	 * @return Return ID of owner thread
+	 */
+	FORCEINLINE uint32 GetThreadId() const
+	{
+		return threadId;
+	}
+
+	/**
+	 * Get number of pushed records
+	 * @return Return number of pushed records
+	 */
+	FORCEINLINE uint32 GetNumRecords() const
+	{
+		return numRecords;
+	}
+
+	/**
+	 * Get number of dropped records
+	 * @return Return number of dropped records
+	 */
+	FORCEINLINE uint32 GetNumDropped() const
+	{
+		return numDropped;
+	}
+
+	/**
+	 * Get number of times when writer waited free space
+	 * @return Return number of times when writer waited free space
+	 */
+	FORCEINLINE uint32 GetNumBlocked() const
+	{
+		return numBlocked;
+	}
+
+private:
+	byte*				data;					/**< Data of buffer */
+	uint32				size;					/**< Size of buffer */
+	uint32				threadId;				/**< ID of owner thread */
+	byte				padding0[ 64 ];			/**< Padding for split writer and reader data by cache lines */
+
+	volatile uint32		writeOffset;			/**< Published write offset */
+	uint32				pendingWriteOffset;		/**< Write offset after end of current write */
+	volatile uint32		numRecords;				/**< Number of pushed records */
+	volatile uint32		numDropped;				/**< Number of dropped records */
+	volatile uint32		numBlocked;				/**< Number of times when writer waited free space */
+	byte				padding1[ 64 ];			/**< Padding for split writer and reader data by cache lines */
+
+	volatile uint32		readOffset;				/**< Published read offset */
+	uint32				pendingReadOffset;		/**< Read offset after collected records */
+	uint32				numReportedDropped;		/**< Number of dropped records which already reported */
+};
+
+/**
+ * @ingroup Core
+ * @brief Asynchronous logging backend
+ *
+ * Captures ID of format string and raw arguments into lock-free ring buffer of calling thread,
+ * formatting and writing to output device (or binary log file) is doing on log thread
+ */
+class CAsyncLogBackend : public CRunnable
+{
+public:
+	/**
+	 * Constructor
+	 */
+	CAsyncLogBackend();
+
+	/**
+	 * Destructor
+	 */
+	~CAsyncLogBackend();
+
+	/**
+	 * Start log thread
+	 *
+	 * @param InSettings	Settings of asynchronous logging
+	 */
+	void Start( const SAsyncLogSettings& InSettings );
+
+	/**
+	 * Flush all messages and stop log thread
+	 */
+	void Shutdown();
+
+	/**
+	 * Push log message into ring buffer of current thread
+	 *
+	 * @param InCallSite		Call site of message
+	 * @param InColor			Text color
+	 * @param InLogType			Log type
+	 * @param InLogCategory		Log category
+	 * @param InFormat			Format string
+	 * @param InIsStaticFormat	Is format string has static storage (string literal). If it is not, the format string will be copied into record
+	 * @param InArgs			Arguments of message
+	 * @return Return FALSE if log thread is stopping and message must be written on calling thread, otherwise returns TRUE (also when message is dropped)
+	 */
+	template< typename... TArgs >
+	FORCEINLINE bool Push( SLogCallSite& InCallSite, ELogColor InColor, ELogType InLogType, ELogCategory InLogCategory, const tchar* InFormat, bool InIsStaticFormat, const TArgs&... InArgs )
+	{
+		static_assert( sizeof...( TArgs ) < 255, "Too many arguments of log message" );
+
+		// Shutdown waits for threads which are pushing records before the last flush, so any accepted record is written
+		appInterlockedIncrement( &numActivePushes );
+		if ( !bIsRunning )
+		{
+			appInterlockedDecrement( &numActivePushes );
+			return false;
+		}
+
+		// Get ID of format string, if it static we cache him in call site
+		uint32		formatId = LOG_DYNAMIC_FORMAT_ID;
+		uint32		recordSize = sizeof( SLogRecordHeader ) + ( 0 + ... + SLogArgument::GetSize( InArgs ) );
+		if ( InIsStaticFormat )
+		{
+			formatId = InCallSite.GetFormatId();
+			if ( formatId == LOG_DYNAMIC_FORMAT_ID )
+			{
+				formatId = RegisterFormat( InCallSite, InFormat );
+			}
+		}
+		else
+		{
+			recordSize += SLogArgument::GetSize( InFormat );
+		}
+		recordSize = Align( recordSize, LOG_RECORD_ALIGNMENT );
+
+		// Allocate record in buffer of current thread, if it failed then record was dropped
+		CLogThreadBuffer*	threadBuffer = nullptr;
+		SLogRecordHeader*	record = ( SLogRecordHeader* )AllocateRecord( recordSize, threadBuffer );
+		if ( !record )
+		{
+			appInterlockedDecrement( &numActivePushes );
+			return true;
+		}
+
+		record->size			= recordSize;
+		record->formatId		= formatId;
+		record->time			= appSeconds() - GStartTime;
+		record->threadId		= appGetCurrentThreadId();
+		record->type			= ( uint8 )InLogType;
+		record->category		= ( uint8 )InLogCategory;
+		record->color			= ( uint8 )InColor;
+		record->numArguments	= ( uint8 )( sizeof...( TArgs ) + ( InIsStaticFormat ? 0 : 1 ) );
+
+		byte*		dest = ( byte* )( record + 1 );
+		if ( !InIsStaticFormat )
+		{
+			dest = SLogArgument::Write( dest, InFormat );
+		}
+		( ( dest = SLogArgument::Write( dest, InArgs ) ), ... );
+		CommitRecord( record, threadBuffer );
+		appInterlockedDecrement( &numActivePushes );
+		return true;
+	}
+
+	/**
+	 * Format and write all pushed messages. Can be called from any thread
+	 */
+	void Flush();
+
+	/**
+	 * Get statistics
+	 * @return Return statistics of asynchronous logging
+	 */
+	SAsyncLogStats GetStats() const;
+
+	/**
+	 * Is running log thread
+	 * @return Return TRUE if log thread is running and accepts new records, otherwise return FALSE
+	 */
+	FORCEINLINE bool IsRunning() const
+	{
+		return bIsRunning;
+	}
+
+	/**
+	 * Initialize log thread
+	 * @return Return TRUE if initialization was successful
+	 */
+	virtual bool Init() override;
+
+	/**
+	 * Main loop of log thread
+	 * @return Return exit code
+	 */
+	virtual uint32 Run() override;
+
+	/**
+	 * Request stop of log thread
+	 */
+	virtual void Stop() override;
+
+	/**
+	 * Exit from log thread
+	 */
+	virtual void Exit() override;
+
+private:
+	/**
+	 * Register static format string
+	 *
+	 * @param InCallSite	Call site of message
+	 * @param InFormat		Format string
+	 * @return Return ID of format string
+	 */
+	uint32 RegisterFormat( SLogCallSite& InCallSite, const tchar* InFormat );
+
+	/**
+	 * Allocate memory for record. If record can't be placed in ring buffer of thread,
+	 * it allocates temporary memory and record will be processed immediately in CommitRecord
+	 *
+	 * @param InSize			Size of record
+	 * @param OutThreadBuffer	Output ring buffer of current thread, or nullptr if was allocated temporary memory
+	 * @return Return pointer to memory for record, if record was dropped return nullptr
+	 */
+	byte* AllocateRecord( uint32 InSize, CLogThreadBuffer*& OutThreadBuffer );
+
+	/**
+	 * Commit record
+	 *
+	 * @param InRecord			Record
+	 * @param InThreadBuffer	Ring buffer of current thread, or nullptr if record placed in temporary memory
+	 */
+	void CommitRecord( SLogRecordHeader* InRecord, CLogThreadBuffer* InThreadBuffer );
+
+	/**
+	 * Get ring buffer of current thread, if it isn't exist it will be created
+	 * @return Return ring buffer of current thread
+	 */
+	CLogThreadBuffer* GetThreadBuffer();
+
+	/**
+	 * Format and write one record. Must be called under lock of flushCS
+	 * @param InRecord		Record
+	 */
+	void ProcessRecord( const SLogRecordHeader* InRecord );
+
+	/**
+	 * Write record into binary log
+	 * @param InRecord		Record
+	 */
+	void WriteBinaryRecord( const SLogRecordHeader* InRecord );
+
+	volatile bool								bIsRunning;				/**< Is log thread accepting new records */
+	volatile bool								bIsStopping;			/**< Is requested stop of log thread */
+	volatile int32								numActivePushes;		/**< Number of threads which are pushing records now */
+	uint32										logThreadId;			/**< ID of log thread */
+	SAsyncLogSettings							settings;				/**< Settings */
+	CRunnableThread*							logThread;				/**< Log thread */
+	CEvent*										wakeUpEvent;			/**< Event for wake up log thread */
+	mutable CCriticalSection					buffersCS;				/**< Critical section of thread buffers */
+	std::vector< CLogThreadBuffer* >			threadBuffers;			/**< Ring buffers of all threads */
+	CCriticalSection							formatsCS;				/**< Critical section of format strings */
+	std::vector< const tchar* >					formats;				/**< Registered static format strings */
+	CCriticalSection							flushCS;				/**< Critical section of flush */
+	std::vector< const SLogRecordHeader* >		pendingRecords;			/**< Records collected for current flush */
+	std::vector< bool >							writtenFormats;			/**< Is format string already written into binary log */
+	class CArchive*								binaryArchive;			/**< Archive of binary log */
+	uint64										numBinaryBytes;			/**< Number of bytes written into binary log */
+};
+
+/**
+ * @ingroup Core
+ * Asynchronous logging backend
+ */
+extern CAsyncLogBackend			GAsyncLog;
+
+/**
+ * @ingroup Core
+ * Is format string of log message has static storage
+ */
+template< typename TFormat >
+struct TIsLogStaticFormat
+{
+	typedef std::remove_reference_t< TFormat >		Type_t;
+	enum { Value = std::is_array_v< Type_t > && std::is_const_v< std::remove_extent_t< Type_t > > };
+};
+
+/**
+ * @ingroup Core
+ * @brief Print message to log
+ *
+ * If asynchronous logging is running, message will be pushed in ring buffer of current thread.
+ * Otherwise message will be formatted and serialized immediately
+ *
+ * @param InCallSite		Call site of message
+ * @param InColor			Text color
+ * @param InLogType			Log type
+ * @param InLogCategory		Log category
+ * @param InFormat			Format string
+ * @param InArgs			Arguments of message
+ */
+template< typename TFormat, typename... TArgs >
+FORCEINLINE void appLogf( SLogCallSite& InCallSite, ELogColor InColor, ELogType InLogType, ELogCategory InLogCategory, TFormat&& InFormat, const TArgs&... InArgs )
+{
+	if ( !GAsyncLog.IsRunning() || !GAsyncLog.Push( InCallSite, InColor, InLogType, InLogCategory, InFormat, TIsLogStaticFormat< TFormat >::Value, InArgs... ) )
+	{
+		if ( InColor != LC_Default )
+		{
+			GLog->SetTextColor( InColor );
+		}
+
+		GLog->Logf( InLogType, InLogCategory, InFormat, InArgs... );
+
+		if ( InColor != LC_Default )
+		{
+			GLog->ResetTextColor();
+		}
+	}
+}
+
+#endif // !ASYNCLOGBACKEND_H
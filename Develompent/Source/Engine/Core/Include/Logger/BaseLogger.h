@@ -9,6 +9,8 @@
 #ifndef BASELOGGER_H
 #define BASELOGGER_H
 
+#include <string>
+
 #include "Core.h"
 #include "Scripts/ScriptEngine.h"
 
@@ -62,6 +64,18 @@ enum ELogColor
     LC_Green            /**< Green */
 };
 
+/**
+ * @ingroup Core
+ * @brief Names of log types
+ */
+extern const tchar*     GLogTypeNames[];
+
+/**
+ * @ingroup Core
+ * @brief Names of log categories
+ */
+extern const tchar*     GLogCategoryNames[];
+
 /**
  * @ingroup Core
  * @brief Base class of logging
@@ -93,8 +107,9 @@ public:
      * @param[in] InMessage Message
      * @param[in] InLogType Type of message
      * @param[in] InLogCategory Log category
+     * @param[in] InTime Time of message in seconds since start of application
      */
-    virtual void        Serialize( const tchar* InMessage, ELogType InLogType, ELogCategory InLogCategory ) {};
+    virtual void        Serialize( const tchar* InMessage, ELogType InLogType, ELogCategory InLogCategory, double InTime ) {};
 
     /**
      * @ingroup Core
@@ -134,6 +149,14 @@ public:
      * @brief Reset color text to default
      */
     virtual void        ResetTextColor() {}
+
+    /**
+     * @brief Get path to log file with extension
+     * 
+     * @param InExtension Extension of file (without dot)
+     * @return Return path to log file, if logger not writes to file return empty string
+     */
+    virtual std::wstring GetLogFilename( const tchar* InExtension ) const { return TEXT( "" ); }
 };
 
 #endif // !BASELOGGER_H
@@ -0,0 +1,290 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef LOGRECORD_H
+#define LOGRECORD_H
+
+#include <string>
+#include <type_traits>
+#include <string.h>
+#include <wchar.h>
+
+#include "Core.h"
+#include "Misc/Types.h"
+
+/**
+ * @ingroup Core
+ * Alignment of log record in buffers
+ */
+#define LOG_RECORD_ALIGNMENT		8
+
+/**
+ * @ingroup Core
+ * Format ID of padding record. Reader must skip to begin of buffer when he found it
+ */
+#define LOG_PADDING_FORMAT_ID		( ( uint32 )-2 )
+
+/**
+ * @ingroup Core
+ * Format ID of record with dynamic format string, it is stored as first argument of record
+ */
+#define LOG_DYNAMIC_FORMAT_ID		( ( uint32 )-1 )
+
+/**
+ * @ingroup Core
+ * Length of null string argument
+ */
+#define LOG_NULL_STRING_LENGTH		( ( uint32 )-1 )
+
+/**
+ * @ingroup Core
+ * Enumeration of types raw arguments in log record
+ */
+enum ELogArgumentType
+{
+	LAT_Int32,				/**< Signed integer 32-bit (also bool, char, short and enums) */
+	LAT_UInt32,				/**< Unsigned integer 32-bit */
+	LAT_Int64,				/**< Signed integer 64-bit */
+	LAT_UInt64,				/**< Unsigned integer 64-bit */
+	LAT_Double,				/**< Float or double */
+	LAT_Pointer,			/**< Pointer */
+	LAT_String,				/**< Copy of Unicode string */
+	LAT_AnsiString			/**< Copy of ANSI string */
+};
+
+/**
+ * @ingroup Core
+ * Call site of log message. Caches ID of static format string, so we not need register it on each call
+ */
+struct SLogCallSite
+{
+	/**
+	 * Constructor
+	 */
+	SLogCallSite()
+		: formatId( ( int32 )LOG_DYNAMIC_FORMAT_ID )
+	{}
+
+	/**
+	 * Get ID of format string
+	 * @return Return ID of format string in format table or LOG_DYNAMIC_FORMAT_ID if not registered yet
+	 */
+	FORCEINLINE uint32 GetFormatId() const
+	{
+		return ( uint32 )formatId;
+	}
+
+	volatile int32		formatId;		/**< ID of format string in format table or LOG_DYNAMIC_FORMAT_ID if not registered yet */
+};
+
+/**
+ * @ingroup Core
+ * Header of log record. After him stored raw arguments of the message
+ */
+struct SLogRecordHeader
+{
+	uint32		size;				/**< Size of record with header and arguments (aligned to LOG_RECORD_ALIGNMENT) */
+	uint32		formatId;			/**< ID of format string. If equal LOG_DYNAMIC_FORMAT_ID format string is stored as first argument */
+	double		time;				/**< Time of message in seconds since start of application */
+	uint32		threadId;			/**< ID of thread who send message */
+	uint8		type;				/**< Log type (see ELogType) */
+	uint8		category;			/**< Log category (see ELogCategory) */
+	uint8		color;				/**< Text color (see ELogColor) */
+	uint8		numArguments;		/**< Number of raw arguments after header */
+};
+
+/**
+ * @ingroup Core
+ * Helper for encoding arguments of log message into log record
+ */
+struct SLogArgument
+{
+	/**
+	 * Get size of encoded argument in bytes
+	 *
+	 * @param InValue	Value
+	 * @return Return size of encoded argument in bytes
+	 */
+	template< typename TType >
+	static FORCEINLINE uint32 GetSize( const TType& InValue )
+	{
+		typedef std::decay_t< TType >		Type_t;
+		if constexpr ( IsString< Type_t >() )
+		{
+			return sizeof( uint8 ) + sizeof( uint32 ) + ( InValue ? ( uint32 )wcslen( InValue ) : 0 ) * sizeof( tchar );
+		}
+		else if constexpr ( IsAnsiString< Type_t >() )
+		{
+			return sizeof( uint8 ) + sizeof( uint32 ) + ( InValue ? ( uint32 )strlen( InValue ) : 0 ) * sizeof( achar );
+		}
+		else
+		{
+			return sizeof( uint8 ) + GetScalarSize< Type_t >();
+		}
+	}
+
+	/**
+	 * Write argument into buffer
+	 *
+	 * @param InDest	Destination buffer
+	 * @param InValue	Value
+	 * @return Return pointer to byte after written argument
+	 */
+	template< typename TType >
+	static FORCEINLINE byte* Write( byte* InDest, const TType& InValue )
+	{
+		typedef std::decay_t< TType >		Type_t;
+		if constexpr ( IsString< Type_t >() )
+		{
+			return WriteString( InDest, LAT_String, InValue, InValue ? ( uint32 )wcslen( InValue ) : LOG_NULL_STRING_LENGTH, sizeof( tchar ) );
+		}
+		else if constexpr ( IsAnsiString< Type_t >() )
+		{
+			return WriteString( InDest, LAT_AnsiString, InValue, InValue ? ( uint32 )strlen( InValue ) : LOG_NULL_STRING_LENGTH, sizeof( achar ) );
+		}
+		else if constexpr ( std::is_floating_point_v< Type_t > )
+		{
+			return WriteScalar( InDest, LAT_Double, ( double )InValue );
+		}
+		else if constexpr ( std::is_pointer_v< Type_t > || std::is_null_pointer_v< Type_t > )
+		{
+			return WriteScalar( InDest, LAT_Pointer, ( uint64 )( const void* )InValue );
+		}
+		else
+		{
+			static_assert( std::is_integral_v< Type_t > || std::is_enum_v< Type_t >, "Log argument must be scalar type or string" );
+			if constexpr ( sizeof( Type_t ) > sizeof( uint32 ) )
+			{
+				return IsSigned< Type_t >() ? WriteScalar( InDest, LAT_Int64, ( int64 )InValue ) : WriteScalar( InDest, LAT_UInt64, ( uint64 )InValue );
+			}
+			else
+			{
+				return IsSigned< Type_t >() ? WriteScalar( InDest, LAT_Int32, ( int32 )InValue ) : WriteScalar( InDest, LAT_UInt32, ( uint32 )InValue );
+			}
+		}
+	}
+
+private:
+	/**
+	 * Is type is Unicode string
+	 * @return Return TRUE if type is Unicode string, otherwise return FALSE
+	 */
+	template< typename TType >
+	static constexpr bool IsString()
+	{
+		return std::is_same_v< TType, tchar* > || std::is_same_v< TType, const tchar* >;
+	}
+
+	/**
+	 * Is type is ANSI string
+	 * @return Return TRUE if type is ANSI string, otherwise return FALSE
+	 */
+	template< typename TType >
+	static constexpr bool IsAnsiString()
+	{
+		return std::is_same_v< TType, achar* > || std::is_same_v< TType, const achar* >;
+	}
+
+	/**
+	 * Is type is signed integer (enums are signed like in varargs)
+	 * @return Return TRUE if type is signed, otherwise return FALSE
+	 */
+	template< typename TType >
+	static constexpr bool IsSigned()
+	{
+		if constexpr ( std::is_enum_v< TType > )
+		{
+			return true;
+		}
+		else
+		{
+			return std::is_signed_v< TType >;
+		}
+	}
+
+	/**
+	 * Get size of encoded scalar value without type tag
+	 * @return Return size of encoded scalar value
+	 */
+	template< typename TType >
+	static constexpr uint32 GetScalarSize()
+	{
+		if constexpr ( std::is_floating_point_v< TType > || std::is_pointer_v< TType > || std::is_null_pointer_v< TType > || sizeof( TType ) > sizeof( uint32 ) )
+		{
+			return sizeof( uint64 );
+		}
+		else
+		{
+			return sizeof( uint32 );
+		}
+	}
+
+	/**
+	 * Write scalar value
+	 *
+	 * @param InDest	Destination buffer
+	 * @param InType	Argument type
+	 * @param InValue	Value
+	 * @return Return pointer to byte after written argument
+	 */
+	template< typename TType >
+	static FORCEINLINE byte* WriteScalar( byte* InDest, ELogArgumentType InType, TType InValue )
+	{
+		*InDest = ( uint8 )InType;
+		memcpy( InDest + 1, &InValue, sizeof( TType ) );
+		return InDest + 1 + sizeof( TType );
+	}
+
+	/**
+	 * Write string
+	 *
+	 * @param InDest		Destination buffer
+	 * @param InType		Argument type
+	 * @param InString		String
+	 * @param InLength		Length of string
+	 * @param InCharSize	Size of one char
+	 * @return Return pointer to byte after written argument
+	 */
+	static FORCEINLINE byte* WriteString( byte* InDest, ELogArgumentType InType, const void* InString, uint32 InLength, uint32 InCharSize )
+	{
+		*InDest = ( uint8 )InType;
+		memcpy( InDest + 1, &InLength, sizeof( uint32 ) );
+		InDest += 1 + sizeof( uint32 );
+
+		if ( InLength != LOG_NULL_STRING_LENGTH && InLength > 0 )
+		{
+			memcpy( InDest, InString, InLength * InCharSize );
+			InDest += InLength * InCharSize;
+		}
+		return InDest;
+	}
+};
+
+/**
+ * @ingroup Core
+ * Format log message from format string and raw arguments of log record.
+ * It is doing the same as CString::Format, but on encoded arguments
+ *
+ * @param InFormat			Format string
+ * @param InArguments		Pointer to first raw argument
+ * @param InNumArguments	Number of raw arguments
+ * @return Return formatted message
+ */
+std::wstring appFormatLogRecord( const tchar* InFormat, const byte* InArguments, uint32 InNumArguments );
+
+/**
+ * @ingroup Core
+ * Format log message from log record
+ *
+ * @param InRecord			Log record
+ * @param InFormat			Format string. If record has dynamic format (formatId == LOG_DYNAMIC_FORMAT_ID) it must be nullptr
+ * @return Return formatted message
+ */
+std::wstring appFormatLogRecord( const SLogRecordHeader* InRecord, const tchar* InFormat );
+
+#endif // !LOGRECORD_H
@@ -12,6 +12,7 @@
 #include "LEBuild.h"
 #include "Misc/CoreGlobals.h"
 #include "Logger/BaseLogger.h"
+#include "Logger/AsyncLogBackend.h"
 
 // If configuration is not shipping - we using logs for debug
 #if !NO_LOGGING || PLATFORM_DOXYGEN
@@ -19,13 +20,18 @@
 	 * @ingroup Core
 	 * @brief Macro for print message to log
 	 * @warning In shipping this macro is empty and logging disabled
+	 * @note If asynchronous logging is enabled, here only captured arguments and formatting is doing on log thread
 	 * 
 	 * @param[in] InType Type message
 	 * @param[in] InCategory Category of message
 	 * @param[in] InMessage Message
 	 * @param[in] ... Other arguments of message
 	 */
-	#define LE_LOG( InType, InCategory, InMessage, ... )				GLog->Logf( InType, InCategory, InMessage, __VA_ARGS__ )
+	#define LE_LOG( InType, InCategory, InMessage, ... ) \
+		{ \
+			static SLogCallSite		logCallSite; \
+			appLogf( logCallSite, LC_Default, InType, InCategory, InMessage, __VA_ARGS__ ); \
+		}
 	 
 	 /**
 	   * @ingroup Core
@@ -40,9 +46,8 @@
 	   */
 	#define LE_LOG_COLOR( InColor, InType, InCategory, InMessage, ...  ) \
 		{ \
-			GLog->SetTextColor( InColor ); \
-			GLog->Logf( InType, InCategory, InMessage, __VA_ARGS__ ); \
-			GLog->ResetTextColor(); \
+			static SLogCallSite		logCallSite; \
+			appLogf( logCallSite, InColor, InType, InCategory, InMessage, __VA_ARGS__ ); \
 		}
 #else
 	#define LE_LOG( InType, InCategory, InMessage, ... )
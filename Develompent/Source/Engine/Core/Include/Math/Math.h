@@ -543,6 +543,26 @@ struct SMath
 		return sqrtf( InA );
 	}
 
+	/**
+	 * @brief Natural logarithm
+	 * @param InA		Value whose logarithm is calculated
+	 * @return Natural logarithm of InA
+	 */
+	static FORCEINLINE float Loge( float InA )
+	{
+		return logf( InA );
+	}
+
+	/**
+	 * @brief Exponential function
+	 * @param InA		Value of the exponent
+	 * @return Exponential value of InA
+	 */
+	static FORCEINLINE float Exp( float InA )
+	{
+		return expf( InA );
+	}
+
 	/**
 	 * @brief Floor
 	 * 
@@ -0,0 +1,151 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TRANSFORMBATCH_H
+#define TRANSFORMBATCH_H
+
+#include "Math/Math.h"
+#include "Core.h"
+
+/**
+ * @ingroup Core
+ * @brief Is enabled SSE path of batched math. SSE2 is always available on x64, on other targets it must be enabled by compiler
+ */
+#ifndef WITH_SIMD_MATH
+	#if defined( _M_X64 ) || defined( __x86_64__ ) || defined( __SSE2__ ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define WITH_SIMD_MATH		1
+	#else
+		#define WITH_SIMD_MATH		0
+	#endif // _M_X64 || __x86_64__ || __SSE2__ || _M_IX86_FP >= 2
+#endif // !WITH_SIMD_MATH
+
+/**
+ * @ingroup Core
+ * @brief Affine matrix 3x4 in row-major order, it is transposed upper part of Matrix. Used for compact instance data on GPU
+ */
+struct SMatrix3x4
+{
+	Vector4D		rows[ 3 ];		/**< Rows of matrix, last column is translation */
+};
+
+/**
+ * @ingroup Core
+ * @brief Batched math operations with arrays of transforms
+ *
+ * Transform is split into three arrays (locations, rotations and scales), so it may be used directly with
+ * structure of arrays storage. Batched functions process four transforms at once with SSE when WITH_SIMD_MATH is 1,
+ * otherwise and for the tail they use scalar path. Result is equal to SMath::TranslateMatrix * SMath::QuaternionToMatrix * SMath::ScaleMatrix
+ */
+struct SMathBatch
+{
+	/**
+	 * @brief Convert transforms to matrices
+	 *
+	 * @param InLocations	Locations
+	 * @param InRotations	Rotations, must be normalized
+	 * @param InScales		Scales
+	 * @param OutMatrices	Output matrices
+	 * @param InCount		Number of transforms
+	 */
+	static void TransformsToMatrices( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount );
+
+	/**
+	 * @brief Convert transforms to affine matrices 3x4
+	 *
+	 * @param InLocations	Locations
+	 * @param InRotations	Rotations, must be normalized
+	 * @param InScales		Scales
+	 * @param OutMatrices	Output matrices
+	 * @param InCount		Number of transforms
+	 */
+	static void TransformsToMatrices3x4( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, SMatrix3x4* OutMatrices, uint32 InCount );
+
+	/**
+	 * @brief Convert transforms to inverse matrices
+	 *
+	 * @param InLocations	Locations
+	 * @param InRotations	Rotations, must be normalized
+	 * @param InScales		Scales, must not contain zero
+	 * @param OutMatrices	Output inverse matrices
+	 * @param InCount		Number of transforms
+	 */
+	static void TransformsToInverseMatrices( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount );
+
+	/**
+	 * @brief Compose parent and relative transforms, same as CTransform::operator+
+	 * @note Output arrays may be the same as input arrays
+	 *
+	 * @param InParentLocations		Parent locations
+	 * @param InParentRotations		Parent rotations
+	 * @param InParentScales		Parent scales
+	 * @param InRelativeLocations	Relative locations
+	 * @param InRelativeRotations	Relative rotations
+	 * @param InRelativeScales		Relative scales
+	 * @param OutLocations			Output locations
+	 * @param OutRotations			Output rotations
+	 * @param OutScales				Output scales
+	 * @param InCount				Number of transforms
+	 */
+	static void ComposeTransforms( const Vector* InParentLocations, const Quaternion* InParentRotations, const Vector* InParentScales,
+								   const Vector* InRelativeLocations, const Quaternion* InRelativeRotations, const Vector* InRelativeScales,
+								   Vector* OutLocations, Quaternion* OutRotations, Vector* OutScales, uint32 InCount );
+
+	/**
+	 * @brief Convert transforms to matrices without SIMD
+	 * @note It is used for the tail of batched functions and for comparison in benchmarks
+	 *
+	 * @param InLocations	Locations
+	 * @param InRotations	Rotations, must be normalized
+	 * @param InScales		Scales
+	 * @param OutMatrices	Output matrices
+	 * @param InCount		Number of transforms
+	 */
+	static void TransformsToMatricesScalar( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount );
+
+	/**
+	 * @brief Convert transforms to affine matrices 3x4 without SIMD
+	 *
+	 * @param InLocations	Locations
+	 * @param InRotations	Rotations, must be normalized
+	 * @param InScales		Scales
+	 * @param OutMatrices	Output matrices
+	 * @param InCount		Number of transforms
+	 */
+	static void TransformsToMatrices3x4Scalar( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, SMatrix3x4* OutMatrices, uint32 InCount );
+
+	/**
+	 * @brief Convert transforms to inverse matrices without SIMD
+	 *
+	 * @param InLocations	Locations
+	 * @param InRotations	Rotations, must be normalized
+	 * @param InScales		Scales, must not contain zero
+	 * @param OutMatrices	Output inverse matrices
+	 * @param InCount		Number of transforms
+	 */
+	static void TransformsToInverseMatricesScalar( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount );
+
+	/**
+	 * @brief Compose parent and relative transforms without SIMD
+	 *
+	 * @param InParentLocations		Parent locations
+	 * @param InParentRotations		Parent rotations
+	 * @param InParentScales		Parent scales
+	 * @param InRelativeLocations	Relative locations
+	 * @param InRelativeRotations	Relative rotations
+	 * @param InRelativeScales		Relative scales
+	 * @param OutLocations			Output locations
+	 * @param OutRotations			Output rotations
+	 * @param OutScales				Output scales
+	 * @param InCount				Number of transforms
+	 */
+	static void ComposeTransformsScalar( const Vector* InParentLocations, const Quaternion* InParentRotations, const Vector* InParentScales,
+										 const Vector* InRelativeLocations, const Quaternion* InRelativeRotations, const Vector* InRelativeScales,
+										 Vector* OutLocations, Quaternion* OutRotations, Vector* OutScales, uint32 InCount );
+};
+
+#endif // !TRANSFORMBATCH_H
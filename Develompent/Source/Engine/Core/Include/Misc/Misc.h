@@ -104,6 +104,16 @@ FORCEINLINE std::wstring appGameDir()
 	return CString::Format( TEXT( ".." ) PATH_SEPARATOR TEXT( ".." ) PATH_SEPARATOR TEXT( "%s" ) PATH_SEPARATOR, GGameName.c_str() );
 }
 
+/**
+ * @ingroup Core
+ * Return directory for files which are written by the game at runtime (caches, settings of user, etc)
+ * @return Return saved directory of the game
+ */
+FORCEINLINE std::wstring appSavedDir()
+{
+	return appGameDir() + TEXT( "Saved" ) PATH_SEPARATOR;
+}
+
 /**
  * @ingroup Core
  * Return shader directory
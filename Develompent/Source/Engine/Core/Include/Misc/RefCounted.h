@@ -11,37 +11,52 @@
 
 #include "Core.h"
 #include "Misc/Types.h"
-#include "System/ThreadingBase.h"
+#include "Misc/SharedPointerInternals.h"
 
 /**
  * @ingroup Core
- * @brief Object reference counting class
+ * @brief Object intrusive reference counting class
+ * 
+ * Reference count is stored in object, so TRefCountPtr not needs separate reference controller.
+ * Objects which never leave one thread can use SPM_NotThreadSafe mode for avoid interlocked operations
  */
-class CRefCounted
+template< ESPMode Mode >
+class TRefCounted
 {
 public:
 	/**
 	 * @brief Constructor
 	 */
-							CRefCounted();
+	FORCEINLINE				TRefCounted()
+		: countReferences( 0 )
+	{}
 
 	/**
 	 * @brief Destructor
 	 */
-	virtual					~CRefCounted();
+	virtual					~TRefCounted()
+	{
+		check( !countReferences );
+	}
 
 	/**
 	 * @brief Increment reference count
 	 */
 	FORCEINLINE void		AddRef()					
 	{ 
-		appInterlockedIncrement( ( int32* )&countReferences );
+		SharedPointerInternals::TReferenceCounterOps<Mode>::Increment( &countReferences );
 	}
 
 	/**
 	 * @brief Decrement reference count and delete self if no more references
 	 */
-	void					ReleaseRef();
+	FORCEINLINE void		ReleaseRef()
+	{
+		if ( !countReferences || !SharedPointerInternals::TReferenceCounterOps<Mode>::Decrement( &countReferences ) )
+		{
+			delete this;
+		}
+	}
 
 	/**
 	 * @brief Get reference count
@@ -53,7 +68,21 @@ public:
 	}
 
 private:
-	uint32			countReferences;			/**< Count references on object */
+	volatile int32			countReferences;			/**< Count references on object */
 };
 
+/**
+ * @ingroup Core
+ * @brief Object reference counting class
+ */
+class CRefCounted : public TRefCounted<SPM_ThreadSafe>
+{};
+
+/**
+ * @ingroup Core
+ * @brief Object reference counting class for objects which never leave one thread
+ */
+class CRefCountedNotThreadSafe : public TRefCounted<SPM_NotThreadSafe>
+{};
+
 #endif // !REFCOUNTED_H
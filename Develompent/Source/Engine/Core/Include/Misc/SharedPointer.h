@@ -12,18 +12,15 @@
 #include "Misc/SharedPointerInternals.h"
 #include "Misc/Template.h"
 
-// Forward declaration
-template< class ObjectType > class TWeakPtr;
-
 /**
  * @ingroup Core
  * @brief Reference-counting pointer class
  */
-template< class ObjectType >
+template< class ObjectType, ESPMode Mode >
 class TSharedPtr
 {
 public:
-	friend TWeakPtr<ObjectType>;
+	friend TWeakPtr<ObjectType, Mode>;
 
 	/**
 	 * @brief Hash function for STL containers
@@ -57,7 +54,7 @@ public:
 	 * @param InSharedPtr	Shared ptr
 	 */
 	template< typename OtherType >
-	FORCEINLINE TSharedPtr( const TSharedPtr<OtherType>& InSharedPtr )
+	FORCEINLINE TSharedPtr( const TSharedPtr<OtherType, Mode>& InSharedPtr )
 		: sharedReferenceCount( InSharedPtr.sharedReferenceCount )
 	{}
 
@@ -74,7 +71,7 @@ public:
 	 * @param InWeakPtr		Weak ptr
 	 */
 	template< typename OtherType >
-	FORCEINLINE TSharedPtr( const TWeakPtr<OtherType>& InWeakPtr )
+	FORCEINLINE TSharedPtr( const TWeakPtr<OtherType, Mode>& InWeakPtr )
 		: sharedReferenceCount( InWeakPtr.weakReferenceCount )
 	{}
 
@@ -82,7 +79,7 @@ public:
 	 * @brief Constructor
 	 * @param InWeakPtr		Weak ptr
 	 */
-	FORCEINLINE TSharedPtr( const TWeakPtr<ObjectType>& InWeakPtr )
+	FORCEINLINE TSharedPtr( const TWeakPtr<ObjectType, Mode>& InWeakPtr )
 		: sharedReferenceCount( InWeakPtr.weakReferenceCount )
 	{}
 
@@ -91,7 +88,7 @@ public:
 	 * @param InSharedPtr	Shared ptr
 	 */
 	template< typename OtherType >
-	FORCEINLINE TSharedPtr( TSharedPtr<OtherType>&& InSharedPtr )
+	FORCEINLINE TSharedPtr( TSharedPtr<OtherType, Mode>&& InSharedPtr )
 		:  sharedReferenceCount( MoveTemp( InSharedPtr.sharedReferenceCount ) )
 	{}
 
@@ -120,7 +117,7 @@ public:
 	 * @return Return reference to current object
 	 */
 	template< typename OtherType >
-	FORCEINLINE TSharedPtr& operator=( const TSharedPtr<OtherType>& InSharedPtr )
+	FORCEINLINE TSharedPtr& operator=( const TSharedPtr<OtherType, Mode>& InSharedPtr )
 	{
 		sharedReferenceCount = InSharedPtr.sharedReferenceCount;
 		return *this;
@@ -145,7 +142,7 @@ public:
 	 * @return Return reference to current object
 	 */
 	template< typename OtherType >
-	FORCEINLINE TSharedPtr& operator=( const TWeakPtr<OtherType>& InWeakPtr )
+	FORCEINLINE TSharedPtr& operator=( const TWeakPtr<OtherType, Mode>& InWeakPtr )
 	{
 		sharedReferenceCount = InWeakPtr.weakReferenceCount;
 		return *this;
@@ -157,7 +154,7 @@ public:
 	 * @param InWeakPtr		Weak ptr
 	 * @return Return reference to current object
 	 */
-	FORCEINLINE TSharedPtr& operator=( const TWeakPtr<ObjectType>& InWeakPtr )
+	FORCEINLINE TSharedPtr& operator=( const TWeakPtr<ObjectType, Mode>& InWeakPtr )
 	{
 		sharedReferenceCount = InWeakPtr.weakReferenceCount;
 		return *this;
@@ -170,9 +167,9 @@ public:
 	 * @return Return reference to current object
 	 */
 	template< typename OtherType >
-	FORCEINLINE TSharedPtr& operator=( TSharedPtr<OtherType>&& InSharedPtr )
+	FORCEINLINE TSharedPtr& operator=( TSharedPtr<OtherType, Mode>&& InSharedPtr )
 	{
-		if ( this != ( TSharedPtr<ObjectType>* )&InSharedPtr )
+		if ( this != ( TSharedPtr<ObjectType, Mode>* )&InSharedPtr )
 		{
 			sharedReferenceCount = MoveTemp( InSharedPtr.sharedReferenceCount );
 		}
@@ -213,7 +210,7 @@ public:
 	 * @return Returning TRUE if pointers is equal, else returning FALSE
 	 */
 	template< typename OtherType >
-	FORCEINLINE bool operator==( const TSharedPtr<OtherType>& InSharedPtr ) const
+	FORCEINLINE bool operator==( const TSharedPtr<OtherType, Mode>& InSharedPtr ) const
 	{
 		return Get() == InSharedPtr.Get();
 	}
@@ -237,7 +234,7 @@ public:
 	 * @return Returning TRUE if pointers is not equal, else returning FALSE
 	 */
 	template< typename OtherType >
-	FORCEINLINE bool operator!=( const TSharedPtr<OtherType>& InSharedPtr ) const
+	FORCEINLINE bool operator!=( const TSharedPtr<OtherType, Mode>& InSharedPtr ) const
 	{
 		return Get() != InSharedPtr.Get();
 	}
@@ -313,7 +310,7 @@ public:
 	 */
 	FORCEINLINE void Reset()
 	{
-		*this = TSharedPtr<ObjectType>();
+		*this = TSharedPtr<ObjectType, Mode>();
 	}
 
 	/**
@@ -335,12 +332,12 @@ public:
 	}
 
 	// Friend function for make shared ptr
-	template< typename ObjectType, typename... ArgTypes >
-	friend TSharedPtr<ObjectType> MakeSharedPtr( ArgTypes&&... InArgs );
+	template< typename OtherType, ESPMode OtherMode, typename... ArgTypes >
+	friend TSharedPtr<OtherType, OtherMode> MakeSharedPtr( ArgTypes&&... InArgs );
 
 	// Declare other smart pointer types as friends as needed
-	template< class OtherType > friend class TSharedPtr;
-	template< class OtherType > friend class TWeakPtr;
+	template< class OtherType, ESPMode OtherMode > friend class TSharedPtr;
+	template< class OtherType, ESPMode OtherMode > friend class TWeakPtr;
 
 protected:
 	/**
@@ -349,38 +346,48 @@ protected:
 	 */
 	template< typename OtherType >
 	FORCEINLINE TSharedPtr( OtherType* InObject )
-		: sharedReferenceCount( MoveTemp( SharedPointerInternals::NewReferenceController( ( ObjectType* )InObject ) ) )
+		: sharedReferenceCount( MoveTemp( SharedPointerInternals::NewReferenceController<Mode>( ( ObjectType* )InObject ) ) )
 	{
 		// If the object happens to be derived from TSharedFromThis, the following method
 		// will prime the object with a weak pointer to itself
 		SharedPointerInternals::EnableSharedFromThis( this, InObject );
 	}
 
-	SharedPointerInternals::TSharedReferencer<ObjectType>		sharedReferenceCount;		/**< Shared reference count */
+	SharedPointerInternals::TSharedReferencer<ObjectType, Mode>		sharedReferenceCount;		/**< Shared reference count */
 };
 
 /**
  * @ingroup Core
  * @brief Make shared pointer
+ * @note Object and reference controller are allocated in one memory block
  *
  * @param InArgs	Arguments for construct object
  * @return Return created shared pointer with allocated object
  */
-template< typename ObjectType, typename... ArgTypes >
-FORCEINLINE TSharedPtr<ObjectType> MakeSharedPtr( ArgTypes&&... InArgs )
+template< typename ObjectType, ESPMode Mode, typename... ArgTypes >
+FORCEINLINE TSharedPtr<ObjectType, Mode> MakeSharedPtr( ArgTypes&&... InArgs )
 {
-	return TSharedPtr<ObjectType>( new ObjectType( InArgs... ) );
+	SharedPointerInternals::TInlineReferenceController<ObjectType, Mode>*	referenceController = new SharedPointerInternals::TInlineReferenceController<ObjectType, Mode>( std::forward<ArgTypes>( InArgs )... );
+	ObjectType*																object = referenceController->GetObject();
+
+	TSharedPtr<ObjectType, Mode>		result;
+	result.sharedReferenceCount = MoveTemp( ( SharedPointerInternals::TReferenceController<ObjectType, Mode>* )referenceController );
+	
+	// If the object happens to be derived from TSharedFromThis, the following method
+	// will prime the object with a weak pointer to itself
+	SharedPointerInternals::EnableSharedFromThis( &result, object );
+	return result;
 }
 
 /**
  * @ingroup Core
  * @brief TWeakPtr is a non-intrusive reference-counted weak object pointer
  */
-template< class ObjectType >
+template< class ObjectType, ESPMode Mode >
 class TWeakPtr
 {
 public:
-	friend TSharedPtr<ObjectType>;
+	friend TSharedPtr<ObjectType, Mode>;
 
 	/**
 	 * @brief Hash function for STL containers
@@ -413,7 +420,7 @@ public:
 	 * @brief Constructor of move
 	 */
 	template< typename OtherType >
-	FORCEINLINE TWeakPtr( TWeakPtr<OtherType>&& InWeakPtr )
+	FORCEINLINE TWeakPtr( TWeakPtr<OtherType, Mode>&& InWeakPtr )
 		: weakReferenceCount( MoveTemp( InWeakPtr.weakReferenceCount ) )
 	{}
 
@@ -429,7 +436,7 @@ public:
 	 * @param InSharedPtr  The shared pointer to create a weak pointer from
 	 */
 	template< typename OtherType >
-	FORCEINLINE TWeakPtr( const TSharedPtr<OtherType>& InSharedPtr )
+	FORCEINLINE TWeakPtr( const TSharedPtr<OtherType, Mode>& InSharedPtr )
 		: weakReferenceCount( InSharedPtr.sharedReferenceCount )
 	{}
 
@@ -437,7 +444,7 @@ public:
 	 * @brief Constructs a weak pointer from a shared pointer
 	 * @param InSharedPtr  The shared pointer to create a weak pointer from
 	 */
-	FORCEINLINE TWeakPtr( const TSharedPtr<ObjectType>& InSharedPtr )
+	FORCEINLINE TWeakPtr( const TSharedPtr<ObjectType, Mode>& InSharedPtr )
 		: weakReferenceCount( InSharedPtr.sharedReferenceCount )
 	{}
 
@@ -446,7 +453,7 @@ public:
 	 * @param  InWeakPtr  The weak pointer to create a weak pointer from
 	 */
 	template< typename OtherType >
-	FORCEINLINE TWeakPtr( const TWeakPtr<OtherType>& InWeakPtr )
+	FORCEINLINE TWeakPtr( const TWeakPtr<OtherType, Mode>& InWeakPtr )
 		: weakReferenceCount( InWeakPtr.weakReferenceCount )
 	{}
 
@@ -475,7 +482,7 @@ public:
 	 * @param InWeakPtr  The weak pointer for the object to assign
 	 */
 	template< typename OtherType >
-	FORCEINLINE TWeakPtr& operator=( const TWeakPtr<OtherType>& InWeakPtr )
+	FORCEINLINE TWeakPtr& operator=( const TWeakPtr<OtherType, Mode>& InWeakPtr )
 	{
 		weakReferenceCount = InWeakPtr.weakReferenceCount;
 		return *this;
@@ -498,7 +505,7 @@ public:
 	 * @param InSharedPtr The shared pointer used to assign to this weak pointer
 	 */
 	template< typename OtherType >
-	FORCEINLINE TWeakPtr& operator=( const TSharedPtr<OtherType >& InSharedPtr )
+	FORCEINLINE TWeakPtr& operator=( const TSharedPtr<OtherType, Mode>& InSharedPtr )
 	{
 		weakReferenceCount = InSharedPtr.sharedReferenceCount;
 		return *this;
@@ -508,7 +515,7 @@ public:
 	 * @brief Assignment operator sets this weak pointer from a shared pointer
 	 * @param InSharedPtr The shared pointer used to assign to this weak pointer
 	 */
-	FORCEINLINE TWeakPtr& operator=( const TSharedPtr<ObjectType>& InSharedPtr )
+	FORCEINLINE TWeakPtr& operator=( const TSharedPtr<ObjectType, Mode>& InSharedPtr )
 	{
 		weakReferenceCount = InSharedPtr.sharedReferenceCount;
 		return *this;
@@ -521,9 +528,9 @@ public:
 	 * @return Return reference to current object
 	 */
 	template< typename OtherType >
-	FORCEINLINE TWeakPtr& operator=( TWeakPtr<OtherType>&& InWeakPtr )
+	FORCEINLINE TWeakPtr& operator=( TWeakPtr<OtherType, Mode>&& InWeakPtr )
 	{
-		if ( this != ( TWeakPtr<ObjectType>* )&InWeakPtr )
+		if ( this != ( TWeakPtr<ObjectType, Mode>* )&InWeakPtr )
 		{
 			weakReferenceCount = MoveTemp( InWeakPtr.weakReferenceCount );
 		}
@@ -552,7 +559,7 @@ public:
 	 * @return Returning TRUE if pointers is equal, else returning FALSE
 	 */
 	template< typename OtherType >
-	FORCEINLINE bool operator==( const TWeakPtr<OtherType>& InWeakPtr ) const
+	FORCEINLINE bool operator==( const TWeakPtr<OtherType, Mode>& InWeakPtr ) const
 	{
 		return Pin().Get() == InWeakPtr.Pin().Get();
 	}
@@ -564,7 +571,7 @@ public:
 	 * @return Returning TRUE if pointers is equal, else returning FALSE
 	 */
 	template< typename OtherType >
-	FORCEINLINE bool operator==( const TSharedPtr<OtherType>& InSharedPtr ) const
+	FORCEINLINE bool operator==( const TSharedPtr<OtherType, Mode>& InSharedPtr ) const
 	{
 		return Pin().Get() == InSharedPtr.Get();
 	}
@@ -576,7 +583,7 @@ public:
 	 * @return Returning TRUE if pointers is not equal, else returning FALSE
 	 */
 	template< typename OtherType >
-	FORCEINLINE bool operator!=( const TWeakPtr<OtherType>& InWeakPtr ) const
+	FORCEINLINE bool operator!=( const TWeakPtr<OtherType, Mode>& InWeakPtr ) const
 	{
 		return Pin().Get() != InWeakPtr.Pin().Get();
 	}
@@ -588,7 +595,7 @@ public:
 	 * @return Returning TRUE if pointers is equal, else returning FALSE
 	 */
 	template< typename OtherType >
-	FORCEINLINE bool operator!=( const TSharedPtr<OtherType>& InSharedPtr ) const
+	FORCEINLINE bool operator!=( const TSharedPtr<OtherType, Mode>& InSharedPtr ) const
 	{
 		return Pin().Get() != InSharedPtr.Get();
 	}
@@ -606,9 +613,9 @@ public:
 	 * @brief Converts this weak pointer to a shared pointer
 	 * @return Return shared pointer for this object (will only be valid if still referenced!)
 	 */
-	FORCEINLINE TSharedPtr<ObjectType> Pin() const
+	FORCEINLINE TSharedPtr<ObjectType, Mode> Pin() const
 	{
-		return IsValid() ? TSharedPtr<ObjectType>( *this ) : TSharedPtr<ObjectType>();
+		return IsValid() ? TSharedPtr<ObjectType, Mode>( *this ) : TSharedPtr<ObjectType, Mode>();
 	}
 
 	/**
@@ -635,7 +642,7 @@ public:
 	 */
 	FORCEINLINE void Reset()
 	{
-		*this = TWeakPtr<ObjectType>();
+		*this = TWeakPtr<ObjectType, Mode>();
 	}
 
 	/**
@@ -648,11 +655,11 @@ public:
 	}
 
 	// Declare other smart pointer types as friends as needed
-	template< class OtherType > friend class TSharedPtr;
-	template< class OtherType > friend class TWeakPtr;
+	template< class OtherType, ESPMode OtherMode > friend class TSharedPtr;
+	template< class OtherType, ESPMode OtherMode > friend class TWeakPtr;
 
 protected:
-	SharedPointerInternals::TWeakReferencer<ObjectType>		weakReferenceCount;		/**< Weak reference count */
+	SharedPointerInternals::TWeakReferencer<ObjectType, Mode>		weakReferenceCount;		/**< Weak reference count */
 };
 
 /**
@@ -660,7 +667,7 @@ protected:
  * @brief Derive your class from TSharedFromThis to enable access to a TSharedPtr directly from an object
  * instance that's already been allocated
  */
-template< class ObjectType >
+template< class ObjectType, ESPMode Mode >
 class TSharedFromThis
 {
 public:
@@ -671,9 +678,9 @@ public:
 	 *
 	 * @return Returns this object as a shared pointer
 	 */
-	TSharedPtr<ObjectType> AsShared()
+	TSharedPtr<ObjectType, Mode> AsShared()
 	{
-		TSharedPtr<ObjectType>	sharedThis = weakThis.Pin();
+		TSharedPtr<ObjectType, Mode>	sharedThis = weakThis.Pin();
 
 		//
 		// If the following assert goes off, it means one of the following:
@@ -697,9 +704,9 @@ public:
 	 *
 	 * @return Returns this object as a shared pointer (const)
 	 */
-	TSharedPtr<const ObjectType> AsShared() const
+	TSharedPtr<const ObjectType, Mode> AsShared() const
 	{
-		TSharedPtr<const ObjectType>	sharedThis = weakThis.Pin();
+		TSharedPtr<const ObjectType, Mode>	sharedThis = weakThis.Pin();
 
 		//
 		// If the following assert goes off, it means one of the following:
@@ -723,9 +730,9 @@ public:
 	 *
 	 * @return Returns this object as a shared pointer
 	 */
-	TWeakPtr<ObjectType> AsWeak()
+	TWeakPtr<ObjectType, Mode> AsWeak()
 	{
-		TWeakPtr<ObjectType>	result = weakThis;
+		TWeakPtr<ObjectType, Mode>	result = weakThis;
 
 		//
 		// If the following assert goes off, it means one of the following:
@@ -749,9 +756,9 @@ public:
 	 *
 	 * @return Returns this object as a shared pointer (const.)
 	 */
-	TWeakPtr<const ObjectType> AsWeak() const
+	TWeakPtr<const ObjectType, Mode> AsWeak() const
 	{
-		TWeakPtr<const ObjectType>		result = weakThis;
+		TWeakPtr<const ObjectType, Mode>		result = weakThis;
 
 		//
 		// If the following assert goes off, it means one of the following:
@@ -779,9 +786,9 @@ protected:
 	 * @return Returns this object as a shared pointer
 	 */
 	template< class OtherType >
-	FORCEINLINE static TSharedPtr<OtherType> SharedThis( OtherType* InThisPtr )
+	FORCEINLINE static TSharedPtr<OtherType, Mode> SharedThis( OtherType* InThisPtr )
 	{
-		return ( TSharedPtr<OtherType> )InThisPtr->AsShared();
+		return ( TSharedPtr<OtherType, Mode> )InThisPtr->AsShared();
 	}
 
 	/**
@@ -794,9 +801,9 @@ protected:
 	 * @return Returns this object as a shared pointer (const)
 	 */
 	template< class OtherType >
-	FORCEINLINE static TSharedPtr<const OtherType> SharedThis( const OtherType* InThisPtr )
+	FORCEINLINE static TSharedPtr<const OtherType, Mode> SharedThis( const OtherType* InThisPtr )
 	{
-		return ( TSharedPtr<const OtherType> )InThisPtr->AsShared();
+		return ( TSharedPtr<const OtherType, Mode> )InThisPtr->AsShared();
 	}
 
 public:		// Ideally this would be private, but template sharing problems prevent it
@@ -810,11 +817,11 @@ public:		// Ideally this would be private, but template sharing problems prevent
 	 * @param InSharedPtr	Pointer to shared ptr
 	 */
 	template< class SharedPtrType >
-	FORCEINLINE void UpdateWeakReferenceInternal( const TSharedPtr<SharedPtrType>* InSharedPtr ) const
+	FORCEINLINE void UpdateWeakReferenceInternal( const TSharedPtr<SharedPtrType, Mode>* InSharedPtr ) const
 	{
 		if ( !weakThis.IsValid() )
 		{
-			weakThis = TSharedPtr<ObjectType>( *InSharedPtr );
+			weakThis = TSharedPtr<ObjectType, Mode>( *InSharedPtr );
 		}
 	}
 
@@ -856,7 +863,7 @@ protected:
 	~TSharedFromThis() {}
 
 private:
-	mutable TWeakPtr<ObjectType>		weakThis;	/**< Weak reference to ourselves */
+	mutable TWeakPtr<ObjectType, Mode>		weakThis;	/**< Weak reference to ourselves */
 };
 
 #endif // SHAREDPOINTER_H
\ No newline at end of file
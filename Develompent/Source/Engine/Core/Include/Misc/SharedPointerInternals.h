@@ -9,14 +9,28 @@
 #ifndef SHAREDPOINTERINTERNALS_H
 #define SHAREDPOINTERINTERNALS_H
 
+#include <new>
+#include <utility>
+
 #include "Misc/Types.h"
 #include "System/ThreadingBase.h"
 #include "Core.h"
 
+/**
+ * @ingroup Core
+ * @brief Thread mode of reference counting in shared pointers and intrusive reference counted objects
+ */
+enum ESPMode
+{
+	SPM_NotThreadSafe,		/**< Reference counts are changed without atomic operations. Use it for objects which never leave one thread */
+	SPM_ThreadSafe			/**< Reference counts are changed by interlocked operations */
+};
+
 // Forward declarations
-template< class ObjectType > class TSharedPtr;
-template< class ObjectType > class TWeakPtr;
-template< class ObjectType > class TSharedFromThis;
+template< class ObjectType, ESPMode Mode = SPM_ThreadSafe > class TSharedPtr;
+template< class ObjectType, ESPMode Mode = SPM_ThreadSafe > class TWeakPtr;
+template< class ObjectType, ESPMode Mode = SPM_ThreadSafe > class TSharedFromThis;
+template< typename ObjectType, ESPMode Mode = SPM_ThreadSafe, typename... ArgTypes > TSharedPtr<ObjectType, Mode> MakeSharedPtr( ArgTypes&&... InArgs );
 
 /**
  * @ingroup Core
@@ -26,12 +40,113 @@ template< class ObjectType > class TSharedFromThis;
 namespace SharedPointerInternals
 {
 	// Forward declarations
-	template< class ObjectType > class TWeakReferencer;
+	template< class ObjectType, ESPMode Mode > class TWeakReferencer;
+
+	/**
+	 * @brief Operations with reference counts
+	 */
+	template< ESPMode Mode >
+	struct TReferenceCounterOps;
+
+	/**
+	 * @brief Operations with reference counts for thread safe mode
+	 */
+	template<>
+	struct TReferenceCounterOps<SPM_ThreadSafe>
+	{
+		/**
+		 * @brief Increment reference count
+		 * @param InCounter		Reference count
+		 */
+		static FORCEINLINE void Increment( volatile int32* InCounter )
+		{
+			appInterlockedIncrement( InCounter );
+		}
+
+		/**
+		 * @brief Decrement reference count
+		 * 
+		 * @param InCounter		Reference count
+		 * @return Return new value of reference count
+		 */
+		static FORCEINLINE int32 Decrement( volatile int32* InCounter )
+		{
+			return appInterlockedDecrement( InCounter );
+		}
+
+		/**
+		 * @brief Increment reference count only if it isn't zero
+		 * 
+		 * @param InCounter		Reference count
+		 * @return Return TRUE if reference count was incremented
+		 */
+		static FORCEINLINE bool ConditionallyIncrement( volatile int32* InCounter )
+		{
+			// Other thread may release the last reference between read and increment, so we repeat until success
+			for ( ; ; )
+			{
+				int32		originalCount = *InCounter;
+				if ( originalCount == 0 )
+				{
+					return false;
+				}
+
+				if ( appInterlockedCompareExchange( InCounter, originalCount + 1, originalCount ) == originalCount )
+				{
+					return true;
+				}
+			}
+		}
+	};
+
+	/**
+	 * @brief Operations with reference counts for not thread safe mode
+	 */
+	template<>
+	struct TReferenceCounterOps<SPM_NotThreadSafe>
+	{
+		/**
+		 * @brief Increment reference count
+		 * @param InCounter		Reference count
+		 */
+		static FORCEINLINE void Increment( volatile int32* InCounter )
+		{
+			++( *( int32* )InCounter );
+		}
+
+		/**
+		 * @brief Decrement reference count
+		 *
+		 * @param InCounter		Reference count
+		 * @return Return new value of reference count
+		 */
+		static FORCEINLINE int32 Decrement( volatile int32* InCounter )
+		{
+			return --( *( int32* )InCounter );
+		}
+
+		/**
+		 * @brief Increment reference count only if it isn't zero
+		 *
+		 * @param InCounter		Reference count
+		 * @return Return TRUE if reference count was incremented
+		 */
+		static FORCEINLINE bool ConditionallyIncrement( volatile int32* InCounter )
+		{
+			if ( *InCounter == 0 )
+			{
+				return false;
+			}
+
+			++( *( int32* )InCounter );
+			return true;
+		}
+	};
 
 	/**
 	 * @brief Reference controller
 	 */
-	template< class ObjectType >
+	template< class ObjectType, ESPMode Mode >
 	class TReferenceController
 	{
 	public:
@@ -77,7 +192,7 @@ namespace SharedPointerInternals
 		 */
 		FORCEINLINE void AddSharedReference()
 		{
-			appInterlockedIncrement( ( int32* )&sharedReferenceCount );
+			TReferenceCounterOps<Mode>::Increment( &sharedReferenceCount );
 		}
 
 		/**
@@ -91,22 +206,15 @@ namespace SharedPointerInternals
 				return;
 			}
 
-			if ( sharedReferenceCount == 1 )
+			if ( TReferenceCounterOps<Mode>::Decrement( &sharedReferenceCount ) == 0 )
 			{
 				// Last shared reference was released!  Destroy the referenced object.
 				DestroyObject();
 
-				// Clear shared reference count
-				appInterlockedDecrement( ( int32* )&sharedReferenceCount );
-
 				// No more shared referencers, so decrement the weak reference count by one.  When the weak
 				// reference count reaches zero, this object will be deleted.
 				ReleaseWeakReference();
 			}
-			else
-			{
-				appInterlockedDecrement( ( int32* )&sharedReferenceCount );
-			}
 		}
 
 		/**
@@ -114,7 +222,7 @@ namespace SharedPointerInternals
 		 */
 		FORCEINLINE void AddWeakReference()
 		{
-			appInterlockedIncrement( ( int32* )&weakReferenceCount );
+			TReferenceCounterOps<Mode>::Increment( &weakReferenceCount );
 		}
 
 		/**
@@ -123,14 +231,8 @@ namespace SharedPointerInternals
 		 */
 		FORCEINLINE bool ConditionallyAddSharedReference()
 		{
-			if ( sharedReferenceCount == 0 )
-			{
-				// Never add a shared reference if the pointer has already expired
-				return false;
-			}
-
-			appInterlockedIncrement( ( int32* )&sharedReferenceCount );
-			return true;
+			// Never add a shared reference if the pointer has already expired
+			return TReferenceCounterOps<Mode>::ConditionallyIncrement( &sharedReferenceCount );
 		}
 
 		/**
@@ -138,7 +240,7 @@ namespace SharedPointerInternals
 		 */
 		FORCEINLINE void ReleaseWeakReference()
 		{
-			if ( !appInterlockedDecrement( ( int32* )&weakReferenceCount ) )
+			if ( !TReferenceCounterOps<Mode>::Decrement( &weakReferenceCount ) )
 			{
 				delete this;
 			}
@@ -147,7 +249,7 @@ namespace SharedPointerInternals
 		/**
 		 * @brief Destroy object
 		 */
-		FORCEINLINE void DestroyObject()
+		virtual void DestroyObject()
 		{
 			if ( object )
 			{
@@ -169,21 +271,64 @@ namespace SharedPointerInternals
 		TReferenceController( const TReferenceController& ) = delete;
 		TReferenceController& operator=( const TReferenceController& ) = delete;
 
+	protected:
+		/**
+		 * @brief Constructor for controllers which own memory of object
+		 */
+		FORCEINLINE TReferenceController()
+			: sharedReferenceCount( 1 )
+			, weakReferenceCount( 1 )
+			, object( nullptr )
+		{}
+
+		volatile int32		sharedReferenceCount;	/**< Number of shared references to this object */
+		volatile int32		weakReferenceCount;		/**< Number of weak references to this object */
+		ObjectType*			object;					/**< Object */
+	};
+
+	/**
+	 * @brief Reference controller which stores object in same memory block (used by MakeSharedPtr).
+	 * Saves one allocation and keeps reference counts near object in cache
+	 */
+	template< class ObjectType, ESPMode Mode >
+	class TInlineReferenceController : public TReferenceController<ObjectType, Mode>
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param InArgs	Arguments for construct object
+		 */
+		template< typename... ArgTypes >
+		FORCEINLINE explicit TInlineReferenceController( ArgTypes&&... InArgs )
+		{
+			this->object = new( storage ) ObjectType( std::forward<ArgTypes>( InArgs )... );
+		}
+
+		/**
+		 * @brief Destroy object
+		 */
+		virtual void DestroyObject() override
+		{
+			if ( this->object )
+			{
+				this->object->~ObjectType();
+				this->object = nullptr;
+			}
+		}
+
 	private:
-		uint32		sharedReferenceCount;	/**< Number of shared references to this object */
-		uint32		weakReferenceCount;		/**< Number of weak references to this object */
-		ObjectType* object;					/**< Object */
+		alignas( ObjectType ) byte		storage[ sizeof( ObjectType ) ];		/**< Memory of object */
 	};
 
 	/**
 	 * @brief FSharedReferencer is a wrapper around a pointer to a reference controller that is used by either a
 	 * TSharedPtr to keep track of a referenced object's lifetime
 	 */
-	template< class ObjectType >
+	template< class ObjectType, ESPMode Mode >
 	class TSharedReferencer
 	{
 	public:
-		friend TWeakReferencer<ObjectType>;
+		friend TWeakReferencer<ObjectType, Mode>;
 
 		/**
 		 * @brief Constructor for an empty shared referencer object
@@ -197,8 +342,8 @@ namespace SharedPointerInternals
 		 * @param InSharedReference		Shared reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TSharedReferencer( TSharedReferencer<OtherType>&& InSharedReference )
-			: referenceController( ( TReferenceController<ObjectType>* )InSharedReference.referenceController )
+		FORCEINLINE explicit TSharedReferencer( TSharedReferencer<OtherType, Mode>&& InSharedReference )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InSharedReference.referenceController )
 		{
 			InSharedReference.referenceController = nullptr;
 		}
@@ -218,8 +363,8 @@ namespace SharedPointerInternals
 		 * @param InReferenceController		Reference controller
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TSharedReferencer( TReferenceController<OtherType>*&& InReferenceController )
-			: referenceController( ( TReferenceController<ObjectType>* )InReferenceController )
+		FORCEINLINE explicit TSharedReferencer( TReferenceController<OtherType, Mode>*&& InReferenceController )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InReferenceController )
 		{
 			InReferenceController = nullptr;
 		}
@@ -228,7 +373,7 @@ namespace SharedPointerInternals
 		 * @brief Constructor of move
 		 * @param InReferenceController		Reference controller
 		 */
-		FORCEINLINE explicit TSharedReferencer( TReferenceController<ObjectType>*&& InReferenceController )
+		FORCEINLINE explicit TSharedReferencer( TReferenceController<ObjectType, Mode>*&& InReferenceController )
 			: referenceController( InReferenceController )
 		{
 			InReferenceController = nullptr;
@@ -239,8 +384,8 @@ namespace SharedPointerInternals
 		 * @param InSharedReference		Shared reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TSharedReferencer( const TSharedReferencer<OtherType>& InSharedReference )
-			: referenceController( ( TReferenceController<ObjectType>* )InSharedReference.referenceController )
+		FORCEINLINE explicit TSharedReferencer( const TSharedReferencer<OtherType, Mode>& InSharedReference )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InSharedReference.referenceController )
 		{
 			// If the incoming reference had an object associated with it, then go ahead and increment the
 			// shared reference count
@@ -272,8 +417,8 @@ namespace SharedPointerInternals
 		 * @param InWeakReference	Weak reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TSharedReferencer( const TWeakReferencer<OtherType>& InWeakReference )
-			: referenceController( ( TReferenceController<ObjectType>* )InWeakReference.referenceController )
+		FORCEINLINE explicit TSharedReferencer( const TWeakReferencer<OtherType, Mode>& InWeakReference )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InWeakReference.referenceController )
 		{
 			// If the incoming reference had an object associated with it, then go ahead and increment the
 			// shared reference count
@@ -295,7 +440,7 @@ namespace SharedPointerInternals
 		 *
 		 * @param InWeakReference	Weak reference
 		 */
-		FORCEINLINE explicit TSharedReferencer( const TWeakReferencer<ObjectType>& InWeakReference )
+		FORCEINLINE explicit TSharedReferencer( const TWeakReferencer<ObjectType, Mode>& InWeakReference )
 			: referenceController( InWeakReference.referenceController )
 		{
 			// If the incoming reference had an object associated with it, then go ahead and increment the
@@ -319,8 +464,8 @@ namespace SharedPointerInternals
 		 * @param InWeakReference	Weak reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TSharedReferencer( TWeakReferencer<OtherType>&& InWeakReference )
-			: referenceController( ( TReferenceController<ObjectType>* )InWeakReference.referenceController )
+		FORCEINLINE explicit TSharedReferencer( TWeakReferencer<OtherType, Mode>&& InWeakReference )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InWeakReference.referenceController )
 		{
 			// If the incoming reference had an object associated with it, then go ahead and increment the
 			// shared reference count
@@ -347,7 +492,7 @@ namespace SharedPointerInternals
 		 *
 		 * @param InWeakReference	Weak reference
 		 */
-		FORCEINLINE explicit TSharedReferencer( TWeakReferencer<ObjectType>&& InWeakReference )
+		FORCEINLINE explicit TSharedReferencer( TWeakReferencer<ObjectType, Mode>&& InWeakReference )
 			: referenceController( InWeakReference.referenceController )
 		{
 			// If the incoming reference had an object associated with it, then go ahead and increment the
@@ -372,7 +517,7 @@ namespace SharedPointerInternals
 		/**
 		 * @brief Destructor
 		 */
-		virtual ~TSharedReferencer()
+		FORCEINLINE ~TSharedReferencer()
 		{
 			if ( referenceController != nullptr )
 			{
@@ -387,7 +532,7 @@ namespace SharedPointerInternals
 		 * @param InSharedReference		Shared reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE TSharedReferencer& operator=( const TSharedReferencer<OtherType>& InSharedReference )
+		FORCEINLINE TSharedReferencer& operator=( const TSharedReferencer<OtherType, Mode>& InSharedReference )
 		{
 			*this = ( TSharedReferencer )InSharedReference;
 			return *this;
@@ -427,7 +572,7 @@ namespace SharedPointerInternals
 		 * @param InSharedReference		Shared reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE TSharedReferencer& operator=( TSharedReferencer<OtherType>&& InSharedReference )
+		FORCEINLINE TSharedReferencer& operator=( TSharedReferencer<OtherType, Mode>&& InSharedReference )
 		{
 			*this = ( TSharedReferencer&& )InSharedReference;
 			return *this;
@@ -465,9 +610,9 @@ namespace SharedPointerInternals
 		 * @param InReferenceController		Reference controller
 		 */
 		template< typename OtherType >
-		FORCEINLINE TSharedReferencer& operator=( TReferenceController<OtherType>*&& InReferenceController )
+		FORCEINLINE TSharedReferencer& operator=( TReferenceController<OtherType, Mode>*&& InReferenceController )
 		{
-			*this = ( TReferenceController<ObjectType>*&& )InReferenceController;
+			*this = ( TReferenceController<ObjectType, Mode>*&& )InReferenceController;
 			return *this;
 		}
 
@@ -476,7 +621,7 @@ namespace SharedPointerInternals
 		 *
 		 * @param InReferenceController		Reference controller
 		 */
-		FORCEINLINE TSharedReferencer& operator=( TReferenceController<ObjectType>*&& InReferenceController )
+		FORCEINLINE TSharedReferencer& operator=( TReferenceController<ObjectType, Mode>*&& InReferenceController )
 		{
 			// Make sure we're not be reassigned to ourself!
 			auto		newReferenceController = InReferenceController;
@@ -552,22 +697,22 @@ namespace SharedPointerInternals
 		}
 
 		// Declare other smart pointer types as friends as needed
-		template< class OtherType > friend class TSharedReferencer;
-		template< class OtherType > friend class TWeakReferencer;
+		template< class OtherType, ESPMode OtherMode > friend class TSharedReferencer;
+		template< class OtherType, ESPMode OtherMode > friend class TWeakReferencer;
 
 	private:
-		mutable TReferenceController<ObjectType>*		referenceController;	/**< Pointer to the reference controller for the object */
+		mutable TReferenceController<ObjectType, Mode>*		referenceController;	/**< Pointer to the reference controller for the object */
 	};
 
 	/**
 	 * @brief TWeakReferencer is a wrapper around a pointer to a reference controller that is used
 	 * by a TWeakPtr to keep track of a referenced object's lifetime
 	 */
-	template< class ObjectType >
+	template< class ObjectType, ESPMode Mode >
 	class TWeakReferencer
 	{
 	public:
-		friend TSharedReferencer<ObjectType>;
+		friend TSharedReferencer<ObjectType, Mode>;
 
 		/**
 		 * @brief Get type hash
@@ -590,8 +735,8 @@ namespace SharedPointerInternals
 		 * @param InWeakRefCountPointer		Weak referencer
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TWeakReferencer( const TWeakReferencer<OtherType>& InWeakRefCountPointer )
-			: referenceController( ( TReferenceController<ObjectType>* )InWeakRefCountPointer.referenceController )
+		FORCEINLINE explicit TWeakReferencer( const TWeakReferencer<OtherType, Mode>& InWeakRefCountPointer )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InWeakRefCountPointer.referenceController )
 		{
 			// If the weak referencer has a valid controller, then go ahead and add a weak reference to it!
 			if ( referenceController != nullptr )
@@ -619,8 +764,8 @@ namespace SharedPointerInternals
 		 * @param InSharedRefCountPointer		Shared referencer
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TWeakReferencer( const TSharedReferencer<OtherType>& InSharedRefCountPointer )
-			: referenceController( ( TReferenceController<ObjectType>* )InSharedRefCountPointer.referenceController )
+		FORCEINLINE explicit TWeakReferencer( const TSharedReferencer<OtherType, Mode>& InSharedRefCountPointer )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InSharedRefCountPointer.referenceController )
 		{
 			// If the shared referencer had a valid controller, then go ahead and add a weak reference to it!
 			if ( referenceController != nullptr )
@@ -633,7 +778,7 @@ namespace SharedPointerInternals
 		 * @brief Construct a weak referencer object from a shared referencer object
 		 * @param InSharedRefCountPointer		Shared referencer
 		 */
-		FORCEINLINE explicit TWeakReferencer( const TSharedReferencer<ObjectType>& InSharedRefCountPointer )
+		FORCEINLINE explicit TWeakReferencer( const TSharedReferencer<ObjectType, Mode>& InSharedRefCountPointer )
 			: referenceController( InSharedRefCountPointer.referenceController )
 		{
 			// If the shared referencer had a valid controller, then go ahead and add a weak reference to it!
@@ -648,8 +793,8 @@ namespace SharedPointerInternals
 		 * @param InSharedRefCountPointer		Shared referencer
 		 */
 		template< typename OtherType >
-		FORCEINLINE explicit TWeakReferencer( TWeakReferencer<OtherType>&& InWeakRefCountPointer )
-			: referenceController( ( TReferenceController<ObjectType>* )InWeakRefCountPointer.referenceController )
+		FORCEINLINE explicit TWeakReferencer( TWeakReferencer<OtherType, Mode>&& InWeakRefCountPointer )
+			: referenceController( ( TReferenceController<ObjectType, Mode>* )InWeakRefCountPointer.referenceController )
 		{
 			InWeakRefCountPointer.referenceController = nullptr;
 		}
@@ -667,7 +812,7 @@ namespace SharedPointerInternals
 		/**
 		 * @brief Destructor
 		 */
-		virtual ~TWeakReferencer()
+		FORCEINLINE ~TWeakReferencer()
 		{
 			if ( referenceController != nullptr )
 			{
@@ -682,7 +827,7 @@ namespace SharedPointerInternals
 		 * @param InWeakReference	Weak reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE TWeakReferencer& operator=( const TWeakReferencer<OtherType>& InWeakReference )
+		FORCEINLINE TWeakReferencer& operator=( const TWeakReferencer<OtherType, Mode>& InWeakReference )
 		{
 			AssignReferenceController( InWeakReference.referenceController );
 			return *this;
@@ -703,7 +848,7 @@ namespace SharedPointerInternals
 		 * @param InSharedReference		Shared reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE TWeakReferencer& operator=( const TSharedReferencer<OtherType>& InSharedReference )
+		FORCEINLINE TWeakReferencer& operator=( const TSharedReferencer<OtherType, Mode>& InSharedReference )
 		{
 			AssignReferenceController( InSharedReference.referenceController );
 			return *this;
@@ -713,7 +858,7 @@ namespace SharedPointerInternals
 		 * @brief Override operator =
 		 * @param InSharedReference		Shared reference
 		 */
-		FORCEINLINE TWeakReferencer& operator=( const TSharedReferencer<ObjectType>& InSharedReference )
+		FORCEINLINE TWeakReferencer& operator=( const TSharedReferencer<ObjectType, Mode>& InSharedReference )
 		{
 			AssignReferenceController( InSharedReference.referenceController );
 			return *this;
@@ -726,7 +871,7 @@ namespace SharedPointerInternals
 		 * @param InWeakReference	Weak reference
 		 */
 		template< typename OtherType >
-		FORCEINLINE TWeakReferencer& operator=( TWeakReferencer<OtherType>&& InWeakReference )
+		FORCEINLINE TWeakReferencer& operator=( TWeakReferencer<OtherType, Mode>&& InWeakReference )
 		{
 			*this = ( TWeakReferencer&& )InWeakReference;
 			return *this;
@@ -738,7 +883,7 @@ namespace SharedPointerInternals
 		 *
 		 * @param InWeakReference	Weak reference
 		 */
-		FORCEINLINE TWeakReferencer& operator=( TWeakReferencer<ObjectType>&& InWeakReference )
+		FORCEINLINE TWeakReferencer& operator=( TWeakReferencer<ObjectType, Mode>&& InWeakReference )
 		{
 			auto		oldReferenceController = referenceController;
 			referenceController = InWeakReference.referenceController;
@@ -771,8 +916,8 @@ namespace SharedPointerInternals
 		}
 
 		// Declare other smart pointer types as friends as needed
-		template< class OtherType > friend class TSharedReferencer;
-		template< class OtherType > friend class TWeakReferencer;
+		template< class OtherType, ESPMode OtherMode > friend class TSharedReferencer;
+		template< class OtherType, ESPMode OtherMode > friend class TWeakReferencer;
 
 	private:
 		/**
@@ -782,10 +927,10 @@ namespace SharedPointerInternals
 		 * @param InNewReferenceController		New reference controller
 		 */
 		template< typename OtherType >
-		FORCEINLINE void AssignReferenceController( TReferenceController<OtherType>* InNewReferenceController )
+		FORCEINLINE void AssignReferenceController( TReferenceController<OtherType, Mode>* InNewReferenceController )
 		{
 			// Only proceed if the new reference counter is different than our current
-			if ( ( TReferenceController<ObjectType>* )InNewReferenceController != referenceController )
+			if ( ( TReferenceController<ObjectType, Mode>* )InNewReferenceController != referenceController )
 			{
 				// First, add a weak reference to the new object
 				if ( InNewReferenceController != nullptr )
@@ -800,21 +945,21 @@ namespace SharedPointerInternals
 				}
 
 				// Assume ownership of the assigned reference counter
-				referenceController = ( TReferenceController<ObjectType>* )InNewReferenceController;
+				referenceController = ( TReferenceController<ObjectType, Mode>* )InNewReferenceController;
 			}
 		}
 
-		mutable TReferenceController<ObjectType>*		referenceController;	/**< Pointer to the reference controller for the object */
+		mutable TReferenceController<ObjectType, Mode>*		referenceController;	/**< Pointer to the reference controller for the object */
 	};
 
 	/**
 	 * @brief Creates a reference controller
 	 * @param InObject		Object
 	 */
-	template< typename ObjectType >
-	FORCEINLINE TReferenceController<ObjectType>* NewReferenceController( ObjectType* InObject )
+	template< ESPMode Mode, typename ObjectType >
+	FORCEINLINE TReferenceController<ObjectType, Mode>* NewReferenceController( ObjectType* InObject )
 	{
-		return new TReferenceController<ObjectType>( InObject );
+		return new TReferenceController<ObjectType, Mode>( InObject );
 	}
 
 	/**
@@ -823,8 +968,8 @@ namespace SharedPointerInternals
 	 * @param InSharedPtr		Pointer to shared ptr
 	 * @param InShareable		Shareable object
 	 */
-	template< class SharedPtrType, class OtherType >
-	FORCEINLINE void EnableSharedFromThis( const TSharedPtr<SharedPtrType>* InSharedPtr, const TSharedFromThis<OtherType>* InShareable )
+	template< class SharedPtrType, class OtherType, ESPMode Mode >
+	FORCEINLINE void EnableSharedFromThis( const TSharedPtr<SharedPtrType, Mode>* InSharedPtr, const TSharedFromThis<OtherType, Mode>* InShareable )
 	{
 		if ( InShareable != nullptr )
 		{
@@ -838,8 +983,8 @@ namespace SharedPointerInternals
 	 * @param InSharedPtr		Pointer to shared ptr
 	 * @param InShareable		Shareable object
 	 */
-	template< class SharedPtrType, class OtherType >
-	FORCEINLINE void EnableSharedFromThis( TSharedPtr<SharedPtrType>* InSharedPtr, const TSharedFromThis<OtherType>* InShareable )
+	template< class SharedPtrType, class OtherType, ESPMode Mode >
+	FORCEINLINE void EnableSharedFromThis( TSharedPtr<SharedPtrType, Mode>* InSharedPtr, const TSharedFromThis<OtherType, Mode>* InShareable )
 	{
 		if ( InShareable != nullptr )
 		{
@@ -13,6 +13,7 @@
 
 #include "Misc/Types.h"
 #include "Misc/Guid.h"
+#include "Containers/HashedString.h"
 #include "System/Archive.h"
 #include "CoreDefines.h"
 
@@ -112,9 +113,9 @@ public:
 	 * @param InName Name of the package
 	 * @return Return path to the package by name, if not found returning empty string
 	 */
-	FORCEINLINE std::wstring GetPackagePath( const std::wstring& InName ) const
+	FORCEINLINE std::wstring GetPackagePath( const CStringView& InName ) const
 	{
-		auto	itEntry = nameEntries.find( InName );
+		auto	itEntry = nameEntries.find( CHashedString::MakeLookupKey( InName ) );
 		if ( itEntry != nameEntries.end() )
 		{
 			return itEntry->second.path;
@@ -151,7 +152,7 @@ private:
 		std::wstring		path;		/**< Path to entry */
 	};
 
-	std::unordered_map< std::wstring, STOCEntry >					nameEntries;			/**< Entries of table content. Key - Name of the package, Item - Path to package */
+	std::unordered_map< CHashedString, STOCEntry, CHashedString::SHashedStringKeyFunc >	nameEntries;	/**< Entries of table content. Key - Name of the package, Item - Path to package */
 	std::unordered_map< CGuid, STOCEntry, CGuid::SGuidKeyFunc >		guidEntries;			/**< Entries of table content. Key - GUID of the package, Item - Path to package */
 };
 
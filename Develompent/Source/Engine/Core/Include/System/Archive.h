@@ -27,7 +27,9 @@ enum EArchiveType
 	AT_ShaderCache,		/**< Archive contains shader cache */
 	AT_TextureCache,	/**< Archive contains texture cache */
 	AT_World,			/**< Archive contains world */
-	AT_Package			/**< Archive contains assets */
+	AT_Package,			/**< Archive contains assets */
+	AT_BinaryLog,		/**< Archive contains binary log */
+	AT_PipelineStateCache	/**< Archive contains list of pipeline states */
 };
 
 /**
@@ -123,6 +125,17 @@ public:
 	 */
 	virtual uint32			GetSize() { return 0; }
 
+	/**
+	 * Set archive version
+	 * @note Used for archives without header (e.g in memory) which are nested into other archive
+	 * 
+	 * @param InVer		Archive version
+	 */
+	FORCEINLINE void SetVer( uint32 InVer )
+	{
+		arVer = InVer;
+	}
+
 	/**
 	 * Get archive version
 	 * @return Return archive version
@@ -63,6 +63,15 @@ public:
 		}
 	}
 
+	/**
+	 * Remove all delegates
+	 */
+	FORCEINLINE void RemoveAll()
+	{
+		CScopeLock		scopeLock( criticalSection );
+		delegates.clear();
+	}
+
 	/**
 	 * Broadcast all delegates
 	 * @param[in] InParams Params for call delegate
@@ -0,0 +1,273 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MALLOC_H
+#define MALLOC_H
+
+#include "Core.h"
+#include "Misc/Types.h"
+
+/**
+ * @ingroup Core
+ * @brief Is enabled tracking of allocations (memory tags, counters and leak reports)
+ */
+#ifndef WITH_MEMORY_TRACKING
+	#define WITH_MEMORY_TRACKING		!SHIPPING_BUILD
+#endif // !WITH_MEMORY_TRACKING
+
+/**
+ * @ingroup Core
+ * @brief Default alignment of allocations
+ */
+#define DEFAULT_ALIGNMENT				16
+
+/**
+ * @ingroup Core
+ * @brief Enumeration of memory tags. Each allocation is attributed to tag which is current on the thread
+ */
+enum EMemoryTag
+{
+	MTAG_Default,		/**< Not tagged allocations */
+	MTAG_Render,		/**< Render and RHI */
+	MTAG_Physics,		/**< Physics */
+	MTAG_Audio,			/**< Audio */
+	MTAG_Assets,		/**< Packages and assets */
+	MTAG_Scripts,		/**< Scripts */
+	MTAG_UI,			/**< UI */
+	MTAG_World,			/**< World, actors and components */
+	MTAG_Num			/**< Number of memory tags */
+};
+
+/**
+ * @ingroup Core
+ * @brief Names of memory tags
+ */
+extern const tchar*				GMemoryTagNames[ MTAG_Num ];
+
+/**
+ * @ingroup Core
+ * @brief Get reference to current memory tag of the thread
+ * @return Return reference to current memory tag of the thread
+ */
+FORCEINLINE EMemoryTag& appGetCurrentMemoryTag()
+{
+	static thread_local EMemoryTag		currentMemoryTag = MTAG_Default;
+	return currentMemoryTag;
+}
+
+/**
+ * @ingroup Core
+ * @brief Set memory tag for all allocations in scope on current thread
+ */
+class CScopedMemoryTag
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InMemoryTag	Memory tag
+	 */
+	FORCEINLINE CScopedMemoryTag( EMemoryTag InMemoryTag )
+		: prevMemoryTag( appGetCurrentMemoryTag() )
+	{
+		appGetCurrentMemoryTag() = InMemoryTag;
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	FORCEINLINE ~CScopedMemoryTag()
+	{
+		appGetCurrentMemoryTag() = prevMemoryTag;
+	}
+
+private:
+	EMemoryTag		prevMemoryTag;		/**< Previous memory tag */
+};
+
+#if WITH_MEMORY_TRACKING
+	/**
+	 * @ingroup Core
+	 * @brief Macro for set memory tag in scope
+	 *
+	 * @param InMemoryTag	Memory tag
+	 *
+	 * Example usage: @code SCOPED_MEMORY_TAG( MTAG_Render ); @endcode
+	 */
+	#define SCOPED_MEMORY_TAG( InMemoryTag )		CScopedMemoryTag		MEMORY_TAG_JOIN( scopedMemoryTag_, __LINE__ )( InMemoryTag )
+
+	#define MEMORY_TAG_JOIN( InA, InB )				MEMORY_TAG_JOIN_INNER( InA, InB )
+	#define MEMORY_TAG_JOIN_INNER( InA, InB )		InA##InB
+#else
+	#define SCOPED_MEMORY_TAG( InMemoryTag )
+#endif // WITH_MEMORY_TRACKING
+
+/**
+ * @ingroup Core
+ * @brief Base class of memory allocators
+ *
+ * All allocations of engine (including operator new/delete) go through GMalloc.
+ * Allocators may be chained, e.g. CMallocTracking wraps other allocator and counts allocations
+ */
+class CMalloc
+{
+public:
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CMalloc() {}
+
+	/**
+	 * @brief Allocate memory
+	 *
+	 * @param InSize		Size of memory in bytes
+	 * @param InAlignment	Alignment of memory
+	 * @return Return pointer to allocated memory, if failed will return NULL
+	 */
+	virtual void* Malloc( uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT ) = 0;
+
+	/**
+	 * @brief Reallocate memory
+	 *
+	 * @param InOriginal	Pointer to original memory. May be NULL
+	 * @param InSize		New size of memory in bytes. If 0 memory will be freed
+	 * @param InAlignment	Alignment of memory
+	 * @return Return pointer to reallocated memory
+	 */
+	virtual void* Realloc( void* InOriginal, uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT ) = 0;
+
+	/**
+	 * @brief Free memory
+	 * @param InOriginal	Pointer to memory. May be NULL
+	 */
+	virtual void Free( void* InOriginal ) = 0;
+
+	/**
+	 * @brief Get size of allocation
+	 *
+	 * @param InOriginal	Pointer to memory
+	 * @param OutSize		Output size of allocation
+	 * @return Return TRUE if size is known, otherwise will return FALSE
+	 */
+	virtual bool GetAllocationSize( void* InOriginal, uint64& OutSize )
+	{
+		return false;
+	}
+
+	/**
+	 * @brief Get descriptive name of allocator
+	 * @return Return descriptive name of allocator
+	 */
+	virtual const tchar* GetDescriptiveName() const = 0;
+};
+
+/**
+ * @ingroup Core
+ * @brief Allocator which uses CRT functions
+ *
+ * Size of allocation isn't known for it, because CRT needs alignment of block for it and alignment isn't stored
+ */
+class CMallocAnsi : public CMalloc
+{
+public:
+	/**
+	 * @brief Allocate memory
+	 *
+	 * @param InSize		Size of memory in bytes
+	 * @param InAlignment	Alignment of memory
+	 * @return Return pointer to allocated memory, if failed will return NULL
+	 */
+	virtual void* Malloc( uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT ) override;
+
+	/**
+	 * @brief Reallocate memory
+	 *
+	 * @param InOriginal	Pointer to original memory. May be NULL
+	 * @param InSize		New size of memory in bytes. If 0 memory will be freed
+	 * @param InAlignment	Alignment of memory
+	 * @return Return pointer to reallocated memory
+	 */
+	virtual void* Realloc( void* InOriginal, uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT ) override;
+
+	/**
+	 * @brief Free memory
+	 * @param InOriginal	Pointer to memory. May be NULL
+	 */
+	virtual void Free( void* InOriginal ) override;
+
+	/**
+	 * @brief Get descriptive name of allocator
+	 * @return Return descriptive name of allocator
+	 */
+	virtual const tchar* GetDescriptiveName() const override;
+};
+
+/**
+ * @ingroup Core
+ * @brief Global allocator. Created on first allocation
+ */
+extern CMalloc*					GMalloc;
+
+/**
+ * @ingroup Core
+ * @brief Create global allocator
+ * It called automatically on first allocation, because allocations may happen before main()
+ */
+void appCreateMalloc();
+
+/**
+ * @ingroup Core
+ * @brief Allocate memory through global allocator
+ *
+ * @param InSize		Size of memory in bytes
+ * @param InAlignment	Alignment of memory
+ * @return Return pointer to allocated memory
+ */
+FORCEINLINE void* appMalloc( uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT )
+{
+	if ( !GMalloc )
+	{
+		appCreateMalloc();
+	}
+	return GMalloc->Malloc( InSize, InAlignment );
+}
+
+/**
+ * @ingroup Core
+ * @brief Reallocate memory through global allocator
+ *
+ * @param InOriginal	Pointer to original memory. May be NULL
+ * @param InSize		New size of memory in bytes
+ * @param InAlignment	Alignment of memory
+ * @return Return pointer to reallocated memory
+ */
+FORCEINLINE void* appRealloc( void* InOriginal, uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT )
+{
+	if ( !GMalloc )
+	{
+		appCreateMalloc();
+	}
+	return GMalloc->Realloc( InOriginal, InSize, InAlignment );
+}
+
+/**
+ * @ingroup Core
+ * @brief Free memory through global allocator
+ * @param InOriginal	Pointer to memory. May be NULL
+ */
+FORCEINLINE void appFree( void* InOriginal )
+{
+	if ( !InOriginal )
+	{
+		return;
+	}
+
+	check( GMalloc );
+	GMalloc->Free( InOriginal );
+}
+
+#endif // !MALLOC_H
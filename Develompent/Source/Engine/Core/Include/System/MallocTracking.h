@@ -0,0 +1,227 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MALLOCTRACKING_H
+#define MALLOCTRACKING_H
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "System/Malloc.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Core
+ * @brief Max depth of captured call stack for each allocation
+ */
+#define MALLOC_MAX_CALLSTACK_DEPTH		16
+
+/**
+ * @ingroup Core
+ * @brief Settings of tracking allocator
+ */
+struct SMallocTrackingSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	SMallocTrackingSettings()
+		: bTrackAllocations( false )
+		, bCaptureCallStacks( false )
+		, callStackDepth( 8 )
+		, bReportLeaksOnExit( false )
+	{}
+
+	/**
+	 * @brief Load settings from engine config (section 'Engine.Memory')
+	 */
+	void LoadFromConfig();
+
+	bool		bTrackAllocations;		/**< Is need keep list of live allocations (for leak reports) */
+	bool		bCaptureCallStacks;		/**< Is need capture call stack for each allocation, it works only with bTrackAllocations */
+	uint32		callStackDepth;			/**< Depth of captured call stacks */
+	bool		bReportLeaksOnExit;		/**< Is need print report of live allocations on exit */
+};
+
+/**
+ * @ingroup Core
+ * @brief Statistics of allocations with one memory tag
+ */
+struct SMemoryTagStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SMemoryTagStats()
+		: liveBytes( 0 )
+		, peakBytes( 0 )
+		, numLiveAllocations( 0 )
+		, numTotalAllocations( 0 )
+	{}
+
+	volatile int64		liveBytes;				/**< Size of live allocations in bytes */
+	volatile int64		peakBytes;				/**< Peak of live bytes */
+	volatile int64		numLiveAllocations;		/**< Number of live allocations */
+	volatile int64		numTotalAllocations;	/**< Number of allocations since start */
+};
+
+/**
+ * @ingroup Core
+ * @brief Allocator which counts allocations per memory tag and optionally keeps list of live allocations with call stacks
+ *
+ * It wraps other allocator and adds small header before each allocation, so it is cheap enough
+ * to be enabled in all not shipping builds. List of live allocations and call stacks are disabled by default,
+ * enable them in config (section 'Engine.Memory') for hunting leaks
+ */
+class CMallocTracking : public CMalloc
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InInnerMalloc		Allocator which really allocates memory
+	 */
+	CMallocTracking( CMalloc* InInnerMalloc );
+
+	/**
+	 * @brief Allocate memory
+	 *
+	 * @param InSize		Size of memory in bytes
+	 * @param InAlignment	Alignment of memory
+	 * @return Return pointer to allocated memory, if failed will return NULL
+	 */
+	virtual void* Malloc( uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT ) override;
+
+	/**
+	 * @brief Reallocate memory
+	 *
+	 * @param InOriginal	Pointer to original memory. May be NULL
+	 * @param InSize		New size of memory in bytes. If 0 memory will be freed
+	 * @param InAlignment	Alignment of memory
+	 * @return Return pointer to reallocated memory
+	 */
+	virtual void* Realloc( void* InOriginal, uint64 InSize, uint32 InAlignment = DEFAULT_ALIGNMENT ) override;
+
+	/**
+	 * @brief Free memory
+	 * @param InOriginal	Pointer to memory. May be NULL
+	 */
+	virtual void Free( void* InOriginal ) override;
+
+	/**
+	 * @brief Get size of allocation
+	 *
+	 * @param InOriginal	Pointer to memory
+	 * @param OutSize		Output size of allocation
+	 * @return Return TRUE if size is known, otherwise will return FALSE
+	 */
+	virtual bool GetAllocationSize( void* InOriginal, uint64& OutSize ) override;
+
+	/**
+	 * @brief Get descriptive name of allocator
+	 * @return Return descriptive name of allocator
+	 */
+	virtual const tchar* GetDescriptiveName() const override;
+
+	/**
+	 * @brief Apply settings
+	 * List of live allocations contains only allocations which made after enable it
+	 *
+	 * @param InSettings	Settings
+	 */
+	void ApplySettings( const SMallocTrackingSettings& InSettings );
+
+	/**
+	 * @brief Save current statistics of memory tags, next DumpStats will print difference with it
+	 */
+	void TakeSnapshot();
+
+	/**
+	 * @brief Print statistics of memory tags into log
+	 * @param InIsCompareWithSnapshot	Is need print difference with last snapshot
+	 */
+	void DumpStats( bool InIsCompareWithSnapshot = true ) const;
+
+	/**
+	 * @brief Print live allocations grouped by call stack into log
+	 * @param InMaxEntries	Max number of printed groups (sorted by size)
+	 */
+	void DumpLiveAllocations( uint32 InMaxEntries = 32 );
+
+	/**
+	 * @brief Get statistics of memory tag
+	 *
+	 * @param InMemoryTag	Memory tag
+	 * @return Return statistics of memory tag
+	 */
+	FORCEINLINE const SMemoryTagStats& GetTagStats( EMemoryTag InMemoryTag ) const
+	{
+		check( InMemoryTag < MTAG_Num );
+		return tagStats[ InMemoryTag ];
+	}
+
+	/**
+	 * @brief Get settings
+	 * @return Return current settings
+	 */
+	FORCEINLINE const SMallocTrackingSettings& GetSettings() const
+	{
+		return settings;
+	}
+
+private:
+	/**
+	 * @brief Header of each allocation, it placed right before user memory
+	 */
+	struct SAllocationHeader
+	{
+		SAllocationHeader*		prev;			/**< Previous allocation in list of live allocations */
+		SAllocationHeader*		next;			/**< Next allocation in list of live allocations */
+		uint64*					backTrace;		/**< Captured call stack (allocated from inner allocator), may be NULL */
+		uint64					size;			/**< Size of user memory */
+		uint32					offset;			/**< Offset from begin of inner allocation to user memory */
+		uint32					magic;			/**< Magic number for validate header */
+		uint16					tag;			/**< Memory tag (see EMemoryTag) */
+		uint8					numFrames;		/**< Number of frames in backTrace */
+		uint8					bLinked;		/**< Is allocation in list of live allocations */
+	};
+
+	/**
+	 * @brief Get header of allocation
+	 *
+	 * @param InPtr		Pointer to user memory
+	 * @return Return header of allocation
+	 */
+	FORCEINLINE static SAllocationHeader* GetHeader( void* InPtr )
+	{
+		return ( SAllocationHeader* )( ( byte* )InPtr - sizeof( SAllocationHeader ) );
+	}
+
+	/**
+	 * @brief Update counters of memory tag
+	 *
+	 * @param InMemoryTag	Memory tag
+	 * @param InDeltaBytes	Delta of live bytes
+	 * @param InDeltaCount	Delta of live allocations
+	 */
+	void UpdateTagStats( uint32 InMemoryTag, int64 InDeltaBytes, int64 InDeltaCount );
+
+	CMalloc*					innerMalloc;					/**< Allocator which really allocates memory */
+	SMallocTrackingSettings		settings;						/**< Settings */
+	SMemoryTagStats				tagStats[ MTAG_Num ];			/**< Statistics of memory tags */
+	SMemoryTagStats				snapshotStats[ MTAG_Num ];		/**< Statistics of memory tags in last snapshot */
+	double						snapshotTime;					/**< Time of last snapshot */
+	CCriticalSection			allocationsCS;					/**< Critical section of list of live allocations */
+	SAllocationHeader*			allocationsHead;				/**< Head of list of live allocations */
+};
+
+/**
+ * @ingroup Core
+ * @brief Global tracking allocator. It is NULL if tracking is disabled (see WITH_MEMORY_TRACKING)
+ */
+extern CMallocTracking*			GMallocTracking;
+
+#endif // !MALLOCTRACKING_H
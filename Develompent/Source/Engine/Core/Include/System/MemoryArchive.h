@@ -0,0 +1,150 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MEMORYARCHIVE_H
+#define MEMORYARCHIVE_H
+
+#include <vector>
+
+#include "Core.h"
+#include "System/Archive.h"
+
+/**
+ * @ingroup Core
+ * @brief The class for reading archive from memory
+ *
+ * Used for reading big blocks of data which were read from file by one call, so many small serialize calls
+ * of objects are just copying from memory
+ */
+class CMemoryArchiveReading : public CArchive
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InData	Data of archive. Archive doesn't own data, it must be alive while archive is used
+	 * @param InSize	Size of data
+	 * @param InVer		Version of archive, usually it's version of parent archive
+	 * @param InType	Type of archive
+	 */
+	CMemoryArchiveReading( const byte* InData, uint32 InSize, uint32 InVer, EArchiveType InType );
+
+	/**
+	 * @brief Serialize data
+	 *
+	 * @param[in] InBuffer Pointer to buffer for serialize
+	 * @param[in] InSize Size of buffer
+	 */
+	virtual void Serialize( void* InBuffer, uint32 InSize ) override;
+
+	/**
+	 * @brief Get current position in archive
+	 * @return Current position in archive
+	 */
+	virtual uint32 Tell() override;
+
+	/**
+	 * @brief Set current position in archive
+	 *
+	 * @param[in] InPosition New position in archive
+	 */
+	virtual void Seek( uint32 InPosition ) override;
+
+	/**
+	 * @breif Is loading archive
+	 * @return True if archive loading, false if archive saving
+	 */
+	virtual bool IsLoading() const override;
+
+	/**
+	 * Is end of file
+	 * @return Return true if end of file, else return false
+	 */
+	virtual bool IsEndOfFile() override;
+
+	/**
+	 * @brief Get size of archive
+	 * @return Size of archive
+	 */
+	virtual uint32 GetSize() override;
+
+private:
+	const byte*		data;		/**< Data of archive */
+	uint32			size;		/**< Size of data */
+	uint32			offset;		/**< Current position in data */
+};
+
+/**
+ * @ingroup Core
+ * @brief The class for writing archive to memory
+ */
+class CMemoryArchiveWriter : public CArchive
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param InVer		Version of archive, usually it's version of parent archive
+	 * @param InType	Type of archive
+	 */
+	CMemoryArchiveWriter( uint32 InVer, EArchiveType InType );
+
+	/**
+	 * @brief Serialize data
+	 *
+	 * @param[in] InBuffer Pointer to buffer for serialize
+	 * @param[in] InSize Size of buffer
+	 */
+	virtual void Serialize( void* InBuffer, uint32 InSize ) override;
+
+	/**
+	 * @brief Get current position in archive
+	 * @return Current position in archive
+	 */
+	virtual uint32 Tell() override;
+
+	/**
+	 * @brief Set current position in archive
+	 *
+	 * @param[in] InPosition New position in archive
+	 */
+	virtual void Seek( uint32 InPosition ) override;
+
+	/**
+	 * @brief Is saving archive
+	 * @return True if archive saving, false if archive loading
+	 */
+	virtual bool IsSaving() const override;
+
+	/**
+	 * Is end of file
+	 * @return Return true if end of file, else return false
+	 */
+	virtual bool IsEndOfFile() override;
+
+	/**
+	 * @brief Get size of archive
+	 * @return Size of archive
+	 */
+	virtual uint32 GetSize() override;
+
+	/**
+	 * @brief Get written data
+	 * @return Return written data
+	 */
+	FORCEINLINE const std::vector<byte>& GetData() const
+	{
+		return data;
+	}
+
+private:
+	std::vector<byte>		data;		/**< Written data */
+	uint32					offset;		/**< Current position in data */
+};
+
+#endif // !MEMORYARCHIVE_H
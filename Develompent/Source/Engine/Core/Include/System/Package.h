@@ -21,6 +21,7 @@
 #include "Misc/Misc.h"
 #include "Misc/Guid.h"
 #include "Misc/TableOfContents.h"
+#include "Containers/HashedString.h"
 #include "Misc/CoreGlobals.h"
 #include "System/Delegate.h"
 #include "System/Archive.h"
@@ -58,7 +59,7 @@ enum EAssetType
  * @param InText	Asset type in text format
  * @return Return converted asset type to enumeration
  */
-FORCEINLINE EAssetType ConvertTextToAssetType( const std::wstring& InText )
+FORCEINLINE EAssetType ConvertTextToAssetType( const CStringView& InText )
 {
 	if ( InText == TEXT( "Texture2D" ) )
 	{
@@ -905,9 +906,9 @@ public:
 	 * @param InIgnoreDirty		Is need ignore dirty flag in asset
 	 * @return Return TRUE if asset seccussed removed from package
 	 */
-	FORCEINLINE bool Remove( const std::wstring& InName, bool InForceUnload = false, bool InIgnoreDirty = false )
+	FORCEINLINE bool Remove( const CStringView& InName, bool InForceUnload = false, bool InIgnoreDirty = false )
 	{
-		auto		itAssetGUID = assetGUIDTable.find( InName );
+		auto		itAssetGUID = assetGUIDTable.find( CHashedString::MakeLookupKey( InName ) );
 		if ( itAssetGUID == assetGUIDTable.end() )
 		{
 			return true;
@@ -1028,9 +1029,9 @@ public:
 	 * @param InName		Asset name
 	 * @return Return TRUE if asset with name InName exist in package, else return FALSE
 	 */
-	FORCEINLINE bool IsExist( const std::wstring& InName ) const
+	FORCEINLINE bool IsExist( const CStringView& InName ) const
 	{
-		auto		itAssetGUID = assetGUIDTable.find( InName );
+		auto		itAssetGUID = assetGUIDTable.find( CHashedString::MakeLookupKey( InName ) );
 		if ( itAssetGUID == assetGUIDTable.end() )
 		{
 			return false;
@@ -1070,9 +1071,9 @@ public:
 	 * @param InName Name asset
 	 * @return Return pointer to asset in package, if not found return nullptr
 	 */
-	FORCEINLINE TAssetHandle<CAsset> Find( const std::wstring& InName )
+	FORCEINLINE TAssetHandle<CAsset> Find( const CStringView& InName )
 	{
-		auto		itAssetGUID = assetGUIDTable.find( InName );
+		auto		itAssetGUID = assetGUIDTable.find( CHashedString::MakeLookupKey( InName ) );
 		if ( itAssetGUID == assetGUIDTable.end() )
 		{
 			return nullptr;
@@ -1217,9 +1218,10 @@ public:
 
 private:
 	/**
-	 * Typedef map of asset name to GUID
+	 * Typedef map of asset name to GUID.
+	 * Key is CHashedString, so lookup by short name not allocates memory and hash is calculated once
 	 */
-	typedef std::unordered_map< std::wstring, CGuid >								AssetNameToGUID_t;
+	typedef std::unordered_map< CHashedString, CGuid, CHashedString::SHashedStringKeyFunc >		AssetNameToGUID_t;
 
 	/**
 	 * Typedef map of assets table
@@ -1364,7 +1366,7 @@ public:
 	 * @param InType Asset type. Optional parameter, if setted return default asset in case fail
 	 * @return Return finded asset. If not found returning nullptr
 	 */
-	TAssetHandle<CAsset> FindAsset( const std::wstring& InString, EAssetType InType = AT_Unknown );
+	TAssetHandle<CAsset> FindAsset( const CStringView& InString, EAssetType InType = AT_Unknown );
 
 	/**
 	 * Find asset in package
@@ -1401,7 +1403,7 @@ public:
 	 * @param InAsset Asset name in the package
 	 * @param InType Asset type. Optional parameter, if setted return default asset in case fail
 	 */
-	TAssetHandle<CAsset> FindAsset( const std::wstring& InPath, const std::wstring& InAsset, EAssetType InType = AT_Unknown );
+	TAssetHandle<CAsset> FindAsset( const std::wstring& InPath, const CStringView& InAsset, EAssetType InType = AT_Unknown );
 
 	/**
 	 * Find default asset
@@ -1626,7 +1628,31 @@ private:
  * @param OutAssetType Asset type
  * @return Return true if InString parsed is seccussed, else returning false
  */
-bool ParseReferenceToAsset( const std::wstring& InString, std::wstring& OutPackageName, std::wstring& OutAssetName, EAssetType& OutAssetType );
+bool ParseReferenceToAsset( const CStringView& InString, CStringView& OutPackageName, CStringView& OutAssetName, EAssetType& OutAssetType );
+
+/**
+ * @ingroup Core
+ * @brief Parse reference to asset in format <AssetType>'<PackageName>:<AssetName>
+ *
+ * @param InString Reference to asset
+ * @param OutPackageName Package name
+ * @param OutAssetName Asset name
+ * @param OutAssetType Asset type
+ * @return Return true if InString parsed is seccussed, else returning false
+ */
+FORCEINLINE bool ParseReferenceToAsset( const CStringView& InString, std::wstring& OutPackageName, std::wstring& OutAssetName, EAssetType& OutAssetType )
+{
+	CStringView		packageName;
+	CStringView		assetName;
+	if ( !ParseReferenceToAsset( InString, packageName, assetName, OutAssetType ) )
+	{
+		return false;
+	}
+
+	OutPackageName	= packageName.ToString();
+	OutAssetName	= assetName.ToString();
+	return true;
+}
 
 /**
  * @ingroup Core
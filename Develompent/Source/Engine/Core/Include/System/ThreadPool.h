@@ -0,0 +1,136 @@
+/**
+ * @file
+ * @addtogroup Core Core
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <functional>
+
+#include "Misc/Types.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Core
+ * @brief Pool of worker threads for parallel loops
+ *
+ * Calling thread participates in the loop too, so ParallelFor returns only when all iterations are done.
+ * If the pool isn't initialized or ParallelFor is called from worker thread, the loop is executed serially
+ */
+class CThreadPool
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CThreadPool();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CThreadPool();
+
+	/**
+	 * @brief Create worker threads
+	 * @param InNumWorkers	Number of worker threads. If 0 will be used number of logical cores minus one
+	 */
+	void Init( uint32 InNumWorkers = 0 );
+
+	/**
+	 * @brief Stop and destroy worker threads
+	 */
+	void Shutdown();
+
+	/**
+	 * @brief Execute function for each index in range [0, InNum) on worker threads and calling thread
+	 *
+	 * @param InNum			Number of iterations
+	 * @param InFunction	Function of one iteration, receives index of iteration
+	 * @param InBatchSize	Number of iterations which worker takes at once
+	 */
+	void ParallelFor( uint32 InNum, const std::function<void( uint32 )>& InFunction, uint32 InBatchSize = 1 );
+
+	/**
+	 * @brief Get number of worker threads
+	 * @return Return number of worker threads
+	 */
+	FORCEINLINE uint32 GetNumWorkers() const
+	{
+		return ( uint32 )workerThreads.size();
+	}
+
+	/**
+	 * @brief Is current thread is worker of any thread pool
+	 * @return Return TRUE if current thread is worker, otherwise returns FALSE
+	 */
+	static bool IsInWorkerThread();
+
+private:
+	/**
+	 * @brief Runnable of worker thread
+	 */
+	class CWorker : public CRunnable
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param InThreadPool	Owner thread pool
+		 */
+		CWorker( CThreadPool* InThreadPool );
+
+		/**
+		 * @brief Initialize
+		 * @return True if initialization was successful, false otherwise
+		 */
+		virtual bool Init() override;
+
+		/**
+		 * @brief Run
+		 * @return The exit code of the runnable object
+		 */
+		virtual uint32 Run() override;
+
+		/**
+		 * @brief Stop
+		 */
+		virtual void Stop() override;
+
+		/**
+		 * @brief Exit
+		 */
+		virtual void Exit() override;
+
+	private:
+		CThreadPool*		threadPool;		/**< Owner thread pool */
+	};
+
+	/**
+	 * @brief Take batches of current job and execute them until job is over
+	 */
+	void ExecuteJob();
+
+	std::vector<CWorker*>						workers;				/**< Runnables of workers */
+	std::vector<CRunnableThread*>				workerThreads;			/**< Worker threads */
+	CSemaphore*									workSemaphore;			/**< Semaphore for wake up workers */
+	CEvent*										jobDoneEvent;			/**< Event triggered by last worker which finished job */
+	CCriticalSection							dispatchCS;				/**< Critical section for dispatch only one job at once */
+	const std::function<void( uint32 )>*		jobFunction;			/**< Function of current job */
+	uint32										jobNum;					/**< Number of iterations in current job */
+	uint32										jobBatchSize;			/**< Batch size of current job */
+	volatile int32								jobNextIndex;			/**< Next not taken iteration of current job */
+	volatile int32								jobNumPendingWorkers;	/**< Number of workers which didn't finish current job */
+	volatile bool								bIsStopping;			/**< Is need stop workers */
+};
+
+/**
+ * @ingroup Core
+ * @brief Global thread pool
+ */
+extern CThreadPool			GThreadPool;
+
+#endif // !THREADPOOL_H
@@ -0,0 +1,135 @@
+#include <string.h>
+
+#include "Containers/HashedString.h"
+#include "Containers/StringConv.h"
+
+/**
+ * Create string from UTF-8
+ */
+CHashedString CHashedString::FromUTF8( const achar* InString )
+{
+	if ( !InString )
+	{
+		return CHashedString();
+	}
+
+	// Short strings converted on stack, without allocation
+	uint32				lengthA = ( uint32 )strlen( InString );
+	tchar				buffer[ 256 ];
+	tchar*				dest = lengthA < ARRAY_COUNT( buffer ) ? buffer : new tchar[ lengthA + 1 ];
+	uint32				lengthW = appUTF8ToTCHAR( InString, lengthA, dest );
+	CHashedString		result( CStringView( dest, lengthW ) );
+
+	if ( dest != buffer )
+	{
+		delete[] dest;
+	}
+	return result;
+}
+
+/**
+ * Convert string to UTF-8
+ */
+std::string CHashedString::ToUTF8() const
+{
+	std::string		result;
+	result.resize( length * 4 );
+	result.resize( appTCHARToUTF8( data, length, result.data() ) );
+	return result;
+}
+
+/**
+ * Assign new string
+ */
+void CHashedString::Assign( const CStringView& InString, uint64 InHash /* = INVALID_HASH */ )
+{
+	uint32		newLength = InString.GetLength();
+	tchar*		newData = data;
+
+	// Select storage for new string: inline, current heap buffer or new heap buffer. Borrowed data is never reused
+	if ( newLength <= HASHEDSTRING_INLINE_LENGTH )
+	{
+		newData = inlineData;
+	}
+	else if ( data == inlineData || bBorrowed || newLength > length )
+	{
+		newData = new tchar[ newLength + 1 ];
+	}
+
+	// memmove because InString may point to our data
+	memmove( newData, InString.GetData(), newLength * sizeof( tchar ) );
+	newData[ newLength ] = TEXT( '\0' );
+
+	if ( newData != data )
+	{
+		FreeData();
+		data = newData;
+	}
+
+	length	= newLength;
+	hash	= InHash != ( uint64 )INVALID_HASH ? InHash : appStrHash( data, length );
+}
+
+/**
+ * Move data from other string
+ */
+void CHashedString::MoveFrom( CHashedString& InOther )
+{
+	check( data == inlineData );
+	if ( InOther.data == InOther.inlineData )
+	{
+		memcpy( inlineData, InOther.inlineData, ( InOther.length + 1 ) * sizeof( tchar ) );
+	}
+	else
+	{
+		data				= InOther.data;
+		bBorrowed			= InOther.bBorrowed;
+		InOther.data		= InOther.inlineData;
+		InOther.bBorrowed	= false;
+	}
+
+	length					= InOther.length;
+	hash					= InOther.hash;
+	InOther.length			= 0;
+	InOther.hash			= appStrHash( TEXT( "" ), 0 );
+	InOther.inlineData[ 0 ]	= TEXT( '\0' );
+}
+
+/**
+ * Serialize
+ */
+CArchive& operator<<( CArchive& InArchive, CHashedString& InValue )
+{
+	if ( InArchive.IsSaving() )
+	{
+		return InArchive << ( const CHashedString& )InValue;
+	}
+
+	// Serialized in the same format as std::wstring, so they are interchangeable in archives
+	std::wstring		string;
+	InArchive << string;
+	InValue = CStringView( string );
+	return InArchive;
+}
+
+/**
+ * Serialize
+ */
+CArchive& operator<<( CArchive& InArchive, const CHashedString& InValue )
+{
+	check( InArchive.IsSaving() );
+	if ( InArchive.Type() == AT_TextFile )
+	{
+		InArchive.Serialize( ( void* )InValue.data, InValue.length * sizeof( tchar ) );
+	}
+	else
+	{
+		uint32		stringSize = InValue.length * sizeof( tchar );
+		InArchive << stringSize;
+		if ( stringSize > 0 )
+		{
+			InArchive.Serialize( ( void* )InValue.data, stringSize );
+		}
+	}
+	return InArchive;
+}
@@ -0,0 +1,153 @@
+#include "Containers/StringConv.h"
+
+/**
+ * Is TCHAR is UTF-16 (on Windows), otherwise it is UTF-32
+ */
+#define TCHAR_IS_UTF16		( sizeof( tchar ) == 2 )
+
+/**
+ * Replacement char for invalid sequences
+ */
+#define UTF_INVALID_CHAR	( ( uint32 )'?' )
+
+/**
+ * Convert UTF-8 string to TCHAR string
+ */
+uint32 appUTF8ToTCHAR( const achar* InSource, uint32 InLength, tchar* OutDest )
+{
+	const byte*		source = ( const byte* )InSource;
+	const byte*		sourceEnd = source + InLength;
+	tchar*			dest = OutDest;
+
+	while ( source < sourceEnd )
+	{
+		// Fast path for ASCII
+		uint32		codePoint = *source;
+		if ( codePoint < 0x80 )
+		{
+			*dest++ = ( tchar )codePoint;
+			++source;
+			continue;
+		}
+
+		// Determine length of sequence
+		uint32		numExtraBytes = 0;
+		if ( ( codePoint & 0xE0 ) == 0xC0 )
+		{
+			numExtraBytes = 1;
+			codePoint &= 0x1F;
+		}
+		else if ( ( codePoint & 0xF0 ) == 0xE0 )
+		{
+			numExtraBytes = 2;
+			codePoint &= 0x0F;
+		}
+		else if ( ( codePoint & 0xF8 ) == 0xF0 )
+		{
+			numExtraBytes = 3;
+			codePoint &= 0x07;
+		}
+		else
+		{
+			*dest++ = ( tchar )UTF_INVALID_CHAR;
+			++source;
+			continue;
+		}
+
+		// Read continuation bytes
+		++source;
+		bool		bIsValid = source + numExtraBytes <= sourceEnd;
+		for ( uint32 index = 0; bIsValid && index < numExtraBytes; ++index, ++source )
+		{
+			bIsValid = ( *source & 0xC0 ) == 0x80;
+			codePoint = ( codePoint << 6 ) | ( *source & 0x3F );
+		}
+
+		if ( !bIsValid || codePoint > 0x10FFFF || ( codePoint >= 0xD800 && codePoint <= 0xDFFF ) )
+		{
+			*dest++ = ( tchar )UTF_INVALID_CHAR;
+			continue;
+		}
+
+		// Write code point, in UTF-16 characters outside BMP are encoded by surrogate pair
+		if ( TCHAR_IS_UTF16 && codePoint > 0xFFFF )
+		{
+			codePoint -= 0x10000;
+			*dest++ = ( tchar )( 0xD800 + ( codePoint >> 10 ) );
+			*dest++ = ( tchar )( 0xDC00 + ( codePoint & 0x3FF ) );
+		}
+		else
+		{
+			*dest++ = ( tchar )codePoint;
+		}
+	}
+
+	*dest = TEXT( '\0' );
+	return ( uint32 )( dest - OutDest );
+}
+
+/**
+ * Convert TCHAR string to UTF-8 string
+ */
+uint32 appTCHARToUTF8( const tchar* InSource, uint32 InLength, achar* OutDest )
+{
+	const tchar*	sourceEnd = InSource + InLength;
+	byte*			dest = ( byte* )OutDest;
+
+	for ( const tchar* source = InSource; source < sourceEnd; ++source )
+	{
+		uint32		codePoint = ( uint32 )*source;
+
+		// Fast path for ASCII
+		if ( codePoint < 0x80 )
+		{
+			*dest++ = ( byte )codePoint;
+			continue;
+		}
+
+		// Combine surrogate pair in UTF-16
+		if ( TCHAR_IS_UTF16 && codePoint >= 0xD800 && codePoint <= 0xDBFF )
+		{
+			uint32		lowSurrogate = source + 1 < sourceEnd ? ( uint32 )source[ 1 ] : 0;
+			if ( lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF )
+			{
+				codePoint = 0x10000 + ( ( codePoint - 0xD800 ) << 10 ) + ( lowSurrogate - 0xDC00 );
+				++source;
+			}
+			else
+			{
+				codePoint = UTF_INVALID_CHAR;
+			}
+		}
+		else if ( ( codePoint >= 0xD800 && codePoint <= 0xDFFF ) || codePoint > 0x10FFFF )
+		{
+			codePoint = UTF_INVALID_CHAR;
+		}
+
+		if ( codePoint < 0x80 )
+		{
+			*dest++ = ( byte )codePoint;
+		}
+		else if ( codePoint < 0x800 )
+		{
+			*dest++ = ( byte )( 0xC0 | ( codePoint >> 6 ) );
+			*dest++ = ( byte )( 0x80 | ( codePoint & 0x3F ) );
+		}
+		else if ( codePoint < 0x10000 )
+		{
+			*dest++ = ( byte )( 0xE0 | ( codePoint >> 12 ) );
+			*dest++ = ( byte )( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+			*dest++ = ( byte )( 0x80 | ( codePoint & 0x3F ) );
+		}
+		else
+		{
+			*dest++ = ( byte )( 0xF0 | ( codePoint >> 18 ) );
+			*dest++ = ( byte )( 0x80 | ( ( codePoint >> 12 ) & 0x3F ) );
+			*dest++ = ( byte )( 0x80 | ( ( codePoint >> 6 ) & 0x3F ) );
+			*dest++ = ( byte )( 0x80 | ( codePoint & 0x3F ) );
+		}
+	}
+
+	*dest = '\0';
+	return ( uint32 )( dest - ( byte* )OutDest );
+}
@@ -0,0 +1,547 @@
+#include <algorithm>
+
+#include "Logger/AsyncLogBackend.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/Config.h"
+#include "Containers/String.h"
+
+/** Asynchronous logging backend */
+CAsyncLogBackend		GAsyncLog;
+
+/**
+ * Load settings from engine config
+ */
+void SAsyncLogSettings::LoadFromConfig()
+{
+	CConfigValue		configAsync = GConfig.GetValue( CT_Engine, TEXT( "Engine.Log" ), TEXT( "Async" ) );
+	if ( configAsync.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configAsync.GetBool();
+	}
+
+	CConfigValue		configBinary = GConfig.GetValue( CT_Engine, TEXT( "Engine.Log" ), TEXT( "Binary" ) );
+	if ( configBinary.IsA( CConfigValue::T_Bool ) )
+	{
+		bBinary = configBinary.GetBool();
+	}
+
+	CConfigValue		configThreadBufferSize = GConfig.GetValue( CT_Engine, TEXT( "Engine.Log" ), TEXT( "ThreadBufferSize" ) );
+	if ( configThreadBufferSize.IsA( CConfigValue::T_Int ) )
+	{
+		threadBufferSize = Max( configThreadBufferSize.GetInt(), 4096 );
+	}
+
+	CConfigValue		configFlushInterval = GConfig.GetValue( CT_Engine, TEXT( "Engine.Log" ), TEXT( "FlushInterval" ) );
+	if ( configFlushInterval.IsA( CConfigValue::T_Int ) )
+	{
+		flushInterval = Max( configFlushInterval.GetInt(), 1 );
+	}
+
+	CConfigValue		configOverflowPolicy = GConfig.GetValue( CT_Engine, TEXT( "Engine.Log" ), TEXT( "OverflowPolicy" ) );
+	if ( configOverflowPolicy.IsA( CConfigValue::T_String ) )
+	{
+		overflowPolicy = configOverflowPolicy.GetString() == TEXT( "Drop" ) ? LOP_Drop : LOP_Block;
+	}
+}
+
+/**
+ * Constructor
+ */
+CLogThreadBuffer::CLogThreadBuffer( uint32 InSize, uint32 InThreadId )
+	: data( nullptr )
+	, size( Align( InSize, LOG_RECORD_ALIGNMENT ) )
+	, threadId( InThreadId )
+	, writeOffset( 0 )
+	, pendingWriteOffset( 0 )
+	, numRecords( 0 )
+	, numDropped( 0 )
+	, numBlocked( 0 )
+	, readOffset( 0 )
+	, pendingReadOffset( 0 )
+	, numReportedDropped( 0 )
+{
+	data = new byte[ size ];
+}
+
+/**
+ * Destructor
+ */
+CLogThreadBuffer::~CLogThreadBuffer()
+{
+	delete[] data;
+}
+
+/**
+ * Begin write record into buffer
+ */
+byte* CLogThreadBuffer::BeginWrite( uint32 InSize )
+{
+	const uint32		currentWriteOffset	= writeOffset;
+	const uint32		currentReadOffset	= readOffset;
+
+	// Write offset never must be equal read offset after write, because it means that buffer is empty
+	if ( currentWriteOffset >= currentReadOffset )
+	{
+		// Enough space at the end of buffer
+		if ( size - currentWriteOffset > InSize )
+		{
+			pendingWriteOffset = currentWriteOffset + InSize;
+			return data + currentWriteOffset;
+		}
+
+		// Enough space at the begin of buffer, wrap around
+		if ( currentReadOffset > InSize )
+		{
+			// Mark the rest of buffer as padding. If there is no space for header, reader wraps around by himself
+			if ( size - currentWriteOffset >= sizeof( SLogRecordHeader ) )
+			{
+				SLogRecordHeader*		padding = ( SLogRecordHeader* )( data + currentWriteOffset );
+				padding->size			= size - currentWriteOffset;
+				padding->formatId		= LOG_PADDING_FORMAT_ID;
+			}
+
+			pendingWriteOffset = InSize;
+			return data;
+		}
+	}
+	else if ( currentReadOffset - currentWriteOffset > InSize )
+	{
+		pendingWriteOffset = currentWriteOffset + InSize;
+		return data + currentWriteOffset;
+	}
+
+	return nullptr;
+}
+
+/**
+ * Collect all published records
+ */
+void CLogThreadBuffer::CollectRecords( std::vector< const SLogRecordHeader* >& OutRecords )
+{
+	const uint32		currentWriteOffset	= writeOffset;
+	uint32				currentReadOffset	= readOffset;
+	while ( currentReadOffset != currentWriteOffset )
+	{
+		// Not enough space for header at the end of buffer, writer wrapped around
+		if ( size - currentReadOffset < sizeof( SLogRecordHeader ) )
+		{
+			currentReadOffset = 0;
+			continue;
+		}
+
+		const SLogRecordHeader*		record = ( const SLogRecordHeader* )( data + currentReadOffset );
+		if ( record->formatId == LOG_PADDING_FORMAT_ID )
+		{
+			currentReadOffset = 0;
+			continue;
+		}
+
+		OutRecords.push_back( record );
+		currentReadOffset += record->size;
+	}
+
+	pendingReadOffset = currentReadOffset;
+}
+
+/**
+ * Constructor
+ */
+CAsyncLogBackend::CAsyncLogBackend()
+	: bIsRunning( false )
+	, bIsStopping( false )
+	, numActivePushes( 0 )
+	, logThreadId( 0 )
+	, logThread( nullptr )
+	, wakeUpEvent( nullptr )
+	, binaryArchive( nullptr )
+	, numBinaryBytes( 0 )
+{}
+
+/**
+ * Destructor
+ */
+CAsyncLogBackend::~CAsyncLogBackend()
+{
+	for ( uint32 index = 0, count = threadBuffers.size(); index < count; ++index )
+	{
+		delete threadBuffers[ index ];
+	}
+	threadBuffers.clear();
+}
+
+/**
+ * Start log thread
+ */
+void CAsyncLogBackend::Start( const SAsyncLogSettings& InSettings )
+{
+	check( IsInGameThread() );
+	if ( bIsRunning || !InSettings.bEnable )
+	{
+		return;
+	}
+
+	settings		= InSettings;
+	bIsStopping		= false;
+
+	// Open binary log file
+	if ( settings.bBinary )
+	{
+		std::wstring		binaryLogFile = GLog->GetLogFilename( TEXT( "lbin" ) );
+		binaryArchive = !binaryLogFile.empty() ? GFileSystem->CreateFileWriter( binaryLogFile, AW_None ) : nullptr;
+		if ( binaryArchive )
+		{
+			binaryArchive->SetType( AT_BinaryLog );
+			binaryArchive->SerializeHeader();
+			GLog->Logf( LT_Log, LC_Init, TEXT( "Opened binary log file '%s'" ), binaryLogFile.c_str() );
+		}
+		else
+		{
+			GLog->Logf( LT_Warning, LC_Init, TEXT( "Failed to open binary log file '%s', messages will be formatted as text" ), binaryLogFile.c_str() );
+		}
+	}
+
+	wakeUpEvent = GSynchronizeFactory->CreateSynchEvent();
+	check( wakeUpEvent );
+
+	bIsRunning	= true;
+	logThread	= GThreadFactory->CreateThread( this, TEXT( "LogThread" ), false, false, 0, TP_BelowNormal );
+	check( logThread );
+}
+
+/**
+ * Flush all messages and stop log thread
+ */
+void CAsyncLogBackend::Shutdown()
+{
+	if ( !bIsRunning )
+	{
+		return;
+	}
+
+	// New messages will be formatted on calling thread
+	bIsRunning = false;
+
+	// Wait for threads which are pushing records, log thread still works and frees space for blocked ones
+	while ( numActivePushes > 0 )
+	{
+		appSleep( 0.f );
+	}
+
+	// Stop log thread, before exit he flushes all messages
+	Stop();
+	logThread->WaitForCompletion();
+	logThread->Kill();
+	GThreadFactory->Destroy( logThread );
+	GSynchronizeFactory->Destroy( wakeUpEvent );
+	logThread	= nullptr;
+	wakeUpEvent = nullptr;
+
+	// Print statistics
+	SAsyncLogStats		stats = GetStats();
+	GLog->Logf( LT_Log, LC_General, TEXT( "Async log: %i threads, %llu records, %llu dropped, %llu blocked, %llu bytes in binary log" ), stats.numThreadBuffers, stats.numRecords, stats.numDropped, stats.numBlocked, stats.numBinaryBytes );
+
+	if ( binaryArchive )
+	{
+		delete binaryArchive;
+		binaryArchive = nullptr;
+	}
+}
+
+/**
+ * Register static format string
+ */
+uint32 CAsyncLogBackend::RegisterFormat( SLogCallSite& InCallSite, const tchar* InFormat )
+{
+	CScopeLock		scopeLock( formatsCS );
+
+	// Other thread may register this call site while we waited lock
+	if ( InCallSite.GetFormatId() != LOG_DYNAMIC_FORMAT_ID )
+	{
+		return InCallSite.GetFormatId();
+	}
+
+	uint32			formatId = formats.size();
+	formats.push_back( InFormat );
+	appInterlockedExchange( &InCallSite.formatId, ( int32 )formatId );
+	return formatId;
+}
+
+/**
+ * Get ring buffer of current thread
+ */
+CLogThreadBuffer* CAsyncLogBackend::GetThreadBuffer()
+{
+	static thread_local CLogThreadBuffer*		threadBuffer = nullptr;
+	if ( !threadBuffer )
+	{
+		threadBuffer = new CLogThreadBuffer( settings.threadBufferSize, appGetCurrentThreadId() );
+
+		CScopeLock		scopeLock( buffersCS );
+		threadBuffers.push_back( threadBuffer );
+	}
+
+	return threadBuffer;
+}
+
+/**
+ * Allocate memory for record
+ */
+byte* CAsyncLogBackend::AllocateRecord( uint32 InSize, CLogThreadBuffer*& OutThreadBuffer )
+{
+	// Record is too big for ring buffer or we are on log thread (he can't wait himself),
+	// so allocate temporary memory and process record immediately
+	if ( InSize >= settings.threadBufferSize / 2 || appGetCurrentThreadId() == logThreadId )
+	{
+		OutThreadBuffer = nullptr;
+		return new byte[ InSize ];
+	}
+
+	OutThreadBuffer		= GetThreadBuffer();
+	byte*	result		= OutThreadBuffer->BeginWrite( InSize );
+	if ( result )
+	{
+		return result;
+	}
+
+	// Buffer is full
+	if ( settings.overflowPolicy == LOP_Drop )
+	{
+		OutThreadBuffer->MarkDropped();
+		return nullptr;
+	}
+
+	// Wake up log thread and wait while he frees space
+	OutThreadBuffer->MarkBlocked();
+	wakeUpEvent->Trigger();
+	while ( !result )
+	{
+		appSleep( 0.f );
+		result = OutThreadBuffer->BeginWrite( InSize );
+	}
+
+	if ( !result )
+	{
+		OutThreadBuffer->MarkDropped();
+	}
+	return result;
+}
+
+/**
+ * Commit record
+ */
+void CAsyncLogBackend::CommitRecord( SLogRecordHeader* InRecord, CLogThreadBuffer* InThreadBuffer )
+{
+	// Record in temporary memory, process all pushed records before him for keep order
+	if ( !InThreadBuffer )
+	{
+		Flush();
+		{
+			CScopeLock		scopeLock( flushCS );
+			ProcessRecord( InRecord );
+		}
+		delete[] ( byte* )InRecord;
+		return;
+	}
+
+	InThreadBuffer->EndWrite();
+
+	// Errors must be visible immediately, application may crash after them
+	if ( InRecord->type == LT_Error )
+	{
+		Flush();
+	}
+}
+
+/**
+ * Format and write all pushed messages
+ */
+void CAsyncLogBackend::Flush()
+{
+	CScopeLock		scopeLock( flushCS );
+
+	// Collect records from all threads
+	std::vector< CLogThreadBuffer* >		buffers;
+	{
+		CScopeLock		scopeBuffersLock( buffersCS );
+		buffers = threadBuffers;
+	}
+
+	for ( uint32 index = 0, count = buffers.size(); index < count; ++index )
+	{
+		buffers[ index ]->CollectRecords( pendingRecords );
+	}
+
+	// Restore order of messages from different threads
+	std::stable_sort( pendingRecords.begin(), pendingRecords.end(), []( const SLogRecordHeader* InA, const SLogRecordHeader* InB )
+					  {
+						  return InA->time < InB->time;
+					  } );
+
+	for ( uint32 index = 0, count = pendingRecords.size(); index < count; ++index )
+	{
+		ProcessRecord( pendingRecords[ index ] );
+	}
+	pendingRecords.clear();
+
+	// Free memory in buffers and report about dropped messages
+	for ( uint32 index = 0, count = buffers.size(); index < count; ++index )
+	{
+		CLogThreadBuffer*		buffer = buffers[ index ];
+		buffer->FinishRead();
+
+		uint32		numDropped = buffer->TakeUnreportedDropped();
+		if ( numDropped > 0 )
+		{
+			GLog->Serialize( CString::Format( TEXT( "Async log: dropped %i messages from thread 0x%X, buffer is full" ), numDropped, buffer->GetThreadId() ).c_str(), LT_Warning, LC_General, appSeconds() - GStartTime );
+		}
+	}
+
+	if ( binaryArchive )
+	{
+		binaryArchive->Flush();
+	}
+	GLog->Flush();
+}
+
+/**
+ * Format and write one record
+ */
+void CAsyncLogBackend::ProcessRecord( const SLogRecordHeader* InRecord )
+{
+	// Messages of type 'Log' in binary mode we don't format, only write raw record
+	if ( binaryArchive )
+	{
+		WriteBinaryRecord( InRecord );
+		if ( InRecord->type == LT_Log )
+		{
+			return;
+		}
+	}
+
+	const tchar*		format = nullptr;
+	if ( InRecord->formatId != LOG_DYNAMIC_FORMAT_ID )
+	{
+		CScopeLock		scopeLock( formatsCS );
+		format = formats[ InRecord->formatId ];
+	}
+
+	std::wstring		message = appFormatLogRecord( InRecord, format );
+	if ( InRecord->color != LC_Default )
+	{
+		GLog->SetTextColor( ( ELogColor )InRecord->color );
+	}
+
+	GLog->Serialize( message.c_str(), ( ELogType )InRecord->type, ( ELogCategory )InRecord->category, InRecord->time );
+
+	if ( InRecord->color != LC_Default )
+	{
+		GLog->ResetTextColor();
+	}
+}
+
+/**
+ * Write record into binary log
+ */
+void CAsyncLogBackend::WriteBinaryRecord( const SLogRecordHeader* InRecord )
+{
+	check( binaryArchive );
+	uint32		startOffset = binaryArchive->Tell();
+
+	// Write format string before first record with him
+	if ( InRecord->formatId != LOG_DYNAMIC_FORMAT_ID && ( InRecord->formatId >= writtenFormats.size() || !writtenFormats[ InRecord->formatId ] ) )
+	{
+		std::wstring		format;
+		{
+			CScopeLock		scopeLock( formatsCS );
+			format = formats[ InRecord->formatId ];
+		}
+
+		if ( InRecord->formatId >= writtenFormats.size() )
+		{
+			writtenFormats.resize( InRecord->formatId + 1, false );
+		}
+		writtenFormats[ InRecord->formatId ] = true;
+
+		uint8		chunkType = LBC_Format;
+		uint32		formatId = InRecord->formatId;
+		*binaryArchive << chunkType;
+		*binaryArchive << formatId;
+		*binaryArchive << format;
+	}
+
+	uint8		chunkType = LBC_Record;
+	uint32		recordSize = InRecord->size;
+	*binaryArchive << chunkType;
+	*binaryArchive << recordSize;
+	binaryArchive->Serialize( ( void* )InRecord, recordSize );
+
+	numBinaryBytes += binaryArchive->Tell() - startOffset;
+}
+
+/**
+ * Get statistics
+ */
+SAsyncLogStats CAsyncLogBackend::GetStats() const
+{
+	SAsyncLogStats		stats;
+	CScopeLock			scopeLock( buffersCS );
+
+	stats.numThreadBuffers	= threadBuffers.size();
+	stats.numBinaryBytes	= numBinaryBytes;
+	for ( uint32 index = 0, count = threadBuffers.size(); index < count; ++index )
+	{
+		const CLogThreadBuffer*		buffer = threadBuffers[ index ];
+		stats.numRecords		+= buffer->GetNumRecords();
+		stats.numDropped		+= buffer->GetNumDropped();
+		stats.numBlocked		+= buffer->GetNumBlocked();
+	}
+
+	return stats;
+}
+
+/**
+ * Initialize log thread
+ */
+bool CAsyncLogBackend::Init()
+{
+	logThreadId = appGetCurrentThreadId();
+	return true;
+}
+
+/**
+ * Main loop of log thread
+ */
+uint32 CAsyncLogBackend::Run()
+{
+	while ( !bIsStopping )
+	{
+		wakeUpEvent->Wait( settings.flushInterval );
+		Flush();
+	}
+
+	// Flush the rest of messages
+	Flush();
+	return 0;
+}
+
+/**
+ * Request stop of log thread
+ */
+void CAsyncLogBackend::Stop()
+{
+	bIsStopping = true;
+	if ( wakeUpEvent )
+	{
+		wakeUpEvent->Trigger();
+	}
+}
+
+/**
+ * Exit from log thread
+ */
+void CAsyncLogBackend::Exit()
+{
+	logThreadId = 0;
+}
@@ -16,9 +16,40 @@ extern "C"
 
 #include <string>
 #include "Misc/CoreGlobals.h"
+#include "Misc/Misc.h"
 #include "Logger/LoggerMacros.h"
 #include "Containers/StringConv.h"
 
+const tchar* GLogTypeNames[] =
+{
+	TEXT( "Log" ),
+	TEXT( "Warning" ),
+	TEXT( "Error" )
+};
+
+const tchar* GLogCategoryNames[] =
+{
+	TEXT( "None" ),
+	TEXT( "General" ),
+	TEXT( "Init" ),
+	TEXT( "Script" ),
+	TEXT( "Dev" ),
+	TEXT( "Shader" ),
+	TEXT( "Input" ),
+	TEXT( "Package" ),
+	TEXT( "Audio" ),
+	TEXT( "Physics" ),
+	TEXT( "Movie" ),
+	TEXT( "Render" ),
+	TEXT( "RHI" ),
+	TEXT( "Console" ),
+
+#if WITH_EDITOR
+	TEXT( "Editor" ),
+	TEXT( "Commandlet" )
+#endif // WITH_EDITOR
+};
+
 void Print( std::string Instr )
 {
 	LE_LOG( LT_Log, LC_Script, TEXT( "%s" ), ANSI_TO_TCHAR( Instr.c_str() ) );
@@ -36,7 +67,7 @@ void CBaseLogger::Logf( ELogType InLogType, ELogCategory InLogCategory, const tc
 #if !NO_LOGGING
 	va_list			arguments;
 	va_start( arguments, InMessage );
-    Serialize( CString::Format( InMessage, arguments ).c_str(), InLogType, InLogCategory );  
+    Serialize( CString::Format( InMessage, arguments ).c_str(), InLogType, InLogCategory, appSeconds() - GStartTime );
 	va_end( arguments );
 #endif // !NO_LOGGING
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "Logger/LogRecord.h"
+#include "Containers/String.h"
+
+/**
+ * Reader of raw arguments from log record
+ */
+class CLogArgumentReader
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param InArguments		Pointer to first raw argument
+	 * @param InNumArguments	Number of raw arguments
+	 */
+	CLogArgumentReader( const byte* InArguments, uint32 InNumArguments )
+		: data( InArguments )
+		, numArguments( InNumArguments )
+	{}
+
+	/**
+	 * Is all arguments readed
+	 * @return Return TRUE if all arguments readed, otherwise return FALSE
+	 */
+	FORCEINLINE bool IsEmpty() const
+	{
+		return numArguments == 0;
+	}
+
+	/**
+	 * Get type of next argument
+	 * @return Return type of next argument
+	 */
+	FORCEINLINE ELogArgumentType PeekType() const
+	{
+		check( numArguments > 0 );
+		return ( ELogArgumentType )*data;
+	}
+
+	/**
+	 * Read scalar argument
+	 * @return Return value of scalar argument
+	 */
+	template< typename TType >
+	FORCEINLINE TType ReadScalar()
+	{
+		check( numArguments > 0 );
+		TType		value;
+		memcpy( &value, data + 1, sizeof( TType ) );
+		data += 1 + sizeof( TType );
+		--numArguments;
+		return value;
+	}
+
+	/**
+	 * Read integer argument of any size, it need for '*' in width and precision
+	 * @return Return value of argument
+	 */
+	FORCEINLINE int64 ReadInteger()
+	{
+		switch ( PeekType() )
+		{
+		case LAT_Int32:		return ReadScalar< int32 >();
+		case LAT_UInt32:	return ReadScalar< uint32 >();
+		case LAT_Int64:		return ReadScalar< int64 >();
+		case LAT_UInt64:	return ( int64 )ReadScalar< uint64 >();
+		case LAT_Double:	return ( int64 )ReadScalar< double >();
+		default:			Skip(); return 0;
+		}
+	}
+
+	/**
+	 * Read string argument
+	 *
+	 * @param OutIsNull		Is string is null
+	 * @return Return string
+	 */
+	template< typename TString >
+	FORCEINLINE TString ReadString( bool& OutIsNull )
+	{
+		check( numArguments > 0 );
+		uint32		length;
+		memcpy( &length, data + 1, sizeof( uint32 ) );
+		data += 1 + sizeof( uint32 );
+		--numArguments;
+
+		OutIsNull = length == LOG_NULL_STRING_LENGTH;
+		if ( OutIsNull || length == 0 )
+		{
+			return TString();
+		}
+
+		TString		result;
+		result.resize( length );
+		memcpy( ( void* )result.data(), data, length * sizeof( typename TString::value_type ) );
+		data += length * sizeof( typename TString::value_type );
+		return result;
+	}
+
+	/**
+	 * Skip next argument
+	 */
+	FORCEINLINE void Skip()
+	{
+		bool		bIsNull;
+		switch ( PeekType() )
+		{
+		case LAT_Int32:
+		case LAT_UInt32:
+			ReadScalar< uint32 >();
+			break;
+
+		case LAT_String:
+			ReadString< std::wstring >( bIsNull );
+			break;
+
+		case LAT_AnsiString:
+			ReadString< std::string >( bIsNull );
+			break;
+
+		default:
+			ReadScalar< uint64 >();
+			break;
+		}
+	}
+
+private:
+	const byte*		data;				/**< Pointer to next argument */
+	uint32			numArguments;		/**< Number of remaining arguments */
+};
+
+/**
+ * Format one conversion specification with next argument
+ *
+ * @param InSpec		Conversion specification (e.g. '%-8.2f')
+ * @param InReader		Reader of arguments
+ * @return Return formatted argument
+ */
+static std::wstring FormatLogArgument( const std::wstring& InSpec, CLogArgumentReader& InReader )
+{
+	bool		bIsNull = false;
+	switch ( InReader.PeekType() )
+	{
+	case LAT_Int32:			return CString::Format( InSpec.c_str(), InReader.ReadScalar< int32 >() );
+	case LAT_UInt32:		return CString::Format( InSpec.c_str(), InReader.ReadScalar< uint32 >() );
+	case LAT_Int64:			return CString::Format( InSpec.c_str(), InReader.ReadScalar< int64 >() );
+	case LAT_UInt64:		return CString::Format( InSpec.c_str(), InReader.ReadScalar< uint64 >() );
+	case LAT_Double:		return CString::Format( InSpec.c_str(), InReader.ReadScalar< double >() );
+	case LAT_Pointer:		return CString::Format( InSpec.c_str(), ( void* )InReader.ReadScalar< uint64 >() );
+
+	case LAT_String:
+	{
+		std::wstring	string = InReader.ReadString< std::wstring >( bIsNull );
+		return CString::Format( InSpec.c_str(), !bIsNull ? string.c_str() : nullptr );
+	}
+
+	case LAT_AnsiString:
+	{
+		std::string		string = InReader.ReadString< std::string >( bIsNull );
+		return CString::Format( InSpec.c_str(), !bIsNull ? string.c_str() : nullptr );
+	}
+
+	default:
+		checkMsg( false, TEXT( "Unknown type of log argument %i" ), InReader.PeekType() );
+		return TEXT( "" );
+	}
+}
+
+/**
+ * Format log message from format string and raw arguments of log record
+ */
+std::wstring appFormatLogRecord( const tchar* InFormat, const byte* InArguments, uint32 InNumArguments )
+{
+	CLogArgumentReader		reader( InArguments, InNumArguments );
+	std::wstring			result;
+	if ( !InFormat )
+	{
+		return result;
+	}
+
+	for ( const tchar* ch = InFormat; *ch; ++ch )
+	{
+		if ( *ch != TEXT( '%' ) )
+		{
+			result += *ch;
+			continue;
+		}
+
+		// Escaped percent
+		if ( ch[ 1 ] == TEXT( '%' ) )
+		{
+			result += TEXT( '%' );
+			++ch;
+			continue;
+		}
+
+		// Collect conversion specification: flags, width, precision and length modifiers
+		std::wstring		spec = TEXT( "%" );
+		const tchar*		specEnd = ch + 1;
+		while ( *specEnd && wcschr( TEXT( "-+ #0123456789.*hlLIjzt" ), *specEnd ) )
+		{
+			if ( *specEnd == TEXT( '*' ) )
+			{
+				spec += !reader.IsEmpty() ? std::to_wstring( reader.ReadInteger() ) : TEXT( "0" );
+			}
+			else
+			{
+				spec += *specEnd;
+			}
+			++specEnd;
+		}
+
+		// Broken specification at the end of format string, print it as is
+		if ( !*specEnd )
+		{
+			result += ch;
+			break;
+		}
+
+		spec += *specEnd;
+		ch = specEnd;
+
+		// Writing number of printed chars isn't supported
+		if ( *specEnd == TEXT( 'n' ) )
+		{
+			continue;
+		}
+
+		// If arguments is over, print specification as is
+		if ( reader.IsEmpty() )
+		{
+			result += spec;
+			continue;
+		}
+
+		result += FormatLogArgument( spec, reader );
+	}
+
+	return result;
+}
+
+/**
+ * Format log message from log record
+ */
+std::wstring appFormatLogRecord( const SLogRecordHeader* InRecord, const tchar* InFormat )
+{
+	check( InRecord );
+	const byte*		arguments = ( const byte* )( InRecord + 1 );
+	uint32			numArguments = InRecord->numArguments;
+
+	// If format string is dynamic, it is stored as first argument
+	if ( InRecord->formatId == LOG_DYNAMIC_FORMAT_ID )
+	{
+		check( !InFormat && numArguments > 0 );
+		CLogArgumentReader		reader( arguments, numArguments );
+		bool					bIsNull = false;
+		std::wstring			format = reader.ReadString< std::wstring >( bIsNull );
+
+		arguments += 1 + sizeof( uint32 ) + format.size() * sizeof( tchar );
+		return appFormatLogRecord( format.c_str(), arguments, numArguments - 1 );
+	}
+
+	return appFormatLogRecord( InFormat, arguments, numArguments );
+}
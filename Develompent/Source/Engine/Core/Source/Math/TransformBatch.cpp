@@ -0,0 +1,379 @@
+#include <cstddef>
+
+#include "Math/TransformBatch.h"
+
+#if WITH_SIMD_MATH
+#include <emmintrin.h>
+#endif // WITH_SIMD_MATH
+
+static_assert( sizeof( Vector ) == sizeof( float ) * 3, "Batched math expects tightly packed Vector" );
+static_assert( sizeof( Quaternion ) == sizeof( float ) * 4 && offsetof( Quaternion, x ) == 0 && offsetof( Quaternion, w ) == sizeof( float ) * 3, "Batched math expects Quaternion in XYZW order" );
+static_assert( sizeof( Matrix ) == sizeof( float ) * 16, "Batched math expects tightly packed Matrix" );
+
+/**
+ * Calculate scaled rotation part of matrix for one transform, OutColumns[ column ][ row ]
+ */
+static FORCEINLINE void CalcRotationScale( const Quaternion& InRotation, const Vector& InScale, float OutColumns[ 3 ][ 3 ] )
+{
+	const float		xx = InRotation.x * InRotation.x;
+	const float		yy = InRotation.y * InRotation.y;
+	const float		zz = InRotation.z * InRotation.z;
+	const float		xy = InRotation.x * InRotation.y;
+	const float		xz = InRotation.x * InRotation.z;
+	const float		yz = InRotation.y * InRotation.z;
+	const float		wx = InRotation.w * InRotation.x;
+	const float		wy = InRotation.w * InRotation.y;
+	const float		wz = InRotation.w * InRotation.z;
+
+	OutColumns[ 0 ][ 0 ] = ( 1.f - 2.f * ( yy + zz ) ) * InScale.x;
+	OutColumns[ 0 ][ 1 ] = ( 2.f * ( xy + wz ) ) * InScale.x;
+	OutColumns[ 0 ][ 2 ] = ( 2.f * ( xz - wy ) ) * InScale.x;
+
+	OutColumns[ 1 ][ 0 ] = ( 2.f * ( xy - wz ) ) * InScale.y;
+	OutColumns[ 1 ][ 1 ] = ( 1.f - 2.f * ( xx + zz ) ) * InScale.y;
+	OutColumns[ 1 ][ 2 ] = ( 2.f * ( yz + wx ) ) * InScale.y;
+
+	OutColumns[ 2 ][ 0 ] = ( 2.f * ( xz + wy ) ) * InScale.z;
+	OutColumns[ 2 ][ 1 ] = ( 2.f * ( yz - wx ) ) * InScale.z;
+	OutColumns[ 2 ][ 2 ] = ( 1.f - 2.f * ( xx + yy ) ) * InScale.z;
+}
+
+/**
+ * Convert transforms to matrices without SIMD
+ */
+void SMathBatch::TransformsToMatricesScalar( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount )
+{
+	for ( uint32 index = 0; index < InCount; ++index )
+	{
+		float		columns[ 3 ][ 3 ];
+		CalcRotationScale( InRotations[ index ], InScales[ index ], columns );
+
+		Matrix&		matrix = OutMatrices[ index ];
+		matrix[ 0 ] = Vector4D( columns[ 0 ][ 0 ], columns[ 0 ][ 1 ], columns[ 0 ][ 2 ], 0.f );
+		matrix[ 1 ] = Vector4D( columns[ 1 ][ 0 ], columns[ 1 ][ 1 ], columns[ 1 ][ 2 ], 0.f );
+		matrix[ 2 ] = Vector4D( columns[ 2 ][ 0 ], columns[ 2 ][ 1 ], columns[ 2 ][ 2 ], 0.f );
+		matrix[ 3 ] = Vector4D( InLocations[ index ], 1.f );
+	}
+}
+
+/**
+ * Convert transforms to affine matrices 3x4 without SIMD
+ */
+void SMathBatch::TransformsToMatrices3x4Scalar( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, SMatrix3x4* OutMatrices, uint32 InCount )
+{
+	for ( uint32 index = 0; index < InCount; ++index )
+	{
+		float			columns[ 3 ][ 3 ];
+		const Vector&	location = InLocations[ index ];
+		CalcRotationScale( InRotations[ index ], InScales[ index ], columns );
+
+		SMatrix3x4&		matrix = OutMatrices[ index ];
+		matrix.rows[ 0 ] = Vector4D( columns[ 0 ][ 0 ], columns[ 1 ][ 0 ], columns[ 2 ][ 0 ], location.x );
+		matrix.rows[ 1 ] = Vector4D( columns[ 0 ][ 1 ], columns[ 1 ][ 1 ], columns[ 2 ][ 1 ], location.y );
+		matrix.rows[ 2 ] = Vector4D( columns[ 0 ][ 2 ], columns[ 1 ][ 2 ], columns[ 2 ][ 2 ], location.z );
+	}
+}
+
+/**
+ * Convert transforms to inverse matrices without SIMD
+ */
+void SMathBatch::TransformsToInverseMatricesScalar( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount )
+{
+	// Inverse of T * R * S is S^-1 * R^T * T^-1
+	for ( uint32 index = 0; index < InCount; ++index )
+	{
+		float			rotation[ 3 ][ 3 ];
+		const Vector&	location = InLocations[ index ];
+		const Vector&	scale = InScales[ index ];
+		CalcRotationScale( InRotations[ index ], SMath::vectorOne, rotation );
+
+		const float		invScale[ 3 ] = { 1.f / scale.x, 1.f / scale.y, 1.f / scale.z };
+		Matrix&			matrix = OutMatrices[ index ];
+		for ( uint32 column = 0; column < 3; ++column )
+		{
+			matrix[ column ] = Vector4D( rotation[ 0 ][ column ] * invScale[ 0 ], rotation[ 1 ][ column ] * invScale[ 1 ], rotation[ 2 ][ column ] * invScale[ 2 ], 0.f );
+		}
+
+		matrix[ 3 ] = Vector4D( -( rotation[ 0 ][ 0 ] * location.x + rotation[ 0 ][ 1 ] * location.y + rotation[ 0 ][ 2 ] * location.z ) * invScale[ 0 ],
+								-( rotation[ 1 ][ 0 ] * location.x + rotation[ 1 ][ 1 ] * location.y + rotation[ 1 ][ 2 ] * location.z ) * invScale[ 1 ],
+								-( rotation[ 2 ][ 0 ] * location.x + rotation[ 2 ][ 1 ] * location.y + rotation[ 2 ][ 2 ] * location.z ) * invScale[ 2 ],
+								1.f );
+	}
+}
+
+/**
+ * Compose parent and relative transforms without SIMD
+ */
+void SMathBatch::ComposeTransformsScalar( const Vector* InParentLocations, const Quaternion* InParentRotations, const Vector* InParentScales,
+										  const Vector* InRelativeLocations, const Quaternion* InRelativeRotations, const Vector* InRelativeScales,
+										  Vector* OutLocations, Quaternion* OutRotations, Vector* OutScales, uint32 InCount )
+{
+	for ( uint32 index = 0; index < InCount; ++index )
+	{
+		OutLocations[ index ]	= InParentLocations[ index ] + InRelativeLocations[ index ];
+		OutRotations[ index ]	= InRelativeRotations[ index ] * InParentRotations[ index ];
+		OutScales[ index ]		= InParentScales[ index ] * InRelativeScales[ index ];
+	}
+}
+
+#if WITH_SIMD_MATH
+/**
+ * Four quaternions in structure of arrays
+ */
+struct SQuaternion4
+{
+	__m128		x;		/**< X components */
+	__m128		y;		/**< Y components */
+	__m128		z;		/**< Z components */
+	__m128		w;		/**< W components */
+};
+
+/**
+ * Four vectors in structure of arrays
+ */
+struct SVector4
+{
+	__m128		x;		/**< X components */
+	__m128		y;		/**< Y components */
+	__m128		z;		/**< Z components */
+};
+
+/**
+ * Load four quaternions and transpose them into structure of arrays
+ */
+static FORCEINLINE SQuaternion4 LoadQuaternion4( const Quaternion* InRotations )
+{
+	SQuaternion4	result;
+	result.x = _mm_loadu_ps( &InRotations[ 0 ].x );
+	result.y = _mm_loadu_ps( &InRotations[ 1 ].x );
+	result.z = _mm_loadu_ps( &InRotations[ 2 ].x );
+	result.w = _mm_loadu_ps( &InRotations[ 3 ].x );
+	_MM_TRANSPOSE4_PS( result.x, result.y, result.z, result.w );
+	return result;
+}
+
+/**
+ * Transpose four quaternions back and store them
+ */
+static FORCEINLINE void StoreQuaternion4( SQuaternion4 InRotations, Quaternion* OutRotations )
+{
+	_MM_TRANSPOSE4_PS( InRotations.x, InRotations.y, InRotations.z, InRotations.w );
+	_mm_storeu_ps( &OutRotations[ 0 ].x, InRotations.x );
+	_mm_storeu_ps( &OutRotations[ 1 ].x, InRotations.y );
+	_mm_storeu_ps( &OutRotations[ 2 ].x, InRotations.z );
+	_mm_storeu_ps( &OutRotations[ 3 ].x, InRotations.w );
+}
+
+/**
+ * Load four vectors into structure of arrays
+ */
+static FORCEINLINE SVector4 LoadVector4( const Vector* InVectors )
+{
+	SVector4	result;
+	result.x = _mm_set_ps( InVectors[ 3 ].x, InVectors[ 2 ].x, InVectors[ 1 ].x, InVectors[ 0 ].x );
+	result.y = _mm_set_ps( InVectors[ 3 ].y, InVectors[ 2 ].y, InVectors[ 1 ].y, InVectors[ 0 ].y );
+	result.z = _mm_set_ps( InVectors[ 3 ].z, InVectors[ 2 ].z, InVectors[ 1 ].z, InVectors[ 0 ].z );
+	return result;
+}
+
+/**
+ * Store four vectors from structure of arrays
+ */
+static FORCEINLINE void StoreVector4( const SVector4& InVectors, Vector* OutVectors )
+{
+	float		x[ 4 ];
+	float		y[ 4 ];
+	float		z[ 4 ];
+	_mm_storeu_ps( x, InVectors.x );
+	_mm_storeu_ps( y, InVectors.y );
+	_mm_storeu_ps( z, InVectors.z );
+	for ( uint32 index = 0; index < 4; ++index )
+	{
+		OutVectors[ index ] = Vector( x[ index ], y[ index ], z[ index ] );
+	}
+}
+
+/**
+ * Calculate scaled rotation part of matrix for four transforms, OutColumns[ column ][ row ]
+ */
+static FORCEINLINE void CalcRotationScale4( const SQuaternion4& InRotations, const SVector4& InScales, __m128 OutColumns[ 3 ][ 3 ] )
+{
+	const __m128	one = _mm_set1_ps( 1.f );
+	const __m128	two = _mm_set1_ps( 2.f );
+	const __m128	xx = _mm_mul_ps( InRotations.x, InRotations.x );
+	const __m128	yy = _mm_mul_ps( InRotations.y, InRotations.y );
+	const __m128	zz = _mm_mul_ps( InRotations.z, InRotations.z );
+	const __m128	xy = _mm_mul_ps( InRotations.x, InRotations.y );
+	const __m128	xz = _mm_mul_ps( InRotations.x, InRotations.z );
+	const __m128	yz = _mm_mul_ps( InRotations.y, InRotations.z );
+	const __m128	wx = _mm_mul_ps( InRotations.w, InRotations.x );
+	const __m128	wy = _mm_mul_ps( InRotations.w, InRotations.y );
+	const __m128	wz = _mm_mul_ps( InRotations.w, InRotations.z );
+
+	OutColumns[ 0 ][ 0 ] = _mm_mul_ps( _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( yy, zz ) ) ), InScales.x );
+	OutColumns[ 0 ][ 1 ] = _mm_mul_ps( _mm_mul_ps( two, _mm_add_ps( xy, wz ) ), InScales.x );
+	OutColumns[ 0 ][ 2 ] = _mm_mul_ps( _mm_mul_ps( two, _mm_sub_ps( xz, wy ) ), InScales.x );
+
+	OutColumns[ 1 ][ 0 ] = _mm_mul_ps( _mm_mul_ps( two, _mm_sub_ps( xy, wz ) ), InScales.y );
+	OutColumns[ 1 ][ 1 ] = _mm_mul_ps( _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, zz ) ) ), InScales.y );
+	OutColumns[ 1 ][ 2 ] = _mm_mul_ps( _mm_mul_ps( two, _mm_add_ps( yz, wx ) ), InScales.y );
+
+	OutColumns[ 2 ][ 0 ] = _mm_mul_ps( _mm_mul_ps( two, _mm_add_ps( xz, wy ) ), InScales.z );
+	OutColumns[ 2 ][ 1 ] = _mm_mul_ps( _mm_mul_ps( two, _mm_sub_ps( yz, wx ) ), InScales.z );
+	OutColumns[ 2 ][ 2 ] = _mm_mul_ps( _mm_sub_ps( one, _mm_mul_ps( two, _mm_add_ps( xx, yy ) ) ), InScales.z );
+}
+
+/**
+ * Transpose four registers from structure of arrays and store them with stride
+ */
+static FORCEINLINE void TransposeAndStore4( __m128 InA, __m128 InB, __m128 InC, __m128 InD, float* OutFirst, uint32 InStride )
+{
+	_MM_TRANSPOSE4_PS( InA, InB, InC, InD );
+	_mm_storeu_ps( OutFirst, InA );
+	_mm_storeu_ps( OutFirst + InStride, InB );
+	_mm_storeu_ps( OutFirst + InStride * 2, InC );
+	_mm_storeu_ps( OutFirst + InStride * 3, InD );
+}
+#endif // WITH_SIMD_MATH
+
+/**
+ * Convert transforms to matrices
+ */
+void SMathBatch::TransformsToMatrices( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount )
+{
+	uint32		index = 0;
+
+#if WITH_SIMD_MATH
+	const __m128	zero = _mm_setzero_ps();
+	const __m128	one = _mm_set1_ps( 1.f );
+	for ( ; index + 4 <= InCount; index += 4 )
+	{
+		__m128		columns[ 3 ][ 3 ];
+		SVector4	locations = LoadVector4( InLocations + index );
+		CalcRotationScale4( LoadQuaternion4( InRotations + index ), LoadVector4( InScales + index ), columns );
+
+		// Each transposed column belongs to one matrix, so stride between matrices is 16 floats
+		float*		firstMatrix = &OutMatrices[ index ][ 0 ][ 0 ];
+		TransposeAndStore4( columns[ 0 ][ 0 ], columns[ 0 ][ 1 ], columns[ 0 ][ 2 ], zero, firstMatrix, 16 );
+		TransposeAndStore4( columns[ 1 ][ 0 ], columns[ 1 ][ 1 ], columns[ 1 ][ 2 ], zero, firstMatrix + 4, 16 );
+		TransposeAndStore4( columns[ 2 ][ 0 ], columns[ 2 ][ 1 ], columns[ 2 ][ 2 ], zero, firstMatrix + 8, 16 );
+		TransposeAndStore4( locations.x, locations.y, locations.z, one, firstMatrix + 12, 16 );
+	}
+#endif // WITH_SIMD_MATH
+
+	TransformsToMatricesScalar( InLocations + index, InRotations + index, InScales + index, OutMatrices + index, InCount - index );
+}
+
+/**
+ * Convert transforms to affine matrices 3x4
+ */
+void SMathBatch::TransformsToMatrices3x4( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, SMatrix3x4* OutMatrices, uint32 InCount )
+{
+	uint32		index = 0;
+
+#if WITH_SIMD_MATH
+	for ( ; index + 4 <= InCount; index += 4 )
+	{
+		__m128		columns[ 3 ][ 3 ];
+		SVector4	locations = LoadVector4( InLocations + index );
+		CalcRotationScale4( LoadQuaternion4( InRotations + index ), LoadVector4( InScales + index ), columns );
+
+		// Each transposed row belongs to one matrix, so stride between matrices is 12 floats
+		float*		firstMatrix = &OutMatrices[ index ].rows[ 0 ].x;
+		TransposeAndStore4( columns[ 0 ][ 0 ], columns[ 1 ][ 0 ], columns[ 2 ][ 0 ], locations.x, firstMatrix, 12 );
+		TransposeAndStore4( columns[ 0 ][ 1 ], columns[ 1 ][ 1 ], columns[ 2 ][ 1 ], locations.y, firstMatrix + 4, 12 );
+		TransposeAndStore4( columns[ 0 ][ 2 ], columns[ 1 ][ 2 ], columns[ 2 ][ 2 ], locations.z, firstMatrix + 8, 12 );
+	}
+#endif // WITH_SIMD_MATH
+
+	TransformsToMatrices3x4Scalar( InLocations + index, InRotations + index, InScales + index, OutMatrices + index, InCount - index );
+}
+
+/**
+ * Convert transforms to inverse matrices
+ */
+void SMathBatch::TransformsToInverseMatrices( const Vector* InLocations, const Quaternion* InRotations, const Vector* InScales, Matrix* OutMatrices, uint32 InCount )
+{
+	uint32		index = 0;
+
+#if WITH_SIMD_MATH
+	const __m128	zero = _mm_setzero_ps();
+	const __m128	one = _mm_set1_ps( 1.f );
+	SVector4		unitScales;
+	unitScales.x = one;
+	unitScales.y = one;
+	unitScales.z = one;
+	for ( ; index + 4 <= InCount; index += 4 )
+	{
+		__m128		rotation[ 3 ][ 3 ];
+		SVector4	locations = LoadVector4( InLocations + index );
+		SVector4	scales = LoadVector4( InScales + index );
+		CalcRotationScale4( LoadQuaternion4( InRotations + index ), unitScales, rotation );
+
+		// Inverse of T * R * S is S^-1 * R^T * T^-1
+		const __m128	invScale[ 3 ] = { _mm_div_ps( one, scales.x ), _mm_div_ps( one, scales.y ), _mm_div_ps( one, scales.z ) };
+		__m128			translation[ 3 ];
+		for ( uint32 axis = 0; axis < 3; ++axis )
+		{
+			__m128		dot = _mm_add_ps( _mm_add_ps( _mm_mul_ps( rotation[ axis ][ 0 ], locations.x ), _mm_mul_ps( rotation[ axis ][ 1 ], locations.y ) ), _mm_mul_ps( rotation[ axis ][ 2 ], locations.z ) );
+			translation[ axis ] = _mm_sub_ps( zero, _mm_mul_ps( dot, invScale[ axis ] ) );
+		}
+
+		float*		firstMatrix = &OutMatrices[ index ][ 0 ][ 0 ];
+		for ( uint32 column = 0; column < 3; ++column )
+		{
+			TransposeAndStore4( _mm_mul_ps( rotation[ 0 ][ column ], invScale[ 0 ] ), _mm_mul_ps( rotation[ 1 ][ column ], invScale[ 1 ] ), _mm_mul_ps( rotation[ 2 ][ column ], invScale[ 2 ] ), zero, firstMatrix + column * 4, 16 );
+		}
+		TransposeAndStore4( translation[ 0 ], translation[ 1 ], translation[ 2 ], one, firstMatrix + 12, 16 );
+	}
+#endif // WITH_SIMD_MATH
+
+	TransformsToInverseMatricesScalar( InLocations + index, InRotations + index, InScales + index, OutMatrices + index, InCount - index );
+}
+
+/**
+ * Compose parent and relative transforms
+ */
+void SMathBatch::ComposeTransforms( const Vector* InParentLocations, const Quaternion* InParentRotations, const Vector* InParentScales,
+									const Vector* InRelativeLocations, const Quaternion* InRelativeRotations, const Vector* InRelativeScales,
+									Vector* OutLocations, Quaternion* OutRotations, Vector* OutScales, uint32 InCount )
+{
+	uint32		index = 0;
+
+#if WITH_SIMD_MATH
+	for ( ; index + 4 <= InCount; index += 4 )
+	{
+		SVector4		parentLocations = LoadVector4( InParentLocations + index );
+		SVector4		relativeLocations = LoadVector4( InRelativeLocations + index );
+		SVector4		parentScales = LoadVector4( InParentScales + index );
+		SVector4		relativeScales = LoadVector4( InRelativeScales + index );
+		SQuaternion4	a = LoadQuaternion4( InRelativeRotations + index );
+		SQuaternion4	b = LoadQuaternion4( InParentRotations + index );
+
+		SVector4		locations;
+		locations.x = _mm_add_ps( parentLocations.x, relativeLocations.x );
+		locations.y = _mm_add_ps( parentLocations.y, relativeLocations.y );
+		locations.z = _mm_add_ps( parentLocations.z, relativeLocations.z );
+
+		SVector4		scales;
+		scales.x = _mm_mul_ps( parentScales.x, relativeScales.x );
+		scales.y = _mm_mul_ps( parentScales.y, relativeScales.y );
+		scales.z = _mm_mul_ps( parentScales.z, relativeScales.z );
+
+		// Hamilton product of relative and parent rotations
+		SQuaternion4	rotations;
+		rotations.w = _mm_sub_ps( _mm_sub_ps( _mm_sub_ps( _mm_mul_ps( a.w, b.w ), _mm_mul_ps( a.x, b.x ) ), _mm_mul_ps( a.y, b.y ) ), _mm_mul_ps( a.z, b.z ) );
+		rotations.x = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( a.w, b.x ), _mm_mul_ps( a.x, b.w ) ), _mm_mul_ps( a.y, b.z ) ), _mm_mul_ps( a.z, b.y ) );
+		rotations.y = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( a.w, b.y ), _mm_mul_ps( a.y, b.w ) ), _mm_mul_ps( a.z, b.x ) ), _mm_mul_ps( a.x, b.z ) );
+		rotations.z = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( a.w, b.z ), _mm_mul_ps( a.z, b.w ) ), _mm_mul_ps( a.x, b.y ) ), _mm_mul_ps( a.y, b.x ) );
+
+		StoreVector4( locations, OutLocations + index );
+		StoreVector4( scales, OutScales + index );
+		StoreQuaternion4( rotations, OutRotations + index );
+	}
+#endif // WITH_SIMD_MATH
+
+	ComposeTransformsScalar( InParentLocations + index, InParentRotations + index, InParentScales + index,
+							 InRelativeLocations + index, InRelativeRotations + index, InRelativeScales + index,
+							 OutLocations + index, OutRotations + index, OutScales + index, InCount - index );
+}
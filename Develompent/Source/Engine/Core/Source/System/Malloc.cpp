@@ -0,0 +1,217 @@
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Misc/Template.h"
+#include "Core.h"
+#include "System/Malloc.h"
+#include "System/MallocTracking.h"
+
+// ----
+// Globals
+// ----
+
+CMalloc*			GMalloc = nullptr;
+const tchar*		GMemoryTagNames[ MTAG_Num ] =
+{
+	TEXT( "Default" ),
+	TEXT( "Render" ),
+	TEXT( "Physics" ),
+	TEXT( "Audio" ),
+	TEXT( "Assets" ),
+	TEXT( "Scripts" ),
+	TEXT( "UI" ),
+	TEXT( "World" )
+};
+
+/**
+ * Create global allocator
+ */
+void appCreateMalloc()
+{
+	if ( GMalloc )
+	{
+		return;
+	}
+
+	// Allocators are created in static storage, because heap isn't available yet and they must live until process end
+	alignas( CMallocAnsi ) static byte			mallocAnsiStorage[ sizeof( CMallocAnsi ) ];
+	CMalloc*									mallocAnsi = new( mallocAnsiStorage ) CMallocAnsi();
+
+#if WITH_MEMORY_TRACKING
+	alignas( CMallocTracking ) static byte		mallocTrackingStorage[ sizeof( CMallocTracking ) ];
+	GMallocTracking = new( mallocTrackingStorage ) CMallocTracking( mallocAnsi );
+	GMalloc = GMallocTracking;
+#else
+	GMalloc = mallocAnsi;
+#endif // WITH_MEMORY_TRACKING
+}
+
+// ----
+// CMallocAnsi
+// ----
+
+/**
+ * Allocate memory
+ */
+void* CMallocAnsi::Malloc( uint64 InSize, uint32 InAlignment /* = DEFAULT_ALIGNMENT */ )
+{
+#if PLATFORM_WINDOWS
+	return _aligned_malloc( InSize, InAlignment );
+#else
+	// Store pointer to original memory before aligned memory
+	void*		original = malloc( InSize + InAlignment + sizeof( void* ) );
+	if ( !original )
+	{
+		return nullptr;
+	}
+
+	void*		result = ( void* )( ( ( uintptr_t )original + sizeof( void* ) + InAlignment - 1 ) & ~( uintptr_t )( InAlignment - 1 ) );
+	*( ( void** )result - 1 ) = original;
+	return result;
+#endif // PLATFORM_WINDOWS
+}
+
+/**
+ * Reallocate memory
+ */
+void* CMallocAnsi::Realloc( void* InOriginal, uint64 InSize, uint32 InAlignment /* = DEFAULT_ALIGNMENT */ )
+{
+#if PLATFORM_WINDOWS
+	if ( !InSize )
+	{
+		_aligned_free( InOriginal );
+		return nullptr;
+	}
+	return _aligned_realloc( InOriginal, InSize, InAlignment );
+#else
+	// Size of original allocation is unknown, so we can't do realloc without tracking
+	checkMsg( false, TEXT( "CMallocAnsi::Realloc isn't supported on this platform" ) );
+	return nullptr;
+#endif // PLATFORM_WINDOWS
+}
+
+/**
+ * Free memory
+ */
+void CMallocAnsi::Free( void* InOriginal )
+{
+#if PLATFORM_WINDOWS
+	_aligned_free( InOriginal );
+#else
+	if ( InOriginal )
+	{
+		free( *( ( void** )InOriginal - 1 ) );
+	}
+#endif // PLATFORM_WINDOWS
+}
+
+/**
+ * Get descriptive name of allocator
+ */
+const tchar* CMallocAnsi::GetDescriptiveName() const
+{
+	return TEXT( "Ansi" );
+}
+
+// ----
+// Overloaded operators new and delete, all allocations of C++ go through GMalloc
+// ----
+
+/**
+ * Allocate memory for operator new. Exceptions are disabled in engine, so on out of memory we exit
+ *
+ * @param InSize		Size of memory in bytes
+ * @param InAlignment	Alignment of memory
+ * @return Return pointer to allocated memory
+ */
+static FORCEINLINE void* OperatorNew( size_t InSize, uint32 InAlignment = DEFAULT_ALIGNMENT )
+{
+	void*	result = appMalloc( InSize ? InSize : 1, Max<uint32>( InAlignment, DEFAULT_ALIGNMENT ) );
+	if ( !result )
+	{
+		appErrorf( TEXT( "Out of memory, failed to allocate %llu bytes" ), ( uint64 )InSize );
+		appRequestExit( true );
+	}
+	return result;
+}
+
+void* operator new( size_t InSize )
+{
+	return OperatorNew( InSize );
+}
+
+void* operator new[]( size_t InSize )
+{
+	return OperatorNew( InSize );
+}
+
+void* operator new( size_t InSize, const std::nothrow_t& ) noexcept
+{
+	return appMalloc( InSize ? InSize : 1 );
+}
+
+void* operator new[]( size_t InSize, const std::nothrow_t& ) noexcept
+{
+	return appMalloc( InSize ? InSize : 1 );
+}
+
+void* operator new( size_t InSize, std::align_val_t InAlignment )
+{
+	return OperatorNew( InSize, ( uint32 )InAlignment );
+}
+
+void* operator new[]( size_t InSize, std::align_val_t InAlignment )
+{
+	return OperatorNew( InSize, ( uint32 )InAlignment );
+}
+
+void operator delete( void* InPtr ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, size_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, size_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, const std::nothrow_t& ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, const std::nothrow_t& ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete( void* InPtr, size_t, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
+
+void operator delete[]( void* InPtr, size_t, std::align_val_t ) noexcept
+{
+	appFree( InPtr );
+}
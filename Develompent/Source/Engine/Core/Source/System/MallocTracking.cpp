@@ -0,0 +1,390 @@
+#include <algorithm>
+#include <vector>
+
+#include "Misc/Template.h"
+#include "Misc/Misc.h"
+#include "Logger/LoggerMacros.h"
+#include "System/MallocTracking.h"
+#include "System/Config.h"
+
+/**
+ * Magic number of allocation header
+ */
+#define MALLOC_TRACKING_MAGIC		0x4D54524B
+
+/**
+ * Global tracking allocator
+ */
+CMallocTracking*		GMallocTracking = nullptr;
+
+/**
+ * Load settings from engine config
+ */
+void SMallocTrackingSettings::LoadFromConfig()
+{
+	CConfigValue		configTrackAllocations = GConfig.GetValue( CT_Engine, TEXT( "Engine.Memory" ), TEXT( "TrackAllocations" ) );
+	if ( configTrackAllocations.IsA( CConfigValue::T_Bool ) )
+	{
+		bTrackAllocations = configTrackAllocations.GetBool();
+	}
+
+	CConfigValue		configCaptureCallStacks = GConfig.GetValue( CT_Engine, TEXT( "Engine.Memory" ), TEXT( "CaptureCallStacks" ) );
+	if ( configCaptureCallStacks.IsA( CConfigValue::T_Bool ) )
+	{
+		bCaptureCallStacks = configCaptureCallStacks.GetBool();
+	}
+
+	CConfigValue		configCallStackDepth = GConfig.GetValue( CT_Engine, TEXT( "Engine.Memory" ), TEXT( "CallStackDepth" ) );
+	if ( configCallStackDepth.IsA( CConfigValue::T_Int ) )
+	{
+		callStackDepth = Clamp<int32>( configCallStackDepth.GetInt(), 1, MALLOC_MAX_CALLSTACK_DEPTH );
+	}
+
+	CConfigValue		configReportLeaksOnExit = GConfig.GetValue( CT_Engine, TEXT( "Engine.Memory" ), TEXT( "ReportLeaksOnExit" ) );
+	if ( configReportLeaksOnExit.IsA( CConfigValue::T_Bool ) )
+	{
+		bReportLeaksOnExit = configReportLeaksOnExit.GetBool();
+	}
+}
+
+/**
+ * Constructor
+ */
+CMallocTracking::CMallocTracking( CMalloc* InInnerMalloc )
+	: innerMalloc( InInnerMalloc )
+	, snapshotTime( 0.0 )
+	, allocationsHead( nullptr )
+{
+	check( innerMalloc );
+}
+
+/**
+ * Allocate memory
+ */
+void* CMallocTracking::Malloc( uint64 InSize, uint32 InAlignment /* = DEFAULT_ALIGNMENT */ )
+{
+	// Header must be placed right before user memory and don't break alignment of it
+	uint32		alignment = Max<uint32>( InAlignment, DEFAULT_ALIGNMENT );
+	uint32		headerSize = ( sizeof( SAllocationHeader ) + alignment - 1 ) & ~( alignment - 1 );
+	byte*		original = ( byte* )innerMalloc->Malloc( InSize + headerSize, alignment );
+	if ( !original )
+	{
+		return nullptr;
+	}
+
+	byte*					result = original + headerSize;
+	SAllocationHeader*		header = GetHeader( result );
+	header->prev			= nullptr;
+	header->next			= nullptr;
+	header->backTrace		= nullptr;
+	header->size			= InSize;
+	header->offset			= headerSize;
+	header->magic			= MALLOC_TRACKING_MAGIC;
+	header->tag				= ( uint16 )appGetCurrentMemoryTag();
+	header->numFrames		= 0;
+	header->bLinked			= 0;
+
+	if ( settings.bTrackAllocations )
+	{
+		// Skip frames of allocator itself
+		if ( settings.bCaptureCallStacks )
+		{
+			uint64		backTrace[ MALLOC_MAX_CALLSTACK_DEPTH ];
+			uint32		numFrames = appCaptureStackBackTrace( backTrace, settings.callStackDepth, 2 );
+			if ( numFrames > 0 )
+			{
+				header->backTrace = ( uint64* )innerMalloc->Malloc( numFrames * sizeof( uint64 ), alignof( uint64 ) );
+				if ( header->backTrace )
+				{
+					memcpy( header->backTrace, backTrace, numFrames * sizeof( uint64 ) );
+					header->numFrames = ( uint8 )numFrames;
+				}
+			}
+		}
+
+		CScopeLock		scopeLock( &allocationsCS );
+		header->next = allocationsHead;
+		if ( allocationsHead )
+		{
+			allocationsHead->prev = header;
+		}
+		allocationsHead		= header;
+		header->bLinked		= 1;
+	}
+
+	UpdateTagStats( header->tag, ( int64 )InSize, 1 );
+	return result;
+}
+
+/**
+ * Reallocate memory
+ */
+void* CMallocTracking::Realloc( void* InOriginal, uint64 InSize, uint32 InAlignment /* = DEFAULT_ALIGNMENT */ )
+{
+	if ( !InOriginal )
+	{
+		return Malloc( InSize, InAlignment );
+	}
+
+	if ( !InSize )
+	{
+		Free( InOriginal );
+		return nullptr;
+	}
+
+	// We always make new allocation, because header must be moved into new list position and tag
+	void*		result = Malloc( InSize, InAlignment );
+	if ( result )
+	{
+		memcpy( result, InOriginal, Min( GetHeader( InOriginal )->size, InSize ) );
+		Free( InOriginal );
+	}
+	return result;
+}
+
+/**
+ * Free memory
+ */
+void CMallocTracking::Free( void* InOriginal )
+{
+	if ( !InOriginal )
+	{
+		return;
+	}
+
+	SAllocationHeader*		header = GetHeader( InOriginal );
+	checkMsg( header->magic == MALLOC_TRACKING_MAGIC, TEXT( "Memory 0x%p wasn't allocated by tracking allocator or header is corrupted" ), InOriginal );
+
+	if ( header->bLinked )
+	{
+		CScopeLock		scopeLock( &allocationsCS );
+		if ( header->prev )
+		{
+			header->prev->next = header->next;
+		}
+		else
+		{
+			allocationsHead = header->next;
+		}
+
+		if ( header->next )
+		{
+			header->next->prev = header->prev;
+		}
+	}
+
+	if ( header->backTrace )
+	{
+		innerMalloc->Free( header->backTrace );
+	}
+
+	UpdateTagStats( header->tag, -( int64 )header->size, -1 );
+	header->magic = 0;
+	innerMalloc->Free( ( byte* )InOriginal - header->offset );
+}
+
+/**
+ * Get size of allocation
+ */
+bool CMallocTracking::GetAllocationSize( void* InOriginal, uint64& OutSize )
+{
+	SAllocationHeader*		header = GetHeader( InOriginal );
+	check( header->magic == MALLOC_TRACKING_MAGIC );
+	OutSize = header->size;
+	return true;
+}
+
+/**
+ * Get descriptive name of allocator
+ */
+const tchar* CMallocTracking::GetDescriptiveName() const
+{
+	return TEXT( "Tracking" );
+}
+
+/**
+ * Apply settings
+ */
+void CMallocTracking::ApplySettings( const SMallocTrackingSettings& InSettings )
+{
+	settings = InSettings;
+	settings.callStackDepth = Clamp<uint32>( settings.callStackDepth, 1, MALLOC_MAX_CALLSTACK_DEPTH );
+}
+
+/**
+ * Update counters of memory tag
+ */
+void CMallocTracking::UpdateTagStats( uint32 InMemoryTag, int64 InDeltaBytes, int64 InDeltaCount )
+{
+	SMemoryTagStats&	stats = tagStats[ InMemoryTag < MTAG_Num ? InMemoryTag : MTAG_Default ];
+	int64				liveBytes = appInterlockedAdd64( &stats.liveBytes, InDeltaBytes ) + InDeltaBytes;
+	appInterlockedAdd64( &stats.numLiveAllocations, InDeltaCount );
+	if ( InDeltaCount <= 0 )
+	{
+		return;
+	}
+
+	appInterlockedAdd64( &stats.numTotalAllocations, InDeltaCount );
+	for ( int64 peakBytes = stats.peakBytes; liveBytes > peakBytes; peakBytes = stats.peakBytes )
+	{
+		if ( appInterlockedCompareExchange64( &stats.peakBytes, liveBytes, peakBytes ) == peakBytes )
+		{
+			break;
+		}
+	}
+}
+
+/**
+ * Save current statistics of memory tags
+ */
+void CMallocTracking::TakeSnapshot()
+{
+	for ( uint32 index = 0; index < MTAG_Num; ++index )
+	{
+		snapshotStats[ index ].liveBytes				= tagStats[ index ].liveBytes;
+		snapshotStats[ index ].peakBytes				= tagStats[ index ].peakBytes;
+		snapshotStats[ index ].numLiveAllocations		= tagStats[ index ].numLiveAllocations;
+		snapshotStats[ index ].numTotalAllocations		= tagStats[ index ].numTotalAllocations;
+	}
+	snapshotTime = appSeconds();
+}
+
+/**
+ * Print statistics of memory tags into log
+ */
+void CMallocTracking::DumpStats( bool InIsCompareWithSnapshot /* = true */ ) const
+{
+	const double	bytesToMB = 1.0 / ( 1024.0 * 1024.0 );
+	bool			bHasSnapshot = InIsCompareWithSnapshot && snapshotTime > 0.0;
+
+	LE_LOG( LT_Log, LC_General, TEXT( "Memory stats (%s allocator):" ), innerMalloc->GetDescriptiveName() );
+	if ( bHasSnapshot )
+	{
+		LE_LOG( LT_Log, LC_General, TEXT( "Difference with snapshot taken %.2f seconds ago" ), appSeconds() - snapshotTime );
+	}
+	LE_LOG( LT_Log, LC_General, TEXT( "%-10s %12s %12s %12s %14s %12s" ), TEXT( "Tag" ), TEXT( "Live MB" ), TEXT( "Live count" ), TEXT( "Peak MB" ), TEXT( "Total count" ), TEXT( "Delta MB" ) );
+
+	int64		totalLiveBytes = 0;
+	int64		totalLiveAllocations = 0;
+	for ( uint32 index = 0; index < MTAG_Num; ++index )
+	{
+		const SMemoryTagStats&		stats = tagStats[ index ];
+		double						deltaMB = bHasSnapshot ? ( stats.liveBytes - snapshotStats[ index ].liveBytes ) * bytesToMB : 0.0;
+		LE_LOG( LT_Log, LC_General, TEXT( "%-10s %12.2f %12lld %12.2f %14lld %+12.2f" ),
+				GMemoryTagNames[ index ], stats.liveBytes * bytesToMB, stats.numLiveAllocations, stats.peakBytes * bytesToMB, stats.numTotalAllocations, deltaMB );
+
+		totalLiveBytes			+= stats.liveBytes;
+		totalLiveAllocations	+= stats.numLiveAllocations;
+	}
+	LE_LOG( LT_Log, LC_General, TEXT( "%-10s %12.2f %12lld" ), TEXT( "Total" ), totalLiveBytes * bytesToMB, totalLiveAllocations );
+}
+
+/**
+ * Print live allocations grouped by call stack into log
+ */
+void CMallocTracking::DumpLiveAllocations( uint32 InMaxEntries /* = 32 */ )
+{
+	/**
+	 * Copy of live allocation, we can't use headers after unlock
+	 */
+	struct SLiveAllocation
+	{
+		uint64		backTrace[ MALLOC_MAX_CALLSTACK_DEPTH ];	/**< Call stack */
+		uint64		size;										/**< Size of allocation */
+		uint16		tag;										/**< Memory tag */
+		uint8		numFrames;									/**< Number of frames in call stack */
+	};
+
+	if ( !settings.bTrackAllocations )
+	{
+		LE_LOG( LT_Warning, LC_General, TEXT( "List of live allocations is disabled, set 'TrackAllocations' in section 'Engine.Memory' of config" ) );
+		return;
+	}
+
+	// Copy live allocations into memory of inner allocator, that logging after unlock doesn't change list
+	SLiveAllocation*	liveAllocations = nullptr;
+	uint32				numLiveAllocations = 0;
+	{
+		CScopeLock		scopeLock( &allocationsCS );
+		for ( SAllocationHeader* header = allocationsHead; header; header = header->next )
+		{
+			++numLiveAllocations;
+		}
+
+		liveAllocations = numLiveAllocations > 0 ? ( SLiveAllocation* )innerMalloc->Malloc( numLiveAllocations * sizeof( SLiveAllocation ) ) : nullptr;
+		if ( !liveAllocations )
+		{
+			numLiveAllocations = 0;
+		}
+
+		uint32		index = 0;
+		for ( SAllocationHeader* header = allocationsHead; header && index < numLiveAllocations; header = header->next, ++index )
+		{
+			SLiveAllocation&	liveAllocation = liveAllocations[ index ];
+			memset( liveAllocation.backTrace, 0, sizeof( liveAllocation.backTrace ) );
+			memcpy( liveAllocation.backTrace, header->backTrace, header->numFrames * sizeof( uint64 ) );
+			liveAllocation.size			= header->size;
+			liveAllocation.tag			= header->tag;
+			liveAllocation.numFrames	= header->numFrames;
+		}
+	}
+
+	// Group allocations with the same call stack and tag
+	std::sort( liveAllocations, liveAllocations + numLiveAllocations, []( const SLiveAllocation& InA, const SLiveAllocation& InB )
+			   {
+				   if ( InA.tag != InB.tag )
+				   {
+					   return InA.tag < InB.tag;
+				   }
+				   return memcmp( InA.backTrace, InB.backTrace, sizeof( InA.backTrace ) ) < 0;
+			   } );
+
+	/**
+	 * Group of live allocations with the same call stack
+	 */
+	struct SAllocationGroup
+	{
+		uint32		firstIndex;		/**< Index of first allocation in group */
+		uint32		count;			/**< Number of allocations */
+		uint64		bytes;			/**< Size of allocations */
+	};
+
+	std::vector<SAllocationGroup>		groups;
+	uint64								totalBytes = 0;
+	for ( uint32 index = 0; index < numLiveAllocations; ++index )
+	{
+		const SLiveAllocation&		liveAllocation = liveAllocations[ index ];
+		if ( groups.empty() || liveAllocations[ groups.back().firstIndex ].tag != liveAllocation.tag ||
+			 memcmp( liveAllocations[ groups.back().firstIndex ].backTrace, liveAllocation.backTrace, sizeof( liveAllocation.backTrace ) ) != 0 )
+		{
+			groups.push_back( SAllocationGroup{ index, 0, 0 } );
+		}
+
+		groups.back().count		+= 1;
+		groups.back().bytes		+= liveAllocation.size;
+		totalBytes				+= liveAllocation.size;
+	}
+
+	std::sort( groups.begin(), groups.end(), []( const SAllocationGroup& InA, const SAllocationGroup& InB )
+			   {
+				   return InA.bytes > InB.bytes;
+			   } );
+
+	LE_LOG( LT_Log, LC_General, TEXT( "Live allocations: %u (%llu bytes) in %u groups" ), numLiveAllocations, totalBytes, ( uint32 )groups.size() );
+	for ( uint32 index = 0, count = Min<uint32>( groups.size(), InMaxEntries ); index < count; ++index )
+	{
+		const SAllocationGroup&		group = groups[ index ];
+		const SLiveAllocation&		liveAllocation = liveAllocations[ group.firstIndex ];
+		LE_LOG( LT_Log, LC_General, TEXT( "#%u: %llu bytes in %u allocations, tag '%s'" ), index, group.bytes, group.count, GMemoryTagNames[ liveAllocation.tag < MTAG_Num ? liveAllocation.tag : MTAG_Default ] );
+
+		for ( uint32 frameIndex = 0; frameIndex < liveAllocation.numFrames; ++frameIndex )
+		{
+			LE_LOG( LT_Log, LC_General, TEXT( "    %s" ), appProgramCounterToString( liveAllocation.backTrace[ frameIndex ] ).c_str() );
+		}
+	}
+
+	if ( liveAllocations )
+	{
+		innerMalloc->Free( liveAllocations );
+	}
+}
@@ -0,0 +1,142 @@
+#include <memory.h>
+
+#include "Misc/Template.h"
+#include "System/MemoryArchive.h"
+
+// ====================================
+// Archive reading
+// ====================================
+
+/**
+ * Constructor
+ */
+CMemoryArchiveReading::CMemoryArchiveReading( const byte* InData, uint32 InSize, uint32 InVer, EArchiveType InType )
+	: CArchive( TEXT( "" ) )
+	, data( InData )
+	, size( InSize )
+	, offset( 0 )
+{
+	arVer	= InVer;
+	arType	= InType;
+}
+
+/**
+ * Serialize data
+ */
+void CMemoryArchiveReading::Serialize( void* InBuffer, uint32 InSize )
+{
+	checkMsg( offset + InSize <= size, TEXT( "Reading out of memory archive: offset %i, size %i, archive size %i" ), offset, InSize, size );
+	memcpy( InBuffer, data + offset, InSize );
+	offset += InSize;
+}
+
+/**
+ * Get current position in archive
+ */
+uint32 CMemoryArchiveReading::Tell()
+{
+	return offset;
+}
+
+/**
+ * Set current position in archive
+ */
+void CMemoryArchiveReading::Seek( uint32 InPosition )
+{
+	check( InPosition <= size );
+	offset = InPosition;
+}
+
+/**
+ * Is loading archive
+ */
+bool CMemoryArchiveReading::IsLoading() const
+{
+	return true;
+}
+
+/**
+ * Is end of file
+ */
+bool CMemoryArchiveReading::IsEndOfFile()
+{
+	return offset == size;
+}
+
+/**
+ * Get size of archive
+ */
+uint32 CMemoryArchiveReading::GetSize()
+{
+	return size;
+}
+
+// ====================================
+// Archive writing
+// ====================================
+
+/**
+ * Constructor
+ */
+CMemoryArchiveWriter::CMemoryArchiveWriter( uint32 InVer, EArchiveType InType )
+	: CArchive( TEXT( "" ) )
+	, offset( 0 )
+{
+	arVer	= InVer;
+	arType	= InType;
+}
+
+/**
+ * Serialize data
+ */
+void CMemoryArchiveWriter::Serialize( void* InBuffer, uint32 InSize )
+{
+	if ( offset + InSize > data.size() )
+	{
+		data.resize( offset + InSize );
+	}
+
+	memcpy( data.data() + offset, InBuffer, InSize );
+	offset += InSize;
+}
+
+/**
+ * Get current position in archive
+ */
+uint32 CMemoryArchiveWriter::Tell()
+{
+	return offset;
+}
+
+/**
+ * Set current position in archive
+ */
+void CMemoryArchiveWriter::Seek( uint32 InPosition )
+{
+	check( InPosition <= data.size() );
+	offset = InPosition;
+}
+
+/**
+ * Is saving archive
+ */
+bool CMemoryArchiveWriter::IsSaving() const
+{
+	return true;
+}
+
+/**
+ * Is end of file
+ */
+bool CMemoryArchiveWriter::IsEndOfFile()
+{
+	return offset == data.size();
+}
+
+/**
+ * Get size of archive
+ */
+uint32 CMemoryArchiveWriter::GetSize()
+{
+	return ( uint32 )data.size();
+}
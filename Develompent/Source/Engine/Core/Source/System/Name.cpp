@@ -1,4 +1,5 @@
 #include <list>
+#include <unordered_map>
 
 #include "Misc/Misc.h"
 #include "Containers/String.h"
@@ -10,9 +11,20 @@ static std::vector<CName::SNameEntry>& GetGlobalNameTable()
 	return globalNameTable;
 }
 
+/**
+ * Get map of name hash to index in global name table, it need for fast interning of names
+ */
+static std::unordered_map<uint32, uint32>& GetGlobalNameHashMap()
+{
+	static std::unordered_map<uint32, uint32>	globalNameHashMap;
+	return globalNameHashMap;
+}
+
 static FORCEINLINE void AllocateNameEntry( const std::wstring& InName, uint32 InHash )
 {
-	GetGlobalNameTable().push_back( CName::SNameEntry( InName, InHash ) );
+	std::vector<CName::SNameEntry>&		globalNameTable = GetGlobalNameTable();
+	GetGlobalNameHashMap().emplace( InHash, ( uint32 )globalNameTable.size() );
+	globalNameTable.push_back( CName::SNameEntry( InName, InHash ) );
 }
 
 void CName::StaticInit()
@@ -41,19 +53,16 @@ void CName::Init( const std::wstring& InString )
 	uint32				hash = appCalcHash( CString::ToUpper( InString ) );
 
 	// Try find already exist name in global table
-	std::vector<CName::SNameEntry>&		globalNameTable = GetGlobalNameTable();
-	for ( uint32 nameEntryId = 0, numNameEntries = globalNameTable.size(); nameEntryId < numNameEntries; ++nameEntryId )
+	std::unordered_map<uint32, uint32>&				globalNameHashMap = GetGlobalNameHashMap();
+	std::unordered_map<uint32, uint32>::iterator	itName = globalNameHashMap.find( hash );
+	if ( itName != globalNameHashMap.end() )
 	{
-		const CName::SNameEntry&		nameEntry = globalNameTable[nameEntryId];
-		if ( nameEntry.hash == hash )
-		{
-			index = nameEntryId;
-			return;
-		}
+		index = itName->second;
+		return;
 	}
 
 	// Getting index of name
-	index = globalNameTable.size();
+	index = GetGlobalNameTable().size();
 
 	// Allocate new name entry
 	AllocateNameEntry( InString, hash );
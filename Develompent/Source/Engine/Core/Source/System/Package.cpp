@@ -13,6 +13,7 @@
 #include "System/AudioBank.h"
 #include "System/PhysicsMaterial.h"
 #include "System/PhysicsEngine.h"
+#include "System/Malloc.h"
 
 #if WITH_EDITOR
 #include "WorldEd.h"
@@ -221,6 +222,8 @@ CPackage::~CPackage()
 
 bool CPackage::Load( const std::wstring& InPath )
 {
+	SCOPED_MEMORY_TAG( MTAG_Assets );
+
 	RemoveAll( true );
 
 	CArchive*		archive = GFileSystem->CreateFileReader( InPath );
@@ -974,49 +977,34 @@ void CPackageManager::Tick()
 void CPackageManager::Shutdown()
 {}
 
-bool ParseReferenceToAsset( const std::wstring& InString, std::wstring& OutPackageName, std::wstring& OutAssetName, EAssetType& OutAssetType )
+bool ParseReferenceToAsset( const CStringView& InString, CStringView& OutPackageName, CStringView& OutAssetName, EAssetType& OutAssetType )
 {
 	// If string is empty, we nothing do
-	if ( InString.empty() )
+	if ( InString.IsEmpty() )
 	{
 		return false;
 	}
 
-	// Divide the string into three parts: asset type, package name and asset name
-	uint32				offset						= 0;
-	std::size_t			posSpliterType				= InString.find( TEXT( "'" ) );
-	std::size_t			posSpliterPackageAndAsset	= InString.find( TEXT( ":" ) );
-	uint32				packageNameSize				= posSpliterPackageAndAsset - posSpliterType - 1;
-	uint32				assetNameSize				= InString.size() - posSpliterPackageAndAsset - 1;
-	if ( posSpliterType == std::wstring::npos || posSpliterPackageAndAsset == std::wstring::npos || packageNameSize <= 0 || assetNameSize <= 0 )
+	// Divide the string into three parts: asset type, package name and asset name.
+	// Parts are views into InString, so here we not allocate memory
+	uint32				posSpliterType				= InString.Find( TEXT( '\'' ) );
+	uint32				posSpliterPackageAndAsset	= InString.Find( TEXT( ':' ) );
+	if ( posSpliterType == INDEX_NONE || posSpliterPackageAndAsset == INDEX_NONE || posSpliterPackageAndAsset <= posSpliterType + 1 || posSpliterPackageAndAsset + 1 >= InString.GetLength() )
 	{
-		LE_LOG( LT_Warning, LC_Package, TEXT( "Not correct input string '%s', reference to asset must be splitted by '<Asset type>'<Package name>:<Asset name>'" ), InString.c_str() );
+		LE_LOG( LT_Warning, LC_Package, TEXT( "Not correct input string '%s', reference to asset must be splitted by '<Asset type>'<Package name>:<Asset name>'" ), InString.ToString().c_str() );
 		return false;
 	}
 
-	// Getting asset type
-	std::wstring		assetType;
-	assetType.resize( posSpliterType );
-	memcpy( assetType.data(), &InString[ 0 ], sizeof( std::wstring::value_type ) * assetType.size() );
-	offset = assetType.size() + 1;				// +1 for skip splitter of type asset
-	OutAssetType = ConvertTextToAssetType( assetType );
-
-	// Getting package name
-	OutPackageName.resize( packageNameSize );
-	memcpy( OutPackageName.data(), &InString[ offset ], sizeof( std::wstring::value_type ) * packageNameSize );
-	offset += packageNameSize + 1;				// +1 for skip splitter of asset and package
-
-	// Getting asset name
-	OutAssetName.resize( assetNameSize );
-	memcpy( OutAssetName.data(), &InString[ offset ], sizeof( std::wstring::value_type ) * assetNameSize );
-
+	OutAssetType	= ConvertTextToAssetType( InString.SubStr( 0, posSpliterType ) );
+	OutPackageName	= InString.SubStr( posSpliterType + 1, posSpliterPackageAndAsset - posSpliterType - 1 );		// +1 for skip splitter of type asset
+	OutAssetName	= InString.SubStr( posSpliterPackageAndAsset + 1 );												// +1 for skip splitter of asset and package
 	return true;
 }
 
-TAssetHandle<CAsset> CPackageManager::FindAsset( const std::wstring& InString, EAssetType InType /* = AT_Unknown */ )
+TAssetHandle<CAsset> CPackageManager::FindAsset( const CStringView& InString, EAssetType InType /* = AT_Unknown */ )
 {
-	std::wstring		packageName;
-	std::wstring		assetName;
+	CStringView			packageName;
+	CStringView			assetName;
 	EAssetType			assetType;
 	if ( !ParseReferenceToAsset( InString, packageName, assetName, assetType ) || ( InType != AT_Unknown && assetType != InType ) )
 	{
@@ -1029,7 +1017,7 @@ TAssetHandle<CAsset> CPackageManager::FindAsset( const std::wstring& InString, E
 	{
 		if ( !GIsCooker )
 		{
-			LE_LOG( LT_Warning, LC_Package, TEXT( "Package with name '%s' not found in TOC file" ), packageName.c_str() );
+			LE_LOG( LT_Warning, LC_Package, TEXT( "Package with name '%s' not found in TOC file" ), packageName.ToString().c_str() );
 		}
 		return GAssetFactory.GetDefault( InType );
 	}
@@ -1060,9 +1048,9 @@ TAssetHandle<CAsset> CPackageManager::FindAsset( const std::wstring& InPath, con
 	return asset;
 }
 
-TAssetHandle<CAsset> CPackageManager::FindAsset( const std::wstring& InPath, const std::wstring& InAsset, EAssetType InType /* = AT_Unknown */ )
+TAssetHandle<CAsset> CPackageManager::FindAsset( const std::wstring& InPath, const CStringView& InAsset, EAssetType InType /* = AT_Unknown */ )
 {
-	check( !InAsset.empty() );
+	check( !InAsset.IsEmpty() );
 
 	// Find package and open he
 	TAssetHandle<CAsset>	asset;
@@ -0,0 +1,220 @@
+#include <thread>
+
+#include "Misc/Template.h"
+#include "Containers/String.h"
+#include "Logger/LoggerMacros.h"
+#include "System/ThreadPool.h"
+
+/**
+ * Global thread pool
+ */
+CThreadPool			GThreadPool;
+
+/**
+ * Is current thread is worker of thread pool
+ */
+static thread_local bool		GIsWorkerThread = false;
+
+/**
+ * Constructor
+ */
+CThreadPool::CWorker::CWorker( CThreadPool* InThreadPool )
+	: threadPool( InThreadPool )
+{}
+
+/**
+ * Initialize worker thread
+ */
+bool CThreadPool::CWorker::Init()
+{
+	GIsWorkerThread = true;
+	return true;
+}
+
+/**
+ * Main loop of worker thread
+ */
+uint32 CThreadPool::CWorker::Run()
+{
+	while ( true )
+	{
+		threadPool->workSemaphore->Wait();
+		if ( threadPool->bIsStopping )
+		{
+			break;
+		}
+
+		threadPool->ExecuteJob();
+	}
+	return 0;
+}
+
+/**
+ * Request stop of worker thread
+ */
+void CThreadPool::CWorker::Stop()
+{}
+
+/**
+ * Exit from worker thread
+ */
+void CThreadPool::CWorker::Exit()
+{
+	GIsWorkerThread = false;
+}
+
+/**
+ * Constructor
+ */
+CThreadPool::CThreadPool()
+	: workSemaphore( nullptr )
+	, jobDoneEvent( nullptr )
+	, jobFunction( nullptr )
+	, jobNum( 0 )
+	, jobBatchSize( 1 )
+	, jobNextIndex( 0 )
+	, jobNumPendingWorkers( 0 )
+	, bIsStopping( false )
+{}
+
+/**
+ * Destructor
+ */
+CThreadPool::~CThreadPool()
+{
+	Shutdown();
+}
+
+/**
+ * Create worker threads
+ */
+void CThreadPool::Init( uint32 InNumWorkers /* = 0 */ )
+{
+	if ( !workerThreads.empty() )
+	{
+		return;
+	}
+
+	uint32		numWorkers = InNumWorkers;
+	if ( !numWorkers )
+	{
+		numWorkers = Max<uint32>( std::thread::hardware_concurrency(), 2 ) - 1;
+	}
+
+	workSemaphore	= GSynchronizeFactory->CreateSemaphore( numWorkers, 0, TEXT( "ThreadPoolWork" ) );
+	jobDoneEvent	= GSynchronizeFactory->CreateSynchEvent( false, TEXT( "ThreadPoolJobDone" ) );
+	check( workSemaphore && jobDoneEvent );
+
+	bIsStopping = false;
+	for ( uint32 index = 0; index < numWorkers; ++index )
+	{
+		CWorker*			worker = new CWorker( this );
+		CRunnableThread*	workerThread = GThreadFactory->CreateThread( worker, CString::Format( TEXT( "WorkerThread_%i" ), index ).c_str(), false, false, 0, TP_Normal );
+		check( workerThread );
+
+		workers.push_back( worker );
+		workerThreads.push_back( workerThread );
+	}
+
+	LE_LOG( LT_Log, LC_Init, TEXT( "Thread pool started with %i workers" ), numWorkers );
+}
+
+/**
+ * Stop and destroy worker threads
+ */
+void CThreadPool::Shutdown()
+{
+	if ( workerThreads.empty() )
+	{
+		return;
+	}
+
+	// Wake up all workers, they will see stop flag and exit
+	bIsStopping = true;
+	workSemaphore->Post( ( uint32 )workerThreads.size() );
+	for ( uint32 index = 0, count = ( uint32 )workerThreads.size(); index < count; ++index )
+	{
+		workerThreads[ index ]->WaitForCompletion();
+		workerThreads[ index ]->Kill();
+		GThreadFactory->Destroy( workerThreads[ index ] );
+		delete workers[ index ];
+	}
+
+	GSynchronizeFactory->Destroy( workSemaphore );
+	GSynchronizeFactory->Destroy( jobDoneEvent );
+	workSemaphore	= nullptr;
+	jobDoneEvent	= nullptr;
+	workers.clear();
+	workerThreads.clear();
+}
+
+/**
+ * Execute function for each index in range [0, InNum)
+ */
+void CThreadPool::ParallelFor( uint32 InNum, const std::function<void( uint32 )>& InFunction, uint32 InBatchSize /* = 1 */ )
+{
+	if ( !InNum )
+	{
+		return;
+	}
+
+	// Nested loops and loops which fit in one batch are executed serially
+	InBatchSize = Max<uint32>( InBatchSize, 1 );
+	if ( workerThreads.empty() || GIsWorkerThread || InNum <= InBatchSize )
+	{
+		for ( uint32 index = 0; index < InNum; ++index )
+		{
+			InFunction( index );
+		}
+		return;
+	}
+
+	CScopeLock		scopeLock( dispatchCS );
+	uint32			numWorkers = Min<uint32>( ( uint32 )workerThreads.size(), ( InNum + InBatchSize - 1 ) / InBatchSize - 1 );
+	jobFunction				= &InFunction;
+	jobNum					= InNum;
+	jobBatchSize			= InBatchSize;
+	jobNextIndex			= 0;
+	jobNumPendingWorkers	= numWorkers;
+	workSemaphore->Post( numWorkers );
+
+	// Calling thread takes batches too, after it waits until all woken workers finish
+	ExecuteJob();
+	jobDoneEvent->Wait();
+	jobFunction = nullptr;
+}
+
+/**
+ * Take batches of current job and execute them until job is over
+ */
+void CThreadPool::ExecuteJob()
+{
+	bool		bIsWorker = GIsWorkerThread;
+	while ( true )
+	{
+		uint32		startIndex = ( uint32 )appInterlockedAdd( &jobNextIndex, ( int32 )jobBatchSize );
+		if ( startIndex >= jobNum )
+		{
+			break;
+		}
+
+		for ( uint32 index = startIndex, endIndex = Min( startIndex + jobBatchSize, jobNum ); index < endIndex; ++index )
+		{
+			( *jobFunction )( index );
+		}
+	}
+
+	// Last finished worker signals to dispatching thread
+	if ( bIsWorker && appInterlockedDecrement( &jobNumPendingWorkers ) == 0 )
+	{
+		jobDoneEvent->Trigger();
+	}
+}
+
+/**
+ * Is current thread is worker of thread pool
+ */
+bool CThreadPool::IsInWorkerThread()
+{
+	return GIsWorkerThread;
+}
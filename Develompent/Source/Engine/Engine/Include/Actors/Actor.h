@@ -539,6 +539,29 @@ private:
  */
 DECLARE_MULTICAST_DELEGATE( COnActorDestroyed, class AActor* );
 
+/**
+ * @ingroup Engine
+ * Tick function of actor, it calls AActor::Tick
+ */
+class CActorTickFunction : public CTickFunction
+{
+public:
+	/**
+	 * Constructor
+	 * @param InActor	Ticked actor
+	 */
+	CActorTickFunction( class AActor* InActor );
+
+	/**
+	 * Execute tick
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	virtual void ExecuteTick( float InDeltaTime ) override;
+
+private:
+	class AActor*		actor;		/**< Ticked actor */
+};
+
 /**
  * @ingroup Engine
  * Base class of all actors in world
@@ -591,6 +614,17 @@ public:
 	 */
 	virtual void Destroyed();
 
+	/**
+	 * @brief Called when destroyed actor is returned to actor pool (see CActorPool)
+	 * Override it for reset gameplay state of actor, after that actor may be spawned again. Spawned and BeginPlay
+	 * are called on each spawn from pool, constructor is called only once.
+	 * Components are reset to state of components with same index in archetype (see CActorComponent::ResetForPool),
+	 * listeners of OnActorDestroyed are removed
+	 *
+	 * @param InArchetype	Never spawned actor of the same class, may be NULL
+	 */
+	virtual void ResetForPool( const AActor* InArchetype );
+
 	/**
 	 * @brief Destroy this actor. Returns TRUE the actor is destroyed or already marked for destruction, FALSE if indestructible
 	 * Destruction is latent. It occurs at the end of the tick
@@ -613,6 +647,112 @@ public:
 	 */
 	void SyncPhysics();
 
+	/**
+	 * @brief Register tick functions of actor and all owned components
+	 * By default actor is ticked after its components from the same tick group
+	 *
+	 * @param InTickTaskManager		Tick task manager
+	 */
+	void RegisterTickFunctions( class CTickTaskManager* InTickTaskManager );
+
+	/**
+	 * @brief Unregister tick functions of actor and all owned components
+	 */
+	void UnregisterTickFunctions();
+
+	/**
+	 * @brief Make this actor tick after other actor
+	 * @param InPrerequisiteActor	Actor which must be ticked before this actor
+	 */
+	FORCEINLINE void AddTickPrerequisiteActor( AActor* InPrerequisiteActor )
+	{
+		check( InPrerequisiteActor );
+		actorTick.AddPrerequisite( &InPrerequisiteActor->actorTick );
+	}
+
+	/**
+	 * @brief Make this actor tick after component
+	 * @param InPrerequisiteComponent	Component which must be ticked before this actor
+	 */
+	FORCEINLINE void AddTickPrerequisiteComponent( CActorComponent* InPrerequisiteComponent )
+	{
+		check( InPrerequisiteComponent );
+		actorTick.AddPrerequisite( &InPrerequisiteComponent->GetComponentTick() );
+	}
+
+	/**
+	 * @brief Get tick function of actor
+	 * Use it for change tick group, prerequisites or mark actor thread-safe for parallel tick
+	 *
+	 * @return Return tick function of actor
+	 */
+	FORCEINLINE CActorTickFunction& GetActorTick()
+	{
+		return actorTick;
+	}
+
+	/**
+	 * @brief Enable or disable tick of actor
+	 * @param InIsEnabled	Is tick enabled
+	 */
+	FORCEINLINE void SetActorTickEnabled( bool InIsEnabled )
+	{
+		actorTick.SetTickEnabled( InIsEnabled );
+	}
+
+	/**
+	 * @brief Set tick interval of actor
+	 * @param InTickInterval	Interval in seconds between ticks. If 0 actor will be ticked every frame
+	 */
+	FORCEINLINE void SetActorTickInterval( float InTickInterval )
+	{
+		actorTick.SetTickInterval( InTickInterval );
+	}
+
+	/**
+	 * @brief Make actor and all owned components dormant
+	 * Dormant tick functions stay registered, but they aren't scheduled until actor wakes up
+	 *
+	 * @param InIsDormant	Is actor dormant
+	 */
+	void SetTickDormant( bool InIsDormant );
+
+	/**
+	 * @brief Make actor dormant by world (e.g. static actors in game)
+	 * It's tracked apart from SetTickDormant, so world wakes up only actors which it made dormant
+	 *
+	 * @param InIsDormant	Is actor dormant
+	 */
+	void SetTickDormantByWorld( bool InIsDormant );
+
+	/**
+	 * @brief Set throttle interval of actor and all owned components
+	 * @param InThrottleInterval	Interval in seconds between ticks. If 0 throttling is disabled
+	 */
+	void SetTickThrottleInterval( float InThrottleInterval );
+
+	/**
+	 * @brief Set is tick frequency of actor depends on distance from view (see CSignificanceManager)
+	 * @param InIsTickBySignificance	Is tick by significance
+	 */
+	FORCEINLINE void SetTickBySignificance( bool InIsTickBySignificance )
+	{
+		bTickBySignificance = InIsTickBySignificance;
+		if ( !bTickBySignificance )
+		{
+			SetTickThrottleInterval( 0.f );
+		}
+	}
+
+	/**
+	 * @brief Is tick frequency of actor depends on distance from view
+	 * @return Return TRUE if actor is throttled by significance manager
+	 */
+	FORCEINLINE bool IsTickBySignificance() const
+	{
+		return bTickBySignificance;
+	}
+
 #if WITH_EDITOR
 	/**
 	 * @brief Initialize actor properties
@@ -714,6 +854,12 @@ public:
 	{
 		bNeedReinitCollision = InIsStatic != bIsStatic ? true : bNeedReinitCollision;
 		bIsStatic = InIsStatic;
+
+		// Only static actors are dormant by world, collision is reinited in tick
+		if ( !bIsStatic && bTickDormantByWorld )
+		{
+			SetTickDormantByWorld( false );
+		}
 	}
 
 #if ENABLE_HITPROXY
@@ -846,6 +992,35 @@ public:
 		return bActorIsBeingDestroyed;
 	}
 
+	/**
+	 * Mark actor as pending kill
+	 * @note Called by CWorld when actor is put into destroy queue
+	 */
+	FORCEINLINE void MarkPendingKill()
+	{
+		bActorIsBeingDestroyed = true;
+	}
+
+	/**
+	 * Set handle of actor in world
+	 * @note Called by CWorld on spawn and destroy
+	 * 
+	 * @param InHandle	Handle of actor
+	 */
+	FORCEINLINE void SetActorHandle( const ActorHandle_t& InHandle )
+	{
+		actorHandle = InHandle;
+	}
+
+	/**
+	 * Get handle of actor in world
+	 * @return Return handle of actor, if actor not in world returns unset handle
+	 */
+	FORCEINLINE const ActorHandle_t& GetActorHandle() const
+	{
+		return actorHandle;
+	}
+
 	/**
 	 * Is actor playing
 	 * @return Return TRUE if actor is playing, else returning FALSE
@@ -897,6 +1072,11 @@ protected:
 	 */
 	void ResetOwnedComponents();
 
+	/**
+	 * @brief Enable or disable tick functions of actor and owned components by dormant flags
+	 */
+	void UpdateTickDormancy();
+
 	/**
 	 * Get event when actor is destroyed
 	 * @return Return event when actor is destroyed
@@ -914,12 +1094,17 @@ private:
 	bool										bNeedReinitCollision;	/**< Is need reinit collision component */
 	bool										bActorIsBeingDestroyed;	/**< Actor is being destroyed */
 	bool										bBeginPlay;				/**< Is begin play for this actor */
+	bool										bTickBySignificance;	/**< Is tick frequency depends on distance from view */
+	bool										bTickDormant;			/**< Is actor dormant by gameplay */
+	bool										bTickDormantByWorld;	/**< Is actor dormant by world */
 	
 #if WITH_EDITOR
 	bool										bSelected;				/**< Is selected this actor */
 #endif // WITH_EDITOR
 
 	std::vector< ActorComponentRef_t >			ownedComponents;		/**< Owned components */
+	CActorTickFunction							actorTick;				/**< Tick function of actor */
+	ActorHandle_t								actorHandle;			/**< Handle of actor in world */
 	mutable COnActorDestroyed					onActorDestroyed;		/**< Called event when actor is destroyed */
 
 #if ENABLE_HITPROXY
@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ATILEMAP_H
+#define ATILEMAP_H
+
+#include <string>
+
+#include "Actors/Actor.h"
+#include "Components/TileMapComponent.h"
+
+ /**
+  * @ingroup Engine
+  * Actor of tilemap, all tiles of map are in one actor
+  */
+class ATileMap : public AActor
+{
+    DECLARE_CLASS( ATileMap, AActor )
+
+public:
+    /**
+     * Constructor
+     */
+    ATileMap();
+
+    /**
+     * Destructor
+     */
+    virtual ~ATileMap();
+
+    /**
+     * Get tilemap component
+     * @return Return pointer to tilemap component
+     */
+    FORCEINLINE TRefCountPtr< CTileMapComponent > GetTileMapComponent() const
+    {
+        return tileMapComponent;
+    }
+
+#if WITH_EDITOR
+    /**
+     * @brief Get path to icon of actor for exploer level in WorldEd
+     * @return Return path to actor icon from appBaseDir()
+     */
+    virtual std::wstring GetActorIcon() const override;
+#endif // WITH_EDITOR
+
+private:
+    TRefCountPtr< CTileMapComponent >			tileMapComponent;		/**< Tilemap component */
+};
+
+#endif // !ATILEMAP_H
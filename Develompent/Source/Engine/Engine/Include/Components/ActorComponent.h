@@ -12,6 +12,30 @@
 #include "Misc/Object.h"
 #include "Misc/RefCounted.h"
 #include "Misc/EngineTypes.h"
+#include "System/TickTaskManager.h"
+
+/**
+ * @ingroup Engine
+ * Tick function of actor component, it calls CActorComponent::TickComponent
+ */
+class CActorComponentTickFunction : public CTickFunction
+{
+public:
+	/**
+	 * Constructor
+	 * @param InComponent	Ticked component
+	 */
+	CActorComponentTickFunction( class CActorComponent* InComponent );
+
+	/**
+	 * Execute tick
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	virtual void ExecuteTick( float InDeltaTime ) override;
+
+private:
+	class CActorComponent*		component;		/**< Ticked component */
+};
 
 /**
  * @ingroup Engine
@@ -62,6 +86,15 @@ public:
 	 */
 	virtual void Destroyed();
 
+	/**
+	 * @brief Called when owner actor is returned to actor pool
+	 * Override it for reset state of component to its defaults, after that owner may be spawned again.
+	 * Each override must call Super::ResetForPool and restore every property which may be changed at runtime
+	 *
+	 * @param InArchetype	Component with same class and index in never spawned actor of the same class, may be NULL
+	 */
+	virtual void ResetForPool( const CActorComponent* InArchetype );
+
 	/**
 	 * Set owner
 	 * @param[in] InOwner Actor owner
@@ -80,6 +113,35 @@ public:
 		return owner;
 	}
 
+	/**
+	 * Get tick function of component
+	 * Use it for change tick group, prerequisites or mark component thread-safe for parallel tick
+	 *
+	 * @return Return tick function of component
+	 */
+	FORCEINLINE CActorComponentTickFunction& GetComponentTick()
+	{
+		return componentTick;
+	}
+
+	/**
+	 * Enable or disable tick of component
+	 * @param InIsEnabled	Is tick enabled
+	 */
+	FORCEINLINE void SetComponentTickEnabled( bool InIsEnabled )
+	{
+		componentTick.SetTickEnabled( InIsEnabled );
+	}
+
+	/**
+	 * Set tick interval of component
+	 * @param InTickInterval	Interval in seconds between ticks. If 0 component will be ticked every frame
+	 */
+	FORCEINLINE void SetComponentTickInterval( float InTickInterval )
+	{
+		componentTick.SetTickInterval( InTickInterval );
+	}
+
 #if WITH_EDITOR
 	/**
 	 * Set editor only
@@ -105,7 +167,8 @@ private:
 	bool					bEditorOnly;	/**< Is component only for editor */
 #endif // WITH_EDITOR
 
-	class AActor*			owner;			/**< Actor owner */
+	class AActor*					owner;			/**< Actor owner */
+	CActorComponentTickFunction		componentTick;	/**< Tick function of component */
 };
 
 #endif // !ACTORCOMPONENT_H
\ No newline at end of file
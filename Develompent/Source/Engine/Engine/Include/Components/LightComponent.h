@@ -69,6 +69,11 @@ public:
 	 */
 	virtual void Destroyed() override;
 
+	/**
+	 * @brief Called when world transform of component is changed
+	 */
+	virtual void OnTransformChanged() override;
+
 	/**
 	 * @brief Set enable the light component
 	 * @param InEnabled		Is enabled the light component
@@ -76,6 +81,7 @@ public:
 	FORCEINLINE void SetEnabled( bool InEnabled )
 	{
 		bEnabled = InEnabled;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -85,6 +91,7 @@ public:
 	FORCEINLINE void SetLightColor( const CColor& InLightColor )
 	{
 		lightColor = InLightColor;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -94,6 +101,7 @@ public:
 	FORCEINLINE void SetSpecularColor( const CColor& InSpecularColor )
 	{
 		specularColor = InSpecularColor;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -103,6 +111,7 @@ public:
 	FORCEINLINE void SetIntensivity( float InIntensivity )
 	{
 		intensivity = InIntensivity;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -159,11 +168,19 @@ public:
 	}
 
 protected:
-	bool				bEnabled;		/**< Is enabled the light component */
-	class CScene*		scene;			/**< The current scene where the primitive is located  */
-	CColor				lightColor;		/**< Light color */
-	CColor				specularColor;	/**< Specular color */
-	float				intensivity;	/**< intensivity */
+	/**
+	 * @brief Mark render state of light as changed
+	 * Scene proxy will be recreated by CScene only once for all changes before the next frame
+	 */
+	void MarkRenderStateDirty();
+
+	bool						bEnabled;			/**< Is enabled the light component */
+	class CScene*				scene;				/**< The current scene where the primitive is located  */
+	CColor						lightColor;			/**< Light color */
+	CColor						specularColor;		/**< Specular color */
+	float						intensivity;		/**< intensivity */
+	class CLightSceneProxy*		sceneProxy;			/**< Scene proxy of light, on the game thread it's used only as handle */
+	bool						bSceneProxyDirty;	/**< Is changed render state which isn't sent to scene proxy yet */
 };
 
 #endif // !LIGHTCOMPONENT_H
\ No newline at end of file
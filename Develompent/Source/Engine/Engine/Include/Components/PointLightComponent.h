@@ -32,6 +32,7 @@ public:
 	FORCEINLINE void SetRadius( float InRadius )
 	{
 		radius = InRadius;
+		MarkRenderStateDirty();
 	}
 
 	/**
@@ -12,6 +12,7 @@
 #include "Math/Box.h"
 #include "System/PhysicsBodySetup.h"
 #include "System/PhysicsBodyInstance.h"
+#include "Render/SceneProxy.h"
 #include "Components/SceneComponent.h"
 
 /**
@@ -56,10 +57,74 @@ public:
 
 	/**
 	 * @brief Adds mesh batches for draw in scene
+	 * This is only called by the rendering thread.
 	 * 
      * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView );
+	virtual void AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy );
+
+	/**
+	 * @brief Called instead of AddToDrawList when primitive is out of view
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void OnCulled( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy );
+
+	/**
+	 * @brief Called when scene proxy of primitive becomes hidden
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void OnHidden( const class CPrimitiveSceneProxy& InSceneProxy );
+
+	/**
+	 * @brief Called when update of render state is applied to scene proxy of primitive
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InSceneProxy Scene proxy of primitive
+	 * @param InFlags Applied changes (see ESceneProxyUpdateFlags)
+	 */
+	virtual void OnSceneProxyUpdated( const class CPrimitiveSceneProxy& InSceneProxy, uint32 InFlags );
+
+	/**
+	 * @brief Called when scene proxy of primitive is removed from scene
+	 * This is only called by the rendering thread. Primitive can be already added to other scene on the game thread
+	 *
+	 * @param InScene Scene where proxy was
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void OnRemovedFromScene( class CScene* InScene, const class CPrimitiveSceneProxy& InSceneProxy );
+
+	/**
+	 * @brief Add geometry of primitive as occluder into occlusion buffer
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InOcclusionBuffer Occlusion buffer
+	 * @param InSceneProxy Scene proxy of primitive
+	 * @return Return TRUE if primitive is added as occluder, otherwise returns FALSE
+	 */
+	virtual bool AddOccluder( class COcclusionBuffer& InOcclusionBuffer, const class CPrimitiveSceneProxy& InSceneProxy );
+
+	/**
+	 * @brief Get local to world matrix for rendering
+	 * @return Return local to world matrix which is cached in scene proxy
+	 */
+	virtual Matrix GetRenderMatrix() const;
+
+	/**
+	 * @brief Called when world transform of component is changed
+	 * Updates bounds and teleports physics body if component was moved not by physics
+	 */
+	virtual void OnTransformChanged() override;
+
+	/**
+	 * @brief Update bound box of primitive
+	 */
+	virtual void UpdateBounds();
 
 	/**
 	 * @brief Called when the owning Actor is spawned
@@ -71,6 +136,12 @@ public:
 	 */
 	virtual void Destroyed() override;
 
+	/**
+	 * @brief Called when owner actor is returned to actor pool
+	 * @param InArchetype	Component with same class and index in never spawned actor of the same class, may be NULL
+	 */
+	virtual void ResetForPool( const CActorComponent* InArchetype ) override;
+
 	/**
 	 * @brief Init physics component
 	 */
@@ -86,14 +157,20 @@ public:
 	 */
 	void TermPrimitivePhysics();
 
+	/**
+	 * @brief Reinit physics component if body instance or body setup is changed
+	 */
+	void UpdatePrimitivePhysics();
+
 	/**
 	 * @brief Set visibility
 	 * 
 	 * @param InNewVisibility New visibility
 	 */
-	FORCEINLINE void SetVisibility( bool InNewVisibility )
+	virtual void SetVisibility( bool InNewVisibility )
 	{
 		bVisibility = InNewVisibility;
+		MarkRenderStateDirty( SPU_Visibility );
 	}
 
 	/**
@@ -103,6 +180,7 @@ public:
 	FORCEINLINE void SetBodySetup( CPhysicsBodySetup* InBodySetup )
 	{
 		bodySetup = InBodySetup;
+		UpdatePhysicsOfDormant();
 	}
 
 	/**
@@ -159,6 +237,14 @@ public:
 		return scene;
 	}
 
+	/**
+	 * @brief Mark render state of primitive as changed
+	 * Scene proxy will be updated by CScene only once for all changes before the next frame
+	 *
+	 * @param InFlags	Changed state (see ESceneProxyUpdateFlags)
+	 */
+	void MarkRenderStateDirty( uint32 InFlags );
+
 protected:
 	/**
 	 * @brief Adds a draw policy link in SDGs
@@ -170,12 +256,19 @@ protected:
 	 */
 	virtual void UnlinkDrawList();
 
+	/**
+	 * @brief Reinit physics component of playing component which doesn't tick (e.g. dormant static actors)
+	 * Ticked components do it in TickComponent
+	 */
+	void UpdatePhysicsOfDormant();
+
 	bool						bVisibility;					/**< Is primitive visibility */
-	bool						bIsDirtyDrawingPolicyLink;		/**< Is dirty drawing policy link. If flag equal true - need update drawing policy link */
 	CBox						boundbox;						/**< Bound box */
 	PhysicsBodySetupRef_t		bodySetup;						/**< Physics body setup */
 	CPhysicsBodyInstance		bodyInstance;					/**< Physics body instance */	
 	class CScene*				scene;							/**< The current scene where the primitive is located  */
+	class CPrimitiveSceneProxy*	sceneProxy;						/**< Scene proxy of primitive, on the game thread it's used only as handle */
+	uint32						sceneProxyDirtyFlags;			/**< Changed render state which isn't sent to scene proxy yet (see ESceneProxyUpdateFlags) */
 };
 
 #endif // !PRIMITIVECOMPONENT_H
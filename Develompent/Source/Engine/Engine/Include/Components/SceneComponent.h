@@ -11,6 +11,7 @@
 
 #include "Math/Transform.h"
 #include "Components/ActorComponent.h"
+#include "System/TransformHierarchy.h"
 
  /**
   * @ingroup Engine
@@ -45,6 +46,12 @@ public:
 	 */
 	virtual void Serialize( class CArchive& InArchive ) override;
 
+	/**
+	 * @brief Called when owner actor is returned to actor pool
+	 * @param InArchetype	Component with same class and index in never spawned actor of the same class, may be NULL
+	 */
+	virtual void ResetForPool( const CActorComponent* InArchetype ) override;
+
 	/**
 	 * Add to relative location component
 	 * 
@@ -53,6 +60,7 @@ public:
 	FORCEINLINE void AddRelativeLocation( const Vector& InLocationDelta )
 	{
 		transform.AddToTranslation( InLocationDelta );
+		GTransformHierarchy.MarkDirty( transformIndex );
 	}
 
 	/**
@@ -63,6 +71,7 @@ public:
 	FORCEINLINE void AddRelativeRotate( const Quaternion& InRotationDelta )
 	{
 		transform.AddToRotation( InRotationDelta );
+		GTransformHierarchy.MarkDirty( transformIndex );
 	}
 
 	/**
@@ -73,6 +82,7 @@ public:
 	FORCEINLINE void AddRelativeScale( const Vector& InScaleDelta )
 	{
 		transform.AddToScale( InScaleDelta );
+		GTransformHierarchy.MarkDirty( transformIndex );
 	}
 
 	/**
@@ -83,6 +93,7 @@ public:
 	FORCEINLINE void SetRelativeLocation( const Vector& InLocation )
 	{
 		transform.SetLocation( InLocation );
+		GTransformHierarchy.MarkDirty( transformIndex );
 	}
 
 	/**
@@ -93,6 +104,7 @@ public:
 	FORCEINLINE void SetRelativeRotation( const Quaternion& InRotation )
 	{
 		transform.SetRotation( InRotation );
+		GTransformHierarchy.MarkDirty( transformIndex );
 	}
 
 	/**
@@ -103,6 +115,7 @@ public:
 	FORCEINLINE void SetRelativeScale( const Vector& InScale )
 	{
 		transform.SetScale( InScale );
+		GTransformHierarchy.MarkDirty( transformIndex );
 	}
 
 	/**
@@ -136,7 +149,7 @@ public:
 	 * Get the relative current transform for this component
 	 * @return Return relative current transform for this component
 	 */
-	FORCEINLINE CTransform GetRelativeTransform() const
+	FORCEINLINE const CTransform& GetRelativeTransform() const
 	{
 		return transform;
 	}
@@ -147,7 +160,16 @@ public:
 	 */
 	FORCEINLINE CTransform GetComponentTransform() const
 	{
-		return attachParent ? attachParent->GetComponentTransform() + GetRelativeTransform() : GetRelativeTransform();
+		return GTransformHierarchy.GetWorldTransform( transformIndex );
+	}
+
+	/**
+	 * Get the current transform for this component in world space as matrix
+	 * @return Return current world matrix of this component, it is recalculated only when component moved
+	 */
+	FORCEINLINE Matrix GetComponentMatrix() const
+	{
+		return GTransformHierarchy.GetWorldMatrix( transformIndex );
 	}
 
 	/**
@@ -183,7 +205,7 @@ public:
 	 */
 	FORCEINLINE Vector GetComponentLocation() const
 	{
-		return attachParent ? attachParent->GetComponentLocation() + GetRelativeLocation() : GetRelativeLocation();
+		return GTransformHierarchy.GetWorldLocation( transformIndex );
 	}
 
 	/**
@@ -192,7 +214,7 @@ public:
 	 */
 	FORCEINLINE Quaternion GetComponentRotation() const
 	{
-		return attachParent ? attachParent->GetComponentRotation() + GetRelativeRotation() : GetRelativeRotation();
+		return GTransformHierarchy.GetWorldRotation( transformIndex );
 	}
 
 	/**
@@ -201,7 +223,7 @@ public:
 	 */
 	FORCEINLINE Vector GetComponentScale() const
 	{
-		return attachParent ? attachParent->GetComponentScale() + GetRelativeScale() : GetRelativeScale();
+		return GTransformHierarchy.GetWorldScale( transformIndex );
 	}
 
 	/**
@@ -221,10 +243,46 @@ public:
 		return attachParent;
 	}
 
+	/**
+	 * Get components attached to this component
+	 * @return Return array of attached components
+	 */
+	FORCEINLINE const std::vector< CSceneComponent* >& GetAttachChildren() const
+	{
+		return attachChildren;
+	}
+
+	/**
+	 * Called by transform hierarchy when world transform of component is changed
+	 * Override it for update of data which depends on transform (bounds, physics and etc)
+	 */
+	virtual void OnTransformChanged();
+
+	/**
+	 * Set index of transform in hierarchy
+	 * @warning Used only by CTransformHierarchy
+	 *
+	 * @param InTransformIndex	Index of transform
+	 */
+	FORCEINLINE void SetTransformIndex( uint32 InTransformIndex )
+	{
+		transformIndex = InTransformIndex;
+	}
+
+	/**
+	 * Get index of transform in hierarchy
+	 * @return Return index of transform in GTransformHierarchy
+	 */
+	FORCEINLINE uint32 GetTransformIndex() const
+	{
+		return transformIndex;
+	}
+
 private:
-	// TODO BS yehor.pohuliaka - Need add array of child components
 	TRefCountPtr< CSceneComponent >		attachParent;	/**< What we are currently attached to. If valid, transform are used relative to this object */
+	std::vector< CSceneComponent* >		attachChildren;	/**< Components attached to this component */
 	CTransform							transform;		/**< Transform of component */
+	uint32								transformIndex;	/**< Index of world transform in GTransformHierarchy */
 };
 
 #endif // !SCENECOMPONENT_H
\ No newline at end of file
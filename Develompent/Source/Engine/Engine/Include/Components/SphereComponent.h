@@ -42,8 +42,15 @@ public:
 	 * @brief Adds mesh batches for draw in scene
 	 *
 	 * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual void AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Get local to world matrix for rendering
+	 * @return Return local to world matrix with scale by radius
+	 */
+	virtual Matrix GetRenderMatrix() const override;
 
 	/**
 	 * @brief Set SDG level
@@ -52,7 +59,7 @@ public:
 	FORCEINLINE void SetSDGLevel( ESceneDepthGroup InSDGLevel )
 	{
 		pendingSDGLevel = InSDGLevel;
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Material );
 	}
 
 	/**
@@ -62,7 +69,7 @@ public:
 	FORCEINLINE void SetRadius( float InRadius )
 	{
 		radius = InRadius;
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Transform );
 	}
 
 	/**
@@ -72,7 +79,7 @@ public:
 	FORCEINLINE void SetMaterial( const TAssetHandle<CMaterial>& InMaterial )
 	{
 		material = InMaterial;
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Material );
 	}
 
 	/**
@@ -25,6 +25,30 @@ public:
 	 */
 	CSpotLightComponent();
 
+	/**
+	 * @brief Set radius
+	 * @param InRadius		Radius
+	 */
+	FORCEINLINE void SetRadius( float InRadius )
+	{
+		radius = InRadius;
+		MarkRenderStateDirty();
+	}
+
+	/**
+	 * @brief Set cone angles
+	 * Light is full inside of inner cone and fades out to outer cone
+	 *
+	 * @param InInnerConeAngle		Inner cone angle in degrees
+	 * @param InOuterConeAngle		Outer cone angle in degrees
+	 */
+	FORCEINLINE void SetConeAngles( float InInnerConeAngle, float InOuterConeAngle )
+	{
+		outerConeAngle	= SMath::Clamp( InOuterConeAngle, 1.f, 89.f );
+		innerConeAngle	= SMath::Clamp( InInnerConeAngle, 0.f, outerConeAngle );
+		MarkRenderStateDirty();
+	}
+
 	/**
 	 * @brief Get light type
 	 * Need override the method by child for setting light type
@@ -32,6 +56,38 @@ public:
 	 * @return Return light type
 	 */
 	virtual ELightType GetLightType() const override;
+
+	/**
+	 * @brief Get radius
+	 * @return Return radius
+	 */
+	FORCEINLINE float GetRadius() const
+	{
+		return radius;
+	}
+
+	/**
+	 * @brief Get inner cone angle
+	 * @return Return inner cone angle in degrees
+	 */
+	FORCEINLINE float GetInnerConeAngle() const
+	{
+		return innerConeAngle;
+	}
+
+	/**
+	 * @brief Get outer cone angle
+	 * @return Return outer cone angle in degrees
+	 */
+	FORCEINLINE float GetOuterConeAngle() const
+	{
+		return outerConeAngle;
+	}
+
+private:
+	float		radius;				/**< Radius */
+	float		innerConeAngle;		/**< Inner cone angle in degrees */
+	float		outerConeAngle;		/**< Outer cone angle in degrees */
 };
 
 #endif // !SPOTLIGHTCOMPONENT_H
\ No newline at end of file
@@ -17,13 +17,6 @@
 #include "Render/SceneHitProxyRendering.h"
 #endif // ENABLE_HITPROXY
 
-enum ESpriteType
-{
-    ST_Static,                  /**< Static sprite */
-    ST_Rotating,                /**< Rotating sprite to player camera */
-    ST_RotatingOnlyVertical     /**< Rotating sprite to player camera only by vertical */
-};
-
  /**
   * @ingroup Engine
   * @brief Component for work with sprite
@@ -42,8 +35,50 @@ public:
 	 * @brief Adds mesh batches for draw in scene
 	 *
 	 * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Called instead of AddToDrawList when sprite is out of view
+	 *
+	 * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void OnCulled( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Called when scene proxy of sprite becomes hidden
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void OnHidden( const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Called when update of render state is applied to scene proxy of sprite
+	 *
+	 * @param InSceneProxy Scene proxy of primitive
+	 * @param InFlags Applied changes (see ESceneProxyUpdateFlags)
+	 */
+	virtual void OnSceneProxyUpdated( const class CPrimitiveSceneProxy& InSceneProxy, uint32 InFlags ) override;
+
+	/**
+	 * @brief Called when scene proxy of sprite is removed from scene
+	 *
+	 * @param InScene Scene where proxy was
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void OnRemovedFromScene( class CScene* InScene, const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Get local to world matrix for rendering
+	 * @return Return local to world matrix, billboard sprite is rotated before scale like before turning to camera
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual Matrix GetRenderMatrix() const override;
+
+	/**
+	 * @brief Update bound box of sprite
+	 */
+	virtual void UpdateBounds() override;
 
 	/**
 	 * @brief Serialize component
@@ -51,6 +86,12 @@ public:
 	 */
 	virtual void Serialize( class CArchive& InArchive ) override;
 
+	/**
+	 * @brief Called when owner actor is returned to actor pool
+	 * @param InArchetype	Component with same class and index in never spawned actor of the same class, may be NULL
+	 */
+	virtual void ResetForPool( const CActorComponent* InArchetype ) override;
+
     /**
      * @brief Set sprite type
      *
@@ -58,7 +99,8 @@ public:
      */
     FORCEINLINE void SetType( ESpriteType InType )
     {
-        type = InType;
+        sprite->SetType( InType );
+        MarkRenderStateDirty( SPU_Transform );
     }
 
     /**
@@ -67,7 +109,7 @@ public:
      */
     FORCEINLINE ESpriteType GetType() const
     {
-        return type;
+        return sprite->GetType();
     }
 
 	/**
@@ -77,7 +119,7 @@ public:
 	FORCEINLINE void SetTextureRect( const RectFloat_t& InTextureRect )
 	{
 		sprite->SetTextureRect( InTextureRect );
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Instance );
 	}
 
 	/**
@@ -96,7 +138,8 @@ public:
 	FORCEINLINE void SetSpriteSize( const Vector2D& InSpriteSize )
 	{
 		sprite->SetSpriteSize( InSpriteSize );
-		bIsDirtyDrawingPolicyLink = true;
+		UpdateBounds();
+		MarkRenderStateDirty( SPU_Transform );
 	}
 
 	/**
@@ -115,7 +158,7 @@ public:
 	FORCEINLINE void SetMaterial( const TAssetHandle<CMaterial> InMaterial )
 	{
 		sprite->SetMaterial( InMaterial );
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Material );
 	}
 
 	/**
@@ -125,7 +168,7 @@ public:
 	FORCEINLINE void SetFlipVertical( bool InFlipVertical )
 	{
 		sprite->SetFlipVertical( InFlipVertical );
-		bFlipVertical = InFlipVertical;
+		MarkRenderStateDirty( SPU_Instance );
 	}
 
 	/**
@@ -135,7 +178,7 @@ public:
 	FORCEINLINE void SetFlipHorizontal( bool InFlipHorizontal )
 	{
 		sprite->SetFlipHorizontal( InFlipHorizontal );
-		bFlipHorizontal = InFlipHorizontal;
+		MarkRenderStateDirty( SPU_Instance );
 	}
 
 	/**
@@ -153,7 +196,7 @@ public:
 	 */
 	FORCEINLINE bool IsFlipedVertical() const
 	{
-		return bFlipVertical;
+		return sprite->IsFlipedVertical();
 	}
 
 	/**
@@ -162,7 +205,7 @@ public:
 	 */
 	FORCEINLINE bool IsFlipedHorizontal() const
 	{
-		return bFlipHorizontal;
+		return sprite->IsFlipedHorizontal();
 	}
 
 #if WITH_EDITOR
@@ -172,7 +215,7 @@ public:
 	 */
 	FORCEINLINE void SetGizmo( bool InIsGizmo )
 	{
-		bIsDirtyDrawingPolicyLink	= true;
+		MarkRenderStateDirty( SPU_Material );
 		bGizmo						= InIsGizmo;
 	}
 
@@ -222,12 +265,10 @@ private:
 #endif // ENABLE_HITPROXY
 
 	/**
-	 * @brief Calculate transformation matrix
-	 *
-	 * @param InSceneView Current view of scene
-	 * @param OutResult Output calculated transformation matrix
+	 * @brief Update instance of sprite in sprite batch
+	 * @param InSceneProxy	Scene proxy of sprite
 	 */
-	void CalcTransformationMatrix( const class CSceneView& InSceneView, Matrix& OutResult ) const;
+	void UpdateInstance( const class CPrimitiveSceneProxy& InSceneProxy );
 
 	/**
 	 * @brief Adds a draw policy link in SDGs
@@ -239,15 +280,25 @@ private:
 	 */
 	virtual void UnlinkDrawList() override;
 
+	/**
+	 * @brief Remove draw policy links from SDGs of scene and free instance in sprite batch
+	 * @note Must be called only in render thread
+	 *
+	 * @param InScene	Scene where sprite is linked
+	 */
+	void RemoveFromDrawLists( class CScene* InScene );
+
 #if WITH_EDITOR
 	bool								bGizmo;							/**< This sprite component is gizmo */
+	bool								bSelectedInstance;				/**< Is instance in sprite batch drawn as selected */
 	GizmoDrawingPolicyLinkRef_t			gizmoDrawingPolicyLink;			/**< Reference to gizmo drawing policy link in scene */
 #endif // WITH_EDITOR
 
-	bool								bFlipVertical;					/**< Is need flip sprite by vertical */
-	bool								bFlipHorizontal;				/**< Is need flip sprite by horizontal */
-    ESpriteType							type;							/**< Sprite type */
-	SpriteRef_t							sprite;							/**< Sprite mesh */
+	bool								bIsDirtyInstance;				/**< Is need update instance in sprite batch, it's used only by the rendering thread */
+	SpriteRef_t							sprite;							/**< Sprite data */
+	SpriteBatchRef_t					spriteBatch;					/**< Sprite batch where sprite is drawn */
+	uint32								instanceId;						/**< ID of instance in sprite batch */
+	ESceneDepthGroup					SDGType;						/**< SDG where sprite is drawn */
 	DrawingPolicyLinkRef_t				drawingPolicyLink;				/**< Reference to drawing policy link in scene */
 	std::vector<const SMeshBatch*>		meshBatchLinks;					/**< Reference to mesh batch in drawing policy link */
 
@@ -39,12 +39,28 @@ public:
 	 */
 	virtual void Serialize( class CArchive& InArchive ) override;
 
+	/**
+	 * @brief Called when owner actor is returned to actor pool
+	 * @param InArchetype	Component with same class and index in never spawned actor of the same class, may be NULL
+	 */
+	virtual void ResetForPool( const CActorComponent* InArchetype ) override;
+
 	/**
 	 * @brief Adds mesh batches for draw in scene
 	 *
 	 * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Add geometry of primitive as occluder into occlusion buffer
+	 *
+	 * @param InOcclusionBuffer Occlusion buffer
+	 * @param InSceneProxy Scene proxy of primitive
+	 * @return Return TRUE if primitive is added as occluder, otherwise returns FALSE
 	 */
-	virtual void AddToDrawList( const class CSceneView& InSceneView ) override;
+	virtual bool AddOccluder( class COcclusionBuffer& InOcclusionBuffer, const class CPrimitiveSceneProxy& InSceneProxy ) override;
 
     /**
      * @brief Set material
@@ -56,7 +72,7 @@ public:
     {
         check( InIndex < overrideMaterials.size() );
 		overrideMaterials[ InIndex ] = InMaterial;
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Material );
     }
 
 	/**
@@ -73,7 +89,7 @@ public:
 				overrideMaterials.resize( staticMeshRef->GetNumMaterials() );
 			}
 		}
-		bIsDirtyDrawingPolicyLink = true;
+		MarkRenderStateDirty( SPU_Material );
 	}
 
 	/**
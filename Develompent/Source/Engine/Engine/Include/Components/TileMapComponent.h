@@ -0,0 +1,175 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAPCOMPONENT_H
+#define TILEMAPCOMPONENT_H
+
+#include <vector>
+
+#include "Misc/PhysicsGlobals.h"
+#include "System/PhysicsEngine.h"
+#include "Components/PrimitiveComponent.h"
+#include "Render/Scene.h"
+#include "Render/TileMap.h"
+
+#if ENABLE_HITPROXY
+#include "Render/SceneHitProxyRendering.h"
+#endif // ENABLE_HITPROXY
+
+ /**
+  * @ingroup Engine
+  * @brief Component for render tilemap by chunks and build its collision
+  */
+class CTileMapComponent : public CPrimitiveComponent
+{
+	DECLARE_CLASS( CTileMapComponent, CPrimitiveComponent )
+
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTileMapComponent();
+
+	/**
+	 * Begins Play for the component.
+	 * Called when the owning Actor begins play or when the component is created if the Actor has already begun play.
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * @brief Serialize component
+	 * @param[in] InArchive Archive for serialize
+	 */
+	virtual void Serialize( class CArchive& InArchive ) override;
+
+	/**
+	 * @brief Adds mesh batches of visible chunks for draw in scene
+	 *
+	 * @param InSceneView Current view of scene
+	 * @param InSceneProxy Scene proxy of primitive
+	 */
+	virtual void AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy ) override;
+
+	/**
+	 * @brief Update bound box of tilemap and its chunks
+	 */
+	virtual void UpdateBounds() override;
+
+	/**
+	 * @brief Update the body setup from solid tiles
+	 */
+	void UpdateBodySetup();
+
+	/**
+	 * @brief Set tilemap
+	 * @param InTileMap		Tilemap
+	 */
+	FORCEINLINE void SetTileMap( const TileMapRef_t& InTileMap )
+	{
+		tileMap						= InTileMap;
+		UpdateBounds();
+		MarkRenderStateDirty( SPU_Material | SPU_Transform );
+	}
+
+	/**
+	 * @brief Get tilemap
+	 * @return Return tilemap
+	 */
+	FORCEINLINE TileMapRef_t GetTileMap() const
+	{
+		return tileMap;
+	}
+
+	/**
+	 * @brief Set collision profile
+	 * @param InName Name of collision profile
+	 */
+	FORCEINLINE void SetCollisionProfile( const std::wstring& InName )
+	{
+		SCollisionProfile*		newCollisionProfile;
+		newCollisionProfile = GPhysicsEngine.FindCollisionProfile( InName );
+		if ( newCollisionProfile )
+		{
+			collisionProfile = newCollisionProfile;
+		}
+	}
+
+	/**
+	 * @brief Set physics material
+	 * @param InPhysMaterial Physics material
+	 */
+	FORCEINLINE void SetPhysMaterial( const TAssetHandle<CPhysicsMaterial>& InPhysMaterial )
+	{
+		physicsMaterial = InPhysMaterial.IsAssetValid() ? InPhysMaterial : GPhysicsEngine.GetDefaultPhysMaterial();
+	}
+
+	/**
+	 * @brief Get collision profile
+	 * @return Return collision profile
+	 */
+	FORCEINLINE SCollisionProfile* GetCollisionProfile() const
+	{
+		return collisionProfile;
+	}
+
+	/**
+	 * @brief Get physics material
+	 * @return Return physics material
+	 */
+	FORCEINLINE TAssetHandle<CPhysicsMaterial> GetPhysMaterial() const
+	{
+		return physicsMaterial;
+	}
+
+private:
+	/**
+	 * @brief Typedef of drawing policy link
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::SDrawingPolicyLink					DrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLinkRef_t				DrawingPolicyLinkRef_t;
+
+#if ENABLE_HITPROXY
+	/**
+	 * @brief Typedef of hit proxy drawing policy link
+	 */
+	typedef CMeshDrawList<CHitProxyDrawingPolicy, false>::SDrawingPolicyLink			HitProxyDrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on hit proxy drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CHitProxyDrawingPolicy, false>::DrawingPolicyLinkRef_t		HitProxyDrawingPolicyLinkRef_t;
+#endif // ENABLE_HITPROXY
+
+	/**
+	 * @brief Adds a draw policy link in SDGs
+	 */
+	virtual void LinkDrawList() override;
+
+	/**
+	 * @brief Removes a draw policy link from SDGs
+	 */
+	virtual void UnlinkDrawList() override;
+
+	TileMapRef_t								tileMap;						/**< Tilemap */
+	SCollisionProfile*							collisionProfile;				/**< Collision profile of solid tiles */
+	TAssetHandle<CPhysicsMaterial>				physicsMaterial;				/**< Physics material of solid tiles */
+	std::vector<CBox>							chunkBounds;					/**< Bound box of each chunk in world space */
+	std::vector<DrawingPolicyLinkRef_t>			drawingPolicyLinks;				/**< References to drawing policy links in scene, one per surface */
+	std::vector<const SMeshBatch*>				meshBatchLinks;					/**< References to mesh batches in drawing policy links */
+	std::vector<uint32>							chunkMeshBatchOffsets;			/**< Offset of first mesh batch link of each chunk in meshBatchLinks, last element is number of links */
+
+#if ENABLE_HITPROXY
+	std::vector<HitProxyDrawingPolicyLinkRef_t>	hitProxyDrawingPolicyLinks;		/**< References to hit proxy drawing policy links in scene */
+#endif // ENABLE_HITPROXY
+};
+
+#endif // !TILEMAPCOMPONENT_H
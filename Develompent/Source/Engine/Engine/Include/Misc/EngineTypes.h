@@ -10,6 +10,7 @@
 #define ENGINETYPES_H
 
 #include "Misc/RefCountPtr.h"
+#include "Containers/SlotMap.h"
 
 /**
  * @ingroup Engine Engine
@@ -23,4 +24,10 @@ typedef TRefCountPtr< class CActorComponent >			ActorComponentRef_t;
  */
 typedef TRefCountPtr< class AActor >					ActorRef_t;
 
+/**
+ * @ingroup Engine Engine
+ * @brief Generational handle of actor in world, becomes invalid after destroying actor
+ */
+typedef SSlotHandle										ActorHandle_t;
+
 #endif // !ENGINETYPES_H
\ No newline at end of file
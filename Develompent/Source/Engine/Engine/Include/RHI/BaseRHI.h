@@ -37,6 +37,32 @@ enum EPrimitiveType
 	PT_Num					/**< Count primitives */
 };
 
+/**
+ * @ingroup Engine
+ * @brief Statistics of shader constants
+ */
+struct SConstantBufferStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SConstantBufferStats()
+		: numUpdates( 0 )
+		, numRedundantUpdates( 0 )
+		, numUploads( 0 )
+		, numSkippedUploads( 0 )
+		, numDirtyBytes( 0 )
+		, numUploadedBytes( 0 )
+	{}
+
+	uint32		numUpdates;				/**< Number of shader parameter updates */
+	uint32		numRedundantUpdates;	/**< Number of updates with the same value as in buffer, they don't dirty buffer */
+	uint32		numUploads;				/**< Number of uploads of constant buffers to GPU */
+	uint32		numSkippedUploads;		/**< Number of commits of not changed constant buffers, they aren't uploaded */
+	uint64		numDirtyBytes;			/**< Number of changed bytes of uploaded buffers */
+	uint64		numUploadedBytes;		/**< Number of bytes uploaded to GPU */
+};
+
 /**
  * @ingroup Engine
  * @brief Base class of RHI
@@ -333,6 +359,12 @@ public:
 	 * @param[in] InDeviceContext Device context
 	 */
 	virtual void								EndDrawEvent( class CBaseDeviceContextRHI* InDeviceContext ) {}
+
+	/**
+	 * @brief Is frame capture tool attached
+	 * @return Return TRUE if frame capture tool (e.g. RenderDoc or PIX) is attached to application, otherwise returns FALSE
+	 */
+	virtual bool								IsFrameCaptureToolAttached() const { return false; }
 #endif // FRAME_CAPTURE_MARKERS
 
 	/**
@@ -442,7 +474,13 @@ public:
 	 * @param[in] InNumBytes Number bytes of parameter
 	 * @param[in] InNewValue New value
 	 */
-	virtual void								SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue ) {}
+	virtual void								SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+	{
+		// Null RHI hasn't constant buffers, each update is counted as upload
+		++constantBufferStats.numUpdates;
+		++constantBufferStats.numUploads;
+		constantBufferStats.numUploadedBytes += InNumBytes;
+	}
 
 	/**
 	 * Set pixel shader parameter
@@ -453,7 +491,13 @@ public:
 	 * @param[in] InNumBytes Number bytes of parameter
 	 * @param[in] InNewValue New value
 	 */
-	virtual void								SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue ) {}
+	virtual void								SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+	{
+		// Null RHI hasn't constant buffers, each update is counted as upload
+		++constantBufferStats.numUpdates;
+		++constantBufferStats.numUploads;
+		constantBufferStats.numUploadedBytes += InNumBytes;
+	}
 
 	/**
 	 * Set depth test
@@ -494,8 +538,9 @@ public:
 	 * @param[in] InSize Size
 	 * @param[in] InOffset Offset in buffer
 	 * @param[out] OutLockedData Locked data in buffer	 
+	 * @param[in] InIsNoOverwrite Write without overwriting data which GPU may still use, content of buffer is kept. Otherwise the whole buffer is discarded
 	 */
-	virtual void								LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData ) {}
+	virtual void								LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData, bool InIsNoOverwrite = false ) {}
 
 	/**
 	 * @brief Unlock vertex buffer
@@ -506,6 +551,18 @@ public:
 	 */
 	virtual void								UnlockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, SLockedData& InLockedData ) {}
 
+	/**
+	 * @brief Update region of vertex buffer
+	 * @note Unlike LockVertexBuffer content of buffer out of region is kept, so buffer must be created without RUF_Dynamic
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InVertexBuffer Pointer to vertex buffer
+	 * @param[in] InOffset Offset of region in buffer
+	 * @param[in] InSize Size of region
+	 * @param[in] InData New data of region
+	 */
+	virtual void								UpdateVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InOffset, uint32 InSize, const void* InData ) {}
+
 	/**
 	 * @brief Lock index buffer
 	 * 
@@ -514,8 +571,9 @@ public:
 	 * @param[in] InSize Size
 	 * @param[in] InOffset Offset in buffer
 	 * @param[out] OutLockedData Locked data in buffer
+	 * @param[in] InIsNoOverwrite Write without overwriting data which GPU may still use, content of buffer is kept. Otherwise the whole buffer is discarded
 	 */
-	virtual void								LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData ) {}
+	virtual void								LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData, bool InIsNoOverwrite = false ) {}
 
 	/**
 	 * @brief Unlock index buffer
@@ -639,6 +697,32 @@ public:
 	 * @return Return viewport height
 	 */
 	virtual uint32								GetViewportHeight() const		{ return 0; }
+
+	/**
+	 * @brief Get statistics of shader constants
+	 * @return Return statistics of shader constants since last reset
+	 */
+	FORCEINLINE const SConstantBufferStats&		GetConstantBufferStats() const	{ return constantBufferStats; }
+
+	/**
+	 * @brief Get statistics of shader constants in last frame
+	 * @return Return statistics of shader constants between two last resets
+	 */
+	FORCEINLINE const SConstantBufferStats&		GetLastFrameConstantBufferStats() const	{ return lastFrameConstantBufferStats; }
+
+	/**
+	 * @brief Reset statistics of shader constants
+	 * @note Must be called only in render thread at begin of frame, current statistics are kept as statistics of last frame
+	 */
+	FORCEINLINE void							ResetConstantBufferStats()
+	{
+		lastFrameConstantBufferStats	= constantBufferStats;
+		constantBufferStats				= SConstantBufferStats();
+	}
+
+protected:
+	SConstantBufferStats						constantBufferStats;			/**< Statistics of shader constants */
+	SConstantBufferStats						lastFrameConstantBufferStats;	/**< Statistics of shader constants in last frame */
 };
 
 #endif // !BASERHI_H
@@ -35,6 +35,7 @@ enum EPixelFormat
 	PF_BC5,						/**< BC5 compression format */
 	PF_BC6H,					/**< BC6 compression format */
 	PF_BC7,						/**< BC7 compression format */
+	PF_A32B32G32R32F,			/**< RGBA with float 32 bit per channel */
 	PF_Max						/**< Max count pixel formats */
 };
 
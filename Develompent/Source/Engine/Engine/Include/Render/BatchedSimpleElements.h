@@ -14,7 +14,10 @@
 #include "Math/Math.h"
 #include "Math/Color.h"
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
+#include "Render/RenderResource.h"
+#include "Render/RenderUtils.h"
 #include "Render/HitProxies.h"
+#include "RHI/BaseBufferRHI.h"
 #include "LEBuild.h"
 
 /**
@@ -63,12 +66,7 @@ public:
 		{
 			uint32		oldSize = thickLines.size();
 			thickLines.resize( oldSize + 1 );
-
-			SBatchedThickLines&		thickLine = thickLines[ oldSize ];
-			thickLine.start			= InStart;
-			thickLine.end			= InEnd;
-			thickLine.thickness		= InThickness;
-			thickLine.color			= InColor;
+			thickLines[ oldSize ]	= SSimpleElementThickLineType{ Vector4D( InStart, InThickness ), Vector4D( InEnd, 1.f ), InColor };
 		}
 	}
 
@@ -99,19 +97,66 @@ public:
 	void Draw( class CBaseDeviceContextRHI* InDeviceContext, const class CSceneView& InSceneView ) const;
 
 protected:
+	std::vector<SSimpleElementVertexType>		lineVerteces;		/**< Array of line verteces */
+	std::vector<SSimpleElementThickLineType>	thickLines;			/**< Array of thick line instances */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Ring vertex buffer for drawing batched simple elements
+ *
+ * Data is written after previous one with no-overwrite lock. When the buffer is full it's discarded
+ * and writing begins from start, the driver keeps old memory while frames in flight use it
+ */
+class CSimpleElementBuffer : public CRenderResource
+{
+public:
 	/**
-	 * @brief Struct of batched thick lines
+	 * @brief Constructor
+	 */
+	CSimpleElementBuffer();
+
+	/**
+	 * @brief Write data into buffer
+	 * @note Must be called only in render thread
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 * @param InData				Data
+	 * @param InSize				Size of data in bytes
+	 * @return Return offset of data in buffer
 	 */
-	struct SBatchedThickLines
+	uint32 Write( class CBaseDeviceContextRHI* InDeviceContextRHI, const void* InData, uint32 InSize );
+
+	/**
+	 * @brief Get vertex buffer RHI
+	 * @return Return vertex buffer RHI
+	 */
+	FORCEINLINE VertexBufferRHIRef_t GetVertexBufferRHI() const
 	{
-		Vector		start;		/**< Start line */
-		Vector		end;		/**< End line */
-		float		thickness;	/**< Thickness */
-		CColor		color;		/**< Color */
-	};
+		return vertexBufferRHI;
+	}
 
-	std::vector<SSimpleElementVertexType>		lineVerteces;		/**< Array of line verteces */
-	std::vector<SBatchedThickLines>				thickLines;			/**< Array of thick lines */
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	VertexBufferRHIRef_t		vertexBufferRHI;	/**< Vertex buffer RHI */
+	uint32						size;				/**< Size of buffer in bytes */
+	uint32						cursor;				/**< Offset of free space in buffer */
 };
 
+extern TGlobalResource<CSimpleElementBuffer>		GSimpleElementBuffer;		/**< The global buffer of batched simple elements */
+
 #endif // !BATCHEDSIMPLEELEMENTS_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef DEPTHRENDERING_H
+#define DEPTHRENDERING_H
+
+#include "Math/Box.h"
+#include "DrawingPolicy.h"
+#include "Render/Shaders/DepthOnlyShader.h"
+
+/**
+ * @ingroup Engine
+ * @brief Settings of depth prepass
+ */
+struct SDepthPrepassSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	SDepthPrepassSettings();
+
+	/**
+	 * @brief Is all static meshes drawn in depth prepass
+	 * @return Return TRUE if all static meshes are occluders, in this case GBuffer pass tests depth for equality without writing it
+	 */
+	FORCEINLINE bool IsAllOccluders() const
+	{
+		return minScreenRadius <= 0.f;
+	}
+
+	bool		bEnable;			/**< Is enabled depth prepass */
+	float		minScreenRadius;	/**< Min radius of bounds on screen (1 is half of screen height) for primitive to be drawn in depth prepass */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Get settings of depth prepass
+ * @note Settings are read from config on first call
+ * 
+ * @return Return settings of depth prepass
+ */
+const SDepthPrepassSettings& GetDepthPrepassSettings();
+
+/**
+ * @ingroup Engine
+ * @brief Is primitive good occluder for depth prepass
+ * @note Small on screen primitives are skipped, they cost more in prepass than they save in GBuffer pass
+ * 
+ * @param InSceneView	Scene view
+ * @param InBoundBox	Bound box of primitive in world space
+ * @return Return TRUE if primitive must be drawn in depth prepass, otherwise returns FALSE
+ */
+bool IsDepthPrepassOccluder( const class CSceneView& InSceneView, const CBox& InBoundBox );
+
+/**
+ * @ingroup Engine
+ * Draw policy of depth only rendering
+ */
+class CDepthOnlyDrawingPolicy : public CMeshDrawingPolicy
+{
+public:
+	/**
+	 * Initialize mesh drawing policy
+	 *
+	 * @param InVertexFactory	Vertex factory with position only stream
+	 * @param InMaterial		Material, it's used only for rasterizer state
+	 * @param InDepthBias		Depth bias
+	 */
+	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const TAssetHandle<CMaterial>& InMaterial, float InDepthBias = 0.f )
+	{
+		InitInternal( InVertexFactory, InMaterial, InDepthBias );
+
+		// Override shaders for depth only rendering
+		uint64			vertexFactoryHash = InVertexFactory->GetType()->GetHash();
+		vertexShader	= GShaderManager->FindInstance<CDepthOnlyVertexShader>( vertexFactoryHash );
+		pixelShader		= GShaderManager->FindInstance<CDepthOnlyPixelShader>( vertexFactoryHash );
+
+		// Shaders don't depend on material, so all surfaces of one vertex factory with the same rasterizer state are drawn by one drawing policy
+		const SRasterizerStateInitializerRHI	rasterizerState = GetRasterizerStateInitializer();
+		hash			= appMemFastHash( InVertexFactory, appMemFastHash( rasterizerState.fillMode, appMemFastHash( rasterizerState.cullMode ) ) );
+		InitPipelineState();
+	}
+};
+
+#endif // !DEPTHRENDERING_H
@@ -11,6 +11,7 @@
 
 #include "Misc/RefCountPtr.h"
 #include "Render/Material.h"
+#include "Render/PipelineState.h"
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Core.h"
 
@@ -43,6 +44,7 @@ public:
 	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const TAssetHandle<CMaterial>& InMaterial, float InDepthBias = 0.f )
 	{
 		InitInternal( InVertexFactory, InMaterial, InDepthBias );
+		InitPipelineState();
 	}
 
 	/**
@@ -60,16 +62,19 @@ public:
 	virtual void SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI );
 
 	/**
-	 * @brief Get bound shader state
-	 * @return Return bound shader state of current drawing policy
+	 * @brief Get rasterizer state initializer
+	 * @return Return initializer of rasterizer state of current drawing policy
 	 */
-	virtual BoundShaderStateRHIRef_t GetBoundShaderState() const;
+	virtual SRasterizerStateInitializerRHI GetRasterizerStateInitializer() const;
 
 	/**
-	 * @brief Get rasterizer state
-	 * @return Return rasterizer state of current drawing policy 
+	 * @brief Get pipeline state
+	 * @return Return pipeline state of current drawing policy, if it isn't created yet returns nullptr
 	 */
-	virtual RasterizerStateRHIRef_t GetRasterizerState() const;
+	FORCEINLINE PipelineStateRef_t GetPipelineState() const
+	{
+		return pipelineState;
+	}
 
 	/**
 	 * Draw mesh
@@ -136,6 +141,13 @@ protected:
 	 */
 	virtual void InitInternal( class CVertexFactory* InVertexFactory, const TAssetHandle<CMaterial>& InMaterial, float InDepthBias = 0.f );
 
+	/**
+	 * @brief Initialize pipeline state from shaders, vertex factory and rasterizer state
+	 * @note Child classes which override shaders must call it after that. If vertex declaration of vertex factory isn't initialized yet,
+	 * pipeline state will be taken from cache on first SetRenderState
+	 */
+	void InitPipelineState();
+
 	bool								bInit;				/**< Is inited drawing policy */
 	TAssetHandle<CMaterial>				material;			/**< Material */
 	VertexFactoryRef_t					vertexFactory;		/**< Vertex factory */
@@ -143,9 +155,7 @@ protected:
 	CShader*							pixelShader;		/**< Pixel shader */
 	float								depthBias;			/**< Depth bias */
 	uint64								hash;				/**< Hash */
-
-	mutable BoundShaderStateRHIRef_t	boundShaderState;	/**< Bound shader state */
-	mutable RasterizerStateRHIRef_t		rasterizerState;	/**< Rasterizer state */
+	PipelineStateRef_t					pipelineState;		/**< Pipeline state */
 };
 
 #endif // !DRAWINGPOLICY_H
\ No newline at end of file
@@ -0,0 +1,178 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef DYNAMICMESHBUFFER_H
+#define DYNAMICMESHBUFFER_H
+
+#include "Misc/RefCountPtr.h"
+#include "Render/RenderResource.h"
+#include "Render/RenderUtils.h"
+#include "Render/VertexFactory/DynamicMeshVertexFactory.h"
+#include "RHI/BaseBufferRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of dynamic mesh buffer for one frame
+ */
+struct SDynamicMeshBufferStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SDynamicMeshBufferStats()
+		: numAllocations( 0 )
+		, numVertexBytes( 0 )
+		, numIndexBytes( 0 )
+		, numDiscards( 0 )
+		, numReallocations( 0 )
+		, vertexBufferSize( 0 )
+		, indexBufferSize( 0 )
+	{}
+
+	uint32		numAllocations;		/**< Number of sub-allocations */
+	uint32		numVertexBytes;		/**< Number of bytes written into vertex buffer */
+	uint32		numIndexBytes;		/**< Number of bytes written into index buffer */
+	uint32		numDiscards;		/**< Number of discards when buffers were wrapped */
+	uint32		numReallocations;	/**< Number of recreations of buffers because they were too small */
+	uint32		vertexBufferSize;	/**< Size of vertex buffer in bytes */
+	uint32		indexBufferSize;	/**< Size of index buffer in bytes */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Sub-allocation of dynamic mesh in dynamic mesh buffer
+ */
+struct SDynamicMeshAllocation
+{
+	/**
+	 * @brief Constructor
+	 */
+	SDynamicMeshAllocation()
+		: baseVertexIndex( 0 )
+		, firstIndex( 0 )
+		, generation( 0 )
+	{}
+
+	uint32		baseVertexIndex;	/**< Index of first vertex in vertex buffer */
+	uint32		firstIndex;			/**< Index of first index in index buffer */
+	uint32		generation;			/**< Generation of buffers when data was written, 0 is not allocated */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Global ring buffers of verteces and indeces for dynamic meshes
+ *
+ * Data of each mesh is written after previous one with no-overwrite lock, so data in use by GPU isn't touched.
+ * When the buffer is full it's discarded and writing begins from start, the driver gives new memory
+ * while old one is still used by frames in flight. Discard increases generation of buffers and allocations of
+ * older generations must be written again before drawing
+ */
+class CDynamicMeshBuffer : public CRenderResource
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CDynamicMeshBuffer();
+
+	/**
+	 * @brief Begin new frame
+	 * @note Must be called only in render thread
+	 */
+	void BeginFrame();
+
+	/**
+	 * @brief Allocate region in buffers and write mesh into it
+	 * @note Must be called only in render thread
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 * @param InVerteces			Verteces
+	 * @param InNumVerteces			Number of verteces
+	 * @param InIndeces				Indeces
+	 * @param InNumIndeces			Number of indeces
+	 * @param OutAllocation			Output allocation of mesh
+	 */
+	void Allocate( class CBaseDeviceContextRHI* InDeviceContextRHI, const SDynamicMeshVertexType* InVerteces, uint32 InNumVerteces, const uint32* InIndeces, uint32 InNumIndeces, SDynamicMeshAllocation& OutAllocation );
+
+	/**
+	 * @brief Is valid allocation
+	 *
+	 * @param InAllocation	Allocation
+	 * @return Return TRUE if data of allocation is still in buffers, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsValidAllocation( const SDynamicMeshAllocation& InAllocation ) const
+	{
+		return InAllocation.generation != 0 && InAllocation.generation == generation;
+	}
+
+	/**
+	 * @brief Get vertex factory
+	 * @return Return vertex factory with vertex buffer of dynamic meshes
+	 */
+	FORCEINLINE TRefCountPtr<CDynamicMeshVertexFactory> GetVertexFactory() const
+	{
+		return vertexFactory;
+	}
+
+	/**
+	 * @brief Get index buffer RHI
+	 * @return Return index buffer of dynamic meshes
+	 */
+	FORCEINLINE IndexBufferRHIRef_t GetIndexBufferRHI() const
+	{
+		return indexBufferRHI;
+	}
+
+	/**
+	 * @brief Get statistics of last finished frame
+	 * @return Return statistics of last finished frame
+	 */
+	FORCEINLINE const SDynamicMeshBufferStats& GetLastFrameStats() const
+	{
+		return lastFrameStats;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	/**
+	 * @brief Create buffers
+	 *
+	 * @param InNumVerteces		Max number of verteces in vertex buffer
+	 * @param InNumIndeces		Max number of indeces in index buffer
+	 */
+	void CreateBuffers( uint32 InNumVerteces, uint32 InNumIndeces );
+
+	VertexBufferRHIRef_t						vertexBufferRHI;	/**< Vertex buffer RHI */
+	IndexBufferRHIRef_t							indexBufferRHI;		/**< Index buffer RHI */
+	TRefCountPtr<CDynamicMeshVertexFactory>		vertexFactory;		/**< Vertex factory with vertex buffer in 0 stream */
+	uint32										maxVerteces;		/**< Max number of verteces in vertex buffer */
+	uint32										maxIndeces;			/**< Max number of indeces in index buffer */
+	uint32										vertexCursor;		/**< Index of first free vertex */
+	uint32										indexCursor;		/**< Index of first free index */
+	uint32										generation;			/**< Generation of buffers, increases on each discard and recreation */
+	SDynamicMeshBufferStats						stats;				/**< Statistics of current frame */
+	SDynamicMeshBufferStats						lastFrameStats;		/**< Statistics of last finished frame */
+};
+
+extern TGlobalResource<CDynamicMeshBuffer>		GDynamicMeshBuffer;		/**< The global buffer of dynamic meshes */
+
+#endif // !DYNAMICMESHBUFFER_H
@@ -16,6 +16,7 @@
 #include "System/ThreadingBase.h"
 #include "Render/Material.h"
 #include "Render/VertexFactory/DynamicMeshVertexFactory.h"
+#include "Render/DynamicMeshBuffer.h"
 #include "Render/RenderResource.h"
 #include "Render/DrawingPolicy.h"
 #include "Render/HitProxies.h"
@@ -30,6 +31,9 @@ typedef TRefCountPtr< class CDynamicMeshBuilder >			DynamicMeshBuilderRef_t;
 /**
  * @ingroup Engine
  * @brief Class for build and draw dynamic mesh
+ *
+ * Mesh doesn't own RHI buffers, it's sub-allocated in GDynamicMeshBuffer. Source data is kept
+ * for writing mesh again when the global buffer was discarded since last draw
  */
 class CDynamicMeshBuilder : public CRenderResource, public CRefCounted
 {
@@ -98,10 +102,10 @@ public:
 	template<typename TDrawingPolicyType>
 	FORCEINLINE void Draw( class CBaseDeviceContextRHI* InDeviceContextRHI, const Matrix& InLocalToWorld, const TAssetHandle<CMaterial>& InMaterial, const class CSceneView& InSceneView ) const
 	{
-		checkMsg( vertexFactory && vertexBufferRHI, TEXT( "Before draw dynamic mesh need call CDynamicMeshBuilder::Build" ) );
+		checkMsg( IsInitialized(), TEXT( "Before draw dynamic mesh need call CDynamicMeshBuilder::Build" ) );
 
 		TDrawingPolicyType		drawingPolicy;
-		drawingPolicy.Init( vertexFactory, InMaterial );
+		drawingPolicy.Init( GDynamicMeshBuffer.GetVertexFactory(), InMaterial );
 		if ( drawingPolicy.IsValid() )
 		{
 			Draw( InDeviceContextRHI, InLocalToWorld, InMaterial, drawingPolicy, InSceneView );
@@ -172,13 +176,18 @@ private:
 	 */
 	virtual void ReleaseRHI() override;
 
+	/**
+	 * @brief Write mesh into global dynamic mesh buffer if it isn't there
+	 * @param InDeviceContextRHI	RHI device context
+	 * @return Return TRUE if mesh is in buffer, otherwise returns FALSE
+	 */
+	bool AllocateMesh( class CBaseDeviceContextRHI* InDeviceContextRHI ) const;
+
 	uint32										numPrimitives;		/**< Number primitives in builded mesh */
-	CCriticalSection							readWriteCS;		/**< Read and write critical section */
+	mutable CCriticalSection					readWriteCS;		/**< Read and write critical section */
 	std::vector< SDynamicMeshVertexType >		verteces;			/**< Array of verteces */
 	std::vector< uint32 >						indeces;			/**< Array of indeces */
-	VertexBufferRHIRef_t						vertexBufferRHI;	/**< Vertex buffer RHI */
-	IndexBufferRHIRef_t							indexBufferRHI;		/**< Index buffer RHI */
-	TRefCountPtr< CDynamicMeshVertexFactory >	vertexFactory;		/**< Vertex factory */
+	mutable SDynamicMeshAllocation				allocation;			/**< Allocation of mesh in GDynamicMeshBuffer */
 
 #if WITH_EDITOR
 	CHitProxyId									hitProxyId;			/**< Hit proxy Id */
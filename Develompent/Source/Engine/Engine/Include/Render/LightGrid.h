@@ -0,0 +1,322 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef LIGHTGRID_H
+#define LIGHTGRID_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+#include "RenderResource.h"
+#include "RenderUtils.h"
+#include "RHI/BaseSurfaceRHI.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Width in texels of light grid textures, data of light grid is stored in them row by row
+ */
+#define LIGHTGRID_TEXTURE_WIDTH		1024
+
+/**
+ * @ingroup Engine
+ * @brief Number of texels in light data texture per one light
+ */
+#define LIGHTGRID_TEXELS_PER_LIGHT	3
+
+/**
+ * @ingroup Engine
+ * @brief Light for binning in light grid
+ */
+struct SLightGridLight
+{
+	/**
+	 * @brief Constructor
+	 */
+	SLightGridLight()
+		: position( 0.f, 0.f, 0.f )
+		, radius( 0.f )
+		, color( 0.f, 0.f, 0.f )
+		, direction( 0.f, 0.f, 1.f )
+		, cosInnerCone( -1.f )
+		, cosOuterCone( -2.f )
+	{}
+
+	/**
+	 * @brief Is spot light
+	 * @return Return TRUE if light has cone, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsSpotLight() const
+	{
+		return cosOuterCone > -1.f;
+	}
+
+	Vector		position;			/**< Position in world space */
+	float		radius;				/**< Radius */
+	Vector		color;				/**< Color multiplied by intensivity */
+	Vector		direction;			/**< Direction of spot light in world space */
+	float		cosInnerCone;		/**< Cosine of inner cone angle, for point light is -1 */
+	float		cosOuterCone;		/**< Cosine of outer cone angle, for point light is -2 */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Settings of light grid
+ */
+struct SLightGridSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	SLightGridSettings()
+		: bEnable( true )
+		, numClustersX( 16 )
+		, numClustersY( 9 )
+		, numClustersZ( 24 )
+	{}
+
+	/**
+	 * @brief Load settings from engine config
+	 */
+	void LoadFromConfig();
+
+	bool		bEnable;			/**< Is enabled clustered lighting */
+	uint32		numClustersX;		/**< Number of clusters by screen X */
+	uint32		numClustersY;		/**< Number of clusters by screen Y */
+	uint32		numClustersZ;		/**< Number of clusters by view depth */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Clustered light grid of view
+ *
+ * View frustum is split into clusters (froxels): tiles on screen and exponential slices by depth.
+ * Lights are binned into clusters on CPU with sphere and cone tests, per cluster compact lists of light indeces
+ * are uploaded once per frame into textures, so lighting pass shades each pixel only by lights of its cluster
+ */
+class CLightGrid : public CRenderResource
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CLightGrid();
+
+	/**
+	 * @brief Set settings
+	 * @param InSettings	Settings of light grid
+	 */
+	FORCEINLINE void SetSettings( const SLightGridSettings& InSettings )
+	{
+		settings = InSettings;
+		check( settings.numClustersX > 0 && settings.numClustersY > 0 && settings.numClustersZ > 0 );
+	}
+
+	/**
+	 * @brief Bin lights into clusters of view
+	 * Doesn't touch RHI, so it may be called without render device
+	 *
+	 * @param InViewMatrix			View matrix
+	 * @param InProjectionMatrix	Projection matrix
+	 * @param InLights				Lights of view
+	 */
+	void Build( const Matrix& InViewMatrix, const Matrix& InProjectionMatrix, const std::vector<SLightGridLight>& InLights );
+
+	/**
+	 * @brief Upload built light grid to textures
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 */
+	void UpdateRHI( class CBaseDeviceContextRHI* InDeviceContextRHI );
+
+	/**
+	 * @brief Get settings
+	 * @return Return settings of light grid
+	 */
+	FORCEINLINE const SLightGridSettings& GetSettings() const
+	{
+		return settings;
+	}
+
+	/**
+	 * @brief Get size of grid
+	 * @return Return number of clusters by X, Y and Z, in W is number of lights in grid
+	 */
+	FORCEINLINE Vector4D GetGridSize() const
+	{
+		return Vector4D( settings.numClustersX, settings.numClustersY, settings.numClustersZ, GetNumLights() );
+	}
+
+	/**
+	 * @brief Get depth parameters of grid
+	 * Slice of view depth is 'log( ( depth - X ) * Y + 1 ) * Z'
+	 *
+	 * @return Return near depth of grid, inverse scale of depth and scale of slices
+	 */
+	FORCEINLINE Vector4D GetDepthParams() const
+	{
+		return Vector4D( gridNearDepth, 1.f / depthScale, sliceScale, 0.f );
+	}
+
+	/**
+	 * @brief Get number of lights in grid
+	 * @return Return number of lights in grid
+	 */
+	FORCEINLINE uint32 GetNumLights() const
+	{
+		return ( uint32 )lightData.size() / ( LIGHTGRID_TEXELS_PER_LIGHT * 4 );
+	}
+
+	/**
+	 * @brief Get number of light indeces in all clusters
+	 * @return Return number of light indeces in all clusters
+	 */
+	FORCEINLINE uint32 GetNumLightIndeces() const
+	{
+		return ( uint32 )lightIndeces.size();
+	}
+
+	/**
+	 * @brief Get data of clusters
+	 * @return Return offset and number of light indeces of each cluster
+	 */
+	FORCEINLINE const std::vector<float>& GetClusterData() const
+	{
+		return clusterData;
+	}
+
+	/**
+	 * @brief Get RHI texture of clusters
+	 * @return Return RHI texture with offset and number of light indeces of each cluster
+	 */
+	FORCEINLINE Texture2DRHIRef_t GetClusterTextureRHI() const
+	{
+		return clusterTextureRHI;
+	}
+
+	/**
+	 * @brief Get RHI texture of light indeces
+	 * @return Return RHI texture with light indeces of all clusters
+	 */
+	FORCEINLINE Texture2DRHIRef_t GetLightIndexTextureRHI() const
+	{
+		return lightIndexTextureRHI;
+	}
+
+	/**
+	 * @brief Get RHI texture of lights
+	 * @return Return RHI texture with data of lights
+	 */
+	FORCEINLINE Texture2DRHIRef_t GetLightDataTextureRHI() const
+	{
+		return lightDataTextureRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	/**
+	 * @brief Light in view space
+	 */
+	struct SViewLight
+	{
+		Vector		position;		/**< Position in view space */
+		float		radius;			/**< Radius */
+		Vector		direction;		/**< Direction of spot light in view space */
+		float		cosOuterCone;	/**< Cosine of outer cone angle */
+		float		sinOuterCone;	/**< Sine of outer cone angle */
+		float		depth;			/**< View depth of position */
+		bool		bSpotLight;		/**< Is spot light */
+	};
+
+	/**
+	 * @brief Get slice of view depth
+	 *
+	 * @param InDepth	View depth
+	 * @return Return slice, it's may be out of grid
+	 */
+	FORCEINLINE int32 GetSlice( float InDepth ) const
+	{
+		return ( int32 )SMath::Floor( SMath::Loge( Max( InDepth - gridNearDepth, 0.f ) / depthScale + 1.f ) * sliceScale );
+	}
+
+	/**
+	 * @brief Get view depth of slice start
+	 *
+	 * @param InSlice	Slice
+	 * @return Return view depth where slice begins
+	 */
+	FORCEINLINE float GetSliceDepth( uint32 InSlice ) const
+	{
+		return gridNearDepth + ( SMath::Exp( InSlice / sliceScale ) - 1.f ) * depthScale;
+	}
+
+	/**
+	 * @brief Build bounds of clusters in view space
+	 * @param InInvProjectionMatrix		Inverse projection matrix
+	 */
+	void BuildClusterBounds( const Matrix& InInvProjectionMatrix );
+
+	/**
+	 * @brief Is light intersects cluster
+	 *
+	 * @param InLight			Light in view space
+	 * @param InClusterIndex	Index of cluster
+	 * @return Return TRUE if light intersects cluster, otherwise returns FALSE
+	 */
+	bool IsLightInCluster( const SViewLight& InLight, uint32 InClusterIndex ) const;
+
+	/**
+	 * @brief Upload data into texture, texture is recreated if it's too small
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 * @param InDebugName			Debug name of texture
+	 * @param InFormat				Pixel format of texture
+	 * @param InData				Data, one float per channel of texel
+	 * @param InNumTexels			Number of texels in data
+	 * @param InOutTextureRHI		RHI texture
+	 */
+	void UploadTexture( class CBaseDeviceContextRHI* InDeviceContextRHI, const tchar* InDebugName, EPixelFormat InFormat, const float* InData, uint32 InNumTexels, Texture2DRHIRef_t& InOutTextureRHI );
+
+	SLightGridSettings			settings;				/**< Settings */
+	float						gridNearDepth;			/**< View depth where the grid begins */
+	float						depthScale;				/**< Scale of depth in slice function */
+	float						sliceScale;				/**< Scale of slices in slice function */
+	std::vector<Vector>			cornerRayOrigins;		/**< Origins of rays through corners of tiles in view space */
+	std::vector<Vector>			cornerRayDirections;	/**< Directions of rays through corners of tiles in view space, length is one unit of view depth */
+	std::vector<CBox>			clusterBounds;			/**< Bounds of clusters in view space */
+	std::vector<SViewLight>		viewLights;				/**< Lights in view space */
+	std::vector<uint32>			lightClusters;			/**< Clusters of all lights one by one */
+	std::vector<uint32>			lightClusterOffsets;	/**< Offset of first cluster of each light in lightClusters, last element is size of lightClusters */
+	std::vector<uint32>			clusterCursors;			/**< Cursors of clusters for fill light indeces */
+	std::vector<float>			clusterData;			/**< Offset and number of light indeces of each cluster */
+	std::vector<float>			lightIndeces;			/**< Light indeces of all clusters */
+	std::vector<float>			lightData;				/**< Data of lights, LIGHTGRID_TEXELS_PER_LIGHT texels per light */
+	Texture2DRHIRef_t			clusterTextureRHI;		/**< RHI texture of clusters */
+	Texture2DRHIRef_t			lightIndexTextureRHI;	/**< RHI texture of light indeces */
+	Texture2DRHIRef_t			lightDataTextureRHI;	/**< RHI texture of lights */
+};
+
+extern TGlobalResource<CLightGrid>		GLightGrid;		/**< The global light grid of rendering view */
+
+#endif // !LIGHTGRID_H
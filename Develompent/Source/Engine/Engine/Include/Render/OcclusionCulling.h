@@ -0,0 +1,247 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef OCCLUSIONCULLING_H
+#define OCCLUSIONCULLING_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+#include "Render/RenderResource.h"
+#include "Render/RenderUtils.h"
+
+/**
+ * @ingroup Engine
+ * @brief Settings of occlusion culling
+ */
+struct SOcclusionCullingSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	SOcclusionCullingSettings()
+		: bEnable( true )
+		, sizeX( 256 )
+		, sizeY( 128 )
+		, maxOccluders( 32 )
+		, maxOccluderTriangles( 16384 )
+		, maxMeshTriangles( 2048 )
+		, minOccluderScreenRadius( 0.2f )
+	{}
+
+	/**
+	 * @brief Load settings from engine config
+	 */
+	void LoadFromConfig();
+
+	bool		bEnable;					/**< Is enabled occlusion culling */
+	uint32		sizeX;						/**< Width of depth buffer, must be multiple of 4 */
+	uint32		sizeY;						/**< Height of depth buffer */
+	uint32		maxOccluders;				/**< Max number of occluders per view */
+	uint32		maxOccluderTriangles;		/**< Max number of triangles of all occluders per view */
+	uint32		maxMeshTriangles;			/**< Max number of triangles in mesh to be occluder, only such meshes keep copy of geometry on CPU */
+	float		minOccluderScreenRadius;	/**< Min radius of primitive bounds on screen (1 is half of screen height) to be occluder */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of occlusion culling for one view
+ */
+struct SOcclusionCullingStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SOcclusionCullingStats()
+		: numOccluders( 0 )
+		, numOccluderTriangles( 0 )
+		, numTestedPrimitives( 0 )
+		, numCulledPrimitives( 0 )
+	{}
+
+	uint32		numOccluders;				/**< Number of added occluders */
+	uint32		numOccluderTriangles;		/**< Number of rasterized triangles */
+	uint32		numTestedPrimitives;		/**< Number of tested bounds */
+	uint32		numCulledPrimitives;		/**< Number of occluded bounds */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Software occlusion buffer of view
+ *
+ * Few big occluders are rasterized on CPU into low resolution depth buffer, rows of buffer are split into bands
+ * which are rasterized in parallel, each band processes four pixels at once with SSE when WITH_SIMD_MATH is 1.
+ * Depth of occluders is conservative, each pixel stores the farthest depth of triangle inside of pixel.
+ * From the buffer hierarchical depth pyramid is built where each texel is max depth of four texels of previous level,
+ * bounds of primitive are projected to the screen and tested against level where they cover few texels.
+ * It doesn't touch RHI, so it may be used without render device
+ */
+class COcclusionBuffer : public CRenderResource
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	COcclusionBuffer();
+
+	/**
+	 * @brief Set settings
+	 * @param InSettings	Settings of occlusion culling
+	 */
+	FORCEINLINE void SetSettings( const SOcclusionCullingSettings& InSettings )
+	{
+		settings = InSettings;
+		check( settings.sizeX > 0 && settings.sizeX % 4 == 0 && settings.sizeY > 0 );
+	}
+
+	/**
+	 * @brief Get settings
+	 * @return Return settings of occlusion culling
+	 */
+	FORCEINLINE const SOcclusionCullingSettings& GetSettings() const
+	{
+		return settings;
+	}
+
+	/**
+	 * @brief Begin new view, remove all occluders
+	 * @param InViewProjectionMatrix	View * Projection matrix
+	 */
+	void Begin( const Matrix& InViewProjectionMatrix );
+
+	/**
+	 * @brief Add occluder
+	 * Triangles which cross near plane are skipped, both windings are rasterized
+	 *
+	 * @param InLocalToWorld	Local to world matrix of occluder
+	 * @param InVerteces		Positions of verteces in local space
+	 * @param InNumVerteces		Number of verteces
+	 * @param InIndeces			Indeces of triangles
+	 * @param InNumIndeces		Number of indeces
+	 * @return Return TRUE if occluder is added, otherwise returns FALSE (budget of triangles is exhausted)
+	 */
+	bool AddOccluder( const Matrix& InLocalToWorld, const Vector4D* InVerteces, uint32 InNumVerteces, const uint32* InIndeces, uint32 InNumIndeces );
+
+	/**
+	 * @brief Rasterize added occluders and build depth pyramid
+	 */
+	void Rasterize();
+
+	/**
+	 * @brief Is visible bounds
+	 * @note Thread safe, must be called after Rasterize
+	 *
+	 * @param InBox		Bounding box in world space
+	 * @return Return TRUE if any part of bounds may be visible, otherwise returns FALSE
+	 */
+	bool IsVisible( const CBox& InBox ) const;
+
+	/**
+	 * @brief Test visibility of array of bounds in parallel
+	 * @note Must be called after Rasterize
+	 *
+	 * @param InBoxes			Bounding boxes in world space
+	 * @param InNumBoxes		Number of bounding boxes
+	 * @param OutVisibility		Output visibility of bounds, 1 if bounds may be visible and 0 if they are occluded
+	 */
+	void TestVisibility( const CBox* InBoxes, uint32 InNumBoxes, uint8* OutVisibility );
+
+	/**
+	 * @brief Get depth of pixel
+	 *
+	 * @param InX	X of pixel
+	 * @param InY	Y of pixel
+	 * @return Return depth of pixel, if pixel isn't covered by occluders returns FLT_MAX
+	 */
+	FORCEINLINE float GetDepth( uint32 InX, uint32 InY ) const
+	{
+		check( InX < settings.sizeX && InY < settings.sizeY && !depthPyramid.empty() );
+		return depthPyramid[ InY * settings.sizeX + InX ];
+	}
+
+	/**
+	 * @brief Get statistics
+	 * @return Return statistics of current view
+	 */
+	FORCEINLINE const SOcclusionCullingStats& GetStats() const
+	{
+		return stats;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+private:
+	/**
+	 * @brief Triangle of occluder in screen space
+	 */
+	struct SOcclusionTriangle
+	{
+		float		edgeA[ 3 ];		/**< Coefficients A of edge functions 'A * x + B * y + C', inside of triangle all edge functions are positive */
+		float		edgeB[ 3 ];		/**< Coefficients B of edge functions */
+		float		edgeC[ 3 ];		/**< Coefficients C of edge functions */
+		float		depthA;			/**< Coefficient A of depth plane 'A * x + B * y + C', it's shifted to the farthest depth inside of pixel */
+		float		depthB;			/**< Coefficient B of depth plane */
+		float		depthC;			/**< Coefficient C of depth plane */
+		float		maxDepth;		/**< Max depth of verteces */
+		int32		minX;			/**< Min X of pixels */
+		int32		minY;			/**< Min Y of pixels */
+		int32		maxX;			/**< Max X of pixels */
+		int32		maxY;			/**< Max Y of pixels */
+	};
+
+	/**
+	 * @brief Level of depth pyramid
+	 */
+	struct SDepthPyramidLevel
+	{
+		uint32		offset;			/**< Offset of first texel in depth pyramid */
+		uint32		sizeX;			/**< Width of level */
+		uint32		sizeY;			/**< Height of level */
+	};
+
+	/**
+	 * @brief Add triangle in screen space
+	 *
+	 * @param InV0	Vertex 0 in clip space
+	 * @param InV1	Vertex 1 in clip space
+	 * @param InV2	Vertex 2 in clip space
+	 */
+	void AddTriangle( const Vector4D& InV0, const Vector4D& InV1, const Vector4D& InV2 );
+
+	/**
+	 * @brief Rasterize triangles into rows of depth buffer
+	 *
+	 * @param InMinY	First row
+	 * @param InMaxY	Last row
+	 */
+	void RasterizeRows( int32 InMinY, int32 InMaxY );
+
+	/**
+	 * @brief Build levels of depth pyramid from the first one
+	 */
+	void BuildDepthPyramid();
+
+	SOcclusionCullingSettings			settings;				/**< Settings */
+	SOcclusionCullingStats				stats;					/**< Statistics of current view */
+	Matrix								viewProjectionMatrix;	/**< View * Projection matrix of current view */
+	std::vector<SOcclusionTriangle>		triangles;				/**< Triangles of occluders */
+	std::vector<Vector4D>				clipVerteces;			/**< Temporary buffer of verteces in clip space */
+	std::vector<float>					depthPyramid;			/**< All levels of depth pyramid, the first level is depth buffer */
+	std::vector<SDepthPyramidLevel>		depthPyramidLevels;		/**< Levels of depth pyramid */
+};
+
+extern TGlobalResource<COcclusionBuffer>		GOcclusionBuffer;	/**< The global occlusion buffer of rendering view */
+
+#endif // !OCCLUSIONCULLING_H
@@ -0,0 +1,312 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef PIPELINESTATE_H
+#define PIPELINESTATE_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Misc/RefCounted.h"
+#include "Misc/RefCountPtr.h"
+#include "System/ThreadingBase.h"
+#include "Render/RenderResource.h"
+#include "Render/RenderUtils.h"
+#include "Render/Shaders/ShaderCompiler.h"
+#include "RHI/BaseStateRHI.h"
+#include "RHI/BaseShaderRHI.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Struct for create pipeline state
+ */
+struct SPipelineStateInitializer
+{
+	/**
+	 * @brief Constructor
+	 */
+	SPipelineStateInitializer();
+
+	/**
+	 * @brief Get hash
+	 * @return Return hash of pipeline state. It doesn't depend on pointers, so it's the same between launches
+	 */
+	uint64 GetHash() const;
+
+	VertexDeclarationRHIRef_t			vertexDeclaration;	/**< Vertex declaration */
+	uint64								vertexFactoryHash;	/**< Hash of vertex factory type, used for find shaders */
+	class CShader*						vertexShader;		/**< Vertex shader */
+	class CShader*						pixelShader;		/**< Pixel shader */
+	SRasterizerStateInitializerRHI		rasterizerState;	/**< Rasterizer state */
+	bool								bUseDepthState;		/**< Is pipeline state set depth state, otherwise it's left as set by pass */
+	SDepthStateInitializerRHI			depthState;			/**< Depth state */
+	bool								bUseBlendState;		/**< Is pipeline state set blend state, otherwise it's left as set by pass */
+	SBlendStateInitializerRHI			blendState;			/**< Blend state */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Immutable pipeline state, it combines bound shader state, rasterizer, depth and blend states
+ *
+ * All RHI objects are created once when pipeline state is initialized, so drawing with it is only setting of them
+ */
+class CPipelineState : public CRenderResource, public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InInitializer		Initializer of pipeline state
+	 */
+	CPipelineState( const SPipelineStateInitializer& InInitializer );
+
+	/**
+	 * @brief Set pipeline state to device context
+	 * @note Must be called only in render thread
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 */
+	void Set( class CBaseDeviceContextRHI* InDeviceContextRHI ) const;
+
+	/**
+	 * @brief Get initializer
+	 * @return Return initializer of pipeline state
+	 */
+	FORCEINLINE const SPipelineStateInitializer& GetInitializer() const
+	{
+		return initializer;
+	}
+
+	/**
+	 * @brief Get hash
+	 * @return Return hash of pipeline state
+	 */
+	FORCEINLINE uint64 GetHash() const
+	{
+		return hash;
+	}
+
+	/**
+	 * @brief Get bound shader state
+	 * @return Return bound shader state, if pipeline state isn't initialized returns nullptr
+	 */
+	FORCEINLINE BoundShaderStateRHIRef_t GetBoundShaderState() const
+	{
+		return boundShaderState;
+	}
+
+	/**
+	 * @brief Get rasterizer state
+	 * @return Return rasterizer state, if pipeline state isn't initialized returns nullptr
+	 */
+	FORCEINLINE RasterizerStateRHIRef_t GetRasterizerState() const
+	{
+		return rasterizerState;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	SPipelineStateInitializer		initializer;		/**< Initializer */
+	uint64							hash;				/**< Hash */
+	BoundShaderStateRHIRef_t		boundShaderState;	/**< Bound shader state */
+	RasterizerStateRHIRef_t			rasterizerState;	/**< Rasterizer state */
+	DepthStateRHIRef_t				depthState;			/**< Depth state, nullptr if not used */
+	BlendStateRHIRef_t				blendState;			/**< Blend state, nullptr if not used */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Typedef of reference to pipeline state
+ */
+typedef TRefCountPtr<CPipelineState>		PipelineStateRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of pipeline state cache
+ */
+struct SPipelineStateCacheStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SPipelineStateCacheStats()
+		: numPipelineStates( 0 )
+		, numPrewarmed( 0 )
+		, numCreatedInPlay( 0 )
+	{}
+
+	uint32		numPipelineStates;	/**< Number of pipeline states in cache */
+	uint32		numPrewarmed;		/**< Number of pipeline states created from list on disk */
+	uint32		numCreatedInPlay;	/**< Number of pipeline states which weren't in list on disk */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Cache of pipeline states
+ *
+ * Pipeline states are keyed by compact hash of initializer. Each new state is added to list which is saved on disk at exit,
+ * on next launch states from the list are created at load. Vertex declaration of a state isn't known at load,
+ * so states from the list wait for registration of vertex declaration with the same hash by vertex factory
+ */
+class CPipelineStateCache : public CRenderResource
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CPipelineStateCache();
+
+	/**
+	 * @brief Get pipeline state, if it isn't in cache it will be created
+	 * @note Thread safe, RHI objects of new state are created on the render thread
+	 *
+	 * @param InInitializer		Initializer of pipeline state
+	 * @return Return pipeline state
+	 */
+	PipelineStateRef_t GetPipelineState( const SPipelineStateInitializer& InInitializer );
+
+	/**
+	 * @brief Register vertex declaration, pipeline states from list on disk with this declaration will be created
+	 * @note Must be called only in render thread
+	 *
+	 * @param InVertexDeclaration	Vertex declaration
+	 */
+	void RegisterVertexDeclaration( VertexDeclarationRHIParamRef_t InVertexDeclaration );
+
+	/**
+	 * @brief Load list of pipeline states from disk and create them
+	 * @note Must be called after loading of shaders
+	 */
+	void Prewarm();
+
+	/**
+	 * @brief Save list of pipeline states on disk if new states were created
+	 */
+	void SaveList();
+
+	/**
+	 * @brief Get statistics
+	 * @return Return statistics of pipeline state cache
+	 */
+	FORCEINLINE const SPipelineStateCacheStats& GetStats() const
+	{
+		return stats;
+	}
+
+	/**
+	 * @brief Get filename of list of pipeline states
+	 *
+	 * @param InShaderPlatform	Shader platform
+	 * @return Return filename of list for shader platform
+	 */
+	static std::wstring GetListFilename( EShaderPlatform InShaderPlatform );
+
+protected:
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	/**
+	 * @brief Record of pipeline state in list on disk
+	 */
+	struct SPipelineStateRecord
+	{
+		uint64								hash;					/**< Hash of pipeline state */
+		std::wstring						vertexShaderName;		/**< Name of vertex shader */
+		std::wstring						pixelShaderName;		/**< Name of pixel shader */
+		uint64								vertexFactoryHash;		/**< Hash of vertex factory type */
+		uint64								vertexDeclarationHash;	/**< Hash of vertex declaration */
+		SRasterizerStateInitializerRHI		rasterizerState;		/**< Rasterizer state */
+		bool								bUseDepthState;			/**< Is used depth state */
+		SDepthStateInitializerRHI			depthState;				/**< Depth state */
+		bool								bUseBlendState;			/**< Is used blend state */
+		SBlendStateInitializerRHI			blendState;				/**< Blend state */
+	};
+
+	/**
+	 * @brief Find pipeline state in cache or create new one
+	 * @warning Critical section must be locked
+	 *
+	 * @param InInitializer		Initializer of pipeline state
+	 * @param InIsPrewarm		Is pipeline state created from list on disk
+	 * @return Return pipeline state
+	 */
+	PipelineStateRef_t FindOrCreate( const SPipelineStateInitializer& InInitializer, bool InIsPrewarm );
+
+	/**
+	 * @brief Create pipeline state from record
+	 * @warning Critical section must be locked
+	 *
+	 * @param InRecord				Record of pipeline state
+	 * @param InVertexDeclaration	Vertex declaration
+	 * @return Return TRUE if pipeline state is created, otherwise returns FALSE (shaders of record not found)
+	 */
+	bool CreateFromRecord( const SPipelineStateRecord& InRecord, VertexDeclarationRHIParamRef_t InVertexDeclaration );
+
+	/**
+	 * @brief Load list of pipeline states from disk
+	 *
+	 * @param InPath		Path to list
+	 * @param OutRecords	Output loaded records
+	 * @return Return TRUE if list is loaded, if it not found or has wrong type or version returns FALSE
+	 */
+	bool LoadList( const std::wstring& InPath, std::vector<SPipelineStateRecord>& OutRecords ) const;
+
+	/**
+	 * @brief Get path to list of pipeline states which is shipped with game
+	 * @return Return path to list of pipeline states
+	 */
+	std::wstring GetListPath() const;
+
+	/**
+	 * @brief Get path to list of pipeline states which is saved at runtime
+	 * @return Return path to saved list of pipeline states, in editor it is equal to GetListPath
+	 */
+	std::wstring GetSavedListPath() const;
+
+	/**
+	 * @brief Serialize record
+	 *
+	 * @param InArchive		Archive
+	 * @param InRecord		Record
+	 */
+	static void SerializeRecord( class CArchive& InArchive, SPipelineStateRecord& InRecord );
+
+	CCriticalSection										cs;						/**< Critical section */
+	std::unordered_map<uint64, PipelineStateRef_t>			pipelineStates;			/**< Pipeline states by hash */
+	std::unordered_map<uint64, VertexDeclarationRHIRef_t>	vertexDeclarations;		/**< Registered vertex declarations by hash */
+	std::vector<SPipelineStateRecord>						records;				/**< List of all seen pipeline states */
+	std::unordered_set<uint64>								recordHashes;			/**< Hashes of states in list */
+	std::vector<SPipelineStateRecord>						pendingRecords;			/**< Records from disk which wait for vertex declaration */
+	bool													bDirtyList;				/**< Is list changed and need save it */
+	SPipelineStateCacheStats								stats;					/**< Statistics */
+};
+
+extern TGlobalResource<CPipelineStateCache>		GPipelineStateCache;	/**< The global cache of pipeline states */
+
+#endif // !PIPELINESTATE_H
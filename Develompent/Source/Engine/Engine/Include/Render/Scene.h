@@ -12,6 +12,7 @@
 #include <vector>
 #include <set>
 #include <list>
+#include <unordered_map>
 
 #include "Math/Math.h"
 #include "Math/Color.h"
@@ -19,11 +20,15 @@
 #include "Render/Material.h"
 #include "Render/SceneRendering.h"
 #include "Render/SceneHitProxyRendering.h"
+#include "Render/DepthRendering.h"
+#include "Render/OcclusionCulling.h"
 #include "Render/Frustum.h"
 #include "Render/HitProxies.h"
 #include "Render/BatchedSimpleElements.h"
 #include "Render/RenderingThread.h"
 #include "Render/DynamicMeshBuilder.h"
+#include "Render/Sprite.h"
+#include "Render/SceneProxy.h"
 #include "Components/CameraComponent.h"
 #include "Components/PrimitiveComponent.h"
 #include "Components/LightComponent.h"
@@ -98,6 +103,14 @@ public:
 		return viewProjectionMatrix * Vector4D( InWorldPoint, 1.f );
 	}
 
+	/**
+	 * Get radius of bounds on screen
+	 *
+	 * @param InBoundBox	Bounding box in world space
+	 * @return Return radius of bounding sphere on screen where 1 is half of screen height. If camera is inside of bounds returns FLT_MAX
+	 */
+	float GetScreenRadius( const CBox& InBoundBox ) const;
+
 	/**
 	 * Get view matrix
 	 * @return Return view matrix
@@ -718,6 +731,7 @@ struct SSceneDepthGroup
 
 		dynamicMeshElements.Clear();
 		staticMeshDrawList.Clear();
+		depthDrawList.Clear();
 		spriteDrawList.Clear();
 
 #if ENABLE_HITPROXY
@@ -762,6 +776,7 @@ struct SSceneDepthGroup
 
 	CMeshDrawList<CMeshDrawingPolicy>						dynamicMeshElements;		/**< Draw list of dynamic meshes */
 	CMeshDrawList<CMeshDrawingPolicy>						staticMeshDrawList;			/**< Draw list of static meshes */
+	CMeshDrawList<CDepthOnlyDrawingPolicy, false>			depthDrawList;				/**< Draw list of occluders in depth prepass */
 	CMeshDrawList<CMeshDrawingPolicy>						spriteDrawList;				/**< Draw list of sprites */
 
 #if ENABLE_HITPROXY
@@ -814,6 +829,12 @@ public:
 	 */
 	virtual void Clear() {}
 
+	/**
+	 * @brief Send all changes of components to the render thread
+	 * Must be called on the game thread before drawing of scene
+	 */
+	virtual void FlushProxyUpdates() {}
+
 	/**
 	 * @brief Build view for render scene from current view
 	 * 
@@ -867,11 +888,34 @@ public:
 	 */
 	virtual void RemoveLight( class CLightComponent* InLight ) override;
 
+	/**
+	 * @brief Mark changed render state of primitive component
+	 * Changes are collected until FlushProxyUpdates, so any number of changes is sent by one update command
+	 *
+	 * @param InPrimitive	Primitive component
+	 * @param InFlags		Changed state (see ESceneProxyUpdateFlags)
+	 */
+	void UpdatePrimitive( class CPrimitiveComponent* InPrimitive, uint32 InFlags );
+
+	/**
+	 * @brief Mark changed render state of light component
+	 * Changes are collected until FlushProxyUpdates, so any number of changes recreates light proxy once
+	 *
+	 * @param InLight	Light component
+	 */
+	void UpdateLight( class CLightComponent* InLight );
+
 	/**
 	 * @brief Clear scene
 	 */
 	virtual void Clear() override;
 
+	/**
+	 * @brief Send all changes of components to the render thread
+	 * Must be called on the game thread before drawing of scene
+	 */
+	virtual void FlushProxyUpdates() override;
+
 	/**
 	 * @brief Build view for render scene from current view
 	 *
@@ -912,11 +956,21 @@ public:
 	 * @brief Get list of visible lights on the current frame
 	 * @return Return list of visible lights
 	 */
-	FORCEINLINE const std::list<LightComponentRef_t>& GetVisibleLights() const
+	FORCEINLINE const LightSceneProxyList_t& GetVisibleLights() const
 	{
 		return frame.visibleLights;
 	}
 
+	/**
+	 * @brief Get sprite batch
+	 * If batch with this material in depth group isn't exist it will be created
+	 *
+	 * @param InMaterial	Material of sprites
+	 * @param InSDGType		SDG type where sprites are drawn
+	 * @return Return sprite batch
+	 */
+	SpriteBatchRef_t GetSpriteBatch( const TAssetHandle<CMaterial>& InMaterial, ESceneDepthGroup InSDGType );
+
 private:
 	/**
 	 * @brief One frame of the scene
@@ -924,12 +978,67 @@ private:
 	struct SSceneFrame
 	{
 		SSceneDepthGroup					SDGs[SDG_Max];		/**< Scene depth groups */
-		std::list<LightComponentRef_t>		visibleLights;		/**< List of visible lights */
+		LightSceneProxyList_t				visibleLights;		/**< List of visible lights */
 	};
+
+	/**
+	 * @brief Apply update commands to scene proxies
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InUpdates		Update commands in order of recording
+	 */
+	void ApplyProxyUpdates( const std::vector<SSceneProxyUpdate>& InUpdates );
+
+	/**
+	 * @brief Delete primitive proxies which are removed by the render thread
+	 * This is only called by the game thread, because with proxy may be destroyed its component
+	 */
+	void DeleteRemovedPrimitiveProxies();
+
+	/**
+	 * @brief Add update command of scene proxy
+	 *
+	 * @param InType			Type of update
+	 * @param InPrimitiveProxy	Primitive proxy
+	 * @param InLightProxy		Light proxy
+	 * @param InOldLightProxy	Replaced light proxy
+	 * @return Return added update command
+	 */
+	SSceneProxyUpdate& AddProxyUpdate( ESceneProxyUpdateType InType, CPrimitiveSceneProxy* InPrimitiveProxy, CLightSceneProxy* InLightProxy = nullptr, CLightSceneProxy* InOldLightProxy = nullptr );
+
+	/**
+	 * @brief Remove proxy from array of scene by swap with last one
+	 *
+	 * @param InOutProxies	Array of proxies
+	 * @param InProxy		Proxy to remove
+	 */
+	template<typename TProxyType>
+	static void RemoveSceneProxy( std::vector<TProxyType*>& InOutProxies, TProxyType* InProxy );
+
+	/**
+	 * @brief Cull primitives in frustum which are occluded by big primitives
+	 * This is only called by the rendering thread.
+	 *
+	 * @param InSceneView	Current view of scene
+	 * @return Return TRUE if occlusion culling is done and visibility of primitives is in primitiveVisibility, otherwise returns FALSE
+	 */
+	bool OcclusionCull( const CSceneView& InSceneView );
 	
 	SSceneFrame								frame;				/**< Scene frame */
 	std::list<PrimitiveComponentRef_t>		primitives;			/**< List of primitives on scene */
 	std::list<LightComponentRef_t>			lights;				/**< List of lights on scene */
+	std::unordered_map<uint64, SpriteBatchRef_t>	spriteBatches;	/**< Sprite batches, key is hash of material and SDG */
+	std::vector<CPrimitiveComponent*>		dirtyPrimitives;	/**< Primitives with changed render state, only for the game thread */
+	std::vector<CLightComponent*>			dirtyLights;		/**< Lights with changed render state, only for the game thread */
+	std::vector<SSceneProxyUpdate>			pendingUpdates;		/**< Recorded update commands which isn't sent to the render thread, only for the game thread */
+	std::vector<CPrimitiveSceneProxy*>		primitiveProxies;	/**< Proxies of primitives, only for the render thread */
+	std::vector<CLightSceneProxy*>			lightProxies;		/**< Proxies of lights, only for the render thread */
+	std::vector<CPrimitiveSceneProxy*>		removedPrimitiveProxies;	/**< Proxies of primitives removed by the render thread, they are deleted on the game thread */
+	CCriticalSection						removedPrimitiveProxiesCS;	/**< Critical section of removedPrimitiveProxies */
+	std::vector<CPrimitiveSceneProxy*>		visiblePrimitiveProxies;	/**< Proxies of primitives in frustum, temporary buffer of BuildView */
+	std::vector<CBox>						visiblePrimitiveBounds;		/**< Bounds of primitives in frustum, temporary buffer of BuildView */
+	std::vector<uint8>						primitiveVisibility;		/**< Result of occlusion test for primitives in frustum, temporary buffer of BuildView */
+	std::vector<std::pair<float, const CPrimitiveSceneProxy*>>	occluderCandidates;	/**< Candidates to occluders with radius on screen, temporary buffer of BuildView */
 };
 
 //
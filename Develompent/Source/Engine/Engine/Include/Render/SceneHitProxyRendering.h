@@ -37,6 +37,7 @@ public:
 		uint64			vertexFactoryHash = InVertexFactory->GetType()->GetHash();
 		vertexShader	= GShaderManager->FindInstance<CHitProxyVertexShader>( vertexFactoryHash );
 		pixelShader		= GShaderManager->FindInstance<CHitProxyPixelShader>( vertexFactoryHash );
+		InitPipelineState();
 	}
 };
 #endif // ENABLE_HITPROXY
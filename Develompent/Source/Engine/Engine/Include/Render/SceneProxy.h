@@ -0,0 +1,282 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SCENEPROXY_H
+#define SCENEPROXY_H
+
+#include <vector>
+
+#include "Math/Math.h"
+#include "Math/Box.h"
+#include "Math/Color.h"
+#include "Misc/EngineTypes.h"
+#include "Components/LightComponent.h"
+
+/**
+ * @ingroup Engine
+ * @brief Flags of changed render state of component
+ */
+enum ESceneProxyUpdateFlags
+{
+	SPU_None			= 0,			/**< Nothing is changed */
+	SPU_Transform		= 1 << 0,		/**< Transform or bounds of primitive are changed */
+	SPU_Visibility		= 1 << 1,		/**< Visibility of primitive is changed */
+	SPU_Material		= 1 << 2,		/**< Material or mesh of primitive is changed, drawing policy link must be updated */
+	SPU_Light			= 1 << 3,		/**< Parameters of light are changed */
+	SPU_Instance		= 1 << 4		/**< Instance data of primitive is changed (e.g. texture rect of sprite) */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Render thread state of primitive component
+ *
+ * Proxy is created by CScene from component on the game thread and after that is owned by the render thread.
+ * It's changed only by update commands of CScene, so the render thread doesn't read transform and visibility of live component.
+ * Proxy holds references to component and its owner, so they live until the render thread removes proxy. Removed proxy is deleted
+ * on the game thread, therefore component is always destroyed there
+ */
+class CPrimitiveSceneProxy
+{
+public:
+	friend class CScene;		// For apply updates and track index in scene
+
+	/**
+	 * @brief Constructor
+	 * @param InComponent	Primitive component
+	 */
+	CPrimitiveSceneProxy( class CPrimitiveComponent* InComponent );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CPrimitiveSceneProxy();
+
+	/**
+	 * @brief Get primitive component
+	 * @return Return primitive component which adds mesh batches of proxy into draw lists
+	 */
+	FORCEINLINE class CPrimitiveComponent* GetComponent() const
+	{
+		return component.GetPtr();
+	}
+
+	/**
+	 * @brief Get local to world matrix
+	 * @return Return local to world matrix
+	 */
+	FORCEINLINE const Matrix& GetLocalToWorld() const
+	{
+		return localToWorld;
+	}
+
+	/**
+	 * @brief Get bound box
+	 * @return Return bound box in world space
+	 */
+	FORCEINLINE const CBox& GetBoundBox() const
+	{
+		return boundbox;
+	}
+
+	/**
+	 * @brief Get visibility
+	 * @return Return visibility of primitive
+	 */
+	FORCEINLINE bool IsVisibility() const
+	{
+		return bVisibility;
+	}
+
+	/**
+	 * @brief Is dirty drawing policy link
+	 * @return Return TRUE if material or mesh of primitive is changed and drawing policy link must be updated in AddToDrawList
+	 */
+	FORCEINLINE bool IsDirtyDrawingPolicyLink() const
+	{
+		return bDirtyDrawingPolicyLink;
+	}
+
+private:
+	TRefCountPtr<class CPrimitiveComponent>	component;	/**< Primitive component */
+	ActorRef_t						owner;			/**< Owner of component, it's used by component on the render thread */
+	Matrix							localToWorld;	/**< Local to world matrix */
+	CBox							boundbox;		/**< Bound box */
+	bool							bVisibility;	/**< Is primitive visibility */
+	bool							bDirtyDrawingPolicyLink;	/**< Is dirty drawing policy link, it's cleared by scene after AddToDrawList */
+	uint32							sceneIndex;		/**< Index of proxy in scene */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Render thread state of light component
+ *
+ * Light proxy is immutable, when light component is changed CScene creates new proxy and replaces old one on the render thread.
+ * All values used by lighting are calculated once when proxy is created
+ */
+class CLightSceneProxy
+{
+public:
+	friend class CScene;		// For track index in scene
+
+	/**
+	 * @brief Constructor
+	 * @param InComponent	Light component
+	 */
+	CLightSceneProxy( const class CLightComponent* InComponent );
+
+	/**
+	 * @brief Get light type
+	 * @return Return light type
+	 */
+	FORCEINLINE ELightType GetLightType() const
+	{
+		return lightType;
+	}
+
+	/**
+	 * @brief Is enabled
+	 * @return Return TRUE if the light is enabled
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnabled;
+	}
+
+	/**
+	 * @brief Get local to world matrix
+	 * @return Return local to world matrix
+	 */
+	FORCEINLINE const Matrix& GetLocalToWorld() const
+	{
+		return localToWorld;
+	}
+
+	/**
+	 * @brief Get position
+	 * @return Return position in world space
+	 */
+	FORCEINLINE const Vector& GetPosition() const
+	{
+		return position;
+	}
+
+	/**
+	 * @brief Get direction
+	 * @return Return direction in world space
+	 */
+	FORCEINLINE const Vector& GetDirection() const
+	{
+		return direction;
+	}
+
+	/**
+	 * @brief Get light color
+	 * @return Return light color
+	 */
+	FORCEINLINE const CColor& GetLightColor() const
+	{
+		return lightColor;
+	}
+
+	/**
+	 * @brief Get specular color
+	 * @return Return specular color
+	 */
+	FORCEINLINE const CColor& GetSpecularColor() const
+	{
+		return specularColor;
+	}
+
+	/**
+	 * @brief Get intensivity
+	 * @return Return intensivity
+	 */
+	FORCEINLINE float GetIntensivity() const
+	{
+		return intensivity;
+	}
+
+	/**
+	 * @brief Get radius
+	 * @return Return radius of point and spot light, for directional light returns 0
+	 */
+	FORCEINLINE float GetRadius() const
+	{
+		return radius;
+	}
+
+	/**
+	 * @brief Get cosine of inner cone angle
+	 * @return Return cosine of inner cone angle of spot light, for other lights returns -1
+	 */
+	FORCEINLINE float GetCosInnerCone() const
+	{
+		return cosInnerCone;
+	}
+
+	/**
+	 * @brief Get cosine of outer cone angle
+	 * @return Return cosine of outer cone angle of spot light, for other lights returns -2
+	 */
+	FORCEINLINE float GetCosOuterCone() const
+	{
+		return cosOuterCone;
+	}
+
+private:
+	ELightType		lightType;		/**< Light type */
+	bool			bEnabled;		/**< Is enabled the light */
+	Matrix			localToWorld;	/**< Local to world matrix */
+	Vector			position;		/**< Position in world space */
+	Vector			direction;		/**< Direction in world space */
+	CColor			lightColor;		/**< Light color */
+	CColor			specularColor;	/**< Specular color */
+	float			intensivity;	/**< Intensivity */
+	float			radius;			/**< Radius */
+	float			cosInnerCone;	/**< Cosine of inner cone angle */
+	float			cosOuterCone;	/**< Cosine of outer cone angle */
+	uint32			sceneIndex;		/**< Index of proxy in scene */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Type of scene proxy update command
+ */
+enum ESceneProxyUpdateType
+{
+	SPUT_AddPrimitive,		/**< Add primitive proxy to scene */
+	SPUT_RemovePrimitive,	/**< Remove primitive proxy from scene and delete it */
+	SPUT_UpdatePrimitive,	/**< Update state of primitive proxy */
+	SPUT_AddLight,			/**< Add light proxy to scene */
+	SPUT_RemoveLight,		/**< Remove light proxy from scene and delete it */
+	SPUT_ReplaceLight		/**< Replace light proxy by new one and delete old */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Update command of scene proxy, it's recorded on the game thread and applied on the render thread
+ */
+struct SSceneProxyUpdate
+{
+	ESceneProxyUpdateType			type;				/**< Type of update */
+	uint32							flags;				/**< Changed state of primitive (see ESceneProxyUpdateFlags) */
+	class CPrimitiveSceneProxy*		primitiveProxy;		/**< Primitive proxy */
+	class CLightSceneProxy*			lightProxy;			/**< Light proxy, for SPUT_ReplaceLight is new proxy */
+	class CLightSceneProxy*			oldLightProxy;		/**< Replaced light proxy */
+	Matrix							localToWorld;		/**< New local to world matrix of primitive */
+	CBox							boundbox;			/**< New bound box of primitive */
+	bool							bVisibility;		/**< New visibility of primitive */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Typedef of list of light proxies
+ */
+typedef std::vector<const CLightSceneProxy*>		LightSceneProxyList_t;
+
+#endif // !SCENEPROXY_H
@@ -67,28 +67,24 @@ public:
 		uint64			vertexFactoryHash = InVertexFactory->GetType()->GetHash();
 		vertexShader	= GShaderManager->FindInstance<CWireframeVertexShader>( vertexFactoryHash );
 		pixelShader		= GShaderManager->FindInstance<CWireframePixelShader>( vertexFactoryHash );
+		TBaseMeshDrawingPolicy::InitPipelineState();
 	}
 
 	/**
-	 * @brief Get rasterizer state
-	 * @return Return rasterizer state of current drawing policy
+	 * @brief Get rasterizer state initializer
+	 * @return Return initializer of rasterizer state of current drawing policy
 	 */
-	virtual RasterizerStateRHIRef_t GetRasterizerState() const
+	virtual SRasterizerStateInitializerRHI GetRasterizerStateInitializer() const override
 	{
-		if ( !rasterizerState )
+		const SRasterizerStateInitializerRHI		initializer =
 		{
-			const SRasterizerStateInitializerRHI		initializer =
-			{
-				FM_Wireframe,
-				CM_None,
-				depthBias,
-				0.f,
-				true
-			};
-			rasterizerState = GRHI->CreateRasterizerState( initializer );
-		}
-
-		return rasterizerState;
+			FM_Wireframe,
+			CM_None,
+			depthBias,
+			0.f,
+			true
+		};
+		return initializer;
 	}
 
 	/**
@@ -170,6 +166,15 @@ private:
 	 */
 	bool RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, uint32 InSDGIndex );
 
+	/**
+	 * Render depth prepass of SDG
+	 * 
+	 * @param InDeviceContext	RHI device context
+	 * @param InSDG				Scene depth group
+	 * @return Return TRUE if occluders is drawed in depth buffer
+	 */
+	bool RenderDepthPrepass( class CBaseDeviceContextRHI* InDeviceContext, struct SSceneDepthGroup& InSDG );
+
 	/**
 	 * Render lights
 	 * 
@@ -177,6 +182,13 @@ private:
 	 */
 	void RenderLights( class CBaseDeviceContextRHI* InDeviceContext );
 
+	/**
+	 * Render point and spot lights by light grid in one fullscreen pass
+	 * 
+	 * @param InDeviceContext	RHI device context
+	 */
+	void RenderClusteredLights( class CBaseDeviceContextRHI* InDeviceContext );
+
 	/**
 	 * Render post process
 	 *
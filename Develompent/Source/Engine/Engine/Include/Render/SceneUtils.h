@@ -13,6 +13,7 @@
 #include "Math/Math.h"
 #include "Math/Color.h"
 #include "Misc/EngineGlobals.h"
+#include "Containers/String.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseDeviceContextRHI.h"
 
@@ -101,47 +102,97 @@
 /**
  * @ingroup Engine
  * @brief Class for scoped draw event
+ *
+ * Draw events are emitted only when they are enabled in runtime (frame capture tool is attached or CVar 'r.drawEvents' is set),
+ * otherwise the macros cost only one check of the flag. Names are literals or formatted only after this check,
+ * so inner draw loops don't format strings without frame capture tool. In shipping builds the macros are empty
  */
 class CScopedDrawEvent
 {
 public:
 	/**
 	 * @brief Constructor
-	 * 
-	 * @param InColor Color of event
-	 * @param InStatId Name event
 	 */
-	FORCEINLINE CScopedDrawEvent( const CColor& InColor, const tchar* InStatId )
-	{
-		GRHI->BeginDrawEvent( GRHI->GetImmediateContext(), InColor, InStatId );
-	}
+	FORCEINLINE CScopedDrawEvent()
+		: bBegun( false )
+	{}
 
 	/**
 	 * @brief Destructor
 	 */
 	FORCEINLINE ~CScopedDrawEvent()
 	{
-		GRHI->EndDrawEvent( GRHI->GetImmediateContext() );
+		if ( bBegun )
+		{
+			GRHI->EndDrawEvent( GRHI->GetImmediateContext() );
+		}
 	}
 
-protected:
 	/**
-	 * @brief Constructor
+	 * @brief Begin draw event, it will be ended in destructor
+	 *
+	 * @param InColor	Color of event
+	 * @param InName	Name of event
+	 */
+	FORCEINLINE void Begin( const CColor& InColor, const tchar* InName )
+	{
+		bBegun = true;
+		GRHI->BeginDrawEvent( GRHI->GetImmediateContext(), InColor, InName );
+	}
+
+	/**
+	 * @brief Is enabled draw events
+	 * @return Return TRUE if draw events are emitted, otherwise returns FALSE
+	 */
+	static FORCEINLINE bool IsEnabled()
+	{
+		return bEnabled;
+	}
+
+	/**
+	 * @brief Update runtime toggle of draw events
+	 * @note Must be called only in render thread at begin of frame
 	 */
-	CScopedDrawEvent() {}
+	static void UpdateEnabled();
+
+private:
+	bool			bBegun;			/**< Is draw event begun */
+	static bool		bEnabled;		/**< Is enabled draw events */
 };
 
 /**
  * @ingroup Engine
- * @brief Macro for declare scroped draw event
+ * @brief Macro for declare scroped draw event with constant name
  * 
  * @param InEventName Event name
  * @param InColor Color of event
- * @param InStatID Stat id
+ * @param InStatID Stat id, must be string literal
+ */
+#define SCOPED_DRAW_EVENT( InEventName, InColor, InStatID ) \
+	CScopedDrawEvent	event_##InEventName; \
+	if ( CScopedDrawEvent::IsEnabled() ) \
+	{ \
+		event_##InEventName.Begin( InColor, InStatID ); \
+	}
+
+/**
+ * @ingroup Engine
+ * @brief Macro for declare scroped draw event with formatted name
+ * @note Arguments of format are evaluated only when draw events are enabled
+ *
+ * @param InEventName Event name
+ * @param InColor Color of event
+ * @param InFormat Format of stat id
  */
-#define SCOPED_DRAW_EVENT( InEventName, InColor, InStatID )		CScopedDrawEvent event_##InEventName( InColor, InStatID )
+#define SCOPED_DRAW_EVENTF( InEventName, InColor, InFormat, ... ) \
+	CScopedDrawEvent	event_##InEventName; \
+	if ( CScopedDrawEvent::IsEnabled() ) \
+	{ \
+		event_##InEventName.Begin( InColor, CString::Format( InFormat, __VA_ARGS__ ).c_str() ); \
+	}
 #else
 #define SCOPED_DRAW_EVENT( InEventName, InColor, InStatID )
+#define SCOPED_DRAW_EVENTF( InEventName, InColor, InFormat, ... )
 #endif // FRAME_CAPTURE_MARKERS
 
 #endif // !SCENEUTILS_H
\ No newline at end of file
@@ -151,14 +151,14 @@ public:
 	 * @brief Set the l2w transform shader
 	 *
 	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of point light componenets
+	 * @param InLights				List of point light proxies
 	 * @param InMesh				Mesh data
 	 * @param InVertexFactory		Vertex factory
 	 * @param InView				Scene view
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CPointLightComponent>>& InLights, const class CVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const
+	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const LightSceneProxyList_t& InLights, const class CVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const
 	{
 		check( vertexFactoryParameters && InVertexFactory && InVertexFactory->GetType()->GetHash() == CLightVertexFactory::staticType.GetHash() );
 		vertexFactoryParameters->SetMesh( InDeviceContextRHI, InLights, ( CLightVertexFactory* )InVertexFactory, InView, InNumInstances, InStartInstanceID );
@@ -493,4 +493,56 @@ public:
 #endif // WITH_EDITOR
 };
 
+/**
+ * @ingroup Engine
+ * @brief Class of clustered lighting pixel shader
+ *
+ * Draws in one fullscreen pass all point and spot lights of light grid
+ */
+class CClusteredLightingPixelShader : public CBaseLightingPixelShader
+{
+	DECLARE_SHADER_TYPE( CClusteredLightingPixelShader )
+
+public:
+#if WITH_EDITOR
+	/**
+	 * @brief Is need compile shader for platform
+	 *
+	 * @param InShaderPlatform Shader platform
+	 * @param InVFMetaType Vertex factory meta type. If him is nullptr - return general check
+	 * @return Return true if need compile shader, else returning false
+	 */
+	static bool ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType = nullptr );
+
+	/**
+	 * @brief Modify compilation environment
+	 *
+	 * @param InShaderPlatform Shader platform
+	 * @param InEnvironment Shader compiler environment
+	 */
+	static void ModifyCompilationEnvironment( EShaderPlatform InShaderPlatform, SShaderCompilerEnvironment& InEnvironment );
+#endif // WITH_EDITOR
+
+	/**
+	 * @brief Initialize shader
+	 * @param[in] InShaderCacheItem Cache of shader
+	 */
+	virtual void Init( const CShaderCache::SShaderCacheItem& InShaderCacheItem ) override;
+
+	/**
+	 * @brief Set light grid parameters
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 * @param InLightGrid			Light grid
+	 */
+	void SetLightGrid( class CBaseDeviceContextRHI* InDeviceContextRHI, const class CLightGrid& InLightGrid ) const;
+
+private:
+	CShaderResourceParameter		lightGridClustersParameter;			/**< Texture of light grid clusters parameter */
+	CShaderResourceParameter		lightGridIndecesParameter;			/**< Texture of light grid indeces parameter */
+	CShaderResourceParameter		lightGridLightsParameter;			/**< Texture of light grid lights parameter */
+	CShaderParameter				lightGridSizeParameter;				/**< Size of light grid parameter */
+	CShaderParameter				lightGridDepthParamsParameter;		/**< Depth parameters of light grid parameter */
+};
+
 #endif // !LIGHTINGSHADER_H
\ No newline at end of file
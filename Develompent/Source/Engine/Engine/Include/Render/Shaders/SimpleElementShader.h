@@ -33,6 +33,27 @@ public:
 #endif // WITH_EDITOR
 };
 
+/**
+ * @ingroup Engine
+ * @brief Class of simple element vertex shader for thick lines, it builds quads of line instances
+ */
+class CSimpleElementThickLineVertexShader : public CShader
+{
+	DECLARE_SHADER_TYPE( CSimpleElementThickLineVertexShader )
+
+public:
+#if WITH_EDITOR
+	/**
+	 * @brief Is need compile shader for platform
+	 *
+	 * @param InShaderPlatform Shader platform
+	 * @param InVFMetaType Vertex factory meta type. If him is nullptr - return general check
+	 * @return Return true if need compile shader, else returning false
+	 */
+	static bool ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType = nullptr );
+#endif // WITH_EDITOR
+};
+
 /**
  * @ingroup Engine
  * @brief Class of simple element pixel shader
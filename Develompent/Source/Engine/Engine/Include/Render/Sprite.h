@@ -9,9 +9,13 @@
 #ifndef SPRITE_H
 #define SPRITE_H
 
+#include <vector>
+
 #include "RenderResource.h"
 #include "RenderUtils.h"
 #include "Misc/RefCounted.h"
+#include "Math/Rect.h"
+#include "Math/Color.h"
 #include "Render/VertexFactory/SpriteVertexFactory.h"
 #include "RHI/BaseBufferRHI.h"
 #include "RHI/TypesRHI.h"
@@ -92,9 +96,35 @@ extern TGlobalResource< CSpriteMesh >		GSpriteMesh;			/**< The global sprite mes
 
 /**
  * @ingroup Engine
- * @brief Implementation for sprite mesh
+ * @brief Type of sprite
+ * @warning Values are used in SpriteVertexFactory.hlsl, keep them in sync
+ */
+enum ESpriteType
+{
+	ST_Static,                  /**< Static sprite */
+	ST_Rotating,                /**< Rotating sprite to player camera */
+	ST_RotatingOnlyVertical     /**< Rotating sprite to player camera only by vertical */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Flags of sprite flip
+ * @warning Values are used in SpriteVertexFactory.hlsl, keep them in sync
  */
-class CSprite : public CRenderResource, public CRefCounted
+enum ESpriteFlipFlags
+{
+	SFF_None			= 0,		/**< Sprite isn't fliped */
+	SFF_Horizontal		= 1 << 0,	/**< Sprite is fliped by horizontal */
+	SFF_Vertical		= 1 << 1	/**< Sprite is fliped by vertical */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Description of sprite
+ *
+ * Sprite has no own render resources, all its data is sent to GPU as instance of CSpriteBatch
+ */
+class CSprite : public CRefCounted
 {
 public:
 	/**
@@ -129,15 +159,6 @@ public:
 		return material;
 	}
 
-	/**
-	 * Get vertex factory
-	 * @return Return vertex factory
-	 */
-	FORCEINLINE TRefCountPtr<CSpriteVertexFactory> GetVertexFactory() const
-	{
-		return vertexFactory;
-	}
-
 	/**
 	 * Get RHI vertex buffer
 	 * @return Return RHI vertex buffer, if not created return nullptr
@@ -156,13 +177,31 @@ public:
 		return GSpriteMesh.GetIndexBufferRHI();
 	}
 
+	/**
+	 * @brief Set type
+	 * @param InType Type of sprite
+	 */
+	FORCEINLINE void SetType( ESpriteType InType )
+	{
+		type = InType;
+	}
+
+	/**
+	 * @brief Get type
+	 * @return Return type of sprite
+	 */
+	FORCEINLINE ESpriteType GetType() const
+	{
+		return type;
+	}
+
 	/**
 	 * @brief Set texture rect
 	 * @param InTextureRect Texture rect
 	 */
 	FORCEINLINE void SetTextureRect( const RectFloat_t& InTextureRect )
 	{
-		vertexFactory->SetTextureRect( InTextureRect );
+		textureRect = InTextureRect;
 	}
 
 	/**
@@ -171,7 +210,7 @@ public:
 	 */
 	FORCEINLINE const RectFloat_t& GetTextureRect() const
 	{
-		return vertexFactory->GetTextureRect();
+		return textureRect;
 	}
 
 	/**
@@ -180,7 +219,16 @@ public:
 	 */
 	FORCEINLINE void SetSpriteSize( const Vector2D& InSpriteSize )
 	{
-		vertexFactory->SetSpriteSize( InSpriteSize );
+		spriteSize = InSpriteSize;
+	}
+
+	/**
+	 * @brief Get sprite size
+	 * @return Return sprite size
+	 */
+	FORCEINLINE const Vector2D& GetSpriteSize() const
+	{
+		return spriteSize;
 	}
 
 	/**
@@ -189,7 +237,7 @@ public:
 	 */
 	FORCEINLINE void SetFlipVertical( bool InFlipVertical )
 	{
-		vertexFactory->SetFlipVertical( InFlipVertical );
+		bFlipVertical = InFlipVertical;
 	}
 
 	/**
@@ -198,16 +246,7 @@ public:
 	 */
 	FORCEINLINE void SetFlipHorizontal( bool InFlipHorizontal )
 	{
-		vertexFactory->SetFlipHorizontal( InFlipHorizontal );
-	}
-
-	/**
-	 * @brief Get sprite size
-	 * @return Return sprite size
-	 */
-	FORCEINLINE const Vector2D& GetSpriteSize() const
-	{
-		return vertexFactory->GetSpriteSize();
+		bFlipHorizontal = InFlipHorizontal;
 	}
 
 	/**
@@ -216,7 +255,7 @@ public:
 	 */
 	FORCEINLINE bool IsFlipedVertical() const
 	{
-		return vertexFactory->IsFlipedVertical();
+		return bFlipVertical;
 	}
 
 	/**
@@ -225,7 +264,129 @@ public:
 	 */
 	FORCEINLINE bool IsFlipedHorizontal() const
 	{
-		return vertexFactory->IsFlipedHorizontal();
+		return bFlipHorizontal;
+	}
+
+	/**
+	 * @brief Get flip flags
+	 * @return Return flip flags (see ESpriteFlipFlags)
+	 */
+	FORCEINLINE uint32 GetFlipFlags() const
+	{
+		return ( bFlipHorizontal ? SFF_Horizontal : SFF_None ) | ( bFlipVertical ? SFF_Vertical : SFF_None );
+	}
+
+private:
+	bool						bFlipVertical;		/**< Is need flip sprite by vertical */
+	bool						bFlipHorizontal;	/**< Is need flip sprite by horizontal */
+	ESpriteType					type;				/**< Type of sprite */
+	RectFloat_t					textureRect;		/**< Texture rect */
+	Vector2D					spriteSize;			/**< Sprite size */
+	TAssetHandle<CMaterial>		material;			/**< Material */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Instance of sprite in CSpriteBatch, layout of instance buffer for CSpriteVertexFactory
+ */
+struct SSpriteInstance
+{
+	Matrix		localToWorld;		/**< Local to world matrix of sprite. Billboard rotation is applied on it in vertex shader */
+	Vector4D	textureRect;		/**< Texture rect, XY is offset and ZW is size */
+	Vector4D	spriteParams;		/**< Sprite size in XY, flip flags in Z (see ESpriteFlipFlags) and type of sprite in W (see ESpriteType) */
+
+#if ENABLE_HITPROXY
+	CColor		hitProxyId;			/**< Hit proxy id */
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+	CColor		colorOverlay;		/**< Color overlay */
+#endif // WITH_EDITOR
+};
+
+/**
+ * @ingroup Engine
+ * @brief Reference to CSpriteBatch
+ */
+typedef TRefCountPtr< class CSpriteBatch >			SpriteBatchRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Batch of sprites with one material
+ *
+ * Sprites of batch are drawn by one instanced draw call. Instances are kept in persistent instance buffer,
+ * only changed instances are uploaded to GPU. Billboard rotation is calculated in vertex shader, so moving of camera
+ * doesn't change instances. Removed instances are collapsed to zero size and their slots are reused
+ */
+class CSpriteBatch : public CRenderResource, public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InMaterial	Material of sprites
+	 */
+	CSpriteBatch( const TAssetHandle<CMaterial>& InMaterial );
+
+	/**
+	 * @brief Allocate instance
+	 * @return Return ID of new instance, it's collapsed until first update
+	 */
+	uint32 AllocateInstance();
+
+	/**
+	 * @brief Free instance
+	 * @param InInstanceId	ID of instance
+	 */
+	void FreeInstance( uint32 InInstanceId );
+
+	/**
+	 * @brief Update instance
+	 *
+	 * @param InInstanceId	ID of instance
+	 * @param InInstance	New data of instance
+	 */
+	void UpdateInstance( uint32 InInstanceId, const SSpriteInstance& InInstance );
+
+	/**
+	 * @brief Collapse instance, it isn't drawn until next update
+	 * @param InInstanceId	ID of instance
+	 */
+	void CollapseInstance( uint32 InInstanceId );
+
+	/**
+	 * @brief Upload changed instances and set instance buffer to stream
+	 * @note This is only called by the rendering thread
+	 *
+	 * @param InDeviceContextRHI	RHI device context
+	 * @param InStreamIndex			Index of instance stream
+	 */
+	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, uint32 InStreamIndex );
+
+	/**
+	 * @brief Get number of instances to draw
+	 * @return Return number of instances including collapsed ones
+	 */
+	FORCEINLINE uint32 GetNumInstances() const
+	{
+		return ( uint32 )instances.size();
+	}
+
+	/**
+	 * @brief Get material
+	 * @return Return material of sprites
+	 */
+	FORCEINLINE TAssetHandle<CMaterial> GetMaterial() const
+	{
+		return material;
+	}
+
+	/**
+	 * @brief Get vertex factory
+	 * @return Return vertex factory
+	 */
+	FORCEINLINE TRefCountPtr<CSpriteVertexFactory> GetVertexFactory() const
+	{
+		return vertexFactory;
 	}
 
 protected:
@@ -244,8 +405,27 @@ protected:
 	virtual void ReleaseRHI() override;
 
 private:
-	TRefCountPtr<CSpriteVertexFactory>		vertexFactory;		/**< Vertex factory */
-	TAssetHandle<CMaterial>					material;			/**< Material */
+	/**
+	 * @brief Mark instance dirty
+	 * @param InInstanceId	ID of instance
+	 */
+	FORCEINLINE void MarkDirty( uint32 InInstanceId )
+	{
+		if ( !dirtyFlags[ InInstanceId ] )
+		{
+			dirtyFlags[ InInstanceId ] = true;
+			dirtyInstances.push_back( InInstanceId );
+		}
+	}
+
+	TAssetHandle<CMaterial>					material;				/**< Material of sprites */
+	TRefCountPtr<CSpriteVertexFactory>		vertexFactory;			/**< Vertex factory */
+	std::vector<SSpriteInstance>			instances;				/**< Instances */
+	std::vector<bool>						dirtyFlags;				/**< Is instance changed since last upload */
+	std::vector<uint32>						dirtyInstances;			/**< IDs of changed instances */
+	std::vector<uint32>						freeInstances;			/**< IDs of free instances */
+	VertexBufferRHIRef_t					instanceBufferRHI;		/**< RHI instance buffer */
+	uint32									numBufferInstances;		/**< Number of instances fit in RHI instance buffer */
 };
 
 #endif // !SPRITE_H
@@ -35,6 +35,62 @@ struct SStaticMeshSurface
 	uint32			numPrimitives;			/**< Number primitives in the surface */
 };
 
+/**
+ * @ingroup Engine
+ * Max number of LODs in static mesh
+ */
+#define STATICMESH_MAX_LODS			8
+
+/**
+ * @ingroup Engine
+ * Level of detail in static mesh, verteces and indeces of all LODs are in the same buffers
+ */
+struct SStaticMeshLOD
+{
+	/**
+	 * @brief Constructor
+	 */
+	SStaticMeshLOD()
+		: screenSize( 0.f )
+	{}
+
+	/**
+	 * @brief Get number of primitives
+	 * @return Return number of primitives in all surfaces of LOD
+	 */
+	FORCEINLINE uint32 GetNumPrimitives() const
+	{
+		uint32		numPrimitives = 0;
+		for ( uint32 index = 0, count = surfaces.size(); index < count; ++index )
+		{
+			numPrimitives += surfaces[ index ].numPrimitives;
+		}
+		return numPrimitives;
+	}
+
+	std::vector<SStaticMeshSurface>		surfaces;		/**< Array surfaces in LOD */
+	float								screenSize;		/**< Min radius of bounds on screen (1 is half of screen height) to draw this LOD, the last LOD is drawn at any size */
+};
+
+/**
+ * @ingroup Engine
+ * Statistics of static mesh LODs drawn in one view
+ */
+struct SStaticMeshLODStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SStaticMeshLODStats()
+	{
+		appMemzero( numInstances, sizeof( numInstances ) );
+		appMemzero( numPrimitives, sizeof( numPrimitives ) );
+	}
+
+	uint32		numInstances[ STATICMESH_MAX_LODS ];		/**< Number of drawn instances of each LOD */
+	uint32		numPrimitives[ STATICMESH_MAX_LODS ];		/**< Number of drawn primitives of each LOD */
+};
+
 /**
  * @ingroup Engine
  * @brief Implementation for static mesh
@@ -52,6 +108,16 @@ public:
 	 */
 	typedef CMeshDrawList<CMeshDrawingPolicy>::DrawingPolicyLinkRef_t				DrawingPolicyLinkRef_t;
 
+	/**
+	 * @brief Typedef of depth only drawing policy link
+	 */
+	typedef CMeshDrawList<CDepthOnlyDrawingPolicy, false>::SDrawingPolicyLink		DepthDrawingPolicyLink_t;
+
+	/**
+	 * @brief Typedef of reference on depth only drawing policy link in scene
+	 */
+	typedef CMeshDrawList<CDepthOnlyDrawingPolicy, false>::DrawingPolicyLinkRef_t	DepthDrawingPolicyLinkRef_t;
+
 #if ENABLE_HITPROXY
 	/**
 	 * @brief Typedef of hit proxy drawing policy link
@@ -69,6 +135,17 @@ public:
 	 */
 	struct SElementDrawingPolicyLink
 	{
+		/**
+		 * @brief LOD of element
+		 */
+		struct SLOD
+		{
+			uint32		firstMeshBatchLink;			/**< Index of first mesh batch link of LOD in meshBatchLinks */
+			uint32		firstDepthMeshBatchLink;	/**< Index of first mesh batch link of LOD in depthMeshBatchLinks */
+			uint32		numPrimitives;				/**< Number primitives in LOD */
+			float		screenSize;					/**< Min radius of bounds on screen to draw this LOD */
+		};
+
 		/**
 		 * @brief Constructor
 		 */
@@ -77,10 +154,39 @@ public:
 			, overrideHash( 0 )
 		{}
 
+		/**
+		 * @brief Select LOD by size of bounds on screen
+		 *
+		 * @param InSceneView	Scene view
+		 * @param InBoundBox	Bounding box of primitive in world space
+		 * @return Return index of LOD to draw
+		 */
+		FORCEINLINE uint32 SelectLOD( const CSceneView& InSceneView, const CBox& InBoundBox ) const
+		{
+			uint32		lastLOD = lods.size() - 1;
+			if ( lastLOD == 0 )
+			{
+				return 0;
+			}
+
+			float		screenRadius = InSceneView.GetScreenRadius( InBoundBox );
+			for ( uint32 index = 0; index < lastLOD; ++index )
+			{
+				if ( screenRadius >= lods[ index ].screenSize )
+				{
+					return index;
+				}
+			}
+			return lastLOD;
+		}
+
 		bool											bDirty;					/**< Is dirty this element */
 		std::vector<DrawingPolicyLinkRef_t>				drawingPolicyLinks;		/**< Array of reference to drawing policy link in scene */
 		std::vector<const SMeshBatch*>					meshBatchLinks;			/**< Array of references to mesh batch in drawing policy link */
 		uint64											overrideHash;			/**< Hash of overrided segments (custom materials) */
+		std::vector<DepthDrawingPolicyLinkRef_t>		depthDrawingPolicyLinks;	/**< Array of references to depth only drawing policy link in scene */
+		std::vector<const SMeshBatch*>					depthMeshBatchLinks;		/**< Array of references to mesh batch in depth only drawing policy link */
+		std::vector<SLOD>								lods;					/**< Array of LODs, mesh batch links of LOD end at the first link of next LOD */
 
 #if ENABLE_HITPROXY
 		std::vector<HitProxyDrawingPolicyLinkRef_t>		hitProxyDrawingPolicyLinks;		/**< Array of references to hit proxy drawing policy link in scene */
@@ -114,6 +220,16 @@ public:
 	 */
 	void SetData( const std::vector< SStaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< SStaticMeshSurface >& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials );
 
+	/**
+	 * Set data mesh with LODs
+	 *
+	 * @param[in] InVerteces Array verteces of all LODs
+	 * @param[in] InIndeces Array indeces of all LODs
+	 * @param[in] InLODs Array LODs in mesh, the first one is the most detailed
+	 * @param[in] InMaterials Array materials in mesh
+	 */
+	void SetData( const std::vector< SStaticMeshVertexType >& InVerteces, const std::vector< uint32 >& InIndeces, const std::vector< SStaticMeshLOD >& InLODs, const std::vector< TAssetHandle<CMaterial> >& InMaterials );
+
 	/**
 	 * Set material
 	 * 
@@ -131,22 +247,80 @@ public:
 		return vertexFactory;
 	}
 
+	/**
+	 * Get position only vertex factory
+	 * @return Return vertex factory for depth prepass
+	 */
+	FORCEINLINE TRefCountPtr< CStaticMeshDepthVertexFactory > GetDepthVertexFactory() const
+	{
+		return depthVertexFactory;
+	}
+
+	/**
+	 * Is mesh has geometry for occlusion culling
+	 * @return Return TRUE if mesh may be occluder, otherwise returns FALSE
+	 */
+	FORCEINLINE bool HasOccluderGeometry() const
+	{
+		return !occluderIndeces.empty();
+	}
+
+	/**
+	 * Get positions of verteces for occlusion culling
+	 * @return Return positions of verteces, empty if mesh isn't occluder
+	 */
+	FORCEINLINE const std::vector< Vector4D >& GetOccluderVerteces() const
+	{
+		return occluderVerteces;
+	}
+
+	/**
+	 * Get indeces of triangles for occlusion culling
+	 * @return Return indeces of all surfaces relative to first vertex, empty if mesh isn't occluder
+	 */
+	FORCEINLINE const std::vector< uint32 >& GetOccluderIndeces() const
+	{
+		return occluderIndeces;
+	}
+
 	/**
 	 * Get number of surfaces
+	 *
+	 * @param[in] InLODIndex Index of LOD
 	 * @return Return number of surfaces in array
 	 */
-	FORCEINLINE uint32 GetNumSurfaces() const
+	FORCEINLINE uint32 GetNumSurfaces( uint32 InLODIndex = 0 ) const
 	{
-		return surfaces.size();
+		return lods[ InLODIndex ].surfaces.size();
 	}
 
 	/**
 	 * Get surfaces
+	 *
+	 * @param[in] InLODIndex Index of LOD
 	 * @return Return array surfaces
 	 */
-	FORCEINLINE const std::vector< SStaticMeshSurface > GetSurfaces() const
+	FORCEINLINE const std::vector< SStaticMeshSurface >& GetSurfaces( uint32 InLODIndex = 0 ) const
+	{
+		return lods[ InLODIndex ].surfaces;
+	}
+
+	/**
+	 * Get number of LODs
+	 * @return Return number of LODs, always at least one
+	 */
+	FORCEINLINE uint32 GetNumLODs() const
+	{
+		return lods.size();
+	}
+
+	/**
+	 * Get LODs
+	 * @return Return array LODs, the first one is the most detailed
+	 */
+	FORCEINLINE const std::vector< SStaticMeshLOD >& GetLODs() const
 	{
-		return surfaces;
+		return lods;
 	}
 
 	/**
@@ -339,12 +513,16 @@ private:
 	}
 
 	TRefCountPtr< CStaticMeshVertexFactory >	vertexFactory;				/**< Vertex factory */
+	TRefCountPtr< CStaticMeshDepthVertexFactory >	depthVertexFactory;		/**< Position only vertex factory for depth prepass */
 	std::vector< TAssetHandle<CMaterial> >		materials;					/**< Array materials in mesh */
-	std::vector< SStaticMeshSurface >			surfaces;					/**< Array surfaces in mesh */
+	std::vector< SStaticMeshLOD >				lods;						/**< Array LODs in mesh, the first one is the most detailed */
 	CBulkData< SStaticMeshVertexType >			verteces;					/**< Array verteces to create RHI vertex buffer */
 	CBulkData< uint32 >							indeces;					/**< Array indeces to create RHI index buffer */
 	VertexBufferRHIRef_t						vertexBufferRHI;			/**< RHI vertex buffer */
+	VertexBufferRHIRef_t						depthVertexBufferRHI;		/**< RHI vertex buffer of positions for depth prepass */
 	IndexBufferRHIRef_t							indexBufferRHI;				/**< RHI index buffer */
+	std::vector< Vector4D >						occluderVerteces;			/**< Positions of verteces for occlusion culling, only for the render thread */
+	std::vector< uint32 >						occluderIndeces;			/**< Indeces of triangles for occlusion culling, only for the render thread */
 	ElementDrawingPolicyMap_t					elementDrawingPolicyMap;	/**< Map of adds a drawing policy link to SDGs */
 };
 
@@ -364,6 +542,21 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const SStaticMeshSurface&
 	return InArchive;
 }
 
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, SStaticMeshLOD& InValue )
+{
+	InArchive << InValue.surfaces;
+	InArchive << InValue.screenSize;
+	return InArchive;
+}
+
+FORCEINLINE CArchive& operator<<( CArchive& InArchive, const SStaticMeshLOD& InValue )
+{
+	check( InArchive.IsSaving() );
+	InArchive << InValue.surfaces;
+	InArchive << InValue.screenSize;
+	return InArchive;
+}
+
 FORCEINLINE CArchive& operator<<( CArchive& InArchive, TAssetHandle<CStaticMesh>& InValue )
 {
 	TAssetHandle<CAsset>	asset = InValue;
@@ -383,4 +576,6 @@ FORCEINLINE CArchive& operator<<( CArchive& InArchive, const TAssetHandle<CStati
 	return InArchive;
 }
 
+extern SStaticMeshLODStats		GStaticMeshLODStats;		/**< Statistics of static mesh LODs drawn in the last built view */
+
 #endif // !STATICMESH_H
\ No newline at end of file
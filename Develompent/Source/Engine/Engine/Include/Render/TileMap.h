@@ -0,0 +1,270 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <vector>
+
+#include "RenderResource.h"
+#include "Misc/RefCounted.h"
+#include "Math/Math.h"
+#include "Math/Rect.h"
+#include "Math/Box.h"
+#include "System/Archive.h"
+#include "Render/Material.h"
+#include "Render/VertexFactory/StaticMeshVertexFactory.h"
+#include "RHI/BaseBufferRHI.h"
+#include "RHI/TypesRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Size of tilemap chunk in tiles by X and Y
+ */
+#define TILEMAP_CHUNK_SIZE		32
+
+/**
+ * @ingroup Engine
+ * @brief Reference to CTileMap
+ */
+typedef TRefCountPtr< class CTileMap >				TileMapRef_t;
+
+/**
+ * @ingroup Engine
+ * @brief Tileset of tilemap
+ */
+struct STileMapTileset
+{
+	/**
+	 * @brief Constructor
+	 */
+	STileMapTileset()
+		: firstTileId( 1 )
+		, tileSize( 0.f, 0.f )
+	{}
+
+	uint32							firstTileId;		/**< ID of first tile in tileset */
+	Vector2D						tileSize;			/**< Size of tile */
+	TAssetHandle<CMaterial>			material;			/**< Material of tileset */
+	std::vector<RectFloat_t>		textureRects;		/**< Texture rect of each tile in range from 0 to 1 */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Layer of tilemap
+ */
+struct STileMapLayer
+{
+	/**
+	 * @brief Constructor
+	 */
+	STileMapLayer()
+		: depth( 0.f )
+	{}
+
+	float						depth;		/**< Depth of layer by Z */
+	std::vector<uint32>			tiles;		/**< ID of each tile, row by row from bottom. Zero is empty tile */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Surface of tilemap chunk, tiles with one tileset
+ */
+struct STileMapSurface
+{
+	uint32		tilesetIndex;		/**< Index of tileset */
+	uint32		firstIndex;			/**< First index */
+	uint32		numPrimitives;		/**< Number primitives in the surface */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Chunk of tilemap, it's square of TILEMAP_CHUNK_SIZE x TILEMAP_CHUNK_SIZE tiles and is culled in whole
+ */
+struct STileMapChunk
+{
+	CBox								bounds;			/**< Bound box in local space of tilemap */
+	std::vector<STileMapSurface>		surfaces;		/**< Surfaces, one per used tileset */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Tilemap data for rendering tiles and building collision
+ *
+ * Layers store only IDs of tiles, mesh is built from them by chunks. All layers of chunk with one tileset
+ * are in one surface, so chunk is drawn by one draw call per tileset instead of one draw call per tile
+ */
+class CTileMap : public CRenderResource, public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTileMap();
+
+	/**
+	 * @brief Serialize
+	 * @param InArchive		Archive
+	 */
+	void Serialize( class CArchive& InArchive );
+
+	/**
+	 * @brief Set data of tilemap
+	 *
+	 * @param InNumTilesX		Number of tiles by X
+	 * @param InNumTilesY		Number of tiles by Y
+	 * @param InTileSize		Size of tile in grid
+	 * @param InTilesets		Array of tilesets
+	 * @param InLayers			Array of layers, each has InNumTilesX * InNumTilesY tiles
+	 * @param InCollision		Collision flag of each tile in grid, may be empty if tilemap hasn't collision
+	 */
+	void SetData( uint32 InNumTilesX, uint32 InNumTilesY, const Vector2D& InTileSize, const std::vector<STileMapTileset>& InTilesets, const std::vector<STileMapLayer>& InLayers, const std::vector<byte>& InCollision );
+
+	/**
+	 * @brief Build collision rects
+	 * Solid tiles are merged into as big as possible rects, so physics has a few bodies instead of one per tile
+	 *
+	 * @param OutRects		Output array of rects in local space of tilemap
+	 */
+	void BuildCollisionRects( std::vector<RectFloat_t>& OutRects ) const;
+
+	/**
+	 * @brief Get number of tiles by X
+	 * @return Return number of tiles by X
+	 */
+	FORCEINLINE uint32 GetNumTilesX() const
+	{
+		return numTilesX;
+	}
+
+	/**
+	 * @brief Get number of tiles by Y
+	 * @return Return number of tiles by Y
+	 */
+	FORCEINLINE uint32 GetNumTilesY() const
+	{
+		return numTilesY;
+	}
+
+	/**
+	 * @brief Get size of tile in grid
+	 * @return Return size of tile in grid
+	 */
+	FORCEINLINE const Vector2D& GetTileSize() const
+	{
+		return tileSize;
+	}
+
+	/**
+	 * @brief Get tilesets
+	 * @return Return array of tilesets
+	 */
+	FORCEINLINE const std::vector<STileMapTileset>& GetTilesets() const
+	{
+		return tilesets;
+	}
+
+	/**
+	 * @brief Get layers
+	 * @return Return array of layers
+	 */
+	FORCEINLINE const std::vector<STileMapLayer>& GetLayers() const
+	{
+		return layers;
+	}
+
+	/**
+	 * @brief Get chunks
+	 * @return Return array of chunks
+	 */
+	FORCEINLINE const std::vector<STileMapChunk>& GetChunks() const
+	{
+		return chunks;
+	}
+
+	/**
+	 * @brief Get bound box of all tiles
+	 * @return Return bound box in local space of tilemap
+	 */
+	FORCEINLINE const CBox& GetBounds() const
+	{
+		return bounds;
+	}
+
+	/**
+	 * @brief Is tilemap has collision
+	 * @return Return TRUE if any tile is solid, otherwise returns FALSE
+	 */
+	FORCEINLINE bool HasCollision() const
+	{
+		return !collision.empty();
+	}
+
+	/**
+	 * @brief Get vertex factory
+	 * @return Return vertex factory
+	 */
+	FORCEINLINE TRefCountPtr<CStaticMeshVertexFactory> GetVertexFactory() const
+	{
+		return vertexFactory;
+	}
+
+	/**
+	 * @brief Get RHI index buffer
+	 * @return Return RHI index buffer, if not created return nullptr
+	 */
+	FORCEINLINE IndexBufferRHIRef_t GetIndexBufferRHI() const
+	{
+		return indexBufferRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	/**
+	 * @brief Find tileset of tile
+	 *
+	 * @param InTileId	ID of tile
+	 * @return Return index of tileset, if not found returns INDEX_NONE
+	 */
+	uint32 FindTileset( uint32 InTileId ) const;
+
+	/**
+	 * @brief Build verteces and indeces of chunks from layers
+	 */
+	void BuildChunks();
+
+	uint32									numTilesX;			/**< Number of tiles by X */
+	uint32									numTilesY;			/**< Number of tiles by Y */
+	Vector2D								tileSize;			/**< Size of tile in grid */
+	CBox									bounds;				/**< Bound box of all tiles */
+	std::vector<STileMapTileset>			tilesets;			/**< Tilesets */
+	std::vector<STileMapLayer>				layers;				/**< Layers */
+	std::vector<byte>						collision;			/**< Collision flag of each tile in grid */
+	std::vector<STileMapChunk>				chunks;				/**< Chunks */
+	std::vector<SStaticMeshVertexType>		verteces;			/**< Verteces of chunks to create RHI vertex buffer */
+	std::vector<uint32>						indeces;			/**< Indeces of chunks to create RHI index buffer */
+	TRefCountPtr<CStaticMeshVertexFactory>	vertexFactory;		/**< Vertex factory */
+	VertexBufferRHIRef_t					vertexBufferRHI;	/**< RHI vertex buffer */
+	IndexBufferRHIRef_t						indexBufferRHI;		/**< RHI index buffer */
+};
+
+#endif // !TILEMAP_H
@@ -16,10 +16,7 @@
 #include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 #include "Render/RenderUtils.h"
 
-#include "Components/LightComponent.h"
-#include "Components/PointLightComponent.h"
-#include "Components/SpotLightComponent.h"
-#include "Components/DirectionalLightComponent.h"
+#include "Render/SceneProxy.h"
 
 /**
  * @ingroup Engine
@@ -114,37 +111,13 @@ public:
 	 * @brief Set the l2w transform shader
 	 *
 	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of point lights
+	 * @param InLights				List of light proxies, all lights must have type of vertex factory
 	 * @param InVertexFactory		Vertex factory
 	 * @param InView				Scene view
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CPointLightComponent>>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
-
-	/**
-	 * @brief Set the l2w transform shader
-	 *
-	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of spot lights
-	 * @param InVertexFactory		Vertex factory
-	 * @param InView				Scene view
-	 * @param InNumInstances		Number instances
-	 * @param InStartInstanceID		ID of first instance
-	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CSpotLightComponent>>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
-
-	/**
-	 * @brief Set the l2w transform shader
-	 *
-	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of directional lights
-	 * @param InVertexFactory		Vertex factory
-	 * @param InView				Scene view
-	 * @param InNumInstances		Number instances
-	 * @param InStartInstanceID		ID of first instance
-	 */
-	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CDirectionalLightComponent>>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const LightSceneProxyList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 };
 
 /**
@@ -187,37 +160,15 @@ public:
 	virtual void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const struct SMeshBatch& InMesh, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const override;
 
 	/**
-	 * @brief Setup instancing for point lights
-	 *
-	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of point lights
-	 * @param InView				Scene view
-	 * @param InNumInstances		Number instances
-	 * @param InStartInstanceID		ID of first instance
-	 */
-	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CPointLightComponent>>& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
-
-	/**
-	 * @brief Setup instancing for spot lights
-	 *
-	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of spot lights
-	 * @param InView				Scene view
-	 * @param InNumInstances		Number instances
-	 * @param InStartInstanceID		ID of first instance
-	 */
-	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CSpotLightComponent>>& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
-
-	/**
-	 * @brief Setup instancing for directional lights
+	 * @brief Setup instancing for lights
 	 *
 	 * @param InDeviceContextRHI	RHI device context
-	 * @param InLights				List of spot lights
+	 * @param InLights				List of light proxies, all lights must have type of vertex factory
 	 * @param InView				Scene view
 	 * @param InNumInstances		Number instances
 	 * @param InStartInstanceID		ID of first instance
 	 */
-	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CDirectionalLightComponent>>& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
+	void SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const LightSceneProxyList_t& InLights, const class CSceneView* InView, uint32 InNumInstances = 1, uint32 InStartInstanceID = 0 ) const;
 
 	/**
 	 * @brief Get type hash
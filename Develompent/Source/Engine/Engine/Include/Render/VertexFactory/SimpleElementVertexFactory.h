@@ -33,6 +33,17 @@ struct SSimpleElementVertexType
 	}
 };
 
+/**
+ * @ingroup Engine
+ * Simple element thick line type, one instance of thick line draw. Quad of line is built in vertex shader
+ */
+struct SSimpleElementThickLineType
+{
+	Vector4D		start;			/**< Start of line, in W is thickness */
+	Vector4D		end;			/**< End of line */
+	CColor			color;			/**< Color */
+};
+
 /**
  * @ingroup Engine
  * The simple element vertex declaration resource type
@@ -78,6 +89,51 @@ private:
  */
 extern TGlobalResource< CSimpleElementVertexDeclaration >			GSimpleElementVertexDeclaration;
 
+/**
+ * @ingroup Engine
+ * The simple element thick line vertex declaration resource type
+ */
+class CSimpleElementThickLineDeclaration : public CRenderResource
+{
+public:
+	/**
+	 * @brief Get vertex declaration RHI
+	 * @return Return vertex declaration RHI
+	 */
+	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI()
+	{
+		if ( !vertexDeclarationRHI )
+		{
+			InitRHI();
+		}
+		return vertexDeclarationRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	VertexDeclarationRHIRef_t		vertexDeclarationRHI;		/**< Vertex declaration RHI */
+};
+
+/**
+ * @ingroup Engine
+ * Global resource of simple element thick line vertex declaration
+ */
+extern TGlobalResource< CSimpleElementThickLineDeclaration >		GSimpleElementThickLineDeclaration;
+
 /**
  * @ingroup Engine
  * Simple element vertex factory
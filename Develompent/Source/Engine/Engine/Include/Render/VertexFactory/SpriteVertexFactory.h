@@ -10,7 +10,6 @@
 #define SPRITEVERTEXFACTORY_H
 
 #include "Math/Math.h"
-#include "Math/Rect.h"
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 #include "Render/RenderUtils.h"
@@ -81,43 +80,11 @@ private:
  */
 extern TGlobalResource< CSpriteVertexDeclaration >			GSpriteVertexDeclaration;
 
-/**
- * @ingroup Engine
- * @brief Vertex factory shader parameters for sprites
- */
-class CSpriteVertexShaderParameters : public CGeneralVertexShaderParameters
-{
-public:
-	/**
-	 * Constructor
-	 */
-	CSpriteVertexShaderParameters();
-
-	/**
-	 * @brief Bind shader parameters
-	 *
-	 * @param InParameterMap Shader parameter map
-	 */
-	virtual void Bind( const class CShaderParameterMap& InParameterMap ) override;
-
-	/**
-	 * @brief Set any shader data specific to this vertex factory
-	 *
-	 * @param InDeviceContextRHI RHI device context
-	 * @param InVertexFactory Vertex factory
-	 */
-	virtual void Set( class CBaseDeviceContextRHI* InDeviceContextRHI, const class CVertexFactory* InVertexFactory ) const override;
-
-private:
-	CShaderParameter		flipVerticalParameter;		/**< Flag is need flip by vertical parameter */
-	CShaderParameter		flipHorizontalParameter;	/**< Flag is need flip by horizontal parameter */
-	CShaderParameter		textureRectParameter;		/**< Texture rect parameter */
-	CShaderParameter		spriteSizeParameter;		/**< Sprite size parameter */
-};
-
 /**
  * @ingroup Engine
  * Vertex factory for render sprites
+ *
+ * All parameters of sprite are in instance data, so one vertex factory is shared by all sprites of CSpriteBatch
  */
 class CSpriteVertexFactory : public CVertexFactory
 {
@@ -132,8 +99,9 @@ public:
 
 	/**
 	 * @brief Constructor
+	 * @param InSpriteBatch		Sprite batch which owns this vertex factory
 	 */
-	CSpriteVertexFactory();
+	CSpriteVertexFactory( class CSpriteBatch* InSpriteBatch );
 
 	/**
 	 * @brief Initializes the RHI resources used by this resource.
@@ -144,6 +112,7 @@ public:
 
 	/**
 	 * @brief Setup instancing
+	 * @note Instances are taken from sprite batch, instances of mesh batch are ignored
 	 *
 	 * @param InDeviceContextRHI RHI device context
 	 * @param InMesh Mesh data
@@ -167,83 +136,8 @@ public:
 	 */
 	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
 
-	/**
-	 * @brief Set texture rect
-	 * @param InTextureRect Texture rect
-	 */
-	FORCEINLINE void SetTextureRect( const RectFloat_t& InTextureRect )
-	{
-		textureRect = InTextureRect;
-	}
-
-	/**
-	 * @brief Get texture rect
-	 * @return Return texture rect
-	 */
-	FORCEINLINE const RectFloat_t& GetTextureRect() const
-	{
-		return textureRect;
-	}
-
-	/**
-	 * @brief Set sprite size
-	 * @param InSpriteSize Sprite size
-	 */
-	FORCEINLINE void SetSpriteSize( const Vector2D& InSpriteSize )
-	{
-		spriteSize = InSpriteSize;
-	}
-
-	/**
-	 * @brief Set flip by vertical
-	 * @param InFlipVertical Is need flip sprite by vertical
-	 */
-	FORCEINLINE void SetFlipVertical( bool InFlipVertical )
-	{
-		bFlipVertical = InFlipVertical;
-	}
-
-	/**
-	 * @brief Set flip by horizontal
-	 * @param InFlipHorizontal Is need flip sprite by horizontal
-	 */
-	FORCEINLINE void SetFlipHorizontal( bool InFlipHorizontal )
-	{
-		bFlipHorizontal = InFlipHorizontal;
-	}
-
-	/**
-	 * @brief Get sprite size
-	 * @return Return sprite size
-	 */
-	FORCEINLINE const Vector2D& GetSpriteSize() const
-	{
-		return spriteSize;
-	}
-
-	/**
-	 * @brief Is fliped by vertical
-	 * @return Return TRUE if sprite fliped by vertical
-	 */
-	FORCEINLINE bool IsFlipedVertical() const
-	{
-		return bFlipVertical;
-	}
-
-	/**
-	 * @brief Is fliped by horizontal
-	 * @return Return TRUE if sprite fliped by horizontal
-	 */
-	FORCEINLINE bool IsFlipedHorizontal() const
-	{
-		return bFlipHorizontal;
-	}
-
 private:
-	bool				bFlipVertical;		/**< Is need flip sprite by vertical */
-	bool				bFlipHorizontal;	/**< Is need flip sprite by horizontal */
-	RectFloat_t			textureRect;		/**< Texture rect */
-	Vector2D			spriteSize;			/**< Sprite size */
+	class CSpriteBatch*		spriteBatch;		/**< Sprite batch which owns this vertex factory */
 };
 
 //
@@ -119,6 +119,88 @@ public:
 	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
 };
 
+/**
+ * @ingroup Engine
+ * The static mesh position only vertex declaration resource type
+ */
+class CStaticMeshDepthVertexDeclaration : public CRenderResource
+{
+public:
+	/**
+	 * @brief Get vertex declaration RHI
+	 * @return Return vertex declaration RHI
+	 */
+	FORCEINLINE VertexDeclarationRHIRef_t GetVertexDeclarationRHI()
+	{
+		if ( !vertexDeclarationRHI )
+		{
+			InitRHI();
+		}
+		return vertexDeclarationRHI;
+	}
+
+protected:
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Releases the RHI resources used by this resource.
+	 * Called when the resource is released.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void ReleaseRHI() override;
+
+private:
+	VertexDeclarationRHIRef_t		vertexDeclarationRHI;		/**< Vertex declaration RHI */
+};
+
+/**
+ * @ingroup Engine
+ * Global resource of static mesh position only vertex declaration
+ */
+extern TGlobalResource< CStaticMeshDepthVertexDeclaration >		GStaticMeshDepthVertexDeclaration;
+
+/**
+ * @ingroup Engine
+ * Vertex factory for render static meshes in depth prepass. It has only stream of positions,
+ * so depth only pass fetches 16 bytes per vertex instead of whole SStaticMeshVertexType
+ */
+class CStaticMeshDepthVertexFactory : public CVertexFactory
+{
+	DECLARE_VERTEX_FACTORY_TYPE( CStaticMeshDepthVertexFactory )
+
+public:
+	enum EStreamSourceSlot
+	{
+		SSS_Main = 0		/**< Vertex buffer of positions */
+	};
+
+	/**
+	 * @brief Initializes the RHI resources used by this resource.
+	 * Called when the resource is initialized.
+	 * This is only called by the rendering thread.
+	 */
+	virtual void InitRHI() override;
+
+	/**
+	 * @brief Get type hash
+	 * @return Return hash of vertex factory
+	 */
+	virtual uint64 GetTypeHash() const override;
+
+	/**
+	 * @brief Construct vertex factory shader parameters
+	 * 
+	 * @param InShaderFrequency Shader frequency
+	 * @return Return instance of vertex factory shader parameters
+	 */
+	static CVertexFactoryShaderParameters* ConstructShaderParameters( EShaderFrequency InShaderFrequency );
+};
+
 //
 // Serialization
 //
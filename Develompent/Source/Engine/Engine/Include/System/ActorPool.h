@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ACTORPOOL_H
+#define ACTORPOOL_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "Misc/Types.h"
+#include "Misc/EngineTypes.h"
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of actor pool for one class
+ */
+struct SActorPoolStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SActorPoolStats()
+		: numHits( 0 )
+		, numMisses( 0 )
+		, numReturned( 0 )
+		, numDiscarded( 0 )
+		, peakSize( 0 )
+	{}
+
+	uint32		numHits;		/**< Number of spawns with actor from pool */
+	uint32		numMisses;		/**< Number of spawns when pool was empty */
+	uint32		numReturned;	/**< Number of destroyed actors returned to pool */
+	uint32		numDiscarded;	/**< Number of destroyed actors deleted because pool was full */
+	uint32		peakSize;		/**< Max number of free actors in pool */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Pool of destroyed actors for reuse in CWorld::SpawnActor
+ *
+ * Pooling is opt-in per class: in config (section 'Engine.ActorPool') or with RegisterClass. While world is playing,
+ * destroyed actors of registered classes are reset (see AActor::ResetForPool) and kept in pool instead of deleting,
+ * next spawn of the same class takes actor from pool without construction of actor and its components.
+ * State of components is restored from archetype, it's never spawned actor created once per class.
+ * Actor from pool has new handle, so old handles of destroyed actor stay invalid
+ */
+class CActorPool
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CActorPool();
+
+	/**
+	 * @brief Load settings and pooled classes from engine config (section 'Engine.ActorPool')
+	 */
+	void LoadFromConfig();
+
+	/**
+	 * @brief Register class for pooling
+	 *
+	 * @param InClass			Class of actors
+	 * @param InMaxSize			Max number of free actors in pool
+	 * @param InPrewarmSize		Number of actors which created in Prewarm()
+	 */
+	void RegisterClass( class CClass* InClass, uint32 InMaxSize, uint32 InPrewarmSize = 0 );
+
+	/**
+	 * @brief Fill pools with new actors up to prewarm size of each class
+	 */
+	void Prewarm();
+
+	/**
+	 * @brief Take actor from pool
+	 *
+	 * @param InClass	Class of actor
+	 * @return Return actor from pool, if class isn't pooled or pool is empty returns NULL
+	 */
+	ActorRef_t Acquire( class CClass* InClass );
+
+	/**
+	 * @brief Return destroyed actor to pool
+	 *
+	 * @param InActor	Destroyed actor
+	 * @return Return TRUE if actor is kept in pool, otherwise returns FALSE
+	 */
+	bool Release( ActorRef_t InActor );
+
+	/**
+	 * @brief Delete all free actors and archetypes in pools
+	 * @note Registered classes and statistics are kept
+	 */
+	void Empty();
+
+	/**
+	 * @brief Print statistics of pools into log
+	 */
+	void DumpStats() const;
+
+	/**
+	 * @brief Set enable pooling
+	 * @param InEnable	Is enable pooling
+	 */
+	FORCEINLINE void SetEnable( bool InEnable )
+	{
+		bEnable = InEnable;
+	}
+
+	/**
+	 * @brief Is enabled pooling
+	 * @return Return TRUE if pooling is enabled, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsEnabled() const
+	{
+		return bEnable;
+	}
+
+	/**
+	 * @brief Is class pooled
+	 *
+	 * @param InClass	Class of actor
+	 * @return Return TRUE if actors of class are pooled, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsPooledClass( class CClass* InClass ) const
+	{
+		return bEnable && pools.find( InClass ) != pools.end();
+	}
+
+private:
+	/**
+	 * @brief Pool of actors of one class
+	 */
+	struct SPool
+	{
+		/**
+		 * @brief Constructor
+		 */
+		SPool()
+			: maxSize( 0 )
+			, prewarmSize( 0 )
+		{}
+
+		uint32						maxSize;		/**< Max number of free actors */
+		uint32						prewarmSize;	/**< Number of actors created in Prewarm() */
+		ActorRef_t					archetype;		/**< Never spawned actor for reset free actors */
+		std::vector<ActorRef_t>		freeActors;		/**< Free actors */
+		SActorPoolStats				stats;			/**< Statistics */
+	};
+
+	/**
+	 * @brief Get archetype of pool, it's created on first call
+	 *
+	 * @param InClass	Class of actors
+	 * @param InPool	Pool of actors
+	 * @return Return archetype of pool
+	 */
+	static class AActor* GetArchetype( class CClass* InClass, SPool& InPool );
+
+	bool										bEnable;	/**< Is enabled pooling */
+	std::unordered_map<class CClass*, SPool>	pools;		/**< Pools of actors by class */
+};
+
+#endif // !ACTORPOOL_H
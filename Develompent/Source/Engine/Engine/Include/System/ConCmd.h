@@ -11,6 +11,7 @@
 
 #include <string>
 #include <vector>
+#include <unordered_map>
 
 #include "System/Delegate.h"
 
@@ -75,11 +76,11 @@ private:
 
 /**
  * @brief Get console commands
- * @return Return array of console commands
+ * @return Return map of console commands, key is name of command
  */
-FORCEINLINE std::vector<CConCmd*>& GetGlobalConCmds()
+FORCEINLINE std::unordered_map<std::wstring, CConCmd*>& GetGlobalConCmds()
 {
-	static std::vector<CConCmd*>	cmds;
+	static std::unordered_map<std::wstring, CConCmd*>	cmds;
 	return cmds;
 }
 
@@ -10,6 +10,8 @@
 #define CONVAR_H
 
 #include <string>
+#include <unordered_map>
+#include <type_traits>
 
 #include "System/Delegate.h"
 
@@ -166,14 +168,7 @@ public:
 	 */
 	FORCEINLINE int32 GetValueInt() const
 	{
-		if ( type != CVT_Int )
-		{
-			return 0;
-		}
-		else
-		{
-			return ( *( int32* )data );
-		}
+		return type == CVT_Int ? value.intValue : 0;
 	}
 
 	/**
@@ -182,14 +177,7 @@ public:
 	 */
 	FORCEINLINE float GetValueFloat() const
 	{
-		if ( type != CVT_Float )
-		{
-			return 0.f;
-		}
-		else
-		{
-			return ( *( float* )data );
-		}
+		return type == CVT_Float ? value.floatValue : 0.f;
 	}
 
 	/**
@@ -198,14 +186,7 @@ public:
 	 */
 	FORCEINLINE bool GetValueBool() const
 	{
-		if ( type != CVT_Bool )
-		{
-			return 0.f;
-		}
-		else
-		{
-			return ( *( bool* )data );
-		}
+		return type == CVT_Bool ? value.boolValue : false;
 	}
 
 	/**
@@ -214,14 +195,7 @@ public:
 	 */
 	FORCEINLINE std::wstring GetValueString() const
 	{
-		if ( type != CVT_String )
-		{
-			return TEXT( "" );
-		}
-		else
-		{
-			return ( *( std::wstring* )data );
-		}
+		return type == CVT_String ? stringValue : TEXT( "" );
 	}
 
 	/**
@@ -300,20 +274,186 @@ private:
 	std::wstring				helpText;		/**< Help text */
 	std::wstring				defaultValue;	/**< Default value */
 	EConVarType					type;			/**< Console variable type */
-	void*						data;			/**< Pointer to value */
 	float						minVar;			/**< Minimum value */
 	float						maxVar;			/**< Maximum value */
 	mutable COnChangeVar		onChangeVar;	/**< Change variable delegate */
+
+	/**
+	 * @brief Value of scalar types, it stored inline for reading without indirection
+	 */
+	union
+	{
+		int32					intValue;		/**< Integer value */
+		float					floatValue;		/**< Float value */
+		bool					boolValue;		/**< Bool value */
+	}							value;
+	std::wstring				stringValue;	/**< String value */
 };
 
 /**
  * @brief Get console variables
- * @return Return array of console variables
+ * @return Return map of console variables, key is name of variable
  */
-FORCEINLINE std::vector<CConVar*>& GetGlobalConVars()
+FORCEINLINE std::unordered_map<std::wstring, CConVar*>& GetGlobalConVars()
 {
-	static std::vector<CConVar*>	vars;
+	static std::unordered_map<std::wstring, CConVar*>	vars;
 	return vars;
 }
 
+/**
+ * @brief Get serial number of console variables
+ * @return Return reference to number which is changed on each registration and unregistration of console variable
+ */
+FORCEINLINE uint32& GetGlobalConVarsSerial()
+{
+	static uint32	serial = 0;
+	return serial;
+}
+
+/**
+ * @brief Find console variable by name
+ * 
+ * @param InName	Name of the console variable
+ * @return Return pointer to console variable is exist, otherwise will return NULL
+ */
+FORCEINLINE CConVar* FindGlobalConVar( const std::wstring& InName )
+{
+	std::unordered_map<std::wstring, CConVar*>&				vars = GetGlobalConVars();
+	std::unordered_map<std::wstring, CConVar*>::iterator	itVar = vars.find( InName );
+	return itVar != vars.end() ? itVar->second : nullptr;
+}
+
+/**
+ * @ingroup Engine
+ * @brief Typed reference to console variable by name
+ * 
+ * Console variable is searched on first access and again only when any console variable is registered or unregistered
+ * (e.g. module is unloaded), otherwise value is read through cached pointer.
+ * It is useful for access to console variables which declared in other modules.
+ * 
+ * Example usage:
+ * @code
+ * static TConVarRef<bool>		CVarRWireframe( TEXT( "r.wireframe" ) );
+ * if ( CVarRWireframe.GetValue() ) { ... }
+ * @endcode
+ */
+template< typename TType >
+class TConVarRef
+{
+public:
+	static_assert( std::is_same_v<TType, int32> || std::is_same_v<TType, float> || std::is_same_v<TType, bool> || std::is_same_v<TType, std::wstring>, "Console variable may be only int32, float, bool or std::wstring" );
+
+	/**
+	 * @brief Constructor
+	 * @param InName	Name of the console variable
+	 */
+	FORCEINLINE TConVarRef( const std::wstring& InName )
+		: name( InName )
+		, conVar( nullptr )
+		, conVarSerial( GetGlobalConVarsSerial() - 1 )
+	{}
+
+	/**
+	 * @brief Get value
+	 * @return Return value of console variable. If variable isn't exist will return default value of type
+	 */
+	FORCEINLINE TType GetValue() const
+	{
+		CConVar*	var = GetConVar();
+		if ( !var )
+		{
+			return TType();
+		}
+
+		if constexpr ( std::is_same_v<TType, int32> )
+		{
+			return var->GetValueInt();
+		}
+		else if constexpr ( std::is_same_v<TType, float> )
+		{
+			return var->GetValueFloat();
+		}
+		else if constexpr ( std::is_same_v<TType, bool> )
+		{
+			return var->GetValueBool();
+		}
+		else
+		{
+			return var->GetValueString();
+		}
+	}
+
+	/**
+	 * @brief Set value
+	 * @param InValue	New value
+	 */
+	FORCEINLINE void SetValue( const TType& InValue ) const
+	{
+		CConVar*	var = GetConVar();
+		if ( !var )
+		{
+			return;
+		}
+
+		if constexpr ( std::is_same_v<TType, int32> )
+		{
+			var->SetValueInt( InValue );
+		}
+		else if constexpr ( std::is_same_v<TType, float> )
+		{
+			var->SetValueFloat( InValue );
+		}
+		else if constexpr ( std::is_same_v<TType, bool> )
+		{
+			var->SetValueBool( InValue );
+		}
+		else
+		{
+			var->SetValueString( InValue );
+		}
+	}
+
+	/**
+	 * @brief Subscribe to changes of console variable
+	 * 
+	 * @param InCallback	Callback
+	 * @return Return pointer to added delegate, it need for unsubscribe. If variable isn't exist will return NULL
+	 */
+	FORCEINLINE CConVar::COnChangeVar::DelegateType_t* OnChangeVar( const CConVar::COnChangeVar::DelegateType_t& InCallback ) const
+	{
+		CConVar*	var = GetConVar();
+		return var ? var->OnChangeVar().Add( InCallback ) : nullptr;
+	}
+
+	/**
+	 * @brief Is valid reference
+	 * @return Return TRUE if console variable is exist
+	 */
+	FORCEINLINE bool IsValid() const
+	{
+		return GetConVar();
+	}
+
+	/**
+	 * @brief Get console variable
+	 * @return Return pointer to console variable, if him isn't exist will return NULL
+	 */
+	FORCEINLINE CConVar* GetConVar() const
+	{
+		// Variable may be registered later or unregistered (e.g. in other module), so we search him again when registry is changed
+		uint32		serial = GetGlobalConVarsSerial();
+		if ( conVarSerial != serial )
+		{
+			conVar			= FindGlobalConVar( name );
+			conVarSerial	= serial;
+		}
+		return conVar;
+	}
+
+private:
+	std::wstring			name;		/**< Name of the console variable */
+	mutable CConVar*		conVar;			/**< Cached pointer to console variable */
+	mutable uint32			conVarSerial;	/**< Serial number of console variables when pointer was cached */
+};
+
 #endif // !CONVAR_H
\ No newline at end of file
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SIGNIFICANCEMANAGER_H
+#define SIGNIFICANCEMANAGER_H
+
+#include <vector>
+
+#include "Misc/Types.h"
+#include "Math/Math.h"
+#include "Misc/EngineTypes.h"
+
+/**
+ * @ingroup Engine
+ * @brief Settings of significance manager
+ */
+struct SSignificanceSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	SSignificanceSettings()
+		: bEnable( false )
+		, bStaticActorsDormant( false )
+		, updateInterval( 0.25f )
+	{}
+
+	/**
+	 * @brief Load settings from engine config (section 'Engine.Tick')
+	 */
+	void LoadFromConfig();
+
+	bool					bEnable;				/**< Is enabled throttling of ticks by distance from view */
+	bool					bStaticActorsDormant;	/**< Is static actors and their components don't tick in game */
+	float					updateInterval;			/**< Interval in seconds between updates of significance */
+	std::vector<float>		distances;				/**< Ascending distances from view where tick interval changes */
+	std::vector<float>		tickIntervals;			/**< Tick intervals for actors farther than appropriate distance */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Manager which decreases tick frequency of far actors
+ *
+ * Actors which opted in (see AActor::SetTickBySignificance) are split into buckets by distance from active camera,
+ * each bucket sets throttle interval to tick functions of actor and its components
+ */
+class CSignificanceManager
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CSignificanceManager();
+
+	/**
+	 * @brief Apply settings
+	 * @param InSettings	Settings
+	 */
+	void ApplySettings( const SSignificanceSettings& InSettings );
+
+	/**
+	 * @brief Update significance of actors
+	 *
+	 * @param InActors		Actors of world
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	void Update( const std::vector<ActorRef_t>& InActors, float InDeltaTime );
+
+	/**
+	 * @brief Print statistics of buckets into log
+	 */
+	void DumpStats() const;
+
+	/**
+	 * @brief Get settings
+	 * @return Return settings
+	 */
+	FORCEINLINE const SSignificanceSettings& GetSettings() const
+	{
+		return settings;
+	}
+
+private:
+	SSignificanceSettings		settings;				/**< Settings */
+	float						timeSinceUpdate;		/**< Time since last update of significance */
+	std::vector<uint32>			numActorsInBuckets;		/**< Number of actors in each bucket after last update, last bucket is for nearest actors */
+};
+
+#endif // !SIGNIFICANCEMANAGER_H
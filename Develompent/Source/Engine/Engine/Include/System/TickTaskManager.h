@@ -0,0 +1,352 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TICKTASKMANAGER_H
+#define TICKTASKMANAGER_H
+
+#include <vector>
+#include <functional>
+
+#include "Misc/Types.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Engine
+ * @brief Enumeration of tick groups. Groups are ticked in order of declaration
+ */
+enum ETickingGroup
+{
+	TG_PrePhysics,			/**< Ticked before physics simulation */
+	TG_DuringPhysics,		/**< Ticked after simulation step, but before physics results are applied to actors. Must not depend on physics of current frame */
+	TG_PostPhysics,			/**< Ticked after physics results are applied to actors */
+	TG_PostUpdateWork,		/**< Ticked after all other groups, e.g. for cameras and effects which follow actors */
+	TG_NumGroups			/**< Number of tick groups */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of tick task manager in last frame
+ */
+struct STickStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	STickStats()
+		: numRegistered( 0 )
+		, numDormant( 0 )
+		, numTicked( 0 )
+		, numSkipped( 0 )
+	{}
+
+	uint32				numRegistered;		/**< Number of registered tick functions */
+	uint32				numDormant;			/**< Number of disabled tick functions, they aren't in schedule */
+	volatile int32		numTicked;			/**< Number of ticked functions */
+	volatile int32		numSkipped;			/**< Number of functions skipped by tick interval */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Base class of tick function registered in CTickTaskManager
+ *
+ * Tick functions in one group are ticked after all their prerequisites from the same group.
+ * Prerequisites from earlier groups are already ticked, prerequisites from later groups are ignored.
+ * Tick functions marked as parallel may be ticked on worker threads at the same time with other parallel functions,
+ * they must not change shared state directly and should use CTickTaskManager::EnqueueDeferredCommand instead.
+ * Disabled (dormant) tick functions are excluded from schedule and cost nothing per frame.
+ * Tick function with interval accumulates time between ticks and receives the accumulated time as delta
+ */
+class CTickFunction
+{
+public:
+	friend class CTickTaskManager;
+
+	/**
+	 * @brief Constructor
+	 */
+	CTickFunction();
+
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~CTickFunction();
+
+	/**
+	 * @brief Execute tick
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	virtual void ExecuteTick( float InDeltaTime ) = 0;
+
+	/**
+	 * @brief Add prerequisite, this tick function will be ticked after it
+	 * @param InPrerequisite	Prerequisite
+	 */
+	void AddPrerequisite( CTickFunction* InPrerequisite );
+
+	/**
+	 * @brief Remove prerequisite
+	 * @param InPrerequisite	Prerequisite
+	 */
+	void RemovePrerequisite( CTickFunction* InPrerequisite );
+
+	/**
+	 * @brief Set tick group
+	 * @param InTickGroup	Tick group
+	 */
+	void SetTickGroup( ETickingGroup InTickGroup );
+
+	/**
+	 * @brief Set is tick function may be ticked in parallel on worker threads
+	 * @param InIsTickInParallel	Is tick function thread-safe
+	 */
+	void SetTickInParallel( bool InIsTickInParallel );
+
+	/**
+	 * @brief Enable or disable tick
+	 * Disabled tick function stays registered, but it is removed from schedule until enabled again
+	 *
+	 * @param InIsEnabled	Is tick enabled
+	 */
+	void SetTickEnabled( bool InIsEnabled );
+
+	/**
+	 * @brief Set tick interval
+	 * @param InTickInterval	Interval in seconds between ticks. If 0 will be ticked every frame
+	 */
+	FORCEINLINE void SetTickInterval( float InTickInterval )
+	{
+		tickInterval = InTickInterval > 0.f ? InTickInterval : 0.f;
+	}
+
+	/**
+	 * @brief Set throttle interval, it is used by significance manager for decrease tick frequency
+	 * Effective interval is max of tick interval and throttle interval
+	 *
+	 * @param InThrottleInterval	Interval in seconds between ticks. If 0 throttling is disabled
+	 */
+	FORCEINLINE void SetThrottleInterval( float InThrottleInterval )
+	{
+		throttleInterval = InThrottleInterval > 0.f ? InThrottleInterval : 0.f;
+	}
+
+	/**
+	 * @brief Get tick interval
+	 * @return Return tick interval in seconds
+	 */
+	FORCEINLINE float GetTickInterval() const
+	{
+		return tickInterval;
+	}
+
+	/**
+	 * @brief Get throttle interval
+	 * @return Return throttle interval in seconds
+	 */
+	FORCEINLINE float GetThrottleInterval() const
+	{
+		return throttleInterval;
+	}
+
+	/**
+	 * @brief Get tick group
+	 * @return Return tick group
+	 */
+	FORCEINLINE ETickingGroup GetTickGroup() const
+	{
+		return tickGroup;
+	}
+
+	/**
+	 * @brief Is tick function may be ticked in parallel
+	 * @return Return TRUE if tick function may be ticked on worker threads
+	 */
+	FORCEINLINE bool IsTickInParallel() const
+	{
+		return bTickInParallel;
+	}
+
+	/**
+	 * @brief Is tick enabled
+	 * @return Return TRUE if tick is enabled
+	 */
+	FORCEINLINE bool IsTickEnabled() const
+	{
+		return bTickEnabled;
+	}
+
+	/**
+	 * @brief Is tick function registered in tick task manager
+	 * @return Return TRUE if tick function is registered
+	 */
+	FORCEINLINE bool IsRegistered() const
+	{
+		return tickTaskManager;
+	}
+
+	/**
+	 * @brief Get tick task manager where tick function is registered
+	 * @return Return tick task manager, if not registered returns NULL
+	 */
+	FORCEINLINE class CTickTaskManager* GetTickTaskManager() const
+	{
+		return tickTaskManager;
+	}
+
+private:
+	/**
+	 * @brief Mark schedule of tick task manager dirty
+	 */
+	void MarkScheduleDirty();
+
+	ETickingGroup						tickGroup;			/**< Tick group */
+	bool								bTickInParallel;	/**< Is tick function may be ticked on worker threads */
+	bool								bTickEnabled;		/**< Is tick enabled */
+	float								tickInterval;		/**< Interval in seconds between ticks */
+	float								throttleInterval;	/**< Interval in seconds between ticks set by significance manager */
+	float								accumulatedTime;	/**< Time accumulated since last tick */
+	std::vector<CTickFunction*>			prerequisites;		/**< Tick functions which must be ticked before this */
+	std::vector<CTickFunction*>			dependents;			/**< Tick functions which have this as prerequisite */
+	class CTickTaskManager*				tickTaskManager;	/**< Tick task manager where tick function is registered */
+	uint32								registeredIndex;	/**< Index in array of registered tick functions */
+	std::vector<CTickFunction*>*		scheduledList;		/**< List of tick level where tick function is scheduled */
+	uint32								scheduledIndex;		/**< Index in scheduled list */
+	uint32								tickLevel;			/**< Level in tick group, calculated on rebuild of schedule */
+	uint32								visitMark;			/**< Mark of visit for rebuild of schedule */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Manager of tick functions in world
+ *
+ * Each tick group is split into levels by prerequisites. Level is ticked in two phases: parallel functions are ticked
+ * on thread pool, after that serial functions are ticked on game thread. Deferred commands from ticks are
+ * executed serially after each level. Schedule is rebuilt only when tick functions are added, removed or changed
+ */
+class CTickTaskManager
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTickTaskManager();
+
+	/**
+	 * @brief Destructor
+	 */
+	~CTickTaskManager();
+
+	/**
+	 * @brief Register tick function
+	 * @param InTickFunction	Tick function
+	 */
+	void RegisterTickFunction( CTickFunction* InTickFunction );
+
+	/**
+	 * @brief Unregister tick function
+	 * @param InTickFunction	Tick function
+	 */
+	void UnregisterTickFunction( CTickFunction* InTickFunction );
+
+	/**
+	 * @brief Unregister all tick functions
+	 */
+	void UnregisterAllTickFunctions();
+
+	/**
+	 * @brief Begin new frame, resets statistics and rebuilds schedule if need
+	 */
+	void BeginFrame();
+
+	/**
+	 * @brief Tick all functions in tick group
+	 *
+	 * @param InTickGroup	Tick group
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	void RunTickGroup( ETickingGroup InTickGroup, float InDeltaTime );
+
+	/**
+	 * @brief Enqueue command which will be executed on game thread after current tick level
+	 * It is thread-safe, use it in parallel ticks for changing shared state
+	 *
+	 * @param InCommand		Command
+	 */
+	void EnqueueDeferredCommand( const std::function<void()>& InCommand );
+
+	/**
+	 * @brief Mark schedule dirty, it will be rebuilt before next tick group
+	 */
+	FORCEINLINE void MarkScheduleDirty()
+	{
+		bScheduleDirty = true;
+	}
+
+	/**
+	 * @brief Get statistics of last frame
+	 * @return Return statistics of last frame
+	 */
+	FORCEINLINE const STickStats& GetStats() const
+	{
+		return stats;
+	}
+
+	/**
+	 * @brief Get number of registered tick functions
+	 * @return Return number of registered tick functions
+	 */
+	FORCEINLINE uint32 GetNumTickFunctions() const
+	{
+		return ( uint32 )tickFunctions.size();
+	}
+
+private:
+	/**
+	 * @brief Functions of one level in tick group
+	 */
+	struct STickLevel
+	{
+		std::vector<CTickFunction*>		parallelFunctions;		/**< Functions ticked on thread pool */
+		std::vector<CTickFunction*>		serialFunctions;		/**< Functions ticked on game thread */
+	};
+
+	/**
+	 * @brief Rebuild levels of all tick groups
+	 */
+	void RebuildSchedule();
+
+	/**
+	 * @brief Calculate level of tick function in group
+	 *
+	 * @param InTickFunction	Tick function
+	 * @return Return level of tick function
+	 */
+	uint32 CalcTickLevel( CTickFunction* InTickFunction );
+
+	/**
+	 * @brief Execute all deferred commands
+	 */
+	void FlushDeferredCommands();
+
+	/**
+	 * @brief Execute tick function if it is enabled and its interval is elapsed
+	 *
+	 * @param InTickFunction	Tick function, may be NULL if it was unregistered during tick
+	 * @param InDeltaTime		The time since the last frame
+	 */
+	void ExecuteTickFunction( CTickFunction* InTickFunction, float InDeltaTime );
+
+	std::vector<CTickFunction*>				tickFunctions;						/**< Registered tick functions */
+	std::vector<STickLevel>					tickLevels[ TG_NumGroups ];			/**< Levels of tick groups */
+	bool									bScheduleDirty;						/**< Is need rebuild levels */
+	uint32									currentVisitMark;					/**< Current mark of visit for rebuild of schedule */
+	CCriticalSection						deferredCommandsCS;					/**< Critical section of deferred commands */
+	std::vector<std::function<void()>>		deferredCommands;					/**< Deferred commands */
+	STickStats								stats;								/**< Statistics of last frame */
+};
+
+#endif // !TICKTASKMANAGER_H
@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TRANSFORMHIERARCHY_H
+#define TRANSFORMHIERARCHY_H
+
+#include <vector>
+
+#include "Core.h"
+#include "Misc/Types.h"
+#include "Math/Math.h"
+#include "Math/Transform.h"
+#include "System/ThreadingBase.h"
+
+/**
+ * @ingroup Engine
+ * @brief Flags of transform in hierarchy
+ */
+enum ETransformFlags
+{
+	TF_None			= 0,		/**< Transform is up to date */
+	TF_DirtyWorld	= 1 << 0,	/**< World transform is stale */
+	TF_DirtyMatrix	= 1 << 1,	/**< World matrix is stale */
+	TF_Moved		= 1 << 2	/**< Transform is changed since last update, component must be notified */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Flat store of world transforms of scene components
+ *
+ * World transforms are kept in structure of arrays sorted by depth of attachment, so parents always precede children.
+ * Changing of relative transform only marks component and its children dirty. Dirty world transform is recalculated
+ * on first access or in Update() which runs once per frame over all transforms in hierarchy order and notifies moved
+ * components (see CSceneComponent::OnTransformChanged).
+ * Only game thread recalculates transforms on access, other threads (e.g. rendering) don't write into hierarchy
+ * and read transforms of the last Update()
+ */
+class CTransformHierarchy
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CTransformHierarchy();
+
+	/**
+	 * @brief Add transform of component
+	 *
+	 * @param InComponent	Scene component
+	 * @return Return index of transform in hierarchy
+	 */
+	uint32 AddTransform( class CSceneComponent* InComponent );
+
+	/**
+	 * @brief Remove transform of component
+	 * @param InIndex	Index of transform
+	 */
+	void RemoveTransform( uint32 InIndex );
+
+	/**
+	 * @brief Set parent of transform
+	 *
+	 * @param InIndex			Index of transform
+	 * @param InParentIndex		Index of parent transform or INDEX_NONE
+	 */
+	void SetParent( uint32 InIndex, uint32 InParentIndex );
+
+	/**
+	 * @brief Mark world transform of component and all its children dirty
+	 * @param InIndex	Index of transform
+	 */
+	void MarkDirty( uint32 InIndex );
+
+	/**
+	 * @brief Recalculate all dirty transforms and notify moved components
+	 */
+	void Update();
+
+	/**
+	 * @brief Get world location
+	 *
+	 * @param InIndex	Index of transform
+	 * @return Return world location
+	 */
+	FORCEINLINE const Vector& GetWorldLocation( uint32 InIndex )
+	{
+		EnsureWorldTransform( InIndex );
+		return worldLocations[ InIndex ];
+	}
+
+	/**
+	 * @brief Get world rotation
+	 *
+	 * @param InIndex	Index of transform
+	 * @return Return world rotation
+	 */
+	FORCEINLINE const Quaternion& GetWorldRotation( uint32 InIndex )
+	{
+		EnsureWorldTransform( InIndex );
+		return worldRotations[ InIndex ];
+	}
+
+	/**
+	 * @brief Get world scale
+	 *
+	 * @param InIndex	Index of transform
+	 * @return Return world scale
+	 */
+	FORCEINLINE const Vector& GetWorldScale( uint32 InIndex )
+	{
+		EnsureWorldTransform( InIndex );
+		return worldScales[ InIndex ];
+	}
+
+	/**
+	 * @brief Get world transform
+	 *
+	 * @param InIndex	Index of transform
+	 * @return Return world transform
+	 */
+	FORCEINLINE CTransform GetWorldTransform( uint32 InIndex )
+	{
+		EnsureWorldTransform( InIndex );
+		return CTransform( worldRotations[ InIndex ], worldLocations[ InIndex ], worldScales[ InIndex ] );
+	}
+
+	/**
+	 * @brief Get world matrix
+	 * @warning Reference is valid only until next adding of transform
+	 *
+	 * @param InIndex	Index of transform
+	 * @return Return world matrix
+	 */
+	FORCEINLINE const Matrix& GetWorldMatrix( uint32 InIndex )
+	{
+		check( InIndex < flags.size() );
+		if ( IsInGameThread() && ( flags[ InIndex ] & TF_DirtyMatrix ) )
+		{
+			EnsureWorldTransform( InIndex );
+			CalcWorldMatrix( InIndex );
+		}
+		return worldMatrices[ InIndex ];
+	}
+
+	/**
+	 * @brief Get number of transforms
+	 * @return Return number of transforms
+	 */
+	FORCEINLINE uint32 GetNumTransforms() const
+	{
+		return ( uint32 )components.size();
+	}
+
+private:
+	/**
+	 * @brief Recalculate world transform if it is dirty and we are in game thread
+	 * @param InIndex	Index of transform
+	 */
+	FORCEINLINE void EnsureWorldTransform( uint32 InIndex )
+	{
+		check( InIndex < flags.size() );
+		if ( IsInGameThread() && ( flags[ InIndex ] & TF_DirtyWorld ) )
+		{
+			CalcWorldTransform( InIndex );
+		}
+	}
+
+	/**
+	 * @brief Calculate world transform from parent and relative transform
+	 * @param InIndex	Index of transform
+	 */
+	void CalcWorldTransform( uint32 InIndex );
+
+	/**
+	 * @brief Calculate world matrix from world transform
+	 * @param InIndex	Index of transform
+	 */
+	void CalcWorldMatrix( uint32 InIndex );
+
+	/**
+	 * @brief Sort transforms by depth of attachment
+	 */
+	void SortByDepth();
+
+	std::vector<class CSceneComponent*>		components;			/**< Owner components */
+	std::vector<uint32>						parents;			/**< Indices of parent transforms */
+	std::vector<uint8>						flags;				/**< Flags of transforms (see ETransformFlags) */
+	std::vector<Vector>						worldLocations;		/**< World locations */
+	std::vector<Quaternion>					worldRotations;		/**< World rotations */
+	std::vector<Vector>						worldScales;		/**< World scales */
+	std::vector<Matrix>						worldMatrices;		/**< World matrices */
+	std::vector<class CSceneComponent*>		movedComponents;	/**< Moved components, used in Update() */
+	bool									bOrderDirty;		/**< Is need sort transforms by depth */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Global transform hierarchy of scene components
+ */
+extern CTransformHierarchy			GTransformHierarchy;
+
+#endif // !TRANSFORMHIERARCHY_H
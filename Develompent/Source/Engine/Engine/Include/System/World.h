@@ -17,6 +17,10 @@
 #include "Misc/PhysicsGlobals.h"
 #include "System/Archive.h"
 #include "Actors/Actor.h"
+#include "System/TickTaskManager.h"
+#include "System/SignificanceManager.h"
+#include "System/ActorPool.h"
+#include "System/WorldPartition.h"
 #include "PhysicsInterface.h"
 
 /**
@@ -48,6 +52,7 @@ public:
 
 	/**
 	 * Update world
+	 * Tick groups are ticked in order: TG_PrePhysics, physics simulation, TG_DuringPhysics, sync actors with physics, TG_PostPhysics and TG_PostUpdateWork
 	 * 
 	 * @param[in] InDeltaTime The time since the last tick
 	 */
@@ -76,11 +81,27 @@ public:
 
 	/**
 	 * Destroy actor in world
+	 * If world is playing, actor is marked as pending kill and destroyed after tick
+	 * 
 	 * @param InActor	Actor
 	 */
-	FORCEINLINE void DestroyActor( ActorRef_t InActor )
+	void DestroyActor( ActorRef_t InActor );
+
+	/**
+	 * Destroy actor in world by handle
+	 * 
+	 * @param InHandle	Handle of actor
+	 * @return Return TRUE if handle is valid and actor is destroyed or queued for destroy, otherwise returns FALSE
+	 */
+	FORCEINLINE bool DestroyActor( const ActorHandle_t& InHandle )
 	{
-		DestroyActor( InActor, false );
+		const ActorRef_t*	actor = actors.Find( InHandle );
+		if ( actor )
+		{
+			DestroyActor( *actor );
+			return true;
+		}
+		return false;
 	}
 
 	/**
@@ -157,27 +178,107 @@ public:
 		return scene;
 	}
 
+	/**
+	 * @brief Get tick task manager
+	 * @return Return tick task manager
+	 */
+	FORCEINLINE CTickTaskManager& GetTickTaskManager()
+	{
+		return tickTaskManager;
+	}
+
+	/**
+	 * @brief Enqueue command which will be executed on game thread after current tick level
+	 * Use it in thread-safe ticks for changing shared state (spawn and destroy actors, change other actors, etc)
+	 *
+	 * @param InCommand		Command
+	 */
+	FORCEINLINE void EnqueueTickCommand( const std::function<void()>& InCommand )
+	{
+		tickTaskManager.EnqueueDeferredCommand( InCommand );
+	}
+
+	/**
+	 * @brief Get significance manager
+	 * @return Return significance manager
+	 */
+	FORCEINLINE CSignificanceManager& GetSignificanceManager()
+	{
+		return significanceManager;
+	}
+
+	/**
+	 * @brief Get actor pool
+	 * @return Return actor pool
+	 */
+	FORCEINLINE CActorPool& GetActorPool()
+	{
+		return actorPool;
+	}
+
+	/**
+	 * @brief Get world partition
+	 * @return Return world partition
+	 */
+	FORCEINLINE CWorldPartition& GetWorldPartition()
+	{
+		return worldPartition;
+	}
+
 	/**
 	 * @brief Get number of actors
 	 * @return Return number of actors
 	 */
 	FORCEINLINE uint32 GetNumActors() const
 	{
-		return actors.size();
+		return actors.Num();
 	}
 
 	/**
 	 * @brief Get actor by index
+	 * @warning Order of actors changes after destroying actor, for keeping reference to actor use ActorHandle_t
 	 * 
 	 * @param InIndex	Index
 	 * @return Return actor
 	 */
 	FORCEINLINE ActorRef_t GetActor( uint32 InIndex ) const
 	{
-		check( InIndex >= 0 && InIndex < actors.size() );
 		return actors[ InIndex ];
 	}
 
+	/**
+	 * @brief Get actor by handle
+	 * 
+	 * @param InHandle	Handle of actor
+	 * @return Return actor, if actor is destroyed returns NULL
+	 */
+	FORCEINLINE ActorRef_t GetActor( const ActorHandle_t& InHandle ) const
+	{
+		const ActorRef_t*	actor = actors.Find( InHandle );
+		return actor ? *actor : nullptr;
+	}
+
+	/**
+	 * @brief Is actor with handle alive
+	 * 
+	 * @param InHandle	Handle of actor
+	 * @return Return TRUE if actor is in world, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsValidActor( const ActorHandle_t& InHandle ) const
+	{
+		return actors.IsValid( InHandle );
+	}
+
+	/**
+	 * @brief Get array of actors
+	 * @warning Order of actors changes after destroying actor
+	 * @return Return array of actors
+	 */
+	FORCEINLINE const std::vector<ActorRef_t>& GetActors() const
+	{
+		return actors.GetElements();
+	}
+
 #if WITH_EDITOR
 	/**
 	 * @brief Get selected actors
@@ -224,19 +325,44 @@ public:
 	}
 #endif // WITH_EDITOR
 
-private:
 	/**
-	 * Destroy actor in world
+	 * Save actors to archive
+	 * Since VER_WorldClassTable world has table of classes and data of all actors in one blob
+	 * 
+	 * @param InArchive		Archive
+	 * @param InActors		Actors to save
+	 */
+	void SaveActors( CArchive& InArchive, const std::vector<ActorRef_t>& InActors );
+
+	/**
+	 * Load actors from archive and spawn them in world
 	 * 
-	 * @param InActor				Actor
-	 * @param InIsIgnorePlaying		Is need ignore playing flag in actor
+	 * @param InArchive		Archive
+	 * @param OutActors		Output array of spawned actors, may be NULL
+	 */
+	void LoadActors( CArchive& InArchive, std::vector<ActorRef_t>* OutActors = nullptr );
+
+private:
+
+	/**
+	 * Remove actor from world and call its events of destroy
+	 * @param InActor	Actor
+	 */
+	void RemoveActor( ActorRef_t InActor );
+
+	/**
+	 * Destroy actors from queue of destroy
 	 */
-	void DestroyActor( ActorRef_t InActor, bool InIsIgnorePlaying );
+	void FlushActorsToDestroy();
 
 	bool						isBeginPlay;		/**< Is started gameplay */
 	class CBaseScene*			scene;				/**< Scene manager */
-	std::vector<ActorRef_t>		actors;				/**< Array actors in world */
+	TSlotMap<ActorRef_t>		actors;				/**< Actors in world */
 	std::vector<ActorRef_t>		actorsToDestroy;	/**< Array actors which need destroy after tick */
+	CTickTaskManager			tickTaskManager;	/**< Tick task manager */
+	CSignificanceManager		significanceManager;	/**< Significance manager */
+	CActorPool					actorPool;			/**< Pool of destroyed actors */
+	CWorldPartition				worldPartition;		/**< Partition of static actors for streaming */
 
 #if WITH_EDITOR
 	bool						bDirty;				/**< Is world dirty and need save */
@@ -0,0 +1,309 @@
+/**
+ * @file
+ * @addtogroup Engine Engine
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef WORLDPARTITION_H
+#define WORLDPARTITION_H
+
+#include <string>
+#include <vector>
+
+#include "Misc/Types.h"
+#include "Misc/RefCounted.h"
+#include "Misc/RefCountPtr.h"
+#include "Misc/EngineTypes.h"
+#include "Math/Math.h"
+#include "System/Archive.h"
+
+/**
+ * @ingroup Engine
+ * @brief Settings of world partition
+ */
+struct SWorldPartitionSettings
+{
+	/**
+	 * @brief Constructor
+	 */
+	SWorldPartitionSettings()
+		: bEnable( false )
+		, cellSize( 2048.f )
+		, loadRange( 4096.f )
+		, unloadRange( 6144.f )
+		, memoryBudget( 256 )
+		, maxConcurrentLoads( 2 )
+		, maxCellsSpawnedPerFrame( 1 )
+	{}
+
+	/**
+	 * @brief Load settings from engine config (section 'Engine.WorldPartition')
+	 */
+	void LoadFromConfig();
+
+	bool		bEnable;					/**< Is need split static actors into cells while cooking maps */
+	float		cellSize;					/**< Size of cell */
+	float		loadRange;					/**< Cells nearer than this distance from streaming source are loaded */
+	float		unloadRange;				/**< Cells farther than this distance from all streaming sources are unloaded, must be bigger than loadRange */
+	uint32		memoryBudget;				/**< Max size of loaded cells data in megabytes */
+	uint32		maxConcurrentLoads;			/**< Max number of cells in queue of streaming thread */
+	uint32		maxCellsSpawnedPerFrame;	/**< Max number of loaded cells which spawn actors in one frame */
+};
+
+/**
+ * @ingroup Engine
+ * @brief State of world partition cell
+ */
+enum ECellState
+{
+	CS_Unloaded,		/**< Actors of cell aren't in world */
+	CS_Loading,			/**< Data of cell is reading from disk */
+	CS_Loaded,			/**< Data of cell is read, actors will be spawned when allowed by budget */
+	CS_Visible			/**< Actors of cell are spawned in world */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Statistics of world partition
+ */
+struct SWorldPartitionStats
+{
+	/**
+	 * @brief Constructor
+	 */
+	SWorldPartitionStats()
+		: numCells( 0 )
+		, numLoadingCells( 0 )
+		, numVisibleCells( 0 )
+		, loadedMemory( 0 )
+		, numStreamedIn( 0 )
+		, numStreamedOut( 0 )
+	{}
+
+	uint32		numCells;			/**< Number of cells */
+	uint32		numLoadingCells;	/**< Number of cells which are reading from disk or wait for spawn */
+	uint32		numVisibleCells;	/**< Number of cells with spawned actors */
+	uint32		loadedMemory;		/**< Size of data of loading and visible cells in bytes */
+	uint32		numStreamedIn;		/**< Number of cells streamed in since begin play */
+	uint32		numStreamedOut;		/**< Number of cells streamed out since begin play */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Request of reading world partition cell from disk
+ * It is shared between game thread and streaming thread
+ */
+class CWorldCellLoadRequest : public CRefCounted
+{
+public:
+	/**
+	 * @brief Constructor
+	 */
+	CWorldCellLoadRequest()
+		: offset( 0 )
+		, size( 0 )
+		, bCompleted( 0 )
+		, bFailed( false )
+	{}
+
+	std::wstring			path;			/**< Path to map file */
+	uint32					offset;			/**< Offset of cell data in file */
+	uint32					size;			/**< Size of cell data */
+	std::vector<byte>		data;			/**< Read data */
+	volatile int32			bCompleted;		/**< Is reading completed */
+	bool					bFailed;		/**< Is reading failed */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Grid based partition of world for streaming
+ *
+ * While cooking map static actors are split into cells of grid on XY plane (see Build), data of each cell
+ * is stored in map file after always loaded actors. In game cells are read from disk in streaming thread
+ * around streaming sources (active camera by default) and their actors are spawned in world, far cells are unloaded.
+ * Load and unload ranges are different, so cells on border aren't reloaded each frame
+ */
+class CWorldPartition
+{
+public:
+	/**
+	 * @brief Constructor
+	 * @param InWorld	World which owns this partition
+	 */
+	CWorldPartition( class CWorld* InWorld );
+
+	/**
+	 * @brief Destructor
+	 */
+	~CWorldPartition();
+
+	/**
+	 * @brief Apply settings
+	 * @param InSettings	Settings
+	 */
+	void ApplySettings( const SWorldPartitionSettings& InSettings );
+
+	/**
+	 * @brief Split static actors of world into cells
+	 * @note Used while cooking map. Partitioned actors are removed from world, their data is kept in cells
+	 */
+	void Build();
+
+	/**
+	 * @brief Serialize partition
+	 * On loading only table of cells is read, data of cells is read later while streaming
+	 *
+	 * @param InArchive		Archive
+	 */
+	void Serialize( CArchive& InArchive );
+
+	/**
+	 * @brief Update streaming of cells
+	 * @param InDeltaTime	The time since the last tick
+	 */
+	void Update( float InDeltaTime );
+
+	/**
+	 * @brief Load all cells around streaming sources and spawn their actors without budgets
+	 * Used on begin play and after teleport of player (respawn, travel) for avoid empty world around player
+	 */
+	void FlushStreaming();
+
+	/**
+	 * @brief Load all cells and spawn their actors, after that partition is removed
+	 * @note Used in editor, where map is edited in whole
+	 */
+	void LoadAllCells();
+
+	/**
+	 * @brief Remove all cells, actors of visible cells aren't destroyed
+	 */
+	void Clear();
+
+	/**
+	 * @brief Add streaming source
+	 * @param InSource	Scene component around which cells are loaded (e.g camera of player)
+	 */
+	void AddStreamingSource( class CSceneComponent* InSource );
+
+	/**
+	 * @brief Remove streaming source
+	 * @param InSource	Scene component
+	 */
+	void RemoveStreamingSource( class CSceneComponent* InSource );
+
+	/**
+	 * @brief Print statistics of partition into log
+	 */
+	void DumpStats() const;
+
+	/**
+	 * @brief Is world partitioned
+	 * @return Return TRUE if world has cells, otherwise returns FALSE
+	 */
+	FORCEINLINE bool IsPartitioned() const
+	{
+		return !cells.empty();
+	}
+
+	/**
+	 * @brief Get settings
+	 * @return Return settings
+	 */
+	FORCEINLINE const SWorldPartitionSettings& GetSettings() const
+	{
+		return settings;
+	}
+
+	/**
+	 * @brief Get statistics
+	 * @return Return statistics
+	 */
+	FORCEINLINE const SWorldPartitionStats& GetStats() const
+	{
+		return stats;
+	}
+
+private:
+	/**
+	 * @brief Cell of partition
+	 */
+	struct SCell
+	{
+		/**
+		 * @brief Constructor
+		 */
+		SCell()
+			: x( 0 )
+			, y( 0 )
+			, numActors( 0 )
+			, dataOffset( 0 )
+			, dataSize( 0 )
+			, state( CS_Unloaded )
+		{}
+
+		int32									x;				/**< Cell coordinate by X */
+		int32									y;				/**< Cell coordinate by Y */
+		uint32									numActors;		/**< Number of actors in cell */
+		uint32									dataOffset;		/**< Offset of cell data in map file */
+		uint32									dataSize;		/**< Size of cell data */
+		ECellState								state;			/**< Current state */
+		std::vector<byte>						data;			/**< Data of actors, it's filled while cooking and between loading and spawn */
+		std::vector<ActorHandle_t>				actors;			/**< Handles of spawned actors */
+		TRefCountPtr<CWorldCellLoadRequest>		loadRequest;	/**< Active request of loading */
+	};
+
+	/**
+	 * @brief Get distance from nearest streaming source to cell
+	 *
+	 * @param InCell	Cell
+	 * @param InSourceLocations		Locations of streaming sources
+	 * @return Return distance on XY plane
+	 */
+	float GetDistanceToCell( const SCell& InCell, const std::vector<Vector>& InSourceLocations ) const;
+
+	/**
+	 * @brief Get locations of streaming sources
+	 * @param OutLocations	Output locations
+	 */
+	void GetSourceLocations( std::vector<Vector>& OutLocations ) const;
+
+	/**
+	 * @brief Start reading cell data in streaming thread
+	 * @param InCell	Cell
+	 */
+	void StartLoadCell( SCell& InCell );
+
+	/**
+	 * @brief Read cell data in current thread
+	 * @param InCell	Cell
+	 */
+	void LoadCellSync( SCell& InCell );
+
+	/**
+	 * @brief Spawn actors of loaded cell
+	 * @param InCell	Cell
+	 */
+	void SpawnCellActors( SCell& InCell );
+
+	/**
+	 * @brief Destroy actors of cell
+	 * @param InCell	Cell
+	 */
+	void UnloadCell( SCell& InCell );
+
+	class CWorld*									world;				/**< World which owns this partition */
+	SWorldPartitionSettings							settings;			/**< Settings */
+	SWorldPartitionStats							stats;				/**< Statistics */
+	float											cellSize;			/**< Size of cell which map was cooked with */
+	uint32											mapVer;				/**< Version of map file */
+	std::wstring									mapPath;			/**< Path to map file */
+	std::vector<SCell>								cells;				/**< Cells */
+	std::vector<TRefCountPtr<class CSceneComponent>>	streamingSources;	/**< Streaming sources, if empty is used active camera */
+	class CWorldStreamingRunnable*					streamingRunnable;	/**< Runnable of streaming thread */
+	class CRunnableThread*							streamingThread;	/**< Streaming thread, it's created on first loading of cell */
+};
+
+#endif // !WORLDPARTITION_H
@@ -5,6 +5,15 @@
 
 IMPLEMENT_CLASS( AActor )
 
+CActorTickFunction::CActorTickFunction( class AActor* InActor )
+	: actor( InActor )
+{}
+
+void CActorTickFunction::ExecuteTick( float InDeltaTime )
+{
+	actor->Tick( InDeltaTime );
+}
+
 #if WITH_EDITOR
 CActorVar::CActorVar()
 	: type( AVT_Unknown )
@@ -48,14 +57,19 @@ AActor::AActor()
 	, bNeedReinitCollision( false )
 	, bActorIsBeingDestroyed( false )
 	, bBeginPlay( false )
+	, bTickBySignificance( false )
+	, bTickDormant( false )
+	, bTickDormantByWorld( false )
 
 #if WITH_EDITOR
 	, bSelected( false )
 #endif // WITH_EDITOR
+	, actorTick( this )
 {}
 
 AActor::~AActor()
 {
+	UnregisterTickFunctions();
 	ResetOwnedComponents();
 }
 
@@ -81,10 +95,7 @@ void AActor::EndPlay()
 
 void AActor::Tick( float InDeltaTime )
 {
-	for ( uint32 index = 0, count = ( uint32 )ownedComponents.size(); index < count; ++index )
-	{
-		ownedComponents[ index ]->TickComponent( InDeltaTime );
-	}
+	// Components are ticked by own tick functions (see RegisterTickFunctions)
 
 	// Reinit collision if need
 	if ( bNeedReinitCollision )
@@ -126,10 +137,10 @@ void AActor::Spawned()
 
 bool AActor::Destroy()
 {
+	// World marks actor as pending kill
 	if ( !bActorIsBeingDestroyed )
 	{
 		GWorld->DestroyActor( this );
-		bActorIsBeingDestroyed = true;
 	}
 	return bActorIsBeingDestroyed;
 }
@@ -155,6 +166,31 @@ void AActor::Destroyed()
 	onActorDestroyed.Broadcast( this );
 }
 
+void AActor::ResetForPool( const AActor* InArchetype )
+{
+	// Components created at runtime haven't pair in archetype, they are reset without it
+	for ( uint32 index = 0, count = ( uint32 )ownedComponents.size(); index < count; ++index )
+	{
+		const CActorComponent*		archetypeComponent = nullptr;
+		if ( InArchetype && index < InArchetype->ownedComponents.size() && InArchetype->ownedComponents[ index ]->GetClass() == ownedComponents[ index ]->GetClass() )
+		{
+			archetypeComponent = InArchetype->ownedComponents[ index ];
+		}
+		ownedComponents[ index ]->ResetForPool( archetypeComponent );
+	}
+
+	// Listeners of destroyed actor must not be called for next spawn
+	onActorDestroyed.RemoveAll();
+
+	// Actor is alive again after reset
+	bActorIsBeingDestroyed	= false;
+	bNeedReinitCollision	= false;
+	bTickDormant			= false;
+	bTickDormantByWorld		= false;
+	UpdateTickDormancy();
+	SetTickThrottleInterval( 0.f );
+}
+
 void AActor::InitPhysics()
 {
 	if ( collisionComponent )
@@ -179,6 +215,62 @@ void AActor::SyncPhysics()
 	}
 }
 
+void AActor::RegisterTickFunctions( class CTickTaskManager* InTickTaskManager )
+{
+	check( InTickTaskManager );
+	InTickTaskManager->RegisterTickFunction( &actorTick );
+	for ( uint32 index = 0, count = ( uint32 )ownedComponents.size(); index < count; ++index )
+	{
+		InTickTaskManager->RegisterTickFunction( &ownedComponents[ index ]->GetComponentTick() );
+	}
+}
+
+void AActor::UnregisterTickFunctions()
+{
+	CTickTaskManager*		tickTaskManager = actorTick.GetTickTaskManager();
+	if ( !tickTaskManager )
+	{
+		return;
+	}
+
+	tickTaskManager->UnregisterTickFunction( &actorTick );
+	for ( uint32 index = 0, count = ( uint32 )ownedComponents.size(); index < count; ++index )
+	{
+		tickTaskManager->UnregisterTickFunction( &ownedComponents[ index ]->GetComponentTick() );
+	}
+}
+
+void AActor::SetTickDormant( bool InIsDormant )
+{
+	bTickDormant = InIsDormant;
+	UpdateTickDormancy();
+}
+
+void AActor::SetTickDormantByWorld( bool InIsDormant )
+{
+	bTickDormantByWorld = InIsDormant;
+	UpdateTickDormancy();
+}
+
+void AActor::UpdateTickDormancy()
+{
+	bool	bIsTickEnabled = !bTickDormant && !bTickDormantByWorld;
+	actorTick.SetTickEnabled( bIsTickEnabled );
+	for ( uint32 index = 0, count = ( uint32 )ownedComponents.size(); index < count; ++index )
+	{
+		ownedComponents[ index ]->GetComponentTick().SetTickEnabled( bIsTickEnabled );
+	}
+}
+
+void AActor::SetTickThrottleInterval( float InThrottleInterval )
+{
+	actorTick.SetThrottleInterval( InThrottleInterval );
+	for ( uint32 index = 0, count = ( uint32 )ownedComponents.size(); index < count; ++index )
+	{
+		ownedComponents[ index ]->GetComponentTick().SetThrottleInterval( InThrottleInterval );
+	}
+}
+
 #if WITH_EDITOR
 bool AActor::InitProperties( const std::vector<CActorVar>& InActorVars, class CCookPackagesCommandlet* InCooker )
 {
@@ -239,9 +331,17 @@ void AActor::AddOwnedComponent( class CActorComponent* InComponent )
 		}
 	}
 
-	// Add component
+	// Add component, actor is ticked after it
 	InComponent->SetOwner( this );
 	ownedComponents.push_back( InComponent );
+	actorTick.AddPrerequisite( &InComponent->GetComponentTick() );
+
+	// If actor already in world, component must be ticked too
+	CTickTaskManager*		tickTaskManager = actorTick.GetTickTaskManager();
+	if ( tickTaskManager )
+	{
+		tickTaskManager->RegisterTickFunction( &InComponent->GetComponentTick() );
+	}
 }
 
 void AActor::RemoveOwnedComponent( class CActorComponent* InComponent )
@@ -262,6 +362,13 @@ void AActor::RemoveOwnedComponent( class CActorComponent* InComponent )
 				check( false && "Need implement change root component" );
 			}
 
+			CTickTaskManager*		tickTaskManager = actorTick.GetTickTaskManager();
+			if ( tickTaskManager )
+			{
+				tickTaskManager->UnregisterTickFunction( &InComponent->GetComponentTick() );
+			}
+			actorTick.RemovePrerequisite( &InComponent->GetComponentTick() );
+
 			InComponent->SetOwner( nullptr );
 			ownedComponents.erase( ownedComponents.begin() + index );
 			return;
@@ -277,6 +384,13 @@ void AActor::ResetOwnedComponents()
 		{
 			collisionComponent->TermPrimitivePhysics();
 		}
+
+		CTickFunction&		componentTick = ownedComponents[ index ]->GetComponentTick();
+		if ( componentTick.IsRegistered() )
+		{
+			componentTick.GetTickTaskManager()->UnregisterTickFunction( &componentTick );
+		}
+		actorTick.RemovePrerequisite( &componentTick );
 		ownedComponents[ index ]->SetOwner( nullptr );
 	}
 
@@ -3,6 +3,15 @@
 
 IMPLEMENT_CLASS( CActorComponent )
 
+CActorComponentTickFunction::CActorComponentTickFunction( class CActorComponent* InComponent )
+	: component( InComponent )
+{}
+
+void CActorComponentTickFunction::ExecuteTick( float InDeltaTime )
+{
+	component->TickComponent( InDeltaTime );
+}
+
 CActorComponent::CActorComponent() 
 #if WITH_EDITOR
 	: bEditorOnly( false ),
@@ -10,6 +19,7 @@ CActorComponent::CActorComponent()
 	:
 #endif // WITH_EDITOR
 	 owner( nullptr )
+	, componentTick( this )
 {}
 
 CActorComponent::~CActorComponent()
@@ -28,4 +38,7 @@ void CActorComponent::Spawned()
 {}
 
 void CActorComponent::Destroyed()
+{}
+
+void CActorComponent::ResetForPool( const CActorComponent* InArchetype )
 {}
\ No newline at end of file
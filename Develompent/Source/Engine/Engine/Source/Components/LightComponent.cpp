@@ -11,6 +11,8 @@ CLightComponent::CLightComponent()
 	, lightColor( CColor::white )
 	, specularColor( CColor::white )
 	, intensivity( 22400.f )
+	, sceneProxy( nullptr )
+	, bSceneProxyDirty( false )
 {}
 
 CLightComponent::~CLightComponent()
@@ -25,6 +27,11 @@ void CLightComponent::Serialize( class CArchive& InArchive )
 {
 	Super::Serialize( InArchive );
 	InArchive << bEnabled;
+
+	if ( InArchive.IsLoading() )
+	{
+		MarkRenderStateDirty();
+	}
 }
 
 void CLightComponent::Spawned()
@@ -39,6 +46,20 @@ void CLightComponent::Destroyed()
 	GWorld->GetScene()->RemoveLight( this );
 }
 
+void CLightComponent::OnTransformChanged()
+{
+	Super::OnTransformChanged();
+	MarkRenderStateDirty();
+}
+
+void CLightComponent::MarkRenderStateDirty()
+{
+	if ( scene )
+	{
+		scene->UpdateLight( this );
+	}
+}
+
 ELightType CLightComponent::GetLightType() const
 {
 	return LT_Unknown;
@@ -7,9 +7,10 @@
 IMPLEMENT_CLASS( CPrimitiveComponent )
 
 CPrimitiveComponent::CPrimitiveComponent()
-	: bIsDirtyDrawingPolicyLink( true )
-	, bVisibility( true )
+	: bVisibility( true )
 	, scene( nullptr )
+	, sceneProxy( nullptr )
+	, sceneProxyDirtyFlags( SPU_None )
 {}
 
 CPrimitiveComponent::~CPrimitiveComponent()
@@ -32,18 +33,22 @@ void CPrimitiveComponent::Destroyed()
 	GWorld->GetScene()->RemovePrimitive( this );
 }
 
-void CPrimitiveComponent::TickComponent( float InDeltaTime )
+void CPrimitiveComponent::ResetForPool( const CActorComponent* InArchetype )
 {
-	Super::TickComponent( InDeltaTime );
-
-	// If body instance is dirty - reinit physics component
-	if ( bodyInstance.IsDirty() || bodySetup != bodyInstance.GetBodySetup() )
+	Super::ResetForPool( InArchetype );
+	if ( InArchetype )
 	{
-		TermPrimitivePhysics();
-		InitPrimitivePhysics();
+		// Body setup isn't restored because it shared with archetype, changes of it would be changed archetype too
+		SetVisibility( ( ( const CPrimitiveComponent* )InArchetype )->bVisibility );
 	}
 }
 
+void CPrimitiveComponent::TickComponent( float InDeltaTime )
+{
+	Super::TickComponent( InDeltaTime );
+	UpdatePrimitivePhysics();
+}
+
 void CPrimitiveComponent::Serialize( class CArchive& InArchive )
 {
 	Super::Serialize( InArchive );
@@ -59,17 +64,93 @@ void CPrimitiveComponent::Serialize( class CArchive& InArchive )
 	{
 		InArchive << bVisibility;
 	}
+
+	if ( InArchive.IsLoading() )
+	{
+		MarkRenderStateDirty( SPU_Visibility );
+	}
 }
 
+void CPrimitiveComponent::OnTransformChanged()
+{
+	Super::OnTransformChanged();
+	UpdateBounds();
+	MarkRenderStateDirty( SPU_Transform );
+
+	// Physics body already is in this location if component was moved by SyncComponentToPhysics
+	if ( bodyInstance.IsValid() )
+	{
+		CTransform		transform = GetComponentTransform();
+		CTransform		bodyTransform = bodyInstance.GetLEWorldTransform();
+
+#if ENGINE_2D
+		// For 2D game we copy to body transform Z coord (in 2D this is layer)
+		bodyTransform.AddToTranslation( Vector( 0.f, 0.f, transform.GetLocation().z ) );
+#endif // ENGINE_2D
+
+		if ( !transform.MatchesNoScale( bodyTransform ) )
+		{
+			bodyInstance.SetLEWorldTransform( transform );
+		}
+	}
+}
+
+void CPrimitiveComponent::UpdateBounds()
+{}
+
 void CPrimitiveComponent::LinkDrawList()
 {}
 
 void CPrimitiveComponent::UnlinkDrawList()
 {}
 
-void CPrimitiveComponent::AddToDrawList( const class CSceneView& InSceneView )
+void CPrimitiveComponent::AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
+{}
+
+void CPrimitiveComponent::OnCulled( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
 {}
 
+void CPrimitiveComponent::OnHidden( const class CPrimitiveSceneProxy& InSceneProxy )
+{}
+
+void CPrimitiveComponent::OnSceneProxyUpdated( const class CPrimitiveSceneProxy& InSceneProxy, uint32 InFlags )
+{}
+
+void CPrimitiveComponent::OnRemovedFromScene( class CScene* InScene, const class CPrimitiveSceneProxy& InSceneProxy )
+{}
+
+bool CPrimitiveComponent::AddOccluder( class COcclusionBuffer& InOcclusionBuffer, const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	return false;
+}
+
+Matrix CPrimitiveComponent::GetRenderMatrix() const
+{
+	return GetComponentMatrix();
+}
+
+void CPrimitiveComponent::MarkRenderStateDirty( uint32 InFlags )
+{
+	UpdatePhysicsOfDormant();
+
+	// Primitive out of scene is fully linked when it will be added to scene
+	if ( !scene )
+	{
+		return;
+	}
+
+	scene->UpdatePrimitive( this, InFlags );
+}
+
+void CPrimitiveComponent::UpdatePhysicsOfDormant()
+{
+	AActor*		actorOwner = GetOwner();
+	if ( actorOwner && actorOwner->IsPlaying() && !GetComponentTick().IsTickEnabled() )
+	{
+		UpdatePrimitivePhysics();
+	}
+}
+
 void CPrimitiveComponent::InitPrimitivePhysics()
 {
 	if ( bodySetup )
@@ -80,6 +161,16 @@ void CPrimitiveComponent::InitPrimitivePhysics()
 	}
 }
 
+void CPrimitiveComponent::UpdatePrimitivePhysics()
+{
+	// If body instance is dirty - reinit physics component
+	if ( bodyInstance.IsDirty() || bodySetup != bodyInstance.GetBodySetup() )
+	{
+		TermPrimitivePhysics();
+		InitPrimitivePhysics();
+	}
+}
+
 void CPrimitiveComponent::SyncComponentToPhysics()
 {
 	if ( bodyInstance.IsValid() )
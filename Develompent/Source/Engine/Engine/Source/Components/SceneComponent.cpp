@@ -1,12 +1,26 @@
+#include <algorithm>
+
 #include "Components/SceneComponent.h"
 
 IMPLEMENT_CLASS( CSceneComponent )
 
 CSceneComponent::CSceneComponent()
+	: transformIndex( GTransformHierarchy.AddTransform( this ) )
 {}
 
 CSceneComponent::~CSceneComponent()
-{}
+{
+	if ( attachParent )
+	{
+		std::vector< CSceneComponent* >&	parentChildren = attachParent->attachChildren;
+		std::vector< CSceneComponent* >::iterator	it = std::find( parentChildren.begin(), parentChildren.end(), this );
+		if ( it != parentChildren.end() )
+		{
+			parentChildren.erase( it );
+		}
+	}
+	GTransformHierarchy.RemoveTransform( transformIndex );
+}
 
 bool CSceneComponent::IsAttachedTo( CSceneComponent* InTestComp ) const
 {
@@ -27,8 +41,26 @@ void CSceneComponent::Serialize( class CArchive& InArchive )
 {
 	Super::Serialize( InArchive );
 	InArchive << transform;
+
+	if ( InArchive.IsLoading() )
+	{
+		GTransformHierarchy.MarkDirty( transformIndex );
+	}
 }
 
+void CSceneComponent::ResetForPool( const CActorComponent* InArchetype )
+{
+	Super::ResetForPool( InArchetype );
+	if ( InArchetype )
+	{
+		transform = ( ( const CSceneComponent* )InArchetype )->transform;
+		GTransformHierarchy.MarkDirty( transformIndex );
+	}
+}
+
+void CSceneComponent::OnTransformChanged()
+{}
+
 void CSceneComponent::SetupAttachment( CSceneComponent* InParent )
 {
 	checkMsg( InParent != this, TEXT( "Cannot attach a component to itself" ) );
@@ -36,4 +68,6 @@ void CSceneComponent::SetupAttachment( CSceneComponent* InParent )
 	checkMsg( !attachParent, TEXT( "Need detach before attach component" ) );
 
 	attachParent = InParent;
+	InParent->attachChildren.push_back( this );
+	GTransformHierarchy.SetParent( transformIndex, InParent->transformIndex );
 }
\ No newline at end of file
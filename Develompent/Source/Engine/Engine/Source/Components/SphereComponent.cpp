@@ -22,27 +22,31 @@ void CSphereComponent::Serialize( class CArchive& InArchive )
 void CSphereComponent::UpdateBodySetup()
 {}
 
-void CSphereComponent::AddToDrawList( const class CSceneView& InSceneView )
+void CSphereComponent::AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
 {
 	// If primitive is empty - exit from method
-	if ( !bIsDirtyDrawingPolicyLink && !meshBatchLink )
+	if ( !InSceneProxy.IsDirtyDrawingPolicyLink() && !meshBatchLink )
 	{
 		return;
 	}
 
 	// If drawing policy link is dirty - we update it
-	if ( bIsDirtyDrawingPolicyLink )
+	if ( InSceneProxy.IsDirtyDrawingPolicyLink() )
 	{
-		bIsDirtyDrawingPolicyLink = false;
 		LinkDrawList();
 	}
 
 	// Add to mesh batch new instance
+	++meshBatchLink->numInstances;
+	meshBatchLink->instances.push_back( SMeshInstance{ InSceneProxy.GetLocalToWorld() } );
+}
+
+Matrix CSphereComponent::GetRenderMatrix() const
+{
+	// Unit sphere mesh is scaled by radius
 	CTransform				transform = GetComponentTransform();
 	transform.SetScale( Vector( radius, radius, radius ) );
-
-	++meshBatchLink->numInstances;
-	meshBatchLink->instances.push_back( SMeshInstance{ transform.ToMatrix() } );
+	return transform.ToMatrix();
 }
 
 void CSphereComponent::LinkDrawList()
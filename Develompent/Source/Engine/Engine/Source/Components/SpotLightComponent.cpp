@@ -3,6 +3,9 @@
 IMPLEMENT_CLASS( CSpotLightComponent )
 
 CSpotLightComponent::CSpotLightComponent()
+	: radius( 850.f )
+	, innerConeAngle( 30.f )
+	, outerConeAngle( 45.f )
 {}
 
 ELightType CSpotLightComponent::GetLightType() const
@@ -8,30 +8,38 @@
 #include "Math/Rect.h"
 #include "Render/Shaders/BasePassShader.h"
 #include "Render/Texture.h"
+#include "Render/RenderingThread.h"
+
+#if WITH_EDITOR
+#include "Misc/WorldEdGlobals.h"
+#include "System/EditorEngine.h"
+#endif // WITH_EDITOR
 
 IMPLEMENT_CLASS( CSpriteComponent )
 
 CSpriteComponent::CSpriteComponent()
 #if WITH_EDITOR
-	: bGizmo( false ),
+	: bGizmo( false )
+	, bSelectedInstance( false ),
 #else
 	:
 #endif // WITH_EDITOR
-	  bFlipVertical( false )
-	, bFlipHorizontal( false )
-    , type( ST_Rotating )
+	  bIsDirtyInstance( true )
 	, sprite( new CSprite() )
-{
-	BeginInitResource( sprite );
-}
+	, instanceId( INDEX_NONE )
+	, SDGType( SDG_World )
+{}
 
 void CSpriteComponent::Serialize( class CArchive& InArchive )
 {
     Super::Serialize( InArchive );
 
+	ESpriteType				type			= GetType();
     RectFloat_t				textureRect     = GetTextureRect();
     Vector2D				spriteSize      = GetSpriteSize();
 	TAssetHandle<CMaterial>	material        = GetMaterial();
+	bool					bFlipVertical	= IsFlipedVertical();
+	bool					bFlipHorizontal	= IsFlipedHorizontal();
 
     InArchive << type;
     InArchive << textureRect;
@@ -42,6 +50,7 @@ void CSpriteComponent::Serialize( class CArchive& InArchive )
 
     if ( InArchive.IsLoading() )
     {
+		SetType( type );
         SetTextureRect( textureRect );
         SetSpriteSize( spriteSize );
         SetMaterial( material );
@@ -50,54 +59,101 @@ void CSpriteComponent::Serialize( class CArchive& InArchive )
     }
 }
 
-void CSpriteComponent::CalcTransformationMatrix( const class CSceneView& InSceneView, Matrix& OutResult ) const
+void CSpriteComponent::ResetForPool( const CActorComponent* InArchetype )
 {
-    CTransform      transform = GetComponentTransform();
-    if ( type == ST_Static )
-    {
-        transform.ToMatrix( OutResult );
-		return;
-    }
+	Super::ResetForPool( InArchetype );
+	if ( InArchetype )
+	{
+		const CSpriteComponent*		archetype = ( const CSpriteComponent* )InArchetype;
+		SetType( archetype->GetType() );
+		SetTextureRect( archetype->GetTextureRect() );
+		SetSpriteSize( archetype->GetSpriteSize() );
+		SetMaterial( archetype->GetMaterial() );
+		SetFlipVertical( archetype->IsFlipedVertical() );
+		SetFlipHorizontal( archetype->IsFlipedHorizontal() );
+	}
+}
 
-	SMath::IdentityMatrix( OutResult );
-	SMath::TranslateMatrix( transform.GetLocation(), OutResult );
-    
-	const Matrix&      viewMatrix = InSceneView.GetViewMatrix();
-	OutResult[ 0 ].x = viewMatrix[ 0 ].x;
-	OutResult[ 0 ].y = viewMatrix[ 1 ].x;
-	OutResult[ 0 ].z = viewMatrix[ 2 ].x;
+void CSpriteComponent::OnHidden( const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	// Hidden sprite isn't added to draw list, but its batch may be drawn by other sprites, so collapse instance
+	if ( spriteBatch )
+	{
+		spriteBatch->CollapseInstance( instanceId );
+		bIsDirtyInstance = true;
+	}
+}
 
-    if ( type == ST_RotatingOnlyVertical )
-    {
-		OutResult[ 1 ].x = 0;
-		OutResult[ 1 ].y = 1;
-		OutResult[ 1 ].z = 0;
-    }
-    else
-    {
-		OutResult[ 1 ].x = viewMatrix[ 0 ].y;
-		OutResult[ 1 ].y = viewMatrix[ 1 ].y;
-		OutResult[ 1 ].z = viewMatrix[ 2 ].y;
-    }
+void CSpriteComponent::OnSceneProxyUpdated( const class CPrimitiveSceneProxy& InSceneProxy, uint32 InFlags )
+{
+	// Instance is uploaded with matrix of scene proxy, so it's marked dirty only after new matrix is applied
+	if ( InFlags & ( SPU_Transform | SPU_Instance ) )
+	{
+		bIsDirtyInstance = true;
+	}
+}
+
+void CSpriteComponent::OnRemovedFromScene( class CScene* InScene, const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	RemoveFromDrawLists( InScene );
+}
+
+Matrix CSpriteComponent::GetRenderMatrix() const
+{
+	if ( GetType() == ST_Static )
+	{
+		return GetComponentMatrix();
+	}
 
-	OutResult[ 2 ].x = viewMatrix[ 0 ].z;
-	OutResult[ 2 ].y = viewMatrix[ 1 ].z;
-	OutResult[ 2 ].z = viewMatrix[ 2 ].z;
+	// Billboard is turned to camera in vertex shader, so here is only translation, scale and rotation of sprite in its plane
+	CTransform		transform = GetComponentTransform();
+	Matrix			result;
+	SMath::IdentityMatrix( result );
+	SMath::TranslateMatrix( transform.GetLocation(), result );
+	result *= SMath::ScaleMatrix( transform.GetScale() );
+	result *= SMath::QuaternionToMatrix( transform.GetRotation() );
+	return result;
+}
+
+void CSpriteComponent::UpdateInstance( const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	check( spriteBatch );
+	AActor*						owner = GetOwner();
+	const RectFloat_t&			textureRect = sprite->GetTextureRect();
+	const Vector2D&				spriteSize = sprite->GetSpriteSize();
+
+	// Billboard rotation depends on view, so it is calculated in vertex shader
+	SSpriteInstance				instance;
+	instance.localToWorld		= InSceneProxy.GetLocalToWorld();
+	instance.textureRect		= Vector4D( textureRect.left, textureRect.top, textureRect.width, textureRect.height );
+	instance.spriteParams		= Vector4D( spriteSize.x, spriteSize.y, ( float )sprite->GetFlipFlags(), ( float )sprite->GetType() );
+
+#if ENABLE_HITPROXY
+	instance.hitProxyId			= owner ? owner->GetHitProxyId().GetColor() : CHitProxyId().GetColor();
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+	bSelectedInstance			= owner ? owner->IsSelected() : false;
+	instance.colorOverlay		= bSelectedInstance ? GEditorEngine->GetSelectionColor() : CColor( 0, 0, 0, 0 );
+#endif // WITH_EDITOR
 
-	OutResult *= SMath::ScaleMatrix( transform.GetScale() );
-	OutResult *= SMath::QuaternionToMatrix( transform.GetRotation() );
+	spriteBatch->UpdateInstance( instanceId, instance );
+	bIsDirtyInstance = false;
 }
 
 void CSpriteComponent::LinkDrawList()
 {
     check( scene );
 
+	// Sprite batch is changed only by the rendering thread. New scene proxy has dirty drawing policy link,
+	// so when sprite is added to scene on the game thread it's linked by AddToDrawList
+	if ( !IsInRenderingThread() )
+	{
+		return;
+	}
+
 	// If the primitive already added to scene - remove all draw policy links
-	if ( drawingPolicyLink
-#if WITH_EDITOR
-		 || gizmoDrawingPolicyLink
-#endif // WITH_EDITOR
-		 )
+	if ( spriteBatch )
 	{
 		UnlinkDrawList();
 	}
@@ -105,12 +161,18 @@ void CSpriteComponent::LinkDrawList()
 	// If sprite is valid - add to scene draw policy link
 	if ( sprite )
 	{
-		SSceneDepthGroup&               SDG = scene->GetSDG( 
 #if WITH_EDITOR
-			bGizmo ? SDG_Highlight :
+		SDGType							= bGizmo ? SDG_Highlight : SDG_World;
+#else
+		SDGType							= SDG_World;
 #endif // WITH_EDITOR
-			SDG_World );
-		
+
+		// Sprites with one material are drawn by one sprite batch
+		SSceneDepthGroup&               SDG = scene->GetSDG( SDGType );
+		spriteBatch						= scene->GetSpriteBatch( sprite->GetMaterial(), SDGType );
+		instanceId						= spriteBatch->AllocateInstance();
+		bIsDirtyInstance				= true;
+
 		SSpriteSurface					surface = sprite->GetSurface();
 
 		// Generate mesh batch of sprite
@@ -126,18 +188,18 @@ void CSpriteComponent::LinkDrawList()
 #if WITH_EDITOR
 		if ( bGizmo )
 		{
-			gizmoDrawingPolicyLink		= ::MakeDrawingPolicyLink<GizmoDrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.gizmoDrawList, DEC_SPRITE );
+			gizmoDrawingPolicyLink		= ::MakeDrawingPolicyLink<GizmoDrawingPolicyLink_t>( spriteBatch->GetVertexFactory(), spriteBatch->GetMaterial(), meshBatch, meshBatchLink, SDG.gizmoDrawList, DEC_SPRITE );
 		}
 		else
 #endif // WITH_EDITOR
 		{
-			drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE );
+			drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( spriteBatch->GetVertexFactory(), spriteBatch->GetMaterial(), meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE );
 		}
 		meshBatchLinks.push_back( meshBatchLink );
 
 		// Make and add to scene new hit proxy draw policy link
 #if ENABLE_HITPROXY
-		hitProxyDrawingPolicyLink		= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( sprite->GetVertexFactory(), sprite->GetMaterial(), meshBatch, meshBatchLink, SDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_SPRITE );
+		hitProxyDrawingPolicyLink		= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( spriteBatch->GetVertexFactory(), spriteBatch->GetMaterial(), meshBatch, meshBatchLink, SDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_SPRITE );
 		meshBatchLinks.push_back( meshBatchLink );
 #endif // ENABLE_HITPROXY
 	}
@@ -145,44 +207,60 @@ void CSpriteComponent::LinkDrawList()
 
 void CSpriteComponent::UnlinkDrawList()
 {
-    check( scene );
-	SSceneDepthGroup&		SDGWorld = scene->GetSDG( SDG_World );
+	// When sprite is removed from scene on the game thread, it's unlinked by OnRemovedFromScene
+	if ( IsInRenderingThread() )
+	{
+		check( scene );
+		RemoveFromDrawLists( scene );
+	}
+}
+
+void CSpriteComponent::RemoveFromDrawLists( class CScene* InScene )
+{
+	check( IsInRenderingThread() && InScene );
+	SSceneDepthGroup&		SDG = InScene->GetSDG( SDGType );
 
 	// If the primitive already added to scene - remove all draw policy links
 	if ( drawingPolicyLink )
 	{		
-		SDGWorld.spriteDrawList.RemoveItem( drawingPolicyLink );
+		SDG.spriteDrawList.RemoveItem( drawingPolicyLink );
 	}
 #if WITH_EDITOR
 	else if ( gizmoDrawingPolicyLink )
 	{
-		SDGWorld.gizmoDrawList.RemoveItem( gizmoDrawingPolicyLink );
+		SDG.gizmoDrawList.RemoveItem( gizmoDrawingPolicyLink );
 	}
 #endif // WITH_EDITOR
 
 #if ENABLE_HITPROXY
 	if ( hitProxyDrawingPolicyLink )
 	{
-		SDGWorld.hitProxyLayers[HPL_World].hitProxyDrawList.RemoveItem( hitProxyDrawingPolicyLink );
+		SDG.hitProxyLayers[HPL_World].hitProxyDrawList.RemoveItem( hitProxyDrawingPolicyLink );
 	}
 #endif // ENABLE_HITPROXY
 
+	// Free instance in sprite batch
+	if ( spriteBatch )
+	{
+		spriteBatch->FreeInstance( instanceId );
+		spriteBatch = nullptr;
+		instanceId	= INDEX_NONE;
+	}
+
 	meshBatchLinks.clear();
 }
 
-void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
+void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
 {
 	// If primitive is empty - exit from method
-	if ( !bIsDirtyDrawingPolicyLink && meshBatchLinks.empty() )
+	if ( !InSceneProxy.IsDirtyDrawingPolicyLink() && meshBatchLinks.empty() )
 	{
 		return;
 	}
 
 	// If drawing policy link is dirty - we update it
-	if ( bIsDirtyDrawingPolicyLink )
+	if ( InSceneProxy.IsDirtyDrawingPolicyLink() )
 	{
-		bIsDirtyDrawingPolicyLink = false;
-
 		if ( sprite )
 		{
 			LinkDrawList();
@@ -194,30 +272,37 @@ void CSpriteComponent::AddToDrawList( const class CSceneView& InSceneView )
 		}	
 	}
 
-	// Calculate transform matrix
-	ActorRef_t	owner = GetOwner();
-	Matrix		transformMatrix;
-	CalcTransformationMatrix( InSceneView, transformMatrix );
-
-    // Add to mesh batch new instance
-	for ( uint32 index = 0, count = meshBatchLinks.size(); index < count; ++index )
+	// Upload instance only if sprite is changed, moving of camera doesn't touch it
+#if WITH_EDITOR
+	AActor*		owner = GetOwner();
+	if ( owner && owner->IsSelected() != bSelectedInstance )
 	{
-		const SMeshBatch*	meshBatchLink = meshBatchLinks[ index ];	
-		++meshBatchLink->numInstances;
-		meshBatchLink->instances.resize( meshBatchLink->numInstances );
+		bIsDirtyInstance = true;
+	}
+#endif // WITH_EDITOR
 
-		SMeshInstance&		instanceMesh = meshBatchLink->instances[ meshBatchLink->numInstances - 1 ];
-		instanceMesh.transformMatrix	 = transformMatrix;
+	if ( bIsDirtyInstance )
+	{
+		UpdateInstance( InSceneProxy );
+	}
 
-#if ENABLE_HITPROXY
-		instanceMesh.hitProxyId		= owner ? owner->GetHitProxyId() : CHitProxyId();
-#endif // ENABLE_HITPROXY
+	// Whole sprite batch is drawn by one draw call if any its sprite is visible
+	for ( uint32 index = 0, count = meshBatchLinks.size(); index < count; ++index )
+	{
+		meshBatchLinks[ index ]->numInstances = spriteBatch->GetNumInstances();
+	}
+}
 
-#if WITH_EDITOR
-		instanceMesh.bSelected		= owner ? owner->IsSelected() : false;
-#endif // WITH_EDITOR
+void CSpriteComponent::OnCulled( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	// Sprite batch may be drawn by other sprites, so changed sprite must be updated even out of view
+	if ( bIsDirtyInstance && spriteBatch )
+	{
+		UpdateInstance( InSceneProxy );
 	}
+}
 
-    // Update AABB
+void CSpriteComponent::UpdateBounds()
+{
     boundbox = CBox::BuildAABB( GetComponentLocation(), Vector( GetSpriteSize(), 1.f ) );
 }
@@ -18,6 +18,18 @@ void CStaticMeshComponent::Serialize( class CArchive& InArchive )
 	InArchive << overrideMaterials;
 }
 
+void CStaticMeshComponent::ResetForPool( const CActorComponent* InArchetype )
+{
+	Super::ResetForPool( InArchetype );
+	if ( InArchetype )
+	{
+		const CStaticMeshComponent*		archetype = ( const CStaticMeshComponent* )InArchetype;
+		staticMesh			= archetype->staticMesh;
+		overrideMaterials	= archetype->overrideMaterials;
+		MarkRenderStateDirty( SPU_Material );
+	}
+}
+
 void CStaticMeshComponent::LinkDrawList()
 {
 	check( scene );
@@ -55,19 +67,17 @@ void CStaticMeshComponent::UnlinkDrawList()
 	}
 }
 
-void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
+void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
 {
 	// If primitive is empty - exit from method
-	if ( !bIsDirtyDrawingPolicyLink && !elementDrawingPolicyLink )
+	if ( !InSceneProxy.IsDirtyDrawingPolicyLink() && !elementDrawingPolicyLink )
 	{
 		return;
 	}
 
 	// If drawing policy link is dirty - we update it
-	if ( bIsDirtyDrawingPolicyLink || elementDrawingPolicyLink->bDirty )
+	if ( InSceneProxy.IsDirtyDrawingPolicyLink() || elementDrawingPolicyLink->bDirty )
 	{
-		bIsDirtyDrawingPolicyLink = false;
-		
 		LinkDrawList();
 		if ( !staticMesh.IsAssetValid() )
 		{
@@ -77,9 +87,18 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 
 	AActor*		owner = GetOwner();
 
+	// Select LOD by size on screen, mesh batch links of LOD end at the first link of next LOD
+	const std::vector<CStaticMesh::SElementDrawingPolicyLink::SLOD>&	lods = elementDrawingPolicyLink->lods;
+	uint32								lodIndex = elementDrawingPolicyLink->SelectLOD( InSceneView, InSceneProxy.GetBoundBox() );
+	bool								bLastLOD = lodIndex + 1 == lods.size();
+	uint32								firstMeshBatchLink = lods[ lodIndex ].firstMeshBatchLink;
+	uint32								lastMeshBatchLink = bLastLOD ? elementDrawingPolicyLink->meshBatchLinks.size() : lods[ lodIndex + 1 ].firstMeshBatchLink;
+	++GStaticMeshLODStats.numInstances[ lodIndex ];
+	GStaticMeshLODStats.numPrimitives[ lodIndex ] += lods[ lodIndex ].numPrimitives;
+
 	// Add to mesh batch new instance
-	const Matrix				transformationMatrix = GetComponentTransform().ToMatrix();
-	for ( uint32 index = 0, count = elementDrawingPolicyLink->meshBatchLinks.size(); index < count; ++index )
+	const Matrix&				transformationMatrix = InSceneProxy.GetLocalToWorld();
+	for ( uint32 index = firstMeshBatchLink; index < lastMeshBatchLink; ++index )
 	{
 		const SMeshBatch*		meshBatch = elementDrawingPolicyLink->meshBatchLinks[ index ];
 		++meshBatch->numInstances;
@@ -93,4 +112,37 @@ void CStaticMeshComponent::AddToDrawList( const class CSceneView& InSceneView )
 #endif // WITH_EDITOR
 										} );
 	}
+
+	// Add instance to depth prepass if primitive is good occluder
+	if ( IsDepthPrepassOccluder( InSceneView, InSceneProxy.GetBoundBox() ) )
+	{
+		uint32		lastDepthMeshBatchLink = bLastLOD ? elementDrawingPolicyLink->depthMeshBatchLinks.size() : lods[ lodIndex + 1 ].firstDepthMeshBatchLink;
+		for ( uint32 index = lods[ lodIndex ].firstDepthMeshBatchLink; index < lastDepthMeshBatchLink; ++index )
+		{
+			const SMeshBatch*		meshBatch = elementDrawingPolicyLink->depthMeshBatchLinks[ index ];
+			++meshBatch->numInstances;
+			meshBatch->instances.push_back( SMeshInstance{ transformationMatrix 
+#if ENABLE_HITPROXY
+											, CHitProxyId()
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+											, false
+#endif // WITH_EDITOR
+											} );
+		}
+	}
+}
+
+bool CStaticMeshComponent::AddOccluder( class COcclusionBuffer& InOcclusionBuffer, const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	TSharedPtr<CStaticMesh>		staticMeshRef = staticMesh.ToSharedPtr();
+	if ( !staticMeshRef || !staticMeshRef->HasOccluderGeometry() )
+	{
+		return false;
+	}
+
+	const std::vector<Vector4D>&	occluderVerteces = staticMeshRef->GetOccluderVerteces();
+	const std::vector<uint32>&		occluderIndeces = staticMeshRef->GetOccluderIndeces();
+	return InOcclusionBuffer.AddOccluder( InSceneProxy.GetLocalToWorld(), occluderVerteces.data(), occluderVerteces.size(), occluderIndeces.data(), occluderIndeces.size() );
 }
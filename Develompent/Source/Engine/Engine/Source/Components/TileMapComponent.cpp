@@ -0,0 +1,192 @@
+#include "Actors/Actor.h"
+#include "Components/TileMapComponent.h"
+#include "System/PhysicsBoxGeometry.h"
+#include "Render/Scene.h"
+#include "Render/SceneUtils.h"
+
+IMPLEMENT_CLASS( CTileMapComponent )
+
+CTileMapComponent::CTileMapComponent()
+	: tileMap( new CTileMap() )
+	, collisionProfile( GPhysicsEngine.FindCollisionProfile( SCollisionProfile::blockAll_ProfileName ) )
+	, physicsMaterial( nullptr )
+{}
+
+void CTileMapComponent::BeginPlay()
+{
+	Super::BeginPlay();
+	if ( !physicsMaterial.IsAssetValid() )
+	{
+		physicsMaterial = GPhysicsEngine.GetDefaultPhysMaterial();
+	}
+
+	UpdateBodySetup();
+}
+
+void CTileMapComponent::Serialize( class CArchive& InArchive )
+{
+	Super::Serialize( InArchive );
+	tileMap->Serialize( InArchive );
+	InArchive << collisionProfile;
+	InArchive << physicsMaterial;
+
+	if ( InArchive.IsLoading() )
+	{
+		UpdateBounds();
+		MarkRenderStateDirty( SPU_Material | SPU_Transform );
+	}
+}
+
+void CTileMapComponent::UpdateBodySetup()
+{
+	// Solid tiles are merged into rects, each rect is one box in body
+	std::vector<RectFloat_t>		collisionRects;
+	tileMap->BuildCollisionRects( collisionRects );
+	if ( collisionRects.empty() )
+	{
+		bodySetup = nullptr;
+		return;
+	}
+
+	bodySetup = new CPhysicsBodySetup();
+	for ( uint32 index = 0, count = ( uint32 )collisionRects.size(); index < count; ++index )
+	{
+		const RectFloat_t&				rect = collisionRects[ index ];
+		SPhysicsBoxGeometry				boxGeometry( rect.width, rect.height, 1.f );
+		boxGeometry.location			= Vector( rect.left, rect.top, 0.f );
+		boxGeometry.collisionProfile	= collisionProfile;
+		boxGeometry.material			= physicsMaterial;
+		bodySetup->AddBoxGeometry( boxGeometry );
+	}
+}
+
+void CTileMapComponent::LinkDrawList()
+{
+	check( scene );
+
+	// If the primitive already added to scene - remove all draw policy links
+	if ( !drawingPolicyLinks.empty() )
+	{
+		UnlinkDrawList();
+	}
+
+	const std::vector<STileMapChunk>&		chunks = tileMap->GetChunks();
+	const std::vector<STileMapTileset>&		tilesets = tileMap->GetTilesets();
+	SSceneDepthGroup&						SDG = scene->GetSDG( SDG_World );
+
+	// Each surface of chunk is own mesh batch, so invisible chunks don't add instances
+	chunkMeshBatchOffsets.resize( chunks.size() + 1 );
+	for ( uint32 chunkIndex = 0, numChunks = ( uint32 )chunks.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		const STileMapChunk&		chunk = chunks[ chunkIndex ];
+		chunkMeshBatchOffsets[ chunkIndex ] = ( uint32 )meshBatchLinks.size();
+
+		for ( uint32 surfaceIndex = 0, numSurfaces = ( uint32 )chunk.surfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+		{
+			const STileMapSurface&		surface = chunk.surfaces[ surfaceIndex ];
+			TAssetHandle<CMaterial>		material = tilesets[ surface.tilesetIndex ].material;
+
+			// Generate mesh batch of surface
+			SMeshBatch					meshBatch;
+			meshBatch.baseVertexIndex	= 0;
+			meshBatch.firstIndex		= surface.firstIndex;
+			meshBatch.numPrimitives		= surface.numPrimitives;
+			meshBatch.indexBufferRHI	= tileMap->GetIndexBufferRHI();
+			meshBatch.primitiveType		= PT_TriangleList;
+
+			// Make and add to scene new draw policy link
+			const SMeshBatch*			meshBatchLink = nullptr;
+			drawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( tileMap->GetVertexFactory(), material, meshBatch, meshBatchLink, SDG.spriteDrawList, DEC_SPRITE ) );
+			meshBatchLinks.push_back( meshBatchLink );
+
+			// Make and add to scene new hit proxy draw policy link
+#if ENABLE_HITPROXY
+			hitProxyDrawingPolicyLinks.push_back( ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( tileMap->GetVertexFactory(), material, meshBatch, meshBatchLink, SDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_SPRITE ) );
+			meshBatchLinks.push_back( meshBatchLink );
+#endif // ENABLE_HITPROXY
+		}
+	}
+	chunkMeshBatchOffsets[ chunks.size() ] = ( uint32 )meshBatchLinks.size();
+}
+
+void CTileMapComponent::UnlinkDrawList()
+{
+	check( scene );
+	SSceneDepthGroup&		SDGWorld = scene->GetSDG( SDG_World );
+
+	for ( uint32 index = 0, count = ( uint32 )drawingPolicyLinks.size(); index < count; ++index )
+	{
+		SDGWorld.spriteDrawList.RemoveItem( drawingPolicyLinks[ index ] );
+	}
+
+#if ENABLE_HITPROXY
+	for ( uint32 index = 0, count = ( uint32 )hitProxyDrawingPolicyLinks.size(); index < count; ++index )
+	{
+		SDGWorld.hitProxyLayers[ HPL_World ].hitProxyDrawList.RemoveItem( hitProxyDrawingPolicyLinks[ index ] );
+	}
+	hitProxyDrawingPolicyLinks.clear();
+#endif // ENABLE_HITPROXY
+
+	drawingPolicyLinks.clear();
+	meshBatchLinks.clear();
+	chunkMeshBatchOffsets.clear();
+}
+
+void CTileMapComponent::AddToDrawList( const class CSceneView& InSceneView, const class CPrimitiveSceneProxy& InSceneProxy )
+{
+	// If primitive is empty - exit from method
+	if ( !InSceneProxy.IsDirtyDrawingPolicyLink() && meshBatchLinks.empty() )
+	{
+		return;
+	}
+
+	// If drawing policy link is dirty - we update it
+	if ( InSceneProxy.IsDirtyDrawingPolicyLink() )
+	{
+		LinkDrawList();
+	}
+
+	AActor*					owner = GetOwner();
+	const Matrix&			transformationMatrix = InSceneProxy.GetLocalToWorld();
+	const CFrustum&			frustum = InSceneView.GetFrustum();
+	for ( uint32 chunkIndex = 0, numChunks = ( uint32 )chunkBounds.size(); chunkIndex < numChunks; ++chunkIndex )
+	{
+		// Whole tilemap is in frustum, but most of its chunks usually aren't
+		if ( !frustum.IsIn( chunkBounds[ chunkIndex ] ) )
+		{
+			continue;
+		}
+
+		for ( uint32 index = chunkMeshBatchOffsets[ chunkIndex ], count = chunkMeshBatchOffsets[ chunkIndex + 1 ]; index < count; ++index )
+		{
+			const SMeshBatch*		meshBatch = meshBatchLinks[ index ];
+			++meshBatch->numInstances;
+			meshBatch->instances.push_back( SMeshInstance{ transformationMatrix
+#if ENABLE_HITPROXY
+											, owner ? owner->GetHitProxyId() : CHitProxyId()
+#endif // ENABLE_HITPROXY
+
+#if WITH_EDITOR
+											, owner ? owner->IsSelected() : false
+#endif // WITH_EDITOR
+											} );
+		}
+	}
+}
+
+void CTileMapComponent::UpdateBounds()
+{
+	// Like sprites, tilemap isn't rotated and scaled, so bounds are just moved to component location
+	Vector								location = GetComponentLocation();
+	const std::vector<STileMapChunk>&	chunks = tileMap->GetChunks();
+
+	chunkBounds.resize( chunks.size() );
+	for ( uint32 index = 0, count = ( uint32 )chunks.size(); index < count; ++index )
+	{
+		const CBox&		bounds = chunks[ index ].bounds;
+		chunkBounds[ index ] = CBox( bounds.GetMin() + location, bounds.GetMax() + location );
+	}
+
+	const CBox&		tileMapBounds = tileMap->GetBounds();
+	boundbox = tileMapBounds.IsValid() ? CBox( tileMapBounds.GetMin() + location, tileMapBounds.GetMax() + location ) : CBox();
+}
@@ -1,43 +1,96 @@
 #include "Misc/EngineGlobals.h"
+#include "Misc/Template.h"
 #include "Render/SceneUtils.h"
 #include "Render/BatchedSimpleElements.h"
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
 #include "Render/Shaders/SimpleElementShader.h"
 #include "Render/Scene.h"
 
+/**
+ * @ingroup Engine
+ * @brief Initial size of simple element buffer in bytes, it grows if batch doesn't fit
+ */
+#define SIMPLEELEMENT_BUFFER_SIZE		( 1024 * 1024 )
+
+// -------------
+// GLOBALS
+// -------------
+TGlobalResource<CSimpleElementBuffer>		GSimpleElementBuffer;
+
 void CBatchedSimpleElements::Draw( class CBaseDeviceContextRHI* InDeviceContext, const CSceneView& InSceneView ) const
 {
-	CSimpleElementVertexShader*			vertexShader	= GShaderManager->FindInstance< CSimpleElementVertexShader, CSimpleElementVertexFactory >();
 	CSimpleElementPixelShader*			pixelShader		= GShaderManager->FindInstance< CSimpleElementPixelShader, CSimpleElementVertexFactory >();
 
-	GRHI->SetBoundShaderState( InDeviceContext, GRHI->CreateBoundShaderState( TEXT( "SimpleElementBoundShaderState" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), vertexShader->GetVertexShader(), pixelShader->GetPixelShader() ) );
-	
-	// Draw lines
+	// Draw lines, all of them in one draw call
 	if ( !lineVerteces.empty() )
 	{
 		SCOPED_DRAW_EVENT( EventSimpleElements, DEC_SIMPLEELEMENTS, TEXT( "Lines" ) );
-		GRHI->DrawPrimitiveUP( InDeviceContext, PT_LineList, 0, lineVerteces.size() / 2, lineVerteces.data(), sizeof( SSimpleElementVertexType ) );
+		CSimpleElementVertexShader*		vertexShader	= GShaderManager->FindInstance< CSimpleElementVertexShader, CSimpleElementVertexFactory >();
+		uint32							offset			= GSimpleElementBuffer.Write( InDeviceContext, lineVerteces.data(), lineVerteces.size() * sizeof( SSimpleElementVertexType ) );
+
+		GRHI->SetBoundShaderState( InDeviceContext, GRHI->CreateBoundShaderState( TEXT( "SimpleElementBoundShaderState" ), GSimpleElementVertexDeclaration.GetVertexDeclarationRHI(), vertexShader->GetVertexShader(), pixelShader->GetPixelShader() ) );
+		GRHI->SetStreamSource( InDeviceContext, CSimpleElementVertexFactory::SSS_Main, GSimpleElementBuffer.GetVertexBufferRHI(), sizeof( SSimpleElementVertexType ), offset );
+		GRHI->DrawPrimitive( InDeviceContext, PT_LineList, 0, lineVerteces.size() / 2 );
 	}
 
-	// Draw thick lines
+	// Draw thick lines, each line is instance and vertex shader builds quad of it
 	if ( !thickLines.empty() )
 	{
-		SCOPED_DRAW_EVENT( EventSimpleElements, DEC_SIMPLEELEMENTS, TEXT( "Thick Lines" ) );	
-		Vector						cameraZ = SMath::NormalizeVector( SMath::InverseMatrix( InSceneView.GetViewMatrix() ) * Vector4D( 0.f, 0.f, -1.f, 0.f ) );
-		SSimpleElementVertexType	thickVertices[ 4 ];
-
-		for ( uint32 index = 0, count = thickLines.size(); index < count; ++index )
-		{
-			const SBatchedThickLines&	thickLine	= thickLines[ index ];
-			Vector						rectLength	= SMath::NormalizeVector( thickLine.end - thickLine.start );
-			Vector						rectUp		= SMath::NormalizeVector( SMath::CrossVector( rectLength, cameraZ ) );
-			rectUp						*= thickLine.thickness * 0.5f;
-			
-			thickVertices[ 2 ]			= SSimpleElementVertexType{ Vector4D( thickLine.start - rectUp, 1.f ), Vector2D( 0.f, 0.f ), thickLine.color };
-			thickVertices[ 3 ]			= SSimpleElementVertexType{ Vector4D( thickLine.start + rectUp, 1.f ), Vector2D( 0.f, 1.f ), thickLine.color };
-			thickVertices[ 1 ]			= SSimpleElementVertexType{ Vector4D( thickLine.end + rectUp, 1.f ), Vector2D( 1.f, 1.f ), thickLine.color };
-			thickVertices[ 0 ]			= SSimpleElementVertexType{ Vector4D( thickLine.end - rectUp, 1.f ), Vector2D( 1.f, 0.f ), thickLine.color };
-			GRHI->DrawPrimitiveUP( InDeviceContext, PT_TriangleStrip, 0, 2, &thickVertices[ 0 ], sizeof( SSimpleElementVertexType ) );
-		}
+		SCOPED_DRAW_EVENT( EventSimpleElements, DEC_SIMPLEELEMENTS, TEXT( "Thick Lines" ) );
+		CSimpleElementThickLineVertexShader*	vertexShader	= GShaderManager->FindInstance< CSimpleElementThickLineVertexShader, CSimpleElementVertexFactory >();
+		uint32									offset			= GSimpleElementBuffer.Write( InDeviceContext, thickLines.data(), thickLines.size() * sizeof( SSimpleElementThickLineType ) );
+
+		GRHI->SetBoundShaderState( InDeviceContext, GRHI->CreateBoundShaderState( TEXT( "SimpleElementThickLineBoundShaderState" ), GSimpleElementThickLineDeclaration.GetVertexDeclarationRHI(), vertexShader->GetVertexShader(), pixelShader->GetPixelShader() ) );
+		GRHI->SetStreamSource( InDeviceContext, CSimpleElementVertexFactory::SSS_Main, GSimpleElementBuffer.GetVertexBufferRHI(), sizeof( SSimpleElementThickLineType ), offset );
+		GRHI->DrawPrimitive( InDeviceContext, PT_TriangleStrip, 0, 2, thickLines.size() );
+	}
+}
+
+CSimpleElementBuffer::CSimpleElementBuffer()
+	: size( 0 )
+	, cursor( 0 )
+{}
+
+uint32 CSimpleElementBuffer::Write( class CBaseDeviceContextRHI* InDeviceContextRHI, const void* InData, uint32 InSize )
+{
+	check( IsInRenderingThread() && InData && InSize > 0 );
+
+	// If data doesn't fit even in empty buffer we recreate it with bigger size
+	if ( InSize > size )
+	{
+		size			= Max( InSize, size * 2 );
+		vertexBufferRHI	= GRHI->CreateVertexBuffer( TEXT( "SimpleElementBuffer" ), size, nullptr, RUF_Dynamic );
+		cursor			= 0;
 	}
-}
\ No newline at end of file
+
+	// If data doesn't fit in rest of buffer we begin from start, the buffer will be discarded by lock
+	else if ( cursor + InSize > size )
+	{
+		cursor			= 0;
+	}
+
+	// Until the buffer isn't discarded we write after data in use by GPU without waiting it
+	SLockedData		lockedData;
+	uint32			offset = cursor;
+	GRHI->LockVertexBuffer( InDeviceContextRHI, vertexBufferRHI, InSize, offset, lockedData, offset > 0 );
+	memcpy( lockedData.data, InData, InSize );
+	GRHI->UnlockVertexBuffer( InDeviceContextRHI, vertexBufferRHI, lockedData );
+
+	// Offsets of data are aligned for any vertex format
+	cursor			= Min( Align( offset + InSize, 16 ), size );
+	return offset;
+}
+
+void CSimpleElementBuffer::InitRHI()
+{
+	size				= SIMPLEELEMENT_BUFFER_SIZE;
+	cursor				= 0;
+	vertexBufferRHI		= GRHI->CreateVertexBuffer( TEXT( "SimpleElementBuffer" ), size, nullptr, RUF_Dynamic );
+}
+
+void CSimpleElementBuffer::ReleaseRHI()
+{
+	vertexBufferRHI.SafeRelease();
+	size				= 0;
+	cursor				= 0;
+}
@@ -0,0 +1,53 @@
+#include "Misc/CoreGlobals.h"
+#include "Math/Math.h"
+#include "System/Config.h"
+#include "Render/DepthRendering.h"
+#include "Render/Scene.h"
+
+/**
+ * Constructor
+ */
+SDepthPrepassSettings::SDepthPrepassSettings()
+	: bEnable( true )
+	, minScreenRadius( 0.1f )
+{
+	CConfigValue		configEnable = GConfig.GetValue( CT_Engine, TEXT( "Engine.DepthPrepass" ), TEXT( "Enable" ) );
+	if ( configEnable.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configEnable.GetBool();
+	}
+
+	CConfigValue		configMinScreenRadius = GConfig.GetValue( CT_Engine, TEXT( "Engine.DepthPrepass" ), TEXT( "MinScreenRadius" ) );
+	if ( configMinScreenRadius.IsA( CConfigValue::T_Float ) || configMinScreenRadius.IsA( CConfigValue::T_Int ) )
+	{
+		minScreenRadius = configMinScreenRadius.GetNumber();
+	}
+}
+
+/**
+ * Get settings of depth prepass
+ */
+const SDepthPrepassSettings& GetDepthPrepassSettings()
+{
+	static SDepthPrepassSettings		settings;
+	return settings;
+}
+
+/**
+ * Is primitive good occluder for depth prepass
+ */
+bool IsDepthPrepassOccluder( const CSceneView& InSceneView, const CBox& InBoundBox )
+{
+	const SDepthPrepassSettings&	settings = GetDepthPrepassSettings();
+	if ( !settings.bEnable )
+	{
+		return false;
+	}
+
+	if ( settings.IsAllOccluders() )
+	{
+		return true;
+	}
+
+	return InBoundBox.IsValid() && InSceneView.GetScreenRadius( InBoundBox ) >= settings.minScreenRadius;
+}
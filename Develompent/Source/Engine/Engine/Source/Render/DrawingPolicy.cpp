@@ -9,6 +9,20 @@
 #include "Render/Scene.h"
 #include "Render/DrawingPolicy.h"
 
+#if FRAME_CAPTURE_MARKERS
+/**
+ * Get name of material for draw event
+ *
+ * @param InMaterial	Material
+ * @return Return name of material, if it isn't loaded returns 'Unloaded'
+ */
+static FORCEINLINE std::wstring GetDrawEventMaterialName( const TAssetHandle<CMaterial>& InMaterial )
+{
+	TSharedPtr<CMaterial>		materialRef = InMaterial.ToSharedPtr();
+	return materialRef ? materialRef->GetAssetName() : TEXT( "Unloaded" );
+}
+#endif // FRAME_CAPTURE_MARKERS
+
 CMeshDrawingPolicy::CMeshDrawingPolicy()
 	: bInit( false )
 	, depthBias( 0.f )
@@ -32,20 +46,50 @@ void CMeshDrawingPolicy::InitInternal( class CVertexFactory* InVertexFactory, co
 	vertexShader	= materialRef->GetShader( vertexFactoryHash, SF_Vertex );
 	pixelShader		= materialRef->GetShader( vertexFactoryHash, SF_Pixel );
 
+	// Rasterizer state of material is part of hash, so after change of it relinked primitives get new drawing policy with new pipeline state
 	hash			= appMemFastHash( materialRef, InVertexFactory->GetTypeHash() );
+	hash			= appMemFastHash( ( uint32 )materialRef->IsWireframe() | ( uint32 )materialRef->IsTwoSided() << 1, hash );
 	vertexFactory	= InVertexFactory;
 	material		= materialRef->GetAssetHandle();
 	depthBias		= InDepthBias;
+	pipelineState	= nullptr;
 	bInit			= true;
 }
 
+void CMeshDrawingPolicy::InitPipelineState()
+{
+	check( bInit );
+	pipelineState = nullptr;
+
+	VertexDeclarationRHIRef_t		vertexDeclaration = vertexFactory->GetDeclaration();
+	if ( !vertexShader || !pixelShader || !vertexDeclaration )
+	{
+		return;
+	}
+
+	SPipelineStateInitializer		initializer;
+	initializer.vertexDeclaration	= vertexDeclaration;
+	initializer.vertexFactoryHash	= vertexFactory->GetType()->GetHash();
+	initializer.vertexShader		= vertexShader;
+	initializer.pixelShader			= pixelShader;
+	initializer.rasterizerState		= GetRasterizerStateInitializer();
+	pipelineState					= GPipelineStateCache.GetPipelineState( initializer );
+}
+
 void CMeshDrawingPolicy::SetRenderState( class CBaseDeviceContextRHI* InDeviceContextRHI )
 {
 	check( bInit );
 
 	vertexFactory->Set( InDeviceContextRHI );
-	GRHI->SetRasterizerState( InDeviceContextRHI, GetRasterizerState() );
-	GRHI->SetBoundShaderState( InDeviceContextRHI, GetBoundShaderState() );
+
+	// Pipeline state isn't created yet if vertex declaration wasn't initialized on init of drawing policy
+	if ( !pipelineState )
+	{
+		InitPipelineState();
+	}
+
+	check( pipelineState );
+	pipelineState->Set( InDeviceContextRHI );
 }
 
 void CMeshDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI )
@@ -68,8 +112,7 @@ void CMeshDrawingPolicy::SetShaderParameters( class CBaseDeviceContextRHI* InDev
 
 void CMeshDrawingPolicy::Draw( class CBaseDeviceContextRHI* InDeviceContextRHI, const struct SMeshBatch& InMeshBatch, const class CSceneView& InSceneView )
 {
-	TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
-	SCOPED_DRAW_EVENT( EventDraw, DEC_MATERIAL, CString::Format( TEXT( "Material %s" ), materialRef ? materialRef->GetAssetName().c_str() : TEXT( "Unloaded" ) ).c_str());
+	SCOPED_DRAW_EVENTF( EventDraw, DEC_MATERIAL, TEXT( "Material %s" ), GetDrawEventMaterialName( material ).c_str() );
 
 	// If vertex factory not support instancig - draw without it
 	if ( !vertexFactory->SupportsInstancing() )
@@ -115,41 +158,18 @@ uint64 CMeshDrawingPolicy::GetTypeHash() const
 	return hash;
 }
 
-BoundShaderStateRHIRef_t CMeshDrawingPolicy::GetBoundShaderState() const
-{
-	if ( !boundShaderState )
-	{
-		TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
-		check( materialRef && vertexFactory && vertexShader && pixelShader );
-		
-		boundShaderState = GRHI->CreateBoundShaderState(
-			materialRef->GetAssetName().c_str(),
-			vertexFactory->GetDeclaration(),
-			vertexShader->GetVertexShader(),
-			pixelShader->GetPixelShader() );
-	}
-
-	return boundShaderState;
-}
-
-RasterizerStateRHIRef_t CMeshDrawingPolicy::GetRasterizerState() const
+SRasterizerStateInitializerRHI CMeshDrawingPolicy::GetRasterizerStateInitializer() const
 {
 	TSharedPtr<CMaterial>		materialRef = material.ToSharedPtr();
 	const SRasterizerStateInitializerRHI		initializer =
 	{
-		materialRef->IsWireframe() ? FM_Wireframe : FM_Solid,
-		materialRef->IsTwoSided() ? CM_None : CM_CW,
+		materialRef && materialRef->IsWireframe() ? FM_Wireframe : FM_Solid,
+		materialRef && materialRef->IsTwoSided() ? CM_None : CM_CW,
 		depthBias,
 		0.f,
 		true
 	};
-
-	if ( !rasterizerState || rasterizerState->GetInitializer() != initializer )
-	{
-		rasterizerState = GRHI->CreateRasterizerState( initializer );
-	}
-
-	return rasterizerState;
+	return initializer;
 }
 
 bool CMeshDrawingPolicy::Matches( const CMeshDrawingPolicy& InOtherDrawer ) const
@@ -0,0 +1,159 @@
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Config.h"
+#include "System/ConCmd.h"
+#include "Render/DynamicMeshBuffer.h"
+#include "Render/RenderingThread.h"
+#include "RHI/BaseRHI.h"
+
+/**
+ * Command 'dynamicmesh.stats', print statistics of dynamic mesh buffer in last frame
+ */
+static void CmdDynamicMeshStats( const std::vector<std::wstring>& InArguments )
+{
+	// Statistics are changed by the rendering thread, so they are printed there
+	UNIQUE_RENDER_COMMAND( CDumpDynamicMeshStatsCommand,
+						   {
+							   const SDynamicMeshBufferStats&		stats = GDynamicMeshBuffer.GetLastFrameStats();
+							   LE_LOG( LT_Log, LC_Console, TEXT( "Dynamic meshes: %u allocations, %u vertex bytes, %u index bytes, %u discards, %u reallocations" ),
+									   stats.numAllocations, stats.numVertexBytes, stats.numIndexBytes, stats.numDiscards, stats.numReallocations );
+							   LE_LOG( LT_Log, LC_Console, TEXT( "Dynamic meshes: vertex buffer %u bytes, index buffer %u bytes" ), stats.vertexBufferSize, stats.indexBufferSize );
+						   } );
+}
+
+// -------------
+// GLOBALS
+// -------------
+TGlobalResource<CDynamicMeshBuffer>		GDynamicMeshBuffer;
+CConCmd									CCmdDynamicMeshStats( TEXT( "dynamicmesh.stats" ), TEXT( "Print statistics of dynamic mesh buffer in last frame" ), &CmdDynamicMeshStats );
+
+/**
+ * Constructor
+ */
+CDynamicMeshBuffer::CDynamicMeshBuffer()
+	: vertexFactory( new CDynamicMeshVertexFactory() )
+	, maxVerteces( 0 )
+	, maxIndeces( 0 )
+	, vertexCursor( 0 )
+	, indexCursor( 0 )
+	, generation( 0 )
+{}
+
+/**
+ * Begin new frame
+ */
+void CDynamicMeshBuffer::BeginFrame()
+{
+	check( IsInRenderingThread() );
+	lastFrameStats				= stats;
+	stats						= SDynamicMeshBufferStats();
+	stats.vertexBufferSize		= maxVerteces * sizeof( SDynamicMeshVertexType );
+	stats.indexBufferSize		= maxIndeces * sizeof( uint32 );
+}
+
+/**
+ * Allocate region in buffers and write mesh into it
+ */
+void CDynamicMeshBuffer::Allocate( class CBaseDeviceContextRHI* InDeviceContextRHI, const SDynamicMeshVertexType* InVerteces, uint32 InNumVerteces, const uint32* InIndeces, uint32 InNumIndeces, SDynamicMeshAllocation& OutAllocation )
+{
+	check( IsInRenderingThread() && InVerteces && InIndeces && InNumVerteces > 0 && InNumIndeces > 0 );
+
+	// If mesh doesn't fit even in empty buffers we recreate them with bigger size
+	if ( InNumVerteces > maxVerteces || InNumIndeces > maxIndeces )
+	{
+		CreateBuffers( Max( InNumVerteces, maxVerteces * 2 ), Max( InNumIndeces, maxIndeces * 2 ) );
+		++stats.numReallocations;
+	}
+
+	// If mesh doesn't fit in rest of buffers we begin from start, the buffers will be discarded by lock.
+	// All allocations written before are invalid from this moment
+	else if ( vertexCursor + InNumVerteces > maxVerteces || indexCursor + InNumIndeces > maxIndeces )
+	{
+		vertexCursor	= 0;
+		indexCursor		= 0;
+		generation		= Max<uint32>( generation + 1, 1 );
+		++stats.numDiscards;
+	}
+
+	// Write verteces and indeces. Until the buffer isn't discarded we write after data in use by GPU without waiting it
+	SLockedData		lockedData;
+	uint32			vertexBytes = InNumVerteces * sizeof( SDynamicMeshVertexType );
+	GRHI->LockVertexBuffer( InDeviceContextRHI, vertexBufferRHI, vertexBytes, vertexCursor * sizeof( SDynamicMeshVertexType ), lockedData, vertexCursor > 0 );
+	memcpy( lockedData.data, InVerteces, vertexBytes );
+	GRHI->UnlockVertexBuffer( InDeviceContextRHI, vertexBufferRHI, lockedData );
+
+	uint32			indexBytes = InNumIndeces * sizeof( uint32 );
+	GRHI->LockIndexBuffer( InDeviceContextRHI, indexBufferRHI, indexBytes, indexCursor * sizeof( uint32 ), lockedData, indexCursor > 0 );
+	memcpy( lockedData.data, InIndeces, indexBytes );
+	GRHI->UnlockIndexBuffer( InDeviceContextRHI, indexBufferRHI, lockedData );
+
+	OutAllocation.baseVertexIndex	= vertexCursor;
+	OutAllocation.firstIndex		= indexCursor;
+	OutAllocation.generation		= generation;
+	vertexCursor					+= InNumVerteces;
+	indexCursor						+= InNumIndeces;
+
+	++stats.numAllocations;
+	stats.numVertexBytes			+= vertexBytes;
+	stats.numIndexBytes				+= indexBytes;
+}
+
+/**
+ * Create buffers
+ */
+void CDynamicMeshBuffer::CreateBuffers( uint32 InNumVerteces, uint32 InNumIndeces )
+{
+	maxVerteces			= InNumVerteces;
+	maxIndeces			= InNumIndeces;
+	vertexCursor		= 0;
+	indexCursor			= 0;
+	generation			= Max<uint32>( generation + 1, 1 );
+	vertexBufferRHI		= GRHI->CreateVertexBuffer( TEXT( "DynamicMeshBuffer" ), maxVerteces * sizeof( SDynamicMeshVertexType ), nullptr, RUF_Dynamic );
+	indexBufferRHI		= GRHI->CreateIndexBuffer( TEXT( "DynamicMeshBuffer" ), sizeof( uint32 ), maxIndeces * sizeof( uint32 ), nullptr, RUF_Dynamic );
+
+	// Vertex factory is the same object for all generations, so drawing policies of dynamic meshes stay valid
+	vertexFactory->ReleaseResource();
+	vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, sizeof( SDynamicMeshVertexType ) } );		// 0 stream slot
+	vertexFactory->Init();
+
+	stats.vertexBufferSize	= maxVerteces * sizeof( SDynamicMeshVertexType );
+	stats.indexBufferSize	= maxIndeces * sizeof( uint32 );
+}
+
+/**
+ * Initializes the RHI resources
+ */
+void CDynamicMeshBuffer::InitRHI()
+{
+	uint32				numVerteces = 65536;
+	uint32				numIndeces = 196608;
+
+	CConfigValue		configMaxVerteces = GConfig.GetValue( CT_Engine, TEXT( "Engine.DynamicMesh" ), TEXT( "MaxVerteces" ) );
+	if ( configMaxVerteces.IsA( CConfigValue::T_Int ) )
+	{
+		numVerteces = Max( configMaxVerteces.GetInt(), 1 );
+	}
+
+	CConfigValue		configMaxIndeces = GConfig.GetValue( CT_Engine, TEXT( "Engine.DynamicMesh" ), TEXT( "MaxIndeces" ) );
+	if ( configMaxIndeces.IsA( CConfigValue::T_Int ) )
+	{
+		numIndeces = Max( configMaxIndeces.GetInt(), 1 );
+	}
+
+	CreateBuffers( numVerteces, numIndeces );
+}
+
+/**
+ * Releases the RHI resources
+ */
+void CDynamicMeshBuffer::ReleaseRHI()
+{
+	vertexFactory->ReleaseResource();
+	vertexBufferRHI.SafeRelease();
+	indexBufferRHI.SafeRelease();
+	maxVerteces		= 0;
+	maxIndeces		= 0;
+	vertexCursor	= 0;
+	indexCursor		= 0;
+}
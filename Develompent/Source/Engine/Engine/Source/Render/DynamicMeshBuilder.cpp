@@ -7,69 +7,77 @@
 #include "Render/SceneRendering.h"
 #include "Render/Scene.h"
 
+/**
+ * @ingroup Engine
+ * @brief Mesh batch reused by all draws of dynamic meshes, they are drawn only in render thread
+ */
+static SMeshBatch		GDynamicMeshBatch;
+
 CDynamicMeshBuilder::CDynamicMeshBuilder()
 	: numPrimitives( 0 )
-	, vertexFactory( new CDynamicMeshVertexFactory() )
 {}
 
 void CDynamicMeshBuilder::InitRHI()
 {
-	CScopeLock		scopeLock( &readWriteCS );
+	AllocateMesh( GRHI->GetImmediateContext() );
+}
 
-	// Create vertex buffer
-	uint32			numVerteces = verteces.size();
-	if ( numVerteces > 0 )
-	{
-		vertexBufferRHI = GRHI->CreateVertexBuffer( TEXT( "DynamicMesh" ), sizeof( SDynamicMeshVertexType ) * numVerteces, ( byte* )verteces.data(), RUF_Static );
+void CDynamicMeshBuilder::ReleaseRHI()
+{
+	allocation = SDynamicMeshAllocation();
+}
 
-		// Initialize vertex factory
-		vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, sizeof( SDynamicMeshVertexType ) } );		// 0 stream slot
-		vertexFactory->Init();
+bool CDynamicMeshBuilder::AllocateMesh( class CBaseDeviceContextRHI* InDeviceContextRHI ) const
+{
+	if ( GDynamicMeshBuffer.IsValidAllocation( allocation ) )
+	{
+		return true;
 	}
 
-	// Create index buffer
-	uint32			numIndeces = indeces.size();
-	if ( numIndeces > 0 )
+	// Mesh isn't in buffer yet or it was discarded, so we write it again
+	CScopeLock		scopeLock( &readWriteCS );
+	if ( verteces.empty() || indeces.empty() )
 	{
-		indexBufferRHI = GRHI->CreateIndexBuffer( TEXT( "DynamicMesh" ), sizeof( uint32 ), sizeof( uint32 ) * numIndeces, ( byte* )indeces.data(), RUF_Static );
+		return false;
 	}
 
-	// Free source data
-	verteces.clear();
-	indeces.clear();
-}
-
-void CDynamicMeshBuilder::ReleaseRHI()
-{
-	vertexBufferRHI.SafeRelease();
-	indexBufferRHI.SafeRelease();
-	vertexFactory->ReleaseResource();
+	GDynamicMeshBuffer.Allocate( InDeviceContextRHI, verteces.data(), ( uint32 )verteces.size(), indeces.data(), ( uint32 )indeces.size(), allocation );
+	return true;
 }
 
 void CDynamicMeshBuilder::Draw( class CBaseDeviceContextRHI* InDeviceContextRHI, const Matrix& InLocalToWorld, const TAssetHandle<CMaterial>& InMaterial, CMeshDrawingPolicy& InDrawingPolicy, const class CSceneView& InSceneView ) const
 {
-	checkMsg( vertexFactory && vertexBufferRHI, TEXT( "Before draw dynamic mesh need call CDynamicMeshBuilder::Build" ) );
-	
+	checkMsg( IsInitialized(), TEXT( "Before draw dynamic mesh need call CDynamicMeshBuilder::Build" ) );
+	if ( !AllocateMesh( InDeviceContextRHI ) )
+	{
+		return;
+	}
+
 	// Init mesh batch
-	SMeshBatch		meshBatch;
-	meshBatch.indexBufferRHI	= indexBufferRHI;
-	meshBatch.baseVertexIndex	= 0;
-	meshBatch.firstIndex		= 0;
-	meshBatch.numInstances		= 1;
-	meshBatch.numPrimitives		= numPrimitives;
-	meshBatch.primitiveType		= PT_TriangleList;
-	meshBatch.instances.push_back( SMeshInstance{ InLocalToWorld, 
+	GDynamicMeshBatch.indexBufferRHI	= GDynamicMeshBuffer.GetIndexBufferRHI();
+	GDynamicMeshBatch.baseVertexIndex	= allocation.baseVertexIndex;
+	GDynamicMeshBatch.firstIndex		= allocation.firstIndex;
+	GDynamicMeshBatch.numInstances		= 1;
+	GDynamicMeshBatch.numPrimitives		= numPrimitives;
+	GDynamicMeshBatch.primitiveType		= PT_TriangleList;
+	GDynamicMeshBatch.instances.resize( 1 );
+
+	SMeshInstance&		meshInstance = GDynamicMeshBatch.instances[ 0 ];
+	meshInstance.transformMatrix		= InLocalToWorld;
 #if ENABLE_HITPROXY
-								   hitProxyId 
+	meshInstance.hitProxyId				= hitProxyId;
 #endif // ENABLE_HITPROXY
-								   }  );
+
+#if WITH_EDITOR
+	meshInstance.bSelected				= false;
+#endif // WITH_EDITOR
 
 	// Draw mesh
 	if ( InDrawingPolicy.IsValid() )
 	{
 		InDrawingPolicy.SetRenderState( InDeviceContextRHI );
 		InDrawingPolicy.SetShaderParameters( InDeviceContextRHI );
-		InDrawingPolicy.Draw( InDeviceContextRHI, meshBatch, InSceneView );
+		InDrawingPolicy.Draw( InDeviceContextRHI, GDynamicMeshBatch, InSceneView );
 	}
 	else
 	{
@@ -24,6 +24,9 @@ void CGameViewportClient::Draw( CViewport* InViewport )
 	CSceneView*		sceneView = CalcSceneView( InViewport, cameraView );
 	GAudioDevice.SetListenerSpatial( cameraView.location, cameraView.rotation * SMath::vectorForward, cameraView.rotation * SMath::vectorUp );
 
+	// Send changes of scene to the render thread before drawing
+	GWorld->GetScene()->FlushProxyUpdates();
+
 	// Draw viewport
 	UNIQUE_RENDER_COMMAND_THREEPARAMETER( CViewportRenderCommand,
 										  CGameViewportClient*, viewportClient, this,
@@ -0,0 +1,375 @@
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "System/Config.h"
+#include "Render/LightGrid.h"
+#include "RHI/BaseRHI.h"
+#include "RHI/BaseBufferRHI.h"
+
+/**
+ * @ingroup Engine
+ * @brief Ratio of grid depth to depth scale of slices. The bigger it is, the thinner near slices are relative to far slices
+ */
+#define LIGHTGRID_DEPTH_DISTRIBUTION	256.f
+
+// -------------
+// GLOBALS
+// -------------
+TGlobalResource<CLightGrid>		GLightGrid;
+
+/**
+ * Get tile of NDC coordinate
+ *
+ * @param InNDC			NDC coordinate in range [0, 1] from first tile to last one
+ * @param InNumTiles	Number of tiles
+ * @return Return index of tile clamped to grid
+ */
+static FORCEINLINE uint32 GetTileIndex( float InNDC, uint32 InNumTiles )
+{
+	return ( uint32 )SMath::Clamp( SMath::Floor( InNDC * InNumTiles ), 0.f, InNumTiles - 1.f );
+}
+
+/**
+ * Load settings from engine config
+ */
+void SLightGridSettings::LoadFromConfig()
+{
+	CConfigValue		configEnable = GConfig.GetValue( CT_Engine, TEXT( "Engine.LightGrid" ), TEXT( "Enable" ) );
+	if ( configEnable.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configEnable.GetBool();
+	}
+
+	CConfigValue		configNumClustersX = GConfig.GetValue( CT_Engine, TEXT( "Engine.LightGrid" ), TEXT( "NumClustersX" ) );
+	if ( configNumClustersX.IsA( CConfigValue::T_Int ) )
+	{
+		numClustersX = Max( configNumClustersX.GetInt(), 1 );
+	}
+
+	CConfigValue		configNumClustersY = GConfig.GetValue( CT_Engine, TEXT( "Engine.LightGrid" ), TEXT( "NumClustersY" ) );
+	if ( configNumClustersY.IsA( CConfigValue::T_Int ) )
+	{
+		numClustersY = Max( configNumClustersY.GetInt(), 1 );
+	}
+
+	CConfigValue		configNumClustersZ = GConfig.GetValue( CT_Engine, TEXT( "Engine.LightGrid" ), TEXT( "NumClustersZ" ) );
+	if ( configNumClustersZ.IsA( CConfigValue::T_Int ) )
+	{
+		numClustersZ = Max( configNumClustersZ.GetInt(), 1 );
+	}
+}
+
+/**
+ * Constructor
+ */
+CLightGrid::CLightGrid()
+	: gridNearDepth( 0.f )
+	, depthScale( 1.f )
+	, sliceScale( 1.f )
+{}
+
+/**
+ * Bin lights into clusters of view
+ */
+void CLightGrid::Build( const Matrix& InViewMatrix, const Matrix& InProjectionMatrix, const std::vector<SLightGridLight>& InLights )
+{
+	const uint32		numClusters			= settings.numClustersX * settings.numClustersY * settings.numClustersZ;
+	const Matrix		invProjectionMatrix	= SMath::InverseMatrix( InProjectionMatrix );
+
+	// Depth range of camera, lights out of it aren't visible
+	Vector4D			nearPoint			= invProjectionMatrix * Vector4D( 0.f, 0.f, -1.f, 1.f );
+	Vector4D			farPoint			= invProjectionMatrix * Vector4D( 0.f, 0.f, 1.f, 1.f );
+	float				cameraNearDepth		= -nearPoint.z / nearPoint.w;
+	float				cameraFarDepth		= -farPoint.z / farPoint.w;
+
+	// Move lights into view space, data for shader stays in world space because lighting pass reconstructs world position
+	float				minDepth = FLT_MAX;
+	float				maxDepth = -FLT_MAX;
+	viewLights.clear();
+	lightData.clear();
+	for ( uint32 index = 0, count = ( uint32 )InLights.size(); index < count; ++index )
+	{
+		const SLightGridLight&	light			= InLights[ index ];
+		Vector4D				viewPosition	= InViewMatrix * Vector4D( light.position, 1.f );
+		float					depth			= -viewPosition.z;
+		if ( light.radius <= 0.f || depth + light.radius < cameraNearDepth || depth - light.radius > cameraFarDepth )
+		{
+			continue;
+		}
+
+		SViewLight				viewLight;
+		viewLight.position		= Vector( viewPosition );
+		viewLight.radius		= light.radius;
+		viewLight.depth			= depth;
+		viewLight.bSpotLight	= light.IsSpotLight();
+		viewLight.direction		= glm::normalize( Vector( InViewMatrix * Vector4D( light.direction, 0.f ) ) );
+		viewLight.cosOuterCone	= light.cosOuterCone;
+		viewLight.sinOuterCone	= SMath::Sqrt( Max( 1.f - light.cosOuterCone * light.cosOuterCone, 0.f ) );
+		viewLights.push_back( viewLight );
+
+		minDepth				= Min( minDepth, depth - light.radius );
+		maxDepth				= Max( maxDepth, depth + light.radius );
+
+		const float				data[ LIGHTGRID_TEXELS_PER_LIGHT * 4 ] =
+		{
+			light.position.x,	light.position.y,	light.position.z,	light.radius,
+			light.color.x,		light.color.y,		light.color.z,		light.cosInnerCone,
+			light.direction.x,	light.direction.y,	light.direction.z,	light.cosOuterCone
+		};
+		lightData.insert( lightData.end(), data, data + LIGHTGRID_TEXELS_PER_LIGHT * 4 );
+	}
+
+	// If there are no lights, all clusters are empty
+	lightIndeces.clear();
+	clusterData.assign( numClusters * 2, 0.f );
+	if ( viewLights.empty() )
+	{
+		gridNearDepth	= 0.f;
+		depthScale		= 1.f;
+		sliceScale		= 1.f;
+		return;
+	}
+
+	// Slices cover only depth range of lights, it's usually much less than range of camera
+	gridNearDepth		= Max( minDepth, cameraNearDepth );
+	float	depthRange	= Max( Min( maxDepth, cameraFarDepth ) - gridNearDepth, 1.f );
+	depthScale			= depthRange / LIGHTGRID_DEPTH_DISTRIBUTION;
+	sliceScale			= settings.numClustersZ / SMath::Loge( LIGHTGRID_DEPTH_DISTRIBUTION + 1.f );
+	BuildClusterBounds( invProjectionMatrix );
+
+	// Find clusters of each light, clusterCursors are used as counters of lights in clusters
+	const uint32	numLights = ( uint32 )viewLights.size();
+	lightClusters.clear();
+	lightClusterOffsets.resize( numLights + 1 );
+	clusterCursors.assign( numClusters, 0 );
+	for ( uint32 lightIndex = 0; lightIndex < numLights; ++lightIndex )
+	{
+		const SViewLight&	viewLight = viewLights[ lightIndex ];
+		lightClusterOffsets[ lightIndex ] = ( uint32 )lightClusters.size();
+
+		// Range of slices by depth of light sphere
+		int32		minZ = Max( GetSlice( viewLight.depth - viewLight.radius ), 0 );
+		int32		maxZ = Min( GetSlice( viewLight.depth + viewLight.radius ), ( int32 )settings.numClustersZ - 1 );
+
+		// Range of tiles by projected bounds of light sphere. If sphere crosses camera plane, it may cover any tile
+		Vector2D	ndcMin( FLT_MAX, FLT_MAX );
+		Vector2D	ndcMax( -FLT_MAX, -FLT_MAX );
+		bool		bAllTiles = false;
+		for ( uint32 cornerIndex = 0; cornerIndex < 8 && !bAllTiles; ++cornerIndex )
+		{
+			Vector		corner( cornerIndex & 1 ? viewLight.radius : -viewLight.radius, cornerIndex & 2 ? viewLight.radius : -viewLight.radius, cornerIndex & 4 ? viewLight.radius : -viewLight.radius );
+			Vector4D	clipPosition = InProjectionMatrix * Vector4D( viewLight.position + corner, 1.f );
+			if ( clipPosition.w <= 0.f )
+			{
+				bAllTiles = true;
+				break;
+			}
+
+			Vector2D	ndcPosition( clipPosition.x / clipPosition.w, clipPosition.y / clipPosition.w );
+			ndcMin		= Vector2D( Min( ndcMin.x, ndcPosition.x ), Min( ndcMin.y, ndcPosition.y ) );
+			ndcMax		= Vector2D( Max( ndcMax.x, ndcPosition.x ), Max( ndcMax.y, ndcPosition.y ) );
+		}
+
+		uint32		minX = 0;
+		uint32		maxX = settings.numClustersX - 1;
+		uint32		minY = 0;
+		uint32		maxY = settings.numClustersY - 1;
+		if ( !bAllTiles )
+		{
+			// Light is out of screen
+			if ( ndcMax.x < -1.f || ndcMin.x > 1.f || ndcMax.y < -1.f || ndcMin.y > 1.f )
+			{
+				continue;
+			}
+
+			// First row of tiles is on top of screen
+			minX	= GetTileIndex( ( ndcMin.x + 1.f ) * 0.5f, settings.numClustersX );
+			maxX	= GetTileIndex( ( ndcMax.x + 1.f ) * 0.5f, settings.numClustersX );
+			minY	= GetTileIndex( ( 1.f - ndcMax.y ) * 0.5f, settings.numClustersY );
+			maxY	= GetTileIndex( ( 1.f - ndcMin.y ) * 0.5f, settings.numClustersY );
+		}
+
+		for ( int32 z = minZ; z <= maxZ; ++z )
+		{
+			for ( uint32 y = minY; y <= maxY; ++y )
+			{
+				for ( uint32 x = minX; x <= maxX; ++x )
+				{
+					uint32		clusterIndex = ( z * settings.numClustersY + y ) * settings.numClustersX + x;
+					if ( IsLightInCluster( viewLight, clusterIndex ) )
+					{
+						lightClusters.push_back( clusterIndex );
+						++clusterCursors[ clusterIndex ];
+					}
+				}
+			}
+		}
+	}
+	lightClusterOffsets[ numLights ] = ( uint32 )lightClusters.size();
+
+	// Lists of clusters are placed one by one without gaps
+	uint32		numLightIndeces = 0;
+	for ( uint32 clusterIndex = 0; clusterIndex < numClusters; ++clusterIndex )
+	{
+		uint32		numClusterLights = clusterCursors[ clusterIndex ];
+		clusterData[ clusterIndex * 2 ]			= ( float )numLightIndeces;
+		clusterData[ clusterIndex * 2 + 1 ]		= ( float )numClusterLights;
+		clusterCursors[ clusterIndex ]			= numLightIndeces;
+		numLightIndeces							+= numClusterLights;
+	}
+
+	lightIndeces.resize( numLightIndeces );
+	for ( uint32 lightIndex = 0; lightIndex < numLights; ++lightIndex )
+	{
+		for ( uint32 index = lightClusterOffsets[ lightIndex ], count = lightClusterOffsets[ lightIndex + 1 ]; index < count; ++index )
+		{
+			lightIndeces[ clusterCursors[ lightClusters[ index ] ]++ ] = ( float )lightIndex;
+		}
+	}
+}
+
+/**
+ * Build bounds of clusters in view space
+ */
+void CLightGrid::BuildClusterBounds( const Matrix& InInvProjectionMatrix )
+{
+	// Rays through corners of tiles. It works for perspective and orthographic projections both
+	const uint32	numCornersX = settings.numClustersX + 1;
+	const uint32	numCornersY = settings.numClustersY + 1;
+	cornerRayOrigins.resize( numCornersX * numCornersY );
+	cornerRayDirections.resize( numCornersX * numCornersY );
+	for ( uint32 y = 0; y < numCornersY; ++y )
+	{
+		for ( uint32 x = 0; x < numCornersX; ++x )
+		{
+			float		ndcX		= -1.f + 2.f * x / settings.numClustersX;
+			float		ndcY		= 1.f - 2.f * y / settings.numClustersY;
+			Vector4D	pointA		= InInvProjectionMatrix * Vector4D( ndcX, ndcY, -1.f, 1.f );
+			Vector4D	pointB		= InInvProjectionMatrix * Vector4D( ndcX, ndcY, 0.f, 1.f );
+			Vector		positionA	= Vector( pointA ) / pointA.w;
+			Vector		direction	= Vector( pointB ) / pointB.w - positionA;
+			direction				/= -direction.z;
+
+			uint32		cornerIndex = y * numCornersX + x;
+			cornerRayOrigins[ cornerIndex ]		= positionA + direction * positionA.z;
+			cornerRayDirections[ cornerIndex ]	= direction;
+		}
+	}
+
+	// Bounds of cluster is box of its tile corners at both depths of its slice
+	clusterBounds.resize( settings.numClustersX * settings.numClustersY * settings.numClustersZ );
+	for ( uint32 z = 0; z < settings.numClustersZ; ++z )
+	{
+		const float		sliceDepths[ 2 ] = { GetSliceDepth( z ), GetSliceDepth( z + 1 ) };
+		for ( uint32 y = 0; y < settings.numClustersY; ++y )
+		{
+			for ( uint32 x = 0; x < settings.numClustersX; ++x )
+			{
+				Vector		boundsMin( FLT_MAX, FLT_MAX, FLT_MAX );
+				Vector		boundsMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+				for ( uint32 pointIndex = 0; pointIndex < 8; ++pointIndex )
+				{
+					uint32		cornerIndex = ( y + ( pointIndex >> 1 & 1 ) ) * numCornersX + x + ( pointIndex & 1 );
+					Vector		point		= cornerRayOrigins[ cornerIndex ] + cornerRayDirections[ cornerIndex ] * sliceDepths[ pointIndex >> 2 ];
+					boundsMin				= glm::min( boundsMin, point );
+					boundsMax				= glm::max( boundsMax, point );
+				}
+
+				clusterBounds[ ( z * settings.numClustersY + y ) * settings.numClustersX + x ] = CBox( boundsMin, boundsMax );
+			}
+		}
+	}
+}
+
+/**
+ * Is light intersects cluster
+ */
+bool CLightGrid::IsLightInCluster( const SViewLight& InLight, uint32 InClusterIndex ) const
+{
+	const CBox&		bounds		= clusterBounds[ InClusterIndex ];
+	const Vector&	boundsMin	= bounds.GetMin();
+	const Vector&	boundsMax	= bounds.GetMax();
+
+	// Sphere of light against box of cluster
+	Vector			delta		= glm::clamp( InLight.position, boundsMin, boundsMax ) - InLight.position;
+	if ( glm::dot( delta, delta ) > InLight.radius * InLight.radius )
+	{
+		return false;
+	}
+
+	if ( !InLight.bSpotLight )
+	{
+		return true;
+	}
+
+	// Cone of spot light against bounding sphere of cluster
+	Vector			center				= ( boundsMin + boundsMax ) * 0.5f;
+	float			clusterRadius		= glm::length( boundsMax - boundsMin ) * 0.5f;
+	Vector			toCenter			= center - InLight.position;
+	float			toCenterLengthSq	= glm::dot( toCenter, toCenter );
+	float			axisDistance		= glm::dot( toCenter, InLight.direction );
+	float			coneDistance		= InLight.cosOuterCone * SMath::Sqrt( Max( toCenterLengthSq - axisDistance * axisDistance, 0.f ) ) - axisDistance * InLight.sinOuterCone;
+	return coneDistance <= clusterRadius && axisDistance <= clusterRadius + InLight.radius && axisDistance >= -clusterRadius;
+}
+
+/**
+ * Upload built light grid to textures
+ */
+void CLightGrid::UpdateRHI( class CBaseDeviceContextRHI* InDeviceContextRHI )
+{
+	UploadTexture( InDeviceContextRHI, TEXT( "LightGridClusters" ), PF_R32F, clusterData.data(), ( uint32 )clusterData.size(), clusterTextureRHI );
+	UploadTexture( InDeviceContextRHI, TEXT( "LightGridIndeces" ), PF_R32F, lightIndeces.data(), ( uint32 )lightIndeces.size(), lightIndexTextureRHI );
+	UploadTexture( InDeviceContextRHI, TEXT( "LightGridLights" ), PF_A32B32G32R32F, lightData.data(), ( uint32 )lightData.size() / 4, lightDataTextureRHI );
+}
+
+/**
+ * Upload data into texture
+ */
+void CLightGrid::UploadTexture( class CBaseDeviceContextRHI* InDeviceContextRHI, const tchar* InDebugName, EPixelFormat InFormat, const float* InData, uint32 InNumTexels, Texture2DRHIRef_t& InOutTextureRHI )
+{
+	// Height of texture grows by power of two, so texture isn't recreated each time when number of lights changes
+	const uint32		numRows = Max<uint32>( ( InNumTexels + LIGHTGRID_TEXTURE_WIDTH - 1 ) / LIGHTGRID_TEXTURE_WIDTH, 1 );
+	if ( !InOutTextureRHI || InOutTextureRHI->GetSizeY() < numRows )
+	{
+		uint32		sizeY = 1;
+		while ( sizeY < numRows )
+		{
+			sizeY <<= 1;
+		}
+		InOutTextureRHI = GRHI->CreateTexture2D( InDebugName, LIGHTGRID_TEXTURE_WIDTH, sizeY, InFormat, 1, TCF_None );
+	}
+
+	if ( !InNumTexels )
+	{
+		return;
+	}
+
+	// Shader reads only texels of built grid, so rows after them are left as is
+	const uint32		texelSize = GPixelFormats[ InFormat ].numComponents * sizeof( float );
+	SLockedData			lockedData;
+	GRHI->LockTexture2D( InDeviceContextRHI, InOutTextureRHI, 0, true, lockedData );
+	for ( uint32 row = 0; row < numRows; ++row )
+	{
+		uint32		firstTexel = row * LIGHTGRID_TEXTURE_WIDTH;
+		uint32		numRowTexels = Min<uint32>( InNumTexels - firstTexel, LIGHTGRID_TEXTURE_WIDTH );
+		memcpy( lockedData.data + row * lockedData.pitch, ( const byte* )InData + firstTexel * texelSize, numRowTexels * texelSize );
+	}
+	GRHI->UnlockTexture2D( InDeviceContextRHI, InOutTextureRHI, 0, lockedData );
+}
+
+/**
+ * Initializes the RHI resources
+ */
+void CLightGrid::InitRHI()
+{
+	settings.LoadFromConfig();
+}
+
+/**
+ * Releases the RHI resources
+ */
+void CLightGrid::ReleaseRHI()
+{
+	clusterTextureRHI.SafeRelease();
+	lightIndexTextureRHI.SafeRelease();
+	lightDataTextureRHI.SafeRelease();
+}
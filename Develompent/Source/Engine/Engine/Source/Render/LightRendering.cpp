@@ -6,6 +6,7 @@
 #include "Render/Scene.h"
 #include "Render/DrawingPolicy.h"
 #include "Render/Sphere.h"
+#include "Render/LightGrid.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseDeviceContextRHI.h"
 #include "RHI/BaseSurfaceRHI.h"
@@ -14,9 +15,6 @@
 #include "Render/Shaders/LightingShader.h"
 #include "Render/Shaders/ScreenShader.h"
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
-#include "Components/PointLightComponent.h"
-#include "Components/SpotLightComponent.h"
-#include "Components/DirectionalLightComponent.h"
 
 /**
  * @ingroup Engine
@@ -108,16 +106,13 @@ public:
 	}
 
 	/**
-	 * @brief Get rasterizer state
-	 * @return Return rasterizer state of current drawing policy
+	 * @brief Get rasterizer state initializer
+	 * @return Return initializer of rasterizer state of current drawing policy
 	 */
-	virtual RasterizerStateRHIRef_t GetRasterizerState() const override
+	virtual SRasterizerStateInitializerRHI GetRasterizerStateInitializer() const override
 	{
-		if ( !rasterizerState )
-		{
-			rasterizerState = TStaticRasterizerStateRHI<FM_Solid, CM_CCW>::GetRHI();
-		}
-		return rasterizerState;
+		const SRasterizerStateInitializerRHI		initializer = { FM_Solid, CM_CCW, 0.f, 0.f, true };
+		return initializer;
 	}
 };
 
@@ -145,7 +140,7 @@ public:
 	 * @param InLights			List of point lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( const std::list<TRefCountPtr<CPointLightComponent>>& InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( const LightSceneProxyList_t& InLights, float InDepthBias = 0.f )
 	{
 		CBaseLightingDrawingPolicy::Init( GLightSphereMesh.GetVertexFactory(), InDepthBias );
 
@@ -153,7 +148,8 @@ public:
 		uint64					vertexFactoryHash		= vertexFactory->GetType()->GetHash();
 		vertexShader			= lightingVertexShader	= GShaderManager->FindInstance<TLightingVertexShader<LT_Point>>( vertexFactoryHash );
 		pixelShader				= lightingPixelShader	= GShaderManager->FindInstance<TLightingPixelShader<LT_Point>>( vertexFactoryHash );
-		pointLightComponents	= InLights;
+		pointLights				= InLights;
+		InitPipelineState();
 	}
 
 	/**
@@ -173,16 +169,16 @@ public:
 		else
 		{
 			IndexBufferRHIRef_t		indexBufferRHI = GLightSphereMesh.GetIndexBufferRHI();
-			lightingVertexShader->SetMesh( InDeviceContextRHI, pointLightComponents, vertexFactory, &InSceneView, pointLightComponents.size() );
+			lightingVertexShader->SetMesh( InDeviceContextRHI, pointLights, vertexFactory, &InSceneView, pointLights.size() );
 			GRHI->CommitConstants( InDeviceContextRHI );
 
 			if ( indexBufferRHI )
 			{
-				GRHI->DrawIndexedPrimitive( InDeviceContextRHI, indexBufferRHI, PT_TriangleList, 0, 0, GLightSphereMesh.GetNumPrimitives(), pointLightComponents.size() );
+				GRHI->DrawIndexedPrimitive( InDeviceContextRHI, indexBufferRHI, PT_TriangleList, 0, 0, GLightSphereMesh.GetNumPrimitives(), pointLights.size() );
 			}
 			else
 			{
-				GRHI->DrawPrimitive( InDeviceContextRHI, PT_TriangleList, 0, GLightSphereMesh.GetNumPrimitives(), pointLightComponents.size() );
+				GRHI->DrawPrimitive( InDeviceContextRHI, PT_TriangleList, 0, GLightSphereMesh.GetNumPrimitives(), pointLights.size() );
 			}
 		}
 	}
@@ -190,7 +186,7 @@ public:
 private:
 	TLightingVertexShader<LT_Point>*					lightingVertexShader;		/**< Point light vertex shader */
 	TLightingPixelShader<LT_Point>*						lightingPixelShader;		/**< Point light pixel shader */
-	std::list<TRefCountPtr<CPointLightComponent>>		pointLightComponents;		/**< List of point light components */
+	LightSceneProxyList_t								pointLights;				/**< List of point light proxies */
 };
 
 /**
@@ -208,7 +204,7 @@ public:
 	 * @param InLights			List of spot lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const std::list<TRefCountPtr<CSpotLightComponent>>& InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const LightSceneProxyList_t& InLights, float InDepthBias = 0.f )
 	{
 		CBaseLightingDrawingPolicy::Init( InVertexFactory, InDepthBias );
 
@@ -216,13 +212,14 @@ public:
 		uint64					vertexFactoryHash		= InVertexFactory->GetType()->GetHash();
 		vertexShader			= lightingVertexShader	= GShaderManager->FindInstance<TLightingVertexShader<LT_Spot>>( vertexFactoryHash );
 		pixelShader				= lightingPixelShader	= GShaderManager->FindInstance<TLightingPixelShader<LT_Spot>>( vertexFactoryHash );
-		spotLightComponents		= InLights;
+		spotLights				= InLights;
+		InitPipelineState();
 	}
 
 private:
 	TLightingVertexShader<LT_Spot>*					lightingVertexShader;		/**< Spot light vertex shader */
 	TLightingPixelShader<LT_Spot>*					lightingPixelShader;		/**< Spot light pixel shader */
-	std::list<TRefCountPtr<CSpotLightComponent>>	spotLightComponents;		/**< List of spot light components */
+	LightSceneProxyList_t							spotLights;					/**< List of spot light proxies */
 };
 
 /**
@@ -240,7 +237,7 @@ public:
 	 * @param InLights			List of directional lights
 	 * @param InDepthBias		Depth bias
 	 */
-	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const std::list<TRefCountPtr<CDirectionalLightComponent>>& InLights, float InDepthBias = 0.f )
+	FORCEINLINE void Init( class CVertexFactory* InVertexFactory, const LightSceneProxyList_t& InLights, float InDepthBias = 0.f )
 	{
 		CBaseLightingDrawingPolicy::Init( InVertexFactory, InDepthBias );
 
@@ -248,13 +245,94 @@ public:
 		uint64						vertexFactoryHash		= InVertexFactory->GetType()->GetHash();
 		vertexShader				= lightingVertexShader	= GShaderManager->FindInstance<TLightingVertexShader<LT_Directional>>( vertexFactoryHash );
 		pixelShader					= lightingPixelShader	= GShaderManager->FindInstance<TLightingPixelShader<LT_Directional>>( vertexFactoryHash );
-		directionalLightComponents	= InLights;
+		directionalLights			= InLights;
+		InitPipelineState();
 	}
 
 private:
 	TLightingVertexShader<LT_Directional>*				lightingVertexShader;			/**< Directional light vertex shader */
 	TLightingPixelShader<LT_Directional>*				lightingPixelShader;			/**< Directional light pixel shader */
-	std::list<TRefCountPtr<CDirectionalLightComponent>>	directionalLightComponents;		/**< List of directional light components */
+	LightSceneProxyList_t								directionalLights;				/**< List of directional light proxies */
+};
+
+/**
+ * @ingroup Engine
+ * @brief Clustered lighting drawing policy
+ */
+class CClusteredLightingDrawingPolicy
+{
+public:
+	/**
+	 * Initialize drawing policy
+	 */
+	FORCEINLINE void Init()
+	{
+		screenVertexShader		= GShaderManager->FindInstance<CScreenVertexShader<SVST_Fullscreen>, CSimpleElementVertexFactory>();
+		lightingPixelShader		= GShaderManager->FindInstance<CClusteredLightingPixelShader, CSimpleElementVertexFactory>();
+		check( screenVertexShader && lightingPixelShader );
+
+		// Lights are added into the scene color, so depth test and write are disabled and blending is additive
+		SPipelineStateInitializer		initializer;
+		initializer.vertexDeclaration	= GSimpleElementVertexDeclaration.GetVertexDeclarationRHI();
+		initializer.vertexFactoryHash	= CSimpleElementVertexFactory::staticType.GetHash();
+		initializer.vertexShader		= screenVertexShader;
+		initializer.pixelShader			= lightingPixelShader;
+		initializer.bUseDepthState		= true;
+		initializer.depthState			= { false, CF_Always };
+		initializer.bUseBlendState		= true;
+		initializer.blendState			= SBlendStateInitializerRHI( BO_Add, BF_One, BF_One, BO_Add, BF_One, BF_Zero, CF_Always, 255 );
+		pipelineState					= GPipelineStateCache.GetPipelineState( initializer );
+	}
+
+	/**
+	 * Set shader parameters
+	 *
+	 * @param InDeviceContextRHI			RHI device context
+	 * @param InLightGrid					Light grid
+	 * @param InDiffuseRoughnessGBufferRHI	RHI diffuse roughness GBuffer texture
+	 * @param InNormalMetalGBufferRHI		RHI normal metal GBuffer texture
+	 * @param InEmissionGBufferRHI			RHI emission GBuffer texture
+	 * @param InDepthBufferRHI				RHI depth buffer texture
+	 */
+	void SetShaderParameters( class CBaseDeviceContextRHI* InDeviceContextRHI, const CLightGrid& InLightGrid, Texture2DRHIParamRef_t InDiffuseRoughnessGBufferRHI, Texture2DRHIParamRef_t InNormalMetalGBufferRHI, Texture2DRHIParamRef_t InEmissionGBufferRHI, Texture2DRHIParamRef_t InDepthBufferRHI )
+	{
+		// GBuffer
+		lightingPixelShader->SetDiffuseRoughnessGBufferTexture( InDeviceContextRHI, InDiffuseRoughnessGBufferRHI );
+		lightingPixelShader->SetDiffuseRoughnessGBufferSamplerState( InDeviceContextRHI, TStaticSamplerStateRHI<>::GetRHI() );
+		lightingPixelShader->SetNormalMetalGBufferTexture( InDeviceContextRHI, InNormalMetalGBufferRHI );
+		lightingPixelShader->SetNormalMetalGBufferSamplerState( InDeviceContextRHI, TStaticSamplerStateRHI<>::GetRHI() );
+		lightingPixelShader->SetEmissionGBufferTexture( InDeviceContextRHI, InEmissionGBufferRHI );
+		lightingPixelShader->SetEmissionGBufferSamplerState( InDeviceContextRHI, TStaticSamplerStateRHI<>::GetRHI() );
+		lightingPixelShader->SetDepthBufferTexture( InDeviceContextRHI, InDepthBufferRHI );
+		lightingPixelShader->SetDepthBufferSamplerState( InDeviceContextRHI, TStaticSamplerStateRHI<>::GetRHI() );
+
+		// Light grid
+		lightingPixelShader->SetLightGrid( InDeviceContextRHI, InLightGrid );
+	}
+
+	/**
+	 * Set render state for drawing
+	 * @param InDeviceContextRHI	RHI device context
+	 */
+	void SetRenderState( class CBaseDeviceContextRHI* InDeviceContextRHI )
+	{
+		pipelineState->Set( InDeviceContextRHI );
+	}
+
+	/**
+	 * Draw lights by fullscreen triangle
+	 * @param InDeviceContextRHI	RHI device context
+	 */
+	void Draw( class CBaseDeviceContextRHI* InDeviceContextRHI )
+	{
+		GRHI->CommitConstants( InDeviceContextRHI );
+		GRHI->DrawPrimitive( InDeviceContextRHI, PT_TriangleList, 0, 1 );
+	}
+
+private:
+	CScreenVertexShader<SVST_Fullscreen>*	screenVertexShader;		/**< Fullscreen vertex shader */
+	CClusteredLightingPixelShader*			lightingPixelShader;	/**< Clustered lighting pixel shader */
+	PipelineStateRef_t						pipelineState;			/**< Pipeline state */
 };
 
 void CSceneRenderer::RenderLights( class CBaseDeviceContextRHI* InDeviceContext )
@@ -274,23 +352,30 @@ void CSceneRenderer::RenderLights( class CBaseDeviceContextRHI* InDeviceContext
 	GSceneRenderTargets.BeginRenderingSceneColor( InDeviceContext );
 	InDeviceContext->ClearSurface( GSceneRenderTargets.GetSceneColorSurface(), CColor::black );
 
-	std::list<TRefCountPtr<CPointLightComponent>>			pointLightComponents;
-	std::list<TRefCountPtr<CSpotLightComponent>>			spotLightComponents;
-	std::list<TRefCountPtr<CDirectionalLightComponent>>		directionalLightComponents;
+	// Point and spot lights are binned into light grid and drawn in one fullscreen pass
+	if ( GLightGrid.GetSettings().bEnable )
+	{
+		RenderClusteredLights( InDeviceContext );
+		return;
+	}
+
+	LightSceneProxyList_t		pointLights;
+	LightSceneProxyList_t		spotLights;
+	LightSceneProxyList_t		directionalLights;
 
-	// Separating light components by type
+	// Separating lights by type
 	{
-		const std::list<LightComponentRef_t>&				lightComponents = scene->GetVisibleLights();
-		for ( auto it = lightComponents.begin(), itEnd = lightComponents.end(); it != itEnd; ++it )
+		const LightSceneProxyList_t&		lightProxies = scene->GetVisibleLights();
+		for ( uint32 index = 0, count = lightProxies.size(); index < count; ++index )
 		{
-			LightComponentRef_t		lightComponent = *it;
-			switch ( lightComponent->GetLightType() )
+			const CLightSceneProxy*		lightProxy = lightProxies[ index ];
+			switch ( lightProxy->GetLightType() )
 			{
-			case LT_Point:			pointLightComponents.push_back( lightComponent );		break;
-			case LT_Spot:			spotLightComponents.push_back( lightComponent );		break;
-			case LT_Directional:	directionalLightComponents.push_back( lightComponent );	break;
+			case LT_Point:			pointLights.push_back( lightProxy );		break;
+			case LT_Spot:			spotLights.push_back( lightProxy );			break;
+			case LT_Directional:	directionalLights.push_back( lightProxy );	break;
 			default:
-				LE_LOG( LT_Warning, LC_Render, TEXT( "Unknown light type in '%s'" ), lightComponent->GetName() );
+				LE_LOG( LT_Warning, LC_Render, TEXT( "Unknown light type 0x%X" ), lightProxy->GetLightType() );
 				break;
 			}
 		}
@@ -299,9 +384,50 @@ void CSceneRenderer::RenderLights( class CBaseDeviceContextRHI* InDeviceContext
 	// Render point lights
 	{
 		TLightingDrawingPolicy<LT_Point>		lightingDrawingPolicy;
-		lightingDrawingPolicy.Init( pointLightComponents );
+		lightingDrawingPolicy.Init( pointLights );
 		lightingDrawingPolicy.SetShaderParameters( InDeviceContext, GSceneRenderTargets.GetDiffuse_Roughness_GBufferTexture(), GSceneRenderTargets.GetNormal_Metal_GBufferTexture(), GSceneRenderTargets.GetEmission_GBufferTexture(), GSceneRenderTargets.GetLightPassDepthZTexture() );
 		lightingDrawingPolicy.SetRenderState( InDeviceContext, TLightingDrawingPolicy<LT_Point>::PT_Base );
 		lightingDrawingPolicy.Draw( InDeviceContext, *sceneView );
 	}
-}
\ No newline at end of file
+}
+
+void CSceneRenderer::RenderClusteredLights( class CBaseDeviceContextRHI* InDeviceContext )
+{
+	// Collect point and spot lights for light grid
+	std::vector<SLightGridLight>				lights;
+	{
+		const LightSceneProxyList_t&			lightProxies = scene->GetVisibleLights();
+		lights.reserve( lightProxies.size() );
+		for ( uint32 index = 0, count = lightProxies.size(); index < count; ++index )
+		{
+			const CLightSceneProxy*		lightProxy = lightProxies[ index ];
+			if ( lightProxy->GetLightType() != LT_Point && lightProxy->GetLightType() != LT_Spot )
+			{
+				continue;
+			}
+
+			SLightGridLight				light;
+			light.position				= lightProxy->GetPosition();
+			light.radius				= lightProxy->GetRadius();
+			light.color					= Vector( lightProxy->GetLightColor().ToNormalizedVector4D() ) * lightProxy->GetIntensivity();
+			light.direction				= lightProxy->GetDirection();
+			light.cosInnerCone			= lightProxy->GetCosInnerCone();
+			light.cosOuterCone			= lightProxy->GetCosOuterCone();
+			lights.push_back( light );
+		}
+	}
+
+	// Bin lights and upload light grid once for the whole view
+	GLightGrid.Build( sceneView->GetViewMatrix(), sceneView->GetProjectionMatrix(), lights );
+	if ( !GLightGrid.GetNumLightIndeces() )
+	{
+		return;
+	}
+	GLightGrid.UpdateRHI( InDeviceContext );
+
+	CClusteredLightingDrawingPolicy		lightingDrawingPolicy;
+	lightingDrawingPolicy.Init();
+	lightingDrawingPolicy.SetRenderState( InDeviceContext );
+	lightingDrawingPolicy.SetShaderParameters( InDeviceContext, GLightGrid, GSceneRenderTargets.GetDiffuse_Roughness_GBufferTexture(), GSceneRenderTargets.GetNormal_Metal_GBufferTexture(), GSceneRenderTargets.GetEmission_GBufferTexture(), GSceneRenderTargets.GetLightPassDepthZTexture() );
+	lightingDrawingPolicy.Draw( InDeviceContext );
+}
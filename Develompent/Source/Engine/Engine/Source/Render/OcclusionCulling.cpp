@@ -0,0 +1,541 @@
+#include <cfloat>
+
+#include "Misc/CoreGlobals.h"
+#include "Math/TransformBatch.h"
+#include "System/Config.h"
+#include "System/ThreadPool.h"
+#include "Render/OcclusionCulling.h"
+
+#if WITH_SIMD_MATH
+#include <emmintrin.h>
+#endif // WITH_SIMD_MATH
+
+/**
+ * @ingroup Engine
+ * @brief Number of rows of depth buffer in one band, bands are rasterized in parallel
+ */
+#define OCCLUSION_BAND_HEIGHT		8
+
+/**
+ * @ingroup Engine
+ * @brief Min W of vertex in clip space, triangles and bounds closer to camera cross near plane
+ */
+#define OCCLUSION_MIN_W				1e-4f
+
+/**
+ * @ingroup Engine
+ * @brief Max size in texels of bounds on level of depth pyramid where they are tested
+ */
+#define OCCLUSION_TEST_TEXELS		4
+
+// -------------
+// GLOBALS
+// -------------
+TGlobalResource<COcclusionBuffer>		GOcclusionBuffer;
+
+/**
+ * Load settings from engine config
+ */
+void SOcclusionCullingSettings::LoadFromConfig()
+{
+	CConfigValue		configEnable = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "Enable" ) );
+	if ( configEnable.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configEnable.GetBool();
+	}
+
+	CConfigValue		configSizeX = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "SizeX" ) );
+	if ( configSizeX.IsA( CConfigValue::T_Int ) )
+	{
+		sizeX = Align( Max( configSizeX.GetInt(), 4 ), 4 );
+	}
+
+	CConfigValue		configSizeY = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "SizeY" ) );
+	if ( configSizeY.IsA( CConfigValue::T_Int ) )
+	{
+		sizeY = Max( configSizeY.GetInt(), 1 );
+	}
+
+	CConfigValue		configMaxOccluders = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "MaxOccluders" ) );
+	if ( configMaxOccluders.IsA( CConfigValue::T_Int ) )
+	{
+		maxOccluders = Max( configMaxOccluders.GetInt(), 0 );
+	}
+
+	CConfigValue		configMaxOccluderTriangles = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "MaxOccluderTriangles" ) );
+	if ( configMaxOccluderTriangles.IsA( CConfigValue::T_Int ) )
+	{
+		maxOccluderTriangles = Max( configMaxOccluderTriangles.GetInt(), 0 );
+	}
+
+	CConfigValue		configMaxMeshTriangles = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "MaxMeshTriangles" ) );
+	if ( configMaxMeshTriangles.IsA( CConfigValue::T_Int ) )
+	{
+		maxMeshTriangles = Max( configMaxMeshTriangles.GetInt(), 0 );
+	}
+
+	CConfigValue		configMinOccluderScreenRadius = GConfig.GetValue( CT_Engine, TEXT( "Engine.OcclusionCulling" ), TEXT( "MinOccluderScreenRadius" ) );
+	if ( configMinOccluderScreenRadius.IsA( CConfigValue::T_Float ) || configMinOccluderScreenRadius.IsA( CConfigValue::T_Int ) )
+	{
+		minOccluderScreenRadius = configMinOccluderScreenRadius.GetNumber();
+	}
+}
+
+/**
+ * Constructor
+ */
+COcclusionBuffer::COcclusionBuffer()
+	: viewProjectionMatrix( SMath::matrixIdentity )
+{}
+
+/**
+ * Begin new view
+ */
+void COcclusionBuffer::Begin( const Matrix& InViewProjectionMatrix )
+{
+	viewProjectionMatrix	= InViewProjectionMatrix;
+	stats					= SOcclusionCullingStats();
+	triangles.clear();
+
+	// Allocate levels of depth pyramid, each next level is twice smaller than previous one
+	depthPyramidLevels.clear();
+	uint32		offset	= 0;
+	uint32		sizeX	= settings.sizeX;
+	uint32		sizeY	= settings.sizeY;
+	while ( true )
+	{
+		depthPyramidLevels.push_back( SDepthPyramidLevel{ offset, sizeX, sizeY } );
+		offset += sizeX * sizeY;
+		if ( sizeX == 1 && sizeY == 1 )
+		{
+			break;
+		}
+
+		sizeX = Max<uint32>( ( sizeX + 1 ) / 2, 1 );
+		sizeY = Max<uint32>( ( sizeY + 1 ) / 2, 1 );
+	}
+	depthPyramid.resize( offset );
+}
+
+/**
+ * Add occluder
+ */
+bool COcclusionBuffer::AddOccluder( const Matrix& InLocalToWorld, const Vector4D* InVerteces, uint32 InNumVerteces, const uint32* InIndeces, uint32 InNumIndeces )
+{
+	check( InVerteces && InIndeces );
+	const uint32		numTriangles = InNumIndeces / 3;
+	if ( !numTriangles || stats.numOccluders >= settings.maxOccluders || stats.numOccluderTriangles + numTriangles > settings.maxOccluderTriangles )
+	{
+		return false;
+	}
+
+	// Transform verteces to clip space
+	const Matrix		localToClip = viewProjectionMatrix * InLocalToWorld;
+	clipVerteces.resize( InNumVerteces );
+	for ( uint32 index = 0; index < InNumVerteces; ++index )
+	{
+		const Vector4D&		vertex = InVerteces[ index ];
+		clipVerteces[ index ] = localToClip * Vector4D( vertex.x, vertex.y, vertex.z, 1.f );
+	}
+
+	// Setup triangles
+	for ( uint32 index = 0; index < numTriangles; ++index )
+	{
+		const uint32*		indeces = &InIndeces[ index * 3 ];
+		check( indeces[ 0 ] < InNumVerteces && indeces[ 1 ] < InNumVerteces && indeces[ 2 ] < InNumVerteces );
+		AddTriangle( clipVerteces[ indeces[ 0 ] ], clipVerteces[ indeces[ 1 ] ], clipVerteces[ indeces[ 2 ] ] );
+	}
+
+	++stats.numOccluders;
+	stats.numOccluderTriangles += numTriangles;
+	return true;
+}
+
+/**
+ * Add triangle in screen space
+ */
+void COcclusionBuffer::AddTriangle( const Vector4D& InV0, const Vector4D& InV1, const Vector4D& InV2 )
+{
+	// Triangles which cross near plane are skipped, without them buffer is still conservative
+	if ( InV0.w < OCCLUSION_MIN_W || InV1.w < OCCLUSION_MIN_W || InV2.w < OCCLUSION_MIN_W )
+	{
+		return;
+	}
+
+	// Project verteces to pixels of depth buffer
+	const float		halfSizeX = settings.sizeX * 0.5f;
+	const float		halfSizeY = settings.sizeY * 0.5f;
+	float			x[ 3 ], y[ 3 ], z[ 3 ];
+	const Vector4D*	verteces[ 3 ] = { &InV0, &InV1, &InV2 };
+	for ( uint32 index = 0; index < 3; ++index )
+	{
+		const Vector4D&		vertex	= *verteces[ index ];
+		const float			invW	= 1.f / vertex.w;
+		x[ index ] = ( vertex.x * invW + 1.f ) * halfSizeX;
+		y[ index ] = ( vertex.y * invW + 1.f ) * halfSizeY;
+		z[ index ] = vertex.z * invW;
+	}
+
+	// Skip degenerate triangles, other ones are turned to counter-clockwise winding
+	float			area = ( x[ 1 ] - x[ 0 ] ) * ( y[ 2 ] - y[ 0 ] ) - ( x[ 2 ] - x[ 0 ] ) * ( y[ 1 ] - y[ 0 ] );
+	if ( SMath::Abs( area ) < 1e-6f )
+	{
+		return;
+	}
+	else if ( area < 0.f )
+	{
+		std::swap( x[ 1 ], x[ 2 ] );
+		std::swap( y[ 1 ], y[ 2 ] );
+		std::swap( z[ 1 ], z[ 2 ] );
+		area = -area;
+	}
+
+	// Bounds of triangle in pixels
+	SOcclusionTriangle		triangle;
+	triangle.minX = ( int32 )SMath::Floor( Min( x[ 0 ], Min( x[ 1 ], x[ 2 ] ) ) );
+	triangle.minY = ( int32 )SMath::Floor( Min( y[ 0 ], Min( y[ 1 ], y[ 2 ] ) ) );
+	triangle.maxX = ( int32 )SMath::Floor( Max( x[ 0 ], Max( x[ 1 ], x[ 2 ] ) ) );
+	triangle.maxY = ( int32 )SMath::Floor( Max( y[ 0 ], Max( y[ 1 ], y[ 2 ] ) ) );
+	if ( triangle.maxX < 0 || triangle.maxY < 0 || triangle.minX >= ( int32 )settings.sizeX || triangle.minY >= ( int32 )settings.sizeY )
+	{
+		return;
+	}
+
+	triangle.minX = Max( triangle.minX, 0 );
+	triangle.minY = Max( triangle.minY, 0 );
+	triangle.maxX = Min( triangle.maxX, ( int32 )settings.sizeX - 1 );
+	triangle.maxY = Min( triangle.maxY, ( int32 )settings.sizeY - 1 );
+
+	// Edge functions, edge from vertex N to N+1
+	for ( uint32 index = 0; index < 3; ++index )
+	{
+		const uint32	next = ( index + 1 ) % 3;
+		triangle.edgeA[ index ] = y[ index ] - y[ next ];
+		triangle.edgeB[ index ] = x[ next ] - x[ index ];
+		triangle.edgeC[ index ] = x[ index ] * y[ next ] - x[ next ] * y[ index ];
+	}
+
+	// Depth is linear in screen space. Plane is shifted by max change of depth over half of pixel,
+	// so at pixel center it gives the farthest depth of triangle inside of pixel
+	const float		invArea = 1.f / area;
+	triangle.depthA		= ( ( z[ 1 ] - z[ 0 ] ) * ( y[ 2 ] - y[ 0 ] ) - ( z[ 2 ] - z[ 0 ] ) * ( y[ 1 ] - y[ 0 ] ) ) * invArea;
+	triangle.depthB		= ( ( z[ 2 ] - z[ 0 ] ) * ( x[ 1 ] - x[ 0 ] ) - ( z[ 1 ] - z[ 0 ] ) * ( x[ 2 ] - x[ 0 ] ) ) * invArea;
+	triangle.depthC		= z[ 0 ] - triangle.depthA * x[ 0 ] - triangle.depthB * y[ 0 ] + ( SMath::Abs( triangle.depthA ) + SMath::Abs( triangle.depthB ) ) * 0.5f;
+	triangle.maxDepth	= Max( z[ 0 ], Max( z[ 1 ], z[ 2 ] ) );
+	triangles.push_back( triangle );
+}
+
+/**
+ * Get span of pixels in row which may be inside of triangle
+ *
+ * @param InTriangle	Triangle
+ * @param InPixelY		Y of pixel centers in row
+ * @param OutMinX		Output first pixel of span
+ * @param OutMaxX		Output last pixel of span
+ * @return Return FALSE if row doesn't cross triangle, otherwise returns TRUE
+ */
+template<typename TTriangleType>
+static FORCEINLINE bool GetRowSpan( const TTriangleType& InTriangle, float InPixelY, int32& OutMinX, int32& OutMaxX )
+{
+	// Each edge function limits pixel centers in row from one side, span is widened by pixel against errors of rounding
+	float		minX = ( float )InTriangle.minX;
+	float		maxX = ( float )InTriangle.maxX;
+	for ( uint32 index = 0; index < 3; ++index )
+	{
+		const float		edgeA	= InTriangle.edgeA[ index ];
+		const float		rowE	= InTriangle.edgeB[ index ] * InPixelY + InTriangle.edgeC[ index ];
+		if ( edgeA > 0.f )
+		{
+			minX = Max( minX, -rowE / edgeA - 1.5f );
+		}
+		else if ( edgeA < 0.f )
+		{
+			maxX = Min( maxX, -rowE / edgeA + 0.5f );
+		}
+		else if ( rowE < 0.f )
+		{
+			return false;
+		}
+	}
+
+	if ( minX > maxX )
+	{
+		return false;
+	}
+
+	OutMinX = ( int32 )SMath::Floor( minX );
+	OutMaxX = ( int32 )SMath::Floor( maxX );
+	return OutMinX <= OutMaxX;
+}
+
+/**
+ * Rasterize added occluders and build depth pyramid
+ */
+void COcclusionBuffer::Rasterize()
+{
+	check( !depthPyramidLevels.empty() );
+	const uint32		numBands = ( settings.sizeY + OCCLUSION_BAND_HEIGHT - 1 ) / OCCLUSION_BAND_HEIGHT;
+	GThreadPool.ParallelFor( numBands, [&]( uint32 InBandIndex )
+							 {
+								 const int32		minY = InBandIndex * OCCLUSION_BAND_HEIGHT;
+								 const int32		maxY = Min<int32>( minY + OCCLUSION_BAND_HEIGHT, settings.sizeY ) - 1;
+								 RasterizeRows( minY, maxY );
+							 } );
+
+	BuildDepthPyramid();
+}
+
+/**
+ * Rasterize triangles into rows of depth buffer
+ */
+void COcclusionBuffer::RasterizeRows( int32 InMinY, int32 InMaxY )
+{
+	float*		depthBuffer = depthPyramid.data();
+	for ( int32 y = InMinY; y <= InMaxY; ++y )
+	{
+		std::fill( depthBuffer + y * settings.sizeX, depthBuffer + ( y + 1 ) * settings.sizeX, FLT_MAX );
+	}
+
+	for ( uint32 index = 0, count = triangles.size(); index < count; ++index )
+	{
+		const SOcclusionTriangle&		triangle = triangles[ index ];
+		const int32						minY = Max( triangle.minY, InMinY );
+		const int32						maxY = Min( triangle.maxY, InMaxY );
+		if ( minY > maxY )
+		{
+			continue;
+		}
+
+		// Depth is written only to texels which are whole inside of triangle, so each edge is inset by half a texel.
+		// Otherwise occluder covers texels behind its edges and hides objects which are visible there
+		const float		inset0	= 0.5f * ( SMath::Abs( triangle.edgeA[ 0 ] ) + SMath::Abs( triangle.edgeB[ 0 ] ) );
+		const float		inset1	= 0.5f * ( SMath::Abs( triangle.edgeA[ 1 ] ) + SMath::Abs( triangle.edgeB[ 1 ] ) );
+		const float		inset2	= 0.5f * ( SMath::Abs( triangle.edgeA[ 2 ] ) + SMath::Abs( triangle.edgeB[ 2 ] ) );
+
+#if WITH_SIMD_MATH
+		const __m128	pixelOffsets	= _mm_setr_ps( 0.5f, 1.5f, 2.5f, 3.5f );
+		const __m128	edgeA0			= _mm_set1_ps( triangle.edgeA[ 0 ] );
+		const __m128	edgeA1			= _mm_set1_ps( triangle.edgeA[ 1 ] );
+		const __m128	edgeA2			= _mm_set1_ps( triangle.edgeA[ 2 ] );
+		const __m128	depthA			= _mm_set1_ps( triangle.depthA );
+		const __m128	maxDepth		= _mm_set1_ps( triangle.maxDepth );
+		const __m128	minE0			= _mm_set1_ps( inset0 );
+		const __m128	minE1			= _mm_set1_ps( inset1 );
+		const __m128	minE2			= _mm_set1_ps( inset2 );
+
+		for ( int32 y = minY; y <= maxY; ++y )
+		{
+			// Pixels are processed by four, buffer width is multiple of 4, so the last group doesn't go out of row
+			const float		pixelY	= y + 0.5f;
+			int32			minX, maxX;
+			if ( !GetRowSpan( triangle, pixelY, minX, maxX ) )
+			{
+				continue;
+			}
+
+			minX &= ~3;
+			const __m128	rowE0	= _mm_set1_ps( triangle.edgeB[ 0 ] * pixelY + triangle.edgeC[ 0 ] );
+			const __m128	rowE1	= _mm_set1_ps( triangle.edgeB[ 1 ] * pixelY + triangle.edgeC[ 1 ] );
+			const __m128	rowE2	= _mm_set1_ps( triangle.edgeB[ 2 ] * pixelY + triangle.edgeC[ 2 ] );
+			const __m128	rowDepth = _mm_set1_ps( triangle.depthB * pixelY + triangle.depthC );
+			float*			row		= depthBuffer + y * settings.sizeX;
+
+			for ( int32 x = minX; x <= maxX; x += 4 )
+			{
+				const __m128	pixelX	= _mm_add_ps( _mm_set1_ps( ( float )x ), pixelOffsets );
+				const __m128	e0		= _mm_add_ps( _mm_mul_ps( edgeA0, pixelX ), rowE0 );
+				const __m128	e1		= _mm_add_ps( _mm_mul_ps( edgeA1, pixelX ), rowE1 );
+				const __m128	e2		= _mm_add_ps( _mm_mul_ps( edgeA2, pixelX ), rowE2 );
+				const __m128	inside	= _mm_and_ps( _mm_cmpge_ps( e0, minE0 ), _mm_and_ps( _mm_cmpge_ps( e1, minE1 ), _mm_cmpge_ps( e2, minE2 ) ) );
+				if ( !_mm_movemask_ps( inside ) )
+				{
+					continue;
+				}
+
+				const __m128	depth		= _mm_min_ps( _mm_add_ps( _mm_mul_ps( depthA, pixelX ), rowDepth ), maxDepth );
+				const __m128	oldDepth	= _mm_loadu_ps( row + x );
+				const __m128	newDepth	= _mm_min_ps( oldDepth, depth );
+				_mm_storeu_ps( row + x, _mm_or_ps( _mm_and_ps( inside, newDepth ), _mm_andnot_ps( inside, oldDepth ) ) );
+			}
+		}
+#else
+		for ( int32 y = minY; y <= maxY; ++y )
+		{
+			const float		pixelY	= y + 0.5f;
+			int32			minX, maxX;
+			if ( !GetRowSpan( triangle, pixelY, minX, maxX ) )
+			{
+				continue;
+			}
+
+			float*			row		= depthBuffer + y * settings.sizeX;
+			for ( int32 x = minX; x <= maxX; ++x )
+			{
+				const float		pixelX	= x + 0.5f;
+				if ( triangle.edgeA[ 0 ] * pixelX + triangle.edgeB[ 0 ] * pixelY + triangle.edgeC[ 0 ] < inset0 ||
+					 triangle.edgeA[ 1 ] * pixelX + triangle.edgeB[ 1 ] * pixelY + triangle.edgeC[ 1 ] < inset1 ||
+					 triangle.edgeA[ 2 ] * pixelX + triangle.edgeB[ 2 ] * pixelY + triangle.edgeC[ 2 ] < inset2 )
+				{
+					continue;
+				}
+
+				const float		depth = Min( triangle.depthA * pixelX + triangle.depthB * pixelY + triangle.depthC, triangle.maxDepth );
+				row[ x ] = Min( row[ x ], depth );
+			}
+		}
+#endif // WITH_SIMD_MATH
+	}
+}
+
+/**
+ * Build levels of depth pyramid from the first one
+ */
+void COcclusionBuffer::BuildDepthPyramid()
+{
+	for ( uint32 levelIndex = 1, numLevels = depthPyramidLevels.size(); levelIndex < numLevels; ++levelIndex )
+	{
+		const SDepthPyramidLevel&	srcLevel	= depthPyramidLevels[ levelIndex - 1 ];
+		const SDepthPyramidLevel&	dstLevel	= depthPyramidLevels[ levelIndex ];
+		const float*				src			= depthPyramid.data() + srcLevel.offset;
+		float*						dst			= depthPyramid.data() + dstLevel.offset;
+
+		GThreadPool.ParallelFor( dstLevel.sizeY, [&]( uint32 InY )
+								 {
+									 const float*	srcRow0 = src + InY * 2 * srcLevel.sizeX;
+									 const float*	srcRow1 = src + Min( InY * 2 + 1, srcLevel.sizeY - 1 ) * srcLevel.sizeX;
+									 float*			dstRow	= dst + InY * dstLevel.sizeX;
+									 uint32			x		= 0;
+
+#if WITH_SIMD_MATH
+									 // Eight texels of two source rows give four texels of destination row
+									 for ( ; x + 4 <= dstLevel.sizeX && ( x + 4 ) * 2 <= srcLevel.sizeX; x += 4 )
+									 {
+										 const __m128	max0 = _mm_max_ps( _mm_loadu_ps( srcRow0 + x * 2 ), _mm_loadu_ps( srcRow1 + x * 2 ) );
+										 const __m128	max1 = _mm_max_ps( _mm_loadu_ps( srcRow0 + x * 2 + 4 ), _mm_loadu_ps( srcRow1 + x * 2 + 4 ) );
+										 _mm_storeu_ps( dstRow + x, _mm_max_ps( _mm_shuffle_ps( max0, max1, _MM_SHUFFLE( 2, 0, 2, 0 ) ), _mm_shuffle_ps( max0, max1, _MM_SHUFFLE( 3, 1, 3, 1 ) ) ) );
+									 }
+#endif // WITH_SIMD_MATH
+
+									 for ( ; x < dstLevel.sizeX; ++x )
+									 {
+										 const uint32	srcX0 = x * 2;
+										 const uint32	srcX1 = Min( srcX0 + 1, srcLevel.sizeX - 1 );
+										 dstRow[ x ] = Max( Max( srcRow0[ srcX0 ], srcRow0[ srcX1 ] ), Max( srcRow1[ srcX0 ], srcRow1[ srcX1 ] ) );
+									 }
+								 }, OCCLUSION_BAND_HEIGHT );
+	}
+}
+
+/**
+ * Is visible bounds
+ */
+bool COcclusionBuffer::IsVisible( const CBox& InBox ) const
+{
+	if ( !InBox.IsValid() || depthPyramidLevels.empty() || !stats.numOccluders )
+	{
+		return true;
+	}
+
+	// Project corners of bounds to pixels, if bounds cross near plane they are visible.
+	// Corners are min corner in clip space plus scaled columns of matrix by axes
+	const Vector		boxSize		= InBox.GetMax() - InBox.GetMin();
+	const Vector4D		minCorner	= viewProjectionMatrix * Vector4D( InBox.GetMin(), 1.f );
+	const Vector4D		axisX		= viewProjectionMatrix[ 0 ] * boxSize.x;
+	const Vector4D		axisY		= viewProjectionMatrix[ 1 ] * boxSize.y;
+	const Vector4D		axisZ		= viewProjectionMatrix[ 2 ] * boxSize.z;
+	float				minX		= FLT_MAX,	minY = FLT_MAX,		minDepth = FLT_MAX;
+	float				maxX		= -FLT_MAX,	maxY = -FLT_MAX;
+	for ( uint32 index = 0; index < 8; ++index )
+	{
+		Vector4D		corner = minCorner;
+		if ( index & 1 )
+		{
+			corner += axisX;
+		}
+		if ( index & 2 )
+		{
+			corner += axisY;
+		}
+		if ( index & 4 )
+		{
+			corner += axisZ;
+		}
+
+		if ( corner.w < OCCLUSION_MIN_W )
+		{
+			return true;
+		}
+
+		const float		invW	= 1.f / corner.w;
+		const float		x		= ( corner.x * invW + 1.f ) * settings.sizeX * 0.5f;
+		const float		y		= ( corner.y * invW + 1.f ) * settings.sizeY * 0.5f;
+		minX		= Min( minX, x );
+		minY		= Min( minY, y );
+		maxX		= Max( maxX, x );
+		maxY		= Max( maxY, y );
+		minDepth	= Min( minDepth, corner.z * invW );
+	}
+
+	// Pixels touched by bounds
+	int32		pixelMinX	= Max( ( int32 )SMath::Floor( minX ), 0 );
+	int32		pixelMinY	= Max( ( int32 )SMath::Floor( minY ), 0 );
+	int32		pixelMaxX	= Min( ( int32 )SMath::Floor( maxX ), ( int32 )settings.sizeX - 1 );
+	int32		pixelMaxY	= Min( ( int32 )SMath::Floor( maxY ), ( int32 )settings.sizeY - 1 );
+	if ( pixelMinX > pixelMaxX || pixelMinY > pixelMaxY )
+	{
+		return true;
+	}
+
+	// Select level of depth pyramid where bounds cover few texels
+	uint32		levelIndex = 0;
+	while ( levelIndex + 1 < depthPyramidLevels.size() && ( pixelMaxX - pixelMinX >= OCCLUSION_TEST_TEXELS || pixelMaxY - pixelMinY >= OCCLUSION_TEST_TEXELS ) )
+	{
+		pixelMinX >>= 1;
+		pixelMinY >>= 1;
+		pixelMaxX >>= 1;
+		pixelMaxY >>= 1;
+		++levelIndex;
+	}
+
+	// Bounds are occluded if the nearest point of them is behind the farthest depth of occluders in all texels
+	const SDepthPyramidLevel&	level = depthPyramidLevels[ levelIndex ];
+	const float*				texels = depthPyramid.data() + level.offset;
+	for ( int32 y = pixelMinY; y <= pixelMaxY; ++y )
+	{
+		for ( int32 x = pixelMinX; x <= pixelMaxX; ++x )
+		{
+			if ( minDepth <= texels[ y * level.sizeX + x ] )
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+/**
+ * Test visibility of array of bounds in parallel
+ */
+void COcclusionBuffer::TestVisibility( const CBox* InBoxes, uint32 InNumBoxes, uint8* OutVisibility )
+{
+	check( InBoxes && OutVisibility );
+	GThreadPool.ParallelFor( InNumBoxes, [&]( uint32 InIndex )
+							 {
+								 OutVisibility[ InIndex ] = IsVisible( InBoxes[ InIndex ] ) ? 1 : 0;
+							 }, 64 );
+
+	stats.numTestedPrimitives += InNumBoxes;
+	for ( uint32 index = 0; index < InNumBoxes; ++index )
+	{
+		stats.numCulledPrimitives += OutVisibility[ index ] ? 0 : 1;
+	}
+}
+
+/**
+ * Initializes the RHI resources
+ */
+void COcclusionBuffer::InitRHI()
+{
+	settings.LoadFromConfig();
+}
@@ -0,0 +1,497 @@
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Archive.h"
+#include "System/BaseFileSystem.h"
+#include "System/Config.h"
+#include "Render/PipelineState.h"
+#include "Render/RenderingThread.h"
+#include "Render/Shaders/ShaderManager.h"
+#include "RHI/BaseRHI.h"
+
+/**
+ * @ingroup Engine
+ * Min size of record in list of pipeline states on disk (hashes and lengths of shader names)
+ */
+#define PIPELINESTATECACHE_MIN_RECORD_SIZE		( sizeof( uint64 ) * 3 + sizeof( uint32 ) * 2 )
+
+/**
+ * @ingroup Engine
+ * Version of records in list of pipeline states on disk, increase it on each change of SPipelineStateRecord
+ */
+#define PIPELINESTATECACHE_VERSION				1
+
+// -------------
+// GLOBALS
+// -------------
+TGlobalResource<CPipelineStateCache>		GPipelineStateCache;
+
+/**
+ * Constructor
+ */
+SPipelineStateInitializer::SPipelineStateInitializer()
+	: vertexFactoryHash( INVALID_HASH )
+	, vertexShader( nullptr )
+	, pixelShader( nullptr )
+	, bUseDepthState( false )
+	, bUseBlendState( false )
+	, blendState( BO_Add, BF_One, BF_Zero, BO_Add, BF_One, BF_Zero, CF_Always, 255 )
+{
+	rasterizerState.fillMode			= FM_Solid;
+	rasterizerState.cullMode			= CM_None;
+	rasterizerState.depthBias			= 0.f;
+	rasterizerState.slopeScaleDepthBias	= 0.f;
+	rasterizerState.isAllowMSAA			= true;
+	depthState.bEnableDepthWrite		= true;
+	depthState.depthTest				= CF_LessEqual;
+}
+
+/**
+ * Get hash
+ */
+uint64 SPipelineStateInitializer::GetHash() const
+{
+	check( vertexShader && pixelShader );
+
+	// Fields are hashed one by one, padding of the structs would make hash random
+	uint64		hash = vertexDeclaration ? vertexDeclaration->GetHash() : 0;
+	hash = appCalcHash( vertexShader->GetName(), hash );
+	hash = appCalcHash( pixelShader->GetName(), hash );
+	hash = appMemFastHash( vertexFactoryHash, hash );
+	hash = appMemFastHash( rasterizerState.fillMode, hash );
+	hash = appMemFastHash( rasterizerState.cullMode, hash );
+	hash = appMemFastHash( rasterizerState.depthBias, hash );
+	hash = appMemFastHash( rasterizerState.slopeScaleDepthBias, hash );
+	hash = appMemFastHash( rasterizerState.isAllowMSAA, hash );
+
+	hash = appMemFastHash( bUseDepthState, hash );
+	if ( bUseDepthState )
+	{
+		hash = appMemFastHash( depthState.bEnableDepthWrite, hash );
+		hash = appMemFastHash( depthState.depthTest, hash );
+	}
+
+	hash = appMemFastHash( bUseBlendState, hash );
+	if ( bUseBlendState )
+	{
+		hash = appMemFastHash( blendState.colorBlendOperation, hash );
+		hash = appMemFastHash( blendState.colorSourceBlendFactor, hash );
+		hash = appMemFastHash( blendState.colorDestBlendFactor, hash );
+		hash = appMemFastHash( blendState.alphaBlendOperation, hash );
+		hash = appMemFastHash( blendState.alphaSourceBlendFactor, hash );
+		hash = appMemFastHash( blendState.alphaDestBlendFactor, hash );
+		hash = appMemFastHash( blendState.alphaTest, hash );
+		hash = appMemFastHash( blendState.alphaRef, hash );
+	}
+	return hash;
+}
+
+/**
+ * Constructor
+ */
+CPipelineState::CPipelineState( const SPipelineStateInitializer& InInitializer )
+	: initializer( InInitializer )
+	, hash( InInitializer.GetHash() )
+{}
+
+/**
+ * Set pipeline state to device context
+ */
+void CPipelineState::Set( class CBaseDeviceContextRHI* InDeviceContextRHI ) const
+{
+	check( IsInRenderingThread() && IsInitialized() );
+	GRHI->SetRasterizerState( InDeviceContextRHI, rasterizerState );
+	GRHI->SetBoundShaderState( InDeviceContextRHI, boundShaderState );
+
+	if ( depthState )
+	{
+		GRHI->SetDepthState( InDeviceContextRHI, depthState );
+	}
+
+	if ( blendState )
+	{
+		GRHI->SetBlendState( InDeviceContextRHI, blendState );
+	}
+}
+
+/**
+ * Initializes the RHI resources
+ */
+void CPipelineState::InitRHI()
+{
+	check( initializer.vertexDeclaration && initializer.vertexShader && initializer.pixelShader );
+	boundShaderState	= GRHI->CreateBoundShaderState( initializer.vertexShader->GetName().c_str(), initializer.vertexDeclaration, initializer.vertexShader->GetVertexShader(), initializer.pixelShader->GetPixelShader() );
+	rasterizerState		= GRHI->CreateRasterizerState( initializer.rasterizerState );
+
+	if ( initializer.bUseDepthState )
+	{
+		depthState		= GRHI->CreateDepthState( initializer.depthState );
+	}
+
+	if ( initializer.bUseBlendState )
+	{
+		blendState		= GRHI->CreateBlendState( initializer.blendState );
+	}
+}
+
+/**
+ * Releases the RHI resources
+ */
+void CPipelineState::ReleaseRHI()
+{
+	boundShaderState.SafeRelease();
+	rasterizerState.SafeRelease();
+	depthState.SafeRelease();
+	blendState.SafeRelease();
+}
+
+/**
+ * Constructor
+ */
+CPipelineStateCache::CPipelineStateCache()
+	: bDirtyList( false )
+{}
+
+/**
+ * Get pipeline state
+ */
+PipelineStateRef_t CPipelineStateCache::GetPipelineState( const SPipelineStateInitializer& InInitializer )
+{
+	CScopeLock		scopeLock( cs );
+	return FindOrCreate( InInitializer, false );
+}
+
+/**
+ * Find pipeline state in cache or create new one
+ */
+PipelineStateRef_t CPipelineStateCache::FindOrCreate( const SPipelineStateInitializer& InInitializer, bool InIsPrewarm )
+{
+	uint64		hash = InInitializer.GetHash();
+	auto		itPipelineState = pipelineStates.find( hash );
+	if ( itPipelineState != pipelineStates.end() )
+	{
+		return itPipelineState->second;
+	}
+
+	// RHI objects are created by the render thread before any draw with this state
+	PipelineStateRef_t		pipelineState = new CPipelineState( InInitializer );
+	BeginInitResource( pipelineState );
+	pipelineStates[ hash ] = pipelineState;
+	stats.numPipelineStates = ( uint32 )pipelineStates.size();
+
+	if ( InIsPrewarm )
+	{
+		++stats.numPrewarmed;
+	}
+	else if ( recordHashes.insert( hash ).second )
+	{
+		// This state wasn't seen before, it's added to the list for prewarm it on next launch
+		SPipelineStateRecord		record;
+		record.hash						= hash;
+		record.vertexShaderName			= InInitializer.vertexShader->GetName();
+		record.pixelShaderName			= InInitializer.pixelShader->GetName();
+		record.vertexFactoryHash		= InInitializer.vertexFactoryHash;
+		record.vertexDeclarationHash	= InInitializer.vertexDeclaration ? InInitializer.vertexDeclaration->GetHash() : 0;
+		record.rasterizerState			= InInitializer.rasterizerState;
+		record.bUseDepthState			= InInitializer.bUseDepthState;
+		record.depthState				= InInitializer.depthState;
+		record.bUseBlendState			= InInitializer.bUseBlendState;
+		record.blendState				= InInitializer.blendState;
+		records.push_back( record );
+
+		bDirtyList = true;
+		++stats.numCreatedInPlay;
+	}
+
+	return pipelineState;
+}
+
+/**
+ * Create pipeline state from record
+ */
+bool CPipelineStateCache::CreateFromRecord( const SPipelineStateRecord& InRecord, VertexDeclarationRHIParamRef_t InVertexDeclaration )
+{
+	SPipelineStateInitializer		initializer;
+	initializer.vertexDeclaration	= InVertexDeclaration;
+	initializer.vertexFactoryHash	= InRecord.vertexFactoryHash;
+	initializer.vertexShader		= GShaderManager->FindInstance( InRecord.vertexShaderName, InRecord.vertexFactoryHash );
+	initializer.pixelShader			= GShaderManager->FindInstance( InRecord.pixelShaderName, InRecord.vertexFactoryHash );
+	initializer.rasterizerState		= InRecord.rasterizerState;
+	initializer.bUseDepthState		= InRecord.bUseDepthState;
+	initializer.depthState			= InRecord.depthState;
+	initializer.bUseBlendState		= InRecord.bUseBlendState;
+	initializer.blendState			= InRecord.blendState;
+
+	// Shaders could be removed after the list was saved
+	if ( !initializer.vertexShader || !initializer.pixelShader )
+	{
+		return false;
+	}
+
+	FindOrCreate( initializer, true );
+	return true;
+}
+
+/**
+ * Register vertex declaration
+ */
+void CPipelineStateCache::RegisterVertexDeclaration( VertexDeclarationRHIParamRef_t InVertexDeclaration )
+{
+	check( IsInRenderingThread() && InVertexDeclaration );
+	CScopeLock		scopeLock( cs );
+
+	uint64			vertexDeclarationHash = InVertexDeclaration->GetHash();
+	if ( vertexDeclarations.find( vertexDeclarationHash ) != vertexDeclarations.end() )
+	{
+		return;
+	}
+	vertexDeclarations[ vertexDeclarationHash ] = InVertexDeclaration;
+
+	// Create pipeline states which wait for this declaration
+	for ( uint32 index = 0; index < ( uint32 )pendingRecords.size(); )
+	{
+		if ( pendingRecords[ index ].vertexDeclarationHash != vertexDeclarationHash )
+		{
+			++index;
+			continue;
+		}
+
+		CreateFromRecord( pendingRecords[ index ], InVertexDeclaration );
+		pendingRecords[ index ] = pendingRecords.back();
+		pendingRecords.pop_back();
+	}
+}
+
+/**
+ * Load list of pipeline states from disk and create them
+ */
+void CPipelineStateCache::Prewarm()
+{
+	CConfigValue		configPrewarm = GConfig.GetValue( CT_Engine, TEXT( "Engine.PipelineStateCache" ), TEXT( "Prewarm" ) );
+	if ( configPrewarm.IsA( CConfigValue::T_Bool ) && !configPrewarm.GetBool() )
+	{
+		return;
+	}
+
+	// List saved by the game is newer than shipped one, so it's tried first
+	std::vector<SPipelineStateRecord>	loadedRecords;
+	std::wstring						savedPath = GetSavedListPath();
+	std::wstring						path = GetListPath();
+	if ( !LoadList( savedPath, loadedRecords ) && ( savedPath == path || !LoadList( path, loadedRecords ) ) )
+	{
+		LE_LOG( LT_Log, LC_Render, TEXT( "Valid list of pipeline states '%s' not found, states will be created in play" ), path.c_str() );
+		return;
+	}
+
+	uint32			numRecords = ( uint32 )loadedRecords.size();
+	CScopeLock		scopeLock( cs );
+	uint32			numCreated = 0;
+	for ( uint32 index = 0; index < numRecords; ++index )
+	{
+		const SPipelineStateRecord&		record = loadedRecords[ index ];
+		if ( !recordHashes.insert( record.hash ).second )
+		{
+			continue;
+		}
+		records.push_back( record );
+
+		// If vertex declaration isn't registered yet the state will be created when it's done
+		auto		itVertexDeclaration = vertexDeclarations.find( record.vertexDeclarationHash );
+		if ( itVertexDeclaration == vertexDeclarations.end() )
+		{
+			pendingRecords.push_back( record );
+		}
+		else if ( CreateFromRecord( record, itVertexDeclaration->second ) )
+		{
+			++numCreated;
+		}
+	}
+
+	LE_LOG( LT_Log, LC_Render, TEXT( "Loaded %i pipeline states, %i created, %i wait for vertex declaration" ), numRecords, numCreated, ( uint32 )pendingRecords.size() );
+}
+
+/**
+ * Load list of pipeline states from disk
+ */
+bool CPipelineStateCache::LoadList( const std::wstring& InPath, std::vector<SPipelineStateRecord>& OutRecords ) const
+{
+	CArchive*		archive = GFileSystem->CreateFileReader( InPath );
+	if ( !archive )
+	{
+		return false;
+	}
+
+	// Check file tag before header, SerializeHeader asserts on files which aren't archives
+	uint32		archiveFileTag = 0;
+	if ( archive->GetSize() >= sizeof( archiveFileTag ) )
+	{
+		*archive << archiveFileTag;
+		archive->Seek( 0 );
+	}
+
+	if ( archiveFileTag != ARCHIVE_FILE_TAG )
+	{
+		LE_LOG( LT_Warning, LC_Render, TEXT( "List of pipeline states '%s' isn't archive, it's skipped" ), InPath.c_str() );
+		delete archive;
+		return false;
+	}
+
+	uint32		listVersion = 0;
+	uint32		numRecords = 0;
+	archive->SerializeHeader();
+	if ( archive->Type() != AT_PipelineStateCache || archive->Ver() > VER_PACKAGE_LATEST )
+	{
+		LE_LOG( LT_Warning, LC_Render, TEXT( "List of pipeline states '%s' has wrong type %i or version %i, it's skipped" ), InPath.c_str(), archive->Type(), archive->Ver() );
+		delete archive;
+		return false;
+	}
+
+	*archive << listVersion;
+	if ( listVersion != PIPELINESTATECACHE_VERSION )
+	{
+		LE_LOG( LT_Warning, LC_Render, TEXT( "List of pipeline states '%s' has version of records %i, but current is %i, it's skipped" ), InPath.c_str(), listVersion, PIPELINESTATECACHE_VERSION );
+		delete archive;
+		return false;
+	}
+
+	// Broken list can have garbage in number of records, so it's checked by size of file
+	*archive << numRecords;
+	if ( numRecords > ( archive->GetSize() - archive->Tell() ) / PIPELINESTATECACHE_MIN_RECORD_SIZE )
+	{
+		LE_LOG( LT_Warning, LC_Render, TEXT( "List of pipeline states '%s' is broken (%i records), it's skipped" ), InPath.c_str(), numRecords );
+		delete archive;
+		return false;
+	}
+
+	OutRecords.resize( numRecords );
+	for ( uint32 index = 0; index < numRecords; ++index )
+	{
+		SerializeRecord( *archive, OutRecords[ index ] );
+	}
+	delete archive;
+	return true;
+}
+
+/**
+ * Save list of pipeline states on disk
+ */
+void CPipelineStateCache::SaveList()
+{
+	CScopeLock		scopeLock( cs );
+	LE_LOG( LT_Log, LC_Render, TEXT( "Pipeline states: %i, prewarmed %i, created in play %i" ), stats.numPipelineStates, stats.numPrewarmed, stats.numCreatedInPlay );
+	if ( !bDirtyList )
+	{
+		return;
+	}
+
+	std::wstring		path = GetSavedListPath();
+	GFileSystem->MakeDirectory( appSavedDir(), true );
+	CArchive*			archive = GFileSystem->CreateFileWriter( path );
+	if ( !archive )
+	{
+		LE_LOG( LT_Warning, LC_Render, TEXT( "Failed to save list of pipeline states '%s'" ), path.c_str() );
+		return;
+	}
+
+	uint32		listVersion = PIPELINESTATECACHE_VERSION;
+	uint32		numRecords = ( uint32 )records.size();
+	archive->SetType( AT_PipelineStateCache );
+	archive->SerializeHeader();
+	*archive << listVersion;
+	*archive << numRecords;
+	for ( uint32 index = 0; index < numRecords; ++index )
+	{
+		SerializeRecord( *archive, records[ index ] );
+	}
+	delete archive;
+
+	bDirtyList = false;
+	LE_LOG( LT_Log, LC_Render, TEXT( "Saved %i pipeline states to '%s'" ), numRecords, path.c_str() );
+}
+
+/**
+ * Serialize record
+ */
+void CPipelineStateCache::SerializeRecord( class CArchive& InArchive, SPipelineStateRecord& InRecord )
+{
+	InArchive << InRecord.hash;
+	InArchive << InRecord.vertexShaderName;
+	InArchive << InRecord.pixelShaderName;
+	InArchive << InRecord.vertexFactoryHash;
+	InArchive << InRecord.vertexDeclarationHash;
+
+	InArchive.Serialize( &InRecord.rasterizerState.fillMode, sizeof( InRecord.rasterizerState.fillMode ) );
+	InArchive.Serialize( &InRecord.rasterizerState.cullMode, sizeof( InRecord.rasterizerState.cullMode ) );
+	InArchive << InRecord.rasterizerState.depthBias;
+	InArchive << InRecord.rasterizerState.slopeScaleDepthBias;
+	InArchive << InRecord.rasterizerState.isAllowMSAA;
+
+	InArchive << InRecord.bUseDepthState;
+	InArchive << InRecord.depthState.bEnableDepthWrite;
+	InArchive.Serialize( &InRecord.depthState.depthTest, sizeof( InRecord.depthState.depthTest ) );
+
+	InArchive << InRecord.bUseBlendState;
+	InArchive.Serialize( &InRecord.blendState.colorBlendOperation, sizeof( InRecord.blendState.colorBlendOperation ) );
+	InArchive.Serialize( &InRecord.blendState.colorSourceBlendFactor, sizeof( InRecord.blendState.colorSourceBlendFactor ) );
+	InArchive.Serialize( &InRecord.blendState.colorDestBlendFactor, sizeof( InRecord.blendState.colorDestBlendFactor ) );
+	InArchive.Serialize( &InRecord.blendState.alphaBlendOperation, sizeof( InRecord.blendState.alphaBlendOperation ) );
+	InArchive.Serialize( &InRecord.blendState.alphaSourceBlendFactor, sizeof( InRecord.blendState.alphaSourceBlendFactor ) );
+	InArchive.Serialize( &InRecord.blendState.alphaDestBlendFactor, sizeof( InRecord.blendState.alphaDestBlendFactor ) );
+	InArchive.Serialize( &InRecord.blendState.alphaTest, sizeof( InRecord.blendState.alphaTest ) );
+	InArchive.Serialize( &InRecord.blendState.alphaRef, sizeof( InRecord.blendState.alphaRef ) );
+}
+
+/**
+ * Get filename of list of pipeline states
+ */
+std::wstring CPipelineStateCache::GetListFilename( EShaderPlatform InShaderPlatform )
+{
+	return CString::Format( TEXT( "PipelineStateCache-%s.bin" ), ShaderPlatformToText( InShaderPlatform ) );
+}
+
+/**
+ * Get path to list of pipeline states
+ */
+std::wstring CPipelineStateCache::GetListPath() const
+{
+#if WITH_EDITOR
+	if ( GIsEditor || GIsCooker || GIsCommandlet )
+	{
+		return appGameDir() + PATH_SEPARATOR + TEXT( "Content" ) + PATH_SEPARATOR + GetListFilename( GRHI->GetShaderPlatform() );
+	}
+#endif // WITH_EDITOR
+
+	return GCookedDir + PATH_SEPARATOR + GetListFilename( GRHI->GetShaderPlatform() );
+}
+
+/**
+ * Get path to list of pipeline states which is saved at runtime
+ */
+std::wstring CPipelineStateCache::GetSavedListPath() const
+{
+#if WITH_EDITOR
+	if ( GIsEditor || GIsCooker || GIsCommandlet )
+	{
+		return GetListPath();
+	}
+#endif // WITH_EDITOR
+
+	// Cooked directory may be read only, so in game list is saved to directory of user data
+	return appSavedDir() + GetListFilename( GRHI->GetShaderPlatform() );
+}
+
+/**
+ * Releases the RHI resources
+ */
+void CPipelineStateCache::ReleaseRHI()
+{
+	CScopeLock		scopeLock( cs );
+	for ( auto it = pipelineStates.begin(), itEnd = pipelineStates.end(); it != itEnd; ++it )
+	{
+		it->second->ReleaseResource();
+	}
+
+	pipelineStates.clear();
+	vertexDeclarations.clear();
+	stats.numPipelineStates = 0;
+}
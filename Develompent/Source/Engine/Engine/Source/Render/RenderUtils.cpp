@@ -28,7 +28,8 @@ SPixelFormatInfo		GPixelFormats[ PF_Max ] =
 	{ TEXT( "BC3" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC3						},
 	{ TEXT( "BC5" ),					4,			4,			1,			16,			2,				0,				0,				0,				PF_BC5						},
 	{ TEXT( "BC6H" ),					1,			1,			1,			16,			3,				0,				0,				0,				PF_BC6H						},
-	{ TEXT( "BC7" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC7						}
+	{ TEXT( "BC7" ),					4,			4,			1,			16,			4,				0,				0,				0,				PF_BC7						},
+	{ TEXT( "A32B32G32R32F" ),			1,			1,			1,			16,			4,				0,				0,				0,				PF_A32B32G32R32F			}
 };
 
 /** Offset to center of the pixel */
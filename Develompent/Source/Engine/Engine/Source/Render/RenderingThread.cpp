@@ -4,6 +4,7 @@
 #include "Logger/LoggerMacros.h"
 #include "Render/RenderingThread.h"
 #include "System/TickableObject.h"
+#include "System/Malloc.h"
 
 //
 // Definitions
@@ -87,6 +88,8 @@ bool CRenderingThread::Init()
 
 uint32 CRenderingThread::Run()
 {
+	SCOPED_MEMORY_TAG( MTAG_Render );
+
 	void*		readPointer = nullptr;
 	uint32		numReadBytes = 0;
 
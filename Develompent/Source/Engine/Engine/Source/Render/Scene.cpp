@@ -1,6 +1,10 @@
+#include <algorithm>
+#include <cfloat>
+
 #include "Math/Math.h"
 #include "Render/SceneRenderTargets.h"
 #include "Render/Scene.h"
+#include "Render/StaticMesh.h"
 #include "System/ConVar.h"
 
 #if WITH_EDITOR
@@ -45,6 +49,32 @@ CSceneView::CSceneView( const Vector& InPosition, const Matrix& InProjectionMatr
 	frustum.Update( viewProjectionMatrix );
 }
 
+float CSceneView::GetScreenRadius( const CBox& InBoundBox ) const
+{
+	if ( !InBoundBox.IsValid() )
+	{
+		return 0.f;
+	}
+
+	// Project radius of bounding sphere to the screen. For orthographic projection size on screen doesn't depend on distance
+	const Vector		center			= ( InBoundBox.GetMin() + InBoundBox.GetMax() ) * 0.5f;
+	const float			radius			= SMath::LengthVector( InBoundBox.GetMax() - InBoundBox.GetMin() ) * 0.5f;
+	float				screenRadius	= radius * projectionMatrix[ 1 ][ 1 ];
+	if ( projectionMatrix[ 3 ][ 3 ] < 1.f )
+	{
+		const float		distance = SMath::DistanceVector( center, position );
+
+		// Camera is inside of bounds, the primitive covers all screen
+		if ( distance <= radius )
+		{
+			return FLT_MAX;
+		}
+		screenRadius /= distance;
+	}
+
+	return screenRadius;
+}
+
 void CSceneView::ScreenToWorld( const Vector2D& InScreenPoint, Vector& OutWorldOrigin, Vector& OutWorldDirection ) const
 {
 	int32	x = SMath::Trunc( InScreenPoint.x ),
@@ -97,6 +127,11 @@ void CSceneView::ScreenToWorld( const Vector2D& InScreenPoint, Vector& OutWorldO
 CScene::~CScene()
 {
 	Clear();
+
+	// Proxies are removed by the render thread, so wait until it's done
+	FlushProxyUpdates();
+	FlushRenderingCommands();
+	DeleteRemovedPrimitiveProxies();
 }
 
 void CScene::AddPrimitive( class CPrimitiveComponent* InPrimitive )
@@ -117,6 +152,11 @@ void CScene::AddPrimitive( class CPrimitiveComponent* InPrimitive )
 	InPrimitive->scene = this;
 	InPrimitive->LinkDrawList();
 	primitives.push_back( InPrimitive );
+
+	// Proxy is created with current state of primitive, so previous changes aren't needed
+	InPrimitive->sceneProxy				= new CPrimitiveSceneProxy( InPrimitive );
+	InPrimitive->sceneProxyDirtyFlags	= SPU_None;
+	AddProxyUpdate( SPUT_AddPrimitive, InPrimitive->sceneProxy );
 }
 
 void CScene::RemovePrimitive( class CPrimitiveComponent* InPrimitive )
@@ -128,6 +168,15 @@ void CScene::RemovePrimitive( class CPrimitiveComponent* InPrimitive )
 			InPrimitive->UnlinkDrawList();
 			InPrimitive->scene = nullptr;
 			primitives.erase( it );
+
+			if ( InPrimitive->sceneProxyDirtyFlags != SPU_None )
+			{
+				dirtyPrimitives.erase( std::find( dirtyPrimitives.begin(), dirtyPrimitives.end(), InPrimitive ) );
+				InPrimitive->sceneProxyDirtyFlags = SPU_None;
+			}
+
+			AddProxyUpdate( SPUT_RemovePrimitive, InPrimitive->sceneProxy );
+			InPrimitive->sceneProxy = nullptr;
 			return;
 		}
 	}
@@ -150,6 +199,10 @@ void CScene::AddLight( class CLightComponent* InLight )
 
 	InLight->scene = this;
 	lights.push_back( InLight );
+
+	InLight->sceneProxy			= new CLightSceneProxy( InLight );
+	InLight->bSceneProxyDirty	= false;
+	AddProxyUpdate( SPUT_AddLight, nullptr, InLight->sceneProxy );
 }
 
 void CScene::RemoveLight( class CLightComponent* InLight )
@@ -160,51 +213,343 @@ void CScene::RemoveLight( class CLightComponent* InLight )
 		{
 			InLight->scene = nullptr;
 			lights.erase( it );
+
+			if ( InLight->bSceneProxyDirty )
+			{
+				dirtyLights.erase( std::find( dirtyLights.begin(), dirtyLights.end(), InLight ) );
+				InLight->bSceneProxyDirty = false;
+			}
+
+			AddProxyUpdate( SPUT_RemoveLight, nullptr, InLight->sceneProxy );
+			InLight->sceneProxy = nullptr;
 			return;
 		}
 	}
 }
 
+void CScene::UpdatePrimitive( class CPrimitiveComponent* InPrimitive, uint32 InFlags )
+{
+	check( InPrimitive && InPrimitive->scene == this );
+	if ( InPrimitive->sceneProxyDirtyFlags == SPU_None )
+	{
+		dirtyPrimitives.push_back( InPrimitive );
+	}
+	InPrimitive->sceneProxyDirtyFlags |= InFlags;
+}
+
+void CScene::UpdateLight( class CLightComponent* InLight )
+{
+	check( InLight && InLight->scene == this );
+	if ( !InLight->bSceneProxyDirty )
+	{
+		dirtyLights.push_back( InLight );
+		InLight->bSceneProxyDirty = true;
+	}
+}
+
 void CScene::Clear()
 {
 	for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
 	{
 		CPrimitiveComponent*		primitiveComponent = *it;
 		primitiveComponent->UnlinkDrawList();
-		primitiveComponent->scene = nullptr;
+		primitiveComponent->scene					= nullptr;
+		primitiveComponent->sceneProxyDirtyFlags	= SPU_None;
+		AddProxyUpdate( SPUT_RemovePrimitive, primitiveComponent->sceneProxy );
+		primitiveComponent->sceneProxy				= nullptr;
 	}
 
 	for ( auto it = lights.begin(), itEnd = lights.end(); it != itEnd; ++it )
 	{
 		CLightComponent*		lightComponent = *it;
-		lightComponent->scene = nullptr;
+		lightComponent->scene				= nullptr;
+		lightComponent->bSceneProxyDirty	= false;
+		AddProxyUpdate( SPUT_RemoveLight, nullptr, lightComponent->sceneProxy );
+		lightComponent->sceneProxy			= nullptr;
 	}
 
 	primitives.clear();
 	lights.clear();
+	dirtyPrimitives.clear();
+	dirtyLights.clear();
+
+	// Sprite batches are used only by the rendering thread
+	UNIQUE_RENDER_COMMAND_ONEPARAMETER( CClearSpriteBatchesCommand,
+										CScene*, scene, this,
+										{
+											scene->spriteBatches.clear();
+										} );
+}
+
+SSceneProxyUpdate& CScene::AddProxyUpdate( ESceneProxyUpdateType InType, CPrimitiveSceneProxy* InPrimitiveProxy, CLightSceneProxy* InLightProxy /* = nullptr */, CLightSceneProxy* InOldLightProxy /* = nullptr */ )
+{
+	pendingUpdates.push_back( SSceneProxyUpdate() );
+	SSceneProxyUpdate&		update = pendingUpdates.back();
+	update.type				= InType;
+	update.flags			= SPU_None;
+	update.primitiveProxy	= InPrimitiveProxy;
+	update.lightProxy		= InLightProxy;
+	update.oldLightProxy	= InOldLightProxy;
+	update.bVisibility		= false;
+	return update;
+}
+
+void CScene::DeleteRemovedPrimitiveProxies()
+{
+	std::vector<CPrimitiveSceneProxy*>		primitiveProxiesToDelete;
+	{
+		CScopeLock		scopeLock( &removedPrimitiveProxiesCS );
+		primitiveProxiesToDelete.swap( removedPrimitiveProxies );
+	}
+
+	for ( uint32 index = 0, count = primitiveProxiesToDelete.size(); index < count; ++index )
+	{
+		delete primitiveProxiesToDelete[ index ];
+	}
+}
+
+void CScene::FlushProxyUpdates()
+{
+	DeleteRemovedPrimitiveProxies();
+
+	// Each changed component is sent once with its latest state
+	for ( uint32 index = 0, count = dirtyPrimitives.size(); index < count; ++index )
+	{
+		CPrimitiveComponent*	primitiveComponent = dirtyPrimitives[ index ];
+		SSceneProxyUpdate&		update = AddProxyUpdate( SPUT_UpdatePrimitive, primitiveComponent->sceneProxy );
+		update.flags			= primitiveComponent->sceneProxyDirtyFlags;
+		if ( update.flags & SPU_Transform )
+		{
+			update.localToWorld	= primitiveComponent->GetRenderMatrix();
+			update.boundbox		= primitiveComponent->GetBoundBox();
+		}
+		update.bVisibility		= primitiveComponent->IsVisibility();
+		primitiveComponent->sceneProxyDirtyFlags = SPU_None;
+	}
+
+	for ( uint32 index = 0, count = dirtyLights.size(); index < count; ++index )
+	{
+		CLightComponent*		lightComponent = dirtyLights[ index ];
+		CLightSceneProxy*		lightProxy = new CLightSceneProxy( lightComponent );
+		AddProxyUpdate( SPUT_ReplaceLight, nullptr, lightProxy, lightComponent->sceneProxy );
+		lightComponent->sceneProxy			= lightProxy;
+		lightComponent->bSceneProxyDirty	= false;
+	}
+
+	dirtyPrimitives.clear();
+	dirtyLights.clear();
+	if ( pendingUpdates.empty() )
+	{
+		return;
+	}
+
+	// All updates of frame are sent by one command
+	std::vector<SSceneProxyUpdate>*		updates = new std::vector<SSceneProxyUpdate>();
+	updates->swap( pendingUpdates );
+	UNIQUE_RENDER_COMMAND_TWOPARAMETER( CUpdateSceneProxiesCommand,
+										CScene*, scene, this,
+										std::vector<SSceneProxyUpdate>*, updates, updates,
+										{
+											scene->ApplyProxyUpdates( *updates );
+											delete updates;
+										} );
+}
+
+template<typename TProxyType>
+void CScene::RemoveSceneProxy( std::vector<TProxyType*>& InOutProxies, TProxyType* InProxy )
+{
+	check( InProxy->sceneIndex < InOutProxies.size() && InOutProxies[ InProxy->sceneIndex ] == InProxy );
+	TProxyType*		lastProxy = InOutProxies.back();
+	InOutProxies[ InProxy->sceneIndex ] = lastProxy;
+	lastProxy->sceneIndex = InProxy->sceneIndex;
+	InOutProxies.pop_back();
+}
+
+void CScene::ApplyProxyUpdates( const std::vector<SSceneProxyUpdate>& InUpdates )
+{
+	check( IsInRenderingThread() );
+	for ( uint32 index = 0, count = InUpdates.size(); index < count; ++index )
+	{
+		const SSceneProxyUpdate&		update = InUpdates[ index ];
+		switch ( update.type )
+		{
+		case SPUT_AddPrimitive:
+			update.primitiveProxy->sceneIndex = primitiveProxies.size();
+			primitiveProxies.push_back( update.primitiveProxy );
+			break;
+
+		case SPUT_RemovePrimitive:
+		{
+			// Proxy holds the last reference to component, so it's deleted on the game thread
+			RemoveSceneProxy( primitiveProxies, update.primitiveProxy );
+			update.primitiveProxy->component->OnRemovedFromScene( this, *update.primitiveProxy );
+			CScopeLock		scopeLock( &removedPrimitiveProxiesCS );
+			removedPrimitiveProxies.push_back( update.primitiveProxy );
+			break;
+		}
+
+		case SPUT_UpdatePrimitive:
+		{
+			CPrimitiveSceneProxy*		primitiveProxy = update.primitiveProxy;
+			if ( update.flags & SPU_Transform )
+			{
+				primitiveProxy->localToWorld	= update.localToWorld;
+				primitiveProxy->boundbox		= update.boundbox;
+			}
+			if ( update.flags & SPU_Visibility )
+			{
+				if ( primitiveProxy->bVisibility && !update.bVisibility )
+				{
+					primitiveProxy->component->OnHidden( *primitiveProxy );
+				}
+				primitiveProxy->bVisibility		= update.bVisibility;
+			}
+			if ( update.flags & SPU_Material )
+			{
+				primitiveProxy->bDirtyDrawingPolicyLink = true;
+			}
+			primitiveProxy->component->OnSceneProxyUpdated( *primitiveProxy, update.flags );
+			break;
+		}
+
+		case SPUT_AddLight:
+			update.lightProxy->sceneIndex = lightProxies.size();
+			lightProxies.push_back( update.lightProxy );
+			break;
+
+		case SPUT_RemoveLight:
+			RemoveSceneProxy( lightProxies, update.lightProxy );
+			delete update.lightProxy;
+			break;
+
+		case SPUT_ReplaceLight:
+			update.lightProxy->sceneIndex = update.oldLightProxy->sceneIndex;
+			lightProxies[ update.lightProxy->sceneIndex ] = update.lightProxy;
+			delete update.oldLightProxy;
+			break;
+
+		default:
+			appErrorf( TEXT( "Unknown scene proxy update 0x%X" ), update.type );
+			break;
+		}
+	}
+}
+
+SpriteBatchRef_t CScene::GetSpriteBatch( const TAssetHandle<CMaterial>& InMaterial, ESceneDepthGroup InSDGType )
+{
+	uint64		hash = appMemFastHash( InSDGType, appMemFastHash( InMaterial.ToSharedPtr().Get() ) );
+	auto		it = spriteBatches.find( hash );
+	if ( it != spriteBatches.end() )
+	{
+		return it->second;
+	}
+
+	SpriteBatchRef_t		spriteBatch = new CSpriteBatch( InMaterial );
+	BeginInitResource( spriteBatch );
+	spriteBatches.insert( std::make_pair( hash, spriteBatch ) );
+	return spriteBatch;
 }
 
 void CScene::BuildView( const CSceneView& InSceneView )
 {
-	// Add to SDGs visible primitives
-	for ( auto it = primitives.begin(), itEnd = primitives.end(); it != itEnd; ++it )
+	// Collect primitives in frustum, other ones are culled
+	const CFrustum&		frustum = InSceneView.GetFrustum();
+	visiblePrimitiveProxies.clear();
+	GStaticMeshLODStats = SStaticMeshLODStats();
+	for ( uint32 index = 0, count = primitiveProxies.size(); index < count; ++index )
 	{
-		CPrimitiveComponent*		primitiveComponent = *it;
-		if ( primitiveComponent->IsVisibility() && InSceneView.GetFrustum().IsIn( primitiveComponent->GetBoundBox() ) )
+		CPrimitiveSceneProxy*		primitiveProxy = primitiveProxies[ index ];
+		if ( !primitiveProxy->IsVisibility() )
+		{
+			continue;
+		}
+
+		if ( frustum.IsIn( primitiveProxy->GetBoundBox() ) )
+		{
+			visiblePrimitiveProxies.push_back( primitiveProxy );
+		}
+		else
 		{
-			primitiveComponent->AddToDrawList( InSceneView );
+			primitiveProxy->GetComponent()->OnCulled( InSceneView, *primitiveProxy );
+		}
+	}
+
+	// Add to SDGs primitives which aren't occluded
+	bool	bOcclusionCulled = OcclusionCull( InSceneView );
+	for ( uint32 index = 0, count = visiblePrimitiveProxies.size(); index < count; ++index )
+	{
+		CPrimitiveSceneProxy*		primitiveProxy = visiblePrimitiveProxies[ index ];
+		if ( !bOcclusionCulled || primitiveVisibility[ index ] )
+		{
+			primitiveProxy->GetComponent()->AddToDrawList( InSceneView, *primitiveProxy );
+			primitiveProxy->bDirtyDrawingPolicyLink = false;
+		}
+		else
+		{
+			primitiveProxy->GetComponent()->OnCulled( InSceneView, *primitiveProxy );
 		}
 	}
 
 	// Add to scene frame visible lights
-	for ( auto it = lights.begin(), itEnd = lights.end(); it != itEnd; ++it )
+	for ( uint32 index = 0, count = lightProxies.size(); index < count; ++index )
 	{
-		CLightComponent*		lightComponent = *it;
-		if ( lightComponent->IsEnabled() )
+		const CLightSceneProxy*		lightProxy = lightProxies[ index ];
+		if ( lightProxy->IsEnabled() )
+		{
+			frame.visibleLights.push_back( lightProxy );
+		}
+	}
+}
+
+bool CScene::OcclusionCull( const CSceneView& InSceneView )
+{
+	const SOcclusionCullingSettings&	settings = GOcclusionBuffer.GetSettings();
+	if ( !settings.bEnable || visiblePrimitiveProxies.empty() || ( InSceneView.GetShowFlags() & SHOW_Wireframe ) )
+	{
+		return false;
+	}
+
+	// Select the biggest primitives on screen as occluders
+	occluderCandidates.clear();
+	for ( uint32 index = 0, count = visiblePrimitiveProxies.size(); index < count; ++index )
+	{
+		const CPrimitiveSceneProxy*		primitiveProxy = visiblePrimitiveProxies[ index ];
+		float							screenRadius = InSceneView.GetScreenRadius( primitiveProxy->GetBoundBox() );
+		if ( screenRadius >= settings.minOccluderScreenRadius )
 		{
-			frame.visibleLights.push_back( lightComponent );
+			occluderCandidates.push_back( std::make_pair( screenRadius, primitiveProxy ) );
 		}
 	}
+
+	std::sort( occluderCandidates.begin(), occluderCandidates.end(), []( const std::pair<float, const CPrimitiveSceneProxy*>& InA, const std::pair<float, const CPrimitiveSceneProxy*>& InB )
+			   {
+				   return InA.first > InB.first;
+			   } );
+
+	// Add occluders until budget is over, primitives without occluder geometry are skipped
+	GOcclusionBuffer.Begin( InSceneView.GetViewProjectionMatrix() );
+	for ( uint32 index = 0, count = occluderCandidates.size(); index < count && GOcclusionBuffer.GetStats().numOccluders < settings.maxOccluders; ++index )
+	{
+		const CPrimitiveSceneProxy*		primitiveProxy = occluderCandidates[ index ].second;
+		primitiveProxy->GetComponent()->AddOccluder( GOcclusionBuffer, *primitiveProxy );
+	}
+
+	if ( !GOcclusionBuffer.GetStats().numOccluders )
+	{
+		return false;
+	}
+
+	// Rasterize occluders and test bounds of all primitives in frustum
+	GOcclusionBuffer.Rasterize();
+	visiblePrimitiveBounds.resize( visiblePrimitiveProxies.size() );
+	primitiveVisibility.resize( visiblePrimitiveProxies.size() );
+	for ( uint32 index = 0, count = visiblePrimitiveProxies.size(); index < count; ++index )
+	{
+		visiblePrimitiveBounds[ index ] = visiblePrimitiveProxies[ index ]->GetBoundBox();
+	}
+
+	GOcclusionBuffer.TestVisibility( visiblePrimitiveBounds.data(), visiblePrimitiveBounds.size(), primitiveVisibility.data() );
+	return true;
 }
 
 void CScene::ClearView()
@@ -0,0 +1,54 @@
+#include "Render/SceneProxy.h"
+#include "Actors/Actor.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/PointLightComponent.h"
+#include "Components/SpotLightComponent.h"
+
+CPrimitiveSceneProxy::CPrimitiveSceneProxy( class CPrimitiveComponent* InComponent )
+	: component( InComponent )
+	, owner( InComponent->GetOwner() )
+	, localToWorld( InComponent->GetRenderMatrix() )
+	, boundbox( InComponent->GetBoundBox() )
+	, bVisibility( InComponent->IsVisibility() )
+	, bDirtyDrawingPolicyLink( true )
+	, sceneIndex( INDEX_NONE )
+{}
+
+CPrimitiveSceneProxy::~CPrimitiveSceneProxy()
+{
+	check( IsInGameThread() );
+}
+
+CLightSceneProxy::CLightSceneProxy( const class CLightComponent* InComponent )
+	: lightType( InComponent->GetLightType() )
+	, bEnabled( InComponent->IsEnabled() )
+	, localToWorld( InComponent->GetComponentMatrix() )
+	, position( InComponent->GetComponentLocation() )
+	, direction( InComponent->GetComponentTransform().GetUnitAxis( A_Z ) )
+	, lightColor( InComponent->GetLightColor() )
+	, specularColor( InComponent->GetSpecularColor() )
+	, intensivity( InComponent->GetIntensivity() )
+	, radius( 0.f )
+	, cosInnerCone( -1.f )
+	, cosOuterCone( -2.f )
+	, sceneIndex( INDEX_NONE )
+{
+	switch ( lightType )
+	{
+	case LT_Point:
+		radius			= ( ( const CPointLightComponent* )InComponent )->GetRadius();
+		break;
+
+	case LT_Spot:
+	{
+		const CSpotLightComponent*		spotLightComponent = ( const CSpotLightComponent* )InComponent;
+		radius			= spotLightComponent->GetRadius();
+		cosInnerCone	= SMath::Cos( SMath::DegreesToRadians( spotLightComponent->GetInnerConeAngle() ) );
+		cosOuterCone	= SMath::Cos( SMath::DegreesToRadians( spotLightComponent->GetOuterConeAngle() ) );
+		break;
+	}
+
+	default:
+		break;
+	}
+}
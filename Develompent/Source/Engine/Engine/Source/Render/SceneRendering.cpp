@@ -123,7 +123,7 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 		return false;
 	}
 
-	SCOPED_DRAW_EVENT( EventSDG, DEC_SCENE_ITEMS, CString::Format( TEXT( "SDG %s" ), GetSceneSDGName( ( ESceneDepthGroup )InSDGIndex ) ).c_str() );
+	SCOPED_DRAW_EVENTF( EventSDG, DEC_SCENE_ITEMS, TEXT( "SDG %s" ), GetSceneSDGName( ( ESceneDepthGroup )InSDGIndex ) );
 
 #if WITH_EDITOR
 	// Draw simple elements
@@ -144,8 +144,23 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 	// Draw static meshes
 	if ( showFlags & SHOW_StaticMesh && SDG.staticMeshDrawList.GetNum() > 0 )
 	{
-		SCOPED_DRAW_EVENT( EventStaticMeshes, DEC_STATIC_MESH, TEXT( "Static meshes" ) );
-		SDG.staticMeshDrawList.Draw( InDeviceContext, *sceneView );
+		// Depth of occluders is already in depth buffer, so hidden pixels of static meshes are rejected before pixel shader.
+		// If all static meshes is drawn in prepass, their depth is known exactly and we needn't write it again
+		bool		bDepthPrepass = RenderDepthPrepass( InDeviceContext, SDG );
+		if ( bDepthPrepass && GetDepthPrepassSettings().IsAllOccluders() )
+		{
+			GRHI->SetDepthState( InDeviceContext, TStaticDepthStateRHI<false, CF_Equal>::GetRHI() );
+		}
+
+		{
+			SCOPED_DRAW_EVENT( EventStaticMeshes, DEC_STATIC_MESH, TEXT( "Static meshes" ) );
+			SDG.staticMeshDrawList.Draw( InDeviceContext, *sceneView );
+		}
+
+		if ( bDepthPrepass )
+		{
+			GRHI->SetDepthState( InDeviceContext, TStaticDepthStateRHI<true>::GetRHI() );
+		}
 	}
 
 	// Draw sprites
@@ -191,6 +206,23 @@ bool CSceneRenderer::RenderSDG( class CBaseDeviceContextRHI* InDeviceContext, ui
 	return true;
 }
 
+bool CSceneRenderer::RenderDepthPrepass( class CBaseDeviceContextRHI* InDeviceContext, SSceneDepthGroup& InSDG )
+{
+	if ( !GetDepthPrepassSettings().bEnable || InSDG.depthDrawList.GetNum() <= 0 
+#if WITH_EDITOR
+		 || sceneView->GetShowFlags() & SHOW_Wireframe
+#endif // WITH_EDITOR
+		 )
+	{
+		return false;
+	}
+
+	SCOPED_DRAW_EVENT( EventDepthPrepass, DEC_STATIC_MESH, TEXT( "Depth prepass" ) );
+	GRHI->SetDepthState( InDeviceContext, TStaticDepthStateRHI<true>::GetRHI() );
+	InSDG.depthDrawList.Draw( InDeviceContext, *sceneView );
+	return true;
+}
+
 void CSceneRenderer::FinishRenderViewTarget( ViewportRHIParamRef_t InViewportRHI )
 {
 	SCOPED_DRAW_EVENT( EventFinishRenderViewTarget, DEC_SCENE_ITEMS, TEXT( "Finish Render View Target" ) );
@@ -0,0 +1,23 @@
+#include "Render/SceneUtils.h"
+#include "Render/RenderingThread.h"
+#include "System/ConVar.h"
+
+#if FRAME_CAPTURE_MARKERS
+/**
+ * @ingroup Engine
+ * @brief CVar enable/disable draw events
+ * @note This console variable is exist only with frame capture markers
+ */
+CConVar		CVarRDrawEvents( TEXT( "r.drawEvents" ), TEXT( "0" ), CVT_Bool, TEXT( "Enable/Disable draw events for frame capture tools. They are enabled automatically when the tool is attached" ) );
+
+bool		CScopedDrawEvent::bEnabled = false;
+
+/**
+ * Update runtime toggle of draw events
+ */
+void CScopedDrawEvent::UpdateEnabled()
+{
+	check( IsInRenderingThread() );
+	bEnabled = CVarRDrawEvents.GetValueBool() || GRHI->IsFrameCaptureToolAttached();
+}
+#endif // FRAME_CAPTURE_MARKERS
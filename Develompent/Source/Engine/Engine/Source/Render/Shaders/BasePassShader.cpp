@@ -154,6 +154,7 @@ void CBasePassPixelShader::SetConstantParameters( class CBaseDeviceContextRHI* I
 
 #if WITH_EDITOR
 #include "Render/VertexFactory/LightVertexFactory.h"
+#include "Render/VertexFactory/StaticMeshVertexFactory.h"
 
 bool CBasePassVertexShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
 {
@@ -162,7 +163,7 @@ bool CBasePassVertexShader::ShouldCache( EShaderPlatform InShaderPlatform, class
 		return true;
 	}
 
-	return InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash();
+	return InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() && InVFMetaType->GetHash() != CStaticMeshDepthVertexFactory::staticType.GetHash();
 }
 
 bool CBasePassPixelShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
@@ -172,6 +173,6 @@ bool CBasePassPixelShader::ShouldCache( EShaderPlatform InShaderPlatform, class
 		return true;
 	}
 
-	return InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash();
+	return InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() && InVFMetaType->GetHash() != CStaticMeshDepthVertexFactory::staticType.GetHash();
 }
 #endif // WITH_EDITOR
\ No newline at end of file
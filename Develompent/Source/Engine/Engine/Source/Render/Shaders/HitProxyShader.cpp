@@ -23,15 +23,16 @@ CHitProxyVertexShader::~CHitProxyVertexShader()
 
 #if WITH_EDITOR
 #include "Render/VertexFactory/LightVertexFactory.h"
+#include "Render/VertexFactory/StaticMeshVertexFactory.h"
 
 bool CHitProxyVertexShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
 {
-	return !GIsCooker && ( !InVFMetaType || InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() );
+	return !GIsCooker && ( !InVFMetaType || ( InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() && InVFMetaType->GetHash() != CStaticMeshDepthVertexFactory::staticType.GetHash() ) );
 }
 
 bool CHitProxyPixelShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
 {
-	return !GIsCooker && ( !InVFMetaType || InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() );
+	return !GIsCooker && ( !InVFMetaType || ( InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() && InVFMetaType->GetHash() != CStaticMeshDepthVertexFactory::staticType.GetHash() ) );
 }
 #endif // WITH_EDITOR
 
@@ -1,5 +1,6 @@
 #include "Math/Math.h"
 #include "Render/Shaders/LightingShader.h"
+#include "Render/LightGrid.h"
 #include "Render/VertexFactory/VertexFactory.h"
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
 
@@ -12,6 +13,7 @@ IMPLEMENT_SHADER_TYPE(, TLightingVertexShader<LT_Directional>, TEXT( "LightingVe
 IMPLEMENT_SHADER_TYPE(, TLightingPixelShader<LT_Point>, TEXT( "LightingPixelShaders.hlsl" ), TEXT( "MainPS" ), SF_Pixel, true );
 IMPLEMENT_SHADER_TYPE(, TLightingPixelShader<LT_Spot>, TEXT( "LightingPixelShaders.hlsl" ), TEXT( "MainPS" ), SF_Pixel, true );
 IMPLEMENT_SHADER_TYPE(, TLightingPixelShader<LT_Directional>, TEXT( "LightingPixelShaders.hlsl" ), TEXT( "MainPS" ), SF_Pixel, true );
+IMPLEMENT_SHADER_TYPE(, CClusteredLightingPixelShader, TEXT( "ClusteredLightingPixelShader.hlsl" ), TEXT( "MainPS" ), SF_Pixel, true );
 
 CBaseLightingVertexShader::CBaseLightingVertexShader()
 	: vertexFactoryParameters( nullptr )
@@ -68,4 +70,45 @@ void CBaseLightingPixelShader::Init( const CShaderCache::SShaderCacheItem& InSha
 	// Depth buffer
 	depthBufferParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "depthBufferTexture" ), true );
 	depthBufferSamplerParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "depthBufferSampler" ), true );
-}
\ No newline at end of file
+}
+
+#if WITH_EDITOR
+bool CClusteredLightingPixelShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
+{
+	if ( !InVFMetaType )
+	{
+		return true;
+	}
+
+	// Shader is drawn by fullscreen triangle, like screen shaders
+	return InVFMetaType->GetHash() == CSimpleElementVertexFactory::staticType.GetHash();
+}
+
+void CClusteredLightingPixelShader::ModifyCompilationEnvironment( EShaderPlatform InShaderPlatform, SShaderCompilerEnvironment& InEnvironment )
+{
+	// Layout of light grid textures must be the same as in CLightGrid
+	InEnvironment.difinitions.insert( std::make_pair( TEXT( "LIGHTGRID_TEXTURE_WIDTH" ), std::to_wstring( LIGHTGRID_TEXTURE_WIDTH ) ) );
+	InEnvironment.difinitions.insert( std::make_pair( TEXT( "LIGHTGRID_TEXELS_PER_LIGHT" ), std::to_wstring( LIGHTGRID_TEXELS_PER_LIGHT ) ) );
+}
+#endif // WITH_EDITOR
+
+void CClusteredLightingPixelShader::Init( const CShaderCache::SShaderCacheItem& InShaderCacheItem )
+{
+	CBaseLightingPixelShader::Init( InShaderCacheItem );
+
+	// Light grid
+	lightGridClustersParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "lightGridClustersTexture" ) );
+	lightGridIndecesParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "lightGridIndecesTexture" ) );
+	lightGridLightsParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "lightGridLightsTexture" ) );
+	lightGridSizeParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "lightGridSize" ) );
+	lightGridDepthParamsParameter.Bind( InShaderCacheItem.parameterMap, TEXT( "lightGridDepthParams" ) );
+}
+
+void CClusteredLightingPixelShader::SetLightGrid( class CBaseDeviceContextRHI* InDeviceContextRHI, const class CLightGrid& InLightGrid ) const
+{
+	SetTextureParameter( InDeviceContextRHI, lightGridClustersParameter, InLightGrid.GetClusterTextureRHI() );
+	SetTextureParameter( InDeviceContextRHI, lightGridIndecesParameter, InLightGrid.GetLightIndexTextureRHI() );
+	SetTextureParameter( InDeviceContextRHI, lightGridLightsParameter, InLightGrid.GetLightDataTextureRHI() );
+	SetPixelShaderValue( InDeviceContextRHI, lightGridSizeParameter, InLightGrid.GetGridSize() );
+	SetPixelShaderValue( InDeviceContextRHI, lightGridDepthParamsParameter, InLightGrid.GetDepthParams() );
+}
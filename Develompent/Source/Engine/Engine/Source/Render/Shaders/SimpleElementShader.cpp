@@ -2,6 +2,7 @@
 #include "Render/VertexFactory/SimpleElementVertexFactory.h"
 
 IMPLEMENT_SHADER_TYPE(, CSimpleElementVertexShader, TEXT( "SimpleElementVertexShader.hlsl" ), TEXT( "MainVS" ), SF_Vertex, true );
+IMPLEMENT_SHADER_TYPE(, CSimpleElementThickLineVertexShader, TEXT( "SimpleElementVertexShader.hlsl" ), TEXT( "ThickLineMainVS" ), SF_Vertex, true );
 IMPLEMENT_SHADER_TYPE(, CSimpleElementPixelShader, TEXT( "SimpleElementPixelShader.hlsl" ), TEXT( "MainPS" ), SF_Pixel, true );
 
 #if WITH_EDITOR
@@ -16,6 +17,17 @@ bool CSimpleElementVertexShader::ShouldCache( EShaderPlatform InShaderPlatform,
 	return InVFMetaType->GetHash() == CSimpleElementVertexFactory::staticType.GetHash();
 }
 
+bool CSimpleElementThickLineVertexShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
+{
+	if ( !InVFMetaType )
+	{
+		return true;
+	}
+
+	// Shader supported only simple element vertex factory
+	return InVFMetaType->GetHash() == CSimpleElementVertexFactory::staticType.GetHash();
+}
+
 bool CSimpleElementPixelShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
 {
 	if ( !InVFMetaType )
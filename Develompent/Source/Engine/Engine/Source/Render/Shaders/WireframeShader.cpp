@@ -19,14 +19,27 @@ CWireframeVertexShader::~CWireframeVertexShader()
 
 #if WITH_EDITOR
 #include "Render/VertexFactory/LightVertexFactory.h"
+#include "Render/VertexFactory/StaticMeshVertexFactory.h"
 
 bool CWireframeVertexShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
 {
+	// Position only vertex factory is used only in depth prepass
+	if ( InVFMetaType && InVFMetaType->GetHash() == CStaticMeshDepthVertexFactory::staticType.GetHash() )
+	{
+		return false;
+	}
+
 	return GIsEditor || GIsCookEditorContent && ( !InVFMetaType || InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() );
 }
 
 bool CWireframePixelShader::ShouldCache( EShaderPlatform InShaderPlatform, class CVertexFactoryMetaType* InVFMetaType /* = nullptr */ )
 {
+	// Position only vertex factory is used only in depth prepass
+	if ( InVFMetaType && InVFMetaType->GetHash() == CStaticMeshDepthVertexFactory::staticType.GetHash() )
+	{
+		return false;
+	}
+
 	return GIsEditor || GIsCookEditorContent && ( !InVFMetaType || InVFMetaType->GetHash() != CLightVertexFactory::staticType.GetHash() );
 }
 #endif // WITH_EDITOR
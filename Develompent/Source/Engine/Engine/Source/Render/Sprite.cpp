@@ -1,6 +1,10 @@
+#include <algorithm>
+
 #include "Render/Sprite.h"
+#include "Render/RenderingThread.h"
 #include "Misc/EngineGlobals.h"
 #include "System/BaseEngine.h"
+#include "Misc/Template.h"
 
 // -------------
 // GLOBALS
@@ -33,18 +37,118 @@ void CSpriteMesh::ReleaseRHI()
 }
 
 CSprite::CSprite()
-	: vertexFactory( new CSpriteVertexFactory() )
+	: bFlipVertical( false )
+	, bFlipHorizontal( false )
+	, type( ST_Rotating )
+	, textureRect( 0.f, 0.f, 1.f, 1.f )
+	, spriteSize( 1.f, 1.f )
 	, material( GEngine->GetDefaultMaterial() )
 {}
 
-void CSprite::InitRHI()
+CSpriteBatch::CSpriteBatch( const TAssetHandle<CMaterial>& InMaterial )
+	: material( InMaterial )
+	, numBufferInstances( 0 )
+{
+	vertexFactory = new CSpriteVertexFactory( this );
+}
+
+uint32 CSpriteBatch::AllocateInstance()
+{
+	uint32		instanceId;
+	if ( !freeInstances.empty() )
+	{
+		instanceId = freeInstances.back();
+		freeInstances.pop_back();
+	}
+	else
+	{
+		instanceId = ( uint32 )instances.size();
+		instances.push_back( SSpriteInstance() );
+		dirtyFlags.push_back( false );
+	}
+
+	CollapseInstance( instanceId );
+	return instanceId;
+}
+
+void CSpriteBatch::FreeInstance( uint32 InInstanceId )
+{
+	check( InInstanceId < instances.size() );
+	CollapseInstance( InInstanceId );
+	freeInstances.push_back( InInstanceId );
+}
+
+void CSpriteBatch::UpdateInstance( uint32 InInstanceId, const SSpriteInstance& InInstance )
+{
+	check( InInstanceId < instances.size() );
+	instances[ InInstanceId ] = InInstance;
+	MarkDirty( InInstanceId );
+}
+
+void CSpriteBatch::CollapseInstance( uint32 InInstanceId )
+{
+	check( InInstanceId < instances.size() );
+
+	// Sprite with zero size is degenerate, so GPU drops it before rasterization
+	appMemzero( &instances[ InInstanceId ], sizeof( SSpriteInstance ) );
+	MarkDirty( InInstanceId );
+}
+
+void CSpriteBatch::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, uint32 InStreamIndex )
+{
+	check( IsInRenderingThread() && !instances.empty() );
+
+	// If instance buffer is small - recreate it with all instances, capacity is doubled to rarely do it
+	const uint32		numInstances = ( uint32 )instances.size();
+	if ( !instanceBufferRHI || numBufferInstances < numInstances )
+	{
+		numBufferInstances = Max<uint32>( numInstances, numBufferInstances * 2 );
+		instanceBufferRHI = GRHI->CreateVertexBuffer( TEXT( "SpriteBatch" ), numBufferInstances * sizeof( SSpriteInstance ), nullptr, RUF_Static );
+		GRHI->UpdateVertexBuffer( InDeviceContextRHI, instanceBufferRHI, 0, numInstances * sizeof( SSpriteInstance ), instances.data() );
+	}
+	// Else upload only changed instances, neighboring ones are merged into one region
+	else if ( !dirtyInstances.empty() )
+	{
+		std::sort( dirtyInstances.begin(), dirtyInstances.end() );
+		for ( uint32 index = 0, count = ( uint32 )dirtyInstances.size(); index < count; )
+		{
+			uint32		firstInstanceId = dirtyInstances[ index ];
+			uint32		lastInstanceId	= firstInstanceId;
+			for ( ++index; index < count && dirtyInstances[ index ] == lastInstanceId + 1; ++index )
+			{
+				++lastInstanceId;
+			}
+
+			GRHI->UpdateVertexBuffer( InDeviceContextRHI, instanceBufferRHI, firstInstanceId * sizeof( SSpriteInstance ), ( lastInstanceId - firstInstanceId + 1 ) * sizeof( SSpriteInstance ), &instances[ firstInstanceId ] );
+		}
+	}
+
+	for ( uint32 index = 0, count = ( uint32 )dirtyInstances.size(); index < count; ++index )
+	{
+		dirtyFlags[ dirtyInstances[ index ] ] = false;
+	}
+	dirtyInstances.clear();
+
+	GRHI->SetStreamSource( InDeviceContextRHI, InStreamIndex, instanceBufferRHI, sizeof( SSpriteInstance ), 0 );
+}
+
+void CSpriteBatch::InitRHI()
 {
 	// Initialize vertex factory
-	vertexFactory->AddVertexStream( SVertexStream{ GetVertexBufferRHI(), sizeof( SSpriteVertexType ) } );		// 0 stream slot
+	vertexFactory->AddVertexStream( SVertexStream{ GSpriteMesh.GetVertexBufferRHI(), sizeof( SSpriteVertexType ) } );		// 0 stream slot
 	vertexFactory->Init();
 }
 
-void CSprite::ReleaseRHI()
+void CSpriteBatch::ReleaseRHI()
 {
 	vertexFactory->ReleaseResource();
+	instanceBufferRHI.SafeRelease();
+	numBufferInstances = 0;
+
+	// Instance buffer will be recreated with all instances
+	for ( uint32 index = 0, count = ( uint32 )dirtyInstances.size(); index < count; ++index )
+	{
+		dirtyFlags[ dirtyInstances[ index ] ] = false;
+	}
+	dirtyInstances.clear();
 }
@@ -1,14 +1,39 @@
 #include "Containers/String.h"
 #include "Logger/LoggerMacros.h"
 #include "System/Archive.h"
+#include "System/ConCmd.h"
 #include "Render/Scene.h"
 #include "Render/StaticMesh.h"
 #include "Render/SceneUtils.h"
 #include "Render/SceneHitProxyRendering.h"
+#include "Render/RenderingThread.h"
+
+/**
+ * Command 'lod.stats', print statistics of static mesh LODs drawn in the last built view
+ */
+static void CmdLODStats( const std::vector<std::wstring>& InArguments )
+{
+	// Statistics are changed by the rendering thread, so they are printed there
+	UNIQUE_RENDER_COMMAND( CDumpLODStatsCommand,
+						   {
+							   for ( uint32 index = 0; index < STATICMESH_MAX_LODS; ++index )
+							   {
+								   LE_LOG( LT_Log, LC_Console, TEXT( "LOD %i: %u instances, %u triangles" ), index, GStaticMeshLODStats.numInstances[ index ], GStaticMeshLODStats.numPrimitives[ index ] );
+							   }
+						   } );
+}
+
+// -------------
+// GLOBALS
+// -------------
+SStaticMeshLODStats		GStaticMeshLODStats;
+CConCmd					CCmdLODStats( TEXT( "lod.stats" ), TEXT( "Print statistics of static mesh LODs drawn in the last built view" ), &CmdLODStats );
 
 CStaticMesh::CStaticMesh()
 	: CAsset( AT_StaticMesh )
 	, vertexFactory( new CStaticMeshVertexFactory() )
+	, depthVertexFactory( new CStaticMeshDepthVertexFactory() )
+	, lods( 1 )
 {}
 
 CStaticMesh::~CStaticMesh()
@@ -22,6 +47,7 @@ CStaticMesh::~CStaticMesh()
 		for ( uint32 index = 0, count = itElement->second->drawingPolicyLinks.size(); index < count; ++index )
 		{
 			itElement->first.SDG->staticMeshDrawList.RemoveItem( itElement->second->drawingPolicyLinks[ index ] );
+			itElement->first.SDG->depthDrawList.RemoveItem( itElement->second->depthDrawingPolicyLinks[ index ] );
 			
 #if ENABLE_HITPROXY
 			itElement->first.SDG->hitProxyLayers[ HPL_World ].hitProxyDrawList.RemoveItem( itElement->second->hitProxyDrawingPolicyLinks[ index ] );
@@ -41,6 +67,18 @@ void CStaticMesh::InitRHI()
 		// Initialize vertex factory
 		vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, sizeof( SStaticMeshVertexType ) } );		// 0 stream slot
 		vertexFactory->Init();
+
+		// Create vertex buffer of positions for depth prepass
+		std::vector<Vector4D>		positions( numVerteces );
+		const SStaticMeshVertexType*	vertexData = verteces.GetData();
+		for ( uint32 index = 0; index < numVerteces; ++index )
+		{
+			positions[ index ] = vertexData[ index ].position;
+		}
+
+		depthVertexBufferRHI = GRHI->CreateVertexBuffer( CString::Format( TEXT( "%s_Depth" ), GetAssetName().c_str() ).c_str(), sizeof( Vector4D ) * numVerteces, ( byte* )positions.data(), RUF_Static );
+		depthVertexFactory->AddVertexStream( SVertexStream{ depthVertexBufferRHI, sizeof( Vector4D ) } );		// 0 stream slot
+		depthVertexFactory->Init();
 	}
 
 	// Create index buffer
@@ -50,6 +88,45 @@ void CStaticMesh::InitRHI()
 		indexBufferRHI = GRHI->CreateIndexBuffer( CString::Format( TEXT( "%s" ), GetAssetName().c_str() ).c_str(), sizeof( uint32 ), sizeof( uint32 ) * numIndeces, ( byte* )indeces.GetData(), RUF_Static );
 	}
 
+	// Keep copy of geometry on CPU for occlusion culling, only for low poly meshes.
+	// It's taken from the most detailed LOD which fits in budget of triangles
+	const SOcclusionCullingSettings&	occlusionSettings = GOcclusionBuffer.GetSettings();
+	const SStaticMeshLOD*				occluderLOD = nullptr;
+	occluderVerteces.clear();
+	occluderIndeces.clear();
+	if ( occlusionSettings.bEnable && numVerteces > 0 && numIndeces > 0 )
+	{
+		for ( uint32 lodIndex = 0, numLODs = lods.size(); lodIndex < numLODs && !occluderLOD; ++lodIndex )
+		{
+			if ( lods[ lodIndex ].GetNumPrimitives() <= occlusionSettings.maxMeshTriangles )
+			{
+				occluderLOD = &lods[ lodIndex ];
+			}
+		}
+	}
+
+	if ( occluderLOD )
+	{
+		// Copy only verteces used by the LOD and remap indeces to them
+		const SStaticMeshVertexType*	vertexData = verteces.GetData();
+		const uint32*					indexData = indeces.GetData();
+		std::vector<uint32>				vertexRemap( numVerteces, INDEX_NONE );
+		for ( uint32 surfaceIndex = 0, numSurfaces = occluderLOD->surfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+		{
+			const SStaticMeshSurface&		surface = occluderLOD->surfaces[ surfaceIndex ];
+			for ( uint32 index = 0, count = surface.numPrimitives * 3; index < count; ++index )
+			{
+				uint32		vertexIndex = surface.baseVertexIndex + indexData[ surface.firstIndex + index ];
+				if ( vertexRemap[ vertexIndex ] == INDEX_NONE )
+				{
+					vertexRemap[ vertexIndex ] = occluderVerteces.size();
+					occluderVerteces.push_back( vertexData[ vertexIndex ].position );
+				}
+				occluderIndeces.push_back( vertexRemap[ vertexIndex ] );
+			}
+		}
+	}
+
 	if ( !GIsEditor && !GIsCommandlet )
 	{
 		verteces.RemoveAllElements();
@@ -60,8 +137,12 @@ void CStaticMesh::InitRHI()
 void CStaticMesh::ReleaseRHI()
 {
 	vertexBufferRHI.SafeRelease();
+	depthVertexBufferRHI.SafeRelease();
 	indexBufferRHI.SafeRelease();
 	vertexFactory->ReleaseResource();
+	depthVertexFactory->ReleaseResource();
+	occluderVerteces.clear();
+	occluderIndeces.clear();
 }
 
 void CStaticMesh::Serialize( class CArchive& InArchive )
@@ -90,7 +171,23 @@ void CStaticMesh::Serialize( class CArchive& InArchive )
 		InArchive << indeces;
 	}
 
-	InArchive << surfaces;
+	if ( InArchive.Ver() < VER_StaticMeshLODs )
+	{
+		lods.resize( 1 );
+		lods[ 0 ] = SStaticMeshLOD();
+		InArchive << lods[ 0 ].surfaces;
+	}
+	else
+	{
+		InArchive << lods;
+
+		// Number of LODs from broken package can be out of range, components index arrays of STATICMESH_MAX_LODS elements by it
+		if ( InArchive.IsLoading() && ( lods.empty() || lods.size() > STATICMESH_MAX_LODS ) )
+		{
+			LE_LOG( LT_Warning, LC_Package, TEXT( "Static mesh '%s' has %i LODs, it must be from 1 to %i" ), GetAssetName().c_str(), ( uint32 )lods.size(), STATICMESH_MAX_LODS );
+			lods.resize( Clamp<uint32>( lods.size(), 1, STATICMESH_MAX_LODS ) );
+		}
+	}
 	InArchive << materials;
 
 	if ( InArchive.IsLoading() )
@@ -103,10 +200,19 @@ void CStaticMesh::Serialize( class CArchive& InArchive )
 
 void CStaticMesh::SetData( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, const std::vector< TAssetHandle<CMaterial> >& InMaterials )
 {
+	std::vector<SStaticMeshLOD>		newLODs( 1 );
+	newLODs[ 0 ].surfaces = InSurfaces;
+	SetData( InVerteces, InIndeces, newLODs, InMaterials );
+}
+
+void CStaticMesh::SetData( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<SStaticMeshLOD>& InLODs, const std::vector< TAssetHandle<CMaterial> >& InMaterials )
+{
+	check( !InLODs.empty() && InLODs.size() <= STATICMESH_MAX_LODS );
+
 	// Copy new parameters of static mesh
 	verteces		= InVerteces;
 	indeces			= InIndeces;
-	surfaces		= InSurfaces;
+	lods			= InLODs;
 	materials		= InMaterials;
 
 	// Mark dirty all drawing policy links
@@ -246,42 +352,55 @@ TSharedPtr<CStaticMesh::SElementDrawingPolicyLink> CStaticMesh::MakeDrawingPolic
 	uint32									numOverrideMaterials	= InOverrideMaterials ? InOverrideMaterials->size() : 0;
 	element->overrideHash = InOverrideHash;
 
-	// Generate mesh batch for surface and add to new scene draw policy link
-	for ( uint32 indexSurface = 0, numSurfaces = ( uint32 )surfaces.size(); indexSurface < numSurfaces; ++indexSurface )
+	// Mesh batch links of all LODs are stored one after another
+	for ( uint32 indexLOD = 0, numLODs = ( uint32 )lods.size(); indexLOD < numLODs; ++indexLOD )
 	{
-		const SStaticMeshSurface&		surface				= surfaces[ indexSurface ];
-		TAssetHandle<CMaterial>			material			= materials[ surface.materialID ];
+		const SStaticMeshLOD&			lod					= lods[ indexLOD ];
+		element->lods.push_back( SElementDrawingPolicyLink::SLOD{ ( uint32 )element->meshBatchLinks.size(), ( uint32 )element->depthMeshBatchLinks.size(), lod.GetNumPrimitives(), lod.screenSize } );
 
-		// If current material is override - use custom material
-		if ( indexSurface < numOverrideMaterials )
+		// Generate mesh batch for surface and add to new scene draw policy link
+		for ( uint32 indexSurface = 0, numSurfaces = ( uint32 )lod.surfaces.size(); indexSurface < numSurfaces; ++indexSurface )
 		{
-			TAssetHandle<CMaterial>			overrideMaterial = InOverrideMaterials->at( surface.materialID );
-			if ( overrideMaterial.IsValid() )
+			const SStaticMeshSurface&		surface				= lod.surfaces[ indexSurface ];
+			TAssetHandle<CMaterial>			material			= materials[ surface.materialID ];
+
+			// If current material is override - use custom material
+			if ( indexSurface < numOverrideMaterials )
 			{
-				material = overrideMaterial;
+				TAssetHandle<CMaterial>			overrideMaterial = InOverrideMaterials->at( surface.materialID );
+				if ( overrideMaterial.IsValid() )
+				{
+					material = overrideMaterial;
+				}
 			}
-		}
 
-		// Generate mesh batch of surface
-		SMeshBatch					meshBatch;
-		meshBatch.baseVertexIndex	= surface.baseVertexIndex;
-		meshBatch.firstIndex		= surface.firstIndex;
-		meshBatch.numPrimitives		= surface.numPrimitives;
-		meshBatch.indexBufferRHI	= indexBufferRHI;
-		meshBatch.primitiveType		= PT_TriangleList;
-
-		// Make and add to scene new static mesh drawing policy link
-		const SMeshBatch*					meshBatchLink				= nullptr;
-		DrawingPolicyLinkRef_t				drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.staticMeshDrawList, DEC_STATIC_MESH );
-		element->drawingPolicyLinks.push_back( drawingPolicyLink );
-		element->meshBatchLinks.push_back( meshBatchLink );
-
-		// Make and add to scene new hit proxy drawing policy link
+			// Generate mesh batch of surface
+			SMeshBatch					meshBatch;
+			meshBatch.baseVertexIndex	= surface.baseVertexIndex;
+			meshBatch.firstIndex		= surface.firstIndex;
+			meshBatch.numPrimitives		= surface.numPrimitives;
+			meshBatch.indexBufferRHI	= indexBufferRHI;
+			meshBatch.primitiveType		= PT_TriangleList;
+
+			// Make and add to scene new static mesh drawing policy link
+			const SMeshBatch*					meshBatchLink				= nullptr;
+			DrawingPolicyLinkRef_t				drawingPolicyLink			= ::MakeDrawingPolicyLink<DrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.staticMeshDrawList, DEC_STATIC_MESH );
+			element->drawingPolicyLinks.push_back( drawingPolicyLink );
+			element->meshBatchLinks.push_back( meshBatchLink );
+
+			// Make and add to scene new depth only drawing policy link, instances are added to it only for occluders
+			const SMeshBatch*					depthMeshBatchLink			= nullptr;
+			DepthDrawingPolicyLinkRef_t			depthDrawingPolicyLink		= ::MakeDrawingPolicyLink<DepthDrawingPolicyLink_t>( depthVertexFactory, material, meshBatch, depthMeshBatchLink, InSDG.depthDrawList );
+			element->depthDrawingPolicyLinks.push_back( depthDrawingPolicyLink );
+			element->depthMeshBatchLinks.push_back( depthMeshBatchLink );
+
+			// Make and add to scene new hit proxy drawing policy link
 #if ENABLE_HITPROXY
-		HitProxyDrawingPolicyLinkRef_t		hitProxyDrawingPolicyLink	= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_STATIC_MESH );
-		element->hitProxyDrawingPolicyLinks.push_back( hitProxyDrawingPolicyLink );
-		element->meshBatchLinks.push_back( meshBatchLink );
+			HitProxyDrawingPolicyLinkRef_t		hitProxyDrawingPolicyLink	= ::MakeDrawingPolicyLink<HitProxyDrawingPolicyLink_t>( vertexFactory, material, meshBatch, meshBatchLink, InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList, DEC_STATIC_MESH );
+			element->hitProxyDrawingPolicyLinks.push_back( hitProxyDrawingPolicyLink );
+			element->meshBatchLinks.push_back( meshBatchLink );
 #endif // ENABLE_HITPROXY
+		}
 	}
 
 	return element;
@@ -313,6 +432,7 @@ void CStaticMesh::UnlinkDrawList( SSceneDepthGroup& InSDG, TSharedPtr<SElementDr
 	for ( uint32 index = 0, count = itElement->second->drawingPolicyLinks.size(); index < count; ++index )
 	{
 		InSDG.staticMeshDrawList.RemoveItem( itElement->second->drawingPolicyLinks[ index ] );
+		InSDG.depthDrawList.RemoveItem( itElement->second->depthDrawingPolicyLinks[ index ] );
 
 #if ENABLE_HITPROXY
 		InSDG.hitProxyLayers[ HPL_World ].hitProxyDrawList.RemoveItem( itElement->second->hitProxyDrawingPolicyLinks[ index ] );
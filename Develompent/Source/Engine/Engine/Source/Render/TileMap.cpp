@@ -0,0 +1,323 @@
+#include <memory.h>
+
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Misc/Template.h"
+#include "RHI/BaseRHI.h"
+#include "Render/TileMap.h"
+
+/**
+ * Serialize array of plain values by one call
+ *
+ * @param InArchive		Archive
+ * @param InArray		Array
+ */
+template<typename TType>
+static FORCEINLINE void SerializeRawArray( CArchive& InArchive, std::vector<TType>& InArray )
+{
+	uint32		numElements = ( uint32 )InArray.size();
+	InArchive << numElements;
+	if ( InArchive.IsLoading() )
+	{
+		InArray.resize( numElements );
+	}
+
+	if ( numElements > 0 )
+	{
+		InArchive.Serialize( InArray.data(), numElements * sizeof( TType ) );
+	}
+}
+
+CTileMap::CTileMap()
+	: numTilesX( 0 )
+	, numTilesY( 0 )
+	, tileSize( 0.f, 0.f )
+	, vertexFactory( new CStaticMeshVertexFactory() )
+{}
+
+void CTileMap::InitRHI()
+{
+	// Create vertex buffer
+	uint32			numVerteces = ( uint32 )verteces.size();
+	if ( numVerteces > 0 )
+	{
+		vertexBufferRHI = GRHI->CreateVertexBuffer( TEXT( "TileMap" ), sizeof( SStaticMeshVertexType ) * numVerteces, ( byte* )verteces.data(), RUF_Static );
+
+		// Initialize vertex factory
+		vertexFactory->AddVertexStream( SVertexStream{ vertexBufferRHI, sizeof( SStaticMeshVertexType ) } );		// 0 stream slot
+		vertexFactory->Init();
+	}
+
+	// Create index buffer
+	uint32			numIndeces = ( uint32 )indeces.size();
+	if ( numIndeces > 0 )
+	{
+		indexBufferRHI = GRHI->CreateIndexBuffer( TEXT( "TileMap" ), sizeof( uint32 ), sizeof( uint32 ) * numIndeces, ( byte* )indeces.data(), RUF_Static );
+	}
+
+	// In game layers are kept for collision, mesh data isn't needed after upload
+	if ( !GIsEditor && !GIsCommandlet )
+	{
+		std::vector<SStaticMeshVertexType>().swap( verteces );
+		std::vector<uint32>().swap( indeces );
+	}
+}
+
+void CTileMap::ReleaseRHI()
+{
+	vertexBufferRHI.SafeRelease();
+	indexBufferRHI.SafeRelease();
+	vertexFactory->ReleaseResource();
+}
+
+void CTileMap::Serialize( class CArchive& InArchive )
+{
+	InArchive << numTilesX;
+	InArchive << numTilesY;
+	InArchive << tileSize;
+
+	uint32		numTilesets = ( uint32 )tilesets.size();
+	InArchive << numTilesets;
+	if ( InArchive.IsLoading() )
+	{
+		tilesets.resize( numTilesets );
+	}
+
+	for ( uint32 index = 0; index < numTilesets; ++index )
+	{
+		STileMapTileset&	tileset = tilesets[ index ];
+		InArchive << tileset.firstTileId;
+		InArchive << tileset.tileSize;
+		InArchive << tileset.material;
+		SerializeRawArray( InArchive, tileset.textureRects );
+	}
+
+	uint32		numLayers = ( uint32 )layers.size();
+	InArchive << numLayers;
+	if ( InArchive.IsLoading() )
+	{
+		layers.resize( numLayers );
+	}
+
+	// Tiles are plain IDs, so they are serialized by one call per layer
+	for ( uint32 index = 0; index < numLayers; ++index )
+	{
+		STileMapLayer&		layer = layers[ index ];
+		InArchive << layer.depth;
+		SerializeRawArray( InArchive, layer.tiles );
+	}
+	SerializeRawArray( InArchive, collision );
+
+	if ( InArchive.IsLoading() )
+	{
+		BuildChunks();
+		BeginUpdateResource( this );
+	}
+}
+
+void CTileMap::SetData( uint32 InNumTilesX, uint32 InNumTilesY, const Vector2D& InTileSize, const std::vector<STileMapTileset>& InTilesets, const std::vector<STileMapLayer>& InLayers, const std::vector<byte>& InCollision )
+{
+	numTilesX	= InNumTilesX;
+	numTilesY	= InNumTilesY;
+	tileSize	= InTileSize;
+	tilesets	= InTilesets;
+	layers		= InLayers;
+	collision	= InCollision;
+
+	// Collision without solid tiles isn't stored
+	bool	bHasSolidTiles = false;
+	for ( uint32 index = 0, count = ( uint32 )collision.size(); index < count && !bHasSolidTiles; ++index )
+	{
+		bHasSolidTiles = collision[ index ] != 0;
+	}
+
+	if ( !bHasSolidTiles )
+	{
+		collision.clear();
+	}
+
+	BuildChunks();
+	BeginUpdateResource( this );
+}
+
+uint32 CTileMap::FindTileset( uint32 InTileId ) const
+{
+	for ( uint32 index = 0, count = ( uint32 )tilesets.size(); index < count; ++index )
+	{
+		const STileMapTileset&		tileset = tilesets[ index ];
+		if ( InTileId >= tileset.firstTileId && InTileId - tileset.firstTileId < tileset.textureRects.size() )
+		{
+			return index;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+void CTileMap::BuildChunks()
+{
+	chunks.clear();
+	verteces.clear();
+	indeces.clear();
+	bounds = CBox();
+
+	uint32		numChunksX = ( numTilesX + TILEMAP_CHUNK_SIZE - 1 ) / TILEMAP_CHUNK_SIZE;
+	uint32		numChunksY = ( numTilesY + TILEMAP_CHUNK_SIZE - 1 ) / TILEMAP_CHUNK_SIZE;
+	Vector		tilemapMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector		tilemapMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+
+	// Indeces of chunk are collected per tileset, after that they are written one after the other for each surface
+	std::vector<std::vector<uint32>>		tilesetIndeces( tilesets.size() );
+	for ( uint32 chunkY = 0; chunkY < numChunksY; ++chunkY )
+	{
+		for ( uint32 chunkX = 0; chunkX < numChunksX; ++chunkX )
+		{
+			Vector		chunkMin( FLT_MAX, FLT_MAX, FLT_MAX );
+			Vector		chunkMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+			uint32		endX = Min<uint32>( ( chunkX + 1 ) * TILEMAP_CHUNK_SIZE, numTilesX );
+			uint32		endY = Min<uint32>( ( chunkY + 1 ) * TILEMAP_CHUNK_SIZE, numTilesY );
+			for ( uint32 layerIndex = 0, numLayers = ( uint32 )layers.size(); layerIndex < numLayers; ++layerIndex )
+			{
+				const STileMapLayer&	layer = layers[ layerIndex ];
+				for ( uint32 y = chunkY * TILEMAP_CHUNK_SIZE; y < endY; ++y )
+				{
+					for ( uint32 x = chunkX * TILEMAP_CHUNK_SIZE; x < endX; ++x )
+					{
+						uint32		tileId = layer.tiles[ y * numTilesX + x ];
+						uint32		tilesetIndex = tileId != 0 ? FindTileset( tileId ) : INDEX_NONE;
+						if ( tilesetIndex == INDEX_NONE )
+						{
+							continue;
+						}
+
+						// Quad of tile, texture coords like in sprite mesh
+						const STileMapTileset&	tileset		= tilesets[ tilesetIndex ];
+						const RectFloat_t&		textureRect = tileset.textureRects[ tileId - tileset.firstTileId ];
+						Vector					tileMin( x * tileSize.x, y * tileSize.y, layer.depth );
+						Vector					tileMax( tileMin.x + tileset.tileSize.x, tileMin.y + tileset.tileSize.y, layer.depth );
+						uint32					baseVertex	= ( uint32 )verteces.size();
+
+						SStaticMeshVertexType	vertex;
+						vertex.normal	= Vector4D( 0.f, 0.f, 1.f, 0.f );
+						vertex.tangent	= Vector4D( 1.f, 0.f, 0.f, 0.f );
+						vertex.binormal	= Vector4D( 0.f, 1.f, 0.f, 0.f );
+
+						vertex.position = Vector4D( tileMin.x, tileMin.y, layer.depth, 1.f );
+						vertex.texCoord = Vector2D( textureRect.left, textureRect.top + textureRect.height );
+						verteces.push_back( vertex );
+
+						vertex.position = Vector4D( tileMin.x, tileMax.y, layer.depth, 1.f );
+						vertex.texCoord = Vector2D( textureRect.left, textureRect.top );
+						verteces.push_back( vertex );
+
+						vertex.position = Vector4D( tileMax.x, tileMax.y, layer.depth, 1.f );
+						vertex.texCoord = Vector2D( textureRect.left + textureRect.width, textureRect.top );
+						verteces.push_back( vertex );
+
+						vertex.position = Vector4D( tileMax.x, tileMin.y, layer.depth, 1.f );
+						vertex.texCoord = Vector2D( textureRect.left + textureRect.width, textureRect.top + textureRect.height );
+						verteces.push_back( vertex );
+
+						std::vector<uint32>&	quadIndeces = tilesetIndeces[ tilesetIndex ];
+						quadIndeces.push_back( baseVertex );
+						quadIndeces.push_back( baseVertex + 1 );
+						quadIndeces.push_back( baseVertex + 2 );
+						quadIndeces.push_back( baseVertex );
+						quadIndeces.push_back( baseVertex + 2 );
+						quadIndeces.push_back( baseVertex + 3 );
+
+						chunkMin = Vector( Min( chunkMin.x, tileMin.x ), Min( chunkMin.y, tileMin.y ), Min( chunkMin.z, tileMin.z ) );
+						chunkMax = Vector( Max( chunkMax.x, tileMax.x ), Max( chunkMax.y, tileMax.y ), Max( chunkMax.z, tileMax.z ) );
+					}
+				}
+			}
+
+			// Empty chunks aren't stored
+			STileMapChunk		chunk;
+			for ( uint32 tilesetIndex = 0, numTilesets = ( uint32 )tilesets.size(); tilesetIndex < numTilesets; ++tilesetIndex )
+			{
+				std::vector<uint32>&	surfaceIndeces = tilesetIndeces[ tilesetIndex ];
+				if ( surfaceIndeces.empty() )
+				{
+					continue;
+				}
+
+				chunk.surfaces.push_back( STileMapSurface{ tilesetIndex, ( uint32 )indeces.size(), ( uint32 )surfaceIndeces.size() / 3 } );
+				indeces.insert( indeces.end(), surfaceIndeces.begin(), surfaceIndeces.end() );
+				surfaceIndeces.clear();
+			}
+
+			if ( !chunk.surfaces.empty() )
+			{
+				// Tiles are flat, so bound box has small depth for frustum test
+				chunkMax.z		+= 1.f;
+				chunk.bounds	= CBox( chunkMin, chunkMax );
+				chunks.push_back( chunk );
+
+				tilemapMin		= Vector( Min( tilemapMin.x, chunkMin.x ), Min( tilemapMin.y, chunkMin.y ), Min( tilemapMin.z, chunkMin.z ) );
+				tilemapMax		= Vector( Max( tilemapMax.x, chunkMax.x ), Max( tilemapMax.y, chunkMax.y ), Max( tilemapMax.z, chunkMax.z ) );
+			}
+		}
+	}
+
+	if ( !chunks.empty() )
+	{
+		bounds = CBox( tilemapMin, tilemapMax );
+	}
+}
+
+void CTileMap::BuildCollisionRects( std::vector<RectFloat_t>& OutRects ) const
+{
+	if ( collision.empty() )
+	{
+		return;
+	}
+
+	// Greedy merge: take free solid tile, grow rect by X as far as possible, after that grow it by Y while whole row is solid
+	std::vector<byte>		merged( collision.size(), 0 );
+	for ( uint32 y = 0; y < numTilesY; ++y )
+	{
+		for ( uint32 x = 0; x < numTilesX; ++x )
+		{
+			uint32		tileIndex = y * numTilesX + x;
+			if ( !collision[ tileIndex ] || merged[ tileIndex ] )
+			{
+				continue;
+			}
+
+			uint32		width = 1;
+			while ( x + width < numTilesX && collision[ tileIndex + width ] && !merged[ tileIndex + width ] )
+			{
+				++width;
+			}
+
+			uint32		height = 1;
+			for ( ; y + height < numTilesY; ++height )
+			{
+				bool		bSolidRow = true;
+				uint32		rowIndex = ( y + height ) * numTilesX + x;
+				for ( uint32 offset = 0; offset < width && bSolidRow; ++offset )
+				{
+					bSolidRow = collision[ rowIndex + offset ] && !merged[ rowIndex + offset ];
+				}
+
+				if ( !bSolidRow )
+				{
+					break;
+				}
+			}
+
+			for ( uint32 rowY = y; rowY < y + height; ++rowY )
+			{
+				memset( merged.data() + rowY * numTilesX + x, 1, width );
+			}
+
+			RectFloat_t		rect;
+			rect.left		= x * tileSize.x;
+			rect.top		= y * tileSize.y;
+			rect.width		= width * tileSize.x;
+			rect.height		= height * tileSize.y;
+			OutRects.push_back( rect );
+		}
+	}
+}
@@ -64,6 +64,60 @@ template<>
 struct TLightInstanceBuffer<LT_Directional> : public SBaseLightInstanceBuffer
 {};
 
+/**
+ * @ingroup Engine
+ * @brief Fill base part of light instance buffer
+ *
+ * @param OutInstanceBuffer		Instance buffer
+ * @param InLightProxy			Light proxy
+ */
+static FORCEINLINE void FillBaseLightInstanceBuffer( SBaseLightInstanceBuffer& OutInstanceBuffer, const CLightSceneProxy* InLightProxy )
+{
+	OutInstanceBuffer.lightColor	= InLightProxy->GetLightColor();
+	OutInstanceBuffer.specularColor	= InLightProxy->GetSpecularColor();
+	OutInstanceBuffer.intensivity	= InLightProxy->GetIntensivity();
+}
+
+/**
+ * @ingroup Engine
+ * @brief Fill instance buffer of point light
+ *
+ * @param OutInstanceBuffer		Instance buffer
+ * @param InLightProxy			Light proxy
+ */
+static FORCEINLINE void FillLightInstanceBuffer( TLightInstanceBuffer<LT_Point>& OutInstanceBuffer, const CLightSceneProxy* InLightProxy )
+{
+	FillBaseLightInstanceBuffer( OutInstanceBuffer, InLightProxy );
+	OutInstanceBuffer.instanceLocalToWorld	= InLightProxy->GetLocalToWorld();
+	OutInstanceBuffer.position				= InLightProxy->GetPosition();
+	OutInstanceBuffer.radius				= InLightProxy->GetRadius();
+}
+
+/**
+ * @ingroup Engine
+ * @brief Fill instance buffer of spot light
+ *
+ * @param OutInstanceBuffer		Instance buffer
+ * @param InLightProxy			Light proxy
+ */
+static FORCEINLINE void FillLightInstanceBuffer( TLightInstanceBuffer<LT_Spot>& OutInstanceBuffer, const CLightSceneProxy* InLightProxy )
+{
+	FillBaseLightInstanceBuffer( OutInstanceBuffer, InLightProxy );
+	OutInstanceBuffer.instanceLocalToWorld	= InLightProxy->GetLocalToWorld();
+}
+
+/**
+ * @ingroup Engine
+ * @brief Fill instance buffer of directional light
+ *
+ * @param OutInstanceBuffer		Instance buffer
+ * @param InLightProxy			Light proxy
+ */
+static FORCEINLINE void FillLightInstanceBuffer( TLightInstanceBuffer<LT_Directional>& OutInstanceBuffer, const CLightSceneProxy* InLightProxy )
+{
+	FillBaseLightInstanceBuffer( OutInstanceBuffer, InLightProxy );
+}
+
 void CLightVertexDeclaration::InitRHI()
 {
 	// Init vertex declaration for point light
@@ -139,33 +193,7 @@ void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDevic
 	appErrorf( TEXT( "CLightVertexShaderParameters::SetMesh( MeshBatch ) Not supported" ) );
 }
 
-void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CPointLightComponent>>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
-{
-	if ( !bSupportsInstancing )
-	{
-		appErrorf( TEXT( "Not implemented, need add it in future" ) );
-	}
-	else
-	{
-		check( InVertexFactory );
-		InVertexFactory->SetupInstancing( InDeviceContextRHI, InLights, InView, InNumInstances, InStartInstanceID );
-	}
-}
-
-void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CSpotLightComponent>>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
-{
-	if ( !bSupportsInstancing )
-	{
-		appErrorf( TEXT( "Not implemented, need add it in future" ) );
-	}
-	else
-	{
-		check( InVertexFactory );
-		InVertexFactory->SetupInstancing( InDeviceContextRHI, InLights, InView, InNumInstances, InStartInstanceID );
-	}
-}
-
-void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CDirectionalLightComponent>>& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexShaderParameters::SetMesh( class CBaseDeviceContextRHI* InDeviceContextRHI, const LightSceneProxyList_t& InLights, const class CLightVertexFactory* InVertexFactory, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
 	if ( !bSupportsInstancing )
 	{
@@ -193,71 +221,43 @@ void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDevice
 	appErrorf( TEXT( "CLightVertexFactory::SetupInstancing( SMeshBatch ) :: Not supported" ) );
 }
 
-void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CPointLightComponent>>& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
-{
-	check( lightType == LT_Point );
-	check( InStartInstanceID < InLights.size() && InNumInstances <= InLights.size() - InStartInstanceID );
-
-	std::vector<TLightInstanceBuffer<LT_Point>>		instanceBuffers;
-	instanceBuffers.resize( InNumInstances );
-	
-	uint32		index = 0;
-	for ( auto it = std::next( InLights.begin(), InStartInstanceID ), itEnd = InLights.end(); it != itEnd && index < InNumInstances; ++it, ++index )
-	{
-		TLightInstanceBuffer<LT_Point>&		instanceBuffer		= instanceBuffers[index];
-		TRefCountPtr<CPointLightComponent>	pointLightComponent = *it;
-		instanceBuffer.instanceLocalToWorld						= pointLightComponent->GetComponentTransform().ToMatrix();
-		instanceBuffer.lightColor								= pointLightComponent->GetLightColor();
-		instanceBuffer.specularColor							= pointLightComponent->GetSpecularColor();
-		instanceBuffer.intensivity								= pointLightComponent->GetIntensivity();
-		instanceBuffer.position									= pointLightComponent->GetComponentLocation();
-		instanceBuffer.radius									= pointLightComponent->GetRadius();
-	}
-
-	GRHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<LT_Point> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Point> ), InNumInstances );
-}
-
-void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CSpotLightComponent>>& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+/**
+ * @ingroup Engine
+ * @brief Fill instance buffers of lights and setup instancing
+ *
+ * @param InDeviceContextRHI	RHI device context
+ * @param InLights				List of light proxies
+ * @param InNumInstances		Number instances
+ * @param InStartInstanceID		ID of first instance
+ */
+template<ELightType InLightType>
+static void SetupLightInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const LightSceneProxyList_t& InLights, uint32 InNumInstances, uint32 InStartInstanceID )
 {
-	check( lightType == LT_Spot );
-	check( InStartInstanceID < InLights.size() && InNumInstances <= InLights.size() - InStartInstanceID );
-
-	std::vector<TLightInstanceBuffer<LT_Spot>>		instanceBuffers;
+	std::vector<TLightInstanceBuffer<InLightType>>		instanceBuffers;
 	instanceBuffers.resize( InNumInstances );
 
-	uint32		index = 0;
-	for ( auto it = std::next( InLights.begin(), InStartInstanceID ), itEnd = InLights.end(); it != itEnd && index < InNumInstances; ++it, ++index )
+	for ( uint32 index = 0; index < InNumInstances; ++index )
 	{
-		TLightInstanceBuffer<LT_Spot>&			instanceBuffer		= instanceBuffers[index];
-		TRefCountPtr<CSpotLightComponent>		spotLightComponent	= *it;
-		instanceBuffer.instanceLocalToWorld							= spotLightComponent->GetComponentTransform().ToMatrix();
-		instanceBuffer.lightColor									= spotLightComponent->GetLightColor();
-		instanceBuffer.specularColor								= spotLightComponent->GetSpecularColor();
-		instanceBuffer.intensivity									= spotLightComponent->GetIntensivity();
+		const CLightSceneProxy*		lightProxy = InLights[ InStartInstanceID + index ];
+		check( lightProxy->GetLightType() == InLightType );
+		FillLightInstanceBuffer( instanceBuffers[ index ], lightProxy );
 	}
 
-	GRHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<LT_Spot> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Spot> ), InNumInstances );
+	GRHI->SetupInstancing( InDeviceContextRHI, CLightVertexFactory::SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<InLightType> ), InNumInstances * sizeof( TLightInstanceBuffer<InLightType> ), InNumInstances );
 }
 
-void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const std::list<TRefCountPtr<CDirectionalLightComponent>>& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
+void CLightVertexFactory::SetupInstancing( class CBaseDeviceContextRHI* InDeviceContextRHI, const LightSceneProxyList_t& InLights, const class CSceneView* InView, uint32 InNumInstances /* = 1 */, uint32 InStartInstanceID /* = 0 */ ) const
 {
-	check( lightType == LT_Directional );
 	check( InStartInstanceID < InLights.size() && InNumInstances <= InLights.size() - InStartInstanceID );
-
-	std::vector<TLightInstanceBuffer<LT_Directional>>		instanceBuffers;
-	instanceBuffers.resize( InNumInstances );
-
-	uint32		index = 0;
-	for ( auto it = std::next( InLights.begin(), InStartInstanceID ), itEnd = InLights.end(); it != itEnd && index < InNumInstances; ++it, ++index )
+	switch ( lightType )
 	{
-		TLightInstanceBuffer<LT_Directional>&			instanceBuffer				= instanceBuffers[index];
-		TRefCountPtr<CDirectionalLightComponent>		directionalLightComponent	= *it;
-		instanceBuffer.lightColor													= directionalLightComponent->GetLightColor();
-		instanceBuffer.specularColor												= directionalLightComponent->GetSpecularColor();
-		instanceBuffer.intensivity													= directionalLightComponent->GetIntensivity();
+	case LT_Point:			SetupLightInstancing<LT_Point>( InDeviceContextRHI, InLights, InNumInstances, InStartInstanceID );			break;
+	case LT_Spot:			SetupLightInstancing<LT_Spot>( InDeviceContextRHI, InLights, InNumInstances, InStartInstanceID );			break;
+	case LT_Directional:	SetupLightInstancing<LT_Directional>( InDeviceContextRHI, InLights, InNumInstances, InStartInstanceID );	break;
+	default:
+		appErrorf( TEXT( "Unknown light type 0x%X" ), lightType );
+		break;
 	}
-
-	GRHI->SetupInstancing( InDeviceContextRHI, SSS_Instance, instanceBuffers.data(), sizeof( TLightInstanceBuffer<LT_Directional> ), InNumInstances * sizeof( TLightInstanceBuffer<LT_Directional> ), InNumInstances );
 }
 
 uint64 CLightVertexFactory::GetTypeHash() const
@@ -8,6 +8,7 @@ IMPLEMENT_VERTEX_FACTORY_TYPE( CSimpleElementVertexFactory, TEXT( "SimpleElement
 // GLOBALS
 //
 TGlobalResource< CSimpleElementVertexDeclaration >			GSimpleElementVertexDeclaration;
+TGlobalResource< CSimpleElementThickLineDeclaration >		GSimpleElementThickLineDeclaration;
 
 void CSimpleElementVertexDeclaration::InitRHI()
 {
@@ -25,6 +26,23 @@ void CSimpleElementVertexDeclaration::ReleaseRHI()
 	vertexDeclarationRHI.SafeRelease();
 }
 
+void CSimpleElementThickLineDeclaration::InitRHI()
+{
+	// All data is per instance, corners of quad are calculated from vertex id
+	VertexDeclarationElementList_t		vertexDeclElementList =
+	{
+		SVertexElement( CSimpleElementVertexFactory::SSS_Main,		sizeof( SSimpleElementThickLineType ),	STRUCT_OFFSET( SSimpleElementThickLineType, start ),	VET_Float4, VEU_Position,			0, true ),
+		SVertexElement( CSimpleElementVertexFactory::SSS_Main,		sizeof( SSimpleElementThickLineType ),	STRUCT_OFFSET( SSimpleElementThickLineType, end ),		VET_Float4, VEU_Position,			1, true ),
+		SVertexElement( CSimpleElementVertexFactory::SSS_Main,		sizeof( SSimpleElementThickLineType ),	STRUCT_OFFSET( SSimpleElementThickLineType, color ),	VET_Color,	VEU_Color,				0, true )
+	};
+	vertexDeclarationRHI = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+}
+
+void CSimpleElementThickLineDeclaration::ReleaseRHI()
+{
+	vertexDeclarationRHI.SafeRelease();
+}
+
 uint64 CSimpleElementVertexFactory::GetTypeHash() const
 {
 	return staticType.GetHash();
@@ -3,11 +3,13 @@
 #include "Render/VertexFactory/GeneralVertexFactoryParams.h"
 
 IMPLEMENT_VERTEX_FACTORY_TYPE( CStaticMeshVertexFactory, TEXT( "StaticMeshVertexFactory.hlsl" ), false, 0 )
+IMPLEMENT_VERTEX_FACTORY_TYPE( CStaticMeshDepthVertexFactory, TEXT( "StaticMeshDepthVertexFactory.hlsl" ), false, 0 )
 
 //
 // GLOBALS
 //
 TGlobalResource< CStaticMeshVertexDeclaration >			GStaticMeshVertexDeclaration;
+TGlobalResource< CStaticMeshDepthVertexDeclaration >	GStaticMeshDepthVertexDeclaration;
 
 void CStaticMeshVertexDeclaration::InitRHI()
 {
@@ -41,3 +43,32 @@ CVertexFactoryShaderParameters* CStaticMeshVertexFactory::ConstructShaderParamet
 {
     return InShaderFrequency == SF_Vertex ? new CGeneralVertexShaderParameters( staticType.SupportsInstancing() ) : nullptr;
 }
+
+void CStaticMeshDepthVertexDeclaration::InitRHI()
+{
+	VertexDeclarationElementList_t		vertexDeclElementList =
+	{
+		SVertexElement( CStaticMeshDepthVertexFactory::SSS_Main, sizeof( Vector4D ), 0, VET_Float4, VEU_Position, 0 )
+	};
+	vertexDeclarationRHI = GRHI->CreateVertexDeclaration( vertexDeclElementList );
+}
+
+void CStaticMeshDepthVertexDeclaration::ReleaseRHI()
+{
+	vertexDeclarationRHI.SafeRelease();
+}
+
+void CStaticMeshDepthVertexFactory::InitRHI()
+{
+	InitDeclaration( GStaticMeshDepthVertexDeclaration.GetVertexDeclarationRHI() );
+}
+
+uint64 CStaticMeshDepthVertexFactory::GetTypeHash() const
+{
+	return staticType.GetHash();
+}
+
+CVertexFactoryShaderParameters* CStaticMeshDepthVertexFactory::ConstructShaderParameters( EShaderFrequency InShaderFrequency )
+{
+	return InShaderFrequency == SF_Vertex ? new CGeneralVertexShaderParameters( staticType.SupportsInstancing() ) : nullptr;
+}
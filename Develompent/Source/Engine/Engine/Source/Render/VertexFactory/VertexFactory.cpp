@@ -3,6 +3,7 @@
 #include "Misc/Misc.h"
 #include "RHI/BaseRHI.h"
 #include "Render/RenderingThread.h"
+#include "Render/PipelineState.h"
 #include "Render/Shaders/ShaderManager.h"
 #include "Render/VertexFactory/VertexFactory.h"
 
@@ -62,12 +63,14 @@ void CVertexFactory::SetShaderParameters( class CBaseDeviceContextRHI* InDeviceC
 void CVertexFactory::InitDeclaration( const VertexDeclarationElementList_t& InElements )
 {
 	declaration = GRHI->CreateVertexDeclaration( InElements );
+	GPipelineStateCache.RegisterVertexDeclaration( declaration );
 }
 
 void CVertexFactory::InitDeclaration( const VertexDeclarationRHIParamRef_t InDeclaration )
 {
 	check( InDeclaration );
 	declaration = InDeclaration;
+	GPipelineStateCache.RegisterVertexDeclaration( declaration );
 }
 
 void CVertexFactory::Init()
@@ -1,3 +1,5 @@
+#include "Logger/LoggerMacros.h"
+#include "System/ConCmd.h"
 #include "Misc/EngineGlobals.h"
 #include "RHI/BaseRHI.h"
 #include "RHI/BaseDeviceContextRHI.h"
@@ -6,6 +8,28 @@
 #include "Render/Viewport.h"
 #include "Render/SceneRenderTargets.h"
 #include "Render/Scene.h"
+#include "Render/SceneUtils.h"
+#include "Render/DynamicMeshBuffer.h"
+
+/**
+ * Command 'rhi.stats', print statistics of shader constants in last frame
+ */
+static void CmdRHIStats( const std::vector<std::wstring>& InArguments )
+{
+	// Statistics are changed by the rendering thread, so they are printed there
+	UNIQUE_RENDER_COMMAND( CDumpRHIStatsCommand,
+						   {
+							   const SConstantBufferStats&		stats = GRHI->GetLastFrameConstantBufferStats();
+							   LE_LOG( LT_Log, LC_Console, TEXT( "Shader constants: %u updates, %u redundant updates" ), stats.numUpdates, stats.numRedundantUpdates );
+							   LE_LOG( LT_Log, LC_Console, TEXT( "Shader constants: %u uploads, %u skipped uploads, %llu dirty bytes, %llu uploaded bytes" ),
+									   stats.numUploads, stats.numSkippedUploads, stats.numDirtyBytes, stats.numUploadedBytes );
+						   } );
+}
+
+// -------------
+// GLOBALS
+// -------------
+CConCmd		CCmdRHIStats( TEXT( "rhi.stats" ), TEXT( "Print statistics of shader constants in last frame" ), &CmdRHIStats );
 
 CViewport::CViewport() 
 	: windowHandle( nullptr )
@@ -124,6 +148,11 @@ void CViewport::Draw( bool InIsShouldPresent /* = true */ )
 										{
 											CBaseDeviceContextRHI*		immediateContext = GRHI->GetImmediateContext();
 											GRHI->BeginDrawingViewport( immediateContext, viewportRHI );
+											GRHI->ResetConstantBufferStats();
+											GDynamicMeshBuffer.BeginFrame();
+#if FRAME_CAPTURE_MARKERS
+											CScopedDrawEvent::UpdateEnabled();
+#endif // FRAME_CAPTURE_MARKERS
 										} );
 
 	// Draw viewport
@@ -1,6 +1,7 @@
 #include "Containers/StringConv.h"
 #include "Logger/LoggerMacros.h"
 #include "Scripts/ScriptEngine.h"
+#include "System/Malloc.h"
 
 // ----------------
 // STATIC VALUES
@@ -13,6 +14,8 @@
  */
 void CScriptEngine::Init()
 {
+	SCOPED_MEMORY_TAG( MTAG_Scripts );
+
 	LE_LOG( LT_Log, LC_Init, TEXT( "Lua version: %s" ), ANSI_TO_TCHAR( LUA_RELEASE ) );
 	LE_LOG( LT_Log, LC_Init, TEXT( "LuaJIT version: %s" ), ANSI_TO_TCHAR( LUAJIT_VERSION ) );
 }
\ No newline at end of file
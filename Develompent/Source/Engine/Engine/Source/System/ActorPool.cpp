@@ -0,0 +1,214 @@
+#include "Misc/Class.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Config.h"
+#include "System/ActorPool.h"
+#include "System/World.h"
+#include "System/ConCmd.h"
+#include "Actors/Actor.h"
+
+/**
+ * Constructor
+ */
+CActorPool::CActorPool()
+	: bEnable( false )
+{}
+
+/**
+ * Load settings and pooled classes from engine config
+ */
+void CActorPool::LoadFromConfig()
+{
+	CConfigValue		configEnable = GConfig.GetValue( CT_Engine, TEXT( "Engine.ActorPool" ), TEXT( "Enable" ) );
+	if ( configEnable.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configEnable.GetBool();
+	}
+
+	// Each pool is object with class name, max size and prewarm size
+	CConfigValue		configPools = GConfig.GetValue( CT_Engine, TEXT( "Engine.ActorPool" ), TEXT( "Pools" ) );
+	if ( !configPools.IsA( CConfigValue::T_Array ) )
+	{
+		return;
+	}
+
+	std::vector<CConfigValue>		configPoolValues = configPools.GetArray();
+	for ( uint32 index = 0, count = ( uint32 )configPoolValues.size(); index < count; ++index )
+	{
+		if ( !configPoolValues[ index ].IsA( CConfigValue::T_Object ) )
+		{
+			LE_LOG( LT_Warning, LC_General, TEXT( "Engine.ActorPool: Pools[%i] must be object" ), index );
+			continue;
+		}
+
+		CConfigObject		configPool = configPoolValues[ index ].GetObject();
+		std::wstring		className = configPool.GetValue( TEXT( "Class" ) ).GetString();
+		CClass*				actorClass = CClass::StaticFindClass( className.c_str() );
+		if ( !actorClass )
+		{
+			LE_LOG( LT_Warning, LC_General, TEXT( "Engine.ActorPool: Class '%s' not found" ), className.c_str() );
+			continue;
+		}
+
+		CConfigValue		configMaxSize = configPool.GetValue( TEXT( "MaxSize" ) );
+		CConfigValue		configPrewarmSize = configPool.GetValue( TEXT( "PrewarmSize" ) );
+		RegisterClass( actorClass,
+					   configMaxSize.IsA( CConfigValue::T_Int ) ? Max( configMaxSize.GetInt(), 0 ) : 0,
+					   configPrewarmSize.IsA( CConfigValue::T_Int ) ? Max( configPrewarmSize.GetInt(), 0 ) : 0 );
+	}
+}
+
+/**
+ * Register class for pooling
+ */
+void CActorPool::RegisterClass( class CClass* InClass, uint32 InMaxSize, uint32 InPrewarmSize /* = 0 */ )
+{
+	check( InClass );
+	SPool&		pool = pools[ InClass ];
+	pool.maxSize		= InMaxSize;
+	pool.prewarmSize	= Min( InPrewarmSize, InMaxSize );
+}
+
+/**
+ * Get archetype of pool
+ */
+AActor* CActorPool::GetArchetype( class CClass* InClass, SPool& InPool )
+{
+	if ( !InPool.archetype )
+	{
+		InPool.archetype = InClass->CreateObject<AActor>();
+		check( InPool.archetype );
+		InPool.archetype->SetName( InClass->GetName().c_str() );
+	}
+	return InPool.archetype;
+}
+
+/**
+ * Fill pools with new actors up to prewarm size of each class
+ */
+void CActorPool::Prewarm()
+{
+	if ( !bEnable )
+	{
+		return;
+	}
+
+	for ( auto itPool = pools.begin(), itPoolEnd = pools.end(); itPool != itPoolEnd; ++itPool )
+	{
+		CClass*		actorClass = itPool->first;
+		SPool&		pool = itPool->second;
+		for ( uint32 index = ( uint32 )pool.freeActors.size(); index < pool.prewarmSize; ++index )
+		{
+			AActor*		actor = actorClass->CreateObject<AActor>();
+			check( actor );
+			actor->SetName( actorClass->GetName().c_str() );
+			pool.freeActors.push_back( actor );
+		}
+		pool.stats.peakSize = Max( pool.stats.peakSize, ( uint32 )pool.freeActors.size() );
+	}
+}
+
+/**
+ * Take actor from pool
+ */
+ActorRef_t CActorPool::Acquire( class CClass* InClass )
+{
+	if ( !bEnable )
+	{
+		return nullptr;
+	}
+
+	auto		itPool = pools.find( InClass );
+	if ( itPool == pools.end() )
+	{
+		return nullptr;
+	}
+
+	SPool&		pool = itPool->second;
+	if ( pool.freeActors.empty() )
+	{
+		++pool.stats.numMisses;
+		return nullptr;
+	}
+
+	ActorRef_t		actor = pool.freeActors.back();
+	pool.freeActors.pop_back();
+	++pool.stats.numHits;
+	return actor;
+}
+
+/**
+ * Return destroyed actor to pool
+ */
+bool CActorPool::Release( ActorRef_t InActor )
+{
+	check( InActor );
+	if ( !bEnable )
+	{
+		return false;
+	}
+
+	auto		itPool = pools.find( InActor->GetClass() );
+	if ( itPool == pools.end() )
+	{
+		return false;
+	}
+
+	SPool&		pool = itPool->second;
+	if ( pool.freeActors.size() >= pool.maxSize )
+	{
+		++pool.stats.numDiscarded;
+		return false;
+	}
+
+	InActor->ResetForPool( GetArchetype( itPool->first, pool ) );
+	pool.freeActors.push_back( InActor );
+	++pool.stats.numReturned;
+	pool.stats.peakSize = Max( pool.stats.peakSize, ( uint32 )pool.freeActors.size() );
+	return true;
+}
+
+/**
+ * Delete all free actors and archetypes in pools
+ */
+void CActorPool::Empty()
+{
+	for ( auto itPool = pools.begin(), itPoolEnd = pools.end(); itPool != itPoolEnd; ++itPool )
+	{
+		itPool->second.archetype = nullptr;
+		itPool->second.freeActors.clear();
+	}
+}
+
+/**
+ * Print statistics of pools into log
+ */
+void CActorPool::DumpStats() const
+{
+	if ( !bEnable || pools.empty() )
+	{
+		LE_LOG( LT_Log, LC_Console, TEXT( "Actor pool is disabled" ) );
+		return;
+	}
+
+	for ( auto itPool = pools.begin(), itPoolEnd = pools.end(); itPool != itPoolEnd; ++itPool )
+	{
+		const SPool&	pool = itPool->second;
+		LE_LOG( LT_Log, LC_Console, TEXT( "%s: %u free (peak %u, max %u), %u hits, %u misses, %u returned, %u discarded" ),
+				itPool->first->GetName().c_str(), ( uint32 )pool.freeActors.size(), pool.stats.peakSize, pool.maxSize,
+				pool.stats.numHits, pool.stats.numMisses, pool.stats.numReturned, pool.stats.numDiscarded );
+	}
+}
+
+/**
+ * Command 'pool.stats', print statistics of actor pools
+ */
+static void CmdPoolStats( const std::vector<std::wstring>& InArguments )
+{
+	GWorld->GetActorPool().DumpStats();
+}
+
+//
+// GLOBALS
+//
+CConCmd		CCmdPoolStats( TEXT( "pool.stats" ), TEXT( "Print statistics of actor pools" ), &CmdPoolStats );
@@ -160,7 +160,6 @@ void CBaseEngine::Shutdown()
 void CBaseEngine::Tick( float InDeltaSeconds )
 {
 	GUIEngine->Tick( InDeltaSeconds );
-	GPhysicsEngine.Tick( InDeltaSeconds );
 }
 
 void CBaseEngine::ProcessEvent( struct SWindowEvent& InWindowEvent )
@@ -7,18 +7,16 @@ CConCmd::CConCmd( const std::wstring& InName, const std::wstring& InHelpText, co
 	, helpText( InHelpText )
 {
 	onExecCmd.Bind( InExecDelegate );
-	GetGlobalConCmds().push_back( this );
+	GetGlobalConCmds().emplace( name, this );
 }
 
 CConCmd::~CConCmd()
 {
-	std::vector<CConCmd*>&		cmds = GetGlobalConCmds();
-	for ( uint32 index = 0, count = cmds.size(); index < count; ++index )
+	// Remove from registry only if it our entry, command with the same name may be registered earlier
+	std::unordered_map<std::wstring, CConCmd*>&				cmds = GetGlobalConCmds();
+	std::unordered_map<std::wstring, CConCmd*>::iterator	itCmd = cmds.find( name );
+	if ( itCmd != cmds.end() && itCmd->second == this )
 	{
-		if ( cmds[index] == this )
-		{
-			cmds.erase( cmds.begin() + index );
-			break;
-		}
+		cmds.erase( itCmd );
 	}
 }
\ No newline at end of file
@@ -7,45 +7,52 @@
 CConVar::CConVar( const std::wstring& InName, const std::wstring& InDefaultValue, EConVarType InType, const std::wstring& InHelpText, bool InHasMin, float InMin, bool InHasMax, float InMax, bool InIsReadOnly /* = false */ )
 	: bHasMin( InHasMin )
 	, bHasMax( InHasMax )
-	, bReadOnly( InIsReadOnly )
+	, bReadOnly( false )
 	, name( InName )
 	, helpText( InHelpText )
 	, defaultValue( InDefaultValue )
 	, type( CVT_None )
-	, data( nullptr )
 	, minVar( InMin )
 	, maxVar( InMax )
 {
-	GetGlobalConVars().push_back( this );
+	value.intValue = 0;
+	GetGlobalConVars().emplace( name, this );
+	++GetGlobalConVarsSerial();
 	SetValue( InDefaultValue, InType );
+
+	// Read only flag must be set after initialize default value, otherwise value will be not set
+	bReadOnly = InIsReadOnly;
 }
 
 CConVar::CConVar( const std::wstring& InName, const std::wstring& InDefaultValue, EConVarType InType, const std::wstring& InHelpText, bool InIsReadOnly /* = false */ )
 	: bHasMin( false )
 	, bHasMax( false )
-	, bReadOnly( InIsReadOnly )
+	, bReadOnly( false )
 	, name( InName )
 	, helpText( InHelpText )
 	, defaultValue( InDefaultValue )
 	, type( CVT_None )
-	, data( nullptr )
 	, minVar( 0.f )
 	, maxVar( 0.f )
 {
-	GetGlobalConVars().push_back( this );
+	value.intValue = 0;
+	GetGlobalConVars().emplace( name, this );
+	++GetGlobalConVarsSerial();
 	SetValue( InDefaultValue, InType );
+
+	// Read only flag must be set after initialize default value, otherwise value will be not set
+	bReadOnly = InIsReadOnly;
 }
 
 CConVar::~CConVar()
 {
-	std::vector<CConVar*>&	vars = GetGlobalConVars();
-	for ( uint32 index = 0, count = vars.size(); index < count; ++index )
+	// Remove from registry only if it our entry, variable with the same name may be registered earlier
+	std::unordered_map<std::wstring, CConVar*>&				vars = GetGlobalConVars();
+	std::unordered_map<std::wstring, CConVar*>::iterator	itVar = vars.find( name );
+	if ( itVar != vars.end() && itVar->second == this )
 	{
-		if ( vars[index] == this )
-		{
-			vars.erase( vars.begin() + index );
-			break;
-		}
+		vars.erase( itVar );
+		++GetGlobalConVarsSerial();
 	}
 
 	DeleteValue();
@@ -96,12 +103,7 @@ void CConVar::SetValueInt( int32 InValue )
 		DeleteValue();
 	}
 
-	if ( type == CVT_None )
-	{
-		data = new int32;
-	}
-
-	int32*	intData = ( int32* )data;
+	int32*	intData = &value.intValue;
 	if ( bHasMin && InValue < minVar )
 	{
 		*intData = minVar;
@@ -131,12 +133,7 @@ void CConVar::SetValueFloat( float InValue )
 		DeleteValue();
 	}
 
-	if ( type == CVT_None )
-	{
-		data = new float;
-	}
-
-	float*		floatData = ( float* )data;
+	float*		floatData = &value.floatValue;
 	if ( bHasMin && InValue < minVar )
 	{
 		*floatData = minVar;
@@ -166,12 +163,7 @@ void CConVar::SetValueBool( bool InValue )
 		DeleteValue();
 	}
 
-	if ( type == CVT_None )
-	{
-		data = new bool;
-	}
-
-	bool*	boolData = ( bool* )data;
+	bool*	boolData = &value.boolValue;
 	SetMin( true, 0.f );
 	SetMax( true, 1.f );
 
@@ -204,12 +196,7 @@ void CConVar::SetValueString( const std::wstring& InValue )
 		DeleteValue();
 	}
 
-	if ( type == CVT_None )
-	{
-		data = new std::wstring();
-	}
-
-	std::wstring*	stringData = ( std::wstring* )data;
+	std::wstring*	stringData = &stringValue;
 	if ( bHasMin && InValue.size() < minVar )
 	{
 		*stringData = InValue;
@@ -235,13 +222,13 @@ void CConVar::DeleteValue()
 		return;
 	}
 
-	switch ( type )
+	// Scalar values stored inline, so we need only release memory of string
+	if ( type == CVT_String )
 	{
-	case CVT_Int:       delete static_cast<int32*>( data );				break;
-	case CVT_Bool:      delete static_cast<bool*>( data );				break;
-	case CVT_Float:     delete static_cast<float*>( data );				break;
-	case CVT_String:    delete static_cast<std::wstring*>( data );		break;
+		stringValue.clear();
+		stringValue.shrink_to_fit();
 	}
 
+	value.intValue = 0;
 	type = CVT_None;
 }
\ No newline at end of file
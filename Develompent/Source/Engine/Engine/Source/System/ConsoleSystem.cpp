@@ -1,3 +1,5 @@
+#include <map>
+
 #include "Logger/LoggerMacros.h"
 #include "System/ConsoleSystem.h"
 
@@ -114,42 +116,26 @@ bool CConsoleSystem::Exec( const std::wstring& InCommand )
 
 CConVar* CConsoleSystem::FindVar( const std::wstring& InName )
 {
-	std::vector<CConVar*>&		vars = GetGlobalConVars();
-	for ( uint32 index = 0, count = vars.size(); index < count; ++index )
-	{
-		if ( vars[index]->GetName() == InName )
-		{
-			return vars[index];
-		}
-	}
-
-	return nullptr;
+	return FindGlobalConVar( InName );
 }
 
 CConCmd* CConsoleSystem::FindCmd( const std::wstring& InName )
 {
-	std::vector<CConCmd*>&		cmds = GetGlobalConCmds();
-	for ( uint32 index = 0, count = cmds.size(); index < count; ++index )
-	{
-		if ( cmds[index]->GetName() == InName )
-		{
-			return cmds[index];
-		}
-	}
-
-	return nullptr;
+	std::unordered_map<std::wstring, CConCmd*>&				cmds = GetGlobalConCmds();
+	std::unordered_map<std::wstring, CConCmd*>::iterator	itCmd = cmds.find( InName );
+	return itCmd != cmds.end() ? itCmd->second : nullptr;
 }
 
 void CConsoleSystem::CmdHelp( const std::vector<std::wstring>& InArguments )
 {
-	// Print all console variables
+	// Print all console variables. Registry is hash map, so we sort them by name for stable output
 	LE_LOG( LT_Log, LC_Console, TEXT( "" ) );
 	LE_LOG( LT_Log, LC_Console, TEXT( "** Console variables **" ) );
 	{
-		std::vector<CConVar*>&		vars = GetGlobalConVars();
-		for ( uint32 index = 0, count = vars.size(); index < count; ++index )
+		std::map<std::wstring, CConVar*>		vars( GetGlobalConVars().begin(), GetGlobalConVars().end() );
+		for ( auto itVar = vars.begin(), itVarEnd = vars.end(); itVar != itVarEnd; ++itVar )
 		{
-			CConVar*	var = vars[index];
+			CConVar*	var = itVar->second;
 			LE_LOG( LT_Log, LC_Console, TEXT( "%s : %s. Default value: %s" ), var->GetName().c_str(), var->GetHelpText().c_str(), var->GetValueDefault().c_str() );
 		}
 	}
@@ -158,11 +144,11 @@ void CConsoleSystem::CmdHelp( const std::vector<std::wstring>& InArguments )
 	LE_LOG( LT_Log, LC_Console, TEXT( "" ) );
 	LE_LOG( LT_Log, LC_Console, TEXT( "** Console commands **" ) );
 	{
-		std::vector<CConCmd*>&		cmds = GetGlobalConCmds();
-		for ( uint32 index = 0, count = cmds.size(); index < count; ++index )
+		std::map<std::wstring, CConCmd*>		cmds( GetGlobalConCmds().begin(), GetGlobalConCmds().end() );
+		for ( auto itCmd = cmds.begin(), itCmdEnd = cmds.end(); itCmd != itCmdEnd; ++itCmd )
 		{
-			CConCmd*	cmd = cmds[index];
+			CConCmd*	cmd = itCmd->second;
 			LE_LOG( LT_Log, LC_Console, TEXT( "%s : %s" ), cmd->GetName().c_str(), cmd->GetHelpText().c_str() );
 		}
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,57 @@
+#include "Logger/LoggerMacros.h"
+#include "System/MallocTracking.h"
+#include "System/ConCmd.h"
+
+/**
+ * Is tracking allocator available
+ */
+static bool IsMallocTrackingAvailable()
+{
+	if ( !GMallocTracking )
+	{
+		LE_LOG( LT_Warning, LC_Console, TEXT( "Memory tracking is disabled in this build" ) );
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Command 'mem.stats', print statistics of memory tags
+ */
+static void CmdMemStats( const std::vector<std::wstring>& InArguments )
+{
+	if ( IsMallocTrackingAvailable() )
+	{
+		GMallocTracking->DumpStats();
+	}
+}
+
+/**
+ * Command 'mem.snapshot', save current statistics of memory tags
+ */
+static void CmdMemSnapshot( const std::vector<std::wstring>& InArguments )
+{
+	if ( IsMallocTrackingAvailable() )
+	{
+		GMallocTracking->TakeSnapshot();
+		LE_LOG( LT_Log, LC_Console, TEXT( "Memory snapshot is taken, 'mem.stats' will print difference with it" ) );
+	}
+}
+
+/**
+ * Command 'mem.leaks', print live allocations grouped by call stack
+ */
+static void CmdMemLeaks( const std::vector<std::wstring>& InArguments )
+{
+	if ( IsMallocTrackingAvailable() )
+	{
+		GMallocTracking->DumpLiveAllocations( !InArguments.empty() ? Max( std::stoi( InArguments[ 0 ] ), 1 ) : 32 );
+	}
+}
+
+//
+// GLOBALS
+//
+CConCmd			CCmdMemStats( TEXT( "mem.stats" ), TEXT( "Print statistics of memory tags" ), &CmdMemStats );
+CConCmd			CCmdMemSnapshot( TEXT( "mem.snapshot" ), TEXT( "Save statistics of memory tags, next 'mem.stats' will print difference with it" ), &CmdMemSnapshot );
+CConCmd			CCmdMemLeaks( TEXT( "mem.leaks" ), TEXT( "Print live allocations grouped by call stack. Usage: mem.leaks <max groups>" ), &CmdMemLeaks );
@@ -0,0 +1,179 @@
+#include <algorithm>
+
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Config.h"
+#include "System/CameraManager.h"
+#include "System/SignificanceManager.h"
+#include "System/World.h"
+#include "System/ConCmd.h"
+#include "Components/CameraComponent.h"
+#include "Actors/Actor.h"
+
+/**
+ * Load settings from engine config
+ */
+void SSignificanceSettings::LoadFromConfig()
+{
+	CConfigValue		configEnableSignificance = GConfig.GetValue( CT_Engine, TEXT( "Engine.Tick" ), TEXT( "EnableSignificance" ) );
+	if ( configEnableSignificance.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configEnableSignificance.GetBool();
+	}
+
+	CConfigValue		configStaticActorsDormant = GConfig.GetValue( CT_Engine, TEXT( "Engine.Tick" ), TEXT( "StaticActorsDormant" ) );
+	if ( configStaticActorsDormant.IsA( CConfigValue::T_Bool ) )
+	{
+		bStaticActorsDormant = configStaticActorsDormant.GetBool();
+	}
+
+	CConfigValue		configUpdateInterval = GConfig.GetValue( CT_Engine, TEXT( "Engine.Tick" ), TEXT( "SignificanceUpdateInterval" ) );
+	if ( configUpdateInterval.IsA( CConfigValue::T_Float ) || configUpdateInterval.IsA( CConfigValue::T_Int ) )
+	{
+		updateInterval = Max( configUpdateInterval.GetNumber(), 0.f );
+	}
+
+	// Distances and tick intervals are two arrays with the same size
+	CConfigValue		configDistances = GConfig.GetValue( CT_Engine, TEXT( "Engine.Tick" ), TEXT( "SignificanceDistances" ) );
+	CConfigValue		configTickIntervals = GConfig.GetValue( CT_Engine, TEXT( "Engine.Tick" ), TEXT( "SignificanceTickIntervals" ) );
+	if ( configDistances.IsA( CConfigValue::T_Array ) && configTickIntervals.IsA( CConfigValue::T_Array ) )
+	{
+		std::vector<CConfigValue>		configDistanceValues = configDistances.GetArray();
+		std::vector<CConfigValue>		configTickIntervalValues = configTickIntervals.GetArray();
+		if ( configDistanceValues.size() != configTickIntervalValues.size() )
+		{
+			LE_LOG( LT_Warning, LC_General, TEXT( "Engine.Tick: SignificanceDistances and SignificanceTickIntervals must have the same size" ) );
+			return;
+		}
+
+		std::vector<std::pair<float, float>>		distanceIntervals;
+		for ( uint32 index = 0, count = ( uint32 )configDistanceValues.size(); index < count; ++index )
+		{
+			distanceIntervals.push_back( std::make_pair( configDistanceValues[ index ].GetNumber(), configTickIntervalValues[ index ].GetNumber() ) );
+		}
+
+		// Buckets are searched from the farthest distance, so distances must be ascending
+		auto		lessDistance = []( const std::pair<float, float>& InA, const std::pair<float, float>& InB )
+								   {
+									   return InA.first < InB.first;
+								   };
+		if ( !std::is_sorted( distanceIntervals.begin(), distanceIntervals.end(), lessDistance ) )
+		{
+			LE_LOG( LT_Warning, LC_General, TEXT( "Engine.Tick: SignificanceDistances must be ascending, they are sorted with their tick intervals" ) );
+			std::stable_sort( distanceIntervals.begin(), distanceIntervals.end(), lessDistance );
+		}
+
+		distances.clear();
+		tickIntervals.clear();
+		for ( uint32 index = 0, count = ( uint32 )distanceIntervals.size(); index < count; ++index )
+		{
+			distances.push_back( distanceIntervals[ index ].first );
+			tickIntervals.push_back( distanceIntervals[ index ].second );
+		}
+	}
+}
+
+/**
+ * Constructor
+ */
+CSignificanceManager::CSignificanceManager()
+	: timeSinceUpdate( 0.f )
+{}
+
+/**
+ * Apply settings
+ */
+void CSignificanceManager::ApplySettings( const SSignificanceSettings& InSettings )
+{
+	settings			= InSettings;
+	timeSinceUpdate		= settings.updateInterval;
+	numActorsInBuckets.clear();
+	numActorsInBuckets.resize( settings.distances.size() + 1 );
+}
+
+/**
+ * Update significance of actors
+ */
+void CSignificanceManager::Update( const std::vector<ActorRef_t>& InActors, float InDeltaTime )
+{
+	if ( !settings.bEnable || settings.distances.empty() )
+	{
+		return;
+	}
+
+	// Significance doesn't change quickly, so we don't update it every frame
+	timeSinceUpdate += InDeltaTime;
+	if ( timeSinceUpdate < settings.updateInterval )
+	{
+		return;
+	}
+	timeSinceUpdate = 0.f;
+
+	TRefCountPtr<CCameraComponent>		activeCamera = GCameraManager->GetActiveCamera();
+	if ( !activeCamera )
+	{
+		return;
+	}
+
+	// Bucket with index numDistances is for actors nearer than first distance
+	Vector		viewLocation = activeCamera->GetComponentLocation();
+	uint32		numDistances = ( uint32 )settings.distances.size();
+	std::fill( numActorsInBuckets.begin(), numActorsInBuckets.end(), 0 );
+	for ( uint32 index = 0, count = ( uint32 )InActors.size(); index < count; ++index )
+	{
+		AActor*		actor = InActors[ index ];
+		if ( !actor->IsTickBySignificance() )
+		{
+			continue;
+		}
+
+		float		distance = SMath::DistanceVector( actor->GetActorLocation(), viewLocation );
+		float		throttleInterval = 0.f;
+		uint32		bucket = numDistances;
+		for ( int32 distanceIndex = numDistances - 1; distanceIndex >= 0; --distanceIndex )
+		{
+			if ( distance >= settings.distances[ distanceIndex ] )
+			{
+				throttleInterval	= settings.tickIntervals[ distanceIndex ];
+				bucket				= distanceIndex;
+				break;
+			}
+		}
+
+		++numActorsInBuckets[ bucket ];
+		actor->SetTickThrottleInterval( throttleInterval );
+	}
+}
+
+/**
+ * Print statistics of buckets into log
+ */
+void CSignificanceManager::DumpStats() const
+{
+	if ( !settings.bEnable || settings.distances.empty() )
+	{
+		LE_LOG( LT_Log, LC_Console, TEXT( "Significance manager is disabled" ) );
+		return;
+	}
+
+	LE_LOG( LT_Log, LC_Console, TEXT( "Significance: %u actors nearer than %.1f, ticked every frame" ), numActorsInBuckets.back(), settings.distances[ 0 ] );
+	for ( uint32 index = 0, count = ( uint32 )settings.distances.size(); index < count; ++index )
+	{
+		LE_LOG( LT_Log, LC_Console, TEXT( "Significance: %u actors farther than %.1f, tick interval %.3f sec" ), numActorsInBuckets[ index ], settings.distances[ index ], settings.tickIntervals[ index ] );
+	}
+}
+
+/**
+ * Command 'tick.stats', print statistics of tick task manager and significance manager
+ */
+static void CmdTickStats( const std::vector<std::wstring>& InArguments )
+{
+	const STickStats&		stats = GWorld->GetTickTaskManager().GetStats();
+	LE_LOG( LT_Log, LC_Console, TEXT( "Tick functions: %u registered, %u dormant, %i ticked, %i skipped by interval" ), stats.numRegistered, stats.numDormant, stats.numTicked, stats.numSkipped );
+	GWorld->GetSignificanceManager().DumpStats();
+}
+
+//
+// GLOBALS
+//
+CConCmd		CCmdTickStats( TEXT( "tick.stats" ), TEXT( "Print statistics of tick functions in last frame" ), &CmdTickStats );
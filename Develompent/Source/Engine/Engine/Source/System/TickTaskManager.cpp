@@ -0,0 +1,448 @@
+#include <algorithm>
+
+#include "Core.h"
+#include "Misc/Template.h"
+#include "Logger/LoggerMacros.h"
+#include "System/ThreadPool.h"
+#include "System/TickTaskManager.h"
+#include "System/ConVar.h"
+
+//
+// GLOBALS
+//
+CConVar		CVarTickParallel( TEXT( "tick.parallel" ), TEXT( "1" ), CVT_Bool, TEXT( "Enable/Disable ticking of thread-safe tick functions on worker threads" ) );
+
+/**
+ * Remove element from array with unordered erase
+ */
+static FORCEINLINE void RemoveTickFunctionFromArray( std::vector<CTickFunction*>& InArray, CTickFunction* InTickFunction )
+{
+	std::vector<CTickFunction*>::iterator		it = std::find( InArray.begin(), InArray.end(), InTickFunction );
+	if ( it != InArray.end() )
+	{
+		*it = InArray.back();
+		InArray.pop_back();
+	}
+}
+
+/**
+ * Constructor
+ */
+CTickFunction::CTickFunction()
+	: tickGroup( TG_PrePhysics )
+	, bTickInParallel( false )
+	, bTickEnabled( true )
+	, tickInterval( 0.f )
+	, throttleInterval( 0.f )
+	, accumulatedTime( 0.f )
+	, tickTaskManager( nullptr )
+	, registeredIndex( INDEX_NONE )
+	, scheduledList( nullptr )
+	, scheduledIndex( INDEX_NONE )
+	, tickLevel( 0 )
+	, visitMark( 0 )
+{}
+
+/**
+ * Destructor
+ */
+CTickFunction::~CTickFunction()
+{
+	if ( tickTaskManager )
+	{
+		tickTaskManager->UnregisterTickFunction( this );
+	}
+
+	// Remove links with other tick functions
+	for ( uint32 index = 0, count = ( uint32 )prerequisites.size(); index < count; ++index )
+	{
+		RemoveTickFunctionFromArray( prerequisites[ index ]->dependents, this );
+	}
+
+	for ( uint32 index = 0, count = ( uint32 )dependents.size(); index < count; ++index )
+	{
+		CTickFunction*		dependent = dependents[ index ];
+		RemoveTickFunctionFromArray( dependent->prerequisites, this );
+		dependent->MarkScheduleDirty();
+	}
+}
+
+/**
+ * Add prerequisite
+ */
+void CTickFunction::AddPrerequisite( CTickFunction* InPrerequisite )
+{
+	check( InPrerequisite && InPrerequisite != this );
+	if ( std::find( prerequisites.begin(), prerequisites.end(), InPrerequisite ) != prerequisites.end() )
+	{
+		return;
+	}
+
+	prerequisites.push_back( InPrerequisite );
+	InPrerequisite->dependents.push_back( this );
+	MarkScheduleDirty();
+}
+
+/**
+ * Remove prerequisite
+ */
+void CTickFunction::RemovePrerequisite( CTickFunction* InPrerequisite )
+{
+	check( InPrerequisite );
+	RemoveTickFunctionFromArray( prerequisites, InPrerequisite );
+	RemoveTickFunctionFromArray( InPrerequisite->dependents, this );
+	MarkScheduleDirty();
+}
+
+/**
+ * Enable or disable tick
+ */
+void CTickFunction::SetTickEnabled( bool InIsEnabled )
+{
+	if ( bTickEnabled != InIsEnabled )
+	{
+		bTickEnabled	= InIsEnabled;
+		accumulatedTime = 0.f;
+		MarkScheduleDirty();
+	}
+}
+
+/**
+ * Set tick group
+ */
+void CTickFunction::SetTickGroup( ETickingGroup InTickGroup )
+{
+	check( InTickGroup < TG_NumGroups );
+	if ( tickGroup != InTickGroup )
+	{
+		tickGroup = InTickGroup;
+		MarkScheduleDirty();
+	}
+}
+
+/**
+ * Set is tick function may be ticked in parallel
+ */
+void CTickFunction::SetTickInParallel( bool InIsTickInParallel )
+{
+	if ( bTickInParallel != InIsTickInParallel )
+	{
+		bTickInParallel = InIsTickInParallel;
+		MarkScheduleDirty();
+	}
+}
+
+/**
+ * Mark schedule of tick task manager dirty
+ */
+void CTickFunction::MarkScheduleDirty()
+{
+	if ( tickTaskManager )
+	{
+		tickTaskManager->MarkScheduleDirty();
+	}
+}
+
+/**
+ * Constructor
+ */
+CTickTaskManager::CTickTaskManager()
+	: bScheduleDirty( false )
+	, currentVisitMark( 0 )
+{}
+
+/**
+ * Destructor
+ */
+CTickTaskManager::~CTickTaskManager()
+{
+	UnregisterAllTickFunctions();
+}
+
+/**
+ * Register tick function
+ */
+void CTickTaskManager::RegisterTickFunction( CTickFunction* InTickFunction )
+{
+	check( InTickFunction );
+	if ( InTickFunction->tickTaskManager == this )
+	{
+		return;
+	}
+
+	checkMsg( !InTickFunction->tickTaskManager, TEXT( "Tick function already registered in other tick task manager" ) );
+	InTickFunction->tickTaskManager		= this;
+	InTickFunction->registeredIndex		= ( uint32 )tickFunctions.size();
+	tickFunctions.push_back( InTickFunction );
+	bScheduleDirty = true;
+}
+
+/**
+ * Unregister tick function
+ */
+void CTickTaskManager::UnregisterTickFunction( CTickFunction* InTickFunction )
+{
+	check( InTickFunction );
+	if ( InTickFunction->tickTaskManager != this )
+	{
+		return;
+	}
+
+	// Tick function may be unregistered during tick, so we only clear it in schedule
+	if ( InTickFunction->scheduledList )
+	{
+		( *InTickFunction->scheduledList )[ InTickFunction->scheduledIndex ] = nullptr;
+	}
+
+	// Unordered remove from array of registered tick functions
+	uint32		index = InTickFunction->registeredIndex;
+	check( index < tickFunctions.size() && tickFunctions[ index ] == InTickFunction );
+	tickFunctions[ index ]						= tickFunctions.back();
+	tickFunctions[ index ]->registeredIndex		= index;
+	tickFunctions.pop_back();
+
+	InTickFunction->tickTaskManager		= nullptr;
+	InTickFunction->registeredIndex		= INDEX_NONE;
+	InTickFunction->scheduledList		= nullptr;
+	InTickFunction->scheduledIndex		= INDEX_NONE;
+	bScheduleDirty = true;
+}
+
+/**
+ * Unregister all tick functions
+ */
+void CTickTaskManager::UnregisterAllTickFunctions()
+{
+	for ( uint32 index = 0, count = ( uint32 )tickFunctions.size(); index < count; ++index )
+	{
+		CTickFunction*		tickFunction = tickFunctions[ index ];
+		tickFunction->tickTaskManager	= nullptr;
+		tickFunction->registeredIndex	= INDEX_NONE;
+		tickFunction->scheduledList		= nullptr;
+		tickFunction->scheduledIndex	= INDEX_NONE;
+	}
+
+	tickFunctions.clear();
+	for ( uint32 index = 0; index < TG_NumGroups; ++index )
+	{
+		tickLevels[ index ].clear();
+	}
+	bScheduleDirty = false;
+}
+
+/**
+ * Calculate level of tick function in group
+ */
+uint32 CTickTaskManager::CalcTickLevel( CTickFunction* InTickFunction )
+{
+	// Tick function already visited, if its level isn't calculated yet we found cycle
+	if ( InTickFunction->visitMark == currentVisitMark )
+	{
+		if ( InTickFunction->tickLevel == ( uint32 )INDEX_NONE )
+		{
+			LE_LOG( LT_Warning, LC_General, TEXT( "Found cycle in tick prerequisites, it will be broken" ) );
+			return 0;
+		}
+		return InTickFunction->tickLevel;
+	}
+
+	InTickFunction->visitMark	= currentVisitMark;
+	InTickFunction->tickLevel	= INDEX_NONE;
+
+	uint32		tickLevel = 0;
+	for ( uint32 index = 0, count = ( uint32 )InTickFunction->prerequisites.size(); index < count; ++index )
+	{
+		// Prerequisites from earlier groups are already ticked, from later groups can't be satisfied
+		CTickFunction*		prerequisite = InTickFunction->prerequisites[ index ];
+		if ( prerequisite->tickTaskManager != this || prerequisite->tickGroup != InTickFunction->tickGroup )
+		{
+			continue;
+		}
+
+		tickLevel = Max( tickLevel, CalcTickLevel( prerequisite ) + 1 );
+	}
+
+	InTickFunction->tickLevel = tickLevel;
+	return tickLevel;
+}
+
+/**
+ * Rebuild levels of all tick groups
+ */
+void CTickTaskManager::RebuildSchedule()
+{
+	for ( uint32 index = 0; index < TG_NumGroups; ++index )
+	{
+		tickLevels[ index ].clear();
+	}
+
+	// Dormant tick functions aren't scheduled
+	++currentVisitMark;
+	stats.numDormant = 0;
+	for ( uint32 index = 0, count = ( uint32 )tickFunctions.size(); index < count; ++index )
+	{
+		CTickFunction*		tickFunction = tickFunctions[ index ];
+		tickFunction->scheduledList		= nullptr;
+		tickFunction->scheduledIndex	= INDEX_NONE;
+		if ( !tickFunction->bTickEnabled )
+		{
+			++stats.numDormant;
+			continue;
+		}
+
+		uint32				tickLevel = CalcTickLevel( tickFunction );
+
+		std::vector<STickLevel>&	groupLevels = tickLevels[ tickFunction->tickGroup ];
+		if ( groupLevels.size() <= tickLevel )
+		{
+			groupLevels.resize( tickLevel + 1 );
+		}
+
+		std::vector<CTickFunction*>&	scheduledList = tickFunction->bTickInParallel ? groupLevels[ tickLevel ].parallelFunctions : groupLevels[ tickLevel ].serialFunctions;
+		scheduledList.push_back( tickFunction );
+	}
+
+	// Save positions in schedule after all lists are filled, before that lists may be reallocated
+	for ( uint32 groupIndex = 0; groupIndex < TG_NumGroups; ++groupIndex )
+	{
+		for ( uint32 levelIndex = 0, numLevels = ( uint32 )tickLevels[ groupIndex ].size(); levelIndex < numLevels; ++levelIndex )
+		{
+			STickLevel&		level = tickLevels[ groupIndex ][ levelIndex ];
+			for ( uint32 index = 0, count = ( uint32 )level.parallelFunctions.size(); index < count; ++index )
+			{
+				level.parallelFunctions[ index ]->scheduledList		= &level.parallelFunctions;
+				level.parallelFunctions[ index ]->scheduledIndex	= index;
+			}
+
+			for ( uint32 index = 0, count = ( uint32 )level.serialFunctions.size(); index < count; ++index )
+			{
+				level.serialFunctions[ index ]->scheduledList		= &level.serialFunctions;
+				level.serialFunctions[ index ]->scheduledIndex		= index;
+			}
+		}
+	}
+
+	bScheduleDirty = false;
+}
+
+/**
+ * Begin new frame
+ */
+void CTickTaskManager::BeginFrame()
+{
+	if ( bScheduleDirty )
+	{
+		RebuildSchedule();
+	}
+
+	stats.numRegistered		= ( uint32 )tickFunctions.size();
+	stats.numTicked			= 0;
+	stats.numSkipped		= 0;
+}
+
+/**
+ * Execute tick function if it is enabled and its interval is elapsed
+ */
+void CTickTaskManager::ExecuteTickFunction( CTickFunction* InTickFunction, float InDeltaTime )
+{
+	// Tick function may be disabled during this frame, before rebuild of schedule
+	if ( !InTickFunction || !InTickFunction->bTickEnabled )
+	{
+		return;
+	}
+
+	// Accumulate time while interval isn't elapsed, each tick function is ticked only by one thread so it is safe
+	float		tickInterval = Max( InTickFunction->tickInterval, InTickFunction->throttleInterval );
+	if ( tickInterval > 0.f )
+	{
+		InTickFunction->accumulatedTime += InDeltaTime;
+		if ( InTickFunction->accumulatedTime < tickInterval )
+		{
+			appInterlockedIncrement( &stats.numSkipped );
+			return;
+		}
+
+		InDeltaTime							= InTickFunction->accumulatedTime;
+		InTickFunction->accumulatedTime		= 0.f;
+	}
+
+	appInterlockedIncrement( &stats.numTicked );
+	InTickFunction->ExecuteTick( InDeltaTime );
+}
+
+/**
+ * Tick all functions in tick group
+ */
+void CTickTaskManager::RunTickGroup( ETickingGroup InTickGroup, float InDeltaTime )
+{
+	check( InTickGroup < TG_NumGroups );
+	if ( bScheduleDirty )
+	{
+		RebuildSchedule();
+	}
+
+	// New tick functions registered during tick will be ticked from next group
+	std::vector<STickLevel>&	groupLevels = tickLevels[ InTickGroup ];
+	bool						bTickParallel = CVarTickParallel.GetValueBool();
+	for ( uint32 levelIndex = 0, numLevels = ( uint32 )groupLevels.size(); levelIndex < numLevels; ++levelIndex )
+	{
+		STickLevel&		level = groupLevels[ levelIndex ];
+
+		// Tick thread-safe functions on thread pool
+		std::vector<CTickFunction*>&	parallelFunctions = level.parallelFunctions;
+		if ( bTickParallel )
+		{
+			GThreadPool.ParallelFor( ( uint32 )parallelFunctions.size(), [&]( uint32 InIndex )
+									 {
+										 ExecuteTickFunction( parallelFunctions[ InIndex ], InDeltaTime );
+									 } );
+		}
+		else
+		{
+			for ( uint32 index = 0; index < parallelFunctions.size(); ++index )
+			{
+				ExecuteTickFunction( parallelFunctions[ index ], InDeltaTime );
+			}
+		}
+
+		// Apply changes from parallel ticks before serial functions of this level
+		FlushDeferredCommands();
+
+		// Tick other functions on game thread
+		for ( uint32 index = 0; index < level.serialFunctions.size(); ++index )
+		{
+			ExecuteTickFunction( level.serialFunctions[ index ], InDeltaTime );
+		}
+		FlushDeferredCommands();
+	}
+}
+
+/**
+ * Enqueue command which will be executed on game thread after current tick level
+ */
+void CTickTaskManager::EnqueueDeferredCommand( const std::function<void()>& InCommand )
+{
+	CScopeLock		scopeLock( deferredCommandsCS );
+	deferredCommands.push_back( InCommand );
+}
+
+/**
+ * Execute all deferred commands
+ */
+void CTickTaskManager::FlushDeferredCommands()
+{
+	std::vector<std::function<void()>>		commands;
+	{
+		CScopeLock		scopeLock( deferredCommandsCS );
+		if ( deferredCommands.empty() )
+		{
+			return;
+		}
+		std::swap( commands, deferredCommands );
+	}
+
+	for ( uint32 index = 0, count = ( uint32 )commands.size(); index < count; ++index )
+	{
+		commands[ index ]();
+	}
+}
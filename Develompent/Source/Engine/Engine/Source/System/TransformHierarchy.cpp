@@ -0,0 +1,275 @@
+#include <algorithm>
+
+#include "Math/TransformBatch.h"
+#include "System/TransformHierarchy.h"
+#include "Components/SceneComponent.h"
+
+/**
+ * Global transform hierarchy
+ */
+CTransformHierarchy			GTransformHierarchy;
+
+/**
+ * Constructor
+ */
+CTransformHierarchy::CTransformHierarchy()
+	: bOrderDirty( false )
+{}
+
+/**
+ * Add transform of component
+ */
+uint32 CTransformHierarchy::AddTransform( class CSceneComponent* InComponent )
+{
+	check( InComponent );
+
+	// New transform hasn't parent, so it doesn't break order
+	uint32		index = ( uint32 )components.size();
+	components.push_back( InComponent );
+	parents.push_back( INDEX_NONE );
+	flags.push_back( TF_DirtyWorld | TF_DirtyMatrix | TF_Moved );
+	worldLocations.push_back( SMath::vectorZero );
+	worldRotations.push_back( SMath::quaternionZero );
+	worldScales.push_back( SMath::vectorOne );
+	worldMatrices.push_back( SMath::matrixIdentity );
+	return index;
+}
+
+/**
+ * Remove transform of component
+ */
+void CTransformHierarchy::RemoveTransform( uint32 InIndex )
+{
+	check( InIndex < components.size() );
+
+	// Children of removed transform become roots
+	const std::vector<CSceneComponent*>&	children = components[ InIndex ]->GetAttachChildren();
+	for ( uint32 index = 0, count = ( uint32 )children.size(); index < count; ++index )
+	{
+		parents[ children[ index ]->GetTransformIndex() ] = INDEX_NONE;
+	}
+
+	// Move last transform to free place, after that fix links to it
+	uint32		lastIndex = ( uint32 )components.size() - 1;
+	if ( InIndex != lastIndex )
+	{
+		CSceneComponent*		movedComponent = components[ lastIndex ];
+		components[ InIndex ]		= movedComponent;
+		parents[ InIndex ]			= parents[ lastIndex ];
+		flags[ InIndex ]			= flags[ lastIndex ];
+		worldLocations[ InIndex ]	= worldLocations[ lastIndex ];
+		worldRotations[ InIndex ]	= worldRotations[ lastIndex ];
+		worldScales[ InIndex ]		= worldScales[ lastIndex ];
+		worldMatrices[ InIndex ]	= worldMatrices[ lastIndex ];
+		movedComponent->SetTransformIndex( InIndex );
+
+		const std::vector<CSceneComponent*>&	movedChildren = movedComponent->GetAttachChildren();
+		for ( uint32 index = 0, count = ( uint32 )movedChildren.size(); index < count; ++index )
+		{
+			parents[ movedChildren[ index ]->GetTransformIndex() ] = InIndex;
+		}
+
+		// Moved transform may be before its parent now
+		bOrderDirty = true;
+	}
+
+	components.pop_back();
+	parents.pop_back();
+	flags.pop_back();
+	worldLocations.pop_back();
+	worldRotations.pop_back();
+	worldScales.pop_back();
+	worldMatrices.pop_back();
+}
+
+/**
+ * Set parent of transform
+ */
+void CTransformHierarchy::SetParent( uint32 InIndex, uint32 InParentIndex )
+{
+	check( InIndex < components.size() && ( InParentIndex == INDEX_NONE || InParentIndex < components.size() ) );
+	parents[ InIndex ]	= InParentIndex;
+	bOrderDirty			= true;
+
+	// Clear dirty flag for force propagation to children
+	flags[ InIndex ] &= ~TF_DirtyWorld;
+	MarkDirty( InIndex );
+}
+
+/**
+ * Mark world transform of component and all its children dirty
+ */
+void CTransformHierarchy::MarkDirty( uint32 InIndex )
+{
+	check( InIndex < flags.size() );
+
+	// Children of dirty transform are dirty too, because clean child always has clean parent
+	if ( flags[ InIndex ] & TF_DirtyWorld )
+	{
+		return;
+	}
+
+	flags[ InIndex ] |= TF_DirtyWorld | TF_DirtyMatrix | TF_Moved;
+	const std::vector<CSceneComponent*>&	children = components[ InIndex ]->GetAttachChildren();
+	for ( uint32 index = 0, count = ( uint32 )children.size(); index < count; ++index )
+	{
+		MarkDirty( children[ index ]->GetTransformIndex() );
+	}
+}
+
+/**
+ * Calculate world transform from parent and relative transform
+ */
+void CTransformHierarchy::CalcWorldTransform( uint32 InIndex )
+{
+	const CTransform&	relativeTransform = components[ InIndex ]->GetRelativeTransform();
+	uint32				parentIndex = parents[ InIndex ];
+	if ( parentIndex != INDEX_NONE )
+	{
+		// Same composition as CTransform::operator+
+		EnsureWorldTransform( parentIndex );
+		worldLocations[ InIndex ]	= worldLocations[ parentIndex ] + relativeTransform.GetLocation();
+		worldRotations[ InIndex ]	= relativeTransform.GetRotation() * worldRotations[ parentIndex ];
+		worldScales[ InIndex ]		= worldScales[ parentIndex ] * relativeTransform.GetScale();
+	}
+	else
+	{
+		worldLocations[ InIndex ]	= relativeTransform.GetLocation();
+		worldRotations[ InIndex ]	= relativeTransform.GetRotation();
+		worldScales[ InIndex ]		= relativeTransform.GetScale();
+	}
+
+	flags[ InIndex ] &= ~TF_DirtyWorld;
+}
+
+/**
+ * Calculate world matrix from world transform
+ */
+void CTransformHierarchy::CalcWorldMatrix( uint32 InIndex )
+{
+	SMathBatch::TransformsToMatricesScalar( &worldLocations[ InIndex ], &worldRotations[ InIndex ], &worldScales[ InIndex ], &worldMatrices[ InIndex ], 1 );
+	flags[ InIndex ] &= ~TF_DirtyMatrix;
+}
+
+/**
+ * Sort transforms by depth of attachment
+ */
+void CTransformHierarchy::SortByDepth()
+{
+	uint32					numTransforms = ( uint32 )components.size();
+	std::vector<uint32>		depths( numTransforms, INDEX_NONE );
+	std::vector<uint32>		order( numTransforms );
+	for ( uint32 index = 0; index < numTransforms; ++index )
+	{
+		// Walk up to first transform with known depth
+		uint32		depth = 0;
+		for ( uint32 parentIndex = parents[ index ]; parentIndex != INDEX_NONE; parentIndex = parents[ parentIndex ] )
+		{
+			if ( depths[ parentIndex ] != INDEX_NONE )
+			{
+				depth += depths[ parentIndex ] + 1;
+				break;
+			}
+			++depth;
+		}
+
+		depths[ index ] = depth;
+		order[ index ]	= index;
+	}
+
+	std::stable_sort( order.begin(), order.end(), [&]( uint32 InA, uint32 InB )
+					  {
+						  return depths[ InA ] < depths[ InB ];
+					  } );
+
+	// Remap old indices to new ones
+	std::vector<uint32>		newIndices( numTransforms );
+	for ( uint32 index = 0; index < numTransforms; ++index )
+	{
+		newIndices[ order[ index ] ] = index;
+	}
+
+	std::vector<CSceneComponent*>		newComponents( numTransforms );
+	std::vector<uint32>					newParents( numTransforms );
+	std::vector<uint8>					newFlags( numTransforms );
+	std::vector<Vector>					newWorldLocations( numTransforms );
+	std::vector<Quaternion>				newWorldRotations( numTransforms );
+	std::vector<Vector>					newWorldScales( numTransforms );
+	std::vector<Matrix>					newWorldMatrices( numTransforms );
+	for ( uint32 index = 0; index < numTransforms; ++index )
+	{
+		uint32		oldIndex = order[ index ];
+		uint32		oldParent = parents[ oldIndex ];
+		newComponents[ index ]		= components[ oldIndex ];
+		newParents[ index ]			= oldParent != INDEX_NONE ? newIndices[ oldParent ] : INDEX_NONE;
+		newFlags[ index ]			= flags[ oldIndex ];
+		newWorldLocations[ index ]	= worldLocations[ oldIndex ];
+		newWorldRotations[ index ]	= worldRotations[ oldIndex ];
+		newWorldScales[ index ]		= worldScales[ oldIndex ];
+		newWorldMatrices[ index ]	= worldMatrices[ oldIndex ];
+		newComponents[ index ]->SetTransformIndex( index );
+	}
+
+	components.swap( newComponents );
+	parents.swap( newParents );
+	flags.swap( newFlags );
+	worldLocations.swap( newWorldLocations );
+	worldRotations.swap( newWorldRotations );
+	worldScales.swap( newWorldScales );
+	worldMatrices.swap( newWorldMatrices );
+	bOrderDirty = false;
+}
+
+/**
+ * Recalculate all dirty transforms and notify moved components
+ */
+void CTransformHierarchy::Update()
+{
+	if ( bOrderDirty )
+	{
+		SortByDepth();
+	}
+
+	// Parents precede children, so parent is always up to date when we reach child.
+	// Matrices are converted in batches for each continuous range of dirty matrices
+	uint32		matrixRangeStart = INDEX_NONE;
+	for ( uint32 index = 0, count = ( uint32 )flags.size(); index < count; ++index )
+	{
+		uint8		transformFlags = flags[ index ];
+		if ( transformFlags & TF_DirtyWorld )
+		{
+			CalcWorldTransform( index );
+		}
+
+		if ( transformFlags & TF_DirtyMatrix )
+		{
+			if ( matrixRangeStart == INDEX_NONE )
+			{
+				matrixRangeStart = index;
+			}
+		}
+		else if ( matrixRangeStart != INDEX_NONE )
+		{
+			SMathBatch::TransformsToMatrices( &worldLocations[ matrixRangeStart ], &worldRotations[ matrixRangeStart ], &worldScales[ matrixRangeStart ], &worldMatrices[ matrixRangeStart ], index - matrixRangeStart );
+			matrixRangeStart = INDEX_NONE;
+		}
+
+		if ( transformFlags & TF_Moved )
+		{
+			movedComponents.push_back( components[ index ] );
+		}
+		flags[ index ] = TF_None;
+	}
+
+	if ( matrixRangeStart != INDEX_NONE )
+	{
+		SMathBatch::TransformsToMatrices( &worldLocations[ matrixRangeStart ], &worldRotations[ matrixRangeStart ], &worldScales[ matrixRangeStart ], &worldMatrices[ matrixRangeStart ], ( uint32 )flags.size() - matrixRangeStart );
+	}
+
+	// Notify after all transforms are updated, listeners may read transforms of other components
+	for ( uint32 index = 0, count = ( uint32 )movedComponents.size(); index < count; ++index )
+	{
+		movedComponents[ index ]->OnTransformChanged();
+	}
+	movedComponents.clear();
+}
@@ -1,13 +1,17 @@
 #include "Misc/CoreGlobals.h"
 #include "Misc/EngineGlobals.h"
 #include "Misc/PhysicsGlobals.h"
+#include "System/PhysicsEngine.h"
 #include "System/CameraManager.h"
 #include "System/Package.h"
 #include "PhysicsInterface.h"
 #include "Actors/Actor.h"
 #include "System/World.h"
+#include "System/TransformHierarchy.h"
 #include "Logger/LoggerMacros.h"
 #include "Render/Scene.h"
+#include "System/Malloc.h"
+#include "System/MemoryArchive.h"
 
 #if WITH_EDITOR
 #include "WorldEd.h"
@@ -16,6 +20,7 @@
 CWorld::CWorld() 
 	: isBeginPlay( false )
 	, scene( new CScene() )
+	, worldPartition( this )
 #if WITH_EDITOR
 	, name( TEXT( "Unknown" ) )
 #endif // WITH_EDITOR
@@ -35,20 +40,48 @@ void CWorld::BeginPlay()
 		return;
 	}
 
+	// Settings of tick throttling are loaded on begin play, because world is created before config is loaded
+	SSignificanceSettings		significanceSettings;
+	significanceSettings.LoadFromConfig();
+	significanceManager.ApplySettings( significanceSettings );
+
+	// Create actors for pools before gameplay, so first spawns don't construct them
+	actorPool.LoadFromConfig();
+	actorPool.Prewarm();
+
+	SWorldPartitionSettings		worldPartitionSettings;
+	worldPartitionSettings.LoadFromConfig();
+	worldPartition.ApplySettings( worldPartitionSettings );
+
 	// Init all actors
-	for ( uint32 index = 0; index < ( uint32 )actors.size(); ++index )
+	for ( uint32 index = 0; index < ( uint32 )actors.Num(); ++index )
 	{
 		actors[ index ]->BeginPlay();
 	}
 
 	// Init all physics in actors
-	for ( uint32 index = 0; index < actors.size(); ++index )
+	for ( uint32 index = 0; index < actors.Num(); ++index )
 	{
 		actors[ index ]->InitPhysics();
 	}
 
+	// Static actors don't need tick in game
+	if ( significanceSettings.bStaticActorsDormant )
+	{
+		for ( uint32 index = 0, count = ( uint32 )actors.Num(); index < count; ++index )
+		{
+			if ( actors[ index ]->IsStatic() )
+			{
+				actors[ index ]->SetTickDormantByWorld( true );
+			}
+		}
+	}
+
 	GCameraManager->BeginPlay();
 	isBeginPlay = true;
+
+	// Cells around player are loaded without budgets, so first frames don't show empty world
+	worldPartition.FlushStreaming();
 }
 
 void CWorld::EndPlay()
@@ -59,36 +92,59 @@ void CWorld::EndPlay()
 		return;
 	}
 
+	// Actors which wait for destroy must be removed while they are playing
+	FlushActorsToDestroy();
+
 	// End play and destroy physics for all actors
-	for ( uint32 index = 0; index < ( uint32 ) actors.size(); ++index )
+	for ( uint32 index = 0; index < ( uint32 ) actors.Num(); ++index )
 	{
 		ActorRef_t		actor = actors[ index ];
 		actor->EndPlay();
 		actor->TermPhysics();
+		actor->SetTickDormantByWorld( false );
 	}
 
 	GCameraManager->EndPlay();
+	actorPool.Empty();
 	isBeginPlay = false;
 }
 
 void CWorld::Tick( float InDeltaTime )
 {
-	// Tick all actors
-	for ( uint32 index = 0, count = ( uint32 )actors.size(); index < count; ++index )
+	SCOPED_MEMORY_TAG( MTAG_World );
+
+	// Rebuild schedule if need and update tick intervals of far actors
+	tickTaskManager.BeginFrame();
+	significanceManager.Update( actors.GetElements(), InDeltaTime );
+
+	// Tick actors and components before physics
+	tickTaskManager.RunTickGroup( TG_PrePhysics, InDeltaTime );
+
+	// Simulate physics, after that tick group which doesn't depend on results of simulation.
+	// Before it update world transforms, so physics bodies of moved components are teleported
+	GTransformHierarchy.Update();
+	GPhysicsEngine.Tick( InDeltaTime );
+	tickTaskManager.RunTickGroup( TG_DuringPhysics, InDeltaTime );
+
+	// Apply results of simulation to actors
+	for ( uint32 index = 0, count = ( uint32 )actors.Num(); index < count; ++index )
 	{
-		AActor*		actor = actors[ index ];
-		actor->Tick( InDeltaTime );
-		actor->SyncPhysics();
+		actors[ index ]->SyncPhysics();
 	}
 
-	// Destroy actors if need
+	tickTaskManager.RunTickGroup( TG_PostPhysics, InDeltaTime );
+	tickTaskManager.RunTickGroup( TG_PostUpdateWork, InDeltaTime );
+
+	// Stream cells of world partition around camera, spawned actors are ticked from next frame
+	worldPartition.Update( InDeltaTime );
+
+	// Update world transforms of all moved components once before rendering
+	GTransformHierarchy.Update();
+
+	// Destroy actors if need. All ticks are finished here, so it's safe point for removing actors
 	if ( !actorsToDestroy.empty() )
 	{
-		for ( uint32 index = 0, count = actorsToDestroy.size(); index < count; ++index )
-		{
-			DestroyActor( actorsToDestroy[ index ], true );
-		}
-		actorsToDestroy.clear();
+		FlushActorsToDestroy();
 	}
 }
 
@@ -96,34 +152,28 @@ void CWorld::Serialize( CArchive& InArchive )
 {
 	if ( InArchive.IsSaving() )
 	{
-		InArchive << ( uint32 )actors.size();
-		for ( uint32 index = 0, count = ( uint32 )actors.size(); index < count; ++index )
-		{
-			AActor*			actor = actors[ index ];
-			InArchive << actor->GetClass()->GetName();
-			actor->Serialize( InArchive );
-		}
+		SaveActors( InArchive, actors.GetElements() );
 	}
 	else
 	{
 		// Clear world
 		CleanupWorld();
+		LoadActors( InArchive );
+	}
 
-		uint32		countActors = 0;
-		InArchive << countActors;
-
-		for ( uint32 index = 0; index < countActors; ++index )
-		{
-			// Serialize class name
-			uint32				classNameSize = 0;
-			std::wstring		className;
-			InArchive << className;
+	// Actors of partition cells are after always loaded actors
+	if ( InArchive.Ver() >= VER_WorldPartition )
+	{
+		worldPartition.Serialize( InArchive );
+	}
 
-			// Spawn actor, serialize and add to array
-			AActor*			actor = SpawnActor( CClass::StaticFindClass( className.c_str() ), SMath::vectorZero, SMath::quaternionZero );
-			actor->Serialize( InArchive );
-		}
+#if WITH_EDITOR
+	// In editor map is edited in whole, so all cells are loaded
+	if ( InArchive.IsLoading() && GIsEditor && !GIsCommandlet )
+	{
+		worldPartition.LoadAllCells();
 	}
+#endif // WITH_EDITOR
 
 #if WITH_EDITOR
 	// Getting path and file name
@@ -148,6 +198,142 @@ void CWorld::Serialize( CArchive& InArchive )
 #endif // WITH_EDITOR
 }
 
+void CWorld::SaveActors( CArchive& InArchive, const std::vector<ActorRef_t>& InActors )
+{
+	// Old format, each actor has name of class
+	uint32		numActors = ( uint32 )InActors.size();
+	if ( InArchive.Ver() < VER_WorldClassTable )
+	{
+		InArchive << numActors;
+		for ( uint32 index = 0; index < numActors; ++index )
+		{
+			AActor*			actor = InActors[ index ];
+			InArchive << actor->GetClass()->GetName();
+			actor->Serialize( InArchive );
+		}
+		return;
+	}
+
+	// Build table of classes and index of class for each actor
+	std::vector<CClass*>						classes;
+	std::unordered_map<CClass*, uint32>			classToIndex;
+	std::vector<uint32>							classIndices( numActors );
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		CClass*		actorClass = InActors[ index ]->GetClass();
+		auto		itClass = classToIndex.find( actorClass );
+		if ( itClass == classToIndex.end() )
+		{
+			itClass = classToIndex.insert( std::make_pair( actorClass, ( uint32 )classes.size() ) ).first;
+			classes.push_back( actorClass );
+		}
+		classIndices[ index ] = itClass->second;
+	}
+
+	// Data of all actors is written into one blob, so on loading it's read by one call
+	CMemoryArchiveWriter		actorsData( InArchive.Ver(), InArchive.Type() );
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		InActors[ index ]->Serialize( actorsData );
+	}
+
+	InArchive << ( uint32 )classes.size();
+	for ( uint32 index = 0, count = ( uint32 )classes.size(); index < count; ++index )
+	{
+		InArchive << classes[ index ]->GetName();
+	}
+
+	InArchive << numActors;
+	if ( numActors > 0 )
+	{
+		InArchive.Serialize( classIndices.data(), numActors * sizeof( uint32 ) );
+	}
+
+	uint32		actorsDataSize = actorsData.GetSize();
+	InArchive << actorsDataSize;
+	if ( actorsDataSize > 0 )
+	{
+		InArchive.Serialize( ( void* )actorsData.GetData().data(), actorsDataSize );
+	}
+}
+
+void CWorld::LoadActors( CArchive& InArchive, std::vector<ActorRef_t>* OutActors /* = nullptr */ )
+{
+	// Old format, each actor has name of class
+	if ( InArchive.Ver() < VER_WorldClassTable )
+	{
+		uint32		countActors = 0;
+		InArchive << countActors;
+
+		for ( uint32 index = 0; index < countActors; ++index )
+		{
+			// Serialize class name
+			std::wstring		className;
+			InArchive << className;
+
+			// Spawn actor, serialize and add to array
+			AActor*			actor = SpawnActor( CClass::StaticFindClass( className.c_str() ), SMath::vectorZero, SMath::quaternionZero );
+			actor->Serialize( InArchive );
+			if ( OutActors )
+			{
+				OutActors->push_back( actor );
+			}
+		}
+		return;
+	}
+
+	// Each class is found only once
+	uint32		numClasses = 0;
+	InArchive << numClasses;
+
+	std::vector<CClass*>		classes( numClasses );
+	for ( uint32 index = 0; index < numClasses; ++index )
+	{
+		std::wstring		className;
+		InArchive << className;
+		classes[ index ] = CClass::StaticFindClass( className.c_str() );
+		checkMsg( classes[ index ], TEXT( "Class '%s' not found" ), className.c_str() );
+	}
+
+	uint32		numActors = 0;
+	InArchive << numActors;
+
+	std::vector<uint32>			classIndices( numActors );
+	if ( numActors > 0 )
+	{
+		InArchive.Serialize( classIndices.data(), numActors * sizeof( uint32 ) );
+	}
+
+	uint32		actorsDataSize = 0;
+	InArchive << actorsDataSize;
+
+	std::vector<byte>			actorsData( actorsDataSize );
+	if ( actorsDataSize > 0 )
+	{
+		InArchive.Serialize( actorsData.data(), actorsDataSize );
+	}
+
+	// Spawn actors and serialize them from memory
+	actors.Reserve( actors.Num() + numActors );
+	if ( OutActors )
+	{
+		OutActors->reserve( OutActors->size() + numActors );
+	}
+
+	CMemoryArchiveReading		actorsDataArchive( actorsData.data(), actorsDataSize, InArchive.Ver(), InArchive.Type() );
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		check( classIndices[ index ] < numClasses );
+		ActorRef_t		actor = SpawnActor( classes[ classIndices[ index ] ], SMath::vectorZero, SMath::quaternionZero );
+		actor->Serialize( actorsDataArchive );
+		if ( OutActors )
+		{
+			OutActors->push_back( actor );
+		}
+	}
+	check( actorsDataArchive.IsEndOfFile() );
+}
+
 void CWorld::CleanupWorld()
 {
 	// If we playing, end it
@@ -157,22 +343,25 @@ void CWorld::CleanupWorld()
 	}
 
 	// Call event of destroyed actor in each object
-	for ( uint32 index = 0, count = actors.size(); index < count; ++index )
+	for ( uint32 index = 0, count = actors.Num(); index < count; ++index )
 	{
 		actors[ index ]->Destroyed();
+		actors[ index ]->SetActorHandle( ActorHandle_t() );
 	}
 
 	// Broadcast event of destroyed actors
 #if WITH_EDITOR
-	if ( !actors.empty() )
+	if ( !actors.IsEmpty() )
 	{
-		SEditorDelegates::onActorsDestroyed.Broadcast( actors );
+		SEditorDelegates::onActorsDestroyed.Broadcast( actors.GetElements() );
 	}
 #endif // WITH_EDITOR
 
+	tickTaskManager.UnregisterAllTickFunctions();
 	GPhysicsScene.RemoveAllBodies();
+	worldPartition.Clear();
 	scene->Clear();
-	actors.clear();
+	actors.Empty();
 	actorsToDestroy.clear();
 
 #if WITH_EDITOR
@@ -187,13 +376,23 @@ ActorRef_t CWorld::SpawnActor( class CClass* InClass, const Vector& InLocation,
 {
 	check( InClass );
 
-	AActor*		actor = InClass->CreateObject< AActor >();
-	check( actor );
+	// Take actor from pool if it's possible, otherwise create new one
+	ActorRef_t		actor = isBeginPlay ? actorPool.Acquire( InClass ) : nullptr;
+	if ( actor )
+	{
+		actor->SetActorLocation( InLocation );
+		actor->SetActorRotation( InRotation );
+	}
+	else
+	{
+		actor = InClass->CreateObject< AActor >();
+		check( actor );
 
-	// Set default actor name and location with rotation
-	actor->SetName( InClass->GetName().c_str() );
-    actor->AddActorLocation( InLocation );
-    actor->AddActorRotation( InRotation );
+		// Set default actor name and location with rotation
+		actor->SetName( InClass->GetName().c_str() );
+		actor->AddActorLocation( InLocation );
+		actor->AddActorRotation( InRotation );
+	}
 
 	// Call event of spawn actor
 	actor->Spawned();
@@ -203,9 +402,14 @@ ActorRef_t CWorld::SpawnActor( class CClass* InClass, const Vector& InLocation,
 	{
 		actor->BeginPlay();
 		actor->InitPhysics();
+		if ( actor->IsStatic() && significanceManager.GetSettings().bStaticActorsDormant )
+		{
+			actor->SetTickDormantByWorld( true );
+		}
 	}
 
-	actors.push_back( actor );
+	actor->SetActorHandle( actors.Add( actor ) );
+	actor->RegisterTickFunctions( &tickTaskManager );
 	
 	// Broadcast event of spawned actor
 #if WITH_EDITOR
@@ -217,25 +421,29 @@ ActorRef_t CWorld::SpawnActor( class CClass* InClass, const Vector& InLocation,
 	return actor;
 }
 
-void CWorld::DestroyActor( ActorRef_t InActor, bool InIsIgnorePlaying )
+void CWorld::DestroyActor( ActorRef_t InActor )
 {
 	check( InActor );
 
-	// If actor allready penging kill, exit from method
-	if ( InActor->IsPendingKill() )
+	// If actor allready penging kill or not in this world, exit from method
+	if ( InActor->IsPendingKill() || !actors.IsValid( InActor->GetActorHandle() ) )
 	{
 		return;
 	}
+	InActor->MarkPendingKill();
 
 	// If world in play, put this actor to actorsToDestroy for remove after tick
-	if ( !InIsIgnorePlaying && InActor->IsPlaying() )
+	if ( InActor->IsPlaying() )
 	{
 		actorsToDestroy.push_back( InActor );
 		return;
 	}
 
-	// Destroy actor
+	RemoveActor( InActor );
+}
 
+void CWorld::RemoveActor( ActorRef_t InActor )
+{
 	// Broadcast event of destroy actor
 #if WITH_EDITOR
 	// Unselect actor if him is selected
@@ -249,24 +457,35 @@ void CWorld::DestroyActor( ActorRef_t InActor, bool InIsIgnorePlaying )
 	bDirty = true;
 #endif // WITH_EDITOR
 
-	// Call events of destroyed actor
+	// Call events of destroyed actor and stop ticking it
 	InActor->Destroyed();
+	InActor->UnregisterTickFunctions();
+
+	// Remove actor from world, last actor takes its place
+	actors.Remove( InActor->GetActorHandle() );
+	InActor->SetActorHandle( ActorHandle_t() );
 
-	// Remove actor from array of all actors in world
-	for ( uint32 index = 0, count = actors.size(); index < count; ++index )
+	// In game actor may be kept for next spawn
+	if ( isBeginPlay )
 	{
-		if ( actors[ index ] == InActor )
-		{
-			actors.erase( actors.begin() + index );
-			break;
-		}
+		actorPool.Release( InActor );
+	}
+}
+
+void CWorld::FlushActorsToDestroy()
+{
+	// Events of destroy may destroy other actors, so size of queue may change while iterating
+	for ( uint32 index = 0; index < ( uint32 )actorsToDestroy.size(); ++index )
+	{
+		RemoveActor( actorsToDestroy[ index ] );
 	}
+	actorsToDestroy.clear();
 }
 
 #if ENABLE_HITPROXY
 void CWorld::UpdateHitProxiesId()
 {
-	for ( uint32 index = 0, count = actors.size(); index < count; ++index )
+	for ( uint32 index = 0, count = actors.Num(); index < count; ++index )
 	{
 		actors[ index ]->SetHitProxyId( index+1 );
 	}
@@ -0,0 +1,725 @@
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "System/Config.h"
+#include "System/BaseFileSystem.h"
+#include "System/ThreadingBase.h"
+#include "System/MemoryArchive.h"
+#include "System/CameraManager.h"
+#include "System/WorldPartition.h"
+#include "System/World.h"
+#include "System/ConCmd.h"
+#include "Components/CameraComponent.h"
+#include "Components/SceneComponent.h"
+#include "Actors/Actor.h"
+#include "Actors/TileMap.h"
+
+/**
+ * Runnable of streaming thread, it reads cell data from map files by requests in queue
+ */
+class CWorldStreamingRunnable : public CRunnable
+{
+public:
+	/**
+	 * Constructor
+	 */
+	CWorldStreamingRunnable()
+		: requestEvent( GSynchronizeFactory->CreateSynchEvent( false, TEXT( "WorldStreamingRequest" ) ) )
+		, archive( nullptr )
+		, bIsStopping( false )
+	{
+		check( requestEvent );
+	}
+
+	/**
+	 * Destructor
+	 */
+	~CWorldStreamingRunnable()
+	{
+		GSynchronizeFactory->Destroy( requestEvent );
+	}
+
+	/**
+	 * Add request of loading to queue
+	 * @param InRequest		Request of loading
+	 */
+	void AddRequest( CWorldCellLoadRequest* InRequest )
+	{
+		{
+			CScopeLock		scopeLock( requestsCS );
+			requests.push_back( InRequest );
+		}
+		requestEvent->Trigger();
+	}
+
+	/**
+	 * Initialize
+	 */
+	virtual bool Init() override
+	{
+		return true;
+	}
+
+	/**
+	 * Run
+	 */
+	virtual uint32 Run() override
+	{
+		while ( !bIsStopping )
+		{
+			requestEvent->Wait();
+
+			// Process all queued requests, map file is kept open between requests to the same map
+			TRefCountPtr<CWorldCellLoadRequest>		request;
+			while ( !bIsStopping && PopRequest( request ) )
+			{
+				ProcessRequest( request );
+				request = nullptr;
+			}
+			CloseArchive();
+		}
+		return 0;
+	}
+
+	/**
+	 * Stop
+	 */
+	virtual void Stop() override
+	{
+		bIsStopping = true;
+		requestEvent->Trigger();
+	}
+
+	/**
+	 * Exit
+	 */
+	virtual void Exit() override
+	{
+		CloseArchive();
+	}
+
+private:
+	/**
+	 * Take first request from queue
+	 *
+	 * @param OutRequest	Output request
+	 * @return Return TRUE if request is taken, if queue is empty returns FALSE
+	 */
+	bool PopRequest( TRefCountPtr<CWorldCellLoadRequest>& OutRequest )
+	{
+		CScopeLock		scopeLock( requestsCS );
+		if ( requests.empty() )
+		{
+			return false;
+		}
+
+		OutRequest = requests.front();
+		requests.pop_front();
+		return true;
+	}
+
+	/**
+	 * Read cell data of request
+	 * @param InRequest		Request of loading
+	 */
+	void ProcessRequest( CWorldCellLoadRequest* InRequest )
+	{
+		// Request is dropped by world partition, only queue holds it
+		if ( InRequest->GetRefCount() == 1 )
+		{
+			return;
+		}
+
+		if ( !archive || archivePath != InRequest->path )
+		{
+			CloseArchive();
+			archive		= GFileSystem->CreateFileReader( InRequest->path );
+			archivePath = InRequest->path;
+		}
+
+		if ( archive )
+		{
+			InRequest->data.resize( InRequest->size );
+			archive->Seek( InRequest->offset );
+			archive->Serialize( InRequest->data.data(), InRequest->size );
+		}
+		else
+		{
+			InRequest->bFailed = true;
+		}
+
+		appInterlockedExchange( &InRequest->bCompleted, 1 );
+	}
+
+	/**
+	 * Close opened map file
+	 */
+	void CloseArchive()
+	{
+		if ( archive )
+		{
+			delete archive;
+			archive = nullptr;
+		}
+	}
+
+	CEvent*										requestEvent;	/**< Event triggered when request is added or thread is stopping */
+	CCriticalSection							requestsCS;		/**< Critical section of requests queue */
+	std::deque<TRefCountPtr<CWorldCellLoadRequest>>	requests;	/**< Queue of requests */
+	CArchive*									archive;		/**< Opened map file */
+	std::wstring								archivePath;	/**< Path to opened map file */
+	volatile bool								bIsStopping;	/**< Is need stop streaming thread */
+};
+
+/**
+ * Load settings from engine config
+ */
+void SWorldPartitionSettings::LoadFromConfig()
+{
+	CConfigValue		configEnable = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "Enable" ) );
+	if ( configEnable.IsA( CConfigValue::T_Bool ) )
+	{
+		bEnable = configEnable.GetBool();
+	}
+
+	CConfigValue		configCellSize = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "CellSize" ) );
+	if ( configCellSize.IsA( CConfigValue::T_Float ) || configCellSize.IsA( CConfigValue::T_Int ) )
+	{
+		cellSize = Max( configCellSize.GetNumber(), 1.f );
+	}
+
+	CConfigValue		configLoadRange = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "LoadRange" ) );
+	if ( configLoadRange.IsA( CConfigValue::T_Float ) || configLoadRange.IsA( CConfigValue::T_Int ) )
+	{
+		loadRange = Max( configLoadRange.GetNumber(), 0.f );
+	}
+
+	// Unload range less than load range will load and unload the same cells each frame
+	CConfigValue		configUnloadRange = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "UnloadRange" ) );
+	if ( configUnloadRange.IsA( CConfigValue::T_Float ) || configUnloadRange.IsA( CConfigValue::T_Int ) )
+	{
+		unloadRange = configUnloadRange.GetNumber();
+	}
+
+	if ( unloadRange < loadRange )
+	{
+		LE_LOG( LT_Warning, LC_General, TEXT( "Engine.WorldPartition: UnloadRange must be bigger than LoadRange" ) );
+		unloadRange = loadRange;
+	}
+
+	CConfigValue		configMemoryBudget = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "MemoryBudgetMB" ) );
+	if ( configMemoryBudget.IsA( CConfigValue::T_Int ) )
+	{
+		memoryBudget = Max( configMemoryBudget.GetInt(), 1 );
+	}
+
+	CConfigValue		configMaxConcurrentLoads = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "MaxConcurrentLoads" ) );
+	if ( configMaxConcurrentLoads.IsA( CConfigValue::T_Int ) )
+	{
+		maxConcurrentLoads = Max( configMaxConcurrentLoads.GetInt(), 1 );
+	}
+
+	CConfigValue		configMaxCellsSpawnedPerFrame = GConfig.GetValue( CT_Engine, TEXT( "Engine.WorldPartition" ), TEXT( "MaxCellsSpawnedPerFrame" ) );
+	if ( configMaxCellsSpawnedPerFrame.IsA( CConfigValue::T_Int ) )
+	{
+		maxCellsSpawnedPerFrame = Max( configMaxCellsSpawnedPerFrame.GetInt(), 1 );
+	}
+}
+
+/**
+ * Constructor
+ */
+CWorldPartition::CWorldPartition( class CWorld* InWorld )
+	: world( InWorld )
+	, cellSize( 0.f )
+	, mapVer( VER_PACKAGE_LATEST )
+	, streamingRunnable( nullptr )
+	, streamingThread( nullptr )
+{}
+
+/**
+ * Destructor
+ */
+CWorldPartition::~CWorldPartition()
+{
+	Clear();
+
+	// Stop streaming thread, not processed requests are dropped
+	if ( streamingThread )
+	{
+		streamingRunnable->Stop();
+		streamingThread->WaitForCompletion();
+		streamingThread->Kill();
+		GThreadFactory->Destroy( streamingThread );
+		delete streamingRunnable;
+	}
+}
+
+/**
+ * Apply settings
+ */
+void CWorldPartition::ApplySettings( const SWorldPartitionSettings& InSettings )
+{
+	settings = InSettings;
+}
+
+/**
+ * Split static actors of world into cells
+ */
+void CWorldPartition::Build()
+{
+	Clear();
+	cellSize = settings.cellSize;
+
+	// Dynamic actors (player start, controllers, etc) are always loaded, as well as tilemaps which cover whole map and cull own chunks
+	std::unordered_map<uint64, uint32>			cellIndices;
+	std::vector<std::vector<ActorRef_t>>		cellActors;
+	std::vector<ActorRef_t>						actors = world->GetActors();
+	for ( uint32 index = 0, count = ( uint32 )actors.size(); index < count; ++index )
+	{
+		ActorRef_t		actor = actors[ index ];
+		if ( !actor->IsStatic() || actor->IsA<ATileMap>() )
+		{
+			continue;
+		}
+
+		Vector		location = actor->GetActorLocation();
+		int32		x = ( int32 )SMath::Floor( location.x / cellSize );
+		int32		y = ( int32 )SMath::Floor( location.y / cellSize );
+		uint64		key = ( ( uint64 )( uint32 )x << 32 ) | ( uint32 )y;
+		auto		itCell = cellIndices.find( key );
+		if ( itCell == cellIndices.end() )
+		{
+			itCell = cellIndices.insert( std::make_pair( key, ( uint32 )cells.size() ) ).first;
+			cells.push_back( SCell() );
+			cells.back().x = x;
+			cells.back().y = y;
+			cellActors.push_back( std::vector<ActorRef_t>() );
+		}
+		cellActors[ itCell->second ].push_back( actor );
+	}
+
+	// Serialize actors of each cell and remove them from world
+	for ( uint32 index = 0, count = ( uint32 )cells.size(); index < count; ++index )
+	{
+		SCell&						cell = cells[ index ];
+		CMemoryArchiveWriter		cellArchive( VER_PACKAGE_LATEST, AT_World );
+		world->SaveActors( cellArchive, cellActors[ index ] );
+
+		cell.data			= cellArchive.GetData();
+		cell.dataSize		= ( uint32 )cell.data.size();
+		cell.numActors		= ( uint32 )cellActors[ index ].size();
+		for ( uint32 actorIndex = 0; actorIndex < cell.numActors; ++actorIndex )
+		{
+			world->DestroyActor( cellActors[ index ][ actorIndex ] );
+		}
+	}
+
+	stats.numCells = ( uint32 )cells.size();
+	LE_LOG( LT_Log, LC_General, TEXT( "World partition: %i static actors split into %i cells" ), ( uint32 )actors.size() - world->GetNumActors(), stats.numCells );
+}
+
+/**
+ * Serialize partition
+ */
+void CWorldPartition::Serialize( CArchive& InArchive )
+{
+	if ( InArchive.IsSaving() )
+	{
+		uint32		numCells = ( uint32 )cells.size();
+		InArchive << cellSize;
+		InArchive << numCells;
+		for ( uint32 index = 0; index < numCells; ++index )
+		{
+			const SCell&	cell = cells[ index ];
+			checkMsg( cell.data.size() == cell.dataSize, TEXT( "World partition may be saved only after Build()" ) );
+			InArchive << cell.x;
+			InArchive << cell.y;
+			InArchive << cell.numActors;
+			InArchive << cell.dataSize;
+		}
+
+		// Data of cells is after table, so loading reads only table
+		for ( uint32 index = 0; index < numCells; ++index )
+		{
+			InArchive.Serialize( cells[ index ].data.data(), cells[ index ].dataSize );
+		}
+	}
+	else
+	{
+		Clear();
+
+		uint32		numCells = 0;
+		InArchive << cellSize;
+		InArchive << numCells;
+
+		cells.resize( numCells );
+		for ( uint32 index = 0; index < numCells; ++index )
+		{
+			SCell&		cell = cells[ index ];
+			InArchive << cell.x;
+			InArchive << cell.y;
+			InArchive << cell.numActors;
+			InArchive << cell.dataSize;
+		}
+
+		// Remember where data of each cell is and skip it
+		uint32		offset = InArchive.Tell();
+		for ( uint32 index = 0; index < numCells; ++index )
+		{
+			cells[ index ].dataOffset = offset;
+			offset += cells[ index ].dataSize;
+		}
+		InArchive.Seek( offset );
+
+		mapPath			= InArchive.GetPath();
+		mapVer			= InArchive.Ver();
+		stats.numCells	= numCells;
+	}
+}
+
+/**
+ * Update streaming of cells
+ */
+void CWorldPartition::Update( float InDeltaTime )
+{
+	if ( cells.empty() )
+	{
+		return;
+	}
+
+	std::vector<Vector>		sourceLocations;
+	GetSourceLocations( sourceLocations );
+	if ( sourceLocations.empty() )
+	{
+		return;
+	}
+
+	// Cells sorted by distance, so the nearest are loaded first
+	std::vector<std::pair<float, uint32>>		cellsToLoad;
+	std::vector<std::pair<float, uint32>>		cellsToSpawn;
+	uint32										numLoadingCells = 0;
+	for ( uint32 index = 0, count = ( uint32 )cells.size(); index < count; ++index )
+	{
+		SCell&		cell = cells[ index ];
+		float		distance = GetDistanceToCell( cell, sourceLocations );
+
+		// Finish reading of cell
+		if ( cell.state == CS_Loading && cell.loadRequest->bCompleted )
+		{
+			if ( cell.loadRequest->bFailed )
+			{
+				LE_LOG( LT_Warning, LC_General, TEXT( "World partition: Failed to read cell (%i;%i) from '%s'" ), cell.x, cell.y, mapPath.c_str() );
+				stats.loadedMemory -= cell.dataSize;
+				cell.state = CS_Unloaded;
+			}
+			else
+			{
+				cell.data.swap( cell.loadRequest->data );
+				cell.state = CS_Loaded;
+			}
+			cell.loadRequest = nullptr;
+		}
+
+		if ( cell.state != CS_Unloaded && distance > settings.unloadRange )
+		{
+			UnloadCell( cell );
+		}
+		else if ( cell.state == CS_Unloaded && distance < settings.loadRange )
+		{
+			cellsToLoad.push_back( std::make_pair( distance, index ) );
+		}
+		else if ( cell.state == CS_Loaded )
+		{
+			cellsToSpawn.push_back( std::make_pair( distance, index ) );
+		}
+
+		if ( cell.state == CS_Loading )
+		{
+			++numLoadingCells;
+		}
+	}
+
+	// Start reading of new cells while it's allowed by budgets
+	std::sort( cellsToLoad.begin(), cellsToLoad.end() );
+	uint64		memoryBudget = ( uint64 )settings.memoryBudget * 1024 * 1024;
+	for ( uint32 index = 0, count = ( uint32 )cellsToLoad.size(); index < count && numLoadingCells < settings.maxConcurrentLoads; ++index )
+	{
+		SCell&		cell = cells[ cellsToLoad[ index ].second ];
+		if ( stats.loadedMemory + cell.dataSize > memoryBudget )
+		{
+			break;
+		}
+
+		StartLoadCell( cell );
+		++numLoadingCells;
+	}
+
+	// Spawn actors of read cells
+	std::sort( cellsToSpawn.begin(), cellsToSpawn.end() );
+	for ( uint32 index = 0, count = Min( ( uint32 )cellsToSpawn.size(), settings.maxCellsSpawnedPerFrame ); index < count; ++index )
+	{
+		SpawnCellActors( cells[ cellsToSpawn[ index ].second ] );
+	}
+}
+
+/**
+ * Load all cells around streaming sources and spawn their actors without budgets
+ */
+void CWorldPartition::FlushStreaming()
+{
+	std::vector<Vector>		sourceLocations;
+	GetSourceLocations( sourceLocations );
+	if ( sourceLocations.empty() )
+	{
+		return;
+	}
+
+	for ( uint32 index = 0, count = ( uint32 )cells.size(); index < count; ++index )
+	{
+		SCell&		cell = cells[ index ];
+		if ( cell.state != CS_Visible && GetDistanceToCell( cell, sourceLocations ) < settings.loadRange )
+		{
+			LoadCellSync( cell );
+			SpawnCellActors( cell );
+		}
+	}
+}
+
+/**
+ * Load all cells and spawn their actors, after that partition is removed
+ */
+void CWorldPartition::LoadAllCells()
+{
+	for ( uint32 index = 0, count = ( uint32 )cells.size(); index < count; ++index )
+	{
+		SCell&		cell = cells[ index ];
+		if ( cell.state != CS_Visible )
+		{
+			LoadCellSync( cell );
+			SpawnCellActors( cell );
+		}
+	}
+
+	// Actors of cells now are usual actors of world
+	Clear();
+}
+
+/**
+ * Remove all cells
+ */
+void CWorldPartition::Clear()
+{
+	// Active requests are owned by loading threads too, so they will be freed after reading
+	cells.clear();
+	streamingSources.clear();
+	mapPath.clear();
+	stats = SWorldPartitionStats();
+}
+
+/**
+ * Add streaming source
+ */
+void CWorldPartition::AddStreamingSource( class CSceneComponent* InSource )
+{
+	check( InSource );
+	streamingSources.push_back( InSource );
+}
+
+/**
+ * Remove streaming source
+ */
+void CWorldPartition::RemoveStreamingSource( class CSceneComponent* InSource )
+{
+	for ( uint32 index = 0, count = ( uint32 )streamingSources.size(); index < count; ++index )
+	{
+		if ( streamingSources[ index ] == InSource )
+		{
+			streamingSources.erase( streamingSources.begin() + index );
+			return;
+		}
+	}
+}
+
+/**
+ * Print statistics of partition into log
+ */
+void CWorldPartition::DumpStats() const
+{
+	if ( cells.empty() )
+	{
+		LE_LOG( LT_Log, LC_Console, TEXT( "World isn't partitioned" ) );
+		return;
+	}
+
+	LE_LOG( LT_Log, LC_Console, TEXT( "World partition: %u cells, %u visible, %u loading, cell size %.1f" ), stats.numCells, stats.numVisibleCells, stats.numLoadingCells, cellSize );
+	LE_LOG( LT_Log, LC_Console, TEXT( "World partition: %.2f / %u MB loaded, %u cells streamed in, %u streamed out" ), stats.loadedMemory / ( 1024.f * 1024.f ), settings.memoryBudget, stats.numStreamedIn, stats.numStreamedOut );
+}
+
+/**
+ * Get distance from nearest streaming source to cell
+ */
+float CWorldPartition::GetDistanceToCell( const SCell& InCell, const std::vector<Vector>& InSourceLocations ) const
+{
+	float		minX = InCell.x * cellSize;
+	float		minY = InCell.y * cellSize;
+	float		minDistanceSquared = FLT_MAX;
+	for ( uint32 index = 0, count = ( uint32 )InSourceLocations.size(); index < count; ++index )
+	{
+		// Distance from point to rectangle of cell, it's zero for point inside
+		const Vector&	location = InSourceLocations[ index ];
+		float			deltaX = Max( Max( minX - location.x, location.x - ( minX + cellSize ) ), 0.f );
+		float			deltaY = Max( Max( minY - location.y, location.y - ( minY + cellSize ) ), 0.f );
+		minDistanceSquared = Min( minDistanceSquared, deltaX * deltaX + deltaY * deltaY );
+	}
+	return SMath::Sqrt( minDistanceSquared );
+}
+
+/**
+ * Get locations of streaming sources
+ */
+void CWorldPartition::GetSourceLocations( std::vector<Vector>& OutLocations ) const
+{
+	for ( uint32 index = 0, count = ( uint32 )streamingSources.size(); index < count; ++index )
+	{
+		OutLocations.push_back( streamingSources[ index ]->GetComponentLocation() );
+	}
+
+	if ( OutLocations.empty() )
+	{
+		TRefCountPtr<CCameraComponent>		activeCamera = GCameraManager->GetActiveCamera();
+		if ( activeCamera )
+		{
+			OutLocations.push_back( activeCamera->GetComponentLocation() );
+		}
+	}
+}
+
+/**
+ * Start reading cell data in streaming thread
+ */
+void CWorldPartition::StartLoadCell( SCell& InCell )
+{
+	check( InCell.state == CS_Unloaded );
+	InCell.loadRequest			= new CWorldCellLoadRequest();
+	InCell.loadRequest->path	= mapPath;
+	InCell.loadRequest->offset	= InCell.dataOffset;
+	InCell.loadRequest->size	= InCell.dataSize;
+	InCell.state				= CS_Loading;
+	stats.loadedMemory			+= InCell.dataSize;
+	++stats.numLoadingCells;
+
+	// Streaming thread is created on first request and lives until partition is destroyed
+	if ( !streamingThread )
+	{
+		streamingRunnable	= new CWorldStreamingRunnable();
+		streamingThread		= GThreadFactory->CreateThread( streamingRunnable, TEXT( "WorldStreaming" ) );
+		check( streamingThread );
+	}
+	streamingRunnable->AddRequest( InCell.loadRequest );
+}
+
+/**
+ * Read cell data in current thread
+ */
+void CWorldPartition::LoadCellSync( SCell& InCell )
+{
+	if ( InCell.state == CS_Loaded )
+	{
+		return;
+	}
+
+	// Pending request is dropped, it's faster to read data again than wait for it
+	if ( InCell.state == CS_Unloaded )
+	{
+		stats.loadedMemory += InCell.dataSize;
+		++stats.numLoadingCells;
+	}
+	InCell.loadRequest	= nullptr;
+	InCell.state		= CS_Loaded;
+
+	CArchive*		archive = GFileSystem->CreateFileReader( mapPath );
+	if ( !archive )
+	{
+		LE_LOG( LT_Warning, LC_General, TEXT( "World partition: Failed to read cell (%i;%i) from '%s'" ), InCell.x, InCell.y, mapPath.c_str() );
+		InCell.data.clear();
+		return;
+	}
+
+	InCell.data.resize( InCell.dataSize );
+	archive->Seek( InCell.dataOffset );
+	archive->Serialize( InCell.data.data(), InCell.dataSize );
+	delete archive;
+}
+
+/**
+ * Spawn actors of loaded cell
+ */
+void CWorldPartition::SpawnCellActors( SCell& InCell )
+{
+	check( InCell.state == CS_Loaded );
+	if ( InCell.data.size() == InCell.dataSize )
+	{
+		std::vector<ActorRef_t>		spawnedActors;
+		CMemoryArchiveReading		cellArchive( InCell.data.data(), InCell.dataSize, mapVer, AT_World );
+		world->LoadActors( cellArchive, &spawnedActors );
+
+		InCell.actors.resize( spawnedActors.size() );
+		for ( uint32 index = 0, count = ( uint32 )spawnedActors.size(); index < count; ++index )
+		{
+			InCell.actors[ index ] = spawnedActors[ index ]->GetActorHandle();
+		}
+	}
+
+	// Data isn't needed anymore, free it
+	std::vector<byte>().swap( InCell.data );
+	InCell.state = CS_Visible;
+	--stats.numLoadingCells;
+	++stats.numVisibleCells;
+	++stats.numStreamedIn;
+}
+
+/**
+ * Destroy actors of cell
+ */
+void CWorldPartition::UnloadCell( SCell& InCell )
+{
+	// Actors may be destroyed by gameplay, their handles are stale
+	for ( uint32 index = 0, count = ( uint32 )InCell.actors.size(); index < count; ++index )
+	{
+		world->DestroyActor( InCell.actors[ index ] );
+	}
+
+	if ( InCell.state == CS_Visible )
+	{
+		--stats.numVisibleCells;
+		++stats.numStreamedOut;
+	}
+	else
+	{
+		--stats.numLoadingCells;
+	}
+
+	stats.loadedMemory -= InCell.dataSize;
+	InCell.actors.clear();
+	std::vector<byte>().swap( InCell.data );
+	InCell.loadRequest	= nullptr;
+	InCell.state		= CS_Unloaded;
+}
+
+/**
+ * Command 'partition.stats', print statistics of world partition
+ */
+static void CmdPartitionStats( const std::vector<std::wstring>& InArguments )
+{
+	GWorld->GetWorldPartition().DumpStats();
+}
+
+//
+// GLOBALS
+//
+CConCmd		CCmdPartitionStats( TEXT( "partition.stats" ), TEXT( "Print statistics of world partition streaming" ), &CmdPartitionStats );
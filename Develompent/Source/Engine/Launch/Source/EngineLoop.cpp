@@ -5,11 +5,14 @@
 #include "Misc/Misc.h"
 #include "Logger/LoggerMacros.h"
 #include "Logger/BaseLogger.h"
+#include "Logger/AsyncLogBackend.h"
+#include "System/MallocTracking.h"
 #include "System/Archive.h"
 #include "System/BaseFileSystem.h"
 #include "System/BaseWindow.h"
 #include "System/Config.h"
 #include "System/ThreadingBase.h"
+#include "System/ThreadPool.h"
 #include "System/InputSystem.h"
 #include "System/Package.h"
 #include "System/AudioEngine.h"
@@ -25,6 +28,7 @@
 #include "RHI/BaseDeviceContextRHI.h"
 #include "RHI/BaseSurfaceRHI.h"
 #include "Render/Shaders/ShaderManager.h"
+#include "Render/PipelineState.h"
 #include "UIEngine.h"
 #include "Misc/UIGlobals.h"
 #include "EngineLoop.h"
@@ -175,6 +179,22 @@ int32 CEngineLoop::PreInit( const tchar* InCmdLine )
 #endif // WITH_EDITOR
 
 	GLog->Init();
+
+	// Start asynchronous logging if it enabled in config
+	{
+		SAsyncLogSettings		asyncLogSettings;
+		asyncLogSettings.LoadFromConfig();
+		GAsyncLog.Start( asyncLogSettings );
+	}
+
+	// Apply settings of tracking allocator
+	if ( GMallocTracking )
+	{
+		SMallocTrackingSettings		mallocTrackingSettings;
+		mallocTrackingSettings.LoadFromConfig();
+		GMallocTracking->ApplySettings( mallocTrackingSettings );
+	}
+
 	int32		result = appPlatformPreInit();
 	
 	// Loading table of contents
@@ -260,9 +280,19 @@ int32 CEngineLoop::Init()
 	appSetSplashText( STT_StartupProgress, TEXT( "Init shaders" ) );
 	GShaderManager->Init();
 
+	appSetSplashText( STT_StartupProgress, TEXT( "Init pipeline states" ) );
+	GPipelineStateCache.Prewarm();
+
 	appSetSplashText( STT_StartupProgress, TEXT( "Init audio" ) );
 	GAudioEngine.Init();
 
+	appSetSplashText( STT_StartupProgress, TEXT( "Init thread pool" ) );
+	{
+		// If number of worker threads isn't set, it will be calculated by number of cores
+		CConfigValue		configNumWorkerThreads = GConfig.GetValue( CT_Engine, TEXT( "Engine.Engine" ), TEXT( "NumWorkerThreads" ) );
+		GThreadPool.Init( configNumWorkerThreads.IsA( CConfigValue::T_Int ) ? Max( configNumWorkerThreads.GetInt(), 0 ) : 0 );
+	}
+
 	appSetSplashText( STT_StartupProgress, TEXT( "Init engine" ) );
 	GEngine->Init();
 
@@ -402,15 +432,26 @@ void CEngineLoop::Exit()
 	GEngine->Shutdown();
 	delete GEngine;
 	GEngine = nullptr;
+	GThreadPool.Shutdown();
 
 	delete GFullScreenMovie;
 	GFullScreenMovie = nullptr;
 
 	GAudioEngine.Shutdown();
+	GPipelineStateCache.SaveList();
 	GShaderManager->Shutdown();
 	GRHI->Destroy();
 
 	GWindow->Close();
+
+	// Print report of allocations which still alive, it must be done before shutdown of logs
+	if ( GMallocTracking && GMallocTracking->GetSettings().bReportLeaksOnExit )
+	{
+		GMallocTracking->DumpStats( false );
+		GMallocTracking->DumpLiveAllocations();
+	}
+
+	GAsyncLog.Shutdown();
 	GLog->TearDown();
 	GConfig.Shutdown();
 	GCommandLine.Shutdown();
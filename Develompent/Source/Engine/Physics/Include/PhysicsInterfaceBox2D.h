@@ -321,6 +321,19 @@ struct SPhysicsInterfaceBox2D
 		return B2LETransform( InActorHandle.bx2Body->GetTransform() );
 	}
 
+	/**
+	 * @brief Set physics actor transform
+	 *
+	 * @param InActorHandle Handle of physics actor
+	 * @param InTransform New transform
+	 */
+	static FORCEINLINE void SetTransform( const SPhysicsActorHandleBox2D& InActorHandle, const CTransform& InTransform )
+	{
+		check( IsValidActor( InActorHandle ) );
+		b2Transform		bx2Transform = LE2BTransform( InTransform );
+		InActorHandle.bx2Body->SetTransform( bx2Transform.p, bx2Transform.q.GetAngle() );
+	}
+
 	/**
 	 * @brief Set linear velocity
 	 * 
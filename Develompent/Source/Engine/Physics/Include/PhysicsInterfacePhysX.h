@@ -348,6 +348,18 @@ struct SPhysicsInterfacePhysX
 		return P2LETransform( InActorHandle.pxRigidActor->getGlobalPose() );
 	}
 
+	/**
+	 * @brief Set physics actor transform
+	 *
+	 * @param InActorHandle Handle of physics actor
+	 * @param InTransform New transform
+	 */
+	static FORCEINLINE void SetTransform( const SPhysicsActorHandlePhysX& InActorHandle, const CTransform& InTransform )
+	{
+		check( IsValidActor( InActorHandle ) );
+		InActorHandle.pxRigidActor->setGlobalPose( LE2PTransform( InTransform ) );
+	}
+
 	/**
 	 * @brief Release actor
 	 * @param InActorHandle Handle of physics actor
@@ -188,6 +188,15 @@ public:
 		return CPhysicsInterface::GetTransform( handle );
 	}
 
+	/**
+	 * @brief Set LE world transform, body is teleported to new location
+	 * @param InTransform New LE world transform
+	 */
+	FORCEINLINE void SetLEWorldTransform( const CTransform& InTransform )
+	{
+		CPhysicsInterface::SetTransform( handle, InTransform );
+	}
+
 	/**
 	 * @brief Get body setup
 	 * @return Return body setup
@@ -5,6 +5,7 @@
 #include "System/PhysicsEngine.h"
 #include "System/Package.h"
 #include "PhysicsInterface.h"
+#include "System/Malloc.h"
 
 FORCEINLINE ECollisionChannel TextToECollisionChannel( const std::wstring& InStr )
 {
@@ -54,6 +55,8 @@ CPhysicsEngine::~CPhysicsEngine()
 
 void CPhysicsEngine::Init()
 {
+	SCOPED_MEMORY_TAG( MTAG_Physics );
+
 	// Init physics interface
 	CPhysicsInterface::Init();
 
@@ -143,6 +146,8 @@ void CPhysicsEngine::Init()
 
 void CPhysicsEngine::Tick( float InDeltaTime )
 {
+	SCOPED_MEMORY_TAG( MTAG_Physics );
+
 	GPhysicsScene.Tick( InDeltaTime );
 }
 
@@ -10,6 +10,7 @@
 #define WINDOWSLOGGER_H
 
 #include <chrono>
+#include <ctime>
 
 #include "Logger/BaseLogger.h"
 #include "WindowsArchive.h"
@@ -44,8 +45,15 @@ public:
      *
      * @param[in] InMessage Message
      * @param[in] InEvent Type event of message
+     * @param[in] InLogCategory Log category
+     * @param[in] InTime Time of message in seconds since start of application
      */
-    virtual void            Serialize( const tchar* InMessage, ELogType InLogType, ELogCategory InLogCategory );
+    virtual void            Serialize( const tchar* InMessage, ELogType InLogType, ELogCategory InLogCategory, double InTime ) override;
+
+    /**
+     * @brief Flush of output device
+     */
+    virtual void            Flush() override;
 
     /**
      * @brief Closes output device and cleans up
@@ -83,10 +91,19 @@ public:
      */
     virtual void        ResetTextColor() override;
 
+    /**
+     * @brief Get path to log file with extension
+     *
+     * @param InExtension Extension of file (without dot)
+     * @return Return path to log file
+     */
+    virtual std::wstring GetLogFilename( const tchar* InExtension ) const override;
+
 private:
     HANDLE              consoleHandle;      /**< OS handle on console*/
     CArchive*           archiveLogs;        /**< Archive of logs */
     ELogColor           textColor;          /**< Current text color */
+    time_t              startTime;          /**< Time of start logging, used in name of log files */
 };
 
 #endif // !WINDOWSLOGGER_H
@@ -26,6 +26,11 @@ FORCEINLINE int32 appInterlockedAdd( volatile int32* InValue, int32 InAmount )
 	return ( int32 )InterlockedExchangeAdd( ( LPLONG )InValue, ( LONG )InAmount );
 }
 
+FORCEINLINE int64 appInterlockedAdd64( volatile int64* InValue, int64 InAmount )
+{
+	return ( int64 )InterlockedExchangeAdd64( InValue, InAmount );
+}
+
 FORCEINLINE int32 appInterlockedExchange( volatile int32* InValue, int32 InExchange )
 {
 	return ( int32 )InterlockedExchange( ( LPLONG )InValue, ( LONG )InExchange );
@@ -7,6 +7,7 @@
 #include "Misc/Misc.h"
 #include "Containers/String.h"
 #include "System/BaseFileSystem.h"
+#include "Logger/AsyncLogBackend.h"
 #include "WindowsLogger.h"
 
 #if WITH_EDITOR
@@ -14,36 +15,6 @@
 #include "Misc/WorldEdGlobals.h"
 #endif // WITH_EDITOR
 
-const tchar* GLogTypeNames[] =
-{
-	TEXT( "Log" ),
-	TEXT( "Warning" ),
-	TEXT( "Error" )
-};
-
-const tchar* GLogCategoryNames[] =
-{
-	TEXT( "None" ),
-	TEXT( "General" ),
-	TEXT( "Init" ),
-	TEXT( "Script" ),
-	TEXT( "Dev" ),
-	TEXT( "Shader" ),
-	TEXT( "Input" ),
-	TEXT( "Package" ),
-	TEXT( "Audio" ),
-	TEXT( "Physics" ),
-	TEXT( "Movie" ),
-	TEXT( "Render" ),
-	TEXT( "RHI" ),
-	TEXT( "Console" ),
-
-#if WITH_EDITOR
-	TEXT( "Editor" ),
-	TEXT( "Commandlet" )
-#endif // WITH_EDITOR
-};
-
 const uint16 GLogColors[] =
 {
 	0x7,			// LC_Default
@@ -59,6 +30,7 @@ CWindowsLogger::CWindowsLogger()
 	: consoleHandle( nullptr )
 	, archiveLogs( nullptr )
 	, textColor( LC_Default )
+	, startTime( time( nullptr ) )
 {}
 
 /**
@@ -98,10 +70,9 @@ void CWindowsLogger::Show( bool InShowWindow )
 void CWindowsLogger::Init()
 {
 #if !NO_LOGGING
-	time_t		timeNow = time( nullptr );
-	tm*			tmTimeNow = localtime( &timeNow );
+	startTime = time( nullptr );
 
-	std::wstring		logFile = CString::Format( TEXT( "%s/Logs/%s-%i.%02i.%02i-%02i.%02i.%02i.log" ), appGameDir().c_str(), !GIsEditor ? GGameName.c_str() : TEXT( "WorldEd" ), 1900 + tmTimeNow->tm_year, 1 + tmTimeNow->tm_mon, tmTimeNow->tm_mday, tmTimeNow->tm_hour, tmTimeNow->tm_min, tmTimeNow->tm_sec );
+	std::wstring		logFile = GetLogFilename( TEXT( "log" ) );
 	archiveLogs = GFileSystem->CreateFileWriter( logFile.c_str(), AW_None );
 	if ( archiveLogs )
 	{
@@ -111,6 +82,15 @@ void CWindowsLogger::Init()
 #endif // !NO_LOGGING
 }
 
+/**
+ * Get path to log file with extension
+ */
+std::wstring CWindowsLogger::GetLogFilename( const tchar* InExtension ) const
+{
+	tm*			tmStartTime = localtime( &startTime );
+	return CString::Format( TEXT( "%s/Logs/%s-%i.%02i.%02i-%02i.%02i.%02i.%s" ), appGameDir().c_str(), !GIsEditor ? GGameName.c_str() : TEXT( "WorldEd" ), 1900 + tmStartTime->tm_year, 1 + tmStartTime->tm_mon, tmStartTime->tm_mday, tmStartTime->tm_hour, tmStartTime->tm_min, tmStartTime->tm_sec, InExtension );
+}
+
 /**
  * Closes output device and cleans up
  */
@@ -150,7 +130,7 @@ void CWindowsLogger::ResetTextColor()
 /**
  * Serialize message
  */
-void CWindowsLogger::Serialize( const tchar* InMessage, ELogType InLogType, ELogCategory InLogCategory )
+void CWindowsLogger::Serialize( const tchar* InMessage, ELogType InLogType, ELogCategory InLogCategory, double InTime )
 {
 	// If console is opened - get current text color
 	// and change to color by event type
@@ -176,7 +156,7 @@ void CWindowsLogger::Serialize( const tchar* InMessage, ELogType InLogType, ELog
 		}
 	}
 	
-	std::wstring			message = CString::Format( TEXT( "[%07.2f][%s][%s] %s" ), appSeconds() - GStartTime, GLogTypeNames[ ( uint32 ) InLogType ], GLogCategoryNames[ ( uint32 ) InLogCategory ], InMessage );
+	std::wstring			message = CString::Format( TEXT( "[%07.2f][%s][%s] %s" ), InTime, GLogTypeNames[ ( uint32 ) InLogType ], GLogCategoryNames[ ( uint32 ) InLogCategory ], InMessage );
 	std::wstring			finalMessage = message + TEXT( "\n" );
 	wprintf( finalMessage.c_str() );
 
@@ -188,11 +168,14 @@ void CWindowsLogger::Serialize( const tchar* InMessage, ELogType InLogType, ELog
 	}
 #endif // WITH_EDITOR
 
-	// Serialize log to file
+	// Serialize log to file. In asynchronous mode log thread flushes file once per batch of messages
 	if ( archiveLogs )
 	{
 		*archiveLogs << finalMessage;
-		archiveLogs->Flush();
+		if ( !GAsyncLog.IsRunning() )
+		{
+			archiveLogs->Flush();
+		}
 	}
 
 	// Print message to debug output
@@ -209,3 +192,14 @@ void CWindowsLogger::Serialize( const tchar* InMessage, ELogType InLogType, ELog
 		SetTextColor( currentLogColor );
 	}
 }
+
+/**
+ * Flush of output device
+ */
+void CWindowsLogger::Flush()
+{
+	if ( archiveLogs )
+	{
+		archiveLogs->Flush();
+	}
+}
@@ -8,6 +8,7 @@
 #include "Misc/Guid.h"
 #include "Containers/String.h"
 #include "Containers/StringConv.h"
+#include "System/ThreadingBase.h"
 #include "Logger/LoggerMacros.h"
 #include "EngineLoop.h"
 #include "D3D11RHI.h"
@@ -18,6 +19,12 @@
 #include "WindowsStackWalker.h"
 #include "WindowsGlobals.h"
 
+#pragma warning( push )
+#pragma warning( disable : 4091 )		// For fix unnamed enums from DbgHelp.h
+#include <DbgHelp.h>
+#pragma warning( pop )
+#pragma comment( lib, "dbghelp.lib" )
+
 // ----
 // Platform specific globals variables
 // ----
@@ -210,6 +217,53 @@ void appDumpCallStack( std::wstring& OutCallStack )
 	OutCallStack = stackWalker.GetBuffer();
 }
 
+uint32 appCaptureStackBackTrace( uint64* OutBackTrace, uint32 InMaxDepth, uint32 InSkipFrames /* = 0 */ )
+{
+	check( OutBackTrace );
+	void*		backTrace[ 64 ];
+	uint32		numFrames = RtlCaptureStackBackTrace( InSkipFrames + 1, Min<uint32>( InMaxDepth, ARRAY_COUNT( backTrace ) ), backTrace, nullptr );		// +1 for skip this function
+	for ( uint32 index = 0; index < numFrames; ++index )
+	{
+		OutBackTrace[ index ] = ( uint64 )backTrace[ index ];
+	}
+	return numFrames;
+}
+
+std::wstring appProgramCounterToString( uint64 InProgramCounter )
+{
+	// DbgHelp functions are single threaded, so we need synchronize access to them
+	static CCriticalSection		symbolsCS;
+	static bool					bSymbolsInitialized = false;
+	CScopeLock					scopeLock( &symbolsCS );
+
+	HANDLE		process = GetCurrentProcess();
+	if ( !bSymbolsInitialized )
+	{
+		SymSetOptions( SymGetOptions() | SYMOPT_LOAD_LINES | SYMOPT_DEFERRED_LOADS | SYMOPT_UNDNAME );
+		SymInitialize( process, nullptr, TRUE );
+		bSymbolsInitialized = true;
+	}
+
+	// Get function name
+	byte				symbolBuffer[ sizeof( SYMBOL_INFO ) + MAX_SYM_NAME ];
+	SYMBOL_INFO*		symbol = ( SYMBOL_INFO* )symbolBuffer;
+	symbol->SizeOfStruct	= sizeof( SYMBOL_INFO );
+	symbol->MaxNameLen		= MAX_SYM_NAME;
+
+	DWORD64				displacement = 0;
+	std::wstring		functionName = SymFromAddr( process, InProgramCounter, &displacement, symbol ) ? ANSI_TO_TCHAR( symbol->Name ) : TEXT( "UnknownFunction" );
+
+	// Get file and line
+	IMAGEHLP_LINE64		line;
+	DWORD				lineDisplacement = 0;
+	line.SizeOfStruct	= sizeof( IMAGEHLP_LINE64 );
+	if ( SymGetLineFromAddr64( process, InProgramCounter, &lineDisplacement, &line ) )
+	{
+		return CString::Format( TEXT( "0x%016llX %s [%s:%i]" ), InProgramCounter, functionName.c_str(), ANSI_TO_TCHAR( line.FileName ), line.LineNumber );
+	}
+	return CString::Format( TEXT( "0x%016llX %s" ), InProgramCounter, functionName.c_str() );
+}
+
 void appRequestExit( bool InForce )
 {
 	if ( InForce )
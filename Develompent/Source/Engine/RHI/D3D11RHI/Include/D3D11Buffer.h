@@ -21,13 +21,20 @@
 
 /**
  * @ingroup D3D11RHI
- * Enumeration of constant buffer slots
+ * Size of the per draw constant buffer
+ */
+#define MAX_DRAW_CONSTANT_BUFFER_SIZE		256
+
+/**
+ * @ingroup D3D11RHI
+ * Enumeration of constant buffer slots, buffers are split by frequency of updates
  * @warning These offsets must match the cbuffer register definitions in Common.hlsl
  */
 enum ED3D11ShaderOffsetBuffer
 {
-	SOB_ShaderConstants,	/**< Global constants in shader */
+	SOB_ShaderConstants,	/**< Global constants in shader, they are changed per material and pass */
 	SOB_GlobalConstants,	/**< Vertex shader view-dependent constants set in RHISetViewParameters */
+	SOB_DrawConstants,		/**< Constants changed per draw (local to world matrix, hit proxy id, etc) */
 	SOB_Max					/**< Max count constant buffer slots */
 };
 
@@ -132,15 +139,37 @@ public:
 	 * @param[in] InData Pointer to data
 	 * @param[in] InOffset Offset in buffer
 	 * @param[in] InSize Size data to update
+	 * @return Return TRUE if data in buffer is changed, if it's the same as new data returns FALSE
 	 */
-	void Update( const byte* InData, uint32 InOffset, uint32 InSize );
+	bool Update( const byte* InData, uint32 InOffset, uint32 InSize );
 
 	/**
 	 * Flush data to GPU
+	 * Map with discard drops old content of buffer and D3D11 can't update part of constant buffer,
+	 * so whole written data is uploaded, not only changed bytes
 	 * 
 	 * @param[in] InDeviceContext Device context
+	 * @return Return number of uploaded bytes, if buffer isn't changed returns 0
+	 */
+	uint32 CommitConstantsToDevice( class CD3D11DeviceContext* InDeviceContext );
+
+	/**
+	 * @brief Is need commit buffer to device
+	 * @return Return TRUE if data in buffer is changed since last commit
 	 */
-	void CommitConstantsToDevice( class CD3D11DeviceContext* InDeviceContext );
+	FORCEINLINE bool IsDirty() const
+	{
+		return numDirtyBytes > 0;
+	}
+
+	/**
+	 * @brief Get size of changed data
+	 * @return Return number of changed bytes since last commit, uploaded size may be bigger (see CommitConstantsToDevice)
+	 */
+	FORCEINLINE uint32 GetDirtySize() const
+	{
+		return numDirtyBytes;
+	}
 
 	/**
 	 * Clear data
@@ -157,11 +186,11 @@ public:
 	}
 
 private:
-	bool				isNeedCommit;			/**< If true - need commit buffer to device */
 	ID3D11Buffer*		d3d11Buffer;			/**< Pointer to DirectX 11 buffer */
 	uint32				size;					/**< Size buffer */
 	byte*				shadowData;				/**< Local version of buffer, which is updated and uploaded to the GPU at once */
-	uint32				currentUpdateSize;		/**< Size to update buffer */
+	uint32				usedSize;				/**< Size of data written in buffer, discard drops whole buffer so it's uploaded every commit */
+	uint32				numDirtyBytes;			/**< Number of changed bytes since last commit */
 };
 
 #endif // !D3D11BUFFERRHI_H
\ No newline at end of file
@@ -317,6 +317,12 @@ public:
 	 * @param[in] InDeviceContext Device context
 	 */
 	virtual void								EndDrawEvent( class CBaseDeviceContextRHI* InDeviceContext ) override;
+
+	/**
+	 * @brief Is frame capture tool attached
+	 * @return Return TRUE if frame capture tool (e.g. RenderDoc or PIX) is attached to application, otherwise returns FALSE
+	 */
+	virtual bool								IsFrameCaptureToolAttached() const override;
 #endif // FRAME_CAPTURE_MARKERS
 
 	/**
@@ -478,8 +484,9 @@ public:
 	 * @param[in] InSize Size
 	 * @param[in] InOffset Offset in buffer
 	 * @param[out] OutLockedData Locked data in buffer
+	 * @param[in] InIsNoOverwrite Write without overwriting data which GPU may still use, content of buffer is kept. Otherwise the whole buffer is discarded
 	 */
-	virtual void									LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData ) override;
+	virtual void									LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData, bool InIsNoOverwrite = false ) override;
 
 	/**
 	 * @brief Unlock vertex buffer
@@ -490,6 +497,18 @@ public:
 	 */
 	virtual void									UnlockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, SLockedData& InLockedData ) override;
 
+	/**
+	 * @brief Update region of vertex buffer
+	 * @note Unlike LockVertexBuffer content of buffer out of region is kept, so buffer must be created without RUF_Dynamic
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InVertexBuffer Pointer to vertex buffer
+	 * @param[in] InOffset Offset of region in buffer
+	 * @param[in] InSize Size of region
+	 * @param[in] InData New data of region
+	 */
+	virtual void									UpdateVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InOffset, uint32 InSize, const void* InData ) override;
+
 	/**
 	 * @brief Lock index buffer
 	 *
@@ -498,8 +517,9 @@ public:
 	 * @param[in] InSize Size
 	 * @param[in] InOffset Offset in buffer
 	 * @param[out] OutLockedData Locked data in buffer
+	 * @param[in] InIsNoOverwrite Write without overwriting data which GPU may still use, content of buffer is kept. Otherwise the whole buffer is discarded
 	 */
-	virtual void									LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData ) override;
+	virtual void									LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData, bool InIsNoOverwrite = false ) override;
 
 	/**
 	 * @brief Unlock index buffer
@@ -669,10 +689,28 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Update data in constant buffer
+	 *
+	 * @param[in] InConstantBuffer Constant buffer
+	 * @param[in] InBaseIndex Offset in bytes to begin parameter
+	 * @param[in] InNumBytes Number bytes of parameter
+	 * @param[in] InNewValue New value
+	 */
+	void										UpdateConstantBuffer( class CD3D11ConstantBuffer* InConstantBuffer, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue );
+
+	/**
+	 * @brief Commit constant buffer to device if it's changed
+	 *
+	 * @param[in] InDeviceContext Device context
+	 * @param[in] InConstantBuffer Constant buffer
+	 */
+	void										CommitConstantBuffer( class CBaseDeviceContextRHI* InDeviceContext, class CD3D11ConstantBuffer* InConstantBuffer );
+
 	bool										isInitialize;						/**< Is RHI is initialized */
 	class CD3D11ConstantBuffer*					globalConstantBuffer;				/**< Global constant buffer */
 	class CD3D11ConstantBuffer*					vsConstantBuffers[ SOB_Max ];		/**< Constant buffers for vertex shader */
-	class CD3D11ConstantBuffer*					psConstantBuffer;					/**< Constant buffer for pixel shader */
+	class CD3D11ConstantBuffer*					psConstantBuffers[ SOB_Max ];		/**< Constant buffers for pixel shader */
 	class CD3D11DeviceContext*					immediateContext;					/**< Immediate context */
 	CBoundShaderStateHistory					boundShaderStateHistory;			/**< History of using bound shader states */
 	SD3D11StateCache							stateCache;							/**< DirectX 11 state cache */
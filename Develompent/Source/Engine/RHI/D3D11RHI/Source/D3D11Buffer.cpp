@@ -18,6 +18,7 @@ const uint32 GConstantBufferSizes[ SOB_Max ] =
 	// CBs must be a multiple of 16
 	Align( ( uint32 )MAX_GLOBAL_CONSTANT_BUFFER_SIZE, 16 ),
 	Align( ( uint32 )sizeof( SGlobalConstantBufferContents ), 16 ),
+	Align( ( uint32 )MAX_DRAW_CONSTANT_BUFFER_SIZE, 16 )
 };
 
 // ------------------------------------
@@ -143,11 +144,11 @@ CD3D11IndexBufferRHI::~CD3D11IndexBufferRHI()
 // ------------------------------------
 
 CD3D11ConstantBuffer::CD3D11ConstantBuffer( uint32 InSize, const tchar* InBufferName ) :
-	isNeedCommit( false ),
 	d3d11Buffer( nullptr ),
 	size( InSize ),
 	shadowData( nullptr ),
-	currentUpdateSize( 0 )
+	usedSize( 0 ),
+	numDirtyBytes( 0 )
 {
 	// Explicitly check that the size is nonzero before allowing create constant buffer to opaquely fail
 	check( size > 0 );
@@ -199,18 +200,27 @@ CD3D11ConstantBuffer::~CD3D11ConstantBuffer()
 	}
 }
 
-void CD3D11ConstantBuffer::Update( const byte* InData, uint32 InOffset, uint32 InSize )
+bool CD3D11ConstantBuffer::Update( const byte* InData, uint32 InOffset, uint32 InSize )
 {
+	check( InOffset + InSize <= size );
+	usedSize = Max( usedSize, InOffset + InSize );
+
+	// Skip values which are already in buffer, it's often for parameters set per draw
+	if ( !memcmp( shadowData + InOffset, InData, InSize ) )
+	{
+		return false;
+	}
+
 	memcpy( shadowData + InOffset, InData, InSize );
-	currentUpdateSize = Max( currentUpdateSize, ( uint32 )InOffset + InSize );
-	isNeedCommit = true;
+	numDirtyBytes += InSize;
+	return true;
 }
 
-void CD3D11ConstantBuffer::CommitConstantsToDevice( class CD3D11DeviceContext* InDeviceContext )
+uint32 CD3D11ConstantBuffer::CommitConstantsToDevice( class CD3D11DeviceContext* InDeviceContext )
 {
-	if ( !isNeedCommit )
+	if ( !IsDirty() )
 	{
-		return;
+		return 0;
 	}
 
 	check( InDeviceContext );
@@ -219,23 +229,25 @@ void CD3D11ConstantBuffer::CommitConstantsToDevice( class CD3D11DeviceContext* I
 
 	d3d11DeviceContext->Map( d3d11Buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &d3d11Mapped );
 
+	// Discard drops old content of buffer, so not only the dirty range must be uploaded
 #if !D3D11_FILLFULL_CONSTANTBUFFER
-	memcpy( ( byte* )d3d11Mapped.pData, shadowData, currentUpdateSize );
+	uint32		uploadSize = usedSize;
 #else
-	memcpy( ( byte* )d3d11Mapped.pData, shadowData, size );
+	uint32		uploadSize = size;
 #endif // !D3D11_FILLFULL_CONSTANTBUFFER
 
+	memcpy( ( byte* )d3d11Mapped.pData, shadowData, uploadSize );
 	d3d11DeviceContext->Unmap( d3d11Buffer, 0 );
 
-	isNeedCommit = false;
-	currentUpdateSize = 0;
+	numDirtyBytes = 0;
+	return uploadSize;
 }
 
 void CD3D11ConstantBuffer::Clear()
 {
 	if ( !shadowData )		return;
 
+	// Only written data must be uploaded again, rest of buffer on GPU is already zero (it's created from shadow data)
 	appMemzero( shadowData, size );
-	isNeedCommit = true;
-	currentUpdateSize = size;
+	numDirtyBytes = usedSize;
 }
\ No newline at end of file
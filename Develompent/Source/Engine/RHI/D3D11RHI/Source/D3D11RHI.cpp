@@ -318,10 +318,10 @@ CD3D11RHI::CD3D11RHI()
 	: isInitialize( false )
 	, immediateContext( nullptr )
 	, globalConstantBuffer( nullptr )
-	, psConstantBuffer( nullptr )
 	, d3d11Device( nullptr )
 {
 	appMemzero( vsConstantBuffers, sizeof( vsConstantBuffers ) );
+	appMemzero( psConstantBuffers, sizeof( psConstantBuffers ) );
 }
 
 /**
@@ -379,26 +379,27 @@ void CD3D11RHI::Init( bool InIsEditor )
 		d3d11DeviceContext->CSSetConstantBuffers( SOB_GlobalConstants, 1, &d3d11GlobalConstantBuffer );
 	}
 
-	// Vertex constant buffer
-	vsConstantBuffers[ SOB_ShaderConstants ] = new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
-	vsConstantBuffers[ SOB_GlobalConstants ] = nullptr;
+	// Vertex and pixel constant buffers. Constants of shader and per draw constants are in separate buffers,
+	// so changing of local to world matrix doesn't upload parameters of material
+	vsConstantBuffers[ SOB_ShaderConstants ]	= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
+	vsConstantBuffers[ SOB_GlobalConstants ]	= nullptr;
+	vsConstantBuffers[ SOB_DrawConstants ]		= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_DrawConstants ], TEXT( "DrawConstantBuffer" ) );
+	psConstantBuffers[ SOB_ShaderConstants ]	= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
+	psConstantBuffers[ SOB_GlobalConstants ]	= nullptr;
+	psConstantBuffers[ SOB_DrawConstants ]		= new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_DrawConstants ], TEXT( "DrawConstantBuffer" ) );
+	for ( uint32 index = 0; index < SOB_Max; ++index )
 	{
-		for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+		if ( vsConstantBuffers[ index ] )
 		{
-			CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
-			if ( constantBuffer )
-			{
-				ID3D11Buffer*		d3d11ConstantBuffer = constantBuffer->GetD3D11Buffer();
-				d3d11DeviceContext->VSSetConstantBuffers( SOB_ShaderConstants, 1, &d3d11ConstantBuffer );
-			}
+			ID3D11Buffer*		d3d11ConstantBuffer = vsConstantBuffers[ index ]->GetD3D11Buffer();
+			d3d11DeviceContext->VSSetConstantBuffers( index, 1, &d3d11ConstantBuffer );
 		}
-	}
 
-	// Pixel constant buffer
-	psConstantBuffer = new CD3D11ConstantBuffer( GConstantBufferSizes[ SOB_ShaderConstants ], TEXT( "ShaderConstantBuffer" ) );
-	{
-		ID3D11Buffer*		d3d11ConstantBuffer = psConstantBuffer->GetD3D11Buffer();
-		d3d11DeviceContext->PSSetConstantBuffers( SOB_ShaderConstants, 1, &d3d11ConstantBuffer );
+		if ( psConstantBuffers[ index ] )
+		{
+			ID3D11Buffer*		d3d11ConstantBuffer = psConstantBuffers[ index ]->GetD3D11Buffer();
+			d3d11DeviceContext->PSSetConstantBuffers( index, 1, &d3d11ConstantBuffer );
+		}
 	}
 
 	// Print info adapter
@@ -426,6 +427,7 @@ void CD3D11RHI::Init( bool InIsEditor )
 	INIT_FORMAT( PF_BC5,					DXGI_FORMAT_BC5_UNORM );
 	INIT_FORMAT( PF_BC6H,					DXGI_FORMAT_BC6H_UF16 );
 	INIT_FORMAT( PF_BC7,					DXGI_FORMAT_BC7_UNORM );
+	INIT_FORMAT( PF_A32B32G32R32F,			DXGI_FORMAT_R32G32B32A32_FLOAT );
 
 	INIT_UNSUPPORTED_FORMAT( PF_Unknown );
 	isInitialize = true;
@@ -473,17 +475,13 @@ void CD3D11RHI::Destroy()
 		( *it )->ReleaseResource();
 	}
 
-	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+	for ( uint32 index = 0; index < SOB_Max; ++index )
 	{
-		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
-		if ( constantBuffer )
-		{
-			delete constantBuffer;
-		}
+		delete vsConstantBuffers[ index ];
+		delete psConstantBuffers[ index ];
 	}
 
 	delete globalConstantBuffer;
-	delete psConstantBuffer;
 	delete immediateContext;
 	d3d11Device->Release();
 	dxgiAdapter->Release();
@@ -491,7 +489,6 @@ void CD3D11RHI::Destroy()
 
 	isInitialize = false;
 	globalConstantBuffer = nullptr;
-	psConstantBuffer = nullptr;
 	immediateContext = nullptr;
 	d3d11Device = nullptr;
 	dxgiAdapter = nullptr;
@@ -499,6 +496,7 @@ void CD3D11RHI::Destroy()
 
 	appMemzero( &stateCache, sizeof( SD3D11StateCache ) );
 	appMemzero( vsConstantBuffers, sizeof( vsConstantBuffers ) );
+	appMemzero( psConstantBuffers, sizeof( psConstantBuffers ) );
 }
 
 /**
@@ -817,18 +815,48 @@ void CD3D11RHI::SetViewParameters( class CBaseDeviceContextRHI* InDeviceContext,
 	SGlobalConstantBufferContents			globalContents;
 	SetGlobalConstants( globalContents, InSceneView, Vector4D( InSceneView.GetSizeX(), InSceneView.GetSizeY(), GSceneRenderTargets.GetBufferWidth(), GSceneRenderTargets.GetBufferHeight() ) );
 
-	globalConstantBuffer->Update( ( byte* ) &globalContents, 0, sizeof( globalContents ) );
-	globalConstantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
+	UpdateConstantBuffer( globalConstantBuffer, 0, sizeof( globalContents ), &globalContents );
+	CommitConstantBuffer( InDeviceContext, globalConstantBuffer );
 }
 
 void CD3D11RHI::SetVertexShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
 {
-	vsConstantBuffers[ InBufferIndex ]->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes );
+	check( InBufferIndex < SOB_Max && vsConstantBuffers[ InBufferIndex ] );
+	UpdateConstantBuffer( vsConstantBuffers[ InBufferIndex ], InBaseIndex, InNumBytes, InNewValue );
 }
 
 void CD3D11RHI::SetPixelShaderParameter( class CBaseDeviceContextRHI* InDeviceContext, uint32 InBufferIndex, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
 {
-	psConstantBuffer->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes );
+	check( InBufferIndex < SOB_Max && psConstantBuffers[ InBufferIndex ] );
+	UpdateConstantBuffer( psConstantBuffers[ InBufferIndex ], InBaseIndex, InNumBytes, InNewValue );
+}
+
+/**
+ * Update data in constant buffer
+ */
+void CD3D11RHI::UpdateConstantBuffer( class CD3D11ConstantBuffer* InConstantBuffer, uint32 InBaseIndex, uint32 InNumBytes, const void* InNewValue )
+{
+	++constantBufferStats.numUpdates;
+	if ( !InConstantBuffer->Update( ( const byte* )InNewValue, InBaseIndex, InNumBytes ) )
+	{
+		++constantBufferStats.numRedundantUpdates;
+	}
+}
+
+/**
+ * Commit constant buffer to device
+ */
+void CD3D11RHI::CommitConstantBuffer( class CBaseDeviceContextRHI* InDeviceContext, class CD3D11ConstantBuffer* InConstantBuffer )
+{
+	if ( !InConstantBuffer->IsDirty() )
+	{
+		++constantBufferStats.numSkippedUploads;
+		return;
+	}
+
+	++constantBufferStats.numUploads;
+	constantBufferStats.numDirtyBytes		+= InConstantBuffer->GetDirtySize();
+	constantBufferStats.numUploadedBytes	+= InConstantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
 }
 
 void CD3D11RHI::SetDepthState( class CBaseDeviceContextRHI* InDeviceContext, DepthStateRHIParamRef_t InNewState )
@@ -867,28 +895,30 @@ void CD3D11RHI::SetStencilState( class CBaseDeviceContextRHI* InDeviceContext, S
 
 void CD3D11RHI::CommitConstants( class CBaseDeviceContextRHI* InDeviceContext )
 {
-	// Commit vertex shader constants
-	for ( uint32 index = 0, num = ARRAY_COUNT( vsConstantBuffers ); index < num; ++index )
+	// Commit vertex and pixel shader constants, only changed buffers are uploaded
+	for ( uint32 index = 0; index < SOB_Max; ++index )
 	{
-		CD3D11ConstantBuffer*		constantBuffer = vsConstantBuffers[ index ];
-		if ( constantBuffer )
+		if ( vsConstantBuffers[ index ] )
 		{
-			constantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
+			CommitConstantBuffer( InDeviceContext, vsConstantBuffers[ index ] );
 		}
-	}
 
-	// Commit pixel shader constants
-	psConstantBuffer->CommitConstantsToDevice( ( CD3D11DeviceContext* )InDeviceContext );
+		if ( psConstantBuffers[ index ] )
+		{
+			CommitConstantBuffer( InDeviceContext, psConstantBuffers[ index ] );
+		}
+	}
 }
 
 /**
  * Lock vertex buffer
  */
-void CD3D11RHI::LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData )
+void CD3D11RHI::LockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData, bool InIsNoOverwrite /* = false */ )
 {
-	check( OutLockedData.data == nullptr && InOffset < InSize );
+	check( OutLockedData.data == nullptr && InOffset + InSize <= InVertexBuffer->GetSize() );
+	check( !InIsNoOverwrite || ( InVertexBuffer->GetUsage() & RUF_AnyDynamic ) );
 
-	D3D11_MAP						writeMode = D3D11_MAP_WRITE_DISCARD;
+	D3D11_MAP						writeMode = InIsNoOverwrite ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD;
 	D3D11_MAPPED_SUBRESOURCE		mappedSubresource;
 	
 	static_cast< CD3D11DeviceContext* >( InDeviceContext )->GetD3D11DeviceContext()->Map( static_cast< CD3D11VertexBufferRHI* >( InVertexBuffer.GetPtr() )->GetD3D11Buffer(), 0, writeMode, 0, &mappedSubresource );
@@ -908,14 +938,27 @@ void CD3D11RHI::UnlockVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext
 	InLockedData.data = nullptr;
 }
 
+/**
+ * Update region of vertex buffer
+ */
+void CD3D11RHI::UpdateVertexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const VertexBufferRHIRef_t InVertexBuffer, uint32 InOffset, uint32 InSize, const void* InData )
+{
+	check( InData && InSize > 0 && InOffset + InSize <= InVertexBuffer->GetSize() );
+	check( !( InVertexBuffer->GetUsage() & RUF_AnyDynamic ) );
+
+	D3D11_BOX		d3d11Box = { InOffset, 0, 0, InOffset + InSize, 1, 1 };
+	static_cast< CD3D11DeviceContext* >( InDeviceContext )->GetD3D11DeviceContext()->UpdateSubresource( static_cast< CD3D11VertexBufferRHI* >( InVertexBuffer.GetPtr() )->GetD3D11Buffer(), 0, &d3d11Box, InData, 0, 0 );
+}
+
 /**
  * Lock index buffer
  */
-void CD3D11RHI::LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData )
+void CD3D11RHI::LockIndexBuffer( class CBaseDeviceContextRHI* InDeviceContext, const IndexBufferRHIRef_t InIndexBuffer, uint32 InSize, uint32 InOffset, SLockedData& OutLockedData, bool InIsNoOverwrite /* = false */ )
 {
-	check( OutLockedData.data == nullptr && InOffset < InSize );
+	check( OutLockedData.data == nullptr && InOffset + InSize <= InIndexBuffer->GetSize() );
+	check( !InIsNoOverwrite || ( InIndexBuffer->GetUsage() & RUF_AnyDynamic ) );
 
-	D3D11_MAP						writeMode = D3D11_MAP_WRITE_DISCARD;
+	D3D11_MAP						writeMode = InIsNoOverwrite ? D3D11_MAP_WRITE_NO_OVERWRITE : D3D11_MAP_WRITE_DISCARD;
 	D3D11_MAPPED_SUBRESOURCE		mappedSubresource;
 
 	static_cast< CD3D11DeviceContext* >( InDeviceContext )->GetD3D11DeviceContext()->Map( static_cast< CD3D11IndexBufferRHI* >( InIndexBuffer.GetPtr() )->GetD3D11Buffer(), 0, writeMode, 0, &mappedSubresource );
@@ -1627,6 +1670,12 @@ void CD3D11RHI::EndDrawEvent( class CBaseDeviceContextRHI* InDeviceContext )
 {
 	D3DPERF_EndEvent();
 }
+
+bool CD3D11RHI::IsFrameCaptureToolAttached() const
+{
+	// PIX reports itself through D3DPERF, RenderDoc is injected into process as DLL
+	return D3DPERF_GetStatus() != 0 || GetModuleHandleW( L"renderdoc.dll" ) != nullptr;
+}
 #endif // FRAME_CAPTURE_MARKERS
 
 /**
@@ -1,5 +1,6 @@
 #include "Misc/UIGlobals.h"
 #include "UIEngine.h"
+#include "System/Malloc.h"
 
 #if WITH_IMGUI
 #include "ImGUI/ImGUIEngine.h"
@@ -7,6 +8,8 @@
 
 void CUIEngine::Init()
 {
+	SCOPED_MEMORY_TAG( MTAG_UI );
+
 #if WITH_IMGUI
 	GImGUIEngine->Init();
 #endif // WITH_IMGUI
@@ -14,6 +17,8 @@ void CUIEngine::Init()
 
 void CUIEngine::Tick( float InDeltaSeconds )
 {
+	SCOPED_MEMORY_TAG( MTAG_UI );
+
 #if WITH_IMGUI
 	GImGUIEngine->Tick( InDeltaSeconds );
 #endif // WITH_IMGUI
@@ -0,0 +1,35 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ACTORPOOLBENCHMARKCOMMANDLET_H
+#define ACTORPOOLBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for check reset of actors in actor pool (spawn, modify, release and spawn again must give actor with default state)
+ * and measure time of creating new actors against taking them from pool
+ * 
+ * Usage: -commandlet=ActorPoolBenchmark [-iterations=<number of runs>] [-actors=<number of actors in each run>]
+ */
+class CActorPoolBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CActorPoolBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !ACTORPOOLBENCHMARKCOMMANDLET_H
@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef ASSETLOOKUPBENCHMARKCOMMANDLET_H
+#define ASSETLOOKUPBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for measure costs of lookup asset by name with std::wstring keys (as it was before) and with CHashedString keys
+ * 
+ * Usage: -commandlet=AssetLookupBenchmark [-iterations=<number of iterations>] [-assets=<number of assets in table>]
+ */
+class CAssetLookupBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CAssetLookupBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !ASSETLOOKUPBENCHMARKCOMMANDLET_H
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef BENCHMARKHELPERS_H
+#define BENCHMARKHELPERS_H
+
+#include <string>
+
+#include "Misc/Misc.h"
+#include "Misc/CommandLine.h"
+#include "Logger/LoggerMacros.h"
+#include "Core.h"
+
+/**
+ * @ingroup WorldEd
+ * Sink for results of benchmarks, that compiler not throws out the code
+ */
+static volatile uint32		GBenchmarkSink = 0;
+
+/**
+ * @ingroup WorldEd
+ * Run benchmark and print result
+ *
+ * @param InName			Name of benchmark
+ * @param InIterations		Number of iterations
+ * @param InFunction		Function of one iteration
+ * @return Return time of one iteration in nanoseconds
+ */
+template< typename TFunction >
+FORCEINLINE double appRunBenchmark( const tchar* InName, uint32 InIterations, TFunction&& InFunction )
+{
+	double		startTime = appSeconds();
+	for ( uint32 index = 0; index < InIterations; ++index )
+	{
+		InFunction();
+	}
+	double		elapsedTime = appSeconds() - startTime;
+	double		timePerOp = elapsedTime * 1e9 / InIterations;
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "%-56s %8.2f ns/op (%.3f ms total)" ), InName, timePerOp, elapsedTime * 1000.0 );
+	return timePerOp;
+}
+
+/**
+ * @ingroup WorldEd
+ * Get number of iterations from command line (parameter -iterations=<number>)
+ *
+ * @param InCommandLine			Command line
+ * @param InDefaultIterations	Default number of iterations
+ * @return Return number of iterations
+ */
+FORCEINLINE uint32 appGetBenchmarkIterations( const CCommandLine& InCommandLine, uint32 InDefaultIterations )
+{
+	std::wstring		paramIterations = InCommandLine.GetFirstValue( TEXT( "iterations" ) );
+	if ( !paramIterations.empty() )
+	{
+		return Max( std::stoi( paramIterations ), 1 );
+	}
+	return InDefaultIterations;
+}
+
+#endif // !BENCHMARKHELPERS_H
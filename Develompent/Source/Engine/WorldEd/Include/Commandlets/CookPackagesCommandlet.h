@@ -35,6 +35,7 @@ struct STMXTileset
 	Vector2D						tileOffset;		/**< Offset of tile */
 	TAssetHandle<CMaterial>			material;		/**< Material of tileset */
 	std::vector< RectFloat_t >		textureRects;	/**< Array of rects with tiles */
+	std::vector< byte >				tileCollisions;	/**< Collision flag of each tile, it's set by bool property 'Collision' of tile in Tiled */
 };
 
  /**
@@ -336,6 +337,8 @@ private:
 
 	/**
 	 * @brief Spawn tiles in world
+	 * All tile layers are merged into one tilemap actor, solid tiles are marked by bool property 'Collision'
+	 * of tile in tileset or of whole layer
 	 * 
 	 * @param InTMXMap TMX map
 	 * @param InTilesets Array of tilesets
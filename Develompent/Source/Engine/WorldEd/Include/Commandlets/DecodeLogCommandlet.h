@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef DECODELOGCOMMANDLET_H
+#define DECODELOGCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for decode binary log (*.lbin) into text file
+ * 
+ * Usage: -commandlet=DecodeLog -src=<path to *.lbin> [-dst=<path to text file>]
+ */
+class CDecodeLogCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CDecodeLogCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !DECODELOGCOMMANDLET_H
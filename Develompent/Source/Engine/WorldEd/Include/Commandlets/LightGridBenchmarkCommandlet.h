@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef LIGHTGRIDBENCHMARKCOMMANDLET_H
+#define LIGHTGRIDBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for measure costs of binning lights into clustered light grid. It doesn't need render device
+ * 
+ * Usage: -commandlet=LightGridBenchmark [-iterations=<number of iterations>] [-lights=<number of lights>] [-radius=<max radius of light>]
+ */
+class CLightGridBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CLightGridBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !LIGHTGRIDBENCHMARKCOMMANDLET_H
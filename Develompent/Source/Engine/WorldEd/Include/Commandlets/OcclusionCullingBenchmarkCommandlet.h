@@ -0,0 +1,36 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef OCCLUSIONCULLINGBENCHMARKCOMMANDLET_H
+#define OCCLUSIONCULLINGBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for measure costs of software occlusion culling and check its results. It doesn't need render device
+ * 
+ * Wall and cubes are rasterized as occluders, bounds behind the wall must be culled and bounds in front of all occluders must stay visible
+ *
+ * Usage: -commandlet=OcclusionCullingBenchmark [-iterations=<number of iterations>] [-occluders=<number of cubes>] [-boxes=<number of tested bounds>]
+ */
+class COcclusionCullingBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( COcclusionCullingBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !OCCLUSIONCULLINGBENCHMARKCOMMANDLET_H
@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef SHAREDPTRBENCHMARKCOMMANDLET_H
+#define SHAREDPTRBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for measure costs of create, copy and destroy smart pointers in different thread modes
+ * 
+ * Usage: -commandlet=SharedPtrBenchmark [-iterations=<number of iterations>]
+ */
+class CSharedPtrBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CSharedPtrBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !SHAREDPTRBENCHMARKCOMMANDLET_H
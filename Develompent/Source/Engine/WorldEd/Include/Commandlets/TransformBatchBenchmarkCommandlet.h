@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef TRANSFORMBATCHBENCHMARKCOMMANDLET_H
+#define TRANSFORMBATCHBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for measure costs of converting transforms to matrices one by one with CTransform (as it was before) and with SMathBatch
+ * 
+ * Usage: -commandlet=TransformBatchBenchmark [-iterations=<number of iterations>] [-transforms=<number of transforms in batch>]
+ */
+class CTransformBatchBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CTransformBatchBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !TRANSFORMBATCHBENCHMARKCOMMANDLET_H
@@ -0,0 +1,34 @@
+/**
+ * @file
+ * @addtogroup WorldEd World editor
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef WORLDLOADBENCHMARKCOMMANDLET_H
+#define WORLDLOADBENCHMARKCOMMANDLET_H
+
+#include "Commandlets/BaseCommandlet.h"
+
+/**
+ * @ingroup WorldEd
+ * Commandlet for measure time of loading world with many actors in old format (name of class for each actor) and in new one (table of classes and blob with data of actors)
+ * 
+ * Usage: -commandlet=WorldLoadBenchmark [-iterations=<number of loads>] [-actors=<number of actors in world>]
+ */
+class CWorldLoadBenchmarkCommandlet : public CBaseCommandlet
+{
+	DECLARE_CLASS( CWorldLoadBenchmarkCommandlet, CBaseCommandlet )
+
+public:
+	/**
+	 * Main method of execute commandlet
+	 *
+	 * @param InCommandLine		Command line
+	 * @return Return TRUE if commandlet executed is seccussed, otherwise will return FALSE
+	 */
+	virtual bool Main( const CCommandLine& InCommandLine ) override;
+};
+
+#endif // !WORLDLOADBENCHMARKCOMMANDLET_H
@@ -228,6 +228,17 @@ private:
 	 */
 	static bool ParseMeshes( const std::wstring& InPath, std::vector<SMeshData>& OutResult, std::wstring& OutError );
 
+	/**
+	 * @brief Generate LODs of mesh
+	 * Function generates LODs with import settings in variable 'importSettings', verteces and indeces of LODs are added to the end of arrays
+	 *
+	 * @param InOutVerteces		Input verteces of the source mesh and output verteces of all LODs
+	 * @param InOutIndeces		Input indeces of the source mesh and output indeces of all LODs
+	 * @param InSurfaces		Surfaces of the source mesh
+	 * @param OutLODs			Output array of LODs, the first one is the source mesh
+	 */
+	static void GenerateLODs( std::vector<SStaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, std::vector<SStaticMeshLOD>& OutLODs );
+
 	/**
 	 * @brief Change axis up in vector
 	 *
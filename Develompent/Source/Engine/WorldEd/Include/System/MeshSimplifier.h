@@ -0,0 +1,43 @@
+/**
+ * @file
+ * @addtogroup WorldEd WorldEd
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#ifndef MESHSIMPLIFIER_H
+#define MESHSIMPLIFIER_H
+
+#include <vector>
+
+#include "Render/StaticMesh.h"
+
+/**
+ * @ingroup WorldEd
+ * @brief Simplifier of static meshes for generation of LODs
+ *
+ * It's vertex clustering: mesh is split by uniform grid and all verteces in one cell with similar normal are merged
+ * into one vertex of the source mesh, triangles which collapsed to a line or point are removed.
+ * Size of the grid is searched to get the biggest number of triangles which isn't more than requested
+ */
+class CMeshSimplifier
+{
+public:
+	/**
+	 * @brief Simplify mesh
+	 *
+	 * @param InVerteces			Verteces of mesh
+	 * @param InIndeces				Indeces of mesh
+	 * @param InSurfaces			Surfaces of mesh
+	 * @param InTargetPrimitives	Max number of primitives in simplified mesh
+	 * @param OutVerteces			Output verteces of simplified mesh
+	 * @param OutIndeces			Output indeces of simplified mesh
+	 * @param OutSurfaces			Output surfaces of simplified mesh, all of them begin from the first vertex. Surfaces without primitives are removed
+	 * @return Return TRUE if mesh is simplified, otherwise returns FALSE (nothing is left from mesh with this number of primitives)
+	 */
+	static bool Simplify( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, uint32 InTargetPrimitives,
+						  std::vector<SStaticMeshVertexType>& OutVerteces, std::vector<uint32>& OutIndeces, std::vector<SStaticMeshSurface>& OutSurfaces );
+};
+
+#endif // !MESHSIMPLIFIER_H
@@ -47,10 +47,18 @@ public:
 		SImportSettings()
 			: bCombineMeshes( false )
 			, axisUp( AU_PlusY )
+			, bGenerateLODs( true )
+			, numLODs( 4 )
+			, lodReduction( 0.5f )
+			, lodScreenSize( 0.3f )
 		{}
 
 		bool		bCombineMeshes;		/**< Is need combine all meshes to one */
 		EAxisUp		axisUp;				/**< Axis up */
+		bool		bGenerateLODs;		/**< Is need generate LODs by simplification of mesh */
+		int32		numLODs;			/**< Max number of LODs including the source mesh */
+		float		lodReduction;		/**< Part of triangles of the source mesh which is left in each next LOD */
+		float		lodScreenSize;		/**< Min radius of bounds on screen (1 is half of screen height) to draw the source mesh */
 	};
 
 	/**
@@ -14,6 +14,7 @@
 
 #include "Containers/StringConv.h"
 #include "Logger/LoggerMacros.h"
+#include "System/ThreadingBase.h"
 #include "ImGUI/ImGUIEngine.h"
 
 /**
@@ -41,6 +42,9 @@ public:
 		SLogInfo		logInfo;
 		logInfo.type = InLogType;
 		logInfo.message = TCHAR_TO_ANSI( InMessage );
+
+		// Messages may come from log thread when asynchronous logging is enabled
+		CScopeLock		scopeLock( historyCS );
 		history.push_back( logInfo );
 	}
 
@@ -67,6 +71,7 @@ private:
 	void ExecCommand( const std::string& InCommand );
 
 	std::vector<SLogInfo>	history;		/**< Array of log history */
+	CCriticalSection		historyCS;		/**< Critical section of log history */
 	std::string				commandBuffer;	/**< Command buffer */
 };
 
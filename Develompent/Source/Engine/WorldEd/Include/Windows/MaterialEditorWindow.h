@@ -84,6 +84,11 @@ private:
 	 */
 	void OnAssetsReloaded( const std::vector<TSharedPtr<CAsset>>& InAssets );
 
+	/**
+	 * @brief Called when rasterizer state of material is changed
+	 */
+	void OnRenderStateChanged();
+
 	/**
 	 * @brief Event called when need open asset editor
 	 *
@@ -0,0 +1,112 @@
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "System/ActorPool.h"
+#include "Logger/LoggerMacros.h"
+#include "Actors/Sprite.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/ActorPoolBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CActorPoolBenchmarkCommandlet )
+
+/**
+ * Is state of sprite actor equal to state of reference one
+ *
+ * @param InSprite		Sprite actor
+ * @param InReference	Never changed sprite actor
+ * @return Return TRUE if state is equal, otherwise returns FALSE
+ */
+static bool IsEqualSpriteState( ASprite* InSprite, ASprite* InReference )
+{
+	TRefCountPtr<CSpriteComponent>		spriteComponent = InSprite->GetSpriteComponent();
+	TRefCountPtr<CSpriteComponent>		referenceComponent = InReference->GetSpriteComponent();
+	const RectFloat_t&					textureRect = spriteComponent->GetTextureRect();
+	const RectFloat_t&					referenceTextureRect = referenceComponent->GetTextureRect();
+	return spriteComponent->GetRelativeLocation() == referenceComponent->GetRelativeLocation() &&
+		   spriteComponent->GetRelativeScale() == referenceComponent->GetRelativeScale() &&
+		   spriteComponent->IsVisibility() == referenceComponent->IsVisibility() &&
+		   spriteComponent->GetSpriteSize() == referenceComponent->GetSpriteSize() &&
+		   textureRect.left == referenceTextureRect.left && textureRect.top == referenceTextureRect.top &&
+		   textureRect.width == referenceTextureRect.width && textureRect.height == referenceTextureRect.height &&
+		   spriteComponent->IsFlipedVertical() == referenceComponent->IsFlipedVertical() &&
+		   spriteComponent->IsFlipedHorizontal() == referenceComponent->IsFlipedHorizontal();
+}
+
+bool CActorPoolBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32				numIterations = appGetBenchmarkIterations( InCommandLine, 5 );
+	uint32				numActors = 1000;
+	std::wstring		paramActors = InCommandLine.GetFirstValue( TEXT( "actors" ) );
+	if ( !paramActors.empty() )
+	{
+		numActors = Max( std::stoi( paramActors ), 1 );
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Actor pool benchmark, %i iterations, %i actors" ), numIterations, numActors );
+
+	CActorPool		actorPool;
+	actorPool.SetEnable( true );
+	actorPool.RegisterClass( ASprite::StaticClass(), numActors );
+
+	// Spawn, modify, release and spawn again, actor from pool must be in default state
+	ActorRef_t		referenceActor = ASprite::StaticClass()->CreateObject<ASprite>();
+	ActorRef_t		actor = ASprite::StaticClass()->CreateObject<ASprite>();
+	{
+		TRefCountPtr<CSpriteComponent>		spriteComponent = ( ( ASprite* )actor.GetPtr() )->GetSpriteComponent();
+		spriteComponent->SetRelativeLocation( Vector( 32.f, 64.f, 1.f ) );
+		spriteComponent->SetRelativeScale( Vector( 2.f, 2.f, 1.f ) );
+		spriteComponent->SetVisibility( false );
+		spriteComponent->SetSpriteSize( Vector2D( 7.f, 9.f ) );
+		spriteComponent->SetTextureRect( RectFloat_t( 0.25f, 0.25f, 0.5f, 0.5f ) );
+		spriteComponent->SetFlipVertical( true );
+		spriteComponent->SetFlipHorizontal( true );
+	}
+
+	if ( !actorPool.Release( actor ) || actorPool.Acquire( ASprite::StaticClass() ) != actor )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "Released actor isn't taken from pool" ) );
+		return false;
+	}
+
+	if ( !IsEqualSpriteState( ( ASprite* )actor.GetPtr(), ( ASprite* )referenceActor.GetPtr() ) )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "Actor from pool isn't reset to default state" ) );
+		return false;
+	}
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Actor from pool is reset to default state" ) );
+
+	// Measure time of creating new actors against taking them from pool
+	std::vector<ActorRef_t>		actors;
+	actors.reserve( numActors );
+	double		createTime = appRunBenchmark( TEXT( "Create new actors" ), numIterations, [&]()
+				  {
+					  for ( uint32 index = 0; index < numActors; ++index )
+					  {
+						  actors.push_back( ASprite::StaticClass()->CreateObject<ASprite>() );
+					  }
+					  GBenchmarkSink += ( uint32 )actors.size();
+					  actors.clear();
+				  } );
+
+	double		poolTime = appRunBenchmark( TEXT( "Take actors from pool" ), numIterations, [&]()
+				  {
+					  for ( uint32 index = 0; index < numActors; ++index )
+					  {
+						  ActorRef_t		pooledActor = actorPool.Acquire( ASprite::StaticClass() );
+						  actors.push_back( pooledActor ? pooledActor : ASprite::StaticClass()->CreateObject<ASprite>() );
+					  }
+					  GBenchmarkSink += ( uint32 )actors.size();
+
+					  for ( uint32 index = 0; index < numActors; ++index )
+					  {
+						  actorPool.Release( actors[ index ] );
+					  }
+					  actors.clear();
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Actor pool speedup: %.2fx" ), createTime / poolTime );
+
+	actorPool.DumpStats();
+	actorPool.Empty();
+	return true;
+}
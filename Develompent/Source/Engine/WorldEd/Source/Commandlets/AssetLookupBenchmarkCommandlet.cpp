@@ -0,0 +1,153 @@
+#include <vector>
+#include <unordered_map>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Misc/Guid.h"
+#include "Containers/String.h"
+#include "Containers/StringView.h"
+#include "Containers/HashedString.h"
+#include "System/Package.h"
+#include "Logger/LoggerMacros.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/AssetLookupBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CAssetLookupBenchmarkCommandlet )
+
+/**
+ * Parse reference to asset as it was before CStringView, each part is copied into std::wstring
+ *
+ * @param InString			Reference to asset
+ * @param OutPackageName	Output package name
+ * @param OutAssetName		Output asset name
+ * @param OutAssetType		Output asset type
+ * @return Return TRUE if reference is parsed, otherwise returns FALSE
+ */
+static bool ParseReferenceToAssetOld( const std::wstring& InString, std::wstring& OutPackageName, std::wstring& OutAssetName, EAssetType& OutAssetType )
+{
+	if ( InString.empty() )
+	{
+		return false;
+	}
+
+	// Divide the string into three parts: asset type, package name and asset name
+	uint32				offset						= 0;
+	std::size_t			posSpliterType				= InString.find( TEXT( "'" ) );
+	std::size_t			posSpliterPackageAndAsset	= InString.find( TEXT( ":" ) );
+	uint32				packageNameSize				= posSpliterPackageAndAsset - posSpliterType - 1;
+	uint32				assetNameSize				= InString.size() - posSpliterPackageAndAsset - 1;
+	if ( posSpliterType == std::wstring::npos || posSpliterPackageAndAsset == std::wstring::npos || packageNameSize <= 0 || assetNameSize <= 0 )
+	{
+		return false;
+	}
+
+	// Getting asset type
+	std::wstring		assetType;
+	assetType.resize( posSpliterType );
+	memcpy( assetType.data(), &InString[ 0 ], sizeof( std::wstring::value_type ) * assetType.size() );
+	offset = assetType.size() + 1;
+	OutAssetType = ConvertTextToAssetType( assetType );
+
+	// Getting package name
+	OutPackageName.resize( packageNameSize );
+	memcpy( OutPackageName.data(), &InString[ offset ], sizeof( std::wstring::value_type ) * packageNameSize );
+	offset += packageNameSize + 1;
+
+	// Getting asset name
+	OutAssetName.resize( assetNameSize );
+	memcpy( OutAssetName.data(), &InString[ offset ], sizeof( std::wstring::value_type ) * assetNameSize );
+	return true;
+}
+
+/**
+ * Run benchmarks of asset lookup for one set of asset names
+ *
+ * @param InSetName			Name of set
+ * @param InAssetNames		Asset names
+ * @param InIterations		Number of iterations
+ */
+static void RunAssetLookupBenchmarks( const tchar* InSetName, const std::vector<std::wstring>& InAssetNames, uint32 InIterations )
+{
+	// Fill tables of asset names to GUID, like in CPackage (old and new)
+	std::unordered_map<std::wstring, CGuid>												oldTable;
+	std::unordered_map<CHashedString, CGuid, CHashedString::SHashedStringKeyFunc>		newTable;
+	std::vector<std::wstring>															references;
+	for ( uint32 index = 0, count = InAssetNames.size(); index < count; ++index )
+	{
+		CGuid		guid( index + 1, 0, 0, 0 );
+		oldTable[ InAssetNames[ index ] ]	= guid;
+		newTable[ InAssetNames[ index ] ]	= guid;
+		references.push_back( CString::Format( TEXT( "Texture2D'Benchmark:%s" ), InAssetNames[ index ].c_str() ) );
+	}
+
+	// Lookup by name. Callers often have name as const tchar*, so in the old way temporary std::wstring is created on each call
+	uint32		nameIndex = 0;
+	double		oldTime = appRunBenchmark( CString::Format( TEXT( "[%s] Find name, std::wstring key" ), InSetName ).c_str(), InIterations, [&]()
+				  {
+					  const tchar*		name = InAssetNames[ nameIndex++ % InAssetNames.size() ].c_str();
+					  auto				itAsset = oldTable.find( name );
+					  GBenchmarkSink += itAsset != oldTable.end() ? ( uint32 )itAsset->second.IsValid() : 0;
+				  } );
+
+	nameIndex = 0;
+	double		newTime = appRunBenchmark( CString::Format( TEXT( "[%s] Find name, CHashedString key" ), InSetName ).c_str(), InIterations, [&]()
+				  {
+					  CStringView		name = InAssetNames[ nameIndex++ % InAssetNames.size() ].c_str();
+					  auto				itAsset = newTable.find( CHashedString::MakeLookupKey( name ) );
+					  GBenchmarkSink += itAsset != newTable.end() ? ( uint32 )itAsset->second.IsValid() : 0;
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "[%s] Find name speedup: %.2fx" ), InSetName, oldTime / newTime );
+
+	// Full path from parse reference to find in table
+	nameIndex = 0;
+	oldTime = appRunBenchmark( CString::Format( TEXT( "[%s] Parse reference + find, std::wstring" ), InSetName ).c_str(), InIterations, [&]()
+				  {
+					  std::wstring		packageName;
+					  std::wstring		assetName;
+					  EAssetType		assetType;
+					  ParseReferenceToAssetOld( references[ nameIndex++ % references.size() ], packageName, assetName, assetType );
+
+					  auto				itAsset = oldTable.find( assetName );
+					  GBenchmarkSink += itAsset != oldTable.end() ? ( uint32 )itAsset->second.IsValid() : 0;
+				  } );
+
+	nameIndex = 0;
+	newTime = appRunBenchmark( CString::Format( TEXT( "[%s] Parse reference + find, CStringView" ), InSetName ).c_str(), InIterations, [&]()
+				  {
+					  CStringView		packageName;
+					  CStringView		assetName;
+					  EAssetType		assetType;
+					  ParseReferenceToAsset( references[ nameIndex++ % references.size() ], packageName, assetName, assetType );
+
+					  auto				itAsset = newTable.find( CHashedString::MakeLookupKey( assetName ) );
+					  GBenchmarkSink += itAsset != newTable.end() ? ( uint32 )itAsset->second.IsValid() : 0;
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "[%s] Parse reference + find speedup: %.2fx" ), InSetName, oldTime / newTime );
+}
+
+bool CAssetLookupBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32				numIterations = appGetBenchmarkIterations( InCommandLine, 5000000 );
+	uint32				numAssets = 1000;
+	std::wstring		paramAssets = InCommandLine.GetFirstValue( TEXT( "assets" ) );
+	if ( !paramAssets.empty() )
+	{
+		numAssets = Max( std::stoi( paramAssets ), 1 );
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Asset lookup benchmark, %i iterations, %i assets" ), numIterations, numAssets );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "sizeof(std::wstring) = %i, sizeof(CHashedString) = %i, inline length = %i" ), ( uint32 )sizeof( std::wstring ), ( uint32 )sizeof( CHashedString ), HASHEDSTRING_INLINE_LENGTH );
+
+	// Short names fit into inline storage of CHashedString, long names not
+	std::vector<std::wstring>		shortNames;
+	std::vector<std::wstring>		longNames;
+	for ( uint32 index = 0; index < numAssets; ++index )
+	{
+		shortNames.push_back( CString::Format( TEXT( "T_Rock_%i" ), index ) );
+		longNames.push_back( CString::Format( TEXT( "T_Environment_Rocks_Mossy_Large_%i_Diffuse" ), index ) );
+	}
+
+	RunAssetLookupBenchmarks( TEXT( "Short" ), shortNames, numIterations );
+	RunAssetLookupBenchmarks( TEXT( "Long" ), longNames, numIterations );
+	return true;
+}
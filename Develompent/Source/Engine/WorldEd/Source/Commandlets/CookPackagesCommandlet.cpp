@@ -23,6 +23,7 @@
 // Actors
 #include "Actors/PlayerStart.h"
 #include "Actors/Sprite.h"
+#include "Actors/TileMap.h"
 
 // Vertex factories
 #include "Render/VertexFactory/StaticMeshVertexFactory.h"
@@ -36,6 +37,26 @@ IMPLEMENT_CLASS( CCookPackagesCommandlet )
 /** Default map extension */
 #define DEFAULT_MAP_EXTENSION			TEXT( "map" )
 
+/**
+ * Is TMX properties have bool property 'Collision' with TRUE value
+ *
+ * @param InProperties	Array of properties
+ * @return Return TRUE if property 'Collision' is enabled, otherwise returns FALSE
+ */
+static bool IsTMXCollisionEnabled( const std::vector< tmx::Property >& InProperties )
+{
+	for ( uint32 index = 0, count = InProperties.size(); index < count; ++index )
+	{
+		const tmx::Property&		property = InProperties[ index ];
+		if ( property.getName() == "Collision" && property.getType() == tmx::Property::Type::Boolean )
+		{
+			return property.getBoolValue();
+		}
+	}
+
+	return false;
+}
+
 /**
  * Struct of TMX object for spawn actor in world
  */
@@ -106,6 +127,16 @@ bool CCookPackagesCommandlet::CookMap( const SResourceInfo& InMapInfo )
 	// Spawn actors
 	SpawnActorsInWorld( tmxMap, tilesets );
 
+	// Split static actors into cells for streaming if it's enabled
+	SWorldPartitionSettings		worldPartitionSettings;
+	worldPartitionSettings.LoadFromConfig();
+	if ( worldPartitionSettings.bEnable )
+	{
+		CWorldPartition&		worldPartition = GWorld->GetWorldPartition();
+		worldPartition.ApplySettings( worldPartitionSettings );
+		worldPartition.Build();
+	}
+
 	// Serialize world to HDD
 	CArchive*		archive = GFileSystem->CreateFileWriter( CString::Format( TEXT( "%s") PATH_SEPARATOR TEXT( "%s.%s" ), GCookedDir.c_str(), InMapInfo.filename.c_str(), extensionInfo.map.c_str() ), AW_NoFail );
 	archive->SetType( AT_World );
@@ -185,6 +216,25 @@ bool CCookPackagesCommandlet::LoadTMXTilests( const tmx::Map& InTMXMap, std::vec
 			}
 		}
 
+		// Solid tiles of tileset
+		const std::vector< tmx::Tileset::Tile >&		tmxTiles = tmxTileset.getTiles();
+		tileset.tileCollisions.resize( tileset.textureRects.size(), 0 );
+		for ( uint32 indexTile = 0, countTiles = tmxTiles.size(); indexTile < countTiles; ++indexTile )
+		{
+			const tmx::Tileset::Tile&		tmxTile = tmxTiles[ indexTile ];
+			if ( tmxTile.ID < tileset.tileCollisions.size() && IsTMXCollisionEnabled( tmxTile.properties ) )
+			{
+				tileset.tileCollisions[ tmxTile.ID ] = 1;
+			}
+		}
+
+		// Tiles are rendered by tilemap with static mesh vertex factory
+		TSharedPtr<CMaterial>		tilesetMaterialRef = tilesetMaterial.ToSharedPtr();
+		if ( tilesetMaterialRef && !( tilesetMaterialRef->GetUsageFlags() & MU_StaticMesh ) )
+		{
+			LE_LOG( LT_Warning, LC_Commandlet, TEXT( "Material of tileset '%s' isn't used on static meshes, tiles with it will not be rendered" ), tmxTilesetName.c_str() );
+		}
+
 		OutTilesets.push_back( tileset );
 	}
 
@@ -214,12 +264,23 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 	const std::vector< tmx::Layer::Ptr >&		tmxLayers	= InTMXMap.getLayers();
 	const tmx::Vector2u&						mapSize		= InTMXMap.getTileCount();
 	const tmx::Vector2u&						mapTileSize = InTMXMap.getTileSize();
+	uint32										numTiles	= mapSize.x * mapSize.y;
+	uint32										numUsedTiles = 0;
+
+	// Layers of tilemap keep only IDs of tiles, all layers are in one actor
+	std::vector< STileMapLayer >				layers;
+	std::vector< byte >							collision( numTiles, 0 );
 	for ( uint32 indexLayer = 0, countLayers = tmxLayers.size(); indexLayer < countLayers; ++indexLayer )
 	{
 		if ( tmxLayers[ indexLayer ]->getType() == tmx::Layer::Type::Tile )
 		{
 			tmx::TileLayer*									tmxLayer = ( tmx::TileLayer* )tmxLayers[ indexLayer ].get();
 			const std::vector< tmx::TileLayer::Tile >&		tmxTiles = tmxLayer->getTiles();
+			bool											bLayerCollision = IsTMXCollisionEnabled( tmxLayer->getProperties() );
+
+			STileMapLayer		layer;
+			layer.depth			= indexLayer;
+			layer.tiles.resize( numTiles, 0 );
 
 			int32		x = 0;
 			int32		y = mapSize.y-1;
@@ -228,20 +289,25 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 				const tmx::TileLayer::Tile&			tile = tmxTiles[ indexTile ];
 				if ( tile.ID != 0 )
 				{
-					// Find material for tile
-					STMXTileset		tileset;
-					RectFloat_t		textureRect;
-					bool			result = FindTileset( InTilesets, tile.ID, tileset, textureRect );
-					checkMsg( result, TEXT( "Not founded tileset for tile with ID %i" ), tile.ID );
-
-					ASprite*			sprite				= GWorld->SpawnActor< ASprite >( Vector( x * mapTileSize.x, y * mapTileSize.y, indexLayer ) );					
-					CSpriteComponent*	spriteComponent		= sprite->GetSpriteComponent();
-					spriteComponent->SetType( ST_Static );
-					spriteComponent->SetMaterial( tileset.material );
-					spriteComponent->SetSpriteSize( Vector2D( tileset.tileSize.x, tileset.tileSize.y ) );
-					spriteComponent->SetTextureRect( textureRect );
-					sprite->SetName( TEXT( "ASprite_Tile" ) );
-					sprite->SetStatic( true );
+					// Find tileset of tile
+					uint32		indexTileset = 0;
+					for ( uint32 countTilesets = InTilesets.size(); indexTileset < countTilesets; ++indexTileset )
+					{
+						if ( tile.ID >= InTilesets[ indexTileset ].firstGID && tile.ID <= InTilesets[ indexTileset ].lastGID )
+						{
+							break;
+						}
+					}
+					checkMsg( indexTileset < InTilesets.size(), TEXT( "Not founded tileset for tile with ID %i" ), tile.ID );
+
+					const STMXTileset&		tileset = InTilesets[ indexTileset ];
+					uint32					tileIndex = y * mapSize.x + x;
+					layer.tiles[ tileIndex ] = tile.ID;
+					if ( bLayerCollision || tileset.tileCollisions[ tile.ID - tileset.firstGID ] )
+					{
+						collision[ tileIndex ] = 1;
+					}
+					++numUsedTiles;
 				}
 
 				++x;
@@ -251,8 +317,34 @@ void CCookPackagesCommandlet::SpawnTilesInWorld( const tmx::Map& InTMXMap, const
 					--y;
 				}
 			}
+
+			layers.push_back( layer );
 		}
 	}
+
+	if ( numUsedTiles == 0 )
+	{
+		return;
+	}
+
+	// Tilesets of tilemap
+	std::vector< STileMapTileset >		tilesets( InTilesets.size() );
+	for ( uint32 index = 0, count = InTilesets.size(); index < count; ++index )
+	{
+		tilesets[ index ].firstTileId	= InTilesets[ index ].firstGID;
+		tilesets[ index ].tileSize		= InTilesets[ index ].tileSize;
+		tilesets[ index ].material		= InTilesets[ index ].material;
+		tilesets[ index ].textureRects	= InTilesets[ index ].textureRects;
+	}
+
+	TileMapRef_t		tileMap = new CTileMap();
+	tileMap->SetData( mapSize.x, mapSize.y, Vector2D( mapTileSize.x, mapTileSize.y ), tilesets, layers, collision );
+
+	ATileMap*			tileMapActor = GWorld->SpawnActor< ATileMap >( SMath::vectorZero );
+	tileMapActor->GetTileMapComponent()->SetTileMap( tileMap );
+	tileMapActor->SetName( TEXT( "ATileMap_Tiles" ) );
+	tileMapActor->SetStatic( true );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Tilemap: %i tiles in %i layers, %i chunks" ), numUsedTiles, ( uint32 )layers.size(), ( uint32 )tileMap->GetChunks().size() );
 }
 
 void CCookPackagesCommandlet::SpawnActorsInWorld( const tmx::Map& InTMXMap, const std::vector<STMXTileset>& InTileset )
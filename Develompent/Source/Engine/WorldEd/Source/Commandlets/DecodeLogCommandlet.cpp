@@ -0,0 +1,117 @@
+#include <unordered_map>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Misc/CoreGlobals.h"
+#include "Logger/LoggerMacros.h"
+#include "Logger/LogRecord.h"
+#include "Logger/AsyncLogBackend.h"
+#include "System/BaseFileSystem.h"
+#include "System/Archive.h"
+#include "Containers/String.h"
+#include "Commandlets/DecodeLogCommandlet.h"
+
+IMPLEMENT_CLASS( CDecodeLogCommandlet )
+
+bool CDecodeLogCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	std::wstring		srcFilename = InCommandLine.GetFirstValue( TEXT( "src" ) );
+	std::wstring		dstFilename = InCommandLine.GetFirstValue( TEXT( "dst" ) );
+	if ( srcFilename.empty() )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "Not entered source file name. Usage: -commandlet=DecodeLog -src=<path to *.lbin> [-dst=<path to text file>]" ) );
+		return false;
+	}
+
+	// If destination file not entered, write near with binary log
+	if ( dstFilename.empty() )
+	{
+		dstFilename = srcFilename;
+		std::size_t		dotPos = dstFilename.find_last_of( TEXT( "." ) );
+		if ( dotPos != std::wstring::npos )
+		{
+			dstFilename.erase( dotPos );
+		}
+		dstFilename += TEXT( "-decoded.log" );
+	}
+
+	CArchive*		archiveSrc = GFileSystem->CreateFileReader( srcFilename );
+	if ( !archiveSrc )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "Failed to open binary log '%s'" ), srcFilename.c_str() );
+		return false;
+	}
+
+	archiveSrc->SerializeHeader();
+	if ( archiveSrc->Type() != AT_BinaryLog )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "File '%s' isn't binary log" ), srcFilename.c_str() );
+		delete archiveSrc;
+		return false;
+	}
+
+	CArchive*		archiveDst = GFileSystem->CreateFileWriter( dstFilename, AW_NoFail );
+	archiveDst->SetType( AT_TextFile );
+
+	// Read chunks and format records
+	std::unordered_map< uint32, std::wstring >		formats;
+	std::vector< byte >								recordBuffer;
+	uint32											numRecords = 0;
+	while ( !archiveSrc->IsEndOfFile() && archiveSrc->Tell() < archiveSrc->GetSize() )
+	{
+		uint8		chunkType = 0;
+		*archiveSrc << chunkType;
+		switch ( chunkType )
+		{
+		case LBC_Format:
+		{
+			uint32			formatId = 0;
+			std::wstring	format;
+			*archiveSrc << formatId;
+			*archiveSrc << format;
+			formats[ formatId ] = format;
+			break;
+		}
+
+		case LBC_Record:
+		{
+			uint32		recordSize = 0;
+			*archiveSrc << recordSize;
+			if ( recordSize < sizeof( SLogRecordHeader ) )
+			{
+				LE_LOG( LT_Error, LC_Commandlet, TEXT( "Broken record with size %i at offset %i" ), recordSize, archiveSrc->Tell() );
+				delete archiveSrc;
+				delete archiveDst;
+				return false;
+			}
+
+			recordBuffer.resize( recordSize );
+			archiveSrc->Serialize( recordBuffer.data(), recordSize );
+
+			const SLogRecordHeader*		record = ( const SLogRecordHeader* )recordBuffer.data();
+			const tchar*				format = nullptr;
+			if ( record->formatId != LOG_DYNAMIC_FORMAT_ID )
+			{
+				auto		itFormat = formats.find( record->formatId );
+				format = itFormat != formats.end() ? itFormat->second.c_str() : TEXT( "<Unknown format>" );
+			}
+
+			std::wstring		message = CString::Format( TEXT( "[%07.2f][%s][%s] %s\n" ), record->time, GLogTypeNames[ record->type ], GLogCategoryNames[ record->category ], appFormatLogRecord( record, format ).c_str() );
+			*archiveDst << message;
+			++numRecords;
+			break;
+		}
+
+		default:
+			LE_LOG( LT_Error, LC_Commandlet, TEXT( "Unknown chunk %i at offset %i" ), chunkType, archiveSrc->Tell() );
+			delete archiveSrc;
+			delete archiveDst;
+			return false;
+		}
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Decoded %i records into '%s'" ), numRecords, dstFilename.c_str() );
+	delete archiveSrc;
+	delete archiveDst;
+	return true;
+}
@@ -0,0 +1,103 @@
+#include <vector>
+#include <cstdlib>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Math/Math.h"
+#include "Logger/LoggerMacros.h"
+#include "Render/LightGrid.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/LightGridBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CLightGridBenchmarkCommandlet )
+
+/**
+ * Get random float in range
+ *
+ * @param InMin		Min value
+ * @param InMax		Max value
+ * @return Return random float in range [InMin, InMax]
+ */
+static FORCEINLINE float GetRandomFloat( float InMin, float InMax )
+{
+	return InMin + ( InMax - InMin ) * ( ( float )std::rand() / RAND_MAX );
+}
+
+/**
+ * Run benchmark of light grid with one projection and print statistics of clusters
+ *
+ * @param InName				Name of benchmark
+ * @param InNumIterations		Number of iterations
+ * @param InViewMatrix			View matrix
+ * @param InProjectionMatrix	Projection matrix
+ * @param InLights				Lights
+ */
+static void RunLightGridBenchmark( const tchar* InName, uint32 InNumIterations, const Matrix& InViewMatrix, const Matrix& InProjectionMatrix, const std::vector<SLightGridLight>& InLights )
+{
+	CLightGrid		lightGrid;
+	appRunBenchmark( InName, InNumIterations, [&]()
+					 {
+						 lightGrid.Build( InViewMatrix, InProjectionMatrix, InLights );
+						 GBenchmarkSink += lightGrid.GetNumLightIndeces();
+					 } );
+
+	// Lights per cluster is number of lights each pixel of cluster shades, volume pass shades pixel by each light covering it on screen
+	const std::vector<float>&	clusterData = lightGrid.GetClusterData();
+	uint32						numClusters = ( uint32 )clusterData.size() / 2;
+	uint32						numUsedClusters = 0;
+	uint32						maxClusterLights = 0;
+	for ( uint32 index = 0; index < numClusters; ++index )
+	{
+		uint32		numClusterLights = ( uint32 )clusterData[ index * 2 + 1 ];
+		numUsedClusters += numClusterLights > 0 ? 1 : 0;
+		maxClusterLights = Max( maxClusterLights, numClusterLights );
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "  %i lights in grid, %i light indeces, %i of %i clusters with lights, %.2f lights per used cluster, max %i" ),
+			lightGrid.GetNumLights(), lightGrid.GetNumLightIndeces(), numUsedClusters, numClusters, numUsedClusters > 0 ? ( float )lightGrid.GetNumLightIndeces() / numUsedClusters : 0.f, maxClusterLights );
+}
+
+bool CLightGridBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32				numIterations = appGetBenchmarkIterations( InCommandLine, 1000 );
+	uint32				numLights = 512;
+	float				maxRadius = 400.f;
+	std::wstring		paramLights = InCommandLine.GetFirstValue( TEXT( "lights" ) );
+	if ( !paramLights.empty() )
+	{
+		numLights = Max( std::stoi( paramLights ), 1 );
+	}
+
+	std::wstring		paramRadius = InCommandLine.GetFirstValue( TEXT( "radius" ) );
+	if ( !paramRadius.empty() )
+	{
+		maxRadius = Max( std::stof( paramRadius ), 1.f );
+	}
+
+	SLightGridSettings	settings;
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Light grid benchmark, %i iterations, %i lights, max radius %.1f, grid %ix%ix%i" ), numIterations, numLights, maxRadius, settings.numClustersX, settings.numClustersY, settings.numClustersZ );
+
+	// Random lights in front of camera, a quarter of them are spot lights. Seed is fixed for the same data in every run
+	std::srand( 0 );
+	std::vector<SLightGridLight>		lights( numLights );
+	for ( uint32 index = 0; index < numLights; ++index )
+	{
+		SLightGridLight&	light = lights[ index ];
+		light.position		= Vector( GetRandomFloat( -5000.f, 5000.f ), GetRandomFloat( -3000.f, 3000.f ), GetRandomFloat( 500.f, 10000.f ) );
+		light.radius		= GetRandomFloat( maxRadius * 0.25f, maxRadius );
+		light.color			= Vector( 1.f, 1.f, 1.f );
+		if ( index % 4 == 0 )
+		{
+			float		outerConeAngle	= GetRandomFloat( 20.f, 45.f );
+			light.direction				= glm::normalize( Vector( GetRandomFloat( -1.f, 1.f ), GetRandomFloat( -1.f, 1.f ), GetRandomFloat( -1.f, 1.f ) ) + Vector( 0.f, 0.f, 0.01f ) );
+			light.cosInnerCone			= SMath::Cos( SMath::DegreesToRadians( outerConeAngle * 0.75f ) );
+			light.cosOuterCone			= SMath::Cos( SMath::DegreesToRadians( outerConeAngle ) );
+		}
+	}
+
+	// Camera looks along axis Z, like in game viewport
+	Matrix		viewMatrix = glm::lookAt( Vector( 0.f, 0.f, 0.f ), Vector( 0.f, 0.f, 1.f ), Vector( 0.f, 1.f, 0.f ) );
+	RunLightGridBenchmark( TEXT( "Build light grid, perspective" ), numIterations, viewMatrix, glm::perspective( SMath::DegreesToRadians( 90.f ), 16.f / 9.f, 1.f, 20000.f ), lights );
+	RunLightGridBenchmark( TEXT( "Build light grid, orthographic" ), numIterations, viewMatrix, glm::ortho( -5000.f, 5000.f, -2812.5f, 2812.5f, 1.f, 20000.f ), lights );
+	return true;
+}
@@ -0,0 +1,173 @@
+#include <vector>
+#include <cstdlib>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Math/Math.h"
+#include "Logger/LoggerMacros.h"
+#include "Render/OcclusionCulling.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/OcclusionCullingBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( COcclusionCullingBenchmarkCommandlet )
+
+/**
+ * Get random float in range
+ *
+ * @param InMin		Min value
+ * @param InMax		Max value
+ * @return Return random float in range [InMin, InMax]
+ */
+static FORCEINLINE float GetRandomFloat( float InMin, float InMax )
+{
+	return InMin + ( InMax - InMin ) * ( ( float )std::rand() / RAND_MAX );
+}
+
+/**
+ * Occluder of benchmark
+ */
+struct SBenchmarkOccluder
+{
+	Matrix						localToWorld;	/**< Local to world matrix */
+	const std::vector<Vector4D>*	verteces;		/**< Verteces */
+	const std::vector<uint32>*		indeces;		/**< Indeces */
+};
+
+bool COcclusionCullingBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32				numIterations = appGetBenchmarkIterations( InCommandLine, 1000 );
+	uint32				numCubes = 31;
+	uint32				numBoxes = 4096;
+	std::wstring		paramOccluders = InCommandLine.GetFirstValue( TEXT( "occluders" ) );
+	if ( !paramOccluders.empty() )
+	{
+		numCubes = Max( std::stoi( paramOccluders ), 0 );
+	}
+
+	std::wstring		paramBoxes = InCommandLine.GetFirstValue( TEXT( "boxes" ) );
+	if ( !paramBoxes.empty() )
+	{
+		numBoxes = Max( std::stoi( paramBoxes ), 2 );
+	}
+
+	SOcclusionCullingSettings	settings;
+	settings.maxOccluders			= numCubes + 1;
+	settings.maxOccluderTriangles	= Max<uint32>( settings.maxOccluderTriangles, settings.maxOccluders * 12 );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Occlusion culling benchmark, %i iterations, %i occluders, %i bounds, buffer %ix%i" ), numIterations, settings.maxOccluders, numBoxes, settings.sizeX, settings.sizeY );
+
+	// Geometry of occluders, unit quad and unit cube with center in origin
+	const std::vector<Vector4D>		quadVerteces = { Vector4D( -0.5f, -0.5f, 0.f, 1.f ), Vector4D( 0.5f, -0.5f, 0.f, 1.f ), Vector4D( 0.5f, 0.5f, 0.f, 1.f ), Vector4D( -0.5f, 0.5f, 0.f, 1.f ) };
+	const std::vector<uint32>		quadIndeces = { 0, 1, 2, 0, 2, 3 };
+	std::vector<Vector4D>			cubeVerteces;
+	for ( uint32 index = 0; index < 8; ++index )
+	{
+		cubeVerteces.push_back( Vector4D( index & 1 ? 0.5f : -0.5f, index & 2 ? 0.5f : -0.5f, index & 4 ? 0.5f : -0.5f, 1.f ) );
+	}
+	const std::vector<uint32>		cubeIndeces = { 0, 2, 1, 1, 2, 3,		4, 5, 6, 5, 7, 6,		0, 1, 4, 1, 5, 4,
+													2, 6, 3, 3, 6, 7,		0, 4, 2, 2, 4, 6,		1, 3, 5, 3, 7, 5 };
+
+	// Wall behind all cubes covers screen, cubes are between camera and wall. Seed is fixed for the same data in every run
+	std::srand( 0 );
+	std::vector<SBenchmarkOccluder>		occluders;
+	occluders.push_back( SBenchmarkOccluder{ SMath::TranslateMatrix( Vector( 0.f, 0.f, 2000.f ) ) * SMath::ScaleMatrix( Vector( 6000.f, 6000.f, 1.f ) ), &quadVerteces, &quadIndeces } );
+	for ( uint32 index = 0; index < numCubes; ++index )
+	{
+		Vector		location( GetRandomFloat( -1500.f, 1500.f ), GetRandomFloat( -800.f, 800.f ), GetRandomFloat( 700.f, 1500.f ) );
+		occluders.push_back( SBenchmarkOccluder{ SMath::TranslateMatrix( location ) * SMath::ScaleMatrix( Vector( GetRandomFloat( 100.f, 300.f ) ) ), &cubeVerteces, &cubeIndeces } );
+	}
+
+	// Half of bounds is behind the wall and must be culled, other half is in front of all occluders and must be visible
+	std::vector<CBox>		boxes( numBoxes );
+	uint32					numBehindBoxes = numBoxes / 2;
+	for ( uint32 index = 0; index < numBoxes; ++index )
+	{
+		bool		bBehind = index < numBehindBoxes;
+		Vector		location( GetRandomFloat( -2500.f, 2500.f ), GetRandomFloat( -1500.f, 1500.f ), bBehind ? GetRandomFloat( 2200.f, 10000.f ) : GetRandomFloat( 100.f, 400.f ) );
+		boxes[ index ] = CBox::BuildAABB( location, Vector( GetRandomFloat( 20.f, 100.f ) ) );
+	}
+
+	// Camera looks along axis Z, like in game viewport
+	Matrix					viewProjectionMatrix = glm::perspective( SMath::DegreesToRadians( 90.f ), 16.f / 9.f, 1.f, 20000.f ) * glm::lookAt( Vector( 0.f, 0.f, 0.f ), Vector( 0.f, 0.f, 1.f ), Vector( 0.f, 1.f, 0.f ) );
+	COcclusionBuffer		occlusionBuffer;
+	occlusionBuffer.SetSettings( settings );
+	appRunBenchmark( TEXT( "Rasterize occluders" ), numIterations, [&]()
+					 {
+						 occlusionBuffer.Begin( viewProjectionMatrix );
+						 for ( uint32 index = 0, count = occluders.size(); index < count; ++index )
+						 {
+							 const SBenchmarkOccluder&		occluder = occluders[ index ];
+							 occlusionBuffer.AddOccluder( occluder.localToWorld, occluder.verteces->data(), occluder.verteces->size(), occluder.indeces->data(), occluder.indeces->size() );
+						 }
+						 occlusionBuffer.Rasterize();
+						 GBenchmarkSink += occlusionBuffer.GetStats().numOccluderTriangles;
+					 } );
+
+	std::vector<uint8>		visibility( numBoxes );
+	appRunBenchmark( TEXT( "Test bounds" ), numIterations, [&]()
+					 {
+						 occlusionBuffer.TestVisibility( boxes.data(), numBoxes, visibility.data() );
+						 GBenchmarkSink += visibility[ 0 ];
+					 } );
+
+	// Check results
+	uint32		numCulledBehind = 0;
+	uint32		numCulledInFront = 0;
+	for ( uint32 index = 0; index < numBoxes; ++index )
+	{
+		if ( visibility[ index ] )
+		{
+			continue;
+		}
+
+		if ( index < numBehindBoxes )
+		{
+			++numCulledBehind;
+		}
+		else
+		{
+			++numCulledInFront;
+		}
+	}
+
+	const SOcclusionCullingStats&	stats = occlusionBuffer.GetStats();
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "  %i occluders, %i triangles, %i of %i bounds behind the wall are culled, %i of %i bounds in front of occluders are culled" ),
+			stats.numOccluders, stats.numOccluderTriangles, numCulledBehind, numBehindBoxes, numCulledInFront, numBoxes - numBehindBoxes );
+
+	if ( numCulledInFront > 0 || numCulledBehind < numBehindBoxes )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "Occlusion culling gives wrong results" ) );
+		return false;
+	}
+
+	// Bounds behind the wall just past its edge must be visible. Edge of the wall crosses texel after its center,
+	// and bounds cover only the part of this texel which is outside of the wall
+	const float		aspectRatio		= 16.f / 9.f;
+	const float		wallDepth		= 2000.f;
+	const float		boxDepth		= 3000.f;
+	const float		edgeOffset		= 32.7f;		// Offset of the wall edge from center of buffer in texels
+	const float		texelToNDC		= 2.f / settings.sizeX;
+	const float		wallSize		= edgeOffset * texelToNDC * wallDepth * aspectRatio * 2.f;
+	const float		boxMinX			= 32.75f * texelToNDC * boxDepth * aspectRatio;
+	const float		boxMaxX			= 32.9f * texelToNDC * boxDepth * aspectRatio;
+	const CBox		edgeBoxes[]		=
+	{
+		CBox( Vector( boxMinX, -10.f, boxDepth - 1.f ), Vector( boxMaxX, 10.f, boxDepth + 1.f ) ),
+		CBox( Vector( -boxMaxX, -10.f, boxDepth - 1.f ), Vector( -boxMinX, 10.f, boxDepth + 1.f ) )
+	};
+
+	occlusionBuffer.Begin( viewProjectionMatrix );
+	occlusionBuffer.AddOccluder( SMath::TranslateMatrix( Vector( 0.f, 0.f, wallDepth ) ) * SMath::ScaleMatrix( Vector( wallSize, wallSize, 1.f ) ), quadVerteces.data(), quadVerteces.size(), quadIndeces.data(), quadIndeces.size() );
+	occlusionBuffer.Rasterize();
+
+	uint8			edgeVisibility[ ARRAY_COUNT( edgeBoxes ) ];
+	occlusionBuffer.TestVisibility( edgeBoxes, ARRAY_COUNT( edgeBoxes ), edgeVisibility );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "  bounds past the edges of the wall are %s and %s" ),
+			edgeVisibility[ 0 ] ? TEXT( "visible" ) : TEXT( "culled" ), edgeVisibility[ 1 ] ? TEXT( "visible" ) : TEXT( "culled" ) );
+
+	if ( !edgeVisibility[ 0 ] || !edgeVisibility[ 1 ] )
+	{
+		LE_LOG( LT_Error, LC_Commandlet, TEXT( "Occlusion culling culls bounds past the edge of occluder" ) );
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,131 @@
+#include <vector>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Misc/SharedPointer.h"
+#include "Misc/RefCounted.h"
+#include "Misc/RefCountPtr.h"
+#include "Logger/LoggerMacros.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/SharedPtrBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CSharedPtrBenchmarkCommandlet )
+
+/**
+ * Object for benchmark of shared pointers
+ */
+struct SBenchmarkObject
+{
+	/**
+	 * Constructor
+	 */
+	SBenchmarkObject()
+		: value( 1 )
+	{}
+
+	uint32		value;		/**< Some value */
+};
+
+/**
+ * Object for benchmark of intrusive pointers
+ */
+template< ESPMode Mode >
+class TBenchmarkRefCountedObject : public TRefCounted<Mode>
+{
+public:
+	/**
+	 * Constructor
+	 */
+	TBenchmarkRefCountedObject()
+		: value( 1 )
+	{}
+
+	uint32		value;		/**< Some value */
+};
+
+/**
+ * Handle like TAssetHandle: weak pointer to object and shared pointer to reference
+ */
+template< ESPMode Mode >
+struct TBenchmarkHandle
+{
+	TWeakPtr<SBenchmarkObject, Mode>		object;			/**< Weak pointer to object */
+	TSharedPtr<SBenchmarkObject, Mode>		reference;		/**< Shared pointer to reference */
+};
+
+/**
+ * Run benchmarks of shared pointer in one thread mode
+ *
+ * @param InModeName		Name of thread mode
+ * @param InIterations		Number of iterations
+ */
+template< ESPMode Mode >
+static void RunSharedPtrBenchmarks( const tchar* InModeName, uint32 InIterations )
+{
+	TSharedPtr<SBenchmarkObject, Mode>		sharedPtr = MakeSharedPtr<SBenchmarkObject, Mode>();
+	TBenchmarkHandle<Mode>					handle;
+	handle.object		= sharedPtr;
+	handle.reference	= sharedPtr;
+
+	appRunBenchmark( CString::Format( TEXT( "[%s] MakeSharedPtr + destroy" ), InModeName ).c_str(), InIterations, [&]()
+				  {
+					  TSharedPtr<SBenchmarkObject, Mode>		newSharedPtr = MakeSharedPtr<SBenchmarkObject, Mode>();
+					  GBenchmarkSink += newSharedPtr->value;
+				  } );
+
+	appRunBenchmark( CString::Format( TEXT( "[%s] TSharedPtr copy + destroy" ), InModeName ).c_str(), InIterations, [&]()
+				  {
+					  TSharedPtr<SBenchmarkObject, Mode>		copySharedPtr = sharedPtr;
+					  GBenchmarkSink += copySharedPtr->value;
+				  } );
+
+	appRunBenchmark( CString::Format( TEXT( "[%s] TWeakPtr pin + destroy" ), InModeName ).c_str(), InIterations, [&]()
+				  {
+					  TSharedPtr<SBenchmarkObject, Mode>		pinnedPtr = handle.object.Pin();
+					  GBenchmarkSink += pinnedPtr->value;
+				  } );
+
+	appRunBenchmark( CString::Format( TEXT( "[%s] Asset handle copy + destroy" ), InModeName ).c_str(), InIterations, [&]()
+				  {
+					  TBenchmarkHandle<Mode>		copyHandle = handle;
+					  GBenchmarkSink += copyHandle.reference->value;
+				  } );
+}
+
+/**
+ * Run benchmarks of intrusive pointer in one thread mode
+ *
+ * @param InModeName		Name of thread mode
+ * @param InIterations		Number of iterations
+ */
+template< ESPMode Mode >
+static void RunRefCountPtrBenchmarks( const tchar* InModeName, uint32 InIterations )
+{
+	TRefCountPtr< TBenchmarkRefCountedObject<Mode> >		refCountPtr = new TBenchmarkRefCountedObject<Mode>();
+
+	appRunBenchmark( CString::Format( TEXT( "[%s] TRefCountPtr new + destroy" ), InModeName ).c_str(), InIterations, [&]()
+				  {
+					  TRefCountPtr< TBenchmarkRefCountedObject<Mode> >		newRefCountPtr = new TBenchmarkRefCountedObject<Mode>();
+					  GBenchmarkSink += newRefCountPtr->value;
+				  } );
+
+	appRunBenchmark( CString::Format( TEXT( "[%s] TRefCountPtr copy + destroy" ), InModeName ).c_str(), InIterations, [&]()
+				  {
+					  TRefCountPtr< TBenchmarkRefCountedObject<Mode> >		copyRefCountPtr = refCountPtr;
+					  GBenchmarkSink += copyRefCountPtr->value;
+				  } );
+}
+
+bool CSharedPtrBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32		numIterations = appGetBenchmarkIterations( InCommandLine, 10000000 );
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Smart pointers benchmark, %i iterations" ), numIterations );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "sizeof(TSharedPtr) = %i, sizeof(TWeakPtr) = %i, sizeof(TRefCountPtr) = %i" ), ( uint32 )sizeof( TSharedPtr<SBenchmarkObject> ), ( uint32 )sizeof( TWeakPtr<SBenchmarkObject> ), ( uint32 )sizeof( TRefCountPtr<CRefCounted> ) );
+
+	RunSharedPtrBenchmarks<SPM_ThreadSafe>( TEXT( "ThreadSafe" ), numIterations );
+	RunSharedPtrBenchmarks<SPM_NotThreadSafe>( TEXT( "NotThreadSafe" ), numIterations );
+	RunRefCountPtrBenchmarks<SPM_ThreadSafe>( TEXT( "ThreadSafe" ), numIterations );
+	RunRefCountPtrBenchmarks<SPM_NotThreadSafe>( TEXT( "NotThreadSafe" ), numIterations );
+	return true;
+}
@@ -0,0 +1,175 @@
+#include <vector>
+#include <cstdlib>
+
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Math/Math.h"
+#include "Math/Transform.h"
+#include "Math/TransformBatch.h"
+#include "Logger/LoggerMacros.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/TransformBatchBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CTransformBatchBenchmarkCommandlet )
+
+/**
+ * Get random float in range
+ *
+ * @param InMin		Min value
+ * @param InMax		Max value
+ * @return Return random float in range [InMin, InMax]
+ */
+static FORCEINLINE float GetRandomFloat( float InMin, float InMax )
+{
+	return InMin + ( InMax - InMin ) * ( ( float )std::rand() / RAND_MAX );
+}
+
+/**
+ * Get max difference between two arrays of matrices
+ *
+ * @param InMatricesA	First array
+ * @param InMatricesB	Second array
+ * @return Return max absolute difference between elements
+ */
+static float GetMaxMatrixError( const std::vector<Matrix>& InMatricesA, const std::vector<Matrix>& InMatricesB )
+{
+	float		maxError = 0.f;
+	for ( uint32 index = 0, count = ( uint32 )InMatricesA.size(); index < count; ++index )
+	{
+		for ( uint32 column = 0; column < 4; ++column )
+		{
+			for ( uint32 row = 0; row < 4; ++row )
+			{
+				maxError = Max( maxError, SMath::Abs( InMatricesA[ index ][ column ][ row ] - InMatricesB[ index ][ column ][ row ] ) );
+			}
+		}
+	}
+	return maxError;
+}
+
+bool CTransformBatchBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32				numIterations = appGetBenchmarkIterations( InCommandLine, 1000 );
+	uint32				numTransforms = 10000;
+	std::wstring		paramTransforms = InCommandLine.GetFirstValue( TEXT( "transforms" ) );
+	if ( !paramTransforms.empty() )
+	{
+		numTransforms = Max( std::stoi( paramTransforms ), 1 );
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Transform batch benchmark, %i iterations, %i transforms, SIMD %s" ), numIterations, numTransforms, WITH_SIMD_MATH ? TEXT( "enabled" ) : TEXT( "disabled" ) );
+
+	// Random transforms, like instances of meshes in scene. Seed is fixed for the same data in every run
+	std::srand( 0 );
+	std::vector<CTransform>		transforms;
+	std::vector<Vector>			locations;
+	std::vector<Quaternion>		rotations;
+	std::vector<Vector>			scales;
+	for ( uint32 index = 0; index < numTransforms; ++index )
+	{
+		Vector			location( GetRandomFloat( -1000.f, 1000.f ), GetRandomFloat( -1000.f, 1000.f ), GetRandomFloat( -1000.f, 1000.f ) );
+		Quaternion		rotation = SMath::AnglesToQuaternionXYZ( GetRandomFloat( 0.f, 360.f ), GetRandomFloat( 0.f, 360.f ), GetRandomFloat( 0.f, 360.f ) );
+		Vector			scale( GetRandomFloat( 0.5f, 2.f ), GetRandomFloat( 0.5f, 2.f ), GetRandomFloat( 0.5f, 2.f ) );
+		transforms.push_back( CTransform( rotation, location, scale ) );
+		locations.push_back( location );
+		rotations.push_back( rotation );
+		scales.push_back( scale );
+	}
+
+	std::vector<Matrix>			referenceMatrices( numTransforms );
+	std::vector<Matrix>			matrices( numTransforms );
+	std::vector<SMatrix3x4>		matrices3x4( numTransforms );
+
+	// Transform to matrix. CTransform caches matrix, so copy of transform is converted, like GetComponentTransform().ToMatrix() did
+	double		oldTime = appRunBenchmark( TEXT( "To matrix, CTransform::ToMatrix" ), numIterations, [&]()
+				  {
+					  for ( uint32 index = 0; index < numTransforms; ++index )
+					  {
+						  CTransform		transform = transforms[ index ];
+						  referenceMatrices[ index ] = transform.ToMatrix();
+					  }
+					  GBenchmarkSink += ( uint32 )referenceMatrices[ 0 ][ 3 ].x;
+				  } );
+
+	double		scalarTime = appRunBenchmark( TEXT( "To matrix, SMathBatch scalar" ), numIterations, [&]()
+				  {
+					  SMathBatch::TransformsToMatricesScalar( locations.data(), rotations.data(), scales.data(), matrices.data(), numTransforms );
+					  GBenchmarkSink += ( uint32 )matrices[ 0 ][ 3 ].x;
+				  } );
+
+	double		newTime = appRunBenchmark( TEXT( "To matrix, SMathBatch" ), numIterations, [&]()
+				  {
+					  SMathBatch::TransformsToMatrices( locations.data(), rotations.data(), scales.data(), matrices.data(), numTransforms );
+					  GBenchmarkSink += ( uint32 )matrices[ 0 ][ 3 ].x;
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "To matrix speedup: scalar %.2fx, batched %.2fx, max error %f" ), oldTime / scalarTime, oldTime / newTime, GetMaxMatrixError( referenceMatrices, matrices ) );
+
+	// Transform to matrix 3x4, reference is transposed matrix 4x4
+	scalarTime = appRunBenchmark( TEXT( "To matrix 3x4, SMathBatch scalar" ), numIterations, [&]()
+				  {
+					  SMathBatch::TransformsToMatrices3x4Scalar( locations.data(), rotations.data(), scales.data(), matrices3x4.data(), numTransforms );
+					  GBenchmarkSink += ( uint32 )matrices3x4[ 0 ].rows[ 0 ].w;
+				  } );
+
+	newTime = appRunBenchmark( TEXT( "To matrix 3x4, SMathBatch" ), numIterations, [&]()
+				  {
+					  SMathBatch::TransformsToMatrices3x4( locations.data(), rotations.data(), scales.data(), matrices3x4.data(), numTransforms );
+					  GBenchmarkSink += ( uint32 )matrices3x4[ 0 ].rows[ 0 ].w;
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "To matrix 3x4 speedup: scalar %.2fx, batched %.2fx" ), oldTime / scalarTime, oldTime / newTime );
+
+	// Inverse matrix
+	std::vector<Matrix>			referenceInverseMatrices( numTransforms );
+	oldTime = appRunBenchmark( TEXT( "Inverse matrix, SMath::InverseMatrix" ), numIterations, [&]()
+				  {
+					  for ( uint32 index = 0; index < numTransforms; ++index )
+					  {
+						  referenceInverseMatrices[ index ] = SMath::InverseMatrix( referenceMatrices[ index ] );
+					  }
+					  GBenchmarkSink += ( uint32 )referenceInverseMatrices[ 0 ][ 3 ].x;
+				  } );
+
+	scalarTime = appRunBenchmark( TEXT( "Inverse matrix, SMathBatch scalar" ), numIterations, [&]()
+				  {
+					  SMathBatch::TransformsToInverseMatricesScalar( locations.data(), rotations.data(), scales.data(), matrices.data(), numTransforms );
+					  GBenchmarkSink += ( uint32 )matrices[ 0 ][ 3 ].x;
+				  } );
+
+	newTime = appRunBenchmark( TEXT( "Inverse matrix, SMathBatch" ), numIterations, [&]()
+				  {
+					  SMathBatch::TransformsToInverseMatrices( locations.data(), rotations.data(), scales.data(), matrices.data(), numTransforms );
+					  GBenchmarkSink += ( uint32 )matrices[ 0 ][ 3 ].x;
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Inverse matrix speedup: scalar %.2fx, batched %.2fx, max error %f" ), oldTime / scalarTime, oldTime / newTime, GetMaxMatrixError( referenceInverseMatrices, matrices ) );
+
+	// Compose with parent, every transform is parent of next one
+	std::vector<CTransform>		composedTransforms( numTransforms );
+	std::vector<Vector>			composedLocations( numTransforms );
+	std::vector<Quaternion>		composedRotations( numTransforms );
+	std::vector<Vector>			composedScales( numTransforms );
+	uint32						numComposed = numTransforms - 1;
+	oldTime = appRunBenchmark( TEXT( "Compose, CTransform::operator+" ), numIterations, [&]()
+				  {
+					  for ( uint32 index = 0; index < numComposed; ++index )
+					  {
+						  composedTransforms[ index ] = transforms[ index ] + transforms[ index + 1 ];
+					  }
+					  GBenchmarkSink += ( uint32 )composedTransforms[ 0 ].GetLocation().x;
+				  } );
+
+	scalarTime = appRunBenchmark( TEXT( "Compose, SMathBatch scalar" ), numIterations, [&]()
+				  {
+					  SMathBatch::ComposeTransformsScalar( locations.data(), rotations.data(), scales.data(), locations.data() + 1, rotations.data() + 1, scales.data() + 1,
+														   composedLocations.data(), composedRotations.data(), composedScales.data(), numComposed );
+					  GBenchmarkSink += ( uint32 )composedLocations[ 0 ].x;
+				  } );
+
+	newTime = appRunBenchmark( TEXT( "Compose, SMathBatch" ), numIterations, [&]()
+				  {
+					  SMathBatch::ComposeTransforms( locations.data(), rotations.data(), scales.data(), locations.data() + 1, rotations.data() + 1, scales.data() + 1,
+													 composedLocations.data(), composedRotations.data(), composedScales.data(), numComposed );
+					  GBenchmarkSink += ( uint32 )composedLocations[ 0 ].x;
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Compose speedup: scalar %.2fx, batched %.2fx" ), oldTime / scalarTime, oldTime / newTime );
+	return true;
+}
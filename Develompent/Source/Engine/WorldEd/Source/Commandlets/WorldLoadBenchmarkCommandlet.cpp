@@ -0,0 +1,95 @@
+#include "Misc/Class.h"
+#include "Misc/Misc.h"
+#include "Misc/CoreGlobals.h"
+#include "Misc/EngineGlobals.h"
+#include "System/BaseFileSystem.h"
+#include "System/Archive.h"
+#include "System/World.h"
+#include "Logger/LoggerMacros.h"
+#include "Actors/Sprite.h"
+#include "Actors/BoxCollision.h"
+#include "Actors/PointLight.h"
+#include "Commandlets/BenchmarkHelpers.h"
+#include "Commandlets/WorldLoadBenchmarkCommandlet.h"
+
+IMPLEMENT_CLASS( CWorldLoadBenchmarkCommandlet )
+
+/**
+ * Save world to file
+ *
+ * @param InPath	Path to file
+ * @param InVer		Version of archive
+ * @return Return size of file
+ */
+static uint32 SaveWorld( const std::wstring& InPath, uint32 InVer )
+{
+	CArchive*		archive = GFileSystem->CreateFileWriter( InPath, AW_NoFail );
+	archive->SetType( AT_World );
+	archive->SetVer( InVer );
+	archive->SerializeHeader();
+	GWorld->Serialize( *archive );
+
+	uint32		size = archive->GetSize();
+	delete archive;
+	return size;
+}
+
+/**
+ * Load world from file
+ * @param InPath	Path to file
+ */
+static void LoadWorld( const std::wstring& InPath )
+{
+	CArchive*		archive = GFileSystem->CreateFileReader( InPath );
+	check( archive );
+	archive->SerializeHeader();
+	GWorld->Serialize( *archive );
+	delete archive;
+}
+
+bool CWorldLoadBenchmarkCommandlet::Main( const CCommandLine& InCommandLine )
+{
+	uint32				numIterations = appGetBenchmarkIterations( InCommandLine, 5 );
+	uint32				numActors = 10000;
+	std::wstring		paramActors = InCommandLine.GetFirstValue( TEXT( "actors" ) );
+	if ( !paramActors.empty() )
+	{
+		numActors = Max( std::stoi( paramActors ), 1 );
+	}
+
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "World load benchmark, %i iterations, %i actors" ), numIterations, numActors );
+
+	// Fill world with actors, like map from TMX with tiles, collisions and lights
+	CClass*		actorClasses[] = { ASprite::StaticClass(), ASprite::StaticClass(), ABoxCollision::StaticClass(), APointLight::StaticClass() };
+	GWorld->CleanupWorld();
+	for ( uint32 index = 0; index < numActors; ++index )
+	{
+		GWorld->SpawnActor( actorClasses[ index % ARRAY_COUNT( actorClasses ) ], Vector( ( index % 100 ) * 32.f, ( index / 100 ) * 32.f, 0.f ) );
+	}
+
+	// Save world in both formats
+	std::wstring		oldPath = GCookedDir + PATH_SEPARATOR + TEXT( "WorldLoadBenchmark_Old.tmp" );
+	std::wstring		newPath = GCookedDir + PATH_SEPARATOR + TEXT( "WorldLoadBenchmark_New.tmp" );
+	GFileSystem->MakeDirectory( GCookedDir, true );
+	uint32				oldSize = SaveWorld( oldPath, VER_WorldClassTable - 1 );
+	uint32				newSize = SaveWorld( newPath, VER_PACKAGE_LATEST );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "File size: old format %u bytes, new format %u bytes" ), oldSize, newSize );
+
+	double		oldTime = appRunBenchmark( TEXT( "Load world, class name per actor" ), numIterations, [&]()
+				  {
+					  LoadWorld( oldPath );
+					  GBenchmarkSink += GWorld->GetNumActors();
+				  } );
+
+	double		newTime = appRunBenchmark( TEXT( "Load world, class table and actors blob" ), numIterations, [&]()
+				  {
+					  LoadWorld( newPath );
+					  GBenchmarkSink += GWorld->GetNumActors();
+				  } );
+	LE_LOG( LT_Log, LC_Commandlet, TEXT( "Load world speedup: %.2fx" ), oldTime / newTime );
+
+	GWorld->CleanupWorld();
+	GFileSystem->Delete( oldPath );
+	GFileSystem->Delete( newPath );
+	return true;
+}
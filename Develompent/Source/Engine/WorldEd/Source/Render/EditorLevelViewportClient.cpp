@@ -106,6 +106,9 @@ void CEditorLevelViewportClient::Draw( CViewport* InViewport )
 		GAudioDevice.SetListenerSpatial( viewLocation, SMath::vectorForward * viewRotationQuat, SMath::vectorUp * viewRotationQuat );
 	}
 
+	// Send changes of scene to the render thread before drawing
+	GWorld->GetScene()->FlushProxyUpdates();
+
 	// Draw viewport
 	UNIQUE_RENDER_COMMAND_THREEPARAMETER( CViewportRenderCommand,
 										  CEditorLevelViewportClient*, viewportClient, this,
@@ -141,6 +144,9 @@ void CEditorLevelViewportClient::DrawHitProxies( CViewport* InViewport, EHitProx
 	check( InViewport );
 	CSceneView*		sceneView = CalcSceneView( InViewport->GetSizeX(), InViewport->GetSizeY() );
 
+	// Send changes of scene to the render thread before drawing
+	GWorld->GetScene()->FlushProxyUpdates();
+
 	// Draw viewport
 	UNIQUE_RENDER_COMMAND_FOURPARAMETER( CViewportRenderCommand,
 										 CEditorLevelViewportClient*, viewportClient, this,
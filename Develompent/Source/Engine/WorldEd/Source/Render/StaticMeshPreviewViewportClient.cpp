@@ -41,6 +41,9 @@ void CStaticMeshPreviewViewportClient::Draw( CViewport* InViewport )
 	check( InViewport );
 	CSceneView*		sceneView = CalcSceneView( InViewport->GetSizeX(), InViewport->GetSizeY() );
 
+	// Send changes of scene to the render thread before drawing
+	scene->FlushProxyUpdates();
+
 	// Draw viewport
 	UNIQUE_RENDER_COMMAND_THREEPARAMETER( CViewportRenderCommand,
 										  CStaticMeshPreviewViewportClient*, viewportClient, this,
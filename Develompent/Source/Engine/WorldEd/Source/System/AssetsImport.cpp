@@ -9,6 +9,7 @@
 #include "Containers/StringConv.h"
 #include "System/AssetsImport.h"
 #include "System/BaseFileSystem.h"
+#include "System/MeshSimplifier.h"
 #include "Render/RenderUtils.h"
 #include "WorldEd.h"
 
@@ -195,10 +196,13 @@ bool CStaticMeshImporter::Import( const std::wstring& InPath, std::vector<TShare
 			surfaces.push_back( surface );
 		}
 
+		std::vector<SStaticMeshLOD>		lods;
+		GenerateLODs( verteces, indeces, surfaces, lods );
+
 		TSharedPtr<CStaticMesh>		staticMesh = MakeSharedPtr<CStaticMesh>();
 		staticMesh->SetAssetName( CFilename( InPath ).GetBaseFilename() );
 		staticMesh->SetAssetSourceFile( InPath );
-		staticMesh->SetData( verteces, indeces, surfaces, materials );
+		staticMesh->SetData( verteces, indeces, lods, materials );
 		OutResult.push_back( staticMesh );
 	}
 	// Otherwise import separated meshes
@@ -206,16 +210,18 @@ bool CStaticMeshImporter::Import( const std::wstring& InPath, std::vector<TShare
 	{
 		for ( uint32 index = 0, count = meshes.size(); index < count; ++index )
 		{
-			const SMeshData&			meshData	= meshes[index];
+			SMeshData&					meshData	= meshes[index];
 			TSharedPtr<CStaticMesh>		staticMesh	= MakeSharedPtr<CStaticMesh>();
 			staticMesh->SetAssetName( meshData.name );
 			staticMesh->SetAssetSourceFile( InPath + TEXT( "?" ) + meshData.name );
 
 			std::vector<SStaticMeshSurface>			surfaces;
+			std::vector<SStaticMeshLOD>				lods;
 			std::vector<TAssetHandle<CMaterial>>	materials;
 			surfaces.push_back( meshData.surface );
 			materials.push_back( meshData.material );
-			staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials );
+			GenerateLODs( meshData.verteces, meshData.indeces, surfaces, lods );
+			staticMesh->SetData( meshData.verteces, meshData.indeces, lods, materials );
 			OutResult.push_back( staticMesh );
 		}
 	}
@@ -254,12 +260,14 @@ bool CStaticMeshImporter::Reimport( const TSharedPtr<CAsset>& InStaticMesh, std:
 
 	check( meshes.size() == 1 );		// We support reimport only one mesh
 	
-	const SMeshData&						meshData = meshes[0];
+	SMeshData&								meshData = meshes[0];
 	std::vector<SStaticMeshSurface>			surfaces;
+	std::vector<SStaticMeshLOD>				lods;
 	std::vector<TAssetHandle<CMaterial>>	materials;
 	surfaces.push_back( meshData.surface );
 	materials.push_back( meshData.material );
-	staticMesh->SetData( meshData.verteces, meshData.indeces, surfaces, materials );
+	GenerateLODs( meshData.verteces, meshData.indeces, surfaces, lods );
+	staticMesh->SetData( meshData.verteces, meshData.indeces, lods, materials );
 
 	// Broadcast event of reimport/reloaded asset
 	std::vector< TSharedPtr<CAsset> >		reimportedAssets{ staticMesh };
@@ -420,6 +428,58 @@ bool CStaticMeshImporter::ParseMeshes( const std::wstring& InPath, std::vector<S
 	return true;
 }
 
+void CStaticMeshImporter::GenerateLODs( std::vector<SStaticMeshVertexType>& InOutVerteces, std::vector<uint32>& InOutIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, std::vector<SStaticMeshLOD>& OutLODs )
+{
+	OutLODs.resize( 1 );
+	OutLODs[0].surfaces		= InSurfaces;
+	OutLODs[0].screenSize	= 0.f;
+	if ( !importSettings.bGenerateLODs )
+	{
+		return;
+	}
+
+	// Each LOD is simplified from the source mesh. Area of mesh on screen is proportional to square of its radius,
+	// so screen size of next LOD is scaled by square root of reduction to keep the same triangle density on screen
+	uint32		numLODs				= Min<uint32>( Max( importSettings.numLODs, 1 ), STATICMESH_MAX_LODS );
+	uint32		sourcePrimitives	= OutLODs[0].GetNumPrimitives();
+	uint32		lastPrimitives		= sourcePrimitives;
+	float		screenSize			= importSettings.lodScreenSize;
+	float		screenSizeScale		= SMath::Sqrt( importSettings.lodReduction );
+	for ( uint32 lodIndex = 1; lodIndex < numLODs; ++lodIndex )
+	{
+		uint32									targetPrimitives = sourcePrimitives * SMath::Pow( importSettings.lodReduction, lodIndex );
+		std::vector<SStaticMeshVertexType>		lodVerteces;
+		std::vector<uint32>						lodIndeces;
+		SStaticMeshLOD							lod;
+		if ( !CMeshSimplifier::Simplify( InOutVerteces, InOutIndeces, InSurfaces, targetPrimitives, lodVerteces, lodIndeces, lod.surfaces ) )
+		{
+			break;
+		}
+
+		// LOD which is almost the same as previous one isn't worth of memory
+		uint32		lodPrimitives = lod.GetNumPrimitives();
+		if ( lodPrimitives > lastPrimitives * 0.9f )
+		{
+			break;
+		}
+
+		// Move LOD to the end of arrays of the source mesh
+		for ( uint32 index = 0, count = lod.surfaces.size(); index < count; ++index )
+		{
+			lod.surfaces[index].baseVertexIndex	= InOutVerteces.size();
+			lod.surfaces[index].firstIndex		+= InOutIndeces.size();
+		}
+		InOutVerteces.insert( InOutVerteces.end(), lodVerteces.begin(), lodVerteces.end() );
+		InOutIndeces.insert( InOutIndeces.end(), lodIndeces.begin(), lodIndeces.end() );
+
+		// Previous LOD is drawn while it's big enough on screen, the last LOD is drawn at any size
+		OutLODs.back().screenSize	= screenSize;
+		screenSize					*= screenSizeScale;
+		OutLODs.push_back( lod );
+		lastPrimitives				= lodPrimitives;
+	}
+}
+
 const std::vector<std::wstring>& CStaticMeshImporter::GetSupportedExtensions()
 {
 	// If supported extension not cached - get extensions from aiImport
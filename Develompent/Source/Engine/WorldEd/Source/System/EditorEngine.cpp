@@ -9,6 +9,7 @@
 #include "Misc/EngineGlobals.h"
 #include "Misc/WorldEdGlobals.h"
 #include "System/World.h"
+#include "System/TransformHierarchy.h"
 #include "Render/Viewport.h"
 #include "Render/RenderingThread.h"
 #include "Render/EditorInterfaceViewportClient.h"
@@ -110,6 +111,9 @@ void CEditorEngine::Tick( float InDeltaSeconds )
 {
 	Super::Tick( InDeltaSeconds );
 
+	// World isn't ticked in editor, so update transforms of moved components here
+	GTransformHierarchy.Update();
+
 	// Update viewports
 	for ( uint32 index = 0, count = ( uint32 )viewports.size(); index < count; ++index )
 	{
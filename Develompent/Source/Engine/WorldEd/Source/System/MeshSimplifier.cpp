@@ -0,0 +1,247 @@
+#include <array>
+#include <algorithm>
+#include <cfloat>
+#include <unordered_map>
+
+#include "Misc/Template.h"
+#include "System/MeshSimplifier.h"
+
+/**
+ * @ingroup WorldEd
+ * Max number of cells of grid along the longest side of mesh bounds
+ */
+#define MESHSIMPLIFIER_MAX_GRID_SIZE		1024
+
+/**
+ * @ingroup WorldEd
+ * @brief Triangle of clusters, it's rotated to begin from the smallest cluster, so winding is kept
+ */
+typedef std::array<uint32, 3>		ClusterTriangle_t;
+
+/**
+ * @brief Get group of normal
+ * Verteces with normals in different groups aren't merged, so hard edges of mesh are kept
+ *
+ * @param InNormal	Normal of vertex
+ * @return Return index of dominant axis and its sign (0-5)
+ */
+static FORCEINLINE uint32 GetNormalGroup( const Vector4D& InNormal )
+{
+	float		absX = InNormal.x >= 0.f ? InNormal.x : -InNormal.x;
+	float		absY = InNormal.y >= 0.f ? InNormal.y : -InNormal.y;
+	float		absZ = InNormal.z >= 0.f ? InNormal.z : -InNormal.z;
+	if ( absX >= absY && absX >= absZ )
+	{
+		return InNormal.x >= 0.f ? 0 : 1;
+	}
+	else if ( absY >= absZ )
+	{
+		return InNormal.y >= 0.f ? 2 : 3;
+	}
+	return InNormal.z >= 0.f ? 4 : 5;
+}
+
+/**
+ * @brief Split verteces into clusters by grid
+ *
+ * @param InVerteces		Verteces of mesh
+ * @param InUsedVerteces	Indeces of verteces used by triangles
+ * @param InBoundsMin		Min point of bounds of used verteces
+ * @param InBoundsSize		Size of the longest side of bounds
+ * @param InGridSize		Number of cells along the longest side of bounds
+ * @param OutVertexClusters	Output cluster of each vertex, must have size of InVerteces
+ * @return Return number of clusters
+ */
+static uint32 ClusterVerteces( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InUsedVerteces, const Vector& InBoundsMin, float InBoundsSize, uint32 InGridSize, std::vector<uint32>& OutVertexClusters )
+{
+	std::unordered_map<uint64, uint32>		clusters;
+	float									invCellSize = InGridSize / InBoundsSize;
+	clusters.reserve( InUsedVerteces.size() );
+	for ( uint32 index = 0, count = InUsedVerteces.size(); index < count; ++index )
+	{
+		uint32							vertexIndex = InUsedVerteces[ index ];
+		const SStaticMeshVertexType&	vertex		= InVerteces[ vertexIndex ];
+		uint64							cellX		= Min<uint32>( ( vertex.position.x - InBoundsMin.x ) * invCellSize, InGridSize - 1 );
+		uint64							cellY		= Min<uint32>( ( vertex.position.y - InBoundsMin.y ) * invCellSize, InGridSize - 1 );
+		uint64							cellZ		= Min<uint32>( ( vertex.position.z - InBoundsMin.z ) * invCellSize, InGridSize - 1 );
+		uint64							key			= ( ( cellX * InGridSize + cellY ) * InGridSize + cellZ ) * 6 + GetNormalGroup( vertex.normal );
+
+		auto	itCluster = clusters.find( key );
+		if ( itCluster == clusters.end() )
+		{
+			itCluster = clusters.insert( std::make_pair( key, ( uint32 )clusters.size() ) ).first;
+		}
+		OutVertexClusters[ vertexIndex ] = itCluster->second;
+	}
+
+	return clusters.size();
+}
+
+/**
+ * @brief Count triangles which aren't collapsed
+ *
+ * @param InIndeces			Indeces of triangles in the whole vertex array
+ * @param InVertexClusters	Cluster of each vertex
+ * @return Return number of triangles which have verteces in three different clusters
+ */
+static uint32 CountPrimitives( const std::vector<uint32>& InIndeces, const std::vector<uint32>& InVertexClusters )
+{
+	uint32		numPrimitives = 0;
+	for ( uint32 index = 0, count = InIndeces.size(); index < count; index += 3 )
+	{
+		uint32		cluster0 = InVertexClusters[ InIndeces[ index ] ];
+		uint32		cluster1 = InVertexClusters[ InIndeces[ index + 1 ] ];
+		uint32		cluster2 = InVertexClusters[ InIndeces[ index + 2 ] ];
+		if ( cluster0 != cluster1 && cluster1 != cluster2 && cluster0 != cluster2 )
+		{
+			++numPrimitives;
+		}
+	}
+	return numPrimitives;
+}
+
+bool CMeshSimplifier::Simplify( const std::vector<SStaticMeshVertexType>& InVerteces, const std::vector<uint32>& InIndeces, const std::vector<SStaticMeshSurface>& InSurfaces, uint32 InTargetPrimitives,
+								std::vector<SStaticMeshVertexType>& OutVerteces, std::vector<uint32>& OutIndeces, std::vector<SStaticMeshSurface>& OutSurfaces )
+{
+	OutVerteces.clear();
+	OutIndeces.clear();
+	OutSurfaces.clear();
+
+	// Gather triangles of all surfaces with indeces in the whole vertex array and bounds of used verteces
+	std::vector<uint32>		triangleIndeces;
+	std::vector<uint32>		surfaceOffsets;			// Offset of first index of each surface in triangleIndeces, last element is number of indeces
+	std::vector<uint32>		usedVerteces;
+	std::vector<uint32>		vertexClusters( InVerteces.size(), INDEX_NONE );
+	Vector					boundsMin( FLT_MAX, FLT_MAX, FLT_MAX );
+	Vector					boundsMax( -FLT_MAX, -FLT_MAX, -FLT_MAX );
+	for ( uint32 surfaceIndex = 0, numSurfaces = InSurfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+	{
+		const SStaticMeshSurface&		surface = InSurfaces[ surfaceIndex ];
+		surfaceOffsets.push_back( triangleIndeces.size() );
+		for ( uint32 index = 0, count = surface.numPrimitives * 3; index < count; ++index )
+		{
+			uint32		vertexIndex = surface.baseVertexIndex + InIndeces[ surface.firstIndex + index ];
+			triangleIndeces.push_back( vertexIndex );
+
+			// Cluster is used here only as mark of used vertex
+			if ( vertexClusters[ vertexIndex ] == INDEX_NONE )
+			{
+				const Vector4D&		position = InVerteces[ vertexIndex ].position;
+				vertexClusters[ vertexIndex ] = 0;
+				usedVerteces.push_back( vertexIndex );
+				boundsMin = Vector( Min( boundsMin.x, position.x ), Min( boundsMin.y, position.y ), Min( boundsMin.z, position.z ) );
+				boundsMax = Vector( Max( boundsMax.x, position.x ), Max( boundsMax.y, position.y ), Max( boundsMax.z, position.z ) );
+			}
+		}
+	}
+	surfaceOffsets.push_back( triangleIndeces.size() );
+
+	float		boundsSize = Max( boundsMax.x - boundsMin.x, Max( boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z ) );
+	if ( usedVerteces.empty() || boundsSize <= 0.f )
+	{
+		return false;
+	}
+
+	// Find the biggest grid which gives not more primitives than requested,
+	// number of primitives grows with size of grid, so binary search is used
+	uint32		gridSize = 0;
+	uint32		minGridSize = 1;
+	uint32		maxGridSize = MESHSIMPLIFIER_MAX_GRID_SIZE;
+	while ( minGridSize <= maxGridSize )
+	{
+		uint32		middleGridSize = ( minGridSize + maxGridSize ) / 2;
+		ClusterVerteces( InVerteces, usedVerteces, boundsMin, boundsSize, middleGridSize, vertexClusters );
+		if ( CountPrimitives( triangleIndeces, vertexClusters ) <= InTargetPrimitives )
+		{
+			gridSize	= middleGridSize;
+			minGridSize = middleGridSize + 1;
+		}
+		else
+		{
+			maxGridSize = middleGridSize - 1;
+		}
+	}
+
+	if ( !gridSize )
+	{
+		return false;
+	}
+	uint32		numClusters = ClusterVerteces( InVerteces, usedVerteces, boundsMin, boundsSize, gridSize, vertexClusters );
+
+	// Vertex of cluster is source vertex nearest to the center of cluster, so its attributes stay consistent (e.g. texture coords on seams)
+	std::vector<Vector>		clusterCenters( numClusters, Vector( 0.f, 0.f, 0.f ) );
+	std::vector<uint32>		clusterSizes( numClusters, 0 );
+	std::vector<uint32>		clusterVerteces( numClusters, INDEX_NONE );
+	std::vector<float>		clusterDistances( numClusters, FLT_MAX );
+	for ( uint32 index = 0, count = usedVerteces.size(); index < count; ++index )
+	{
+		const Vector4D&		position	= InVerteces[ usedVerteces[ index ] ].position;
+		uint32				cluster		= vertexClusters[ usedVerteces[ index ] ];
+		clusterCenters[ cluster ]		+= Vector( position.x, position.y, position.z );
+		++clusterSizes[ cluster ];
+	}
+
+	for ( uint32 index = 0, count = usedVerteces.size(); index < count; ++index )
+	{
+		const Vector4D&		position	= InVerteces[ usedVerteces[ index ] ].position;
+		uint32				cluster		= vertexClusters[ usedVerteces[ index ] ];
+		Vector				delta		= Vector( position.x, position.y, position.z ) - clusterCenters[ cluster ] / ( float )clusterSizes[ cluster ];
+		float				distance	= delta.x * delta.x + delta.y * delta.y + delta.z * delta.z;
+		if ( distance < clusterDistances[ cluster ] )
+		{
+			clusterDistances[ cluster ] = distance;
+			clusterVerteces[ cluster ]	= usedVerteces[ index ];
+		}
+	}
+
+	// Make triangles of each surface, collapsed and duplicated triangles are removed
+	std::vector<uint32>				clusterRemap( numClusters, INDEX_NONE );
+	std::vector<ClusterTriangle_t>	triangles;
+	for ( uint32 surfaceIndex = 0, numSurfaces = InSurfaces.size(); surfaceIndex < numSurfaces; ++surfaceIndex )
+	{
+		triangles.clear();
+		for ( uint32 index = surfaceOffsets[ surfaceIndex ], count = surfaceOffsets[ surfaceIndex + 1 ]; index < count; index += 3 )
+		{
+			ClusterTriangle_t	triangle = { vertexClusters[ triangleIndeces[ index ] ], vertexClusters[ triangleIndeces[ index + 1 ] ], vertexClusters[ triangleIndeces[ index + 2 ] ] };
+			if ( triangle[ 0 ] == triangle[ 1 ] || triangle[ 1 ] == triangle[ 2 ] || triangle[ 0 ] == triangle[ 2 ] )
+			{
+				continue;
+			}
+
+			while ( triangle[ 0 ] > triangle[ 1 ] || triangle[ 0 ] > triangle[ 2 ] )
+			{
+				triangle = { triangle[ 1 ], triangle[ 2 ], triangle[ 0 ] };
+			}
+			triangles.push_back( triangle );
+		}
+
+		std::sort( triangles.begin(), triangles.end() );
+		triangles.erase( std::unique( triangles.begin(), triangles.end() ), triangles.end() );
+		if ( triangles.empty() )
+		{
+			continue;
+		}
+
+		SStaticMeshSurface		surface;
+		surface.materialID		= InSurfaces[ surfaceIndex ].materialID;
+		surface.baseVertexIndex = 0;
+		surface.firstIndex		= OutIndeces.size();
+		surface.numPrimitives	= triangles.size();
+		for ( uint32 index = 0, count = triangles.size(); index < count; ++index )
+		{
+			for ( uint32 corner = 0; corner < 3; ++corner )
+			{
+				uint32		cluster = triangles[ index ][ corner ];
+				if ( clusterRemap[ cluster ] == INDEX_NONE )
+				{
+					clusterRemap[ cluster ] = OutVerteces.size();
+					OutVerteces.push_back( InVerteces[ clusterVerteces[ cluster ] ] );
+				}
+				OutIndeces.push_back( clusterRemap[ cluster ] );
+			}
+		}
+		OutSurfaces.push_back( surface );
+	}
+
+	return !OutSurfaces.empty();
+}
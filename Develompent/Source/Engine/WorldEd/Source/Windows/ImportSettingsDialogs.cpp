@@ -1,5 +1,6 @@
 #include "Windows/ImportSettingsDialogs.h"
 #include "ImGUI/imgui_internal.h"
+#include "Render/StaticMesh.h"
 
 /** Table names of axis up */
 static const achar* GAxisUpNames[] =
@@ -57,6 +58,64 @@ void CStaticMeshImportSettingsDialog::OnTick()
 		ImGui::EndColumns();
 	}
 
+	// LODs section
+	if ( ImGui::CollapsingHeader( "LODs", ImGuiTreeNodeFlags_DefaultOpen ) )
+	{
+		ImGui::Columns( 2, 0, false );
+
+		// Generate LODs
+		{
+			ImGui::Text( "Generate LODs:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "If enabled, generates simplified LODs of mesh for drawing at distance" );
+			}
+
+			ImGui::NextColumn();
+			ImGui::Checkbox( "##GenerateLODs", &importSettings.bGenerateLODs );
+			ImGui::NextColumn();
+		}
+
+		// Number of LODs
+		{
+			ImGui::Text( "Number LODs:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Max number of LODs including the source mesh" );
+			}
+
+			ImGui::NextColumn();
+			ImGui::SliderInt( "##NumLODs", &importSettings.numLODs, 2, STATICMESH_MAX_LODS );
+			ImGui::NextColumn();
+		}
+
+		// Reduction of triangles
+		{
+			ImGui::Text( "Reduction:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Part of triangles of the source mesh which is left in each next LOD" );
+			}
+
+			ImGui::NextColumn();
+			ImGui::SliderFloat( "##LODReduction", &importSettings.lodReduction, 0.1f, 0.9f );
+			ImGui::NextColumn();
+		}
+
+		// Screen size of the source mesh
+		{
+			ImGui::Text( "Screen Size:" );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Min radius of mesh on screen (1 is half of screen height) to draw the source mesh, next LODs are switched by the same triangle density on screen" );
+			}
+
+			ImGui::NextColumn();
+			ImGui::SliderFloat( "##LODScreenSize", &importSettings.lodScreenSize, 0.01f, 2.f );
+		}
+		ImGui::EndColumns();
+	}
+
 	// Draw buttons
 	ImGui::NewLine();
 	ImGui::Separator();
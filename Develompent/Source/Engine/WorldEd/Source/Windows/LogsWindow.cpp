@@ -17,6 +17,7 @@ void CLogsWindow::OnTick()
 		ImGui::BeginChild( "##ScrollingRegion", ImVec2( 0, -footerHeightToReserve ), false, ImGuiWindowFlags_HorizontalScrollbar );
 		ImGui::PushStyleVar( ImGuiStyleVar_ItemSpacing, ImVec2( 4.f, 1.f ) );			// Tighten spacing
 		
+		historyCS.Lock();
 		for ( uint32 index = 0, count = history.size(); index < count; ++index )
 		{
 			bool				bHasColor = false;
@@ -41,6 +42,7 @@ void CLogsWindow::OnTick()
 				ImGui::PopStyleColor();
 			}
 		}
+		historyCS.Unlock();
 
 		if ( ImGui::GetScrollY() >= ImGui::GetScrollMaxY() )
 		{
@@ -7,6 +7,9 @@
 #include "Render/MaterialPreviewViewportClient.h"
 #include "ImGUI/ImGUIEngine.h"
 #include "Render/RenderUtils.h"
+#include "Misc/EngineGlobals.h"
+#include "System/World.h"
+#include "Components/PrimitiveComponent.h"
 
 /** Table of texture parameters in material */
 static const CName		GTextureParameterNames[] =
@@ -110,16 +113,18 @@ void CMaterialEditorWindow::OnTick()
 		
 		// Is two sided
 		bool bIsTwoSided		= material->IsTwoSided();
-		if ( ImGui::Checkbox( "Is Two Sided", &bIsTwoSided ), &bIsTwoSided )
+		if ( ImGui::Checkbox( "Is Two Sided", &bIsTwoSided ) )
 		{
 			material->SetTwoSided( bIsTwoSided );
+			OnRenderStateChanged();
 		}
 
 		// Is wireframe
 		bool bIsWireframe		= material->IsWireframe();
-		if ( ImGui::Checkbox( "Is Wireframe", &bIsWireframe ), &bIsTwoSided )
+		if ( ImGui::Checkbox( "Is Wireframe", &bIsWireframe ) )
 		{
 			material->SetWireframe( bIsWireframe );
+			OnRenderStateChanged();
 		}
 	}
 
@@ -234,11 +239,35 @@ void CMaterialEditorWindow::OnAssetsReloaded( const std::vector<TSharedPtr<CAsse
 		if ( InAssets[index] == material )
 		{
 			UpdateAssetInfo();
+			OnRenderStateChanged();
 			return;
 		}
 	}
 }
 
+void CMaterialEditorWindow::OnRenderStateChanged()
+{
+	// Drawing policies take pipeline state only on link, so all primitives are relinked to get new rasterizer state of material
+	viewportClient->SetMaterial( material );
+	if ( !GWorld )
+	{
+		return;
+	}
+
+	const std::vector<ActorRef_t>&		actors = GWorld->GetActors();
+	for ( uint32 actorIndex = 0, numActors = actors.size(); actorIndex < numActors; ++actorIndex )
+	{
+		const std::vector<ActorComponentRef_t>&		components = actors[actorIndex]->GetComponents();
+		for ( uint32 componentIndex = 0, numComponents = components.size(); componentIndex < numComponents; ++componentIndex )
+		{
+			if ( components[componentIndex]->IsA<CPrimitiveComponent>() )
+			{
+				( ( CPrimitiveComponent* )components[componentIndex].GetPtr() )->MarkRenderStateDirty( SPU_Material );
+			}
+		}
+	}
+}
+
 void CMaterialEditorWindow::OnOpenAssetEditor( uint32 InAssetSlot )
 {
 	if ( !material )
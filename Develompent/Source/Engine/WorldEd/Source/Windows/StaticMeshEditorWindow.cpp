@@ -153,10 +153,28 @@ void CStaticMeshEditorWindow::OnTick()
 		ImGui::Text( std::to_string( staticMesh->GetVerteces().Num() ).c_str() );
 		ImGui::TableNextColumn();
 
-		// Draw texture format
+		// Draw count triangles of LOD0, index buffer contains all LODs
 		ImGui::Text( "Triangles:" );
 		ImGui::TableNextColumn();
-		ImGui::Text( std::to_string( staticMesh->GetIndeces().Num() / 3 ).c_str() );
+		ImGui::Text( std::to_string( staticMesh->GetNumLODs() > 0 ? staticMesh->GetLODs()[ 0 ].GetNumPrimitives() : 0 ).c_str() );
+		ImGui::TableNextColumn();
+
+		// Number of triangles in each LOD
+		ImGui::Text( "LODs:" );
+		ImGui::TableNextColumn();
+		{
+			const std::vector<SStaticMeshLOD>&		lods = staticMesh->GetLODs();
+			std::string								lodsInfo;
+			for ( uint32 index = 0, count = lods.size(); index < count; ++index )
+			{
+				lodsInfo += ( index > 0 ? ", " : "" ) + std::to_string( lods[index].GetNumPrimitives() );
+			}
+			ImGui::Text( lodsInfo.c_str() );
+			if ( ImGui::IsItemHovered( ImGuiHoveredFlags_AllowWhenDisabled ) )
+			{
+				ImGui::SetTooltip( "Number of triangles in each LOD" );
+			}
+		}
 		ImGui::TableNextColumn();
 
 		// Resource size
@@ -0,0 +1,80 @@
+/**
+ * ClusteredLightingPixelShader.hlsl: Pixel shader code for calculating lights of light grid in one fullscreen pass.
+ *
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#include "Common.hlsl"
+#include "LightingCommon.hlsl"
+
+// Offset and number of light indeces of each cluster, one texel per value
+Texture2D		lightGridClustersTexture;
+
+// Light indeces of all clusters
+Texture2D		lightGridIndecesTexture;
+
+// Data of lights, LIGHTGRID_TEXELS_PER_LIGHT texels per light:
+// ( position, radius ), ( color * intensivity, cosine of inner cone ), ( direction, cosine of outer cone )
+Texture2D		lightGridLightsTexture;
+
+// Number of clusters by X, Y and Z, in W is number of lights
+float4			lightGridSize;
+
+// Near depth of grid, inverse scale of depth and scale of slices
+float4			lightGridDepthParams;
+
+float4 LoadLightGridTexel( Texture2D InTexture, uint InIndex )
+{
+    return InTexture.Load( int3( InIndex % LIGHTGRID_TEXTURE_WIDTH, InIndex / LIGHTGRID_TEXTURE_WIDTH, 0 ) );
+}
+
+// Main function for calculate light attenuation
+float4 MainPS( in float2 InUV : TEXCOORD0 ) : SV_TARGET0
+{
+    float2      bufferUV            = InUV * ( GetScreenSize() / GetBufferSize() );
+
+    // Getting data from GBuffer
+    float4      diffuseRoughness    = diffuseRoughnessGBufferTexture.Sample( diffuseRoughnessGBufferSampler, bufferUV );
+    float4      normalMetal         = normalMetalGBufferTexture.Sample( normalMetalGBufferSampler, bufferUV );
+    float4      emission            = emissionGBufferTexture.Sample( emissionGBufferSampler, bufferUV );
+
+    // Getting postion of fragment and view direction
+    float3      positionFragment    = ReconstructPosition( InUV, bufferUV );
+    float3      viewDirection       = normalize( position.xyz - positionFragment );
+
+    // Find cluster of fragment, slices beyond the grid haven't lights
+    float       viewDepth           = -MulMatrix( viewMatrix, float4( positionFragment, 1.f ) ).z;
+    uint        slice               = ( uint )floor( log( max( viewDepth - lightGridDepthParams.x, 0.f ) * lightGridDepthParams.y + 1.f ) * lightGridDepthParams.z );
+    uint2       tile                = min( ( uint2 )( InUV * lightGridSize.xy ), ( uint2 )lightGridSize.xy - 1 );
+    float3      lighting            = 0.f;
+
+    if ( slice < ( uint )lightGridSize.z )
+    {
+        uint    clusterIndex        = ( slice * ( uint )lightGridSize.y + tile.y ) * ( uint )lightGridSize.x + tile.x;
+        uint    firstLight          = ( uint )LoadLightGridTexel( lightGridClustersTexture, clusterIndex * 2 ).x;
+        uint    numLights           = ( uint )LoadLightGridTexel( lightGridClustersTexture, clusterIndex * 2 + 1 ).x;
+
+        for ( uint index = firstLight; index < firstLight + numLights; ++index )
+        {
+            uint        lightIndex          = ( uint )LoadLightGridTexel( lightGridIndecesTexture, index ).x * LIGHTGRID_TEXELS_PER_LIGHT;
+            float4      positionRadius      = LoadLightGridTexel( lightGridLightsTexture, lightIndex );
+            float4      colorInnerCone      = LoadLightGridTexel( lightGridLightsTexture, lightIndex + 1 );
+            float4      directionOuterCone  = LoadLightGridTexel( lightGridLightsTexture, lightIndex + 2 );
+
+            float3      lightDirection      = positionRadius.xyz - positionFragment;
+            float       distance            = length( lightDirection );
+            lightDirection                  = normalize( lightDirection );
+
+            // For point lights cosines of cones are -1 and -2, so the factor is always 1
+            float       spotFactor          = saturate( ( dot( -lightDirection, directionOuterCone.xyz ) - directionOuterCone.w ) / max( colorInnerCone.w - directionOuterCone.w, 0.0001f ) );
+            float       NdotL               = max( dot( normalMetal.xyz, lightDirection ), 0.f );
+            float       attenuation         = pow( saturate( 1.f - pow( distance / positionRadius.w, 4.f ) ), 2.f ) / ( pow( distance, 2.f ) + 1.f );
+            float       specularFactor      = max( pow( dot( reflect( -lightDirection, normalMetal.xyz ), viewDirection ), diffuseRoughness.a ) * normalMetal.a, 0.f );
+
+            lighting                        += ( colorInnerCone.rgb + colorInnerCone.rgb * specularFactor ) * attenuation * NdotL * spotFactor;
+        }
+    }
+
+    return float4( diffuseRoughness.xyz, 1.f ) * ( emission + float4( lighting, 0.f ) );
+}
\ No newline at end of file
@@ -16,6 +16,7 @@
 // Pixel and vertex shader constant registers that are reserved by the Engine.
 // ----------------------------------------------------------------------------------------
 #define SOB_GlobalConstants			b1			// Slot for global constant buffer
+#define SOB_DrawConstants			b2			// Slot for per draw constant buffer
 
 #include "CPP_GlobalConstantBuffers.hlsl"
 
@@ -0,0 +1,18 @@
+/**
+ * DepthOnlyShaders.hlsl: Vertex and pixel shader code for depth prepass.
+ * 
+ * Copyright Broken Singularity, All Rights Reserved.
+ * Authors: Yehor Pohuliaka (zombiHello)
+ */
+
+#include "Common.hlsl"
+#include "VertexFactory.hlsl"
+
+/* World position is computed by the same expression as in base pass, so GBuffer pass can test depth for equality */
+void MainVS( in FVertexFactoryInput In, out float4 OutPosition : SV_POSITION )
+{
+	OutPosition		= MulMatrix( viewProjectionMatrix, VertexFactory_GetWorldPosition( In ) );
+}
+
+void MainPS()
+{}
@@ -7,35 +7,7 @@
 
 #include "Common.hlsl"
 #include "VertexFactory.hlsl"
-
-// DiffuseRoughnessGBuffer texture
-Texture2D		diffuseRoughnessGBufferTexture;
-SamplerState	diffuseRoughnessGBufferSampler;
-
-// NormalMetalGBuffer texture
-Texture2D		normalMetalGBufferTexture;
-SamplerState	normalMetalGBufferSampler;
-
-// EmissionGBuffer texture
-Texture2D       emissionGBufferTexture;
-SamplerState    emissionGBufferSampler;
-
-// Depth buffer texture
-Texture2D		depthBufferTexture;
-SamplerState	depthBufferSampler;
-
-float3 ReconstructPosition( float2 InScreenUV, float2 InBufferUV ) 
-{
-    // Getting depth from depth buffer
-    float       depth = depthBufferTexture.Sample( depthBufferSampler, InBufferUV ).x;
-
-    // Inverting Y coord, because in DirectX screen's coord Y starting from Up of the viewport
-    InScreenUV.y = 1.f - InScreenUV.y;
-
-    // Restore world position
-    float4      worldPosition = MulMatrix( invViewProjectionMatrix, float4( InScreenUV * 2.f - 1.f, depth, 1.f ) );
-    return worldPosition.xyz / worldPosition.w;
-}
+#include "LightingCommon.hlsl"
 
 // Main function for calculate light attenuation
 float4 MainPS( in nointerpolation SLightData InLightData, in float4 InScreenPosition : TEXCOORD0 ) : SV_TARGET0
@@ -13,4 +13,16 @@
      OutUV              = VertexFactory_GetTexCoord( In, 0 );
      OutColor           = VertexFactory_GetColor( In, 0 );
      OutPosition        = MulMatrix( viewProjectionMatrix, VertexFactory_GetLocalPosition( In ) );
+ }
+
+ // Main function for thick lines, each instance is a line which is expanded into quad facing the camera.
+ // Verteces of triangle strip are: 0 - end down, 1 - end up, 2 - start down, 3 - start up
+ void ThickLineMainVS( in float4 InStart : POSITION0, in float4 InEnd : POSITION1, in float4 InColor : COLOR0, in uint InVertexID : SV_VertexID, out float2 OutUV : TEXCOORD0, out float4 OutColor : TEXCOORD1, out float4 OutPosition : SV_POSITION )
+ {
+     float3     cameraZ         = -viewMatrix[ 2 ].xyz;
+     float3     lineUp          = normalize( cross( normalize( InEnd.xyz - InStart.xyz ), cameraZ ) ) * InStart.w * 0.5f;
+
+     OutUV                      = float2( InVertexID < 2 ? 1.f : 0.f, InVertexID & 1 );
+     OutColor                   = InColor;
+     OutPosition                = MulMatrix( viewProjectionMatrix, float4( lerp( InStart.xyz, InEnd.xyz, OutUV.x ) + lineUp * ( OutUV.y * 2.f - 1.f ), 1.f ) );
  }
\ No newline at end of file
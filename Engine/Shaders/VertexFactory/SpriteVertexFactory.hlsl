@@ -4,33 +4,55 @@
 #include "Common.hlsl"
 #include "VertexFactory/VertexFactoryCommon.hlsl"
 
+/* Types of sprite, must be in sync with ESpriteType */
+#define SPRITE_TYPE_STATIC						0
+#define SPRITE_TYPE_ROTATING					1
+#define SPRITE_TYPE_ROTATING_ONLY_VERTICAL		2
+
+/* Flags of sprite flip, must be in sync with ESpriteFlipFlags */
+#define SPRITE_FLIP_HORIZONTAL					1
+#define SPRITE_FLIP_VERTICAL					2
+
 struct FVertexFactoryInput
 {
 	float4 		position				: POSITION;
 	float2 		texCoord0				: TEXCOORD0;
 	float4		normal					: NORMAL0;
 	
-#if USE_INSTANCING
+	// Sprites are drawn only by instancing (see CSpriteBatch), so instance data doesn't depend on USE_INSTANCING
 	float4x4 	instanceLocalToWorld 	: POSITION1;
+	float4		textureRect				: TEXCOORD1;
+	float4		spriteParams			: TEXCOORD2;
 	
-	#if ENABLE_HITPROXY
-		float4		hitProxyId			: COLOR0;
-	#endif // ENABLE_HITPROXY
+#if ENABLE_HITPROXY
+	float4		hitProxyId				: COLOR0;
+#endif // ENABLE_HITPROXY
 	
-	#if WITH_EDITOR
-		float4		colorOverlay		: COLOR1;
-	#endif // WITH_EDITOR
-#endif // USE_INSTANCING
+#if WITH_EDITOR
+	float4		colorOverlay			: COLOR1;
+#endif // WITH_EDITOR
 };
 
-bool		bFlipVertical;
-bool		bFlipHorizontal;
-float4		textureRect;
-float2		spriteSize;
+/**
+ * Transform vector from local space of sprite to world space. Billboard sprites are turned to camera by view matrix,
+ * so instance data doesn't depend on view
+ */
+float3 VertexFactory_LocalToWorldVector( FVertexFactoryInput InInput, float3 InVector )
+{
+	float3		worldVector = MulMatrix( InInput.instanceLocalToWorld, float4( InVector, 0.f ) ).xyz;
+	uint		spriteType 	= ( uint )InInput.spriteParams.w;
+	if ( spriteType == SPRITE_TYPE_STATIC )
+	{
+		return worldVector;
+	}
+	
+	float3		upAxis = spriteType == SPRITE_TYPE_ROTATING_ONLY_VERTICAL ? float3( 0.f, 1.f, 0.f ) : viewMatrix[ 1 ].xyz;
+	return viewMatrix[ 0 ].xyz * worldVector.x + upAxis * worldVector.y + viewMatrix[ 2 ].xyz * worldVector.z;
+}
 
 float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
 {
-	return InInput.position * float4( spriteSize, 1.f, 1.f );
+	return InInput.position * float4( InInput.spriteParams.xy, 1.f, 1.f );
 }
 
 float4 VertexFactory_GetLocalNormal( FVertexFactoryInput InInput )
@@ -40,36 +62,30 @@ float4 VertexFactory_GetLocalNormal( FVertexFactoryInput InInput )
 
 float4 VertexFactory_GetWorldPosition( FVertexFactoryInput InInput )
 {
-#if USE_INSTANCING
-	return MulMatrix( InInput.instanceLocalToWorld, VertexFactory_GetLocalPosition( InInput ) );
-#else
-	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalPosition( InInput ) );
-#endif // USE_INSTANCING
+	float3		origin = MulMatrix( InInput.instanceLocalToWorld, float4( 0.f, 0.f, 0.f, 1.f ) ).xyz;
+	return float4( origin + VertexFactory_LocalToWorldVector( InInput, VertexFactory_GetLocalPosition( InInput ).xyz ), 1.f );
 }
 
 float4 VertexFactory_GetWorldNormal( FVertexFactoryInput InInput )
 {
-#if USE_INSTANCING
-	return MulMatrix( InInput.instanceLocalToWorld, VertexFactory_GetLocalNormal( InInput ) );
-#else
-	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalNormal( InInput ) );
-#endif // USE_INSTANCING
+	return float4( VertexFactory_LocalToWorldVector( InInput, VertexFactory_GetLocalNormal( InInput ).xyz ), 0.f );
 }
 
 float2 VertexFactory_GetTexCoord( FVertexFactoryInput InInput, uint InTexCoordIndex )
 {
-	// TODO BS yehor.pohuliaka - Need fix fliping, because on tile texture is not correct work
-	float2	outTexCoord = textureRect.xy + ( InInput.texCoord0 * textureRect.zw );	
-	if ( bFlipVertical )
+	// Flip is done inside of texture rect, so it works with tiles of atlas
+	float2		texCoord 	= InInput.texCoord0;
+	uint		flipFlags 	= ( uint )InInput.spriteParams.z;
+	if ( flipFlags & SPRITE_FLIP_HORIZONTAL )
 	{
-		outTexCoord.y *= -1.f;
+		texCoord.x = 1.f - texCoord.x;
 	}
 	
-	if ( bFlipHorizontal )
+	if ( flipFlags & SPRITE_FLIP_VERTICAL )
 	{
-		outTexCoord.x *= -1.f;
+		texCoord.y = 1.f - texCoord.y;
 	}
-	return outTexCoord;
+	return InInput.textureRect.xy + texCoord * InInput.textureRect.zw;
 }
 
 float4 VertexFactory_GetColor( FVertexFactoryInput InInput, uint InColorIndex )
@@ -80,23 +96,15 @@ float4 VertexFactory_GetColor( FVertexFactoryInput InInput, uint InColorIndex )
 #if ENABLE_HITPROXY
 float4 VertexFactory_GetHitProxyId( FVertexFactoryInput InInput )
 {
-	#if USE_INSTANCING
-		return InInput.hitProxyId;
-	#else
-		return hitProxyId;
-	#endif // USE_INSTANCING
+	return InInput.hitProxyId;
 }
 #endif // ENABLE_HITPROXY
 
 #if WITH_EDITOR
 float4 VertexFactory_GetColorOverlay( FVertexFactoryInput InInput )
 {
-	#if USE_INSTANCING
-		return InInput.colorOverlay;
-	#else
-		return colorOverlay;
-	#endif // USE_INSTANCING
+	return InInput.colorOverlay;
 }
 #endif // WITH_EDITOR
 
-#endif // !VERTEXFACTORY_H
\ No newline at end of file
+#endif // !VERTEXFACTORY_H
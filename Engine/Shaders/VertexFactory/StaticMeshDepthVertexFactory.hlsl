@@ -0,0 +1,23 @@
+#ifndef VERTEXFACTORY_H
+#define VERTEXFACTORY_H 0
+
+#include "Common.hlsl"
+#include "VertexFactory/VertexFactoryCommon.hlsl"
+
+/* Position only stream of static mesh for depth prepass */
+struct FVertexFactoryInput
+{
+	float4 		position		: POSITION;
+};
+
+float4 VertexFactory_GetLocalPosition( FVertexFactoryInput InInput )
+{
+	return InInput.position;
+}
+
+float4 VertexFactory_GetWorldPosition( FVertexFactoryInput InInput )
+{
+	return MulMatrix( localToWorldMatrix, VertexFactory_GetLocalPosition( InInput ) );
+}
+
+#endif // !VERTEXFACTORY_H
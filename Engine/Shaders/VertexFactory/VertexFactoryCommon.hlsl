@@ -2,6 +2,9 @@
 #define VERTEXFACTORYCOMMON_H 0
 
 #if !USE_INSTANCING
+/* Constants changed per draw, they are in own buffer for don't upload constants of material on each draw */
+cbuffer DrawConstants : register( SOB_DrawConstants )
+{
 	/* Matrix for convert from local to world coord system */
 	float4x4        localToWorldMatrix;
 	
@@ -14,6 +17,7 @@
 	#if WITH_EDITOR
 		float4			colorOverlay;
 	#endif // WITH_EDITOR
+};
 #endif // !USE_INSTANCING
 
 #endif // !VERTEXFACTORYCOMMON_H
\ No newline at end of file